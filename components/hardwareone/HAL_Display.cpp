@@ -19,6 +19,153 @@
 // Global display instance
 DisplayDriver* gDisplay = nullptr;
 
+static DisplayFlushStats sFlushStats = {};
+
+#if DISPLAY_TYPE == DISPLAY_TYPE_SSD1306
+// =============================================================================
+// SSD1306 dirty-region flush
+// =============================================================================
+// A shadow copy of what the panel currently shows is diffed against the
+// Adafruit framebuffer (page-major: buf[col + page * WIDTH]). Each changed page
+// contributes a [first, last] column span; vertically adjacent spans are merged
+// into one page/column window when that costs fewer bus bytes than sending them
+// separately. Horizontal addressing mode (set by begin()) wraps the window
+// row-by-row, so a window is one command write plus a contiguous data stream.
+
+#define OLED_PAGES            (DISPLAY_HEIGHT / 8)
+#define OLED_FB_BYTES         (DISPLAY_WIDTH * OLED_PAGES)
+#define OLED_WINDOW_OVERHEAD  10     // addr+ctrl+6 cmd bytes, addr+ctrl for the first data write
+#define OLED_FULL_REFRESH_MS  30000  // Periodic full push in case the panel missed a write
+
+#if defined(I2C_BUFFER_LENGTH) && (I2C_BUFFER_LENGTH) < 256
+  #define OLED_I2C_CHUNK (I2C_BUFFER_LENGTH)
+#elif defined(I2C_BUFFER_LENGTH)
+  #define OLED_I2C_CHUNK 256
+#else
+  #define OLED_I2C_CHUNK 32
+#endif
+
+extern TwoWire Wire1;
+
+static uint8_t sOledShadow[OLED_FB_BYTES];
+static bool sOledShadowValid = false;
+static uint8_t sOledAddr = OLED_I2C_ADDRESS;
+static uint32_t sOledLastFullMs = 0;
+
+// Copy the window into the shadow, then send it from the shadow so the shadow
+// matches the panel exactly even if the framebuffer is drawn to mid-flush.
+static bool oledSendWindow(const uint8_t* fb, uint8_t page0, uint8_t page1, uint8_t col0, uint8_t col1) {
+  const size_t cols = (size_t)col1 - col0 + 1;
+  for (uint8_t p = page0; p <= page1; p++) {
+    memcpy(&sOledShadow[p * DISPLAY_WIDTH + col0], &fb[p * DISPLAY_WIDTH + col0], cols);
+  }
+
+  Wire1.beginTransmission(sOledAddr);
+  Wire1.write((uint8_t)0x00);  // Command stream
+  Wire1.write((uint8_t)0x21);  // Column address
+  Wire1.write(col0);
+  Wire1.write(col1);
+  Wire1.write((uint8_t)0x22);  // Page address
+  Wire1.write(page0);
+  Wire1.write(page1);
+  if (Wire1.endTransmission() != 0) return false;
+  sFlushStats.busBytes += 8;
+
+  size_t inChunk = 0;
+  for (uint8_t p = page0; p <= page1; p++) {
+    const uint8_t* row = &sOledShadow[p * DISPLAY_WIDTH + col0];
+    for (size_t i = 0; i < cols; i++) {
+      if (inChunk == 0) {
+        Wire1.beginTransmission(sOledAddr);
+        Wire1.write((uint8_t)0x40);  // Data stream
+        inChunk = 1;
+        sFlushStats.busBytes += 2;
+      }
+      Wire1.write(row[i]);
+      inChunk++;
+      sFlushStats.busBytes++;
+      if (inChunk >= OLED_I2C_CHUNK) {
+        if (Wire1.endTransmission() != 0) return false;
+        inChunk = 0;
+      }
+    }
+  }
+  if (inChunk > 0 && Wire1.endTransmission() != 0) return false;
+  sFlushStats.windows++;
+  return true;
+}
+
+static void oledFlushDirty() {
+  const uint8_t* fb = gDisplay->getBuffer();
+  if (!fb) return;
+
+  uint32_t now = millis();
+  if (!sOledShadowValid || (now - sOledLastFullMs) >= OLED_FULL_REFRESH_MS) {
+    sFlushStats.flushes++;
+    sFlushStats.fullFlushes++;
+    if (oledSendWindow(fb, 0, OLED_PAGES - 1, 0, DISPLAY_WIDTH - 1)) {
+      sOledShadowValid = true;
+      sOledLastFullMs = now;
+    } else {
+      sOledShadowValid = false;
+      sFlushStats.errors++;
+    }
+    return;
+  }
+
+  // Pending window (merged run of dirty pages)
+  int g0 = -1, g1 = -1, gc0 = 0, gc1 = 0;
+  bool sent = false;
+  bool ok = true;
+
+  for (int p = 0; p <= OLED_PAGES && ok; p++) {
+    int lo = -1, hi = -1;
+    if (p < OLED_PAGES) {
+      const uint8_t* a = &fb[p * DISPLAY_WIDTH];
+      const uint8_t* b = &sOledShadow[p * DISPLAY_WIDTH];
+      if (memcmp(a, b, DISPLAY_WIDTH) != 0) {
+        lo = 0;
+        while (a[lo] == b[lo]) lo++;
+        hi = DISPLAY_WIDTH - 1;
+        while (a[hi] == b[hi]) hi--;
+      }
+    }
+
+    if (lo >= 0 && g0 >= 0 && p == g1 + 1) {
+      int mc0 = (lo < gc0) ? lo : gc0;
+      int mc1 = (hi > gc1) ? hi : gc1;
+      int merged = (p - g0 + 1) * (mc1 - mc0 + 1);
+      int separate = (g1 - g0 + 1) * (gc1 - gc0 + 1) + (hi - lo + 1) + OLED_WINDOW_OVERHEAD;
+      if (merged <= separate) {
+        g1 = p;
+        gc0 = mc0;
+        gc1 = mc1;
+        continue;
+      }
+    }
+
+    // Current page does not extend the pending window: emit it
+    if (g0 >= 0) {
+      ok = oledSendWindow(fb, (uint8_t)g0, (uint8_t)g1, (uint8_t)gc0, (uint8_t)gc1);
+      sent = true;
+      g0 = -1;
+    }
+    if (lo >= 0) {
+      g0 = g1 = p;
+      gc0 = lo;
+      gc1 = hi;
+    }
+  }
+
+  if (!ok) {
+    sOledShadowValid = false;
+    sFlushStats.errors++;
+  }
+  if (sent) sFlushStats.flushes++;
+  else sFlushStats.idleFlushes++;
+}
+#endif // DISPLAY_TYPE == DISPLAY_TYPE_SSD1306
+
 /**
  * Initialize display hardware based on DISPLAY_TYPE
  * Returns true on success, false on failure
@@ -63,6 +210,7 @@ bool displayInit() {
     gDisplay = nullptr;
     return false;
   }
+  displayAttachI2C(detectedAddr);
   
   // Clear the display buffer and push to OLED via transaction-wrapped update
   gDisplay->clearDisplay();
@@ -73,7 +221,7 @@ bool displayInit() {
   // ============================================================================
   // SPI TFT (ST7789) Initialization
   // ============================================================================
-  gDisplay = new Adafruit_ST7789(DISPLAY_SPI_CS, DISPLAY_SPI_DC, DISPLAY_SPI_RST);
+  gDisplay = new DisplayDriver(DISPLAY_SPI_CS, DISPLAY_SPI_DC, DISPLAY_SPI_RST);
   if (!gDisplay) {
     return false;
   }
@@ -87,6 +235,11 @@ bool displayInit() {
   // Clear screen to black
   gDisplay->fillScreen(DISPLAY_COLOR_BLACK);
   
+  #if DISPLAY_TFT_FRAMEBUFFER
+    // Attached after rotation so the buffer matches the logical layout
+    gDisplay->attachFramebuffer();
+  #endif
+  
   // Optional: Initialize backlight if pin is defined
   #if DISPLAY_BL_PIN >= 0
     pinMode(DISPLAY_BL_PIN, OUTPUT);
@@ -99,7 +252,7 @@ bool displayInit() {
   // ============================================================================
   // SPI TFT (ILI9341) Initialization - PLACEHOLDER
   // ============================================================================
-  gDisplay = new Adafruit_ILI9341(DISPLAY_SPI_CS, DISPLAY_SPI_DC, DISPLAY_SPI_RST);
+  gDisplay = new DisplayDriver(DISPLAY_SPI_CS, DISPLAY_SPI_DC, DISPLAY_SPI_RST);
   if (!gDisplay) {
     return false;
   }
@@ -107,6 +260,9 @@ bool displayInit() {
   gDisplay->begin();
   gDisplay->setRotation(0);
   gDisplay->fillScreen(DISPLAY_COLOR_BLACK);
+  #if DISPLAY_TFT_FRAMEBUFFER
+    gDisplay->attachFramebuffer();
+  #endif
   
   #if DISPLAY_BL_PIN >= 0
     pinMode(DISPLAY_BL_PIN, OUTPUT);
@@ -123,7 +279,7 @@ bool displayInit() {
 /**
  * Clear entire display
  * OLED: Clears framebuffer (requires display() to show)
- * TFT: Fills screen with black (immediate)
+ * TFT: Fills screen with black (immediate, or on next displayUpdate() with a framebuffer)
  */
 void displayClear() {
   if (!gDisplay) return;
@@ -137,8 +293,8 @@ void displayClear() {
 
 /**
  * Update display (push framebuffer to screen)
- * OLED: Pushes framebuffer to display (required)
- * TFT: No-op (direct rendering, already on screen)
+ * OLED: Sends the regions that changed since the last flush (required)
+ * TFT: Pushes dirty rects from the framebuffer (no-op when drawing directly)
  */
 void displayUpdate() {
   if (!gDisplay) return;
@@ -150,16 +306,65 @@ void displayUpdate() {
   if (gSensorPollingPaused) return;
   
   // Use device-aware transaction for proper clock management.
-  // Run at 400kHz to reduce bus hold time (~20ms vs ~80ms at 100kHz).
-  // SSD1306 supports up to 400kHz I2C.
+  // Run at 400kHz to reduce bus hold time (~20ms for a full frame vs ~80ms at 100kHz;
+  // typical UI updates only touch a few pages and static screens send nothing).
   // Short timeout (15ms) so OLED yields to higher-priority I2C devices (gamepad, sensors).
-  // If bus is busy, we skip this frame and retry next cycle - no visible flicker.
+  // If bus is busy, we skip this frame and retry next cycle - the diff carries over.
   i2cDeviceTransactionVoid(OLED_I2C_ADDRESS, 400000, 15, [&]() {
-    gDisplay->display();  // Push framebuffer to OLED (~20ms at 400kHz)
+    oledFlushDirty();
   });
 #elif DISPLAY_TYPE == DISPLAY_TYPE_ST7789 || DISPLAY_TYPE == DISPLAY_TYPE_ILI9341
-  // No-op for TFT (direct rendering)
+  #if DISPLAY_TFT_FRAMEBUFFER
+    gDisplay->flush();
+  #endif
+#endif
+}
+
+/**
+ * Flush changed regions from inside an existing OLED I2C transaction
+ * (replaces direct display() calls in modal screens)
+ */
+void displayFlushLocked() {
+  if (!gDisplay) return;
+#if DISPLAY_TYPE == DISPLAY_TYPE_SSD1306
+  oledFlushDirty();
+#elif DISPLAY_TFT_FRAMEBUFFER
+  gDisplay->flush();
+#endif
+}
+
+/**
+ * Forget what the panel shows; the next flush pushes the whole frame
+ */
+void displayInvalidate() {
+#if DISPLAY_TYPE == DISPLAY_TYPE_SSD1306
+  sOledShadowValid = false;
+#endif
+}
+
+/**
+ * Record the panel's I2C address after a successful begin()
+ */
+void displayAttachI2C(uint8_t i2cAddr) {
+#if DISPLAY_TYPE == DISPLAY_TYPE_SSD1306
+  sOledAddr = i2cAddr;
+  sOledShadowValid = false;
+#else
+  (void)i2cAddr;
+#endif
+}
+
+void displayGetFlushStats(DisplayFlushStats* out) {
+  if (!out) return;
+#if (DISPLAY_TYPE == DISPLAY_TYPE_ST7789 || DISPLAY_TYPE == DISPLAY_TYPE_ILI9341) && DISPLAY_TFT_FRAMEBUFFER
+  if (gDisplay) {
+    const TFTFlushStats& t = gDisplay->flushStats();
+    sFlushStats.flushes = t.flushes;
+    sFlushStats.windows = t.rects;
+    sFlushStats.busBytes = t.pixels * 2;
+  }
 #endif
+  *out = sFlushStats;
 }
 
 /**
@@ -90,7 +90,18 @@
   // SD card (if using the microSD slot on the breakout)
   #define DISPLAY_SD_CS         15    // SD card chip select
   
-  typedef Adafruit_ST7789 DisplayDriver;
+  // Draw into a PSRAM framebuffer and push dirty rects in displayUpdate()
+  // (falls back to direct drawing when PSRAM is unavailable)
+  #ifndef DISPLAY_TFT_FRAMEBUFFER
+    #define DISPLAY_TFT_FRAMEBUFFER 1
+  #endif
+  
+  #if DISPLAY_TFT_FRAMEBUFFER
+    #include "HAL_TFTFramebuffer.h"
+    typedef TFTFramebuffer<Adafruit_ST7789> DisplayDriver;
+  #else
+    typedef Adafruit_ST7789 DisplayDriver;
+  #endif
   
   // Color definitions (RGB565 - 16-bit color)
   #define DISPLAY_COLOR_BLACK   ST77XX_BLACK
@@ -124,7 +135,16 @@
   #define DISPLAY_SPI_DC        16
   #define DISPLAY_SPI_RST       17
   
-  typedef Adafruit_ILI9341 DisplayDriver;
+  #ifndef DISPLAY_TFT_FRAMEBUFFER
+    #define DISPLAY_TFT_FRAMEBUFFER 1
+  #endif
+  
+  #if DISPLAY_TFT_FRAMEBUFFER
+    #include "HAL_TFTFramebuffer.h"
+    typedef TFTFramebuffer<Adafruit_ILI9341> DisplayDriver;
+  #else
+    typedef Adafruit_ILI9341 DisplayDriver;
+  #endif
   
   // Color definitions (RGB565)
   #define DISPLAY_COLOR_BLACK   ILI9341_BLACK
@@ -213,10 +233,26 @@ extern DisplayDriver* gDisplay;
 // Display control functions
 bool displayInit();                      // Initialize display hardware
 void displayClear();                     // Clear entire display
-void displayUpdate();                    // Update display (no-op for TFT, display() for OLED)
+void displayUpdate();                    // Update display (dirty-region flush; no-op for TFT without framebuffer)
 void displayDim(bool dim);               // Dim display (on/off brightness)
 void displaySetBrightness(uint8_t level); // Set brightness 0-255 (PWM for TFT, contrast for OLED)
 
+// Partial flush: OLED sends only framebuffer bytes that differ from what the
+// panel already shows (SSD1306 page/column windows); TFT pushes dirty rects.
+void displayFlushLocked();                // Flush changes; caller already holds the OLED I2C transaction
+void displayInvalidate();                 // Next flush sends the whole frame (after begin(), bus recovery, ...)
+void displayAttachI2C(uint8_t i2cAddr);   // Record panel address after begin(); also invalidates
+
+struct DisplayFlushStats {
+  uint32_t flushes;        // Flush calls that had something to send
+  uint32_t fullFlushes;    // Whole-frame pushes
+  uint32_t idleFlushes;    // Flush calls with no changed bytes (no bus traffic)
+  uint32_t windows;        // Address windows sent (TFT: dirty rects)
+  uint32_t errors;         // I2C write failures (force a full flush next time)
+  uint64_t busBytes;       // Bytes put on the bus (OLED includes address/control bytes; TFT pixel data only)
+};
+void displayGetFlushStats(DisplayFlushStats* out);
+
 #endif // DISPLAY_ENABLED
 
 #endif // HAL_DISPLAY_H
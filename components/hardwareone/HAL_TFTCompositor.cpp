@@ -0,0 +1,261 @@
+/**
+ * HAL_TFTCompositor.cpp - Band compositor for live views on color TFT panels
+ */
+
+#include "HAL_TFTCompositor.h"
+
+#if DISPLAY_ENABLED && DISPLAY_IS_COLOR
+
+#include "System_MemUtil.h"
+
+// Longest row the compositor handles (either orientation of the panel)
+#define TFT_COMPOSITOR_MAX_W  (DISPLAY_WIDTH > DISPLAY_HEIGHT ? DISPLAY_WIDTH : DISPLAY_HEIGHT)
+#define TFT_COMPOSITOR_MAX_SRC_W  64   // Widest thermal source row
+
+static uint16_t* sBand = nullptr;     // TFT_COMPOSITOR_BAND_ROWS x MAX_W RGB565
+static int16_t* sEnvelope = nullptr;  // Waveform min/max per column (2 x MAX_W)
+static TFTCompositorStats sStats = {};
+
+static inline uint16_t rgb565(uint8_t r, uint8_t g, uint8_t b) {
+  return (uint16_t)(((r & 0xF8) << 8) | ((g & 0xFC) << 3) | (b >> 3));
+}
+
+const uint16_t* tftThermalPalette() {
+  static uint16_t palette[256];
+  static bool built = false;
+  if (!built) {
+    // Ironbow-style stops, linearly interpolated
+    static const uint8_t stops[][4] = {
+      {   0,   0,   0,   0 },
+      {  48,  32,   0, 140 },
+      {  96, 150,   0, 160 },
+      { 144, 230,  40,  40 },
+      { 192, 255, 150,   0 },
+      { 232, 255, 230,  60 },
+      { 255, 255, 255, 255 },
+    };
+    const size_t nStops = sizeof(stops) / sizeof(stops[0]);
+    for (size_t s = 0; s + 1 < nStops; s++) {
+      int i0 = stops[s][0], i1 = stops[s + 1][0];
+      for (int i = i0; i <= i1; i++) {
+        int t = (i1 > i0) ? ((i - i0) * 256) / (i1 - i0) : 0;
+        uint8_t r = (uint8_t)(stops[s][1] + (((int)stops[s + 1][1] - stops[s][1]) * t) / 256);
+        uint8_t g = (uint8_t)(stops[s][2] + (((int)stops[s + 1][2] - stops[s][2]) * t) / 256);
+        uint8_t b = (uint8_t)(stops[s][3] + (((int)stops[s + 1][3] - stops[s][3]) * t) / 256);
+        palette[i] = rgb565(r, g, b);
+      }
+    }
+    built = true;
+  }
+  return palette;
+}
+
+const TFTCompositorStats& tftCompositorStats() {
+  return sStats;
+}
+
+static bool compositorBuffers() {
+  if (!sBand) {
+    // Internal RAM keeps the SPI burst off the PSRAM bus; falls back if tight
+    sBand = (uint16_t*)ps_alloc(sizeof(uint16_t) * TFT_COMPOSITOR_MAX_W * TFT_COMPOSITOR_BAND_ROWS,
+                                AllocPref::PreferInternal, "tft.band");
+    if (!sBand) return false;
+  }
+  if (!sEnvelope) {
+    sEnvelope = (int16_t*)ps_alloc(sizeof(int16_t) * TFT_COMPOSITOR_MAX_W * 2, AllocPref::PreferPSRAM, "tft.env");
+    if (!sEnvelope) return false;
+  }
+  return true;
+}
+
+// ============================================================================
+// TFTBandCanvas
+// ============================================================================
+
+void TFTBandCanvas::drawPixel(int16_t x, int16_t y, uint16_t color) {
+  y -= _bandY;
+  if (!_buf || x < 0 || x >= _width || y < 0 || y >= _rows) return;
+  _buf[(int32_t)y * _width + x] = color;
+}
+
+void TFTBandCanvas::fillRect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color) {
+  if (!_buf) return;
+  if (w < 0) { x += w + 1; w = -w; }
+  if (h < 0) { y += h + 1; h = -h; }
+  int16_t x0 = x < 0 ? 0 : x;
+  int16_t x1 = (x + w > _width) ? _width : x + w;
+  int16_t y0 = y - _bandY, y1 = y0 + h;
+  if (y0 < 0) y0 = 0;
+  if (y1 > _rows) y1 = _rows;
+  if (x0 >= x1 || y0 >= y1) return;
+  for (int16_t yy = y0; yy < y1; yy++) {
+    uint16_t* row = &_buf[(int32_t)yy * _width];
+    for (int16_t xx = x0; xx < x1; xx++) row[xx] = color;
+  }
+}
+
+void TFTBandCanvas::drawFastHLine(int16_t x, int16_t y, int16_t w, uint16_t color) {
+  fillRect(x, y, w, 1, color);
+}
+
+void TFTBandCanvas::drawFastVLine(int16_t x, int16_t y, int16_t h, uint16_t color) {
+  fillRect(x, y, 1, h, color);
+}
+
+// ============================================================================
+// TFTCompositor
+// ============================================================================
+
+TFTCompositor::TFTCompositor(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t background)
+  : _x(x), _y(y), _w(w > TFT_COMPOSITOR_MAX_W ? TFT_COMPOSITOR_MAX_W : w), _h(h), _bg(background) {}
+
+void TFTCompositor::setThermal(const int16_t* frame, uint8_t srcW, uint8_t srcH,
+                               int16_t minCenti, int16_t maxCenti,
+                               int16_t dx, int16_t dy, int16_t dw, int16_t dh) {
+  if (!frame || srcW == 0 || srcH == 0 || srcW > TFT_COMPOSITOR_MAX_SRC_W || dw <= 0 || dh <= 0) {
+    _thermal = nullptr;
+    return;
+  }
+  _thermal = frame;
+  _srcW = srcW;
+  _srcH = srcH;
+  _minCenti = minCenti;
+  int32_t range = (int32_t)maxCenti - minCenti;
+  if (range < 100) range = 100;  // At least 1 degree across the ramp
+  _range = range;
+  _tx = dx; _ty = dy; _tw = dw; _th = dh;
+}
+
+void TFTCompositor::setBars(const uint8_t* values, uint8_t count, uint8_t maxValue) {
+  _bars = (count > 0) ? values : nullptr;
+  _barCount = count;
+  _barMax = maxValue ? maxValue : 1;
+}
+
+void TFTCompositor::setWaveform(const int16_t* samples, size_t count, uint16_t color) {
+  _wave = (count > 0) ? samples : nullptr;
+  _waveCount = count;
+  _waveColor = color;
+}
+
+void TFTCompositor::renderThermalRows(uint16_t* band, int16_t bandY, int16_t rows) {
+  const uint16_t* palette = tftThermalPalette();
+  uint8_t idx[TFT_COMPOSITOR_MAX_SRC_W];
+  int16_t lastSrcY = -1;
+
+  int16_t x0 = _tx < 0 ? 0 : _tx;
+  int16_t x1 = (_tx + _tw > _w) ? _w : _tx + _tw;
+  if (x0 >= x1) return;
+  uint8_t xmap[TFT_COMPOSITOR_MAX_W];
+  for (int16_t x = x0; x < x1; x++) xmap[x] = (uint8_t)(((int32_t)(x - _tx) * _srcW) / _tw);
+
+  for (int16_t r = 0; r < rows; r++) {
+    int16_t ly = bandY + r - _ty;
+    if (ly < 0 || ly >= _th) continue;
+    int16_t srcY = (int16_t)(((int32_t)ly * _srcH) / _th);
+
+    // Palette indices for one source row, reused by every output row it covers
+    // (one divide per source pixel, not per screen pixel)
+    if (srcY != lastSrcY) {
+      const int16_t* src = &_thermal[(int32_t)srcY * _srcW];
+      for (uint8_t sx = 0; sx < _srcW; sx++) {
+        int32_t d = (int32_t)src[sx] - _minCenti;
+        int32_t v = (d <= 0) ? 0 : (d * 255) / _range;
+        idx[sx] = (uint8_t)(v > 255 ? 255 : v);
+      }
+      lastSrcY = srcY;
+    }
+
+    uint16_t* out = &band[(int32_t)r * _w];
+    for (int16_t x = x0; x < x1; x++) out[x] = palette[idx[xmap[x]]];
+  }
+}
+
+void TFTCompositor::renderBarRows(uint16_t* band, int16_t bandY, int16_t rows) {
+  const uint16_t* palette = tftThermalPalette();
+  int16_t colW = _w / _barCount;
+  if (colW <= 0) return;
+  int16_t gap = (colW > 2) ? 1 : 0;
+
+  for (int16_t r = 0; r < rows; r++) {
+    int16_t ry = bandY + r;
+    int16_t fromBottom = _h - 1 - ry;  // 0 = bottom row
+    uint16_t color = palette[_h > 1 ? (fromBottom * 255) / (_h - 1) : 255];
+    uint16_t* out = &band[(int32_t)r * _w];
+    for (uint8_t i = 0; i < _barCount; i++) {
+      // Values above maxValue fill the column (and must not wrap int16_t)
+      int32_t barH = ((int32_t)_bars[i] * _h) / _barMax;
+      if (fromBottom >= barH) continue;
+      int16_t xs = i * colW;
+      for (int16_t x = xs; x < xs + colW - gap; x++) out[x] = color;
+    }
+  }
+}
+
+void TFTCompositor::renderWaveRows(uint16_t* band, int16_t bandY, int16_t rows) {
+  const int16_t* yMin = sEnvelope;
+  const int16_t* yMax = sEnvelope + TFT_COMPOSITOR_MAX_W;
+  for (int16_t x = 0; x < _w; x++) {
+    int16_t top = yMin[x] - bandY;
+    int16_t bottom = yMax[x] - bandY;
+    if (bottom < 0 || top >= rows) continue;
+    if (top < 0) top = 0;
+    if (bottom >= rows) bottom = rows - 1;
+    for (int16_t r = top; r <= bottom; r++) band[(int32_t)r * _w + x] = _waveColor;
+  }
+}
+
+bool TFTCompositor::render(DisplayDriver* display) {
+  if (!display || _w <= 0 || _h <= 0) return false;
+  if (!compositorBuffers()) return false;
+  uint32_t startUs = micros();
+
+  // Waveform envelope is computed once per frame in rectangle rows
+  if (_wave) {
+    int16_t* yMin = sEnvelope;
+    int16_t* yMax = sEnvelope + TFT_COMPOSITOR_MAX_W;
+    int32_t mid = _h / 2;
+    int32_t half = (_h - 1) / 2;
+    for (int16_t x = 0; x < _w; x++) {
+      size_t s0 = ((size_t)x * _waveCount) / _w;
+      size_t s1 = ((size_t)(x + 1) * _waveCount) / _w;
+      if (s1 <= s0) s1 = s0 + 1;
+      if (s1 > _waveCount) s1 = _waveCount;
+      int16_t lo = 32767, hi = -32768;
+      for (size_t s = s0; s < s1; s++) {
+        if (_wave[s] < lo) lo = _wave[s];
+        if (_wave[s] > hi) hi = _wave[s];
+      }
+      // Screen y grows downward: the highest sample is the top of the span
+      yMin[x] = (int16_t)(mid - ((int32_t)hi * half) / 32768);
+      yMax[x] = (int16_t)(mid - ((int32_t)lo * half) / 32768);
+    }
+  }
+
+  TFTBandCanvas canvas(_w, _h);
+  uint32_t bands = 0;
+  for (int16_t bandY = 0; bandY < _h; bandY += TFT_COMPOSITOR_BAND_ROWS) {
+    int16_t rows = (_h - bandY < TFT_COMPOSITOR_BAND_ROWS) ? (_h - bandY) : TFT_COMPOSITOR_BAND_ROWS;
+    size_t n = (size_t)rows * _w;
+    for (size_t i = 0; i < n; i++) sBand[i] = _bg;
+
+    if (_thermal) renderThermalRows(sBand, bandY, rows);
+    if (_bars) renderBarRows(sBand, bandY, rows);
+    if (_wave) renderWaveRows(sBand, bandY, rows);
+    if (_overlay) {
+      canvas.setBand(sBand, bandY, rows);
+      _overlay(canvas, _overlayUser);
+    }
+
+    // One address window + bulk write (or framebuffer row copy) per band
+    display->drawRGBBitmap(_x, _y + bandY, sBand, _w, rows);
+    bands++;
+  }
+
+  sStats.frames++;
+  sStats.bands += bands;
+  sStats.lastFrameUs = micros() - startUs;
+  return true;
+}
+
+#endif // DISPLAY_ENABLED && DISPLAY_IS_COLOR
@@ -0,0 +1,116 @@
+/**
+ * HAL_TFTCompositor.h - Band compositor for live views on color TFT panels
+ *
+ * Thermal images, spectrum bars and waveforms change every frame and cover
+ * most of their screen area, so drawing them through GFX primitives costs
+ * one clipped call per pixel or line segment. The compositor instead renders
+ * a rectangle in horizontal bands of TFT_COMPOSITOR_BAND_ROWS lines:
+ *
+ *   base layers (thermal -> bars -> waveform) -> overlay callback -> push
+ *
+ * Each finished band is handed to drawRGBBitmap() once, which is a single
+ * address window + bulk write on the panel or a row memcpy into the PSRAM
+ * framebuffer (HAL_TFTFramebuffer.h). Overlays (labels, cursors, scales) are
+ * drawn with normal GFX calls on a TFTBandCanvas clipped to the current band,
+ * so text composites over the image without flicker.
+ *
+ * Per-frame cost depends only on the rectangle size, not on the data.
+ */
+
+#ifndef HAL_TFT_COMPOSITOR_H
+#define HAL_TFT_COMPOSITOR_H
+
+#include "HAL_Display.h"
+
+#if DISPLAY_ENABLED && DISPLAY_IS_COLOR
+
+#include <Adafruit_GFX.h>
+
+#define TFT_COMPOSITOR_BAND_ROWS  16
+
+// 256-entry RGB565 false-color ramp (black -> blue -> magenta -> red -> yellow -> white)
+const uint16_t* tftThermalPalette();
+
+// GFX target for overlays. Coordinates are relative to the compositor
+// rectangle; anything outside the band being rendered is dropped.
+class TFTBandCanvas : public Adafruit_GFX {
+public:
+  TFTBandCanvas(int16_t w, int16_t h) : Adafruit_GFX(w, h) {}
+
+  void setBand(uint16_t* buf, int16_t bandY, int16_t rows) { _buf = buf; _bandY = bandY; _rows = rows; }
+
+  void drawPixel(int16_t x, int16_t y, uint16_t color) override;
+  void drawFastHLine(int16_t x, int16_t y, int16_t w, uint16_t color) override;
+  void drawFastVLine(int16_t x, int16_t y, int16_t h, uint16_t color) override;
+  void fillRect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color) override;
+
+private:
+  uint16_t* _buf = nullptr;
+  int16_t _bandY = 0;
+  int16_t _rows = 0;
+};
+
+typedef void (*TFTOverlayFunc)(TFTBandCanvas& canvas, void* userData);
+
+struct TFTCompositorStats {
+  uint32_t frames;
+  uint32_t bands;
+  uint32_t lastFrameUs;
+};
+
+class TFTCompositor {
+public:
+  // x/y/w/h: target rectangle in screen coordinates
+  TFTCompositor(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t background = 0);
+
+  // Scaled false-color image of a centidegree frame (nearest neighbour),
+  // placed at (dx, dy, dw, dh) inside the rectangle. Values are mapped
+  // linearly from [minCenti, maxCenti] onto the palette.
+  void setThermal(const int16_t* frame, uint8_t srcW, uint8_t srcH,
+                  int16_t minCenti, int16_t maxCenti,
+                  int16_t dx, int16_t dy, int16_t dw, int16_t dh);
+
+  // Bottom-anchored columns across the full width, value 0..maxValue.
+  // Colors follow the palette by height so louder bins read hotter.
+  void setBars(const uint8_t* values, uint8_t count, uint8_t maxValue);
+
+  // PCM trace across the full width, centred vertically. Each column shows the
+  // min..max envelope of the samples that fall into it.
+  void setWaveform(const int16_t* samples, size_t count, uint16_t color);
+
+  void setOverlay(TFTOverlayFunc fn, void* userData) { _overlay = fn; _overlayUser = userData; }
+
+  // Render all bands and push them to the display
+  bool render(DisplayDriver* display);
+
+private:
+  void renderThermalRows(uint16_t* band, int16_t bandY, int16_t rows);
+  void renderBarRows(uint16_t* band, int16_t bandY, int16_t rows);
+  void renderWaveRows(uint16_t* band, int16_t bandY, int16_t rows);
+
+  int16_t _x, _y, _w, _h;
+  uint16_t _bg;
+
+  const int16_t* _thermal = nullptr;
+  uint8_t _srcW = 0, _srcH = 0;
+  int16_t _minCenti = 0;
+  int32_t _range = 100;    // Centidegrees across the palette (>= 100)
+  int16_t _tx = 0, _ty = 0, _tw = 0, _th = 0;
+
+  const uint8_t* _bars = nullptr;
+  uint8_t _barCount = 0;
+  uint8_t _barMax = 1;
+
+  const int16_t* _wave = nullptr;
+  size_t _waveCount = 0;
+  uint16_t _waveColor = 0;
+
+  TFTOverlayFunc _overlay = nullptr;
+  void* _overlayUser = nullptr;
+};
+
+const TFTCompositorStats& tftCompositorStats();
+
+#endif // DISPLAY_ENABLED && DISPLAY_IS_COLOR
+
+#endif // HAL_TFT_COMPOSITOR_H
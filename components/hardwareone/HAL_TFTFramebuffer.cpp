@@ -0,0 +1,83 @@
+/**
+ * HAL_TFTFramebuffer.cpp - Dirty-rectangle bookkeeping and buffer allocation
+ */
+
+#include "HAL_TFTFramebuffer.h"
+#include <esp_heap_caps.h>
+#include "System_MemUtil.h"
+
+// A merged rect may cover this many pixels that neither input covered. One
+// extra window costs roughly a 10-byte command sequence plus SPI setup, which
+// is on the order of a few hundred pixel writes at 40 MHz.
+#define TFT_DIRTY_MERGE_SLACK_PX  512
+
+static inline DirtyRectList::Rect rectUnion(const DirtyRectList::Rect& a, const DirtyRectList::Rect& b) {
+  DirtyRectList::Rect u;
+  u.x0 = a.x0 < b.x0 ? a.x0 : b.x0;
+  u.y0 = a.y0 < b.y0 ? a.y0 : b.y0;
+  u.x1 = a.x1 > b.x1 ? a.x1 : b.x1;
+  u.y1 = a.y1 > b.y1 ? a.y1 : b.y1;
+  return u;
+}
+
+static inline bool rectContains(const DirtyRectList::Rect& outer, const DirtyRectList::Rect& r) {
+  return r.x0 >= outer.x0 && r.y0 >= outer.y0 && r.x1 <= outer.x1 && r.y1 <= outer.y1;
+}
+
+void DirtyRectList::add(int16_t x, int16_t y, int16_t w, int16_t h, int16_t screenW, int16_t screenH) {
+  if (w <= 0 || h <= 0) return;
+  Rect r;
+  r.x0 = x < 0 ? 0 : x;
+  r.y0 = y < 0 ? 0 : y;
+  r.x1 = (x + w > screenW) ? screenW - 1 : x + w - 1;
+  r.y1 = (y + h > screenH) ? screenH - 1 : y + h - 1;
+  if (r.x0 > r.x1 || r.y0 > r.y1) return;
+  insert(r);
+}
+
+void DirtyRectList::insert(Rect r) {
+  // Absorb into (or grow) an existing rect when the union wastes little area.
+  // A grown rect may now reach others, so repeat until nothing merges.
+  for (;;) {
+    bool merged = false;
+    for (uint8_t i = 0; i < _count; i++) {
+      if (rectContains(_rects[i], r)) return;
+      Rect u = rectUnion(_rects[i], r);
+      if (u.area() <= _rects[i].area() + r.area() + TFT_DIRTY_MERGE_SLACK_PX) {
+        r = u;
+        _rects[i] = _rects[--_count];
+        merged = true;
+        break;
+      }
+    }
+    if (!merged) break;
+  }
+
+  if (_count < TFT_DIRTY_MAX_RECTS) {
+    _rects[_count++] = r;
+    return;
+  }
+
+  // Full: merge the new rect with whichever existing rect grows least
+  uint8_t best = 0;
+  int32_t bestGrowth = INT32_MAX;
+  for (uint8_t i = 0; i < _count; i++) {
+    int32_t growth = rectUnion(_rects[i], r).area() - _rects[i].area();
+    if (growth < bestGrowth) {
+      bestGrowth = growth;
+      best = i;
+    }
+  }
+  Rect u = rectUnion(_rects[best], r);
+  _rects[best] = _rects[--_count];
+  insert(u);
+}
+
+uint16_t* tftFramebufferAlloc(size_t pixels) {
+  // Internal RAM is far too small to give up ~150 KB for this, so no
+  // ps_alloc() fallback: PSRAM or direct drawing
+  if (psramBypassGlobal() || !psramAvailableRuntime()) return nullptr;
+  uint16_t* fb = (uint16_t*)heap_caps_malloc(pixels * sizeof(uint16_t), MALLOC_CAP_SPIRAM);
+  if (fb) memset(fb, 0, pixels * sizeof(uint16_t));
+  return fb;
+}
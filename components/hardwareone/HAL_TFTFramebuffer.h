@@ -0,0 +1,190 @@
+/**
+ * HAL_TFTFramebuffer.h - Optional RGB565 framebuffer for SPI TFT panels
+ *
+ * Wraps an Adafruit SPITFT panel class so GFX drawing goes into a PSRAM
+ * framebuffer instead of straight to the panel. Every primitive records the
+ * rectangle it touched; displayUpdate() then pushes only those rectangles with
+ * one address window and one bulk pixel write each. This removes the per-
+ * primitive SPI transaction overhead and the visible partial redraws of full
+ * screen updates.
+ *
+ * If PSRAM is not available the wrapper falls back to the panel's own direct
+ * drawing, so callers never need to know which mode is active.
+ */
+
+#ifndef HAL_TFT_FRAMEBUFFER_H
+#define HAL_TFT_FRAMEBUFFER_H
+
+#include <Arduino.h>
+
+#define TFT_DIRTY_MAX_RECTS   8   // Rects tracked before merging the closest pair
+
+// Screen-space rectangle set. Overlapping or nearly-adjacent rects are merged
+// on insert when the union wastes little area; when the list is full the pair
+// whose union grows least is merged.
+class DirtyRectList {
+public:
+  struct Rect {
+    int16_t x0, y0, x1, y1;  // Inclusive bounds
+    int32_t area() const { return (int32_t)(x1 - x0 + 1) * (y1 - y0 + 1); }
+  };
+
+  void clear() { _count = 0; }
+  void add(int16_t x, int16_t y, int16_t w, int16_t h, int16_t screenW, int16_t screenH);
+  void addAll(int16_t screenW, int16_t screenH) { clear(); add(0, 0, screenW, screenH, screenW, screenH); }
+  uint8_t count() const { return _count; }
+  const Rect& operator[](uint8_t i) const { return _rects[i]; }
+
+private:
+  void insert(Rect r);
+  Rect _rects[TFT_DIRTY_MAX_RECTS];
+  uint8_t _count = 0;
+};
+
+struct TFTFlushStats {
+  uint32_t flushes;
+  uint32_t rects;
+  uint64_t pixels;
+  uint32_t lastFlushUs;
+};
+
+// Allocates the PSRAM buffer (nullptr if PSRAM is unavailable)
+uint16_t* tftFramebufferAlloc(size_t pixels);
+
+template <class Panel>
+class TFTFramebuffer : public Panel {
+public:
+  template <typename... Args>
+  TFTFramebuffer(Args... args) : Panel(args...) {}
+
+  // Call after the panel is initialized; false = direct drawing stays active
+  bool attachFramebuffer() {
+    if (!_fb) {
+      _fbW = (int16_t)this->width();
+      _fbH = (int16_t)this->height();
+      _fb = tftFramebufferAlloc((size_t)_fbW * _fbH);
+    }
+    if (_fb) _dirty.addAll(_fbW, _fbH);
+    return _fb != nullptr;
+  }
+  bool hasFramebuffer() const { return _fb != nullptr; }
+  uint16_t* framebuffer() { return _fb; }
+  const TFTFlushStats& flushStats() const { return _stats; }
+
+  // Push dirty rectangles to the panel (frame boundary)
+  void flush() {
+    if (!_fb || _dirty.count() == 0) return;
+    uint32_t startUs = micros();
+    Panel::startWrite();
+    for (uint8_t i = 0; i < _dirty.count(); i++) {
+      const DirtyRectList::Rect& r = _dirty[i];
+      uint16_t w = (uint16_t)(r.x1 - r.x0 + 1);
+      uint16_t h = (uint16_t)(r.y1 - r.y0 + 1);
+      this->setAddrWindow(r.x0, r.y0, w, h);
+      if (w == (uint16_t)_fbW) {
+        Panel::writePixels(&_fb[(int32_t)r.y0 * _fbW], (uint32_t)w * h);
+      } else {
+        for (int16_t y = r.y0; y <= r.y1; y++) {
+          Panel::writePixels(&_fb[(int32_t)y * _fbW + r.x0], w);
+        }
+      }
+      _stats.pixels += (uint32_t)w * h;
+    }
+    Panel::endWrite();
+    _stats.rects += _dirty.count();
+    _stats.flushes++;
+    _stats.lastFlushUs = micros() - startUs;
+    _dirty.clear();
+  }
+
+  // --- GFX overrides: draw into the framebuffer when one is attached ---
+
+  void startWrite(void) override { if (!_fb) Panel::startWrite(); }
+  void endWrite(void) override { if (!_fb) Panel::endWrite(); }
+
+  void drawPixel(int16_t x, int16_t y, uint16_t color) override {
+    if (!_fb) { Panel::drawPixel(x, y, color); return; }
+    writePixel(x, y, color);
+  }
+
+  void writePixel(int16_t x, int16_t y, uint16_t color) override {
+    if (!_fb) { Panel::writePixel(x, y, color); return; }
+    if (x < 0 || y < 0 || x >= _fbW || y >= _fbH) return;
+    _fb[(int32_t)y * _fbW + x] = color;
+    _dirty.add(x, y, 1, 1, _fbW, _fbH);
+  }
+
+  void writeFillRect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color) override {
+    if (!_fb) { Panel::writeFillRect(x, y, w, h, color); return; }
+    fillClipped(x, y, w, h, color);
+  }
+  void fillRect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color) override {
+    if (!_fb) { Panel::fillRect(x, y, w, h, color); return; }
+    fillClipped(x, y, w, h, color);
+  }
+  void writeFastHLine(int16_t x, int16_t y, int16_t w, uint16_t color) override {
+    if (!_fb) { Panel::writeFastHLine(x, y, w, color); return; }
+    fillClipped(x, y, w, 1, color);
+  }
+  void drawFastHLine(int16_t x, int16_t y, int16_t w, uint16_t color) override {
+    if (!_fb) { Panel::drawFastHLine(x, y, w, color); return; }
+    fillClipped(x, y, w, 1, color);
+  }
+  void writeFastVLine(int16_t x, int16_t y, int16_t h, uint16_t color) override {
+    if (!_fb) { Panel::writeFastVLine(x, y, h, color); return; }
+    fillClipped(x, y, 1, h, color);
+  }
+  void drawFastVLine(int16_t x, int16_t y, int16_t h, uint16_t color) override {
+    if (!_fb) { Panel::drawFastVLine(x, y, h, color); return; }
+    fillClipped(x, y, 1, h, color);
+  }
+  void fillScreen(uint16_t color) override {
+    if (!_fb) { Panel::fillScreen(color); return; }
+    fillClipped(0, 0, _fbW, _fbH, color);
+  }
+
+  using Panel::drawRGBBitmap;
+  void drawRGBBitmap(int16_t x, int16_t y, uint16_t* pcolors, int16_t w, int16_t h) {
+    if (!_fb) { Panel::drawRGBBitmap(x, y, pcolors, w, h); return; }
+    int16_t cx0 = x < 0 ? 0 : x, cy0 = y < 0 ? 0 : y;
+    int16_t cx1 = (x + w > _fbW) ? _fbW : x + w, cy1 = (y + h > _fbH) ? _fbH : y + h;
+    if (cx0 >= cx1 || cy0 >= cy1) return;
+    for (int16_t yy = cy0; yy < cy1; yy++) {
+      memcpy(&_fb[(int32_t)yy * _fbW + cx0], &pcolors[(int32_t)(yy - y) * w + (cx0 - x)],
+             (size_t)(cx1 - cx0) * sizeof(uint16_t));
+    }
+    _dirty.add(cx0, cy0, cx1 - cx0, cy1 - cy0, _fbW, _fbH);
+  }
+
+  // Rotation changes the logical layout; keep the buffer and redraw everything
+  void setRotation(uint8_t r) override {
+    Panel::setRotation(r);
+    if (_fb) {
+      _fbW = (int16_t)this->width();
+      _fbH = (int16_t)this->height();
+      _dirty.addAll(_fbW, _fbH);
+    }
+  }
+
+private:
+  void fillClipped(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color) {
+    if (w < 0) { x += w + 1; w = -w; }
+    if (h < 0) { y += h + 1; h = -h; }
+    int16_t x0 = x < 0 ? 0 : x, y0 = y < 0 ? 0 : y;
+    int16_t x1 = (x + w > _fbW) ? _fbW : x + w, y1 = (y + h > _fbH) ? _fbH : y + h;
+    if (x0 >= x1 || y0 >= y1) return;
+    for (int16_t yy = y0; yy < y1; yy++) {
+      uint16_t* row = &_fb[(int32_t)yy * _fbW];
+      for (int16_t xx = x0; xx < x1; xx++) row[xx] = color;
+    }
+    _dirty.add(x0, y0, x1 - x0, y1 - y0, _fbW, _fbH);
+  }
+
+  uint16_t* _fb = nullptr;
+  int16_t _fbW = 0;
+  int16_t _fbH = 0;
+  DirtyRectList _dirty;
+  TFTFlushStats _stats = {};
+};
+
+#endif // HAL_TFT_FRAMEBUFFER_H
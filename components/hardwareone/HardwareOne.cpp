@@ -1786,6 +1786,8 @@ void hardwareone_loop() {
 
   sensorLogTick();
 
+  settingsSaveTick();
+
 #if ENABLE_BATTERY_MONITOR
   {
     static unsigned long lastBatteryUpdate = 0;
@@ -170,8 +170,24 @@ struct OLEDModeEntry {
   bool showInMenu;            // Whether to show in main menu
   int menuOrder;              // Order in menu (lower = earlier, -1 = end)
   const char* hints;          // Footer hints string (nullptr = use central switch fallback)
+  uint16_t refreshMs;         // Max redraw rate for owner-fed data, or a poll period (see OLED_REFRESH_*)
 };
 
+// Refresh policies for OLEDModeEntry::refreshMs. Static screens (menus, settings)
+// leave it 0 and only redraw on input or oledMarkDirty(). Modes fed by a data
+// owner use a plain value as a maximum rate: the owner calls oledMarkDirtyMode()
+// when new data is ready and the mode redraws at most once per refreshMs.
+// Screens with no owner to signal them (uptime, stats, lists) use the POLL
+// variants and redraw on that period. gSettings.oledUpdateInterval still caps
+// the overall rate.
+#define OLED_REFRESH_ON_CHANGE   0
+#define OLED_REFRESH_LIVE_FAST   100   // Fast-moving data (ToF, IMU, thermal, mic level)
+#define OLED_REFRESH_LIVE        250   // Sensor values, status lists
+#define OLED_REFRESH_SLOW        1000  // Clocks, GPS fixes
+#define OLED_REFRESH_POLL_FLAG   0x8000
+#define OLED_REFRESH_POLL_LIVE   (OLED_REFRESH_POLL_FLAG | OLED_REFRESH_LIVE)
+#define OLED_REFRESH_POLL_SLOW   (OLED_REFRESH_POLL_FLAG | OLED_REFRESH_SLOW)  // Uptime, network/system stats
+
 // Maximum number of OLED modes that can be registered
 // 47 enum values + sensor modules registering multiple entries each
 #define MAX_OLED_MODES 64
@@ -180,6 +196,7 @@ struct OLEDModeEntry {
 void registerOLEDMode(const OLEDModeEntry* mode);
 void registerOLEDModes(const OLEDModeEntry* modes, size_t count);
 const OLEDModeEntry* findOLEDMode(OLEDMode mode);
+uint16_t oledModeRefreshMs(OLEDMode mode);  // Raw OLEDModeEntry::refreshMs (incl. OLED_REFRESH_POLL_FLAG)
 const OLEDModeEntry* getOLEDModeByIndex(size_t index);
 size_t getRegisteredOLEDModeCount();
 void printRegisteredOLEDModes();  // Print summary of registered modes (call from setup)
@@ -339,9 +356,11 @@ void displayConnectedSensors();
 // - gamepadSeq: increments on any gamepad input
 // - gSensorStatusSeq: increments on sensor state changes
 // Call oledMarkDirty() only for non-sensor changes (menu state, settings, etc.)
+// Sensor owners call oledMarkDirtyMode() with their mode when a new reading is
+// ready; that redraw is rate-limited by OLEDModeEntry::refreshMs.
 
 void oledMarkDirty();              // Force next render (for non-sensor changes)
-void oledMarkDirtyMode(OLEDMode mode);  // Force next render (compatibility)
+void oledMarkDirtyMode(OLEDMode mode);  // New data for that mode: render (within its refreshMs) if on screen
 bool oledIsDirty();                // Check if anything changed since last render
 void oledClearDirty();             // Record current sequences after render
 void oledSetAlwaysDirty(bool always);  // For animations that need constant refresh
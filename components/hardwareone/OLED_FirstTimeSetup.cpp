@@ -167,7 +167,7 @@ String getOLEDTextInput(const char* prompt, bool isPassword,
         oledDisplay->print(" S:OK");
       }
       
-      oledDisplay->display();
+      displayFlushLocked();
     );
     
     // Handle input
@@ -184,7 +184,7 @@ String getOLEDTextInput(const char* prompt, bool isPassword,
   // Clear the display after keyboard exits
   OLED_TRANSACTION(
     oledDisplay->clearDisplay();
-    oledDisplay->display();
+    displayFlushLocked();
   );
   
   // Check if cancelled
@@ -295,7 +295,7 @@ bool getOLEDYesNoPrompt(const char* prompt, bool defaultYes) {
       oledDisplay->setTextColor(DISPLAY_COLOR_WHITE);
       drawFTSFooter("L/R:Move A:OK");
       
-      oledDisplay->display();
+      displayFlushLocked();
     );
     
     // Check for serial input first (non-blocking)
@@ -359,7 +359,7 @@ bool getOLEDWiFiSelection(String& outSSID) {
     oledDisplay->setTextColor(DISPLAY_COLOR_WHITE);
     oledDisplay->setCursor(0, 0);
     oledDisplay->print("Scanning WiFi...");
-    oledDisplay->display();
+    displayFlushLocked();
   );
   
   WiFi.mode(WIFI_STA);
@@ -387,7 +387,7 @@ bool getOLEDWiFiSelection(String& outSSID) {
       oledDisplay->print("Press A to retry");
       oledDisplay->setCursor(0, 30);
       oledDisplay->print("Press B to skip");
-      oledDisplay->display();
+      displayFlushLocked();
     );
     
     uint32_t pressed = waitForButtonPress();
@@ -499,7 +499,7 @@ bool getOLEDWiFiSelection(String& outSSID) {
         oledDisplay->print("v");
       }
       
-      oledDisplay->display();
+      displayFlushLocked();
     );
     
     // Check for serial input first (non-blocking)
@@ -603,7 +603,7 @@ bool getOLEDWiFiSelection(String& outSSID) {
     oledDisplay->print("at compile time");
     oledDisplay->setCursor(0, 30);
     oledDisplay->print("Press A to continue");
-    oledDisplay->display();
+    displayFlushLocked();
   );
   waitForButtonPress();
   return false;
@@ -657,7 +657,7 @@ void showOLEDMessage(const char* message, bool waitForButton) {
       drawFTSFooter("A:Continue");
     }
     
-    oledDisplay->display();
+    displayFlushLocked();
   );
   
   if (waitForButton) {
@@ -406,7 +406,7 @@ static const OLEDModeEntry logoutModeEntry = {
 };
 
 // Combined auth modes array
-// Columns: mode, name, iconName, displayFunc, availFunc, inputFunc, showInMenu, menuOrder, hints
+// Columns: mode, name, iconName, displayFunc, availFunc, inputFunc, showInMenu, menuOrder, hints, refreshMs
 static const OLEDModeEntry authModes[] = { loginModeEntry, logoutModeEntry };
 
 REGISTER_OLED_MODE_MODULE(authModes, sizeof(authModes) / sizeof(authModes[0]), "Auth");
@@ -456,9 +456,9 @@ static bool automationsInputHandler(int deltaX, int deltaY, uint32_t newlyPresse
 // Mode Registration
 // ============================================================================
 
-// Columns: mode, name, iconName, displayFunc, availFunc, inputFunc, showInMenu, menuOrder, hints
+// Columns: mode, name, iconName, displayFunc, availFunc, inputFunc, showInMenu, menuOrder, hints, refreshMs
 static const OLEDModeEntry sAutomationsModes[] = {
-  { OLED_AUTOMATIONS, "Automations", "notify_automation", displayAutomations, nullptr, automationsInputHandler, false, -1, "B:Back" },
+  { OLED_AUTOMATIONS, "Automations", "notify_automation", displayAutomations, nullptr, automationsInputHandler, false, -1, "B:Back", OLED_REFRESH_POLL_SLOW },
 };
 
 REGISTER_OLED_MODE_MODULE(sAutomationsModes, sizeof(sAutomationsModes) / sizeof(sAutomationsModes[0]), "Automations");
@@ -301,10 +301,11 @@ static const OLEDModeEntry cliViewerEntry = {
   handleCLIViewerInput,
   true,
   92,
-  nullptr  // dynamic hints (shows line count)
+  nullptr,           // dynamic hints (shows line count)
+  OLED_REFRESH_POLL_LIVE // refreshMs
 };
 
-// Columns: mode, name, iconName, displayFunc, availFunc, inputFunc, showInMenu, menuOrder, hints
+// Columns: mode, name, iconName, displayFunc, availFunc, inputFunc, showInMenu, menuOrder, hints, refreshMs
 static const OLEDModeEntry cliViewerModes[] = { cliViewerEntry };
 
 REGISTER_OLED_MODE_MODULE(cliViewerModes, sizeof(cliViewerModes) / sizeof(cliViewerModes[0]), "CLIViewer");
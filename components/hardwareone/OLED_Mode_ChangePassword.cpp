@@ -348,7 +348,7 @@ static bool isChangePasswordModeAvailable(String* outReason) {
 // Mode Registration
 // ============================================================================
 
-// Columns: mode, name, iconName, displayFunc, availFunc, inputFunc, showInMenu, menuOrder, hints
+// Columns: mode, name, iconName, displayFunc, availFunc, inputFunc, showInMenu, menuOrder, hints, refreshMs
 static const OLEDModeEntry changePasswordModeEntries[] = {
   {
     OLED_CHANGE_PASSWORD,
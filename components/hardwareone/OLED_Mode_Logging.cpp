@@ -329,10 +329,11 @@ static const OLEDModeEntry loggingModeEntry = {
   handleLoggingModeInput,
   true,
   93,
-  "A:Select B:Back"
+  "A:Select B:Back",
+  OLED_REFRESH_POLL_SLOW // refreshMs
 };
 
-// Columns: mode, name, iconName, displayFunc, availFunc, inputFunc, showInMenu, menuOrder, hints
+// Columns: mode, name, iconName, displayFunc, availFunc, inputFunc, showInMenu, menuOrder, hints, refreshMs
 static const OLEDModeEntry loggingModes[] = { loggingModeEntry };
 
 REGISTER_OLED_MODE_MODULE(loggingModes, sizeof(loggingModes) / sizeof(loggingModes[0]), "Logging");
@@ -11,6 +11,7 @@
 
 #include <Adafruit_SSD1306.h>
 #include "System_Maps.h"
+#include "System_Mutex.h"
 #include "OLED_Utils.h"
 #include "System_FileManager.h"
 #include "i2csensor-seesaw.h"
@@ -86,6 +87,9 @@ static volatile bool sForceRender = false;
 // Render task handle
 static TaskHandle_t sRenderTaskHandle = nullptr;
 
+// Feature canvas reused across pans (render task only)
+static MapCanvas sMapCanvas;
+
 // Forward declaration
 static void mapRenderTask(void* param);
 
@@ -393,7 +397,8 @@ static void drawFeatures() {
   for (int i = gFeaturesScrollOffset; i < map.nameCount && displayIdx < itemsPerPage; i++) {
     oledDisplay->setCursor(0, 10 + displayIdx * 10);
     char nameBuf[22];
-    strncpy(nameBuf, map.names[i].name, 21);
+    const char* name = MapCore::getName(MapCore::getSortedNameIndex(i));
+    strncpy(nameBuf, name ? name : "", 21);
     nameBuf[21] = '\0';
     oledDisplay->print(nameBuf);
     displayIdx++;
@@ -437,26 +442,16 @@ static void drawRoutes() {
   
   // Iterate through all tiles to find transit features
   for (uint16_t tileIdx = 0; tileIdx < map.tileCount && routeCount < 32; tileIdx++) {
+    MapCacheGuard cacheGuard("oled.routes");  // Tile bytes stay ours until the next iteration
     size_t tileDataSize;
     const uint8_t* tileData = MapCore::loadTileData(tileIdx, &tileDataSize);
     if (!tileData || tileDataSize == 0) continue;
     
-    const uint8_t* ptr = tileData;
-    const uint8_t* end = tileData + tileDataSize;
-    
-    // Feature count is at the START of each tile's payload (2 bytes)
-    if (ptr + 2 > end) continue;
-    uint16_t featureCount = ptr[0] | (ptr[1] << 8);
-    ptr += 2;
-    
-    for (uint16_t f = 0; f < featureCount && routeCount < 32; f++) {
-      if (ptr + HWMAP_FEATURE_HEADER_SIZE > end) break;
-      
-      uint8_t type = ptr[0];
-      // type(1) + subtype(1) + nameIndex(2) + pointCount(2)
-      uint16_t nameIdx = ptr[2] | (ptr[3] << 8);
-      uint16_t pointCount = ptr[4] | (ptr[5] << 8);
-      ptr += HWMAP_FEATURE_HEADER_SIZE + pointCount * 4;  // Skip header + quantized points
+    MapTileReader reader(tileData, tileDataSize, map.header.version);
+    MapFeatureInfo info;
+    while (routeCount < 32 && reader.next(info)) {
+      uint8_t type = info.type;
+      uint16_t nameIdx = info.nameIndex;
       
       // Check if transit type (rail=0x20, bus=0x21, ferry=0x22) with name
       if ((type == 0x20 || type == 0x21 || type == 0x22) && nameIdx != 0xFFFF) {
@@ -588,24 +583,33 @@ static void scanTrackFiles() {
     File file = root.openNextFile();
     while (file && gTrackFileCount < 8) {
       if (!file.isDirectory()) {
-        // Check if file has GPS data
-        File check = LittleFS.open(file.path(), "r");
-        if (check) {
-          bool hasGPS = false;
-          for (int i = 0; i < 15 && check.available(); i++) {
-            String line = check.readStringUntil('\n');
-            if (isGPSDataLine(line)) {
-              hasGPS = true;
-              break;
+        bool hasGPS = false;
+        const char* path = file.path();
+        size_t pathLen = strlen(path);
+        size_t extLen = strlen(GPS_TRACK_EXT);
+        if (pathLen > extLen && strcmp(path + pathLen - extLen, GPS_TRACK_EXT) == 0) {
+          // Binary track; skip the cached copy of a log that is listed itself
+          String source = String(path).substring(0, pathLen - extLen);
+          hasGPS = !LittleFS.exists(source.c_str());
+        } else {
+          // Check if file has GPS data
+          File check = LittleFS.open(path, "r");
+          if (check) {
+            for (int i = 0; i < 15 && check.available(); i++) {
+              String line = check.readStringUntil('\n');
+              if (isGPSDataLine(line)) {
+                hasGPS = true;
+                break;
+              }
             }
-          }
-          check.close();
-          
-          if (hasGPS) {
-            strlcpy(gTrackFiles[gTrackFileCount], file.path(), 64);
-            gTrackFileCount++;
+            check.close();
           }
         }
+        
+        if (hasGPS) {
+          strlcpy(gTrackFiles[gTrackFileCount], path, 64);
+          gTrackFileCount++;
+        }
       }
       file = root.openNextFile();
     }
@@ -881,6 +885,11 @@ static void initAsyncMapRenderer() {
   sMapBackBuf  = sMapBufB;
   sFrontBufReady = false;
   
+  // Without the canvas every frame is a full renderMap, which still works
+  if (!sMapCanvas.begin(DISPLAY_WIDTH, DISPLAY_CONTENT_HEIGHT)) {
+    Serial.println("[MAP_ASYNC] Canvas alloc failed, panning will redraw in full");
+  }
+  
   // Create render semaphore
   sRenderSemaphore = xSemaphoreCreateBinary();
   
@@ -910,6 +919,7 @@ static void mapRenderTask(void* param) {
     renderParams.rotation = rotation;
     renderParams.visibleLayers = sRenderSnapshot.visibleLayers;
     memcpy(renderParams.subtypeVisibility, sRenderSnapshot.subtypeVisibility, sizeof(renderParams.subtypeVisibility));
+    renderParams.liveOverlays = true;
     hasTrack = sRenderSnapshot.hasTrack;
     trackScaleX = sRenderSnapshot.trackScaleX;
     trackScaleY = sRenderSnapshot.trackScaleY;
@@ -924,7 +934,17 @@ static void mapRenderTask(void* param) {
     OffscreenMapRenderer localRenderer(backBuf, DISPLAY_WIDTH, DISPLAY_CONTENT_HEIGHT, DISPLAY_CONTENT_START_Y);
     localRenderer.clear();
     
-    MapCore::renderMap(&localRenderer, lat, lon, renderParams);
+    // Features come from the canvas when it can serve the view (pans then only
+    // render newly exposed strips); overlays are drawn fresh over its window at
+    // the centre it snapped to. Rotated or highlighted views render in full.
+    if (sMapCanvas.update(lat, lon, renderParams)) {
+      sMapCanvas.blit(backBuf, DISPLAY_CONTENT_START_Y);
+      lat = sMapCanvas.snappedLat();
+      lon = sMapCanvas.snappedLon();
+      MapCore::renderMapOverlays(&localRenderer, lat, lon, renderParams);
+    } else {
+      MapCore::renderMap(&localRenderer, lat, lon, renderParams);
+    }
     
     // Render GPS track if loaded
     if (hasTrack && GPSTrackManager::hasTrack()) {
@@ -1583,54 +1603,44 @@ static bool gpsMapInputHandler(int deltaX, int deltaY, uint32_t newlyPressed) {
       gSearchResult[sizeof(gSearchResult) - 1] = '\0';
       DEBUG_SENSORSF("[MAP_SEARCH] Selected: '%s'", gSearchResult);
       
-      // Find ALL matching features (iterate through tiles)
+      // Find ALL matching features via the name index (exact, case-sensitive)
       gSearchResultCount = 0;
       gSearchResultCurrent = 0;
+      MapCacheGuard cacheGuard("oled.search");
       const LoadedMap& map = MapCore::getCurrentMap();
       if (map.valid && map.tileDir && gSearchResult[0] != '\0') {
-        // Iterate through all tiles
-        for (uint16_t tileIdx = 0; tileIdx < map.tileCount && gSearchResultCount < 32; tileIdx++) {
-          size_t tileDataSize;
-          const uint8_t* tileData = MapCore::loadTileData(tileIdx, &tileDataSize);
-          if (!tileData || tileDataSize == 0) continue;
-          
-          // Calculate tile halo bounds for dequantization
-          int tx = tileIdx % map.tileGridSize;
-          int ty = tileIdx / map.tileGridSize;
-          int32_t tileMinLon = map.header.minLon + tx * map.tileW - map.haloW;
-          int32_t tileMinLat = map.header.minLat + ty * map.tileH - map.haloH;
-          int32_t haloLonSpan = map.tileW + 2 * map.haloW;
-          int32_t haloLatSpan = map.tileH + 2 * map.haloH;
-          
-          const uint8_t* ptr = tileData;
-          const uint8_t* end = tileData + tileDataSize;
-          
-          // Feature count is at the START of each tile's payload (2 bytes)
-          if (ptr + 2 > end) continue;
-          uint16_t featureCount = ptr[0] | (ptr[1] << 8);
-          ptr += 2;
+        uint32_t first = 0;
+        uint32_t matches = MapCore::findNamePrefixRange(gSearchResult, &first);
+        for (uint32_t m = 0; m < matches && gSearchResultCount < 32; m++) {
+          uint16_t nameIndex = MapCore::getSortedNameIndex(first + m);
+          const char* featureName = MapCore::getName(nameIndex);
+          if (!featureName || strcmp(featureName, gSearchResult) != 0) continue;
           
-          for (uint16_t f = 0; f < featureCount && gSearchResultCount < 32; f++) {
-            if (ptr + HWMAP_FEATURE_HEADER_SIZE > end) break;
+          MapNameRef refs[32];
+          int refCount = MapCore::findFeaturesByName(nameIndex, refs, 32 - gSearchResultCount);
+          for (int r = 0; r < refCount; r++) {
+            size_t tileDataSize;
+            const uint8_t* tileData = MapCore::loadTileData(refs[r].tileIdx, &tileDataSize);
+            if (!tileData) continue;
+            MapTileReader reader(tileData, tileDataSize, map.header.version);
+            MapFeatureInfo info;
+            uint16_t qLat, qLon;
+            if (!reader.seek(refs[r].offset, info) || !reader.point(qLat, qLon)) continue;
             
-            // type(1) + subtype(1) + nameIndex(2) + pointCount(2)
-            uint16_t nameIndex = ptr[2] | (ptr[3] << 8);
-            uint16_t pointCount = ptr[4] | (ptr[5] << 8);
+            // Calculate tile halo bounds for dequantization
+            int tx = refs[r].tileIdx % map.tileGridSize;
+            int ty = refs[r].tileIdx / map.tileGridSize;
+            int32_t tileMinLon = map.header.minLon + tx * map.tileW - map.haloW;
+            int32_t tileMinLat = map.header.minLat + ty * map.tileH - map.haloH;
+            int32_t haloLonSpan = map.tileW + 2 * map.haloW;
+            int32_t haloLatSpan = map.tileH + 2 * map.haloH;
             
-            const char* featureName = MapCore::getName(nameIndex);
-            if (featureName && strcmp(featureName, gSearchResult) == 0 && pointCount > 0) {
-              // Dequantize first point and store coordinates (points start after header)
-              const uint8_t* pointsPtr = ptr + HWMAP_FEATURE_HEADER_SIZE;
-              uint16_t qLat = pointsPtr[0] | (pointsPtr[1] << 8);
-              uint16_t qLon = pointsPtr[2] | (pointsPtr[3] << 8);
-              int32_t lat = tileMinLat + (int32_t)((int64_t)qLat * haloLatSpan >> 16);
-              int32_t lon = tileMinLon + (int32_t)((int64_t)qLon * haloLonSpan >> 16);
-              gSearchResultCoords[gSearchResultCount].lat = lat / 1000000.0f;
-              gSearchResultCoords[gSearchResultCount].lon = lon / 1000000.0f;
-              gSearchResultCount++;
-            }
-            
-            ptr += HWMAP_FEATURE_HEADER_SIZE + pointCount * 4;  // Skip to next feature
+            // Dequantize first point and store coordinates
+            int32_t lat = tileMinLat + (int32_t)((int64_t)qLat * haloLatSpan >> 16);
+            int32_t lon = tileMinLon + (int32_t)((int64_t)qLon * haloLonSpan >> 16);
+            gSearchResultCoords[gSearchResultCount].lat = lat / 1000000.0f;
+            gSearchResultCoords[gSearchResultCount].lon = lon / 1000000.0f;
+            gSearchResultCount++;
           }
         }
         
@@ -1756,6 +1766,7 @@ static bool gpsMapInputHandler(int deltaX, int deltaY, uint32_t newlyPressed) {
     int routeCount = 0;
     if (map.valid && map.tileDir) {
       for (uint16_t tileIdx = 0; tileIdx < map.tileCount && routeCount < 32; tileIdx++) {
+        MapCacheGuard cacheGuard("oled.routes");
         size_t tileDataSize;
         const uint8_t* tileData = MapCore::loadTileData(tileIdx, &tileDataSize);
         if (!tileData || tileDataSize == 0) continue;
@@ -1768,35 +1779,23 @@ static bool gpsMapInputHandler(int deltaX, int deltaY, uint32_t newlyPressed) {
         int32_t haloLonSpan = map.tileW + 2 * map.haloW;
         int32_t haloLatSpan = map.tileH + 2 * map.haloH;
         
-        const uint8_t* ptr = tileData;
-        const uint8_t* end = tileData + tileDataSize;
-        
-        // Feature count is at the START of each tile's payload (2 bytes)
-        if (ptr + 2 > end) continue;
-        uint16_t featureCount = ptr[0] | (ptr[1] << 8);
-        ptr += 2;
-        
-        for (uint16_t f = 0; f < featureCount && routeCount < 32; f++) {
-          if (ptr + HWMAP_FEATURE_HEADER_SIZE > end) break;
-          
-          uint8_t type = ptr[0];
-          // type(1) + subtype(1) + nameIndex(2) + pointCount(2)
-          uint16_t nameIdx = ptr[2] | (ptr[3] << 8);
-          uint16_t pointCount = ptr[4] | (ptr[5] << 8);
+        MapTileReader reader(tileData, tileDataSize, map.header.version);
+        MapFeatureInfo info;
+        while (routeCount < 32 && reader.next(info)) {
+          uint8_t type = info.type;
+          uint16_t nameIdx = info.nameIndex;
           
           // Check for transit types (rail, bus, ferry)
-          if ((type == 0x20 || type == 0x21 || type == 0x22) && nameIdx != 0xFFFF && pointCount > 0) {
+          if ((type == 0x20 || type == 0x21 || type == 0x22) && nameIdx != 0xFFFF && info.pointCount > 0) {
             const char* name = MapCore::getName(nameIdx);
             if (name && name[0]) {
               bool dup = false;
               for (int i = 0; i < routeCount; i++) {
                 if (strcmp(routeList[i].name, name) == 0 && routeList[i].type == type) { dup = true; break; }
               }
-              if (!dup) {
-                // Dequantize first point for goto functionality (points start after header)
-                const uint8_t* pointsPtr = ptr + HWMAP_FEATURE_HEADER_SIZE;
-                uint16_t qLat = pointsPtr[0] | (pointsPtr[1] << 8);
-                uint16_t qLon = pointsPtr[2] | (pointsPtr[3] << 8);
+              uint16_t qLat, qLon;
+              if (!dup && reader.point(qLat, qLon)) {
+                // Dequantize first point for goto functionality
                 int32_t lat = tileMinLat + (int32_t)((int64_t)qLat * haloLatSpan >> 16);
                 int32_t lon = tileMinLon + (int32_t)((int64_t)qLon * haloLonSpan >> 16);
                 
@@ -1808,8 +1807,6 @@ static bool gpsMapInputHandler(int deltaX, int deltaY, uint32_t newlyPressed) {
               }
             }
           }
-          
-          ptr += HWMAP_FEATURE_HEADER_SIZE + pointCount * 4;  // Skip to next feature
         }
       }
     }
@@ -2137,7 +2134,7 @@ static bool gpsMapInputHandler(int deltaX, int deltaY, uint32_t newlyPressed) {
 }
 
 // Map OLED mode entry
-// Columns: mode, name, iconName, displayFunc, availFunc, inputFunc, showInMenu, menuOrder, hints
+// Columns: mode, name, iconName, displayFunc, availFunc, inputFunc, showInMenu, menuOrder, hints, refreshMs
 static const OLEDModeEntry gpsMapOLEDModes[] = {
   {
     OLED_GPS_MAP,
@@ -2148,7 +2145,8 @@ static const OLEDModeEntry gpsMapOLEDModes[] = {
     gpsMapInputHandler,
     true,
     50,
-    nullptr  // dynamic hints (menu vs map view)
+    nullptr,           // dynamic hints (menu vs map view)
+    OLED_REFRESH_POLL_SLOW // refreshMs
   }
 };
 
@@ -499,7 +499,7 @@ static bool sensorMenuInputHandler(int deltaX, int deltaY, uint32_t newlyPressed
   return false;
 }
 
-// Columns: mode, name, iconName, displayFunc, availFunc, inputFunc, showInMenu, menuOrder, hints
+// Columns: mode, name, iconName, displayFunc, availFunc, inputFunc, showInMenu, menuOrder, hints, refreshMs
 static const OLEDModeEntry sSensorMenuModes[] = {
   { OLED_SENSOR_MENU, "Sensors", "sensor", displaySensorMenu, nullptr, sensorMenuInputHandler, false, -1, "A:Select B:Back" },
 };
@@ -198,7 +198,7 @@ static bool powerSleepInputHandler(int deltaX, int deltaY, uint32_t newlyPressed
 // Power Mode Registration
 // ============================================================================
 
-// Columns: mode, name, iconName, displayFunc, availFunc, inputFunc, showInMenu, menuOrder, hints
+// Columns: mode, name, iconName, displayFunc, availFunc, inputFunc, showInMenu, menuOrder, hints, refreshMs
 static const OLEDModeEntry sPowerModes[] = {
   { OLED_POWER,       "Power",    "power", displayPower,      nullptr, powerMainInputHandler,  false, -1, "A:Select B:Back" },
   { OLED_POWER_CPU,   "CPU Power","power", displayPowerCPU,   nullptr, powerCpuInputHandler,   false, -1, "A:Execute B:Back" },
@@ -573,7 +573,7 @@ bool bondModeInputHandler(int deltaX, int deltaY, uint32_t newlyPressed) {
 // ============================================================================
 
 static const OLEDModeEntry sRemoteModes[] = {
-  { OLED_REMOTE, "Bond", "notify_espnow", displayRemoteMode, nullptr, bondModeInputHandler, false, -1, "A:Select  B:Back" },
+  { OLED_REMOTE, "Bond", "notify_espnow", displayRemoteMode, nullptr, bondModeInputHandler, false, -1, "A:Select  B:Back", OLED_REFRESH_POLL_SLOW },
 };
 
 REGISTER_OLED_MODE_MODULE(sRemoteModes, sizeof(sRemoteModes) / sizeof(sRemoteModes[0]), "Bond");
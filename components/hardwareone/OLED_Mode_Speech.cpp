@@ -248,7 +248,7 @@ bool speechInputHandler(int deltaX, int deltaY, uint32_t newlyPressed) {
 // OLED Mode Registration
 // ============================================================================
 
-// Columns: mode, name, iconName, displayFunc, availFunc, inputFunc, showInMenu, menuOrder, hints
+// Columns: mode, name, iconName, displayFunc, availFunc, inputFunc, showInMenu, menuOrder, hints, refreshMs
 static const OLEDModeEntry speechModeEntries[] = {
   {
     OLED_SPEECH,          // mode
@@ -259,7 +259,8 @@ static const OLEDModeEntry speechModeEntries[] = {
     speechInputHandler,   // inputFunc
     true,                 // showInMenu
     50,                   // menuOrder
-    "X:Select B:Back"     // hints
+    "X:Select B:Back",    // hints
+    OLED_REFRESH_POLL_LIVE // refreshMs
   }
 };
 
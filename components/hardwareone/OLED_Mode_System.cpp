@@ -475,9 +475,9 @@ void displaySystemStatusRendered() {
 // ============================================================================
 
 static const OLEDModeEntry sSystemModes[] = {
-  { OLED_SYSTEM_STATUS, "System",    "settings", displaySystemStatusRendered, nullptr, nullptr, false, -1, "B:Back" },
+  { OLED_SYSTEM_STATUS, "System",    "settings", displaySystemStatusRendered, nullptr, nullptr, false, -1, "B:Back", OLED_REFRESH_POLL_SLOW },
   { OLED_CUSTOM_TEXT,   "Text",      "text",     displayCustomText,           nullptr, nullptr, false, -1, "B:Back" },
-  { OLED_MEMORY_STATS,  "Memory",    "memory",   displayMemoryStatsRendered,  nullptr, nullptr, false, -1, "B:Back" },
+  { OLED_MEMORY_STATS,  "Memory",    "memory",   displayMemoryStatsRendered,  nullptr, nullptr, false, -1, "B:Back", OLED_REFRESH_POLL_SLOW },
   { OLED_UNAVAILABLE,   "Unavail",   nullptr,    displayUnavailable,          nullptr, nullptr, false, -1, nullptr  },  // dynamic hints
 };
 
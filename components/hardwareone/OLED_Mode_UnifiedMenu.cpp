@@ -612,7 +612,7 @@ static const OLEDModeEntry unifiedMenuModeEntry = {
   "A:Run X:Refresh B:Back"
 };
 
-// Columns: mode, name, iconName, displayFunc, availFunc, inputFunc, showInMenu, menuOrder, hints
+// Columns: mode, name, iconName, displayFunc, availFunc, inputFunc, showInMenu, menuOrder, hints, refreshMs
 static const OLEDModeEntry unifiedMenuModes[] = { unifiedMenuModeEntry };
 
 REGISTER_OLED_MODE_MODULE(unifiedMenuModes, 1, "UnifiedMenu");
@@ -163,7 +163,7 @@ static void renderToggleList(const char* title, SetupWizardPage page,
   }
   
   drawWizardFooter(footerLeft, footerRight, footerBack);
-  OLED_TRANSACTION(oledDisplay->display());
+  OLED_TRANSACTION(displayFlushLocked());
 }
 
 void renderFeaturesPage() {
@@ -241,7 +241,7 @@ void renderNetworkPage() {
   }
 
   drawWizardFooter("Toggle", "Next", "Back");
-  OLED_TRANSACTION(oledDisplay->display());
+  OLED_TRANSACTION(displayFlushLocked());
 }
 
 void renderSystemPage() {
@@ -363,7 +363,7 @@ void renderSystemPage() {
   }
 
   drawWizardFooter("Change", "Next", "Back");
-  OLED_TRANSACTION(oledDisplay->display());
+  OLED_TRANSACTION(displayFlushLocked());
 }
 
 bool renderWiFiPage(SetupWizardResult& result) {
@@ -379,7 +379,7 @@ bool renderWiFiPage(SetupWizardResult& result) {
     oledDisplay->println("press B to go back");
     
     drawWizardFooter("Select", "Done", "Back");
-    OLED_TRANSACTION(oledDisplay->display());
+    OLED_TRANSACTION(displayFlushLocked());
     
     // Wait a moment then launch WiFi selector
     delay(500);
@@ -590,7 +590,7 @@ static int showWizardOptionalPageIntro(SetupWizardPage page, const char* title,
     oledDisplay->println(" Skip");
 
     drawWizardFooter("Select", "", "Back");
-    OLED_TRANSACTION(oledDisplay->display());
+    OLED_TRANSACTION(displayFlushLocked());
 
     delay(50);
 
@@ -673,7 +673,7 @@ void handleOLEDESPNowPage(SetupWizardResult& result, bool& running) {
       oledDisplay->print(selection == 1 ? ">" : " ");
       oledDisplay->println(" Stationary");
       drawWizardFooter("Select", "", "Back");
-      OLED_TRANSACTION(oledDisplay->display());
+      OLED_TRANSACTION(displayFlushLocked());
 
       delay(50);
 
@@ -844,7 +844,7 @@ bool getOLEDSetupModeSelection(int& setupMode) {
       oledDisplay->setCursor(0, footerY + 2);
       oledDisplay->print("A:Select  Joy:Move");
 
-      OLED_TRANSACTION(oledDisplay->display());
+      OLED_TRANSACTION(displayFlushLocked());
     }
 
     delay(50);
@@ -964,7 +964,7 @@ bool getOLEDThemeSelection(bool& darkMode) {
       oledDisplay->setCursor(0, footerY + 2);
       oledDisplay->print("A:Select  Joy:Move");
       
-      OLED_TRANSACTION(oledDisplay->display());
+      OLED_TRANSACTION(displayFlushLocked());
     }
     
     delay(50);
@@ -2462,6 +2462,9 @@ static uint32_t oledLastRenderedGamepadSeq = 0;
 static unsigned long oledLastRenderedSensorSeq = 0;
 static bool oledForceNextRender = true;  // Force first render
 static unsigned long oledDirtyUntilMs = 0;  // Keep rendering dirty until this time (for timed popups)
+static unsigned long oledLastRenderMs = 0;  // Last completed render (for per-mode refreshMs)
+static volatile uint32_t oledModeDataSeq = 0;  // Bumped by oledMarkDirtyMode() (sensor tasks)
+static uint32_t oledLastRenderedModeDataSeq = 0;
 
 // Manual dirty flag for non-sensor changes (menu state, settings, etc.)
 void oledMarkDirty() {
@@ -2469,8 +2472,9 @@ void oledMarkDirty() {
 }
 
 void oledMarkDirtyMode(OLEDMode mode) {
-  // For compatibility - any mode change triggers dirty
-  oledForceNextRender = true;
+  // Data owners can invalidate their own screen without waking unrelated modes;
+  // oledUpdate() holds the redraw back until the mode's refreshMs has passed
+  if (mode == currentOLEDMode) oledModeDataSeq++;
 }
 
 void oledMarkDirtyUntil(unsigned long untilMs) {
@@ -2496,6 +2500,8 @@ void oledClearDirty() {
   oledForceNextRender = false;
   oledLastRenderedGamepadSeq = gControlCache.gamepadSeq;
   oledLastRenderedSensorSeq = gSensorStatusSeq;
+  oledLastRenderedModeDataSeq = oledModeDataSeq;
+  oledLastRenderMs = millis();
 }
 
 void oledSetAlwaysDirty(bool always) {
@@ -2665,6 +2671,11 @@ const OLEDModeEntry* findOLEDMode(OLEDMode mode) {
   return nullptr;
 }
 
+uint16_t oledModeRefreshMs(OLEDMode mode) {
+  const OLEDModeEntry* entry = findOLEDMode(mode);
+  return entry ? entry->refreshMs : OLED_REFRESH_ON_CHANGE;
+}
+
 const OLEDModeEntry* getRegisteredOLEDModes() {
   // Return first entry (caller should use getRegisteredOLEDModeCount for iteration)
   return oledModeRegistrySize > 0 ? oledModeRegistry[0] : nullptr;
@@ -3021,8 +3032,17 @@ void updateOLEDDisplay() {
       return;  // Not time to check yet
     }
     
+    // refreshMs caps how often new data from the mode's owner redraws it; only
+    // POLL modes (no owner to signal them) redraw on the timer alone
+    uint16_t refresh = oledModeRefreshMs(currentOLEDMode);
+    uint16_t refreshMs = refresh & ~OLED_REFRESH_POLL_FLAG;
+    bool intervalDone = (now - oledLastRenderMs >= refreshMs);
+    bool refreshDue = (refresh & OLED_REFRESH_POLL_FLAG)
+                        ? intervalDone
+                        : (oledModeDataSeq != oledLastRenderedModeDataSeq && intervalDone);
+
     // Skip render if nothing changed (uses gamepadSeq + sensorStatusSeq)
-    if (!modeChanged && !oledIsDirty()) {
+    if (!modeChanged && !refreshDue && !oledIsDirty()) {
       oledLastUpdate = now;  // Reset timer even if we skip
       return;  // Nothing changed, skip expensive render
     }
@@ -3031,7 +3051,9 @@ void updateOLEDDisplay() {
   lastRenderedMode = currentOLEDMode;
 
   // Skip if OLED is degraded (will auto-retry after recovery timeout)
+  static bool wasDegraded = false;
   if (i2cDeviceIsDegraded(OLED_I2C_ADDRESS)) {
+    wasDegraded = true;
     static unsigned long lastDegradedLog = 0;
     unsigned long nowLog = millis();
     if ((isDebugFlagSet(DEBUG_MEMORY) || isDebugFlagSet(DEBUG_SYSTEM)) && (nowLog - lastDegradedLog > 2000)) {
@@ -3041,6 +3063,13 @@ void updateOLEDDisplay() {
     return;
   }
 
+  // The panel may have been reset while the bus was recovering, and a new mode
+  // redraws everything anyway: push the whole frame instead of a diff
+  if (wasDegraded || modeChanged) {
+    displayInvalidate();
+    wasDegraded = false;
+  }
+
   // Pre-gather data OUTSIDE I2C transaction to avoid blocking gamepad
   switch (currentOLEDMode) {
     case OLED_FILE_BROWSER:
@@ -3235,7 +3264,7 @@ const char* cmd_oled_enabled(const String& argsInput) {
       oledEnabled = false;
       i2cOledTransactionVoid(400000, 500, [&]() {
         oledDisplay->clearDisplay();
-        oledDisplay->display();
+        displayFlushLocked();
       });
     }
     snprintf(getDebugBuffer(), 1024, "OLED display disabled");
@@ -3474,7 +3503,7 @@ const char* cmd_oledmode(const String& argsInput) {
     case OLED_OFF:
       i2cOledTransactionVoid(400000, 500, [&]() {
         oledDisplay->clearDisplay();
-        oledDisplay->display();
+        displayFlushLocked();
       });
       break;
     default:
@@ -3531,7 +3560,7 @@ const char* cmd_oledclear(const String& argsInput) {
 
   i2cOledTransactionVoid(400000, 500, [&]() {
     oledDisplay->clearDisplay();
-    oledDisplay->display();
+    displayFlushLocked();
   });
 
   broadcastOutput("OLED display cleared");
@@ -3585,6 +3614,13 @@ const char* cmd_oledstatus(const String& argsInput) {
         }
       }
     }
+
+    DisplayFlushStats fs;
+    displayGetFlushStats(&fs);
+    snprintf(getDebugBuffer(), 1024, "Flushes: %lu (full %lu, idle %lu), windows=%lu, errors=%lu, bus=%llu bytes",
+             (unsigned long)fs.flushes, (unsigned long)fs.fullFlushes, (unsigned long)fs.idleFlushes,
+             (unsigned long)fs.windows, (unsigned long)fs.errors, (unsigned long long)fs.busBytes);
+    broadcastOutput(getDebugBuffer());
   }
 
   return "OK";
@@ -3894,6 +3930,7 @@ bool earlyOLEDInit() {
       return gDisplay->begin(SSD1306_SWITCHCAPVCC, detectedAddr);
     });
     if (beginOk) {
+      displayAttachI2C(detectedAddr);
       oledConnected = true;
       oledEnabled = true;
 
@@ -3918,7 +3955,7 @@ bool earlyOLEDInit() {
       i2cOledTransactionVoid(400000, 500, [&]() {
         oledDisplay->clearDisplay();
         displayAnimation();
-        oledDisplay->display();
+        displayFlushLocked();
       });
 
       DEBUG_SENSORSF("OLED boot animation started at 0x%02X", detectedAddr);
@@ -6135,6 +6172,7 @@ void oledDisplayOn() {
     i2cDeviceTransactionVoid(I2C_ADDR_OLED, 400000, 500, [&]() {
       oledDisplay->ssd1306_command(SSD1306_DISPLAYON);
     });
+    displayInvalidate();  // Panel RAM is not trusted across power-save
   }
 #endif
 }
@@ -6149,7 +6187,7 @@ void oledShowSleepScreen(int seconds) {
       oledDisplay->println("  Sleeping...");
       oledDisplay->println();
       oledDisplay->printf("  Waking in %ds", seconds);
-      oledDisplay->display();
+      displayFlushLocked();
     });
   }
 #endif
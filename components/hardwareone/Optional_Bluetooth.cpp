@@ -1896,7 +1896,7 @@ static bool bluetoothInputHandler(int deltaX, int deltaY, uint32_t newlyPressed)
 }
 
 // Bluetooth OLED mode entry
-// Columns: mode, name, iconName, displayFunc, availFunc, inputFunc, showInMenu, menuOrder, hints
+// Columns: mode, name, iconName, displayFunc, availFunc, inputFunc, showInMenu, menuOrder, hints, refreshMs
 static const OLEDModeEntry bluetoothOLEDModes[] = {
   {
     OLED_BLUETOOTH,          // mode enum
@@ -1907,7 +1907,8 @@ static const OLEDModeEntry bluetoothOLEDModes[] = {
     bluetoothInputHandler,   // inputFunc - X toggles BLE state
     true,                    // showInMenu
     45,                      // menuOrder (near ESP-NOW)
-    nullptr                  // dynamic hints
+    nullptr,                 // dynamic hints
+    OLED_REFRESH_POLL_SLOW   // refreshMs
   }
 };
 
@@ -0,0 +1,331 @@
+/**
+ * Audio Analysis - fixed-point spectrum and voice-activity detection
+ *
+ * FFT: radix-2 decimation-in-time on int16 with a 1/2 scale per stage (output
+ * is X/N), Q15 twiddles and window. The block is DC-removed and left-shifted so
+ * its peak uses ~14 bits before windowing; that shift is subtracted again in
+ * the log domain so quiet raw PDM input keeps its precision.
+ */
+
+#include "System_AudioAnalysis.h"
+
+#if ENABLE_MICROPHONE_SENSOR || ENABLE_ESP_SR
+
+#include <freertos/FreeRTOS.h>
+#include <freertos/semphr.h>
+#include <math.h>
+#include <new>
+
+#include "System_AudioCapture.h"
+#include "System_MemUtil.h"
+
+// ============================================================================
+// Spectrum analyzer
+// ============================================================================
+
+struct AudioSpectrumState {
+  uint16_t fftSize = 0;
+  uint8_t log2Size = 0;
+  uint8_t bins = 0;
+  AudioWindow window = AUDIO_WINDOW_HANN;
+  bool logBins = true;
+  int16_t twCos[AUDIO_SPECTRUM_MAX_FFT / 2];
+  int16_t twSin[AUDIO_SPECTRUM_MAX_FFT / 2];
+  int16_t win[AUDIO_SPECTRUM_MAX_FFT];
+  uint16_t bandEdge[AUDIO_SPECTRUM_MAX_BINS + 1];  // FFT bin index where each band starts
+  // Scratch (guarded by sSpectrumLock)
+  int16_t re[AUDIO_SPECTRUM_MAX_FFT];
+  int16_t im[AUDIO_SPECTRUM_MAX_FFT];
+  int16_t latestPcm[AUDIO_SPECTRUM_MAX_FFT];
+  // Cache for audioSpectrumLatest()
+  uint64_t latestIdx = 0;
+  uint8_t latestBins[AUDIO_SPECTRUM_MAX_BINS];
+  uint8_t latestCount = 0;
+};
+
+static AudioSpectrumState* sSpec = nullptr;
+static SemaphoreHandle_t sSpectrumLock = nullptr;
+
+// log2(p) in Q3 (1/8 octave steps); 0 for p == 0
+static inline int32_t log2Q3(uint32_t p) {
+  if (p == 0) return 0;
+  int msb = 31 - __builtin_clz(p);
+  uint32_t frac = (msb >= 3) ? (p >> (msb - 3)) : (p << (3 - msb));
+  return msb * 8 + (int32_t)(frac & 7);
+}
+
+static void buildBandEdges(AudioSpectrumState& s) {
+  const uint16_t first = 1;              // Skip DC
+  const uint16_t last = s.fftSize / 2;   // Exclusive upper bound
+  const uint16_t span = last - first;
+  for (uint8_t b = 0; b <= s.bins; b++) {
+    uint16_t edge;
+    if (s.logBins) {
+      edge = (uint16_t)(first * powf((float)last / (float)first, (float)b / (float)s.bins) + 0.5f);
+    } else {
+      edge = (uint16_t)(first + (uint32_t)span * b / s.bins);
+    }
+    // Every band covers at least one FFT bin
+    uint16_t minEdge = (b == 0) ? first : (uint16_t)(s.bandEdge[b - 1] + 1);
+    uint16_t maxEdge = (uint16_t)(last - (s.bins - b));
+    if (edge < minEdge) edge = minEdge;
+    if (edge > maxEdge) edge = maxEdge;
+    s.bandEdge[b] = edge;
+  }
+  s.bandEdge[s.bins] = last;
+}
+
+static bool ensureSpectrum() {
+  if (!sSpectrumLock) {
+    sSpectrumLock = xSemaphoreCreateMutex();
+    if (!sSpectrumLock) return false;
+  }
+  if (!sSpec) {
+    return audioSpectrumConfigure(AUDIO_SPECTRUM_DEFAULT_FFT, AUDIO_SPECTRUM_DEFAULT_BINS, AUDIO_WINDOW_HANN, true);
+  }
+  return true;
+}
+
+bool audioSpectrumConfigure(uint16_t fftSize, uint8_t bins, AudioWindow window, bool logBins) {
+  if (fftSize < AUDIO_SPECTRUM_MIN_FFT || fftSize > AUDIO_SPECTRUM_MAX_FFT || (fftSize & (fftSize - 1)) != 0) return false;
+  if (bins == 0 || bins > AUDIO_SPECTRUM_MAX_BINS || bins > fftSize / 2 - 1) return false;
+
+  if (!sSpectrumLock) {
+    sSpectrumLock = xSemaphoreCreateMutex();
+    if (!sSpectrumLock) return false;
+  }
+  xSemaphoreTake(sSpectrumLock, portMAX_DELAY);
+  if (!sSpec) {
+    sSpec = (AudioSpectrumState*)ps_alloc(sizeof(AudioSpectrumState), AllocPref::PreferPSRAM, "audio.spectrum");
+    if (!sSpec) {
+      xSemaphoreGive(sSpectrumLock);
+      return false;
+    }
+    new (sSpec) AudioSpectrumState();
+  }
+
+  AudioSpectrumState& s = *sSpec;
+  s.fftSize = fftSize;
+  s.log2Size = (uint8_t)(31 - __builtin_clz(fftSize));
+  s.bins = bins;
+  s.window = window;
+  s.logBins = logBins;
+
+  for (uint16_t k = 0; k < fftSize / 2; k++) {
+    float a = 2.0f * (float)M_PI * (float)k / (float)fftSize;
+    s.twCos[k] = (int16_t)lrintf(cosf(a) * 32767.0f);
+    s.twSin[k] = (int16_t)lrintf(sinf(a) * 32767.0f);
+  }
+  for (uint16_t n = 0; n < fftSize; n++) {
+    float w = (window == AUDIO_WINDOW_HANN)
+                ? 0.5f - 0.5f * cosf(2.0f * (float)M_PI * (float)n / (float)fftSize)
+                : 1.0f;
+    s.win[n] = (int16_t)lrintf(w * 32767.0f);
+  }
+  buildBandEdges(s);
+  s.latestIdx = 0;
+  s.latestCount = 0;
+
+  xSemaphoreGive(sSpectrumLock);
+  return true;
+}
+
+uint16_t audioSpectrumFftSize() {
+  return sSpec ? sSpec->fftSize : AUDIO_SPECTRUM_DEFAULT_FFT;
+}
+
+uint8_t audioSpectrumBinCount() {
+  return sSpec ? sSpec->bins : AUDIO_SPECTRUM_DEFAULT_BINS;
+}
+
+// In-place forward FFT of s.re/s.im (called with sSpectrumLock held)
+static void fftQ15(AudioSpectrumState& s) {
+  const uint16_t n = s.fftSize;
+  int16_t* re = s.re;
+  int16_t* im = s.im;
+
+  // Bit-reversal permutation
+  for (uint16_t i = 1, j = 0; i < n; i++) {
+    uint16_t bit = n >> 1;
+    for (; j & bit; bit >>= 1) j ^= bit;
+    j ^= bit;
+    if (i < j) {
+      int16_t t = re[i]; re[i] = re[j]; re[j] = t;
+      t = im[i]; im[i] = im[j]; im[j] = t;
+    }
+  }
+
+  // Butterflies, halving every stage so values stay in int16
+  for (uint16_t len = 2; len <= n; len <<= 1) {
+    uint16_t half = len >> 1;
+    uint16_t step = n / len;
+    for (uint16_t base = 0; base < n; base += len) {
+      for (uint16_t k = 0; k < half; k++) {
+        int32_t c = s.twCos[k * step];
+        int32_t sn = s.twSin[k * step];
+        uint16_t a = base + k;
+        uint16_t b = a + half;
+        // W = cos - j*sin (forward transform)
+        int32_t tr = ((int32_t)re[b] * c + (int32_t)im[b] * sn) >> 15;
+        int32_t ti = ((int32_t)im[b] * c - (int32_t)re[b] * sn) >> 15;
+        int32_t ar = re[a];
+        int32_t ai = im[a];
+        re[a] = (int16_t)((ar + tr) >> 1);
+        im[a] = (int16_t)((ai + ti) >> 1);
+        re[b] = (int16_t)((ar - tr) >> 1);
+        im[b] = (int16_t)((ai - ti) >> 1);
+      }
+    }
+  }
+}
+
+// Called with sSpectrumLock held
+static size_t computeLocked(AudioSpectrumState& s, const int16_t* pcm, uint8_t* outBins, size_t maxBins) {
+  const uint16_t n = s.fftSize;
+
+  // DC removal + block normalization so the FFT sees ~14 significant bits
+  int32_t sum = 0;
+  for (uint16_t i = 0; i < n; i++) sum += pcm[i];
+  int32_t mean = sum / (int32_t)n;
+  int32_t peak = 0;
+  for (uint16_t i = 0; i < n; i++) {
+    int32_t v = pcm[i] - mean;
+    if (v < 0) v = -v;
+    if (v > peak) peak = v;
+  }
+  int shift = 0;
+  if (peak > 0) {
+    while (shift < 15 && (peak << (shift + 1)) < 16384) shift++;
+  }
+
+  for (uint16_t i = 0; i < n; i++) {
+    int32_t v = (pcm[i] - mean) << shift;
+    if (v > 32767) v = 32767;
+    if (v < -32768) v = -32768;
+    s.re[i] = (int16_t)((v * s.win[i]) >> 15);
+    s.im[i] = 0;
+  }
+
+  fftQ15(s);
+
+  // Power per band; undo the normalization shift (power scales by 4^shift).
+  // With the 1/N output scaling a tone's bin power is independent of fftSize.
+  const int32_t offset = -16 * shift;
+  size_t count = (s.bins < maxBins) ? s.bins : maxBins;
+  for (size_t b = 0; b < count; b++) {
+    uint32_t acc = 0;
+    for (uint16_t k = s.bandEdge[b]; k < s.bandEdge[b + 1]; k++) {
+      uint32_t p = (uint32_t)((int32_t)s.re[k] * s.re[k]) + (uint32_t)((int32_t)s.im[k] * s.im[k]);
+      acc = (acc > UINT32_MAX - p) ? UINT32_MAX : acc + p;
+    }
+    int32_t v = (acc > 0) ? log2Q3(acc) + offset : 0;
+    outBins[b] = (uint8_t)(v < 0 ? 0 : (v > 255 ? 255 : v));
+  }
+  return count;
+}
+
+size_t audioSpectrumCompute(const int16_t* pcm, size_t samples, uint8_t* outBins, size_t maxBins) {
+  if (!pcm || !outBins || maxBins == 0 || !ensureSpectrum()) return 0;
+  xSemaphoreTake(sSpectrumLock, portMAX_DELAY);
+  size_t count = 0;
+  if (samples >= sSpec->fftSize) {
+    count = computeLocked(*sSpec, pcm, outBins, maxBins);
+  }
+  xSemaphoreGive(sSpectrumLock);
+  return count;
+}
+
+size_t audioSpectrumLatest(uint8_t* outBins, size_t maxBins) {
+  if (!outBins || maxBins == 0 || !audioCaptureRunning() || !ensureSpectrum()) return 0;
+
+  xSemaphoreTake(sSpectrumLock, portMAX_DELAY);
+  AudioSpectrumState& s = *sSpec;
+  uint64_t endIdx = 0;
+  size_t count = 0;
+  if (audioCapturePeekLatest(s.latestPcm, s.fftSize, &endIdx) == s.fftSize) {
+    // Reuse the previous result while no new capture block has arrived
+    if (endIdx != s.latestIdx || s.latestCount == 0) {
+      s.latestCount = (uint8_t)computeLocked(s, s.latestPcm, s.latestBins, AUDIO_SPECTRUM_MAX_BINS);
+      s.latestIdx = endIdx;
+    }
+    count = (s.latestCount < maxBins) ? s.latestCount : maxBins;
+    memcpy(outBins, s.latestBins, count);
+  }
+  xSemaphoreGive(sSpectrumLock);
+  return count;
+}
+
+// ============================================================================
+// Voice-activity detector
+// ============================================================================
+
+#define VAD_PRIME_FRAMES   8    // Frames averaged for the initial noise floor
+#define VAD_MIN_FLOOR      4    // Raw PDM idle noise is a few LSB; keeps ratios meaningful
+
+bool audioVadProcess(AudioVadState& st, const AudioVadConfig& cfg, const int16_t* pcm, size_t samples, uint32_t sampleRate) {
+  if (!pcm || samples < 2) return st.speech;
+
+  // One pass for the mean, one for energy and zero crossings around it
+  int32_t sum = 0;
+  for (size_t i = 0; i < samples; i++) sum += pcm[i];
+  int32_t mean = sum / (int32_t)samples;
+
+  uint64_t energySum = 0;
+  uint32_t crossings = 0;
+  int32_t prev = pcm[0] - mean;
+  for (size_t i = 0; i < samples; i++) {
+    int32_t v = pcm[i] - mean;
+    energySum += (uint64_t)((int64_t)v * v);
+    crossings += ((v ^ prev) < 0);
+    prev = v;
+  }
+  uint32_t energy = (uint32_t)(energySum / samples);
+  uint16_t zcrQ8 = (uint16_t)((crossings << 8) / samples);
+  st.lastEnergy = energy;
+  st.lastZcrQ8 = zcrQ8;
+  st.totalFrames++;
+
+  // Prime the floor from the first frames (assumed mostly background)
+  if (st.primeFrames < VAD_PRIME_FRAMES) {
+    st.noiseFloor = (st.primeFrames == 0) ? energy : (st.noiseFloor + energy) / 2;
+    if (st.noiseFloor < VAD_MIN_FLOOR) st.noiseFloor = VAD_MIN_FLOOR;
+    st.primeFrames++;
+    return st.speech;
+  }
+
+  uint64_t floorQ4 = (uint64_t)st.noiseFloor;
+  uint64_t energyQ4 = (uint64_t)energy << 4;
+  uint16_t ratio = st.speech ? cfg.holdRatioQ4 : cfg.onsetRatioQ4;
+  bool loud = energyQ4 > floorQ4 * ratio;
+  // Unvoiced consonants: moderate energy but high zero-crossing rate
+  bool fricative = (energyQ4 > floorQ4 * (cfg.holdRatioQ4 / 2 + 8)) && (zcrQ8 >= cfg.fricativeZcrQ8);
+  bool speechFrame = loud || fricative;
+
+  // Noise floor tracks quickly downward and slowly upward, and barely moves during speech
+  if (!speechFrame) {
+    if (energy < st.noiseFloor) st.noiseFloor -= (st.noiseFloor - energy) >> 2;
+    else st.noiseFloor += (energy - st.noiseFloor) >> 4;
+  } else if (energy > st.noiseFloor) {
+    st.noiseFloor += (energy - st.noiseFloor) >> 9;
+  }
+  if (st.noiseFloor < VAD_MIN_FLOOR) st.noiseFloor = VAD_MIN_FLOOR;
+
+  uint32_t hangover = (uint32_t)((uint64_t)cfg.hangoverMs * sampleRate / 1000);
+  if (speechFrame) {
+    st.speechFrames++;
+    if (st.onsetCount < 255) st.onsetCount++;
+    if (st.speech || st.onsetCount >= cfg.onsetFrames) {
+      st.speech = true;
+      st.hangSamples = hangover;
+    }
+  } else {
+    st.onsetCount = 0;
+    if (st.speech) {
+      st.hangSamples = (st.hangSamples > samples) ? (st.hangSamples - (uint32_t)samples) : 0;
+      if (st.hangSamples == 0) st.speech = false;
+    }
+  }
+  return st.speech;
+}
+
+#endif // ENABLE_MICROPHONE_SENSOR || ENABLE_ESP_SR
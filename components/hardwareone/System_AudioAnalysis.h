@@ -0,0 +1,78 @@
+/**
+ * Audio Analysis - fixed-point spectrum and voice-activity detection
+ *
+ * Both work on raw PCM blocks from the shared capture ring (System_AudioCapture):
+ *  - The VAD runs inside the capture task on every block (one pass: mean,
+ *    energy, zero crossings) and publishes a speech/silence flag that ESP-SR
+ *    and snippet capture use to skip work during silence.
+ *  - The spectrum is computed on demand from the newest ring samples and cached
+ *    per capture block, so the OLED, web card and CLI share one FFT.
+ */
+
+#ifndef SYSTEM_AUDIO_ANALYSIS_H
+#define SYSTEM_AUDIO_ANALYSIS_H
+
+#include <Arduino.h>
+#include "System_BuildConfig.h"
+
+#if ENABLE_MICROPHONE_SENSOR || ENABLE_ESP_SR
+
+// ============================================================================
+// Spectrum analyzer
+// ============================================================================
+
+#define AUDIO_SPECTRUM_MIN_FFT      64
+#define AUDIO_SPECTRUM_MAX_FFT      512
+#define AUDIO_SPECTRUM_MAX_BINS     64
+#define AUDIO_SPECTRUM_DEFAULT_FFT  256
+#define AUDIO_SPECTRUM_DEFAULT_BINS 32
+
+enum AudioWindow : uint8_t {
+  AUDIO_WINDOW_RECT = 0,
+  AUDIO_WINDOW_HANN
+};
+
+// fftSize must be a power of two in [MIN_FFT, MAX_FFT]; bins in [1, min(MAX_BINS, fftSize/2)].
+// logBins spaces band edges logarithmically (more resolution at low frequencies).
+bool audioSpectrumConfigure(uint16_t fftSize, uint8_t bins, AudioWindow window, bool logBins);
+uint16_t audioSpectrumFftSize();
+uint8_t audioSpectrumBinCount();
+
+// Spectrum of pcm[0..fftSize) (pcm must hold at least fftSize samples). Each
+// output byte is band power in 1/8-octave steps (~0.38 dB), 0 = silence and
+// ~208 = full-scale sine. Returns bins written.
+size_t audioSpectrumCompute(const int16_t* pcm, size_t samples, uint8_t* outBins, size_t maxBins);
+
+// Spectrum of the newest capture ring samples (0 if capture is idle)
+size_t audioSpectrumLatest(uint8_t* outBins, size_t maxBins);
+
+// ============================================================================
+// Voice-activity detector
+// ============================================================================
+
+struct AudioVadConfig {
+  uint16_t onsetRatioQ4 = 96;    // Energy over noise floor to start speech (6.0x, ~7.8 dB)
+  uint16_t holdRatioQ4 = 48;     // Energy over noise floor to keep speech (3.0x)
+  uint16_t fricativeZcrQ8 = 77;  // Zero-crossing rate (0.30) that counts quieter frames as speech
+  uint16_t hangoverMs = 300;     // Keep "speech" this long after the last speech frame
+  uint8_t onsetFrames = 2;       // Consecutive speech frames needed to start
+};
+
+struct AudioVadState {
+  uint32_t noiseFloor = 0;       // Mean-square energy of background noise (raw PCM units)
+  uint32_t lastEnergy = 0;
+  uint16_t lastZcrQ8 = 0;
+  uint8_t onsetCount = 0;
+  uint8_t primeFrames = 0;       // Frames averaged into the initial floor
+  uint32_t hangSamples = 0;      // Remaining hangover
+  bool speech = false;
+  uint32_t speechFrames = 0;
+  uint32_t totalFrames = 0;
+};
+
+// Classify one block and update state. Returns state.speech.
+bool audioVadProcess(AudioVadState& st, const AudioVadConfig& cfg, const int16_t* pcm, size_t samples, uint32_t sampleRate);
+
+#endif // ENABLE_MICROPHONE_SENSOR || ENABLE_ESP_SR
+
+#endif // SYSTEM_AUDIO_ANALYSIS_H
@@ -0,0 +1,536 @@
+/**
+ * Audio Capture - shared PDM capture ring with per-consumer cursors
+ *
+ * Positions are absolute sample counts (uint64), so "how far behind" is a plain
+ * subtraction and never ambiguous across ring wraps. The ring is sized to a
+ * whole number of capture blocks; the block currently being filled by I2S is
+ * excluded from what readers may copy, and readers re-check the write head
+ * after copying so a block overwritten mid-copy is reported as an overrun
+ * rather than returned torn.
+ */
+
+#include "System_AudioCapture.h"
+
+#if ENABLE_MICROPHONE_SENSOR || ENABLE_ESP_SR
+
+#include <driver/i2s_pdm.h>
+#include <freertos/event_groups.h>
+#include <freertos/semphr.h>
+#include <freertos/task.h>
+
+#include "System_AudioAnalysis.h"
+#include "System_Debug.h"
+#include "System_MemUtil.h"
+#include "System_Mutex.h"
+#include "System_TaskUtils.h"
+#include "System_Utils.h"
+#if ENABLE_MICROPHONE_SENSOR && ENABLE_OLED_DISPLAY
+#include "OLED_Display.h"
+#endif
+
+#ifndef MIC_CLK_PIN
+  #define MIC_CLK_PIN       42  // Default for XIAO ESP32S3 Sense
+#endif
+#ifndef MIC_DATA_PIN
+  #define MIC_DATA_PIN      41  // Default for XIAO ESP32S3 Sense
+#endif
+
+#define AUDIO_CAPTURE_WARMUP_BLOCKS  5    // PDM output settles after ~150 ms
+#define AUDIO_CAPTURE_READ_TIMEOUT   pdMS_TO_TICKS(100)
+#define AUDIO_CAPTURE_READER_WAIT    pdMS_TO_TICKS(20)   // Readers skip a frame rather than wait out start/stop
+
+struct AudioConsumer {
+  bool active;
+  char name[16];
+  uint64_t cursor;        // Next absolute sample index to read
+  uint32_t overruns;
+  uint64_t samplesRead;
+};
+
+static i2s_chan_handle_t sRxHandle = nullptr;
+static int16_t* sRing = nullptr;
+static size_t sRingSamples = 0;
+static uint32_t sSampleRate = 0;
+static uint64_t sWriteIdx = 0;          // Guarded by sWriteMux (64-bit, not atomic on Xtensa)
+static uint32_t sReadErrors = 0;
+
+static AudioConsumer sConsumers[AUDIO_CAPTURE_MAX_CONSUMERS];
+static int sActiveConsumers = 0;
+
+static TaskHandle_t sCaptureTask = nullptr;
+static volatile bool sCaptureRun = false;
+static EventGroupHandle_t sDataEvents = nullptr;  // One "new data" bit per consumer slot
+static SemaphoreHandle_t sLifecycleLock = nullptr; // Serializes acquire/release (start/stop)
+static portMUX_TYPE sWriteMux = portMUX_INITIALIZER_UNLOCKED;
+
+// Voice activity, updated by the capture task once per published block
+static AudioVadState sVad;
+static AudioVadConfig sVadConfig;
+static volatile bool sSpeechActive = false;
+static volatile uint32_t sSpeechSegments = 0;
+
+static inline uint64_t loadWriteIdx() {
+  portENTER_CRITICAL(&sWriteMux);
+  uint64_t w = sWriteIdx;
+  portEXIT_CRITICAL(&sWriteMux);
+  return w;
+}
+
+// Oldest sample a reader may copy: one block of the ring is reserved for the write in flight
+static inline uint64_t oldestReadable(uint64_t w) {
+  uint64_t span = sRingSamples - AUDIO_CAPTURE_BLOCK_SAMPLES;
+  return (w > span) ? (w - span) : 0;
+}
+
+// Ring readers hold sLifecycleLock across check-and-copy so a concurrent last
+// release cannot free the ring under them. Returns false (caller reports 0
+// samples) while start/stop holds the lock or once the ring is gone.
+static bool lockRingForRead() {
+  if (!sLifecycleLock || xSemaphoreTake(sLifecycleLock, AUDIO_CAPTURE_READER_WAIT) != pdTRUE) return false;
+  if (!sRing || sRingSamples == 0) {
+    xSemaphoreGive(sLifecycleLock);
+    return false;
+  }
+  return true;
+}
+
+static inline void unlockRingForRead() {
+  xSemaphoreGive(sLifecycleLock);
+}
+
+// Caller holds lockRingForRead()
+static void copyFromRing(int16_t* dst, uint64_t start, size_t n) {
+  size_t pos = (size_t)(start % sRingSamples);
+  size_t first = sRingSamples - pos;
+  if (first > n) first = n;
+  memcpy(dst, &sRing[pos], first * sizeof(int16_t));
+  if (n > first) memcpy(dst + first, sRing, (n - first) * sizeof(int16_t));
+}
+
+static inline EventBits_t consumerBit(AudioConsumerId id) {
+  return (EventBits_t)1 << id;
+}
+
+static inline bool validConsumer(AudioConsumerId id) {
+  return id >= 0 && id < AUDIO_CAPTURE_MAX_CONSUMERS && sConsumers[id].active;
+}
+
+// ============================================================================
+// Capture task
+// ============================================================================
+
+static void audioCaptureTask(void* param) {
+  uint32_t warmup = AUDIO_CAPTURE_WARMUP_BLOCKS;
+
+  while (sCaptureRun) {
+    uint64_t w = loadWriteIdx();
+    size_t pos = (size_t)(w % sRingSamples);
+    size_t want = sRingSamples - pos;
+    if (want > AUDIO_CAPTURE_BLOCK_SAMPLES) want = AUDIO_CAPTURE_BLOCK_SAMPLES;
+
+    size_t bytesRead = 0;
+    esp_err_t err = i2s_channel_read(sRxHandle, &sRing[pos], want * sizeof(int16_t), &bytesRead, AUDIO_CAPTURE_READ_TIMEOUT);
+    if (err != ESP_OK || bytesRead == 0) {
+      if (err != ESP_OK && err != ESP_ERR_TIMEOUT) {
+        if ((sReadErrors++ % 50) == 0) {
+          WARN_SYSTEMF("[AudioCap] i2s_channel_read failed: %s (errors=%lu)", esp_err_to_name(err), (unsigned long)sReadErrors);
+        }
+        vTaskDelay(pdMS_TO_TICKS(10));
+      }
+      continue;
+    }
+
+    // Discard PDM start-up transient without publishing it
+    if (warmup > 0) {
+      warmup--;
+      continue;
+    }
+
+    size_t got = bytesRead / sizeof(int16_t);
+    portENTER_CRITICAL(&sWriteMux);
+    sWriteIdx += got;
+    portEXIT_CRITICAL(&sWriteMux);
+
+    // Only this task writes the ring, so the block is stable until the next read
+    bool speech = audioVadProcess(sVad, sVadConfig, &sRing[pos], got, sSampleRate);
+    if (speech && !sSpeechActive) sSpeechSegments++;
+    sSpeechActive = speech;
+
+#if ENABLE_MICROPHONE_SENSOR && ENABLE_OLED_DISPLAY
+    // Fresh samples for the mic level meter; its refreshMs caps the redraw rate
+    oledMarkDirtyMode(OLED_MICROPHONE);
+#endif
+
+    EventBits_t wake = 0;
+    for (int i = 0; i < AUDIO_CAPTURE_MAX_CONSUMERS; i++) {
+      if (sConsumers[i].active) wake |= consumerBit(i);
+    }
+    if (wake) xEventGroupSetBits(sDataEvents, wake);
+  }
+
+  sCaptureTask = nullptr;
+  vTaskDelete(nullptr);
+}
+
+// ============================================================================
+// I2S lifecycle (called with sLifecycleLock held)
+// ============================================================================
+
+// Channel and ring teardown; only once the capture task is gone
+static void releaseCaptureResources() {
+  {
+    I2sMicLockGuard i2sGuard("audiocap.stop");
+    if (sRxHandle) {
+      i2s_channel_disable(sRxHandle);
+      i2s_del_channel(sRxHandle);
+      sRxHandle = nullptr;
+    }
+  }
+
+  free(sRing);
+  sRing = nullptr;
+  sRingSamples = 0;
+  sSampleRate = 0;
+}
+
+static bool startCapture(uint32_t sampleRate) {
+  if (sCaptureTask) {
+    ERROR_SYSTEMF("[AudioCap] Previous capture task still running; not restarting");
+    return false;
+  }
+  // A stop that timed out left the channel and ring behind; the task is gone now
+  if (sRxHandle || sRing) releaseCaptureResources();
+
+  size_t blocks = ((size_t)sampleRate * AUDIO_CAPTURE_RING_MS / 1000 + AUDIO_CAPTURE_BLOCK_SAMPLES - 1) / AUDIO_CAPTURE_BLOCK_SAMPLES;
+  if (blocks < 4) blocks = 4;
+  size_t ringSamples = blocks * AUDIO_CAPTURE_BLOCK_SAMPLES;
+
+  int16_t* ring = (int16_t*)ps_alloc(ringSamples * sizeof(int16_t), AllocPref::PreferPSRAM, "audio.ring");
+  if (!ring) {
+    ERROR_SYSTEMF("[AudioCap] Failed to allocate %u-sample ring", (unsigned)ringSamples);
+    return false;
+  }
+
+  I2sMicLockGuard i2sGuard("audiocap.start");
+
+  i2s_chan_config_t chan_cfg = I2S_CHANNEL_DEFAULT_CONFIG(I2S_NUM_0, I2S_ROLE_MASTER);
+  chan_cfg.dma_desc_num = AUDIO_CAPTURE_DMA_DESC;
+  chan_cfg.dma_frame_num = AUDIO_CAPTURE_BLOCK_SAMPLES;
+
+  esp_err_t err = i2s_new_channel(&chan_cfg, nullptr, &sRxHandle);
+  if (err != ESP_OK) {
+    ERROR_SYSTEMF("[AudioCap] i2s_new_channel failed: %s", esp_err_to_name(err));
+    sRxHandle = nullptr;
+    free(ring);
+    return false;
+  }
+
+  // XIAO ESP32S3 Sense MSM261S4030H0R outputs on LEFT channel; hardware PDM->PCM
+  i2s_pdm_rx_slot_config_t slot_cfg =
+#ifdef I2S_PDM_RX_SLOT_PCM_FMT_DEFAULT_CONFIG
+    I2S_PDM_RX_SLOT_PCM_FMT_DEFAULT_CONFIG(I2S_DATA_BIT_WIDTH_16BIT, I2S_SLOT_MODE_MONO);
+#else
+    I2S_PDM_RX_SLOT_DEFAULT_CONFIG(I2S_DATA_BIT_WIDTH_16BIT, I2S_SLOT_MODE_MONO);
+#endif
+#if !defined(I2S_PDM_RX_SLOT_PCM_FMT_DEFAULT_CONFIG) && defined(I2S_PDM_DATA_FMT_PCM)
+  slot_cfg.data_fmt = I2S_PDM_DATA_FMT_PCM;
+#endif
+
+  i2s_pdm_rx_config_t pdm_cfg = {
+    .clk_cfg = I2S_PDM_RX_CLK_DEFAULT_CONFIG(sampleRate),
+    .slot_cfg = slot_cfg,
+    .gpio_cfg = {
+      .clk = (gpio_num_t)MIC_CLK_PIN,
+      .din = (gpio_num_t)MIC_DATA_PIN,
+      .invert_flags = {
+        .clk_inv = false,
+      },
+    },
+  };
+
+  err = i2s_channel_init_pdm_rx_mode(sRxHandle, &pdm_cfg);
+  if (err == ESP_OK) err = i2s_channel_enable(sRxHandle);
+  if (err != ESP_OK) {
+    ERROR_SYSTEMF("[AudioCap] PDM RX start failed: %s", esp_err_to_name(err));
+    i2s_del_channel(sRxHandle);
+    sRxHandle = nullptr;
+    free(ring);
+    return false;
+  }
+
+  sRing = ring;
+  sRingSamples = ringSamples;
+  sSampleRate = sampleRate;
+  portENTER_CRITICAL(&sWriteMux);
+  sWriteIdx = 0;
+  portEXIT_CRITICAL(&sWriteMux);
+  sReadErrors = 0;
+  sVad = AudioVadState();
+  sSpeechActive = false;
+  xEventGroupClearBits(sDataEvents, 0x00FFFFFF);
+
+  sCaptureRun = true;
+  if (xTaskCreateLogged(audioCaptureTask, "audio_cap", AUDIO_CAPTURE_STACK_WORDS, nullptr, 6, &sCaptureTask, "audio.cap") != pdPASS) {
+    ERROR_SYSTEMF("[AudioCap] Failed to create capture task");
+    sCaptureRun = false;
+    sCaptureTask = nullptr;
+    i2s_channel_disable(sRxHandle);
+    i2s_del_channel(sRxHandle);
+    sRxHandle = nullptr;
+    free(ring);
+    sRing = nullptr;
+    sRingSamples = 0;
+    sSampleRate = 0;
+    return false;
+  }
+
+  INFO_SENSORSF("[AudioCap] Capture started: %lu Hz, ring=%u samples (CLK=%d, DATA=%d)",
+                (unsigned long)sampleRate, (unsigned)ringSamples, MIC_CLK_PIN, MIC_DATA_PIN);
+  return true;
+}
+
+static void stopCapture() {
+  sCaptureRun = false;
+  // The task exits within one read timeout
+  for (int i = 0; i < 30 && sCaptureTask; i++) {
+    vTaskDelay(pdMS_TO_TICKS(10));
+  }
+  sSpeechActive = false;
+  if (sCaptureTask) {
+    // It may still be inside i2s_channel_read() on the ring: freeing either now
+    // would be a use-after-free. Leak them; the next start reclaims both once
+    // the task has gone.
+    ERROR_SYSTEMF("[AudioCap] Capture task did not exit in 300 ms; leaving %u-sample ring and I2S channel allocated",
+                  (unsigned)sRingSamples);
+    return;
+  }
+
+  releaseCaptureResources();
+  INFO_SENSORSF("[AudioCap] Capture stopped");
+}
+
+// ============================================================================
+// Consumer API
+// ============================================================================
+
+static bool ensureCaptureSync() {
+  if (!sLifecycleLock) {
+    sLifecycleLock = xSemaphoreCreateMutex();
+    if (!sLifecycleLock) return false;
+  }
+  if (!sDataEvents) {
+    sDataEvents = xEventGroupCreate();
+    if (!sDataEvents) return false;
+  }
+  return true;
+}
+
+AudioConsumerId audioCaptureAcquire(const char* name, uint32_t sampleRate) {
+  if (!ensureCaptureSync()) return AUDIO_CONSUMER_INVALID;
+
+  xSemaphoreTake(sLifecycleLock, portMAX_DELAY);
+
+  if (sActiveConsumers > 0 && sSampleRate != sampleRate) {
+    WARN_SYSTEMF("[AudioCap] '%s' wants %lu Hz but capture is running at %lu Hz",
+                 name ? name : "?", (unsigned long)sampleRate, (unsigned long)sSampleRate);
+    xSemaphoreGive(sLifecycleLock);
+    return AUDIO_CONSUMER_INVALID;
+  }
+
+  AudioConsumerId id = AUDIO_CONSUMER_INVALID;
+  for (int i = 0; i < AUDIO_CAPTURE_MAX_CONSUMERS; i++) {
+    if (!sConsumers[i].active) { id = i; break; }
+  }
+  if (id == AUDIO_CONSUMER_INVALID) {
+    WARN_SYSTEMF("[AudioCap] No free consumer slot for '%s'", name ? name : "?");
+    xSemaphoreGive(sLifecycleLock);
+    return AUDIO_CONSUMER_INVALID;
+  }
+
+  if (sActiveConsumers == 0 && !startCapture(sampleRate)) {
+    xSemaphoreGive(sLifecycleLock);
+    return AUDIO_CONSUMER_INVALID;
+  }
+
+  AudioConsumer& c = sConsumers[id];
+  strlcpy(c.name, name ? name : "?", sizeof(c.name));
+  c.cursor = loadWriteIdx();  // Start from "now", not from history
+  c.overruns = 0;
+  c.samplesRead = 0;
+  xEventGroupClearBits(sDataEvents, consumerBit(id));
+  c.active = true;
+  sActiveConsumers++;
+
+  DEBUG_MICF("[AudioCap] Consumer %d '%s' attached (%d active)", id, c.name, sActiveConsumers);
+  xSemaphoreGive(sLifecycleLock);
+  return id;
+}
+
+void audioCaptureRelease(AudioConsumerId id) {
+  if (!sLifecycleLock || !validConsumer(id)) return;
+
+  xSemaphoreTake(sLifecycleLock, portMAX_DELAY);
+  if (sConsumers[id].active) {
+    sConsumers[id].active = false;
+    sActiveConsumers--;
+    DEBUG_MICF("[AudioCap] Consumer %d '%s' detached (overruns=%lu, %d active)",
+               id, sConsumers[id].name, (unsigned long)sConsumers[id].overruns, sActiveConsumers);
+    if (sActiveConsumers == 0) stopCapture();
+  }
+  xSemaphoreGive(sLifecycleLock);
+}
+
+size_t audioCaptureRead(AudioConsumerId id, int16_t* dst, size_t maxSamples, TickType_t wait) {
+  if (!validConsumer(id) || !dst || maxSamples == 0) return 0;
+  AudioConsumer& c = sConsumers[id];
+  EventBits_t bit = consumerBit(id);
+
+  for (;;) {
+    // Clear before checking so a block published after the check still wakes us
+    xEventGroupClearBits(sDataEvents, bit);
+
+    if (!lockRingForRead()) return 0;
+    uint64_t w = loadWriteIdx();
+    uint64_t oldest = oldestReadable(w);
+    if (c.cursor < oldest) {
+      c.overruns++;
+      c.cursor = oldest;
+    }
+
+    if (w > c.cursor) {
+      size_t n = (size_t)(w - c.cursor);
+      if (n > maxSamples) n = maxSamples;
+      uint64_t start = c.cursor;
+      copyFromRing(dst, start, n);
+
+      // Writer may have lapped us during the copy
+      uint64_t lapOldest = oldestReadable(loadWriteIdx());
+      unlockRingForRead();
+      if (start < lapOldest) {
+        c.overruns++;
+        c.cursor = lapOldest;
+        continue;
+      }
+      c.cursor = start + n;
+      c.samplesRead += n;
+      return n;
+    }
+    unlockRingForRead();
+
+    if (wait == 0) return 0;
+    if ((xEventGroupWaitBits(sDataEvents, bit, pdTRUE, pdFALSE, wait) & bit) == 0) return 0;
+    wait = 0;  // One wake-up per call; the caller loops
+    if (!sConsumers[id].active) return 0;
+  }
+}
+
+size_t audioCaptureReadLatest(AudioConsumerId id, int16_t* dst, size_t samples) {
+  if (!validConsumer(id) || !dst || samples == 0) return 0;
+  AudioConsumer& c = sConsumers[id];
+  if (!lockRingForRead()) return 0;
+
+  uint64_t w = loadWriteIdx();
+  uint64_t avail = w - oldestReadable(w);
+  size_t n = (avail < samples) ? (size_t)avail : samples;
+  if (n == 0) {
+    unlockRingForRead();
+    return 0;
+  }
+
+  uint64_t start = w - n;
+  copyFromRing(dst, start, n);
+  bool lapped = start < oldestReadable(loadWriteIdx());
+  unlockRingForRead();
+  if (lapped) {
+    c.overruns++;
+    return 0;
+  }
+  c.cursor = w;
+  c.samplesRead += n;
+  return n;
+}
+
+size_t audioCapturePeekLatest(int16_t* dst, size_t samples, uint64_t* endIdx) {
+  if (!dst || samples == 0 || !audioCaptureRunning()) return 0;
+  if (!lockRingForRead()) return 0;
+
+  uint64_t w = loadWriteIdx();
+  if (w - oldestReadable(w) < samples) {
+    unlockRingForRead();
+    return 0;
+  }
+  uint64_t start = w - samples;
+  copyFromRing(dst, start, samples);
+  bool lapped = start < oldestReadable(loadWriteIdx());
+  unlockRingForRead();
+  if (lapped) return 0;
+  if (endIdx) *endIdx = w;
+  return samples;
+}
+
+bool audioCaptureRunning() {
+  return sCaptureTask != nullptr;
+}
+
+uint32_t audioCaptureSampleRate() {
+  return sSampleRate;
+}
+
+uint64_t audioCaptureTotalSamples() {
+  return loadWriteIdx();
+}
+
+uint32_t audioCaptureOverruns(AudioConsumerId id) {
+  return validConsumer(id) ? sConsumers[id].overruns : 0;
+}
+
+bool audioCaptureSpeechActive() {
+  return sSpeechActive;
+}
+
+uint32_t audioCaptureSpeechSegments() {
+  return sSpeechSegments;
+}
+
+void audioCaptureVadStats(uint32_t* noiseFloor, uint32_t* energy, uint16_t* zcrQ8) {
+  if (noiseFloor) *noiseFloor = sVad.noiseFloor;
+  if (energy) *energy = sVad.lastEnergy;
+  if (zcrQ8) *zcrQ8 = sVad.lastZcrQ8;
+}
+
+// ============================================================================
+// CLI
+// ============================================================================
+
+static char gAudioCapBuffer[512];
+
+const char* cmd_audiocapture(const String& args) {
+  RETURN_VALID_IF_VALIDATE_CSTR();
+
+  if (!audioCaptureRunning()) {
+    return "Audio capture: idle";
+  }
+
+  uint64_t w = loadWriteIdx();
+  int len = snprintf(gAudioCapBuffer, sizeof(gAudioCapBuffer),
+                     "Audio capture: %lu Hz, ring=%u samples (%u ms), captured=%llu, i2s_err=%lu\n"
+                     "  VAD: %s, floor=%lu energy=%lu zcr=%u/256, segments=%lu\n",
+                     (unsigned long)sSampleRate, (unsigned)sRingSamples,
+                     (unsigned)(sSampleRate ? (uint64_t)sRingSamples * 1000 / sSampleRate : 0),
+                     (unsigned long long)w, (unsigned long)sReadErrors,
+                     sSpeechActive ? "speech" : "silence", (unsigned long)sVad.noiseFloor,
+                     (unsigned long)sVad.lastEnergy, (unsigned)sVad.lastZcrQ8,
+                     (unsigned long)sSpeechSegments);
+  for (int i = 0; i < AUDIO_CAPTURE_MAX_CONSUMERS && len > 0 && len < (int)sizeof(gAudioCapBuffer); i++) {
+    const AudioConsumer& c = sConsumers[i];
+    if (!c.active) continue;
+    uint64_t lag = (w > c.cursor) ? (w - c.cursor) : 0;
+    len += snprintf(gAudioCapBuffer + len, sizeof(gAudioCapBuffer) - len,
+                    "  [%d] %-12s lag=%llu overruns=%lu read=%llu\n",
+                    i, c.name, (unsigned long long)lag, (unsigned long)c.overruns,
+                    (unsigned long long)c.samplesRead);
+  }
+  return gAudioCapBuffer;
+}
+
+#endif // ENABLE_MICROPHONE_SENSOR || ENABLE_ESP_SR
@@ -0,0 +1,69 @@
+/**
+ * Audio Capture - single owner of the I2S PDM microphone
+ *
+ * One capture task reads the PDM channel and appends raw PCM into a PSRAM ring.
+ * Recording, level metering, the visualizer and ESP-SR each register as a
+ * consumer with their own read cursor, so they run side by side without
+ * reconfiguring I2S. A consumer that falls more than the ring length behind is
+ * moved forward to the oldest retained sample and its overrun counter bumped;
+ * the capture task itself never waits on a consumer.
+ *
+ * The channel is created when the first consumer acquires it and torn down when
+ * the last one releases it. All consumers share one sample rate: acquiring at a
+ * different rate while capture is running fails.
+ */
+
+#ifndef SYSTEM_AUDIO_CAPTURE_H
+#define SYSTEM_AUDIO_CAPTURE_H
+
+#include <Arduino.h>
+#include "System_BuildConfig.h"
+
+#if ENABLE_MICROPHONE_SENSOR || ENABLE_ESP_SR
+
+#include <freertos/FreeRTOS.h>
+
+#define AUDIO_CAPTURE_RING_MS        2000  // History retained for lagging consumers
+#define AUDIO_CAPTURE_BLOCK_SAMPLES  512   // Samples per I2S read (32 ms at 16 kHz)
+#define AUDIO_CAPTURE_DMA_DESC       8
+#define AUDIO_CAPTURE_MAX_CONSUMERS  6
+
+typedef int AudioConsumerId;
+#define AUDIO_CONSUMER_INVALID (-1)
+
+// Register a consumer. Starts capture at sampleRate if idle. Returns
+// AUDIO_CONSUMER_INVALID if capture is running at another rate, all consumer
+// slots are taken, or the I2S channel could not be started.
+AudioConsumerId audioCaptureAcquire(const char* name, uint32_t sampleRate);
+
+// Unregister a consumer; capture stops when the last one leaves
+void audioCaptureRelease(AudioConsumerId id);
+
+// Copy up to maxSamples contiguous samples from the consumer's cursor,
+// waiting up to `wait` for data. Returns samples copied (0 on timeout).
+size_t audioCaptureRead(AudioConsumerId id, int16_t* dst, size_t maxSamples, TickType_t wait);
+
+// Copy the most recent `samples` samples without waiting and move the cursor
+// to the write head (for meters that only care about "now").
+size_t audioCaptureReadLatest(AudioConsumerId id, int16_t* dst, size_t samples);
+
+// Copy the most recent `samples` samples without a consumer slot (analysis
+// taps). Returns 0 if fewer are retained; *endIdx receives the write index.
+size_t audioCapturePeekLatest(int16_t* dst, size_t samples, uint64_t* endIdx);
+
+bool audioCaptureRunning();
+uint32_t audioCaptureSampleRate();
+uint64_t audioCaptureTotalSamples();
+uint32_t audioCaptureOverruns(AudioConsumerId id);
+
+// Voice-activity detector run by the capture task on every block
+bool audioCaptureSpeechActive();
+uint32_t audioCaptureSpeechSegments();  // Silence->speech transitions since boot
+void audioCaptureVadStats(uint32_t* noiseFloor, uint32_t* energy, uint16_t* zcrQ8);
+
+// CLI: ring and per-consumer status
+const char* cmd_audiocapture(const String& args);
+
+#endif // ENABLE_MICROPHONE_SENSOR || ENABLE_ESP_SR
+
+#endif // SYSTEM_AUDIO_CAPTURE_H
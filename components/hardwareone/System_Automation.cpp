@@ -41,6 +41,7 @@
 #include "System_Debug.h"
 #include "System_Filesystem.h"
 #include "System_MemUtil.h"
+#include "System_Mutex.h"
 #include "System_Settings.h"
 #include "System_User.h"
 #include "System_Utils.h"
@@ -239,7 +240,8 @@ static int findJsonObjectEnd(const String& json, int objStart) {
 
 // Streaming automation parser: reads file in chunks and calls callback for each automation object
 bool streamParseAutomations(const char* path, AutomationCallback callback, void* userData) {
-  FsLockGuard guard("streamParseAutos");
+  // Per-path read lock: scheduler lookups do not wait behind unrelated bulk I/O
+  FsPathReadGuard guard(path);
   File f = LittleFS.open(path, "r");
   if (!f) return false;
 
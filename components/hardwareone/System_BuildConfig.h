@@ -129,7 +129,10 @@
 
 // Display Type: Hardware display selection
 //   0 = NONE, 1 = SSD1306 (OLED), 2 = ST7789 (TFT), 3 = ILI9341 (TFT)
+//   (may also be set from the compiler command line, e.g. -DDISPLAY_TYPE=2)
+#ifndef DISPLAY_TYPE
 #define DISPLAY_TYPE            1
+#endif
 
 // ╔═══════════════════════════════════════════════════════════════════════════╗
 // ║                    END OF USER CONFIGURATION                              ║
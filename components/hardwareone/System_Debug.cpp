@@ -59,6 +59,19 @@ static uint16_t gSystemLogUnflushedCount = 0;
 static const uint16_t LOG_FLUSH_MESSAGE_COUNT = 20;      // Flush every 20 messages
 static const uint32_t LOG_FLUSH_INTERVAL_MS = 5000;      // Or every 5 seconds
 
+// Guards gSystemLogPath, gSystemLogEnabled and gSystemLogFile between the dbg_file
+// sink task and log start/stop. Taken before the log file's path lock.
+static SemaphoreHandle_t gSystemLogStateMutex = nullptr;
+
+struct SystemLogStateGuard {
+  bool held;
+  SystemLogStateGuard()
+    : held(gSystemLogStateMutex && xSemaphoreTake(gSystemLogStateMutex, portMAX_DELAY) == pdTRUE) {}
+  ~SystemLogStateGuard() { if (held) xSemaphoreGive(gSystemLogStateMutex); }
+  SystemLogStateGuard(const SystemLogStateGuard&) = delete;
+  SystemLogStateGuard& operator=(const SystemLogStateGuard&) = delete;
+};
+
 // Suppressed output during help (summary only)
 static volatile unsigned long gHelpSuppressedCount = 0;
 
@@ -134,7 +147,211 @@ void helpSuppressedTailDump() {
 // Initialization
 // ============================================================================
 
-// Debug output task - single writer for all debug messages
+// ============================================================================
+// Debug Sink Fan-out
+// ============================================================================
+// debugOutputTask is the single dispatcher: it applies help-mode gating and then
+// hands a reference to the shared DebugMessage to every enabled sink. Slow sinks
+// (UART, flash, G2 BLE) each own a bounded queue and a drain task, so a blocked
+// Serial TX or a flash flush only backs up that sink. Memory-only sinks (web
+// mirror, OLED console) are cheap and drained inline by the dispatcher.
+// A message returns to gDebugFreeQueue when its last reference is released.
+
+struct DebugSink {
+  const char* name;
+  const char* taskName;                       // nullptr = drained inline by dispatcher
+  bool (*accepts)(const DebugMessage* msg);   // Runtime enable check (evaluated per message)
+  size_t (*write)(DebugMessage* msg);         // Returns bytes emitted
+  QueueHandle_t queue;
+  TaskHandle_t task;
+  volatile uint32_t written;
+  volatile uint32_t dropped;                  // Sink queue full - message skipped for this sink only
+  volatile uint32_t bytes;
+  volatile uint16_t highWater;
+  uint32_t lastWritten;                       // Snapshot for throughput reporting
+  unsigned long lastSampleMs;
+};
+
+static inline void releaseDebugMessage(DebugMessage* msg) {
+  if (__atomic_sub_fetch(&msg->refCount, 1, __ATOMIC_ACQ_REL) == 0 && gDebugFreeQueue) {
+    xQueueSend(gDebugFreeQueue, &msg, 0);
+  }
+}
+
+static bool serialSinkAccepts(const DebugMessage* msg) {
+  return (gOutputFlags & OUTPUT_SERIAL) && !(msg->flags & DEBUG_MSG_FLAG_NO_SERIAL);
+}
+
+static size_t serialSinkWrite(DebugMessage* msg) {
+  int n = Serial.printf("[%lu] %s\n", msg->timestamp, msg->text);
+  return n > 0 ? (size_t)n : 0;
+}
+
+static bool fileSinkAccepts(const DebugMessage* msg) {
+  (void)msg;
+  return (gOutputFlags & OUTPUT_FILE) && gSystemLogEnabled;
+}
+
+// File output (system log) - optimized with persistent file handle
+static size_t fileSinkWrite(DebugMessage* msg) {
+  size_t n = 0;
+  // Path and enabled flag are read under the state lock: 'log stop' clears both
+  // there before closing the file, so a queued message cannot reopen it
+  SystemLogStateGuard state;
+  if (!gSystemLogEnabled || gSystemLogPath.length() == 0) return 0;
+  FsPathWriteGuard guard(gSystemLogPath);
+
+  // Open file if not already open (once per logging session)
+  if (!gSystemLogFile) {
+    gSystemLogFile = LittleFS.open(gSystemLogPath.c_str(), "a");
+    if (gSystemLogFile) {
+      gSystemLogLastFlush = millis();
+      gSystemLogUnflushedCount = 0;
+    }
+  }
+
+  if (gSystemLogFile) {
+    // Write directly to file (no intermediate buffer needed)
+    if (gSystemLogCategoryTags && msg->flags != 0) {
+      const char* category = getDebugCategoryName(msg->flags);
+      n = gSystemLogFile.printf("[%lu] [%s] %s\n", msg->timestamp, category, msg->text);
+    } else {
+      n = gSystemLogFile.printf("[%lu] %s\n", msg->timestamp, msg->text);
+    }
+
+    gSystemLogLastWrite = millis();
+    gSystemLogUnflushedCount++;
+
+    // Periodic flush (balances performance vs data safety)
+    bool shouldFlush =
+      (gSystemLogUnflushedCount >= LOG_FLUSH_MESSAGE_COUNT) ||
+      ((millis() - gSystemLogLastFlush) >= LOG_FLUSH_INTERVAL_MS);
+
+    if (shouldFlush) {
+      gSystemLogFile.flush();
+      gSystemLogLastFlush = millis();
+      gSystemLogUnflushedCount = 0;
+    }
+  }
+
+  return n;
+}
+
+#if ENABLE_BLUETOOTH && ENABLE_G2_GLASSES
+static bool g2SinkAccepts(const DebugMessage* msg) {
+  (void)msg;
+  return (gOutputFlags & OUTPUT_G2) && isG2Connected();
+}
+
+// G2 glasses output - buffer messages and flush periodically
+static size_t g2SinkWrite(DebugMessage* msg) {
+  size_t n = 0;
+  size_t len = strlen(msg->text);
+  if (gG2OutputBuffer.length() + len + 2 < G2_BUFFER_MAX) {
+    gG2OutputBuffer += msg->text;
+    gG2OutputBuffer += "\n";
+    n = len + 1;
+  }
+  // Flush if buffer full or interval elapsed
+  unsigned long now = millis();
+  if (gG2OutputBuffer.length() >= G2_BUFFER_MAX - 50 ||
+      (now - gG2LastFlush >= G2_FLUSH_INTERVAL_MS && gG2OutputBuffer.length() > 0)) {
+    g2ShowText(gG2OutputBuffer.c_str());
+    gG2OutputBuffer = "";
+    gG2LastFlush = now;
+  }
+  return n;
+}
+#endif
+
+static bool webSinkAccepts(const DebugMessage* msg) {
+  (void)msg;
+  return (gOutputFlags & OUTPUT_WEB) && gWebMirror.buf;
+}
+
+// Append to web mirror buffer using circular buffer logic
+static size_t webSinkWrite(DebugMessage* msg) {
+  // Format message with timestamp (stack buffer - zero heap allocation)
+  char formattedMsg[DEBUG_MSG_SIZE + 32];
+  int written = snprintf(formattedMsg, sizeof(formattedMsg), "[%lu] %s", msg->timestamp, msg->text);
+  if (written <= 0) return 0;
+  if ((size_t)written >= sizeof(formattedMsg)) written = sizeof(formattedMsg) - 1;
+  // Use appendDirect() with pre-calculated length - zero String churn
+  gWebMirror.appendDirect(formattedMsg, (size_t)written, true);
+  return (size_t)written;
+}
+
+#if ENABLE_OLED_DISPLAY
+// OLED console buffer is fed always, independent of OUTPUT_* flags
+static bool oledSinkAccepts(const DebugMessage* msg) {
+  (void)msg;
+  return gOLEDConsole.mutex != nullptr;
+}
+
+static size_t oledSinkWrite(DebugMessage* msg) {
+  gOLEDConsole.append(msg->text, msg->timestamp);
+  return strlen(msg->text);
+}
+#endif
+
+static DebugSink gDebugSinks[] = {
+  { "serial", "dbg_serial", serialSinkAccepts, serialSinkWrite },
+  { "file",   "dbg_file",   fileSinkAccepts,   fileSinkWrite },
+#if ENABLE_BLUETOOTH && ENABLE_G2_GLASSES
+  { "g2",     "dbg_g2",     g2SinkAccepts,     g2SinkWrite },
+#endif
+  { "web",    nullptr,      webSinkAccepts,    webSinkWrite },
+#if ENABLE_OLED_DISPLAY
+  { "oled",   nullptr,      oledSinkAccepts,   oledSinkWrite },
+#endif
+};
+static const size_t kDebugSinkCount = sizeof(gDebugSinks) / sizeof(gDebugSinks[0]);
+
+static inline void runDebugSink(DebugSink& sink, DebugMessage* msg) {
+  size_t n = sink.write(msg);
+  sink.written++;
+  sink.bytes += n;
+}
+
+// Drain task for one queued sink - blocks only on its own output device
+static void debugSinkTask(void* parameter) {
+  DebugSink* sink = (DebugSink*)parameter;
+  while (true) {
+    DebugMessage* msg = nullptr;
+    if (xQueueReceive(sink->queue, &msg, portMAX_DELAY) == pdTRUE && msg) {
+      runDebugSink(*sink, msg);
+      releaseDebugMessage(msg);
+    }
+  }
+}
+
+// Create per-sink queues and drain tasks. A slow sink may pin at most half of the
+// message pool; beyond that its own drop counter increments and other sinks proceed.
+static void initDebugSinks() {
+  int sinkDepth = gDebugQueueSize / 2;
+  if (sinkDepth < 8) sinkDepth = 8;
+
+  if (!gSystemLogStateMutex) gSystemLogStateMutex = xSemaphoreCreateMutex();
+
+  for (size_t i = 0; i < kDebugSinkCount; i++) {
+    DebugSink& sink = gDebugSinks[i];
+    sink.lastSampleMs = millis();
+    if (!sink.taskName || sink.task) continue;
+
+    if (!sink.queue) {
+      sink.queue = xQueueCreate(sinkDepth, sizeof(DebugMessage*));
+    }
+    if (sink.queue) {
+      xTaskCreate(debugSinkTask, sink.taskName, DEBUG_SINK_STACK_WORDS, &sink, 1, &sink.task);
+    }
+    if (!sink.task && (gOutputFlags & OUTPUT_SERIAL)) {
+      // Falls back to inline draining in the dispatcher (pre-fan-out behaviour)
+      Serial.printf("WARNING: Debug sink '%s' running inline (task/queue create failed)\n", sink.name);
+    }
+  }
+}
+
+// Debug output task - single dispatcher for all debug messages
 static TaskHandle_t gDebugOutputTaskHandle = nullptr;
 
 void debugOutputTask(void* parameter) {
@@ -153,90 +370,32 @@ void debugOutputTask(void* parameter) {
           continue; // Drop from sinks to avoid overwriting help UI
         }
       }
-      // Single point of output - no concurrency issues
-      if ((gOutputFlags & OUTPUT_SERIAL) && !(msg->flags & DEBUG_MSG_FLAG_NO_SERIAL)) {
-        Serial.printf("[%lu] %s\n", msg->timestamp, msg->text);
-      }
-      // Append to web mirror buffer using circular buffer logic (only if web output enabled)
-      if ((gOutputFlags & OUTPUT_WEB) && gWebMirror.buf) {
-        // Format message with timestamp (stack buffer - zero heap allocation)
-        char formattedMsg[DEBUG_MSG_SIZE + 32];
-        int written = snprintf(formattedMsg, sizeof(formattedMsg), "[%lu] %s", msg->timestamp, msg->text);
-        if (written > 0) {
-          // Use appendDirect() with pre-calculated length - zero String churn
-          gWebMirror.appendDirect(formattedMsg, (size_t)written, true);
-        }
-      }
-      // File output (system log) - optimized with persistent file handle
-      if ((gOutputFlags & OUTPUT_FILE) && gSystemLogEnabled && gSystemLogPath.length() > 0) {
-        fsLock("debug.log");
-        
-        // Open file if not already open (once per logging session)
-        if (!gSystemLogFile) {
-          gSystemLogFile = LittleFS.open(gSystemLogPath.c_str(), "a");
-          if (gSystemLogFile) {
-            gSystemLogLastFlush = millis();
-            gSystemLogUnflushedCount = 0;
-          }
-        }
-        
-        if (gSystemLogFile) {
-          // Write directly to file (no intermediate buffer needed)
-          if (gSystemLogCategoryTags && msg->flags != 0) {
-            const char* category = getDebugCategoryName(msg->flags);
-            gSystemLogFile.printf("[%lu] [%s] %s\n", msg->timestamp, category, msg->text);
-          } else {
-            gSystemLogFile.printf("[%lu] %s\n", msg->timestamp, msg->text);
-          }
-          
-          gSystemLogLastWrite = millis();
-          gSystemLogUnflushedCount++;
-          
-          // Periodic flush (balances performance vs data safety)
-          bool shouldFlush = 
-            (gSystemLogUnflushedCount >= LOG_FLUSH_MESSAGE_COUNT) ||
-            ((millis() - gSystemLogLastFlush) >= LOG_FLUSH_INTERVAL_MS);
-          
-          if (shouldFlush) {
-            gSystemLogFile.flush();
-            gSystemLogLastFlush = millis();
-            gSystemLogUnflushedCount = 0;
-          }
-        }
-        
-        fsUnlock();
-      }
-      
-      // Append to OLED console buffer (always, independent of OUTPUT_* flags)
-      #if ENABLE_OLED_DISPLAY
-      if (gOLEDConsole.mutex) {
-        gOLEDConsole.append(msg->text, msg->timestamp);
-      }
-      #endif
-      
-      // G2 glasses output - buffer messages and flush periodically
-      #if ENABLE_BLUETOOTH && ENABLE_G2_GLASSES
-      if ((gOutputFlags & OUTPUT_G2) && isG2Connected()) {
-        // Append to buffer (with newline)
-        if (gG2OutputBuffer.length() + strlen(msg->text) + 2 < G2_BUFFER_MAX) {
-          gG2OutputBuffer += msg->text;
-          gG2OutputBuffer += "\n";
+
+      // Dispatcher holds one reference until every sink has been offered the message
+      __atomic_store_n(&msg->refCount, 1, __ATOMIC_RELEASE);
+
+      for (size_t i = 0; i < kDebugSinkCount; i++) {
+        DebugSink& sink = gDebugSinks[i];
+        if (!sink.accepts(msg)) continue;
+
+        if (!sink.task) {
+          runDebugSink(sink, msg);
+          continue;
         }
-        // Flush if buffer full or interval elapsed
-        unsigned long now = millis();
-        if (gG2OutputBuffer.length() >= G2_BUFFER_MAX - 50 || 
-            (now - gG2LastFlush >= G2_FLUSH_INTERVAL_MS && gG2OutputBuffer.length() > 0)) {
-          g2ShowText(gG2OutputBuffer.c_str());
-          gG2OutputBuffer = "";
-          gG2LastFlush = now;
+
+        __atomic_add_fetch(&msg->refCount, 1, __ATOMIC_ACQ_REL);
+        if (xQueueSend(sink.queue, &msg, 0) != pdTRUE) {
+          // Sink is backed up - drop for this sink only, never wait on it
+          __atomic_sub_fetch(&msg->refCount, 1, __ATOMIC_ACQ_REL);
+          sink.dropped++;
+          continue;
         }
+        UBaseType_t depth = uxQueueMessagesWaiting(sink.queue);
+        if (depth > sink.highWater) sink.highWater = (uint16_t)depth;
       }
-      #endif
-      
-      // Return message to pool
-      if (gDebugFreeQueue) {
-        xQueueSend(gDebugFreeQueue, &msg, 0);
-      }
+
+      // Return message to pool once the last sink is done with it
+      releaseDebugMessage(msg);
     }
   }
 }
@@ -379,6 +538,9 @@ void initDebugSystem() {
                   hasPsram ? "PSRAM" : "internal RAM");
   }
 
+  // Per-sink queues/drain tasks must exist before the dispatcher starts routing
+  initDebugSinks();
+
   // Create debug output task
   if (!gDebugOutputTaskHandle) {
     BaseType_t result = xTaskCreate(
@@ -1860,6 +2022,29 @@ const char* cmd_debugbuffer(const String& argsInput) {
   BROADCAST_PRINTF("  Dropped: %lu (queue full)", dropped);
   BROADCAST_PRINTF("  Status: %s", status);
 
+  // Per-sink fan-out metrics (rate is since the previous 'debugbuffer' call)
+  broadcastOutput("Debug Sinks:");
+  unsigned long now = millis();
+  for (size_t i = 0; i < kDebugSinkCount; i++) {
+    DebugSink& sink = gDebugSinks[i];
+    uint32_t written = sink.written;
+    unsigned long elapsed = now - sink.lastSampleMs;
+    unsigned long rate = elapsed > 0 ? ((unsigned long)(written - sink.lastWritten) * 1000UL) / elapsed : 0;
+    sink.lastWritten = written;
+    sink.lastSampleMs = now;
+
+    if (sink.task) {
+      int sinkDepth = uxQueueMessagesWaiting(sink.queue);
+      int sinkCap = sinkDepth + (int)uxQueueSpacesAvailable(sink.queue);
+      BROADCAST_PRINTF("  %-6s queued %d/%d (peak %u)  msgs %lu (%lu/s)  bytes %lu  dropped %lu",
+                       sink.name, sinkDepth, sinkCap, (unsigned)sink.highWater,
+                       (unsigned long)written, rate, (unsigned long)sink.bytes, (unsigned long)sink.dropped);
+    } else {
+      BROADCAST_PRINTF("  %-6s inline             msgs %lu (%lu/s)  bytes %lu",
+                       sink.name, (unsigned long)written, rate, (unsigned long)sink.bytes);
+    }
+  }
+
   return "OK";
 }
 
@@ -2397,24 +2582,30 @@ const char* cmd_log(const String& argsInput) {
   
   // Handle 'stop' subcommand
   if (subCmd == "stop") {
-    if (!gSystemLogEnabled) {
-      return "System logging is not running";
-    }
-    
-    // Flush and close persistent file handle if open
-    if (gSystemLogFile) {
-      fsLock("debug.log");
-      gSystemLogFile.flush();
-      gSystemLogFile.close();
-      // Note: close() resets the handle internally
-      gSystemLogUnflushedCount = 0;
-      fsUnlock();
+    String stoppedPath;
+    {
+      SystemLogStateGuard state;
+      if (!gSystemLogEnabled) {
+        return "System logging is not running";
+      }
+
+      // Disable first so the sink task cannot reopen the file once it is closed
+      gSystemLogEnabled = false;
+      gOutputFlags &= ~OUTPUT_FILE;
+      stoppedPath = gSystemLogPath;
+      gSystemLogPath = "";
+
+      // Flush and close persistent file handle if open
+      if (gSystemLogFile) {
+        FsPathWriteGuard guard(stoppedPath);
+        gSystemLogFile.flush();
+        gSystemLogFile.close();
+        // Note: close() resets the handle internally
+        gSystemLogUnflushedCount = 0;
+      }
     }
     
-    gSystemLogEnabled = false;
-    gOutputFlags &= ~OUTPUT_FILE;
-    String msg = "System logging stopped. Log saved to: " + gSystemLogPath;
-    gSystemLogPath = "";
+    String msg = "System logging stopped. Log saved to: " + stoppedPath;
     snprintf(gDebugBuffer, 1024, "%s", msg.c_str());
     return gDebugBuffer;
   }
@@ -2426,12 +2617,15 @@ const char* cmd_log(const String& argsInput) {
     }
     
     // Ensure any previous file handle is closed (safety check)
-    if (gSystemLogFile) {
-      fsLock("log.create");
-      gSystemLogFile.flush();
-      gSystemLogFile.close();
-      // Note: close() resets the handle internally
-      fsUnlock();
+    {
+      SystemLogStateGuard state;
+      if (gSystemLogFile) {
+        fsLock("log.create");
+        gSystemLogFile.flush();
+        gSystemLogFile.close();
+        // Note: close() resets the handle internally
+        fsUnlock();
+      }
     }
     
     // Parse arguments: log start [filepath] [flags=0xXXXX] [tags=0|1]
@@ -2530,10 +2724,13 @@ const char* cmd_log(const String& argsInput) {
     }
     fsUnlock();
     
-    gSystemLogPath = filepath;
-    gSystemLogEnabled = true;
-    gSystemLogLastWrite = millis();
-    gOutputFlags |= OUTPUT_FILE;
+    {
+      SystemLogStateGuard state;
+      gSystemLogPath = filepath;
+      gSystemLogEnabled = true;
+      gSystemLogLastWrite = millis();
+      gOutputFlags |= OUTPUT_FILE;
+    }
     
     snprintf(gDebugBuffer, 1024, "System logging started\n  File: %s", filepath.c_str());
     broadcastOutput(gDebugBuffer);
@@ -3039,7 +3236,7 @@ const CommandEntry debugCommands[] = {
   { "debugperformance", "Debug performance metrics.", true, cmd_debugperformance },
   { "debugdatetime", "Debug date/time operations.", true, cmd_debugdatetime },
   { "debugverbose", "Global debug verbosity override (forces all debug + loglevel=DEBUG).", true, cmd_debugverbose, "Usage: debugverbose <0|1>" },
-  { "debugbuffer", "Show debug ring buffer status.", true, cmd_debugbuffer },
+  { "debugbuffer", "Show debug queue and per-sink throughput/drop status.", true, cmd_debugbuffer },
   { "debugcommandflow", "Debug command flow.", true, cmd_debugcommandflow, "Usage: debugcommandflow <0|1>" },
   { "debugusers", "Debug user management.", true, cmd_debugusers, "Usage: debugusers <0|1>" },
   { "debugsystem", "Debug system/boot operations.", true, cmd_debugsystem, "Usage: debugsystem <0|1>" },
@@ -3163,7 +3360,10 @@ uint64_t DebugManager::getDebugFlags() const { return gDebugFlags; }
 void DebugManager::setLogLevel(uint8_t level) { gLogLevel = level; }
 uint8_t DebugManager::getLogLevel() const { return gLogLevel; }
 
-void DebugManager::setSystemLogEnabled(bool enabled) { gSystemLogEnabled = enabled; }
+void DebugManager::setSystemLogEnabled(bool enabled) {
+  SystemLogStateGuard state;
+  gSystemLogEnabled = enabled;
+}
 bool DebugManager::isSystemLogEnabled() const { return gSystemLogEnabled; }
 
 void DebugManager::setLogCategoryTags(bool enabled) { gSystemLogCategoryTags = enabled; }
@@ -3284,11 +3484,14 @@ void systemLogAutoStart() {
   String filepath = generateSystemLogFilename();
   
   // Ensure any previous file handle is closed (safety check)
-  if (gSystemLogFile) {
-    fsLock("debug.log");
-    gSystemLogFile.flush();
-    gSystemLogFile.close();
-    fsUnlock();
+  {
+    SystemLogStateGuard state;
+    if (gSystemLogFile) {
+      fsLock("debug.log");
+      gSystemLogFile.flush();
+      gSystemLogFile.close();
+      fsUnlock();
+    }
   }
   
   // Create the log file
@@ -3303,10 +3506,13 @@ void systemLogAutoStart() {
   f.close();
   fsUnlock();
   
-  gSystemLogPath = filepath;
-  gSystemLogEnabled = true;
-  gSystemLogLastWrite = millis();
-  gOutputFlags |= OUTPUT_FILE;
+  {
+    SystemLogStateGuard state;
+    gSystemLogPath = filepath;
+    gSystemLogEnabled = true;
+    gSystemLogLastWrite = millis();
+    gOutputFlags |= OUTPUT_FILE;
+  }
   
   broadcastOutput("[SYSTEM_LOG] Auto-start enabled, logging to: " + filepath);
 }
@@ -150,6 +150,7 @@ extern int gDebugQueueSize;
 struct DebugMessage {
   unsigned long timestamp;
   uint64_t flags;  // Full 64-bit debug flag (matches debugQueuePrintf/isDebugFlagSet)
+  volatile uint8_t refCount;  // Outstanding sink references (owned by debugOutputTask fan-out)
   char text[DEBUG_MSG_SIZE];
 };
 
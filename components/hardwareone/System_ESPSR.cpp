@@ -8,6 +8,7 @@
 #include "System_BuildConfig.h"
 #include "System_MemUtil.h"
 #include "System_Microphone.h"
+#include "System_AudioCapture.h"
 #include "System_Mutex.h"
 #include "System_Command.h"
 #include "System_CLI.h"
@@ -30,7 +31,6 @@
 #include "esp_wn_iface.h"
 #include "esp_wn_models.h"
 #include "model_path.h"
-#include "driver/i2s_pdm.h"
 
 // Debug tags - use DEBUG_MICROPHONE flag and system logging macros
 #define TAG_SR "ESP_SR"
@@ -39,20 +39,11 @@
 #define WARN_SRF(fmt, ...)  WARN_SYSTEMF("[SR] " fmt, ##__VA_ARGS__)
 #define ERROR_SRF(fmt, ...) ERROR_SYSTEMF("[SR] " fmt, ##__VA_ARGS__)
 
-// I2S PDM Configuration for microphone (XIAO ESP32S3 Sense uses PDM mic)
-#define I2S_SR_NUM          I2S_NUM_0
+// Audio format expected by the AFE (PDM capture is shared via System_AudioCapture)
 #define I2S_SR_SAMPLE_RATE  16000
 #define I2S_SR_BITS         16
 #define I2S_SR_CHANNELS     1
 
-// Use PDM microphone pins from BuildConfig
-#ifndef MIC_CLK_PIN
-  #define MIC_CLK_PIN       42  // Default for XIAO ESP32S3 Sense
-#endif
-#ifndef MIC_DATA_PIN
-  #define MIC_DATA_PIN      41  // Default for XIAO ESP32S3 Sense
-#endif
-
 // Task configuration
 #define SR_TASK_STACK_SIZE  (8 * 1024)
 #define SR_TASK_PRIORITY    5
@@ -74,8 +65,8 @@ static const esp_mn_iface_t* gMNModel = nullptr;
 static SemaphoreHandle_t gMNCommandMutex = nullptr;
 static bool gMNCommandsAllocated = false;
 
-// I2S handle
-static i2s_chan_handle_t gI2SRxHandle = nullptr;
+// Shared capture ring consumer (I2S itself is owned by System_AudioCapture)
+static AudioConsumerId gSrCaptureId = AUDIO_CONSUMER_INVALID;
 static bool gRestoreMicAfterSR = false;
 
 // Statistics
@@ -252,6 +243,7 @@ static const uint32_t kAutoTuneStepDurationMs = 8000;  // 8 seconds per config
 #define SR_INFO_L(lvl, fmt, ...) do { if (gSrDebugLevel >= (lvl)) { INFO_SRF(fmt, ##__VA_ARGS__); } } while (0)
 
 enum class SrSnipDest : uint8_t { Auto = 0, SD = 1, LittleFS = 2 };
+enum class SrSnipTrigger : uint8_t { Wake = 0, Speech = 1 };
 
 static volatile bool gSrSnipEnabled = false;
 static volatile bool gSrSnipManualStartRequested = false;
@@ -259,6 +251,7 @@ static volatile bool gSrSnipManualStopRequested = false;
 static uint32_t gSrSnipPreMs = 800;
 static uint32_t gSrSnipMaxMs = 6000;
 static SrSnipDest gSrSnipDest = SrSnipDest::Auto;
+static volatile SrSnipTrigger gSrSnipTrigger = SrSnipTrigger::Wake;
 static const char* kSrSnipFolderSd = "/sd/ESP-SR Models/snips";
 static const char* kSrSnipFolderInternal = "/sr_snips";
 
@@ -277,6 +270,11 @@ static int gSrSnipSessionCmdId = -1;
 static char gSrSnipSessionPhrase[64] = {0};
 static char gSrSnipSessionReason[16] = {0};
 
+// Skip AFE feed/fetch while the capture VAD reports silence (not while a command is pending)
+static volatile bool gSrVadGateEnabled = true;
+#define SR_VAD_PREROLL_CHUNKS 6   // Feed chunks kept while gated so the wake word onset survives
+static volatile uint32_t gSrVadGatedChunks = 0;
+
 typedef struct {
   int16_t* pcm;
   uint32_t samples;
@@ -1360,6 +1358,8 @@ static void srDebugPrintTelemetry() {
   WARN_SYSTEMF("[SR] I2S: reads_ok=%u, reads_err=%u, reads_zero=%u, bytes_ok=%llu",
            (unsigned)gSrI2SReadOk, (unsigned)gSrI2SReadErr, (unsigned)gSrI2SReadZero, (unsigned long long)gSrI2SBytesOk);
   WARN_SYSTEMF("[SR] I2S: est_rate=%.1f Hz", gSrEstSampleRateHz);
+  WARN_SYSTEMF("[SR] VAD gate: %s, speech=%s, gated_chunks=%u",
+               gSrVadGateEnabled ? "on" : "off", audioCaptureSpeechActive() ? "yes" : "no", (unsigned)gSrVadGatedChunks);
   WARN_SYSTEMF("[SR] PCM: min=%d, max=%d, abs_avg=%.1f",
            (int)gSrLastPcmMin, (int)gSrLastPcmMax, gSrLastPcmAbsAvg);
   WARN_SYSTEMF("[SR] AFE: feed_chunk=%d, fetch_chunk=%d", gSrAfeFeedChunk, gSrAfeFetchChunk);
@@ -1536,132 +1536,23 @@ static bool saveCommandsFileLocked(size_t& outSaved) {
 // ============================================================================
 
 static bool initI2SMicrophone() {
-  WARN_SYSTEMF("[SR_I2S] ========== initI2SMicrophone() START ==========");
-  WARN_SYSTEMF("[SR_I2S] Heap: free=%u, PSRAM_free=%u", 
-               (unsigned)esp_get_free_heap_size(), 
-               (unsigned)heap_caps_get_free_size(MALLOC_CAP_SPIRAM));
-
-  I2sMicLockGuard i2sGuard("sr.i2s.init");
-  
-  // Create I2S channel for PDM RX
-  i2s_chan_config_t chan_cfg = I2S_CHANNEL_DEFAULT_CONFIG(I2S_SR_NUM, I2S_ROLE_MASTER);
-  chan_cfg.dma_desc_num = 4;
-  chan_cfg.dma_frame_num = 1024;
-  
-  WARN_SYSTEMF("[SR_I2S] Channel config: i2s_num=%d, dma_desc_num=%d, dma_frame_num=%d",
-               (int)I2S_SR_NUM, (int)chan_cfg.dma_desc_num, (int)chan_cfg.dma_frame_num);
-  
-  WARN_SYSTEMF("[SR_I2S] Calling i2s_new_channel()...");
-  esp_err_t err = i2s_new_channel(&chan_cfg, nullptr, &gI2SRxHandle);
-  WARN_SYSTEMF("[SR_I2S] i2s_new_channel returned: 0x%x (%s), handle=%p", 
-               err, esp_err_to_name(err), gI2SRxHandle);
-  if (err != ESP_OK) {
-    ERROR_SRF("Failed to create I2S channel: %s", esp_err_to_name(err));
+  // Attach to the shared capture ring. If the microphone sensor is already
+  // capturing at 16 kHz this just adds a cursor; otherwise it starts I2S.
+  gSrCaptureId = audioCaptureAcquire("sr", I2S_SR_SAMPLE_RATE);
+  if (gSrCaptureId == AUDIO_CONSUMER_INVALID) {
+    ERROR_SRF("Audio capture unavailable at %d Hz (running at %lu Hz)",
+              I2S_SR_SAMPLE_RATE, (unsigned long)audioCaptureSampleRate());
     return false;
   }
-  
-  // Configure PDM RX mode for the onboard PDM microphone
-  // XIAO ESP32S3 Sense MSM261S4030H0R outputs on LEFT channel
-  i2s_pdm_rx_slot_config_t slot_cfg =
-#ifdef I2S_PDM_RX_SLOT_PCM_FMT_DEFAULT_CONFIG
-    I2S_PDM_RX_SLOT_PCM_FMT_DEFAULT_CONFIG(I2S_DATA_BIT_WIDTH_16BIT, I2S_SLOT_MODE_MONO);
-#else
-    I2S_PDM_RX_SLOT_DEFAULT_CONFIG(I2S_DATA_BIT_WIDTH_16BIT, I2S_SLOT_MODE_MONO);
-#endif
-
-#if !defined(I2S_PDM_RX_SLOT_PCM_FMT_DEFAULT_CONFIG) && defined(I2S_PDM_DATA_FMT_PCM)
-  slot_cfg.data_fmt = I2S_PDM_DATA_FMT_PCM;
-#endif
-
-  i2s_pdm_rx_config_t pdm_cfg = {
-    .clk_cfg = I2S_PDM_RX_CLK_DEFAULT_CONFIG(I2S_SR_SAMPLE_RATE),
-    .slot_cfg = slot_cfg,
-    .gpio_cfg = {
-      .clk = (gpio_num_t)MIC_CLK_PIN,
-      .din = (gpio_num_t)MIC_DATA_PIN,
-      .invert_flags = {
-        .clk_inv = false,
-      },
-    },
-  };
-
-  WARN_SYSTEMF("[SR_I2S] PDM clk_cfg: sample_rate_hz=%u, clk_src=%d, mclk_mult=%d, bclk_div=%u",
-            (unsigned)pdm_cfg.clk_cfg.sample_rate_hz,
-            (int)pdm_cfg.clk_cfg.clk_src,
-            (int)pdm_cfg.clk_cfg.mclk_multiple,
-            (unsigned)pdm_cfg.clk_cfg.bclk_div);
-  WARN_SYSTEMF("[SR_I2S] PDM gpio_cfg: clk=%d, din=%d, clk_inv=%d",
-            (int)pdm_cfg.gpio_cfg.clk, (int)pdm_cfg.gpio_cfg.din,
-            (int)pdm_cfg.gpio_cfg.invert_flags.clk_inv);
-
-#ifdef I2S_PDM_RX_SLOT_PCM_FMT_DEFAULT_CONFIG
-  WARN_SYSTEMF("[SR_I2S] PDM slot cfg: I2S_PDM_RX_SLOT_PCM_FMT_DEFAULT_CONFIG");
-#else
-  WARN_SYSTEMF("[SR_I2S] PDM slot cfg: I2S_PDM_RX_SLOT_DEFAULT_CONFIG%s", 
-#ifdef I2S_PDM_DATA_FMT_PCM
-            " + data_fmt=PCM"
-#else
-            ""
-#endif
-  );
-#endif
-  
-  WARN_SYSTEMF("[SR_I2S] Calling i2s_channel_init_pdm_rx_mode()...");
-  err = i2s_channel_init_pdm_rx_mode(gI2SRxHandle, &pdm_cfg);
-  WARN_SYSTEMF("[SR_I2S] i2s_channel_init_pdm_rx_mode returned: 0x%x (%s)", err, esp_err_to_name(err));
-  if (err != ESP_OK) {
-    ERROR_SRF("Failed to init I2S PDM RX mode: %s", esp_err_to_name(err));
-    i2s_del_channel(gI2SRxHandle);
-    gI2SRxHandle = nullptr;
-    return false;
-  }
-  
-  WARN_SYSTEMF("[SR_I2S] Calling i2s_channel_enable()...");
-  err = i2s_channel_enable(gI2SRxHandle);
-  WARN_SYSTEMF("[SR_I2S] i2s_channel_enable returned: 0x%x (%s)", err, esp_err_to_name(err));
-  if (err != ESP_OK) {
-    ERROR_SRF("Failed to enable I2S channel: %s", esp_err_to_name(err));
-    i2s_del_channel(gI2SRxHandle);
-    gI2SRxHandle = nullptr;
-    return false;
-  }
-
-  WARN_SYSTEMF("[SR_I2S] Starting PDM warm-up flush (10 reads of 512 bytes)...");
-  {
-    int16_t flushBuf[256];
-    size_t flushBytesRead = 0;
-    int flushOkCount = 0;
-    for (int i = 0; i < 10; i++) {
-      esp_err_t flushErr = i2s_channel_read(gI2SRxHandle, flushBuf, sizeof(flushBuf), &flushBytesRead, pdMS_TO_TICKS(100));
-      if (flushErr == ESP_OK && flushBytesRead > 0) {
-        flushOkCount++;
-        if (i == 9) {
-          int16_t mn = 32767, mx = -32768;
-          for (size_t j = 0; j < flushBytesRead / 2; j++) {
-            if (flushBuf[j] < mn) mn = flushBuf[j];
-            if (flushBuf[j] > mx) mx = flushBuf[j];
-          }
-          WARN_SYSTEMF("[SR_I2S] Flush[%d]: %u bytes, min=%d, max=%d", i, (unsigned)flushBytesRead, mn, mx);
-        }
-      } else {
-        WARN_SYSTEMF("[SR_I2S] Flush[%d]: err=0x%x, bytes=%u", i, flushErr, (unsigned)flushBytesRead);
-      }
-    }
-    WARN_SYSTEMF("[SR_I2S] Warm-up flush complete: %d/10 reads OK", flushOkCount);
-  }
-  
-  WARN_SYSTEMF("[SR_I2S] ========== initI2SMicrophone() SUCCESS ==========");
-  INFO_SRF("PDM microphone initialized (CLK=%d, DATA=%d)", MIC_CLK_PIN, MIC_DATA_PIN);
+  INFO_SRF("Attached to audio capture ring (consumer %d)", (int)gSrCaptureId);
   return true;
 }
 
 static void deinitI2SMicrophone() {
-  if (gI2SRxHandle) {
-    I2sMicLockGuard i2sGuard("sr.i2s.deinit");
-    i2s_channel_disable(gI2SRxHandle);
-    i2s_del_channel(gI2SRxHandle);
-    gI2SRxHandle = nullptr;
-    DEBUG_SRF("I2S microphone deinitialized");
+  if (gSrCaptureId != AUDIO_CONSUMER_INVALID) {
+    audioCaptureRelease(gSrCaptureId);
+    gSrCaptureId = AUDIO_CONSUMER_INVALID;
+    DEBUG_SRF("Detached from audio capture ring");
   }
 }
 
@@ -2009,11 +1900,12 @@ static void srTask(void* param) {
 
   WARN_SYSTEMF("[SR_TASK] Buffers allocated OK. feed_chunk=%u samples, i2s_read_cap=%u samples, ring_cap=%u samples, mn_cap=%u samples",
                (unsigned)feedChunkSamples, (unsigned)i2sReadSamplesCap, (unsigned)ringSamplesCap, (unsigned)mnBufSamplesCap);
-  WARN_SYSTEMF("[SR_TASK] gI2SRxHandle=%p", gI2SRxHandle);
+  WARN_SYSTEMF("[SR_TASK] capture consumer=%d", (int)gSrCaptureId);
   SR_DBG_L(1, "SR buffers: feed_chunk=%u samples, read_cap=%u samples (%u bytes), ring_cap=%u samples",
            (unsigned)feedChunkSamples, (unsigned)i2sReadSamplesCap, (unsigned)i2sReadBytes, (unsigned)ringSamplesCap);
   
   bool listeningForCommand = false;
+  bool prevSpeechActive = false;
   uint32_t commandTimeoutMs = 0;
   bool commandSpeechStarted = false;  // Has user started speaking the command?
   uint32_t loopCount = 0;
@@ -2048,12 +1940,11 @@ static void srTask(void* param) {
       }
     }
     
-    size_t bytesRead = 0;
     uint32_t readStartMs = millis();
-    esp_err_t err;
-    {
-      I2sMicLockGuard i2sGuard("sr.i2s.read");
-      err = i2s_channel_read(gI2SRxHandle, i2sReadBuf, i2sReadBytes, &bytesRead, pdMS_TO_TICKS(100));
+    esp_err_t err = (gSrCaptureId != AUDIO_CONSUMER_INVALID) ? ESP_OK : ESP_ERR_INVALID_STATE;
+    size_t bytesRead = 0;
+    if (err == ESP_OK) {
+      bytesRead = audioCaptureRead(gSrCaptureId, i2sReadBuf, i2sReadSamplesCap, pdMS_TO_TICKS(100)) * sizeof(int16_t);
     }
     uint32_t readDurationMs = millis() - readStartMs;
     
@@ -2111,6 +2002,17 @@ static void srTask(void* param) {
     if (gSrSnipEnabled && gSrSnipRing) {
       srSnipRingPush(i2sReadBuf, samplesRead);
     }
+
+    bool speechActive = audioCaptureSpeechActive();
+    if (gSrSnipEnabled && gSrSnipTrigger == SrSnipTrigger::Speech && speechActive != prevSpeechActive) {
+      if (speechActive && !gSrSnipSessionActive) {
+        srSnipStartSession("speech", -1, nullptr);
+      } else if (!speechActive && gSrSnipSessionActive && strcmp(gSrSnipSessionReason, "speech") == 0) {
+        srSnipEndSession(true);
+      }
+    }
+    prevSpeechActive = speechActive;
+
     if (gSrSnipSessionActive) {
       srSnipFeedSession(i2sReadBuf, samplesRead);
     }
@@ -2144,6 +2046,19 @@ static void srTask(void* param) {
       }
     }
 
+    // Silence gate: keep only a short pre-roll and leave the AFE idle. Feeding
+    // resumes on VAD onset, starting with the pre-roll, so wake words are not clipped.
+    if (gSrVadGateEnabled && !listeningForCommand && !speechActive) {
+      size_t keep = feedChunkSamples * SR_VAD_PREROLL_CHUNKS;
+      if (ringCount > keep) {
+        size_t drop = ringCount - keep;
+        gSrVadGatedChunks += (uint32_t)(drop / feedChunkSamples);
+        ringHead = (ringHead + drop) % ringSamplesCap;
+        ringCount = keep;
+      }
+      continue;
+    }
+
     if (gAFE && gAFEData) {
       while (ringCount >= feedChunkSamples) {
         size_t first = feedChunkSamples;
@@ -2245,7 +2160,7 @@ static void srTask(void* param) {
                    gWakeWordCount, fetchResult->wake_word_index, fetchResult->wakenet_model_index,
                    fetchResult->data_volume, fetchResult->wake_word_length);
           
-          if (gSrSnipEnabled && !gSrSnipSessionActive) {
+          if (gSrSnipEnabled && gSrSnipTrigger == SrSnipTrigger::Wake && !gSrSnipSessionActive) {
             srSnipStartSession("wake", -1, nullptr);
           }
           
@@ -2574,10 +2489,11 @@ bool startESPSR() {
   INFO_SRF("Starting ESP-SR pipeline...");
 
 #if ENABLE_MICROPHONE_SENSOR
-  WARN_SYSTEMF("[SR_START] Checking microphone sensor: micEnabled=%d", micEnabled ? 1 : 0);
-  if (micEnabled) {
+  WARN_SYSTEMF("[SR_START] Checking microphone sensor: micEnabled=%d, rate=%d", micEnabled ? 1 : 0, micSampleRate);
+  // Same-rate capture is shared; only a different rate needs the mic closed
+  if (micEnabled && micSampleRate != I2S_SR_SAMPLE_RATE) {
     gRestoreMicAfterSR = true;
-    INFO_SRF("Microphone sensor is running; stopping it to start SR");
+    INFO_SRF("Microphone sensor is running at %d Hz; stopping it to start SR", micSampleRate);
     if (micRecording) {
       stopRecording();
     }
@@ -3640,10 +3556,52 @@ static const char* cmd_sr_tuning_filters(const String& argsInput) {
   return "Usage: sr tuning filters <on|off>";
 }
 
+static const char* cmd_sr_tuning_vadgate(const String& argsInput) {
+  RETURN_VALID_IF_VALIDATE_CSTR();
+  String args = argsInput;
+  args.trim();
+  args.toLowerCase();
+  if (args.length() == 0) {
+    static char buf[96];
+    snprintf(buf, sizeof(buf), "VAD gate: %s (gated chunks=%lu, speech=%s)",
+             gSrVadGateEnabled ? "on" : "off", (unsigned long)gSrVadGatedChunks,
+             audioCaptureSpeechActive() ? "yes" : "no");
+    return buf;
+  }
+  if (args == "on" || args == "1") {
+    gSrVadGateEnabled = true;
+    return "VAD gate ENABLED (AFE idles during silence)";
+  }
+  if (args == "off" || args == "0") {
+    gSrVadGateEnabled = false;
+    return "VAD gate DISABLED (AFE runs continuously)";
+  }
+  return "Usage: sr tuning vadgate [on|off]";
+}
+
 static const char* cmd_sr_snip(const String& argsInput) {
   RETURN_VALID_IF_VALIDATE_CSTR();
   (void)argsInput;
-  return "Usage: sr snip <on|off|start|stop|status|config>";
+  return "Usage: sr snip <on|off|start|stop|status|config|trigger>";
+}
+
+static const char* cmd_sr_snip_trigger(const String& argsInput) {
+  RETURN_VALID_IF_VALIDATE_CSTR();
+  String args = argsInput;
+  args.trim();
+  args.toLowerCase();
+  if (args.length() == 0) {
+    return (gSrSnipTrigger == SrSnipTrigger::Speech) ? "Snippet trigger: speech" : "Snippet trigger: wake";
+  }
+  if (args == "wake") {
+    gSrSnipTrigger = SrSnipTrigger::Wake;
+    return "Snippets will start on the wake word";
+  }
+  if (args == "speech") {
+    gSrSnipTrigger = SrSnipTrigger::Speech;
+    return "Snippets will start on VAD speech onset and end with the utterance";
+  }
+  return "Usage: sr snip trigger <wake|speech>";
 }
 
 static const char* cmd_sr_snip_on(const String& argsInput) {
@@ -3656,7 +3614,9 @@ static const char* cmd_sr_snip_on(const String& argsInput) {
     return "Error: failed to initialize snippet capture";
   }
   gSrSnipEnabled = true;
-  return "Snippet capture enabled (will trigger on wake word)";
+  return (gSrSnipTrigger == SrSnipTrigger::Speech)
+           ? "Snippet capture enabled (will trigger on detected speech)"
+           : "Snippet capture enabled (will trigger on wake word)";
 }
 
 static const char* cmd_sr_snip_off(const String& argsInput) {
@@ -3696,6 +3656,8 @@ static const char* cmd_sr_snip_status(const String& argsInput) {
   out = "";
   out += "Snippet capture: ";
   out += gSrSnipEnabled ? "enabled" : "disabled";
+  out += "\nTrigger: ";
+  out += (gSrSnipTrigger == SrSnipTrigger::Speech) ? "speech" : "wake";
   out += "\nSession active: ";
   out += gSrSnipSessionActive ? "yes" : "no";
   out += "\nRing buffer: ";
@@ -3816,12 +3778,14 @@ const CommandEntry espsrCommands[] = {
   { "sr tuning agc", "Set AGC mode (0=off, 1-3=levels).", false, cmd_sr_tuning_agc, "Usage: sr tuning agc <0-3>" },
   { "sr tuning vad", "Set VAD sensitivity (0-4).", false, cmd_sr_tuning_vad, "Usage: sr tuning vad <0-4>" },
   { "sr tuning filters", "Toggle audio filters (high-pass + pre-emphasis).", false, cmd_sr_tuning_filters, "Usage: sr tuning filters <on|off>" },
-  { "sr snip", "Voice snippet capture commands.", false, cmd_sr_snip, "Usage: sr snip <on|off|start|stop|status|config>" },
-  { "sr snip on", "Enable auto-capture on wake word.", false, cmd_sr_snip_on, "Usage: sr snip on" },
+  { "sr tuning vadgate", "Skip wake-word inference while the capture VAD reports silence.", false, cmd_sr_tuning_vadgate, "Usage: sr tuning vadgate [on|off]" },
+  { "sr snip", "Voice snippet capture commands.", false, cmd_sr_snip, "Usage: sr snip <on|off|start|stop|status|config|trigger>" },
+  { "sr snip on", "Enable auto-capture (wake word or speech, see trigger).", false, cmd_sr_snip_on, "Usage: sr snip on" },
   { "sr snip off", "Disable auto-capture.", false, cmd_sr_snip_off, "Usage: sr snip off" },
   { "sr snip start", "Start manual snippet capture now.", false, cmd_sr_snip_start, "Usage: sr snip start" },
   { "sr snip stop", "Stop manual snippet capture and save.", false, cmd_sr_snip_stop, "Usage: sr snip stop" },
   { "sr snip status", "Show snippet capture status.", false, cmd_sr_snip_status, "Usage: sr snip status" },
+  { "sr snip trigger", "Start snippets on the wake word or on VAD speech onset.", false, cmd_sr_snip_trigger, "Usage: sr snip trigger [wake|speech]" },
   { "sr snip config", "Configure snippet capture params.", false, cmd_sr_snip_config, "Usage: sr snip config [pre_ms|max_ms|dest] [value]" },
   // Global voice commands - voiceCategory="*" means available at all stages
   { "voice cancel", "Cancel current voice command sequence.", false, cmd_voice_cancel, nullptr, "*", "cancel" },
@@ -708,7 +708,7 @@ uint8_t getDirPerms(const String& dirPath) {
 
 bool readTextLimited(const char* path, String& out, size_t maxBytes) {
   out = "";
-  FsLockGuard guard("readTextLimited");
+  FsPathReadGuard guard(path);
   File f = LittleFS.open(path, "r");
   if (!f) return false;
   out.reserve(maxBytes);
@@ -732,7 +732,7 @@ bool readTextLimited(const char* path, String& out, size_t maxBytes) {
 }
 
 bool appendLineWithCap(const char* path, const String& line, size_t capBytes) {
-  FsLockGuard guard("appendLineWithCap");
+  FsPathWriteGuard guard(path);
   {
     File a = LittleFS.open(path, "a");
     if (!a) return false;
@@ -139,6 +139,7 @@ static void rebootWithMessage(const char* message) {
   broadcastOutput("");
   broadcastOutput(message);
   clearOledIfActive();
+  flushPendingSettings();
   delay(1000);
   ESP.restart();
 }
@@ -0,0 +1,258 @@
+/**
+ * Filesystem Service Implementation
+ *
+ * Single worker task; requests are queued by pointer and serviced one chunk at a
+ * time in round-robin order. The worker never holds a path lock between chunks.
+ */
+
+#include "System_FsService.h"
+#include "System_Debug.h"
+#include "System_Filesystem.h"
+#include "System_MemUtil.h"
+#include "System_Mutex.h"
+#include "System_TaskUtils.h"
+#include "WebServer_ResponseCache.h"  // respCacheInvalidate
+#include <LittleFS.h>
+#include <freertos/queue.h>
+
+enum FsAsyncOp : uint8_t {
+  FS_ASYNC_READ = 0,
+  FS_ASYNC_WRITE,
+  FS_ASYNC_APPEND
+};
+
+struct FsAsyncJob {
+  FsAsyncOp op;
+  char path[96];
+  char partPath[112];         // Staging file for whole-file writes: <path>.<jobId>.part
+  size_t offset;              // Read start offset
+  size_t length;              // Bytes requested (0 = to EOF for reads)
+  size_t done;                // Bytes transferred so far
+  size_t fileSize;            // Read: size seen by the first chunk
+  size_t pendingLen;          // Read: bytes in buf not yet taken by onChunk
+  bool eof;                   // Read: buf holds the last chunk
+  uint8_t* buf;               // Read: per-job chunk buffer (held across RETRY)
+  const uint8_t* data;        // Write source (caller-owned)
+  FsAsyncChunkCallback onChunk;
+  FsAsyncDoneCallback onDone;
+  void* ctx;
+};
+
+static QueueHandle_t gFsAsyncQueue = nullptr;
+static TaskHandle_t gFsAsyncTask = nullptr;
+static uint32_t gFsAsyncNextJobId = 0;
+
+static void finishJob(FsAsyncJob* job, bool ok) {
+  if (job->op == FS_ASYNC_WRITE && !ok) {
+    FsPathWriteGuard guard(job->partPath);
+    LittleFS.remove(job->partPath);
+  }
+  if (job->op != FS_ASYNC_READ) respCacheInvalidate(RESP_SRC_FILESYSTEM);
+  DEBUG_STORAGEF("[FsAsync] %s '%s' %s (%u bytes)",
+                 job->op == FS_ASYNC_READ ? "read" : job->op == FS_ASYNC_APPEND ? "append" : "write",
+                 job->path, ok ? "done" : "FAILED", (unsigned)job->done);
+  if (job->onDone) job->onDone(ok, job->done, job->ctx);
+  if (job->buf) free(job->buf);
+  free(job);
+}
+
+// Service one chunk. Returns 1 = more to do, 0 = finished ok, -1 = failed.
+static int stepReadJob(FsAsyncJob* job) {
+  if (job->pendingLen == 0) {
+    FsPathReadGuard guard(job->path);
+    File f = LittleFS.open(job->path, "r");
+    if (!f) return -1;
+    size_t fileSize = f.size();
+    // The path lock is dropped between chunks: a replaced file would splice two
+    // versions into one transfer
+    if (job->done == 0) job->fileSize = fileSize;
+    else if (fileSize != job->fileSize) {
+      f.close();
+      return -1;
+    }
+    size_t pos = job->offset + job->done;
+    size_t end = job->length ? job->offset + job->length : fileSize;
+    if (end > fileSize) end = fileSize;
+    if (pos >= end) {
+      f.close();
+      return 0;
+    }
+    size_t want = end - pos;
+    if (want > FS_ASYNC_CHUNK_SIZE) want = FS_ASYNC_CHUNK_SIZE;
+    if (!f.seek(pos)) {
+      f.close();
+      return -1;
+    }
+    size_t n = f.read(job->buf, want);
+    f.close();
+    if (n == 0) return -1;
+    job->pendingLen = n;
+    job->eof = (pos + n >= end);
+  }
+
+  // Callback runs without the path lock held
+  FsAsyncChunkResult r = job->onChunk
+      ? job->onChunk(job->buf, job->pendingLen, job->offset + job->done, job->ctx)
+      : FS_CHUNK_TAKEN;
+  if (r == FS_CHUNK_ABORT) return -1;
+  if (r == FS_CHUNK_RETRY) return 1;
+  job->done += job->pendingLen;
+  job->pendingLen = 0;
+  return job->eof ? 0 : 1;
+}
+
+static int stepWriteJob(FsAsyncJob* job) {
+  bool append = (job->op == FS_ASYNC_APPEND);
+  const char* target = append ? job->path : job->partPath;
+
+  size_t want = job->length - job->done;
+  if (want > FS_ASYNC_CHUNK_SIZE) want = FS_ASYNC_CHUNK_SIZE;
+
+  if (want > 0) {
+    FsPathWriteGuard guard(target);
+    File f = LittleFS.open(target, (!append && job->done == 0) ? "w" : "a", true);
+    if (!f) return -1;
+    size_t w = f.write(job->data + job->done, want);
+    f.close();
+    if (w != want) return -1;
+    job->done += w;
+  }
+
+  if (job->done < job->length) return 1;
+
+  if (!append) {
+    // Commit: swap the staged file into place under the destination's write lock
+    FsPathWriteGuard dstGuard(job->path);
+    FsPathWriteGuard partGuard(job->partPath);
+    if (job->length == 0) {
+      File f = LittleFS.open(job->partPath, "w");
+      if (f) f.close();
+    }
+    LittleFS.remove(job->path);
+    if (!LittleFS.rename(job->partPath, job->path)) return -1;
+  }
+  return 0;
+}
+
+static void fsAsyncTask(void* parameter) {
+  FsAsyncJob* active[FS_ASYNC_MAX_ACTIVE] = {nullptr};
+  size_t activeCount = 0;
+
+  while (true) {
+    // Block only when idle; otherwise just pick up newly queued work
+    TickType_t wait = activeCount ? 0 : portMAX_DELAY;
+    FsAsyncJob* incoming = nullptr;
+    while (activeCount < FS_ASYNC_MAX_ACTIVE &&
+           xQueueReceive(gFsAsyncQueue, &incoming, wait) == pdTRUE) {
+      active[activeCount++] = incoming;
+      wait = 0;
+    }
+
+    // One chunk per active job per round
+    for (size_t i = 0; i < activeCount;) {
+      FsAsyncJob* job = active[i];
+      int r = (job->op == FS_ASYNC_READ) ? stepReadJob(job) : stepWriteJob(job);
+      if (r <= 0) {
+        finishJob(job, r == 0);
+        active[i] = active[--activeCount];
+        active[activeCount] = nullptr;
+        continue;
+      }
+      i++;
+    }
+
+    // Let other tasks' small filesystem operations in between rounds
+    if (activeCount) vTaskDelay(1);
+  }
+}
+
+static bool ensureFsAsyncService() {
+  if (gFsAsyncTask) return true;
+  if (!filesystemReady) return false;
+
+  if (!gFsAsyncQueue) {
+    gFsAsyncQueue = xQueueCreate(FS_ASYNC_QUEUE_DEPTH, sizeof(FsAsyncJob*));
+    if (!gFsAsyncQueue) return false;
+  }
+  if (xTaskCreateLogged(fsAsyncTask, "fs_async", FS_ASYNC_STACK_WORDS, nullptr, 1, &gFsAsyncTask, "fs.async") != pdPASS) {
+    gFsAsyncTask = nullptr;
+    ERROR_STORAGEF("Failed to create fs_async task");
+    return false;
+  }
+  return true;
+}
+
+static bool submitJob(FsAsyncJob* job) {
+  if (!ensureFsAsyncService() || xQueueSend(gFsAsyncQueue, &job, pdMS_TO_TICKS(100)) != pdTRUE) {
+    if (job->buf) free(job->buf);
+    free(job);
+    return false;
+  }
+  return true;
+}
+
+static FsAsyncJob* newJob(FsAsyncOp op, const char* path) {
+  if (!path || strlen(path) >= sizeof(FsAsyncJob::path)) return nullptr;
+  FsAsyncJob* job = (FsAsyncJob*)ps_alloc(sizeof(FsAsyncJob), AllocPref::PreferPSRAM, "fs.async.job");
+  if (!job) return nullptr;
+  memset(job, 0, sizeof(*job));
+  job->op = op;
+  strncpy(job->path, path, sizeof(job->path) - 1);
+  // Own staging file per job: two saves of one path in flight must not interleave
+  // their chunks into a shared .part (IDs restart at boot, so leftovers get reused)
+  uint32_t jobId = __atomic_fetch_add(&gFsAsyncNextJobId, 1, __ATOMIC_RELAXED);
+  snprintf(job->partPath, sizeof(job->partPath), "%s.%lx.part", path, (unsigned long)jobId);
+  return job;
+}
+
+bool fsAsyncRead(const char* path, size_t offset, size_t length,
+                 FsAsyncChunkCallback onChunk, FsAsyncDoneCallback onDone, void* ctx) {
+  FsAsyncJob* job = newJob(FS_ASYNC_READ, path);
+  if (!job) return false;
+  // Per job rather than shared: a chunk the consumer has not taken yet stays put
+  job->buf = (uint8_t*)ps_alloc(FS_ASYNC_CHUNK_SIZE, AllocPref::PreferPSRAM, "fs.async.read");
+  if (!job->buf) {
+    free(job);
+    return false;
+  }
+  job->offset = offset;
+  job->length = length;
+  job->onChunk = onChunk;
+  job->onDone = onDone;
+  job->ctx = ctx;
+  return submitJob(job);
+}
+
+bool fsAsyncWrite(const char* path, const uint8_t* data, size_t length, bool append,
+                  FsAsyncDoneCallback onDone, void* ctx) {
+  if (!data && length > 0) return false;
+  FsAsyncJob* job = newJob(append ? FS_ASYNC_APPEND : FS_ASYNC_WRITE, path);
+  if (!job) return false;
+  job->data = data;
+  job->length = length;
+  job->onDone = onDone;
+  job->ctx = ctx;
+  return submitJob(job);
+}
+
+struct FsSyncWait {
+  SemaphoreHandle_t done;
+  bool ok;
+};
+
+static void fsSyncDone(bool ok, size_t bytes, void* ctx) {
+  (void)bytes;
+  FsSyncWait* w = (FsSyncWait*)ctx;
+  w->ok = ok;
+  xSemaphoreGive(w->done);
+}
+
+bool fsChunkedWrite(const char* path, const uint8_t* data, size_t length, bool append) {
+  if (xTaskGetCurrentTaskHandle() == gFsAsyncTask) return false;
+  FsSyncWait w = { xSemaphoreCreateBinary(), false };
+  if (!w.done) return false;
+  bool queued = fsAsyncWrite(path, data, length, append, fsSyncDone, &w);
+  if (queued) xSemaphoreTake(w.done, portMAX_DELAY);
+  vSemaphoreDelete(w.done);
+  return queued && w.ok;
+}
@@ -0,0 +1,54 @@
+/**
+ * Filesystem Service - chunked, asynchronous bulk file I/O
+ *
+ * Large reads and writes are split into FS_ASYNC_CHUNK_SIZE pieces and serviced
+ * round-robin by a single worker task. Each chunk takes its per-path lock
+ * (FsPathReadGuard/FsPathWriteGuard in System_Mutex.h) only for that chunk, so
+ * settings saves, log appends and other small operations interleave with a
+ * multi-hundred-KB transfer instead of waiting for it to finish.
+ *
+ * Whole-file writes go to "<path>.<jobId>.part" and are renamed into place on
+ * success, so readers never observe a partially written file and concurrent
+ * saves of one path never share a staging file (the last commit wins).
+ */
+
+#ifndef FS_SERVICE_H
+#define FS_SERVICE_H
+
+#include <Arduino.h>
+
+#define FS_ASYNC_CHUNK_SIZE   4096  // Bytes moved per lock acquisition
+#define FS_ASYNC_QUEUE_DEPTH  8     // Pending requests
+#define FS_ASYNC_MAX_ACTIVE   4     // Requests serviced round-robin at once
+
+// What a read consumer did with the chunk it was offered
+enum FsAsyncChunkResult : uint8_t {
+  FS_CHUNK_TAKEN = 0,   // Consumed; the read advances
+  FS_CHUNK_RETRY,       // No room yet; the same chunk is offered again next round
+  FS_CHUNK_ABORT        // Stop the read; onDone reports failure
+};
+
+// Read: called on the fs_async task for each chunk (data valid only during the call).
+// Returning FS_CHUNK_RETRY applies backpressure without blocking the worker.
+typedef FsAsyncChunkResult (*FsAsyncChunkCallback)(const uint8_t* data, size_t len, size_t offset, void* ctx);
+
+// Completion: called once on the fs_async task with total bytes transferred
+typedef void (*FsAsyncDoneCallback)(bool ok, size_t bytes, void* ctx);
+
+// Queue a chunked read of [offset, offset+length) (length 0 = to end of file).
+// Fails if the file is replaced or resized while the read is in progress.
+// Returns false if the request could not be queued.
+bool fsAsyncRead(const char* path, size_t offset, size_t length,
+                 FsAsyncChunkCallback onChunk, FsAsyncDoneCallback onDone, void* ctx);
+
+// Queue a chunked write. 'data' must stay valid until onDone runs.
+// append=false replaces the file atomically (via a per-job .part file + rename).
+// Returns false if the request could not be queued.
+bool fsAsyncWrite(const char* path, const uint8_t* data, size_t length, bool append,
+                  FsAsyncDoneCallback onDone, void* ctx);
+
+// Blocking convenience wrapper: chunked write that returns when complete.
+// Must not be called from the fs_async task itself.
+bool fsChunkedWrite(const char* path, const uint8_t* data, size_t length, bool append);
+
+#endif // FS_SERVICE_H
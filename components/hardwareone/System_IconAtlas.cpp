@@ -0,0 +1,153 @@
+/**
+ * System_IconAtlas.cpp - Icon name index and pre-rasterized icon cache
+ *
+ * findEmbeddedIcon() used to strcpy_P + strcmp every registry entry on each
+ * draw. Names are now hashed once into an open-addressed index, and the
+ * drawable rasters (MSB-first, optionally downscaled) are cached so menus and
+ * dashboards blit icons instead of resampling 1024 pixels per frame.
+ */
+
+#include "System_Icons.h"
+#include "System_MemUtil.h"
+
+// ============================================================================
+// Name index
+// ============================================================================
+
+#define ICON_INDEX_SLOTS  256   // Power of two, > 2x icon count
+#define ICON_INDEX_EMPTY  0     // Slots hold registry index + 1
+
+static uint8_t sIconIndex[ICON_INDEX_SLOTS];
+static volatile bool sIconIndexReady = false;
+
+static inline uint32_t iconNameHash(const char* s) {
+  uint32_t h = 2166136261u;  // FNV-1a
+  while (*s) {
+    h ^= (uint8_t)*s++;
+    h *= 16777619u;
+  }
+  return h;
+}
+
+static void buildIconIndex() {
+  // Built into a local table and published in one copy, so a caller on another
+  // task never probes a half-filled index. Two racing builders write identical data.
+  uint8_t table[ICON_INDEX_SLOTS];
+  memset(table, ICON_INDEX_EMPTY, sizeof(table));
+
+  size_t count = EMBEDDED_ICONS_COUNT < 255 ? EMBEDDED_ICONS_COUNT : 255;
+  for (size_t i = 0; i < count; i++) {
+    const char* name = (const char*)pgm_read_ptr(&EMBEDDED_ICONS[i].name);
+    uint32_t slot = iconNameHash(name) & (ICON_INDEX_SLOTS - 1);
+    bool duplicate = false;
+    while (table[slot] != ICON_INDEX_EMPTY) {
+      const char* other = (const char*)pgm_read_ptr(&EMBEDDED_ICONS[table[slot] - 1].name);
+      if (strcmp(other, name) == 0) { duplicate = true; break; }
+      slot = (slot + 1) & (ICON_INDEX_SLOTS - 1);
+    }
+    // Keep the first registration, matching the old linear scan
+    if (!duplicate) table[slot] = (uint8_t)(i + 1);
+  }
+
+  memcpy(sIconIndex, table, sizeof(table));
+  __atomic_store_n(&sIconIndexReady, true, __ATOMIC_RELEASE);
+}
+
+const EmbeddedIcon* findEmbeddedIcon(const char* name) {
+  if (!name || !*name) return nullptr;
+  if (!__atomic_load_n(&sIconIndexReady, __ATOMIC_ACQUIRE)) buildIconIndex();
+
+  uint32_t slot = iconNameHash(name) & (ICON_INDEX_SLOTS - 1);
+  while (sIconIndex[slot] != ICON_INDEX_EMPTY) {
+    const EmbeddedIcon* icon = &EMBEDDED_ICONS[sIconIndex[slot] - 1];
+    if (strcmp((const char*)pgm_read_ptr(&icon->name), name) == 0) return icon;
+    slot = (slot + 1) & (ICON_INDEX_SLOTS - 1);
+  }
+  return nullptr;
+}
+
+// ============================================================================
+// Raster cache
+// ============================================================================
+
+#define ICON_ATLAS_SLOTS       24    // A full menu page plus status/ribbon icons
+#define ICON_ATLAS_MAX_BYTES   ((ICON_ATLAS_MAX_SIZE + 7) / 8 * ICON_ATLAS_MAX_SIZE)
+
+struct IconAtlasSlot {
+  const EmbeddedIcon* icon;
+  uint32_t lastUse;
+  uint8_t size;
+  uint8_t bits[ICON_ATLAS_MAX_BYTES];
+};
+
+static IconAtlasSlot* sAtlas = nullptr;
+static uint32_t sAtlasClock = 0;
+
+// Source pixel from the registry bitmap (LSB-first)
+static inline bool iconSrcBit(const uint8_t* src, uint8_t w, uint8_t h, int x, int y) {
+  if (x < 0 || x >= w || y < 0 || y >= h) return false;
+  return (pgm_read_byte(&src[y * ((w + 7) / 8) + x / 8]) >> (x % 8)) & 1;
+}
+
+static void rasterizeIcon(const EmbeddedIcon* icon, uint8_t size, uint8_t* out) {
+  const uint8_t* src = (const uint8_t*)pgm_read_ptr(&icon->bitmapData);
+  uint8_t w = pgm_read_byte(&icon->width);
+  uint8_t h = pgm_read_byte(&icon->height);
+  int outW = size, outH = size;
+  int rowBytes = (outW + 7) / 8;
+  memset(out, 0, (size_t)rowBytes * outH);
+
+  if (size == w && size == h) {
+    // Native size: only the bit order changes
+    for (int y = 0; y < outH; y++)
+      for (int x = 0; x < outW; x++)
+        if (iconSrcBit(src, w, h, x, y)) out[y * rowBytes + x / 8] |= 0x80 >> (x % 8);
+    return;
+  }
+
+  if (size * 2 == w && size * 2 == h) {
+    // Half size: OR each 2x2 block so thin strokes survive
+    for (int y = 0; y < outH; y++)
+      for (int x = 0; x < outW; x++)
+        if (iconSrcBit(src, w, h, x * 2, y * 2) || iconSrcBit(src, w, h, x * 2 + 1, y * 2) ||
+            iconSrcBit(src, w, h, x * 2, y * 2 + 1) || iconSrcBit(src, w, h, x * 2 + 1, y * 2 + 1))
+          out[y * rowBytes + x / 8] |= 0x80 >> (x % 8);
+    return;
+  }
+
+  // Nearest neighbour with the same float math drawIconScaled() used
+  float scale = (float)size / (float)w;
+  float invScale = 1.0f / scale;
+  for (int y = 0; y < outH; y++)
+    for (int x = 0; x < outW; x++)
+      if (iconSrcBit(src, w, h, (int)(x * invScale), (int)(y * invScale)))
+        out[y * rowBytes + x / 8] |= 0x80 >> (x % 8);
+}
+
+const uint8_t* embeddedIconRaster(const EmbeddedIcon* icon, uint8_t size) {
+  if (!icon || size == 0 || size > ICON_ATLAS_MAX_SIZE) return nullptr;
+
+  if (!sAtlas) {
+    sAtlas = (IconAtlasSlot*)ps_alloc(sizeof(IconAtlasSlot) * ICON_ATLAS_SLOTS, AllocPref::PreferPSRAM, "icon.atlas");
+    if (!sAtlas) return nullptr;
+    memset(sAtlas, 0, sizeof(IconAtlasSlot) * ICON_ATLAS_SLOTS);
+  }
+
+  sAtlasClock++;
+  IconAtlasSlot* victim = &sAtlas[0];
+  for (int i = 0; i < ICON_ATLAS_SLOTS; i++) {
+    IconAtlasSlot& s = sAtlas[i];
+    if (s.icon == icon && s.size == size) {
+      s.lastUse = sAtlasClock;
+      return s.bits;
+    }
+    if (!s.icon) victim = &s;
+    else if (victim->icon && s.lastUse < victim->lastUse) victim = &s;
+  }
+
+  rasterizeIcon(icon, size, victim->bits);
+  victim->icon = icon;
+  victim->size = size;
+  victim->lastUse = sAtlasClock;
+  return victim->bits;
+}
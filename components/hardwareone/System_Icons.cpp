@@ -3,6 +3,7 @@
 // Auto-generated icon arrays
 // DO NOT EDIT - regenerate with icons/scripts/generate_icons.py
 
+#if EMBEDDED_ICONS_PNG
 // smiley PNG data (1170 bytes)
 static const uint8_t PROGMEM icon_smiley_png[] = {
   0x89, 0x50, 0x4E, 0x47, 0x0D, 0x0A, 0x1A, 0x0A, 0x00, 0x00, 0x00, 0x0D, 0x49, 0x48, 0x44, 0x52,
@@ -80,6 +81,7 @@ static const uint8_t PROGMEM icon_smiley_png[] = {
   0x7F, 0x19, 0x8B, 0xBA, 0x5D, 0x7C, 0x00, 0x00, 0x00, 0x00, 0x49, 0x45, 0x4E, 0x44, 0xAE, 0x42,
   0x60, 0x82,
 };
+#endif
 
 // smiley monochrome bitmap (32x32 = 128 bytes)
 static const uint8_t PROGMEM icon_smiley_bitmap[] = {
@@ -101,6 +103,7 @@ static const uint8_t PROGMEM icon_smiley_bitmap[] = {
   0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
 };
 
+#if EMBEDDED_ICONS_PNG
 // frowny PNG data (1149 bytes)
 static const uint8_t PROGMEM icon_frowny_png[] = {
   0x89, 0x50, 0x4E, 0x47, 0x0D, 0x0A, 0x1A, 0x0A, 0x00, 0x00, 0x00, 0x0D, 0x49, 0x48, 0x44, 0x52,
@@ -176,6 +179,7 @@ static const uint8_t PROGMEM icon_frowny_png[] = {
   0x2A, 0xFC, 0xF6, 0x76, 0x2D, 0xC2, 0x2F, 0xD3, 0x7F, 0x79, 0x96, 0x99, 0x91, 0x20, 0xD5, 0x4F,
   0x47, 0x00, 0x00, 0x00, 0x00, 0x49, 0x45, 0x4E, 0x44, 0xAE, 0x42, 0x60, 0x82,
 };
+#endif
 
 // frowny monochrome bitmap (32x32 = 128 bytes)
 static const uint8_t PROGMEM icon_frowny_bitmap[] = {
@@ -197,6 +201,7 @@ static const uint8_t PROGMEM icon_frowny_bitmap[] = {
   0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
 };
 
+#if EMBEDDED_ICONS_PNG
 // folder PNG data (491 bytes)
 static const uint8_t PROGMEM icon_folder_png[] = {
   0x89, 0x50, 0x4E, 0x47, 0x0D, 0x0A, 0x1A, 0x0A, 0x00, 0x00, 0x00, 0x0D, 0x49, 0x48, 0x44, 0x52,
@@ -231,6 +236,7 @@ static const uint8_t PROGMEM icon_folder_png[] = {
   0x93, 0x7F, 0xFF, 0xFC, 0xFE, 0x84, 0x4F, 0xEE, 0x50, 0x16, 0xEB, 0x93, 0x3C, 0xD7, 0x14, 0x00,
   0x00, 0x00, 0x00, 0x49, 0x45, 0x4E, 0x44, 0xAE, 0x42, 0x60, 0x82,
 };
+#endif
 
 // folder monochrome bitmap (32x32 = 128 bytes)
 static const uint8_t PROGMEM icon_folder_bitmap[] = {
@@ -252,6 +258,7 @@ static const uint8_t PROGMEM icon_folder_bitmap[] = {
   0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
 };
 
+#if EMBEDDED_ICONS_PNG
 // file PNG data (502 bytes)
 static const uint8_t PROGMEM icon_file_png[] = {
   0x89, 0x50, 0x4E, 0x47, 0x0D, 0x0A, 0x1A, 0x0A, 0x00, 0x00, 0x00, 0x0D, 0x49, 0x48, 0x44, 0x52,
@@ -287,6 +294,7 @@ static const uint8_t PROGMEM icon_file_png[] = {
   0xDA, 0x0F, 0x20, 0x83, 0x6C, 0xB5, 0xC5, 0x64, 0x34, 0x11, 0x00, 0x00, 0x00, 0x00, 0x49, 0x45,
   0x4E, 0x44, 0xAE, 0x42, 0x60, 0x82,
 };
+#endif
 
 // file monochrome bitmap (32x32 = 128 bytes)
 static const uint8_t PROGMEM icon_file_bitmap[] = {
@@ -308,6 +316,7 @@ static const uint8_t PROGMEM icon_file_bitmap[] = {
   0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
 };
 
+#if EMBEDDED_ICONS_PNG
 // file_text PNG data (553 bytes)
 static const uint8_t PROGMEM icon_file_text_png[] = {
   0x89, 0x50, 0x4E, 0x47, 0x0D, 0x0A, 0x1A, 0x0A, 0x00, 0x00, 0x00, 0x0D, 0x49, 0x48, 0x44, 0x52,
@@ -346,6 +355,7 @@ static const uint8_t PROGMEM icon_file_text_png[] = {
   0xE8, 0xDA, 0x87, 0xED, 0x27, 0x55, 0x6D, 0xA4, 0x2B, 0xB5, 0x4E, 0x0E, 0xF8, 0x00, 0x00, 0x00,
   0x00, 0x49, 0x45, 0x4E, 0x44, 0xAE, 0x42, 0x60, 0x82,
 };
+#endif
 
 // file_text monochrome bitmap (32x32 = 128 bytes)
 static const uint8_t PROGMEM icon_file_text_bitmap[] = {
@@ -367,6 +377,7 @@ static const uint8_t PROGMEM icon_file_text_bitmap[] = {
   0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
 };
 
+#if EMBEDDED_ICONS_PNG
 // file_code PNG data (955 bytes)
 static const uint8_t PROGMEM icon_file_code_png[] = {
   0x89, 0x50, 0x4E, 0x47, 0x0D, 0x0A, 0x1A, 0x0A, 0x00, 0x00, 0x00, 0x0D, 0x49, 0x48, 0x44, 0x52,
@@ -430,6 +441,7 @@ static const uint8_t PROGMEM icon_file_code_png[] = {
   0xD7, 0x2B, 0xC0, 0xCA, 0x2F, 0xC7, 0x1F, 0xE2, 0xAE, 0x8D, 0x9D, 0x83, 0xFD, 0x28, 0xA5, 0x00,
   0x00, 0x00, 0x00, 0x49, 0x45, 0x4E, 0x44, 0xAE, 0x42, 0x60, 0x82,
 };
+#endif
 
 // file_code monochrome bitmap (32x32 = 128 bytes)
 static const uint8_t PROGMEM icon_file_code_bitmap[] = {
@@ -451,6 +463,7 @@ static const uint8_t PROGMEM icon_file_code_bitmap[] = {
   0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
 };
 
+#if EMBEDDED_ICONS_PNG
 // file_image PNG data (863 bytes)
 static const uint8_t PROGMEM icon_file_image_png[] = {
   0x89, 0x50, 0x4E, 0x47, 0x0D, 0x0A, 0x1A, 0x0A, 0x00, 0x00, 0x00, 0x0D, 0x49, 0x48, 0x44, 0x52,
@@ -508,6 +521,7 @@ static const uint8_t PROGMEM icon_file_image_png[] = {
   0xB1, 0xD6, 0xAD, 0xF0, 0xE3, 0x11, 0x50, 0xE3, 0x87, 0xF1, 0x1B, 0xD8, 0x67, 0x08, 0x2C, 0x05,
   0xA9, 0xE6, 0x42, 0x00, 0x00, 0x00, 0x00, 0x49, 0x45, 0x4E, 0x44, 0xAE, 0x42, 0x60, 0x82,
 };
+#endif
 
 // file_image monochrome bitmap (32x32 = 128 bytes)
 static const uint8_t PROGMEM icon_file_image_bitmap[] = {
@@ -529,6 +543,7 @@ static const uint8_t PROGMEM icon_file_image_bitmap[] = {
   0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
 };
 
+#if EMBEDDED_ICONS_PNG
 // file_zip PNG data (765 bytes)
 static const uint8_t PROGMEM icon_file_zip_png[] = {
   0x89, 0x50, 0x4E, 0x47, 0x0D, 0x0A, 0x1A, 0x0A, 0x00, 0x00, 0x00, 0x0D, 0x49, 0x48, 0x44, 0x52,
@@ -580,6 +595,7 @@ static const uint8_t PROGMEM icon_file_zip_png[] = {
   0x9C, 0x7F, 0x1C, 0x01, 0xB1, 0x7E, 0x58, 0x7E, 0x01, 0xB0, 0xF7, 0xFB, 0xEA, 0xD8, 0x95, 0x96,
   0xDA, 0x00, 0x00, 0x00, 0x00, 0x49, 0x45, 0x4E, 0x44, 0xAE, 0x42, 0x60, 0x82,
 };
+#endif
 
 // file_zip monochrome bitmap (32x32 = 128 bytes)
 static const uint8_t PROGMEM icon_file_zip_bitmap[] = {
@@ -601,6 +617,7 @@ static const uint8_t PROGMEM icon_file_zip_bitmap[] = {
   0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
 };
 
+#if EMBEDDED_ICONS_PNG
 // file_json PNG data (873 bytes)
 static const uint8_t PROGMEM icon_file_json_png[] = {
   0x89, 0x50, 0x4E, 0x47, 0x0D, 0x0A, 0x1A, 0x0A, 0x00, 0x00, 0x00, 0x0D, 0x49, 0x48, 0x44, 0x52,
@@ -659,6 +676,7 @@ static const uint8_t PROGMEM icon_file_json_png[] = {
   0x58, 0xFA, 0xE1, 0xF8, 0x0D, 0x27, 0xFC, 0x40, 0x5C, 0x6A, 0x78, 0x38, 0x90, 0x00, 0x00, 0x00,
   0x00, 0x49, 0x45, 0x4E, 0x44, 0xAE, 0x42, 0x60, 0x82,
 };
+#endif
 
 // file_json monochrome bitmap (32x32 = 128 bytes)
 static const uint8_t PROGMEM icon_file_json_bitmap[] = {
@@ -680,6 +698,7 @@ static const uint8_t PROGMEM icon_file_json_bitmap[] = {
   0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
 };
 
+#if EMBEDDED_ICONS_PNG
 // file_pdf PNG data (698 bytes)
 static const uint8_t PROGMEM icon_file_pdf_png[] = {
   0x89, 0x50, 0x4E, 0x47, 0x0D, 0x0A, 0x1A, 0x0A, 0x00, 0x00, 0x00, 0x0D, 0x49, 0x48, 0x44, 0x52,
@@ -727,6 +746,7 @@ static const uint8_t PROGMEM icon_file_pdf_png[] = {
   0x2B, 0xA0, 0xE4, 0x87, 0xE3, 0x0F, 0x88, 0x94, 0xB8, 0xD4, 0x12, 0x8E, 0x2F, 0x45, 0x00, 0x00,
   0x00, 0x00, 0x49, 0x45, 0x4E, 0x44, 0xAE, 0x42, 0x60, 0x82,
 };
+#endif
 
 // file_pdf monochrome bitmap (32x32 = 128 bytes)
 static const uint8_t PROGMEM icon_file_pdf_bitmap[] = {
@@ -748,6 +768,7 @@ static const uint8_t PROGMEM icon_file_pdf_bitmap[] = {
   0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
 };
 
+#if EMBEDDED_ICONS_PNG
 // file_bin PNG data (879 bytes)
 static const uint8_t PROGMEM icon_file_bin_png[] = {
   0x89, 0x50, 0x4E, 0x47, 0x0D, 0x0A, 0x1A, 0x0A, 0x00, 0x00, 0x00, 0x0D, 0x49, 0x48, 0x44, 0x52,
@@ -806,6 +827,7 @@ static const uint8_t PROGMEM icon_file_bin_png[] = {
   0xC9, 0xDE, 0x0A, 0xBF, 0x5E, 0x01, 0x46, 0xBF, 0x1C, 0x7F, 0x00, 0xB6, 0xB6, 0x73, 0x52, 0x68,
   0x83, 0x2F, 0x49, 0x00, 0x00, 0x00, 0x00, 0x49, 0x45, 0x4E, 0x44, 0xAE, 0x42, 0x60, 0x82,
 };
+#endif
 
 // file_bin monochrome bitmap (32x32 = 128 bytes)
 static const uint8_t PROGMEM icon_file_bin_bitmap[] = {
@@ -827,6 +849,7 @@ static const uint8_t PROGMEM icon_file_bin_bitmap[] = {
   0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
 };
 
+#if EMBEDDED_ICONS_PNG
 // sdcard PNG data (1004 bytes)
 static const uint8_t PROGMEM icon_sdcard_png[] = {
   0x89, 0x50, 0x4E, 0x47, 0x0D, 0x0A, 0x1A, 0x0A, 0x00, 0x00, 0x00, 0x0D, 0x49, 0x48, 0x44, 0x52,
@@ -893,6 +916,7 @@ static const uint8_t PROGMEM icon_sdcard_png[] = {
   0xBF, 0xBF, 0x8E, 0xFF, 0x7F, 0x80, 0x7F, 0x00, 0x7C, 0xE8, 0x21, 0xB5, 0xF6, 0xD5, 0xE5, 0xF5,
   0x00, 0x00, 0x00, 0x00, 0x49, 0x45, 0x4E, 0x44, 0xAE, 0x42, 0x60, 0x82,
 };
+#endif
 
 // sdcard monochrome bitmap (32x32 = 128 bytes)
 static const uint8_t PROGMEM icon_sdcard_bitmap[] = {
@@ -914,6 +938,7 @@ static const uint8_t PROGMEM icon_sdcard_bitmap[] = {
   0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
 };
 
+#if EMBEDDED_ICONS_PNG
 // trash PNG data (702 bytes)
 static const uint8_t PROGMEM icon_trash_png[] = {
   0x89, 0x50, 0x4E, 0x47, 0x0D, 0x0A, 0x1A, 0x0A, 0x00, 0x00, 0x00, 0x0D, 0x49, 0x48, 0x44, 0x52,
@@ -961,6 +986,7 @@ static const uint8_t PROGMEM icon_trash_png[] = {
   0xB7, 0xFC, 0xB1, 0xF7, 0xAE, 0x60, 0xEF, 0x93, 0xFC, 0x01, 0x3C, 0xC7, 0x5E, 0xE0, 0xB1, 0x7E,
   0x07, 0xD2, 0x00, 0x00, 0x00, 0x00, 0x49, 0x45, 0x4E, 0x44, 0xAE, 0x42, 0x60, 0x82,
 };
+#endif
 
 // trash monochrome bitmap (32x32 = 128 bytes)
 static const uint8_t PROGMEM icon_trash_bitmap[] = {
@@ -982,6 +1008,7 @@ static const uint8_t PROGMEM icon_trash_bitmap[] = {
   0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
 };
 
+#if EMBEDDED_ICONS_PNG
 // save PNG data (801 bytes)
 static const uint8_t PROGMEM icon_save_png[] = {
   0x89, 0x50, 0x4E, 0x47, 0x0D, 0x0A, 0x1A, 0x0A, 0x00, 0x00, 0x00, 0x0D, 0x49, 0x48, 0x44, 0x52,
@@ -1036,6 +1063,7 @@ static const uint8_t PROGMEM icon_save_png[] = {
   0x84, 0xE0, 0xA7, 0x81, 0x3D, 0x00, 0x00, 0x00, 0x00, 0x49, 0x45, 0x4E, 0x44, 0xAE, 0x42, 0x60,
   0x82,
 };
+#endif
 
 // save monochrome bitmap (32x32 = 128 bytes)
 static const uint8_t PROGMEM icon_save_bitmap[] = {
@@ -1057,6 +1085,7 @@ static const uint8_t PROGMEM icon_save_bitmap[] = {
   0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
 };
 
+#if EMBEDDED_ICONS_PNG
 // edit PNG data (448 bytes)
 static const uint8_t PROGMEM icon_edit_png[] = {
   0x89, 0x50, 0x4E, 0x47, 0x0D, 0x0A, 0x1A, 0x0A, 0x00, 0x00, 0x00, 0x0D, 0x49, 0x48, 0x44, 0x52,
@@ -1088,6 +1117,7 @@ static const uint8_t PROGMEM icon_edit_png[] = {
   0x8C, 0x9E, 0x58, 0x6B, 0xDD, 0x77, 0x6A, 0xAA, 0xE0, 0x4B, 0xF5, 0x03, 0x64, 0x98, 0x1E, 0x29,
   0x8A, 0x7E, 0x41, 0x3F, 0x00, 0x00, 0x00, 0x00, 0x49, 0x45, 0x4E, 0x44, 0xAE, 0x42, 0x60, 0x82,
 };
+#endif
 
 // edit monochrome bitmap (32x32 = 128 bytes)
 static const uint8_t PROGMEM icon_edit_bitmap[] = {
@@ -1109,6 +1139,7 @@ static const uint8_t PROGMEM icon_edit_bitmap[] = {
   0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
 };
 
+#if EMBEDDED_ICONS_PNG
 // wifi_0 PNG data (326 bytes)
 static const uint8_t PROGMEM icon_wifi_0_png[] = {
   0x89, 0x50, 0x4E, 0x47, 0x0D, 0x0A, 0x1A, 0x0A, 0x00, 0x00, 0x00, 0x0D, 0x49, 0x48, 0x44, 0x52,
@@ -1133,6 +1164,7 @@ static const uint8_t PROGMEM icon_wifi_0_png[] = {
   0xEB, 0x0F, 0x57, 0x5C, 0xA8, 0xCF, 0x4F, 0x5C, 0x04, 0x2E, 0x00, 0x00, 0x00, 0x00, 0x49, 0x45,
   0x4E, 0x44, 0xAE, 0x42, 0x60, 0x82,
 };
+#endif
 
 // wifi_0 monochrome bitmap (32x32 = 128 bytes)
 static const uint8_t PROGMEM icon_wifi_0_bitmap[] = {
@@ -1154,6 +1186,7 @@ static const uint8_t PROGMEM icon_wifi_0_bitmap[] = {
   0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
 };
 
+#if EMBEDDED_ICONS_PNG
 // wifi_1 PNG data (499 bytes)
 static const uint8_t PROGMEM icon_wifi_1_png[] = {
   0x89, 0x50, 0x4E, 0x47, 0x0D, 0x0A, 0x1A, 0x0A, 0x00, 0x00, 0x00, 0x0D, 0x49, 0x48, 0x44, 0x52,
@@ -1189,6 +1222,7 @@ static const uint8_t PROGMEM icon_wifi_1_png[] = {
   0xB2, 0x0B, 0xE9, 0xA5, 0x8D, 0x2A, 0x58, 0x00, 0x00, 0x00, 0x00, 0x49, 0x45, 0x4E, 0x44, 0xAE,
   0x42, 0x60, 0x82,
 };
+#endif
 
 // wifi_1 monochrome bitmap (32x32 = 128 bytes)
 static const uint8_t PROGMEM icon_wifi_1_bitmap[] = {
@@ -1210,6 +1244,7 @@ static const uint8_t PROGMEM icon_wifi_1_bitmap[] = {
   0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
 };
 
+#if EMBEDDED_ICONS_PNG
 // wifi_2 PNG data (719 bytes)
 static const uint8_t PROGMEM icon_wifi_2_png[] = {
   0x89, 0x50, 0x4E, 0x47, 0x0D, 0x0A, 0x1A, 0x0A, 0x00, 0x00, 0x00, 0x0D, 0x49, 0x48, 0x44, 0x52,
@@ -1258,6 +1293,7 @@ static const uint8_t PROGMEM icon_wifi_2_png[] = {
   0x44, 0x86, 0x61, 0x54, 0x5C, 0xC5, 0xFE, 0xF9, 0xBF, 0xEB, 0x5F, 0xB6, 0xE4, 0x9D, 0xC6, 0x7D,
   0x99, 0x29, 0x05, 0x00, 0x00, 0x00, 0x00, 0x49, 0x45, 0x4E, 0x44, 0xAE, 0x42, 0x60, 0x82,
 };
+#endif
 
 // wifi_2 monochrome bitmap (32x32 = 128 bytes)
 static const uint8_t PROGMEM icon_wifi_2_bitmap[] = {
@@ -1279,6 +1315,7 @@ static const uint8_t PROGMEM icon_wifi_2_bitmap[] = {
   0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
 };
 
+#if EMBEDDED_ICONS_PNG
 // wifi_3 PNG data (977 bytes)
 static const uint8_t PROGMEM icon_wifi_3_png[] = {
   0x89, 0x50, 0x4E, 0x47, 0x0D, 0x0A, 0x1A, 0x0A, 0x00, 0x00, 0x00, 0x0D, 0x49, 0x48, 0x44, 0x52,
@@ -1344,6 +1381,7 @@ static const uint8_t PROGMEM icon_wifi_3_png[] = {
   0xF4, 0x4F, 0x07, 0x75, 0x74, 0x00, 0x00, 0x00, 0x00, 0x49, 0x45, 0x4E, 0x44, 0xAE, 0x42, 0x60,
   0x82,
 };
+#endif
 
 // wifi_3 monochrome bitmap (32x32 = 128 bytes)
 static const uint8_t PROGMEM icon_wifi_3_bitmap[] = {
@@ -1365,6 +1403,7 @@ static const uint8_t PROGMEM icon_wifi_3_bitmap[] = {
   0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
 };
 
+#if EMBEDDED_ICONS_PNG
 // wifi_off PNG data (863 bytes)
 static const uint8_t PROGMEM icon_wifi_off_png[] = {
   0x89, 0x50, 0x4E, 0x47, 0x0D, 0x0A, 0x1A, 0x0A, 0x00, 0x00, 0x00, 0x0D, 0x49, 0x48, 0x44, 0x52,
@@ -1422,6 +1461,7 @@ static const uint8_t PROGMEM icon_wifi_off_png[] = {
   0x89, 0xE2, 0x96, 0x9D, 0x1B, 0xC1, 0x7F, 0x3A, 0x5D, 0xFF, 0x02, 0x64, 0x55, 0xFE, 0x28, 0x4A,
   0x64, 0x36, 0x02, 0x00, 0x00, 0x00, 0x00, 0x49, 0x45, 0x4E, 0x44, 0xAE, 0x42, 0x60, 0x82,
 };
+#endif
 
 // wifi_off monochrome bitmap (32x32 = 128 bytes)
 static const uint8_t PROGMEM icon_wifi_off_bitmap[] = {
@@ -1443,6 +1483,7 @@ static const uint8_t PROGMEM icon_wifi_off_bitmap[] = {
   0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
 };
 
+#if EMBEDDED_ICONS_PNG
 // bt_off PNG data (829 bytes)
 static const uint8_t PROGMEM icon_bt_off_png[] = {
   0x89, 0x50, 0x4E, 0x47, 0x0D, 0x0A, 0x1A, 0x0A, 0x00, 0x00, 0x00, 0x0D, 0x49, 0x48, 0x44, 0x52,
@@ -1498,6 +1539,7 @@ static const uint8_t PROGMEM icon_bt_off_png[] = {
   0xE5, 0x7F, 0xB1, 0x3A, 0x4E, 0x7C, 0xBB, 0xFE, 0x05, 0x86, 0x76, 0x0E, 0x9D, 0xB2, 0x0E, 0x4D,
   0x67, 0x00, 0x00, 0x00, 0x00, 0x49, 0x45, 0x4E, 0x44, 0xAE, 0x42, 0x60, 0x82,
 };
+#endif
 
 // bt_off monochrome bitmap (32x32 = 128 bytes)
 static const uint8_t PROGMEM icon_bt_off_bitmap[] = {
@@ -1519,6 +1561,7 @@ static const uint8_t PROGMEM icon_bt_off_bitmap[] = {
   0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
 };
 
+#if EMBEDDED_ICONS_PNG
 // bt_idle PNG data (618 bytes)
 static const uint8_t PROGMEM icon_bt_idle_png[] = {
   0x89, 0x50, 0x4E, 0x47, 0x0D, 0x0A, 0x1A, 0x0A, 0x00, 0x00, 0x00, 0x0D, 0x49, 0x48, 0x44, 0x52,
@@ -1561,6 +1604,7 @@ static const uint8_t PROGMEM icon_bt_idle_png[] = {
   0x50, 0xF0, 0xF5, 0xD7, 0xF5, 0x0F, 0x23, 0x0D, 0x3E, 0x85, 0x19, 0xF3, 0xA2, 0x4E, 0x00, 0x00,
   0x00, 0x00, 0x49, 0x45, 0x4E, 0x44, 0xAE, 0x42, 0x60, 0x82,
 };
+#endif
 
 // bt_idle monochrome bitmap (32x32 = 128 bytes)
 static const uint8_t PROGMEM icon_bt_idle_bitmap[] = {
@@ -1582,6 +1626,7 @@ static const uint8_t PROGMEM icon_bt_idle_bitmap[] = {
   0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
 };
 
+#if EMBEDDED_ICONS_PNG
 // bt_advertising PNG data (903 bytes)
 static const uint8_t PROGMEM icon_bt_advertising_png[] = {
   0x89, 0x50, 0x4E, 0x47, 0x0D, 0x0A, 0x1A, 0x0A, 0x00, 0x00, 0x00, 0x0D, 0x49, 0x48, 0x44, 0x52,
@@ -1642,6 +1687,7 @@ static const uint8_t PROGMEM icon_bt_advertising_png[] = {
   0xD7, 0xBF, 0x00, 0xDD, 0xE0, 0x39, 0xC7, 0x22, 0x3D, 0x0A, 0xAE, 0x00, 0x00, 0x00, 0x00, 0x49,
   0x45, 0x4E, 0x44, 0xAE, 0x42, 0x60, 0x82,
 };
+#endif
 
 // bt_advertising monochrome bitmap (32x32 = 128 bytes)
 static const uint8_t PROGMEM icon_bt_advertising_bitmap[] = {
@@ -1663,6 +1709,7 @@ static const uint8_t PROGMEM icon_bt_advertising_bitmap[] = {
   0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
 };
 
+#if EMBEDDED_ICONS_PNG
 // bt_connected PNG data (1011 bytes)
 static const uint8_t PROGMEM icon_bt_connected_png[] = {
   0x89, 0x50, 0x4E, 0x47, 0x0D, 0x0A, 0x1A, 0x0A, 0x00, 0x00, 0x00, 0x0D, 0x49, 0x48, 0x44, 0x52,
@@ -1730,6 +1777,7 @@ static const uint8_t PROGMEM icon_bt_connected_png[] = {
   0x85, 0xE0, 0xE7, 0xB4, 0x42, 0xFF, 0xD3, 0x00, 0x00, 0x00, 0x00, 0x49, 0x45, 0x4E, 0x44, 0xAE,
   0x42, 0x60, 0x82,
 };
+#endif
 
 // bt_connected monochrome bitmap (32x32 = 128 bytes)
 static const uint8_t PROGMEM icon_bt_connected_bitmap[] = {
@@ -1751,6 +1799,7 @@ static const uint8_t PROGMEM icon_bt_connected_bitmap[] = {
   0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
 };
 
+#if EMBEDDED_ICONS_PNG
 // notify_espnow PNG data (673 bytes)
 static const uint8_t PROGMEM icon_notify_espnow_png[] = {
   0x89, 0x50, 0x4E, 0x47, 0x0D, 0x0A, 0x1A, 0x0A, 0x00, 0x00, 0x00, 0x0D, 0x49, 0x48, 0x44, 0x52,
@@ -1797,6 +1846,7 @@ static const uint8_t PROGMEM icon_notify_espnow_png[] = {
   0x7C, 0xFD, 0xE8, 0x64, 0xFC, 0x00, 0x00, 0x00, 0x00, 0x49, 0x45, 0x4E, 0x44, 0xAE, 0x42, 0x60,
   0x82,
 };
+#endif
 
 // notify_espnow monochrome bitmap (32x32 = 128 bytes)
 static const uint8_t PROGMEM icon_notify_espnow_bitmap[] = {
@@ -1818,6 +1868,7 @@ static const uint8_t PROGMEM icon_notify_espnow_bitmap[] = {
   0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
 };
 
+#if EMBEDDED_ICONS_PNG
 // notify_server PNG data (505 bytes)
 static const uint8_t PROGMEM icon_notify_server_png[] = {
   0x89, 0x50, 0x4E, 0x47, 0x0D, 0x0A, 0x1A, 0x0A, 0x00, 0x00, 0x00, 0x0D, 0x49, 0x48, 0x44, 0x52,
@@ -1853,6 +1904,7 @@ static const uint8_t PROGMEM icon_notify_server_png[] = {
   0xFD, 0xF9, 0xED, 0xFA, 0x05, 0x97, 0xD5, 0x28, 0xA3, 0x1C, 0xD9, 0x85, 0x09, 0x00, 0x00, 0x00,
   0x00, 0x49, 0x45, 0x4E, 0x44, 0xAE, 0x42, 0x60, 0x82,
 };
+#endif
 
 // notify_server monochrome bitmap (32x32 = 128 bytes)
 static const uint8_t PROGMEM icon_notify_server_bitmap[] = {
@@ -1874,6 +1926,7 @@ static const uint8_t PROGMEM icon_notify_server_bitmap[] = {
   0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
 };
 
+#if EMBEDDED_ICONS_PNG
 // radio PNG data (982 bytes)
 static const uint8_t PROGMEM icon_radio_png[] = {
   0x89, 0x50, 0x4E, 0x47, 0x0D, 0x0A, 0x1A, 0x0A, 0x00, 0x00, 0x00, 0x0D, 0x49, 0x48, 0x44, 0x52,
@@ -1939,6 +1992,7 @@ static const uint8_t PROGMEM icon_radio_png[] = {
   0xFA, 0x1F, 0x24, 0xED, 0xDB, 0x59, 0x43, 0xB8, 0x65, 0x38, 0x00, 0x00, 0x00, 0x00, 0x49, 0x45,
   0x4E, 0x44, 0xAE, 0x42, 0x60, 0x82,
 };
+#endif
 
 // radio monochrome bitmap (32x32 = 128 bytes)
 static const uint8_t PROGMEM icon_radio_bitmap[] = {
@@ -1960,6 +2014,7 @@ static const uint8_t PROGMEM icon_radio_bitmap[] = {
   0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
 };
 
+#if EMBEDDED_ICONS_PNG
 // upload PNG data (581 bytes)
 static const uint8_t PROGMEM icon_upload_png[] = {
   0x89, 0x50, 0x4E, 0x47, 0x0D, 0x0A, 0x1A, 0x0A, 0x00, 0x00, 0x00, 0x0D, 0x49, 0x48, 0x44, 0x52,
@@ -2000,6 +2055,7 @@ static const uint8_t PROGMEM icon_upload_png[] = {
   0x05, 0x6E, 0x8A, 0x3D, 0xF7, 0xE8, 0x5C, 0x2E, 0xC3, 0x00, 0x00, 0x00, 0x00, 0x49, 0x45, 0x4E,
   0x44, 0xAE, 0x42, 0x60, 0x82,
 };
+#endif
 
 // upload monochrome bitmap (32x32 = 128 bytes)
 static const uint8_t PROGMEM icon_upload_bitmap[] = {
@@ -2021,6 +2077,7 @@ static const uint8_t PROGMEM icon_upload_bitmap[] = {
   0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
 };
 
+#if EMBEDDED_ICONS_PNG
 // download PNG data (610 bytes)
 static const uint8_t PROGMEM icon_download_png[] = {
   0x89, 0x50, 0x4E, 0x47, 0x0D, 0x0A, 0x1A, 0x0A, 0x00, 0x00, 0x00, 0x0D, 0x49, 0x48, 0x44, 0x52,
@@ -2063,6 +2120,7 @@ static const uint8_t PROGMEM icon_download_png[] = {
   0x1A, 0xF6, 0xDC, 0x60, 0xB9, 0x43, 0x00, 0x00, 0x00, 0x00, 0x49, 0x45, 0x4E, 0x44, 0xAE, 0x42,
   0x60, 0x82,
 };
+#endif
 
 // download monochrome bitmap (32x32 = 128 bytes)
 static const uint8_t PROGMEM icon_download_bitmap[] = {
@@ -2084,6 +2142,7 @@ static const uint8_t PROGMEM icon_download_bitmap[] = {
   0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
 };
 
+#if EMBEDDED_ICONS_PNG
 // refresh PNG data (868 bytes)
 static const uint8_t PROGMEM icon_refresh_png[] = {
   0x89, 0x50, 0x4E, 0x47, 0x0D, 0x0A, 0x1A, 0x0A, 0x00, 0x00, 0x00, 0x0D, 0x49, 0x48, 0x44, 0x52,
@@ -2142,6 +2201,7 @@ static const uint8_t PROGMEM icon_refresh_png[] = {
   0xA7, 0x49, 0x9E, 0x66, 0x97, 0x62, 0x09, 0xDD, 0x00, 0x00, 0x00, 0x00, 0x49, 0x45, 0x4E, 0x44,
   0xAE, 0x42, 0x60, 0x82,
 };
+#endif
 
 // refresh monochrome bitmap (32x32 = 128 bytes)
 static const uint8_t PROGMEM icon_refresh_bitmap[] = {
@@ -2163,6 +2223,7 @@ static const uint8_t PROGMEM icon_refresh_bitmap[] = {
   0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
 };
 
+#if EMBEDDED_ICONS_PNG
 // battery_0 PNG data (519 bytes)
 static const uint8_t PROGMEM icon_battery_0_png[] = {
   0x89, 0x50, 0x4E, 0x47, 0x0D, 0x0A, 0x1A, 0x0A, 0x00, 0x00, 0x00, 0x0D, 0x49, 0x48, 0x44, 0x52,
@@ -2199,6 +2260,7 @@ static const uint8_t PROGMEM icon_battery_0_png[] = {
   0x7F, 0x82, 0x1F, 0xFA, 0xDA, 0x5F, 0xC4, 0x89, 0x10, 0x74, 0xE7, 0x00, 0x00, 0x00, 0x00, 0x49,
   0x45, 0x4E, 0x44, 0xAE, 0x42, 0x60, 0x82,
 };
+#endif
 
 // battery_0 monochrome bitmap (32x32 = 128 bytes)
 static const uint8_t PROGMEM icon_battery_0_bitmap[] = {
@@ -2220,6 +2282,7 @@ static const uint8_t PROGMEM icon_battery_0_bitmap[] = {
   0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
 };
 
+#if EMBEDDED_ICONS_PNG
 // battery_25 PNG data (547 bytes)
 static const uint8_t PROGMEM icon_battery_25_png[] = {
   0x89, 0x50, 0x4E, 0x47, 0x0D, 0x0A, 0x1A, 0x0A, 0x00, 0x00, 0x00, 0x0D, 0x49, 0x48, 0x44, 0x52,
@@ -2258,6 +2321,7 @@ static const uint8_t PROGMEM icon_battery_25_png[] = {
   0xB7, 0x70, 0x11, 0x7F, 0xD2, 0x4B, 0x2C, 0x00, 0x00, 0x00, 0x00, 0x49, 0x45, 0x4E, 0x44, 0xAE,
   0x42, 0x60, 0x82,
 };
+#endif
 
 // battery_25 monochrome bitmap (32x32 = 128 bytes)
 static const uint8_t PROGMEM icon_battery_25_bitmap[] = {
@@ -2279,6 +2343,7 @@ static const uint8_t PROGMEM icon_battery_25_bitmap[] = {
   0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
 };
 
+#if EMBEDDED_ICONS_PNG
 // battery_50 PNG data (542 bytes)
 static const uint8_t PROGMEM icon_battery_50_png[] = {
   0x89, 0x50, 0x4E, 0x47, 0x0D, 0x0A, 0x1A, 0x0A, 0x00, 0x00, 0x00, 0x0D, 0x49, 0x48, 0x44, 0x52,
@@ -2316,6 +2381,7 @@ static const uint8_t PROGMEM icon_battery_50_png[] = {
   0xE9, 0xFB, 0xC7, 0xEB, 0x4D, 0xF0, 0xFF, 0x13, 0x7C, 0x00, 0xF9, 0x3C, 0x6C, 0xF1, 0xCD, 0x6B,
   0x42, 0x7F, 0x00, 0x00, 0x00, 0x00, 0x49, 0x45, 0x4E, 0x44, 0xAE, 0x42, 0x60, 0x82,
 };
+#endif
 
 // battery_50 monochrome bitmap (32x32 = 128 bytes)
 static const uint8_t PROGMEM icon_battery_50_bitmap[] = {
@@ -2337,6 +2403,7 @@ static const uint8_t PROGMEM icon_battery_50_bitmap[] = {
   0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
 };
 
+#if EMBEDDED_ICONS_PNG
 // battery_75 PNG data (526 bytes)
 static const uint8_t PROGMEM icon_battery_75_png[] = {
   0x89, 0x50, 0x4E, 0x47, 0x0D, 0x0A, 0x1A, 0x0A, 0x00, 0x00, 0x00, 0x0D, 0x49, 0x48, 0x44, 0x52,
@@ -2373,6 +2440,7 @@ static const uint8_t PROGMEM icon_battery_75_png[] = {
   0x73, 0xE8, 0xEB, 0xE1, 0xF5, 0x02, 0xFC, 0x7D, 0xC0, 0x1B, 0xEB, 0xC5, 0x56, 0x7B, 0xA8, 0x96,
   0xF4, 0xD8, 0x00, 0x00, 0x00, 0x00, 0x49, 0x45, 0x4E, 0x44, 0xAE, 0x42, 0x60, 0x82,
 };
+#endif
 
 // battery_75 monochrome bitmap (32x32 = 128 bytes)
 static const uint8_t PROGMEM icon_battery_75_bitmap[] = {
@@ -2394,6 +2462,7 @@ static const uint8_t PROGMEM icon_battery_75_bitmap[] = {
   0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
 };
 
+#if EMBEDDED_ICONS_PNG
 // battery_100 PNG data (435 bytes)
 static const uint8_t PROGMEM icon_battery_100_png[] = {
   0x89, 0x50, 0x4E, 0x47, 0x0D, 0x0A, 0x1A, 0x0A, 0x00, 0x00, 0x00, 0x0D, 0x49, 0x48, 0x44, 0x52,
@@ -2425,6 +2494,7 @@ static const uint8_t PROGMEM icon_battery_100_png[] = {
   0x57, 0xF5, 0x5E, 0xE0, 0xD0, 0xA4, 0x39, 0x00, 0x00, 0x00, 0x00, 0x49, 0x45, 0x4E, 0x44, 0xAE,
   0x42, 0x60, 0x82,
 };
+#endif
 
 // battery_100 monochrome bitmap (32x32 = 128 bytes)
 static const uint8_t PROGMEM icon_battery_100_bitmap[] = {
@@ -2446,6 +2516,7 @@ static const uint8_t PROGMEM icon_battery_100_bitmap[] = {
   0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
 };
 
+#if EMBEDDED_ICONS_PNG
 // battery_charging PNG data (846 bytes)
 static const uint8_t PROGMEM icon_battery_charging_png[] = {
   0x89, 0x50, 0x4E, 0x47, 0x0D, 0x0A, 0x1A, 0x0A, 0x00, 0x00, 0x00, 0x0D, 0x49, 0x48, 0x44, 0x52,
@@ -2502,6 +2573,7 @@ static const uint8_t PROGMEM icon_battery_charging_png[] = {
   0xBF, 0xBE, 0x93, 0x7F, 0xFE, 0x8B, 0xFE, 0x37, 0x82, 0x5F, 0x5E, 0x33, 0x7C, 0x9B, 0x85, 0x7B,
   0xE0, 0x90, 0x00, 0x00, 0x00, 0x00, 0x49, 0x45, 0x4E, 0x44, 0xAE, 0x42, 0x60, 0x82,
 };
+#endif
 
 // battery_charging monochrome bitmap (32x32 = 128 bytes)
 static const uint8_t PROGMEM icon_battery_charging_bitmap[] = {
@@ -2523,6 +2595,7 @@ static const uint8_t PROGMEM icon_battery_charging_bitmap[] = {
   0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
 };
 
+#if EMBEDDED_ICONS_PNG
 // battery_full PNG data (435 bytes)
 static const uint8_t PROGMEM icon_battery_full_png[] = {
   0x89, 0x50, 0x4E, 0x47, 0x0D, 0x0A, 0x1A, 0x0A, 0x00, 0x00, 0x00, 0x0D, 0x49, 0x48, 0x44, 0x52,
@@ -2554,6 +2627,7 @@ static const uint8_t PROGMEM icon_battery_full_png[] = {
   0x57, 0xF5, 0x5E, 0xE0, 0xD0, 0xA4, 0x39, 0x00, 0x00, 0x00, 0x00, 0x49, 0x45, 0x4E, 0x44, 0xAE,
   0x42, 0x60, 0x82,
 };
+#endif
 
 // battery_full monochrome bitmap (32x32 = 128 bytes)
 static const uint8_t PROGMEM icon_battery_full_bitmap[] = {
@@ -2575,6 +2649,7 @@ static const uint8_t PROGMEM icon_battery_full_bitmap[] = {
   0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
 };
 
+#if EMBEDDED_ICONS_PNG
 // memory PNG data (860 bytes)
 static const uint8_t PROGMEM icon_memory_png[] = {
   0x89, 0x50, 0x4E, 0x47, 0x0D, 0x0A, 0x1A, 0x0A, 0x00, 0x00, 0x00, 0x0D, 0x49, 0x48, 0x44, 0x52,
@@ -2632,6 +2707,7 @@ static const uint8_t PROGMEM icon_memory_png[] = {
   0xFF, 0xBF, 0x8E, 0xFF, 0xFE, 0x01, 0x7F, 0x00, 0xD6, 0xE3, 0xEA, 0xD2, 0x01, 0xCC, 0xEF, 0x2B,
   0x00, 0x00, 0x00, 0x00, 0x49, 0x45, 0x4E, 0x44, 0xAE, 0x42, 0x60, 0x82,
 };
+#endif
 
 // memory monochrome bitmap (32x32 = 128 bytes)
 static const uint8_t PROGMEM icon_memory_bitmap[] = {
@@ -2653,6 +2729,7 @@ static const uint8_t PROGMEM icon_memory_bitmap[] = {
   0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
 };
 
+#if EMBEDDED_ICONS_PNG
 // device PNG data (756 bytes)
 static const uint8_t PROGMEM icon_device_png[] = {
   0x89, 0x50, 0x4E, 0x47, 0x0D, 0x0A, 0x1A, 0x0A, 0x00, 0x00, 0x00, 0x0D, 0x49, 0x48, 0x44, 0x52,
@@ -2704,6 +2781,7 @@ static const uint8_t PROGMEM icon_device_png[] = {
   0x63, 0xD8, 0xF4, 0x71, 0x03, 0x2D, 0x55, 0x00, 0x00, 0x00, 0x00, 0x00, 0x49, 0x45, 0x4E, 0x44,
   0xAE, 0x42, 0x60, 0x82,
 };
+#endif
 
 // device monochrome bitmap (32x32 = 128 bytes)
 static const uint8_t PROGMEM icon_device_bitmap[] = {
@@ -2725,6 +2803,7 @@ static const uint8_t PROGMEM icon_device_bitmap[] = {
   0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
 };
 
+#if EMBEDDED_ICONS_PNG
 // terminal PNG data (795 bytes)
 static const uint8_t PROGMEM icon_terminal_png[] = {
   0x89, 0x50, 0x4E, 0x47, 0x0D, 0x0A, 0x1A, 0x0A, 0x00, 0x00, 0x00, 0x0D, 0x49, 0x48, 0x44, 0x52,
@@ -2778,6 +2857,7 @@ static const uint8_t PROGMEM icon_terminal_png[] = {
   0xE4, 0xFF, 0xF2, 0x3B, 0xC9, 0xFE, 0x02, 0x23, 0x1E, 0x08, 0xF3, 0x0F, 0x96, 0x43, 0x67, 0x00,
   0x00, 0x00, 0x00, 0x49, 0x45, 0x4E, 0x44, 0xAE, 0x42, 0x60, 0x82,
 };
+#endif
 
 // terminal monochrome bitmap (32x32 = 128 bytes)
 static const uint8_t PROGMEM icon_terminal_bitmap[] = {
@@ -2799,6 +2879,7 @@ static const uint8_t PROGMEM icon_terminal_bitmap[] = {
   0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
 };
 
+#if EMBEDDED_ICONS_PNG
 // settings PNG data (906 bytes)
 static const uint8_t PROGMEM icon_settings_png[] = {
   0x89, 0x50, 0x4E, 0x47, 0x0D, 0x0A, 0x1A, 0x0A, 0x00, 0x00, 0x00, 0x0D, 0x49, 0x48, 0x44, 0x52,
@@ -2859,6 +2940,7 @@ static const uint8_t PROGMEM icon_settings_png[] = {
   0x82, 0x5F, 0x7F, 0x5D, 0xFF, 0x01, 0x9D, 0xF9, 0xE8, 0xED, 0xD9, 0x42, 0xC8, 0x06, 0x00, 0x00,
   0x00, 0x00, 0x49, 0x45, 0x4E, 0x44, 0xAE, 0x42, 0x60, 0x82,
 };
+#endif
 
 // settings monochrome bitmap (32x32 = 128 bytes)
 static const uint8_t PROGMEM icon_settings_bitmap[] = {
@@ -2880,6 +2962,7 @@ static const uint8_t PROGMEM icon_settings_bitmap[] = {
   0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
 };
 
+#if EMBEDDED_ICONS_PNG
 // led PNG data (801 bytes)
 static const uint8_t PROGMEM icon_led_png[] = {
   0x89, 0x50, 0x4E, 0x47, 0x0D, 0x0A, 0x1A, 0x0A, 0x00, 0x00, 0x00, 0x0D, 0x49, 0x48, 0x44, 0x52,
@@ -2934,6 +3017,7 @@ static const uint8_t PROGMEM icon_led_png[] = {
   0x11, 0xE9, 0x4F, 0xB4, 0xC7, 0x00, 0x00, 0x00, 0x00, 0x49, 0x45, 0x4E, 0x44, 0xAE, 0x42, 0x60,
   0x82,
 };
+#endif
 
 // led monochrome bitmap (32x32 = 128 bytes)
 static const uint8_t PROGMEM icon_led_bitmap[] = {
@@ -2955,6 +3039,7 @@ static const uint8_t PROGMEM icon_led_bitmap[] = {
   0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
 };
 
+#if EMBEDDED_ICONS_PNG
 // sun PNG data (824 bytes)
 static const uint8_t PROGMEM icon_sun_png[] = {
   0x89, 0x50, 0x4E, 0x47, 0x0D, 0x0A, 0x1A, 0x0A, 0x00, 0x00, 0x00, 0x0D, 0x49, 0x48, 0x44, 0x52,
@@ -3010,6 +3095,7 @@ static const uint8_t PROGMEM icon_sun_png[] = {
   0xE5, 0xAF, 0xEB, 0x0F, 0xF4, 0x87, 0xF6, 0x66, 0x5D, 0x50, 0x81, 0x5A, 0x00, 0x00, 0x00, 0x00,
   0x49, 0x45, 0x4E, 0x44, 0xAE, 0x42, 0x60, 0x82,
 };
+#endif
 
 // sun monochrome bitmap (32x32 = 128 bytes)
 static const uint8_t PROGMEM icon_sun_bitmap[] = {
@@ -3031,6 +3117,7 @@ static const uint8_t PROGMEM icon_sun_bitmap[] = {
   0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
 };
 
+#if EMBEDDED_ICONS_PNG
 // moon PNG data (701 bytes)
 static const uint8_t PROGMEM icon_moon_png[] = {
   0x89, 0x50, 0x4E, 0x47, 0x0D, 0x0A, 0x1A, 0x0A, 0x00, 0x00, 0x00, 0x0D, 0x49, 0x48, 0x44, 0x52,
@@ -3078,6 +3165,7 @@ static const uint8_t PROGMEM icon_moon_png[] = {
   0xFA, 0xD4, 0x9B, 0x01, 0x7E, 0xF1, 0xDD, 0xF4, 0x0F, 0xAC, 0x63, 0xCC, 0x3A, 0xEF, 0x47, 0xA5,
   0xC8, 0x00, 0x00, 0x00, 0x00, 0x49, 0x45, 0x4E, 0x44, 0xAE, 0x42, 0x60, 0x82,
 };
+#endif
 
 // moon monochrome bitmap (32x32 = 128 bytes)
 static const uint8_t PROGMEM icon_moon_bitmap[] = {
@@ -3099,6 +3187,7 @@ static const uint8_t PROGMEM icon_moon_bitmap[] = {
   0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
 };
 
+#if EMBEDDED_ICONS_PNG
 // arrow_left PNG data (545 bytes)
 static const uint8_t PROGMEM icon_arrow_left_png[] = {
   0x89, 0x50, 0x4E, 0x47, 0x0D, 0x0A, 0x1A, 0x0A, 0x00, 0x00, 0x00, 0x0D, 0x49, 0x48, 0x44, 0x52,
@@ -3137,6 +3226,7 @@ static const uint8_t PROGMEM icon_arrow_left_png[] = {
   0x2C, 0x7E, 0x12, 0x1E, 0x1B, 0x00, 0x00, 0x00, 0x00, 0x49, 0x45, 0x4E, 0x44, 0xAE, 0x42, 0x60,
   0x82,
 };
+#endif
 
 // arrow_left monochrome bitmap (32x32 = 128 bytes)
 static const uint8_t PROGMEM icon_arrow_left_bitmap[] = {
@@ -3158,6 +3248,7 @@ static const uint8_t PROGMEM icon_arrow_left_bitmap[] = {
   0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
 };
 
+#if EMBEDDED_ICONS_PNG
 // arrow_right PNG data (490 bytes)
 static const uint8_t PROGMEM icon_arrow_right_png[] = {
   0x89, 0x50, 0x4E, 0x47, 0x0D, 0x0A, 0x1A, 0x0A, 0x00, 0x00, 0x00, 0x0D, 0x49, 0x48, 0x44, 0x52,
@@ -3192,6 +3283,7 @@ static const uint8_t PROGMEM icon_arrow_right_png[] = {
   0xF9, 0xFF, 0x9B, 0xFE, 0xA0, 0x0F, 0x7B, 0xC8, 0xB9, 0x95, 0x3C, 0xA6, 0xBE, 0x2A, 0x00, 0x00,
   0x00, 0x00, 0x49, 0x45, 0x4E, 0x44, 0xAE, 0x42, 0x60, 0x82,
 };
+#endif
 
 // arrow_right monochrome bitmap (32x32 = 128 bytes)
 static const uint8_t PROGMEM icon_arrow_right_bitmap[] = {
@@ -3213,6 +3305,7 @@ static const uint8_t PROGMEM icon_arrow_right_bitmap[] = {
   0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
 };
 
+#if EMBEDDED_ICONS_PNG
 // arrow_up PNG data (444 bytes)
 static const uint8_t PROGMEM icon_arrow_up_png[] = {
   0x89, 0x50, 0x4E, 0x47, 0x0D, 0x0A, 0x1A, 0x0A, 0x00, 0x00, 0x00, 0x0D, 0x49, 0x48, 0x44, 0x52,
@@ -3244,6 +3337,7 @@ static const uint8_t PROGMEM icon_arrow_up_png[] = {
   0x6E, 0xBF, 0xA1, 0x82, 0xDF, 0x3F, 0x07, 0x1F, 0x03, 0xBF, 0xF8, 0xDB, 0x31, 0xAB, 0x6C, 0x22,
   0x00, 0x00, 0x00, 0x00, 0x49, 0x45, 0x4E, 0x44, 0xAE, 0x42, 0x60, 0x82,
 };
+#endif
 
 // arrow_up monochrome bitmap (32x32 = 128 bytes)
 static const uint8_t PROGMEM icon_arrow_up_bitmap[] = {
@@ -3265,6 +3359,7 @@ static const uint8_t PROGMEM icon_arrow_up_bitmap[] = {
   0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
 };
 
+#if EMBEDDED_ICONS_PNG
 // arrow_down PNG data (479 bytes)
 static const uint8_t PROGMEM icon_arrow_down_png[] = {
   0x89, 0x50, 0x4E, 0x47, 0x0D, 0x0A, 0x1A, 0x0A, 0x00, 0x00, 0x00, 0x0D, 0x49, 0x48, 0x44, 0x52,
@@ -3298,6 +3393,7 @@ static const uint8_t PROGMEM icon_arrow_down_png[] = {
   0x00, 0x88, 0x57, 0xFF, 0x89, 0x87, 0xD7, 0xDF, 0x1F, 0x99, 0x1F, 0x00, 0x6B, 0x95, 0xFD, 0x19,
   0xCE, 0x0D, 0x3F, 0x00, 0x00, 0x00, 0x00, 0x49, 0x45, 0x4E, 0x44, 0xAE, 0x42, 0x60, 0x82,
 };
+#endif
 
 // arrow_down monochrome bitmap (32x32 = 128 bytes)
 static const uint8_t PROGMEM icon_arrow_down_bitmap[] = {
@@ -3319,6 +3415,7 @@ static const uint8_t PROGMEM icon_arrow_down_bitmap[] = {
   0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
 };
 
+#if EMBEDDED_ICONS_PNG
 // chevron_left PNG data (387 bytes)
 static const uint8_t PROGMEM icon_chevron_left_png[] = {
   0x89, 0x50, 0x4E, 0x47, 0x0D, 0x0A, 0x1A, 0x0A, 0x00, 0x00, 0x00, 0x0D, 0x49, 0x48, 0x44, 0x52,
@@ -3347,6 +3444,7 @@ static const uint8_t PROGMEM icon_chevron_left_png[] = {
   0xF2, 0x95, 0x1B, 0x99, 0xBE, 0x88, 0x6C, 0x00, 0x00, 0x00, 0x00, 0x49, 0x45, 0x4E, 0x44, 0xAE,
   0x42, 0x60, 0x82,
 };
+#endif
 
 // chevron_left monochrome bitmap (32x32 = 128 bytes)
 static const uint8_t PROGMEM icon_chevron_left_bitmap[] = {
@@ -3368,6 +3466,7 @@ static const uint8_t PROGMEM icon_chevron_left_bitmap[] = {
   0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
 };
 
+#if EMBEDDED_ICONS_PNG
 // chevron_right PNG data (391 bytes)
 static const uint8_t PROGMEM icon_chevron_right_png[] = {
   0x89, 0x50, 0x4E, 0x47, 0x0D, 0x0A, 0x1A, 0x0A, 0x00, 0x00, 0x00, 0x0D, 0x49, 0x48, 0x44, 0x52,
@@ -3396,6 +3495,7 @@ static const uint8_t PROGMEM icon_chevron_right_png[] = {
   0xE3, 0xF7, 0x05, 0xD7, 0x7A, 0xEC, 0x34, 0xED, 0xB7, 0xB4, 0x65, 0x00, 0x00, 0x00, 0x00, 0x49,
   0x45, 0x4E, 0x44, 0xAE, 0x42, 0x60, 0x82,
 };
+#endif
 
 // chevron_right monochrome bitmap (32x32 = 128 bytes)
 static const uint8_t PROGMEM icon_chevron_right_bitmap[] = {
@@ -3417,6 +3517,7 @@ static const uint8_t PROGMEM icon_chevron_right_bitmap[] = {
   0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
 };
 
+#if EMBEDDED_ICONS_PNG
 // plus PNG data (463 bytes)
 static const uint8_t PROGMEM icon_plus_png[] = {
   0x89, 0x50, 0x4E, 0x47, 0x0D, 0x0A, 0x1A, 0x0A, 0x00, 0x00, 0x00, 0x0D, 0x49, 0x48, 0x44, 0x52,
@@ -3449,6 +3550,7 @@ static const uint8_t PROGMEM icon_plus_png[] = {
   0x3D, 0x7D, 0xE4, 0x7C, 0xFF, 0x35, 0x04, 0x7F, 0x5F, 0x07, 0x1F, 0x0A, 0x58, 0xB0, 0x7F, 0x4C,
   0xC0, 0x45, 0xE6, 0x00, 0x00, 0x00, 0x00, 0x49, 0x45, 0x4E, 0x44, 0xAE, 0x42, 0x60, 0x82,
 };
+#endif
 
 // plus monochrome bitmap (32x32 = 128 bytes)
 static const uint8_t PROGMEM icon_plus_bitmap[] = {
@@ -3470,6 +3572,7 @@ static const uint8_t PROGMEM icon_plus_bitmap[] = {
   0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
 };
 
+#if EMBEDDED_ICONS_PNG
 // minus PNG data (248 bytes)
 static const uint8_t PROGMEM icon_minus_png[] = {
   0x89, 0x50, 0x4E, 0x47, 0x0D, 0x0A, 0x1A, 0x0A, 0x00, 0x00, 0x00, 0x0D, 0x49, 0x48, 0x44, 0x52,
@@ -3489,6 +3592,7 @@ static const uint8_t PROGMEM icon_minus_png[] = {
   0xF0, 0x0F, 0x80, 0x07, 0x34, 0xFB, 0x61, 0xD9, 0x1F, 0x62, 0x34, 0x49, 0x00, 0x00, 0x00, 0x00,
   0x49, 0x45, 0x4E, 0x44, 0xAE, 0x42, 0x60, 0x82,
 };
+#endif
 
 // minus monochrome bitmap (32x32 = 128 bytes)
 static const uint8_t PROGMEM icon_minus_bitmap[] = {
@@ -3510,6 +3614,7 @@ static const uint8_t PROGMEM icon_minus_bitmap[] = {
   0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
 };
 
+#if EMBEDDED_ICONS_PNG
 // check PNG data (567 bytes)
 static const uint8_t PROGMEM icon_check_png[] = {
   0x89, 0x50, 0x4E, 0x47, 0x0D, 0x0A, 0x1A, 0x0A, 0x00, 0x00, 0x00, 0x0D, 0x49, 0x48, 0x44, 0x52,
@@ -3549,6 +3654,7 @@ static const uint8_t PROGMEM icon_check_png[] = {
   0x0E, 0xF8, 0x03, 0x1F, 0x85, 0xDD, 0x2A, 0x6F, 0xD7, 0x77, 0x47, 0x00, 0x00, 0x00, 0x00, 0x49,
   0x45, 0x4E, 0x44, 0xAE, 0x42, 0x60, 0x82,
 };
+#endif
 
 // check monochrome bitmap (32x32 = 128 bytes)
 static const uint8_t PROGMEM icon_check_bitmap[] = {
@@ -3570,6 +3676,7 @@ static const uint8_t PROGMEM icon_check_bitmap[] = {
   0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
 };
 
+#if EMBEDDED_ICONS_PNG
 // close PNG data (512 bytes)
 static const uint8_t PROGMEM icon_close_png[] = {
   0x89, 0x50, 0x4E, 0x47, 0x0D, 0x0A, 0x1A, 0x0A, 0x00, 0x00, 0x00, 0x0D, 0x49, 0x48, 0x44, 0x52,
@@ -3605,6 +3712,7 @@ static const uint8_t PROGMEM icon_close_png[] = {
   0x80, 0x52, 0x2A, 0xB8, 0x14, 0xF9, 0xFF, 0x6F, 0xFA, 0xE7, 0x80, 0x0F, 0xC4, 0x6B, 0xC5, 0x89,
   0x6F, 0x40, 0xE7, 0x07, 0x00, 0x00, 0x00, 0x00, 0x49, 0x45, 0x4E, 0x44, 0xAE, 0x42, 0x60, 0x82,
 };
+#endif
 
 // close monochrome bitmap (32x32 = 128 bytes)
 static const uint8_t PROGMEM icon_close_bitmap[] = {
@@ -3626,6 +3734,7 @@ static const uint8_t PROGMEM icon_close_bitmap[] = {
   0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
 };
 
+#if EMBEDDED_ICONS_PNG
 // menu PNG data (232 bytes)
 static const uint8_t PROGMEM icon_menu_png[] = {
   0x89, 0x50, 0x4E, 0x47, 0x0D, 0x0A, 0x1A, 0x0A, 0x00, 0x00, 0x00, 0x0D, 0x49, 0x48, 0x44, 0x52,
@@ -3644,6 +3753,7 @@ static const uint8_t PROGMEM icon_menu_png[] = {
   0xAE, 0x37, 0xB8, 0x01, 0x71, 0x2F, 0xC8, 0x87, 0x59, 0x05, 0xAB, 0xC6, 0x00, 0x00, 0x00, 0x00,
   0x49, 0x45, 0x4E, 0x44, 0xAE, 0x42, 0x60, 0x82,
 };
+#endif
 
 // menu monochrome bitmap (32x32 = 128 bytes)
 static const uint8_t PROGMEM icon_menu_bitmap[] = {
@@ -3665,6 +3775,7 @@ static const uint8_t PROGMEM icon_menu_bitmap[] = {
   0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
 };
 
+#if EMBEDDED_ICONS_PNG
 // search PNG data (780 bytes)
 static const uint8_t PROGMEM icon_search_png[] = {
   0x89, 0x50, 0x4E, 0x47, 0x0D, 0x0A, 0x1A, 0x0A, 0x00, 0x00, 0x00, 0x0D, 0x49, 0x48, 0x44, 0x52,
@@ -3717,6 +3828,7 @@ static const uint8_t PROGMEM icon_search_png[] = {
   0xC6, 0x36, 0x4C, 0xF6, 0xDF, 0x6F, 0xD7, 0x1F, 0xDC, 0x20, 0x50, 0x8F, 0x0D, 0x9E, 0x97, 0x54,
   0x00, 0x00, 0x00, 0x00, 0x49, 0x45, 0x4E, 0x44, 0xAE, 0x42, 0x60, 0x82,
 };
+#endif
 
 // search monochrome bitmap (32x32 = 128 bytes)
 static const uint8_t PROGMEM icon_search_bitmap[] = {
@@ -3738,6 +3850,7 @@ static const uint8_t PROGMEM icon_search_bitmap[] = {
   0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
 };
 
+#if EMBEDDED_ICONS_PNG
 // home PNG data (725 bytes)
 static const uint8_t PROGMEM icon_home_png[] = {
   0x89, 0x50, 0x4E, 0x47, 0x0D, 0x0A, 0x1A, 0x0A, 0x00, 0x00, 0x00, 0x0D, 0x49, 0x48, 0x44, 0x52,
@@ -3787,6 +3900,7 @@ static const uint8_t PROGMEM icon_home_png[] = {
   0x0B, 0x89, 0x1C, 0x81, 0x34, 0x70, 0x5F, 0x94, 0xC0, 0x00, 0x00, 0x00, 0x00, 0x49, 0x45, 0x4E,
   0x44, 0xAE, 0x42, 0x60, 0x82,
 };
+#endif
 
 // home monochrome bitmap (32x32 = 128 bytes)
 static const uint8_t PROGMEM icon_home_bitmap[] = {
@@ -3808,6 +3922,7 @@ static const uint8_t PROGMEM icon_home_bitmap[] = {
   0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
 };
 
+#if EMBEDDED_ICONS_PNG
 // back PNG data (545 bytes)
 static const uint8_t PROGMEM icon_back_png[] = {
   0x89, 0x50, 0x4E, 0x47, 0x0D, 0x0A, 0x1A, 0x0A, 0x00, 0x00, 0x00, 0x0D, 0x49, 0x48, 0x44, 0x52,
@@ -3846,6 +3961,7 @@ static const uint8_t PROGMEM icon_back_png[] = {
   0x2C, 0x7E, 0x12, 0x1E, 0x1B, 0x00, 0x00, 0x00, 0x00, 0x49, 0x45, 0x4E, 0x44, 0xAE, 0x42, 0x60,
   0x82,
 };
+#endif
 
 // back monochrome bitmap (32x32 = 128 bytes)
 static const uint8_t PROGMEM icon_back_bitmap[] = {
@@ -3867,6 +3983,7 @@ static const uint8_t PROGMEM icon_back_bitmap[] = {
   0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
 };
 
+#if EMBEDDED_ICONS_PNG
 // info PNG data (1094 bytes)
 static const uint8_t PROGMEM icon_info_png[] = {
   0x89, 0x50, 0x4E, 0x47, 0x0D, 0x0A, 0x1A, 0x0A, 0x00, 0x00, 0x00, 0x0D, 0x49, 0x48, 0x44, 0x52,
@@ -3939,6 +4056,7 @@ static const uint8_t PROGMEM icon_info_png[] = {
   0xFF, 0x02, 0xCF, 0xE7, 0x0B, 0xFF, 0xA3, 0x45, 0xA5, 0x5D, 0x00, 0x00, 0x00, 0x00, 0x49, 0x45,
   0x4E, 0x44, 0xAE, 0x42, 0x60, 0x82,
 };
+#endif
 
 // info monochrome bitmap (32x32 = 128 bytes)
 static const uint8_t PROGMEM icon_info_bitmap[] = {
@@ -3960,6 +4078,7 @@ static const uint8_t PROGMEM icon_info_bitmap[] = {
   0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
 };
 
+#if EMBEDDED_ICONS_PNG
 // warning PNG data (886 bytes)
 static const uint8_t PROGMEM icon_warning_png[] = {
   0x89, 0x50, 0x4E, 0x47, 0x0D, 0x0A, 0x1A, 0x0A, 0x00, 0x00, 0x00, 0x0D, 0x49, 0x48, 0x44, 0x52,
@@ -4019,6 +4138,7 @@ static const uint8_t PROGMEM icon_warning_png[] = {
   0xFD, 0x0B, 0x22, 0x93, 0xE6, 0xF3, 0xA9, 0x04, 0x73, 0x2D, 0x00, 0x00, 0x00, 0x00, 0x49, 0x45,
   0x4E, 0x44, 0xAE, 0x42, 0x60, 0x82,
 };
+#endif
 
 // warning monochrome bitmap (32x32 = 128 bytes)
 static const uint8_t PROGMEM icon_warning_bitmap[] = {
@@ -4040,6 +4160,7 @@ static const uint8_t PROGMEM icon_warning_bitmap[] = {
   0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
 };
 
+#if EMBEDDED_ICONS_PNG
 // lock PNG data (847 bytes)
 static const uint8_t PROGMEM icon_lock_png[] = {
   0x89, 0x50, 0x4E, 0x47, 0x0D, 0x0A, 0x1A, 0x0A, 0x00, 0x00, 0x00, 0x0D, 0x49, 0x48, 0x44, 0x52,
@@ -4096,6 +4217,7 @@ static const uint8_t PROGMEM icon_lock_png[] = {
   0x09, 0x51, 0x88, 0xBE, 0x3F, 0x1E, 0x01, 0x87, 0x1F, 0xA6, 0x5F, 0x5C, 0xCD, 0xFE, 0x8A, 0xF6,
   0x3E, 0xD6, 0x14, 0x00, 0x00, 0x00, 0x00, 0x49, 0x45, 0x4E, 0x44, 0xAE, 0x42, 0x60, 0x82,
 };
+#endif
 
 // lock monochrome bitmap (32x32 = 128 bytes)
 static const uint8_t PROGMEM icon_lock_bitmap[] = {
@@ -4117,6 +4239,7 @@ static const uint8_t PROGMEM icon_lock_bitmap[] = {
   0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
 };
 
+#if EMBEDDED_ICONS_PNG
 // unlock PNG data (847 bytes)
 static const uint8_t PROGMEM icon_unlock_png[] = {
   0x89, 0x50, 0x4E, 0x47, 0x0D, 0x0A, 0x1A, 0x0A, 0x00, 0x00, 0x00, 0x0D, 0x49, 0x48, 0x44, 0x52,
@@ -4173,6 +4296,7 @@ static const uint8_t PROGMEM icon_unlock_png[] = {
   0xE7, 0x95, 0x7F, 0xC4, 0xBF, 0x7E, 0x03, 0x0A, 0xBF, 0x8C, 0x3F, 0xC0, 0x9D, 0xFE, 0xF4, 0x24,
   0x95, 0xEB, 0xC9, 0x00, 0x00, 0x00, 0x00, 0x49, 0x45, 0x4E, 0x44, 0xAE, 0x42, 0x60, 0x82,
 };
+#endif
 
 // unlock monochrome bitmap (32x32 = 128 bytes)
 static const uint8_t PROGMEM icon_unlock_bitmap[] = {
@@ -4194,6 +4318,7 @@ static const uint8_t PROGMEM icon_unlock_bitmap[] = {
   0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
 };
 
+#if EMBEDDED_ICONS_PNG
 // user PNG data (626 bytes)
 static const uint8_t PROGMEM icon_user_png[] = {
   0x89, 0x50, 0x4E, 0x47, 0x0D, 0x0A, 0x1A, 0x0A, 0x00, 0x00, 0x00, 0x0D, 0x49, 0x48, 0x44, 0x52,
@@ -4237,6 +4362,7 @@ static const uint8_t PROGMEM icon_user_png[] = {
   0xBD, 0xAD, 0x4C, 0xD7, 0xCF, 0x90, 0x00, 0x00, 0x00, 0x00, 0x49, 0x45, 0x4E, 0x44, 0xAE, 0x42,
   0x60, 0x82,
 };
+#endif
 
 // user monochrome bitmap (32x32 = 128 bytes)
 static const uint8_t PROGMEM icon_user_bitmap[] = {
@@ -4258,6 +4384,7 @@ static const uint8_t PROGMEM icon_user_bitmap[] = {
   0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
 };
 
+#if EMBEDDED_ICONS_PNG
 // notify_bell PNG data (723 bytes)
 static const uint8_t PROGMEM icon_notify_bell_png[] = {
   0x89, 0x50, 0x4E, 0x47, 0x0D, 0x0A, 0x1A, 0x0A, 0x00, 0x00, 0x00, 0x0D, 0x49, 0x48, 0x44, 0x52,
@@ -4307,6 +4434,7 @@ static const uint8_t PROGMEM icon_notify_bell_png[] = {
   0x8E, 0x86, 0x87, 0xE0, 0xE3, 0x4B, 0x95, 0x00, 0x00, 0x00, 0x00, 0x49, 0x45, 0x4E, 0x44, 0xAE,
   0x42, 0x60, 0x82,
 };
+#endif
 
 // notify_bell monochrome bitmap (32x32 = 128 bytes)
 static const uint8_t PROGMEM icon_notify_bell_bitmap[] = {
@@ -4328,6 +4456,7 @@ static const uint8_t PROGMEM icon_notify_bell_bitmap[] = {
   0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
 };
 
+#if EMBEDDED_ICONS_PNG
 // notify_automation PNG data (1121 bytes)
 static const uint8_t PROGMEM icon_notify_automation_png[] = {
   0x89, 0x50, 0x4E, 0x47, 0x0D, 0x0A, 0x1A, 0x0A, 0x00, 0x00, 0x00, 0x0D, 0x49, 0x48, 0x44, 0x52,
@@ -4402,6 +4531,7 @@ static const uint8_t PROGMEM icon_notify_automation_png[] = {
   0xF4, 0x84, 0xA2, 0x79, 0xF8, 0x00, 0x00, 0x00, 0x00, 0x49, 0x45, 0x4E, 0x44, 0xAE, 0x42, 0x60,
   0x82,
 };
+#endif
 
 // notify_automation monochrome bitmap (32x32 = 128 bytes)
 static const uint8_t PROGMEM icon_notify_automation_bitmap[] = {
@@ -4423,6 +4553,7 @@ static const uint8_t PROGMEM icon_notify_automation_bitmap[] = {
   0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
 };
 
+#if EMBEDDED_ICONS_PNG
 // notify_sensor PNG data (963 bytes)
 static const uint8_t PROGMEM icon_notify_sensor_png[] = {
   0x89, 0x50, 0x4E, 0x47, 0x0D, 0x0A, 0x1A, 0x0A, 0x00, 0x00, 0x00, 0x0D, 0x49, 0x48, 0x44, 0x52,
@@ -4487,6 +4618,7 @@ static const uint8_t PROGMEM icon_notify_sensor_png[] = {
   0x35, 0x25, 0x23, 0xF7, 0xBB, 0x6D, 0x65, 0x00, 0x00, 0x00, 0x00, 0x49, 0x45, 0x4E, 0x44, 0xAE,
   0x42, 0x60, 0x82,
 };
+#endif
 
 // notify_sensor monochrome bitmap (32x32 = 128 bytes)
 static const uint8_t PROGMEM icon_notify_sensor_bitmap[] = {
@@ -4508,6 +4640,7 @@ static const uint8_t PROGMEM icon_notify_sensor_bitmap[] = {
   0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
 };
 
+#if EMBEDDED_ICONS_PNG
 // notify_logging PNG data (559 bytes)
 static const uint8_t PROGMEM icon_notify_logging_png[] = {
   0x89, 0x50, 0x4E, 0x47, 0x0D, 0x0A, 0x1A, 0x0A, 0x00, 0x00, 0x00, 0x0D, 0x49, 0x48, 0x44, 0x52,
@@ -4546,6 +4679,7 @@ static const uint8_t PROGMEM icon_notify_logging_png[] = {
   0xD3, 0xF2, 0xB3, 0xF4, 0xF1, 0x0E, 0xB0, 0xF2, 0xE1, 0xF8, 0x0D, 0xD2, 0x31, 0xC0, 0xC7, 0x71,
   0x71, 0xEA, 0x21, 0x00, 0x00, 0x00, 0x00, 0x49, 0x45, 0x4E, 0x44, 0xAE, 0x42, 0x60, 0x82,
 };
+#endif
 
 // notify_logging monochrome bitmap (32x32 = 128 bytes)
 static const uint8_t PROGMEM icon_notify_logging_bitmap[] = {
@@ -4567,6 +4701,7 @@ static const uint8_t PROGMEM icon_notify_logging_bitmap[] = {
   0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
 };
 
+#if EMBEDDED_ICONS_PNG
 // notify_files PNG data (585 bytes)
 static const uint8_t PROGMEM icon_notify_files_png[] = {
   0x89, 0x50, 0x4E, 0x47, 0x0D, 0x0A, 0x1A, 0x0A, 0x00, 0x00, 0x00, 0x0D, 0x49, 0x48, 0x44, 0x52,
@@ -4607,6 +4742,7 @@ static const uint8_t PROGMEM icon_notify_files_png[] = {
   0xF0, 0x71, 0x37, 0xFD, 0x03, 0xFE, 0x84, 0x90, 0x85, 0x09, 0x34, 0xC7, 0x0D, 0x00, 0x00, 0x00,
   0x00, 0x49, 0x45, 0x4E, 0x44, 0xAE, 0x42, 0x60, 0x82,
 };
+#endif
 
 // notify_files monochrome bitmap (32x32 = 128 bytes)
 static const uint8_t PROGMEM icon_notify_files_bitmap[] = {
@@ -4628,6 +4764,7 @@ static const uint8_t PROGMEM icon_notify_files_bitmap[] = {
   0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
 };
 
+#if EMBEDDED_ICONS_PNG
 // notify_system PNG data (832 bytes)
 static const uint8_t PROGMEM icon_notify_system_png[] = {
   0x89, 0x50, 0x4E, 0x47, 0x0D, 0x0A, 0x1A, 0x0A, 0x00, 0x00, 0x00, 0x0D, 0x49, 0x48, 0x44, 0x52,
@@ -4683,6 +4820,7 @@ static const uint8_t PROGMEM icon_notify_system_png[] = {
   0xE7, 0xDA, 0xE4, 0xBF, 0xE9, 0xE0, 0xFF, 0xAF, 0xE3, 0x97, 0xF1, 0x0B, 0xA9, 0xAA, 0xFF, 0x2C,
   0x63, 0xED, 0x8D, 0x12, 0x00, 0x00, 0x00, 0x00, 0x49, 0x45, 0x4E, 0x44, 0xAE, 0x42, 0x60, 0x82,
 };
+#endif
 
 // notify_system monochrome bitmap (32x32 = 128 bytes)
 static const uint8_t PROGMEM icon_notify_system_bitmap[] = {
@@ -4704,6 +4842,7 @@ static const uint8_t PROGMEM icon_notify_system_bitmap[] = {
   0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
 };
 
+#if EMBEDDED_ICONS_PNG
 // notify_cli PNG data (756 bytes)
 static const uint8_t PROGMEM icon_notify_cli_png[] = {
   0x89, 0x50, 0x4E, 0x47, 0x0D, 0x0A, 0x1A, 0x0A, 0x00, 0x00, 0x00, 0x0D, 0x49, 0x48, 0x44, 0x52,
@@ -4755,6 +4894,7 @@ static const uint8_t PROGMEM icon_notify_cli_png[] = {
   0xE8, 0xAB, 0xF6, 0x98, 0x95, 0x32, 0x1F, 0x9F, 0x00, 0x00, 0x00, 0x00, 0x49, 0x45, 0x4E, 0x44,
   0xAE, 0x42, 0x60, 0x82,
 };
+#endif
 
 // notify_cli monochrome bitmap (32x32 = 128 bytes)
 static const uint8_t PROGMEM icon_notify_cli_bitmap[] = {
@@ -4776,6 +4916,7 @@ static const uint8_t PROGMEM icon_notify_cli_bitmap[] = {
   0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
 };
 
+#if EMBEDDED_ICONS_PNG
 // compass PNG data (1211 bytes)
 static const uint8_t PROGMEM icon_compass_png[] = {
   0x89, 0x50, 0x4E, 0x47, 0x0D, 0x0A, 0x1A, 0x0A, 0x00, 0x00, 0x00, 0x0D, 0x49, 0x48, 0x44, 0x52,
@@ -4855,6 +4996,7 @@ static const uint8_t PROGMEM icon_compass_png[] = {
   0xF5, 0x76, 0x2D, 0xC1, 0x1F, 0x9F, 0x7F, 0xD6, 0xB8, 0x9A, 0x69, 0x11, 0x5D, 0xE0, 0x6B, 0x00,
   0x00, 0x00, 0x00, 0x49, 0x45, 0x4E, 0x44, 0xAE, 0x42, 0x60, 0x82,
 };
+#endif
 
 // compass monochrome bitmap (32x32 = 128 bytes)
 static const uint8_t PROGMEM icon_compass_bitmap[] = {
@@ -4876,6 +5018,7 @@ static const uint8_t PROGMEM icon_compass_bitmap[] = {
   0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
 };
 
+#if EMBEDDED_ICONS_PNG
 // imu_axes PNG data (772 bytes)
 static const uint8_t PROGMEM icon_imu_axes_png[] = {
   0x89, 0x50, 0x4E, 0x47, 0x0D, 0x0A, 0x1A, 0x0A, 0x00, 0x00, 0x00, 0x0D, 0x49, 0x48, 0x44, 0x52,
@@ -4928,6 +5071,7 @@ static const uint8_t PROGMEM icon_imu_axes_png[] = {
   0x66, 0x9B, 0x3E, 0xD3, 0xA1, 0xDD, 0x6C, 0xB1, 0x00, 0x00, 0x00, 0x00, 0x49, 0x45, 0x4E, 0x44,
   0xAE, 0x42, 0x60, 0x82,
 };
+#endif
 
 // imu_axes monochrome bitmap (32x32 = 128 bytes)
 static const uint8_t PROGMEM icon_imu_axes_bitmap[] = {
@@ -4949,6 +5093,7 @@ static const uint8_t PROGMEM icon_imu_axes_bitmap[] = {
   0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
 };
 
+#if EMBEDDED_ICONS_PNG
 // thermal PNG data (820 bytes)
 static const uint8_t PROGMEM icon_thermal_png[] = {
   0x89, 0x50, 0x4E, 0x47, 0x0D, 0x0A, 0x1A, 0x0A, 0x00, 0x00, 0x00, 0x0D, 0x49, 0x48, 0x44, 0x52,
@@ -5004,6 +5149,7 @@ static const uint8_t PROGMEM icon_thermal_png[] = {
   0x19, 0xD4, 0x8A, 0x8F, 0x5E, 0x85, 0x9D, 0xCB, 0x00, 0x00, 0x00, 0x00, 0x49, 0x45, 0x4E, 0x44,
   0xAE, 0x42, 0x60, 0x82,
 };
+#endif
 
 // thermal monochrome bitmap (32x32 = 128 bytes)
 static const uint8_t PROGMEM icon_thermal_bitmap[] = {
@@ -5025,6 +5171,7 @@ static const uint8_t PROGMEM icon_thermal_bitmap[] = {
   0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
 };
 
+#if EMBEDDED_ICONS_PNG
 // tof_radar PNG data (921 bytes)
 static const uint8_t PROGMEM icon_tof_radar_png[] = {
   0x89, 0x50, 0x4E, 0x47, 0x0D, 0x0A, 0x1A, 0x0A, 0x00, 0x00, 0x00, 0x0D, 0x49, 0x48, 0x44, 0x52,
@@ -5086,6 +5233,7 @@ static const uint8_t PROGMEM icon_tof_radar_png[] = {
   0xED, 0x7A, 0xD4, 0xF8, 0x07, 0xA0, 0x9C, 0xF7, 0x3C, 0x87, 0x38, 0x79, 0xF4, 0x00, 0x00, 0x00,
   0x00, 0x49, 0x45, 0x4E, 0x44, 0xAE, 0x42, 0x60, 0x82,
 };
+#endif
 
 // tof_radar monochrome bitmap (32x32 = 128 bytes)
 static const uint8_t PROGMEM icon_tof_radar_bitmap[] = {
@@ -5107,6 +5255,7 @@ static const uint8_t PROGMEM icon_tof_radar_bitmap[] = {
   0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
 };
 
+#if EMBEDDED_ICONS_PNG
 // smartphone PNG data (574 bytes)
 static const uint8_t PROGMEM icon_smartphone_png[] = {
   0x89, 0x50, 0x4E, 0x47, 0x0D, 0x0A, 0x1A, 0x0A, 0x00, 0x00, 0x00, 0x0D, 0x49, 0x48, 0x44, 0x52,
@@ -5146,6 +5295,7 @@ static const uint8_t PROGMEM icon_smartphone_png[] = {
   0x6A, 0xE4, 0xE9, 0xDB, 0x23, 0x78, 0xFB, 0x65, 0xF7, 0x0B, 0x9B, 0x33, 0xDD, 0xDF, 0xBA, 0x56,
   0x8C, 0x40, 0x00, 0x00, 0x00, 0x00, 0x49, 0x45, 0x4E, 0x44, 0xAE, 0x42, 0x60, 0x82,
 };
+#endif
 
 // smartphone monochrome bitmap (32x32 = 128 bytes)
 static const uint8_t PROGMEM icon_smartphone_bitmap[] = {
@@ -5167,6 +5317,7 @@ static const uint8_t PROGMEM icon_smartphone_bitmap[] = {
   0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
 };
 
+#if EMBEDDED_ICONS_PNG
 // laptop PNG data (504 bytes)
 static const uint8_t PROGMEM icon_laptop_png[] = {
   0x89, 0x50, 0x4E, 0x47, 0x0D, 0x0A, 0x1A, 0x0A, 0x00, 0x00, 0x00, 0x0D, 0x49, 0x48, 0x44, 0x52,
@@ -5202,6 +5353,7 @@ static const uint8_t PROGMEM icon_laptop_png[] = {
   0xFE, 0x39, 0xC0, 0x17, 0xE3, 0xDC, 0x6E, 0x45, 0xC6, 0x1A, 0xEE, 0xD2, 0x00, 0x00, 0x00, 0x00,
   0x49, 0x45, 0x4E, 0x44, 0xAE, 0x42, 0x60, 0x82,
 };
+#endif
 
 // laptop monochrome bitmap (32x32 = 128 bytes)
 static const uint8_t PROGMEM icon_laptop_bitmap[] = {
@@ -5223,6 +5375,7 @@ static const uint8_t PROGMEM icon_laptop_bitmap[] = {
   0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
 };
 
+#if EMBEDDED_ICONS_PNG
 // watch PNG data (941 bytes)
 static const uint8_t PROGMEM icon_watch_png[] = {
   0x89, 0x50, 0x4E, 0x47, 0x0D, 0x0A, 0x1A, 0x0A, 0x00, 0x00, 0x00, 0x0D, 0x49, 0x48, 0x44, 0x52,
@@ -5285,6 +5438,7 @@ static const uint8_t PROGMEM icon_watch_png[] = {
   0xF1, 0xFF, 0x8D, 0x0A, 0x04, 0xF4, 0x8B, 0xF1, 0x1B, 0xAB, 0x0C, 0xA9, 0x3B, 0x18, 0x8B, 0x84,
   0x13, 0x00, 0x00, 0x00, 0x00, 0x49, 0x45, 0x4E, 0x44, 0xAE, 0x42, 0x60, 0x82,
 };
+#endif
 
 // watch monochrome bitmap (32x32 = 128 bytes)
 static const uint8_t PROGMEM icon_watch_bitmap[] = {
@@ -5306,6 +5460,7 @@ static const uint8_t PROGMEM icon_watch_bitmap[] = {
   0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
 };
 
+#if EMBEDDED_ICONS_PNG
 // headphones PNG data (744 bytes)
 static const uint8_t PROGMEM icon_headphones_png[] = {
   0x89, 0x50, 0x4E, 0x47, 0x0D, 0x0A, 0x1A, 0x0A, 0x00, 0x00, 0x00, 0x0D, 0x49, 0x48, 0x44, 0x52,
@@ -5356,6 +5511,7 @@ static const uint8_t PROGMEM icon_headphones_png[] = {
   0xF7, 0x39, 0xF8, 0x01, 0x44, 0x35, 0x71, 0x03, 0x70, 0x3E, 0x90, 0x00, 0x00, 0x00, 0x00, 0x00,
   0x49, 0x45, 0x4E, 0x44, 0xAE, 0x42, 0x60, 0x82,
 };
+#endif
 
 // headphones monochrome bitmap (32x32 = 128 bytes)
 static const uint8_t PROGMEM icon_headphones_bitmap[] = {
@@ -5377,6 +5533,7 @@ static const uint8_t PROGMEM icon_headphones_bitmap[] = {
   0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
 };
 
+#if EMBEDDED_ICONS_PNG
 // smart_glasses PNG data (713 bytes)
 static const uint8_t PROGMEM icon_smart_glasses_png[] = {
   0x89, 0x50, 0x4E, 0x47, 0x0D, 0x0A, 0x1A, 0x0A, 0x00, 0x00, 0x00, 0x0D, 0x49, 0x48, 0x44, 0x52,
@@ -5425,6 +5582,7 @@ static const uint8_t PROGMEM icon_smart_glasses_png[] = {
   0xE0, 0xEF, 0x05, 0xFE, 0x01, 0xE1, 0x2B, 0x8C, 0x33, 0xB6, 0x06, 0xB7, 0xD6, 0x00, 0x00, 0x00,
   0x00, 0x49, 0x45, 0x4E, 0x44, 0xAE, 0x42, 0x60, 0x82,
 };
+#endif
 
 // smart_glasses monochrome bitmap (32x32 = 128 bytes)
 static const uint8_t PROGMEM icon_smart_glasses_bitmap[] = {
@@ -5446,6 +5604,7 @@ static const uint8_t PROGMEM icon_smart_glasses_bitmap[] = {
   0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
 };
 
+#if EMBEDDED_ICONS_PNG
 // gamepad PNG data (784 bytes)
 static const uint8_t PROGMEM icon_gamepad_png[] = {
   0x89, 0x50, 0x4E, 0x47, 0x0D, 0x0A, 0x1A, 0x0A, 0x00, 0x00, 0x00, 0x0D, 0x49, 0x48, 0x44, 0x52,
@@ -5498,6 +5657,7 @@ static const uint8_t PROGMEM icon_gamepad_png[] = {
   0xF7, 0x5F, 0xCD, 0x09, 0x51, 0x50, 0x43, 0xFC, 0xEF, 0xB7, 0xEB, 0x7F, 0xC8, 0x7A, 0x16, 0xF1,
   0x7A, 0xED, 0x01, 0xF0, 0x00, 0x00, 0x00, 0x00, 0x49, 0x45, 0x4E, 0x44, 0xAE, 0x42, 0x60, 0x82,
 };
+#endif
 
 // gamepad monochrome bitmap (32x32 = 128 bytes)
 static const uint8_t PROGMEM icon_gamepad_bitmap[] = {
@@ -5519,6 +5679,7 @@ static const uint8_t PROGMEM icon_gamepad_bitmap[] = {
   0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
 };
 
+#if EMBEDDED_ICONS_PNG
 // gesture PNG data (1030 bytes)
 static const uint8_t PROGMEM icon_gesture_png[] = {
   0x89, 0x50, 0x4E, 0x47, 0x0D, 0x0A, 0x1A, 0x0A, 0x00, 0x00, 0x00, 0x0D, 0x49, 0x48, 0x44, 0x52,
@@ -5587,6 +5748,7 @@ static const uint8_t PROGMEM icon_gesture_png[] = {
   0xFC, 0x05, 0xD6, 0x85, 0x8E, 0xFC, 0x9F, 0x53, 0xD4, 0x37, 0x00, 0x00, 0x00, 0x00, 0x49, 0x45,
   0x4E, 0x44, 0xAE, 0x42, 0x60, 0x82,
 };
+#endif
 
 // gesture monochrome bitmap (32x32 = 128 bytes)
 static const uint8_t PROGMEM icon_gesture_bitmap[] = {
@@ -5608,6 +5770,7 @@ static const uint8_t PROGMEM icon_gesture_bitmap[] = {
   0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
 };
 
+#if EMBEDDED_ICONS_PNG
 // clock PNG data (1118 bytes)
 static const uint8_t PROGMEM icon_clock_png[] = {
   0x89, 0x50, 0x4E, 0x47, 0x0D, 0x0A, 0x1A, 0x0A, 0x00, 0x00, 0x00, 0x0D, 0x49, 0x48, 0x44, 0x52,
@@ -5681,6 +5844,7 @@ static const uint8_t PROGMEM icon_clock_png[] = {
   0xA8, 0xE4, 0xB7, 0xA7, 0x6B, 0x0E, 0x7E, 0x59, 0xFE, 0x01, 0xCD, 0x6C, 0x05, 0xE8, 0x0B, 0x5C,
   0x5F, 0x44, 0x00, 0x00, 0x00, 0x00, 0x49, 0x45, 0x4E, 0x44, 0xAE, 0x42, 0x60, 0x82,
 };
+#endif
 
 // clock monochrome bitmap (32x32 = 128 bytes)
 static const uint8_t PROGMEM icon_clock_bitmap[] = {
@@ -5702,6 +5866,7 @@ static const uint8_t PROGMEM icon_clock_bitmap[] = {
   0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
 };
 
+#if EMBEDDED_ICONS_PNG
 // pair_link PNG data (899 bytes)
 static const uint8_t PROGMEM icon_pair_link_png[] = {
   0x89, 0x50, 0x4E, 0x47, 0x0D, 0x0A, 0x1A, 0x0A, 0x00, 0x00, 0x00, 0x0D, 0x49, 0x48, 0x44, 0x52,
@@ -5762,6 +5927,7 @@ static const uint8_t PROGMEM icon_pair_link_png[] = {
   0x19, 0x09, 0x6D, 0x58, 0x56, 0xCD, 0x16, 0x00, 0x00, 0x00, 0x00, 0x49, 0x45, 0x4E, 0x44, 0xAE,
   0x42, 0x60, 0x82,
 };
+#endif
 
 // pair_link monochrome bitmap (32x32 = 128 bytes)
 static const uint8_t PROGMEM icon_pair_link_bitmap[] = {
@@ -5783,6 +5949,7 @@ static const uint8_t PROGMEM icon_pair_link_bitmap[] = {
   0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
 };
 
+#if EMBEDDED_ICONS_PNG
 // pair_link_off PNG data (955 bytes)
 static const uint8_t PROGMEM icon_pair_link_off_png[] = {
   0x89, 0x50, 0x4E, 0x47, 0x0D, 0x0A, 0x1A, 0x0A, 0x00, 0x00, 0x00, 0x0D, 0x49, 0x48, 0x44, 0x52,
@@ -5846,6 +6013,7 @@ static const uint8_t PROGMEM icon_pair_link_off_png[] = {
   0x7F, 0xFF, 0x4D, 0xFF, 0x3A, 0xC1, 0x7F, 0xF8, 0x9F, 0xB7, 0x66, 0x96, 0xC2, 0x10, 0x9C, 0x00,
   0x00, 0x00, 0x00, 0x49, 0x45, 0x4E, 0x44, 0xAE, 0x42, 0x60, 0x82,
 };
+#endif
 
 // pair_link_off monochrome bitmap (32x32 = 128 bytes)
 static const uint8_t PROGMEM icon_pair_link_off_bitmap[] = {
@@ -5867,6 +6035,7 @@ static const uint8_t PROGMEM icon_pair_link_off_bitmap[] = {
   0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
 };
 
+#if EMBEDDED_ICONS_PNG
 // pair_sync PNG data (843 bytes)
 static const uint8_t PROGMEM icon_pair_sync_png[] = {
   0x89, 0x50, 0x4E, 0x47, 0x0D, 0x0A, 0x1A, 0x0A, 0x00, 0x00, 0x00, 0x0D, 0x49, 0x48, 0x44, 0x52,
@@ -5923,6 +6092,7 @@ static const uint8_t PROGMEM icon_pair_sync_png[] = {
   0xFE, 0x3F, 0x1D, 0xFF, 0x7D, 0x80, 0x1F, 0x61, 0x45, 0x99, 0xC4, 0x79, 0x3A, 0x6E, 0x50, 0x00,
   0x00, 0x00, 0x00, 0x49, 0x45, 0x4E, 0x44, 0xAE, 0x42, 0x60, 0x82,
 };
+#endif
 
 // pair_sync monochrome bitmap (32x32 = 128 bytes)
 static const uint8_t PROGMEM icon_pair_sync_bitmap[] = {
@@ -5944,6 +6114,7 @@ static const uint8_t PROGMEM icon_pair_sync_bitmap[] = {
   0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
 };
 
+#if EMBEDDED_ICONS_PNG
 // pair_search PNG data (797 bytes)
 static const uint8_t PROGMEM icon_pair_search_png[] = {
   0x89, 0x50, 0x4E, 0x47, 0x0D, 0x0A, 0x1A, 0x0A, 0x00, 0x00, 0x00, 0x0D, 0x49, 0x48, 0x44, 0x52,
@@ -5997,6 +6168,7 @@ static const uint8_t PROGMEM icon_pair_search_png[] = {
   0x86, 0xE6, 0xCA, 0xFE, 0x7F, 0xFC, 0x4E, 0xC2, 0x2F, 0xBB, 0x62, 0x58, 0x9D, 0xF3, 0x6F, 0x2A,
   0xE0, 0x00, 0x00, 0x00, 0x00, 0x49, 0x45, 0x4E, 0x44, 0xAE, 0x42, 0x60, 0x82,
 };
+#endif
 
 // pair_search monochrome bitmap (32x32 = 128 bytes)
 static const uint8_t PROGMEM icon_pair_search_bitmap[] = {
@@ -6018,6 +6190,7 @@ static const uint8_t PROGMEM icon_pair_search_bitmap[] = {
   0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
 };
 
+#if EMBEDDED_ICONS_PNG
 // help PNG data (1155 bytes)
 static const uint8_t PROGMEM icon_help_png[] = {
   0x89, 0x50, 0x4E, 0x47, 0x0D, 0x0A, 0x1A, 0x0A, 0x00, 0x00, 0x00, 0x0D, 0x49, 0x48, 0x44, 0x52,
@@ -6094,6 +6267,7 @@ static const uint8_t PROGMEM icon_help_png[] = {
   0x69, 0xBB, 0x78, 0x38, 0xAD, 0xA4, 0x05, 0x00, 0x00, 0x00, 0x00, 0x49, 0x45, 0x4E, 0x44, 0xAE,
   0x42, 0x60, 0x82,
 };
+#endif
 
 // help monochrome bitmap (32x32 = 128 bytes)
 static const uint8_t PROGMEM icon_help_bitmap[] = {
@@ -6115,6 +6289,7 @@ static const uint8_t PROGMEM icon_help_bitmap[] = {
   0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
 };
 
+#if EMBEDDED_ICONS_PNG
 // debug PNG data (622 bytes)
 static const uint8_t PROGMEM icon_debug_png[] = {
   0x89, 0x50, 0x4E, 0x47, 0x0D, 0x0A, 0x1A, 0x0A, 0x00, 0x00, 0x00, 0x0D, 0x49, 0x48, 0x44, 0x52,
@@ -6157,6 +6332,7 @@ static const uint8_t PROGMEM icon_debug_png[] = {
   0x84, 0xA6, 0x69, 0x61, 0xB9, 0x3F, 0x01, 0x84, 0xAE, 0x6F, 0x7B, 0x25, 0x03, 0xD0, 0x2C, 0xFA,
   0xAF, 0xF2, 0x00, 0x00, 0x00, 0x00, 0x49, 0x45, 0x4E, 0x44, 0xAE, 0x42, 0x60, 0x82,
 };
+#endif
 
 // debug monochrome bitmap (32x32 = 128 bytes)
 static const uint8_t PROGMEM icon_debug_bitmap[] = {
@@ -6178,6 +6354,7 @@ static const uint8_t PROGMEM icon_debug_bitmap[] = {
   0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
 };
 
+#if EMBEDDED_ICONS_PNG
 // power PNG data (921 bytes)
 static const uint8_t PROGMEM icon_power_png[] = {
   0x89, 0x50, 0x4E, 0x47, 0x0D, 0x0A, 0x1A, 0x0A, 0x00, 0x00, 0x00, 0x0D, 0x49, 0x48, 0x44, 0x52,
@@ -6239,6 +6416,7 @@ static const uint8_t PROGMEM icon_power_png[] = {
   0x25, 0xF8, 0x61, 0xF9, 0x05, 0x56, 0xB4, 0x70, 0x3A, 0x0F, 0x0A, 0x59, 0x53, 0x00, 0x00, 0x00,
   0x00, 0x49, 0x45, 0x4E, 0x44, 0xAE, 0x42, 0x60, 0x82,
 };
+#endif
 
 // power monochrome bitmap (32x32 = 128 bytes)
 static const uint8_t PROGMEM icon_power_bitmap[] = {
@@ -6260,6 +6438,7 @@ static const uint8_t PROGMEM icon_power_bitmap[] = {
   0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
 };
 
+#if EMBEDDED_ICONS_PNG
 // notify_display PNG data (747 bytes)
 static const uint8_t PROGMEM icon_notify_display_png[] = {
   0x89, 0x50, 0x4E, 0x47, 0x0D, 0x0A, 0x1A, 0x0A, 0x00, 0x00, 0x00, 0x0D, 0x49, 0x48, 0x44, 0x52,
@@ -6310,6 +6489,7 @@ static const uint8_t PROGMEM icon_notify_display_png[] = {
   0x5B, 0xC1, 0xD1, 0x3F, 0x7E, 0xFF, 0x00, 0x37, 0x93, 0x45, 0xD3, 0x30, 0xF0, 0x5C, 0x98, 0x00,
   0x00, 0x00, 0x00, 0x49, 0x45, 0x4E, 0x44, 0xAE, 0x42, 0x60, 0x82,
 };
+#endif
 
 // notify_display monochrome bitmap (32x32 = 128 bytes)
 static const uint8_t PROGMEM icon_notify_display_bitmap[] = {
@@ -6331,6 +6511,7 @@ static const uint8_t PROGMEM icon_notify_display_bitmap[] = {
   0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
 };
 
+#if EMBEDDED_ICONS_PNG
 // neopixel PNG data (843 bytes)
 static const uint8_t PROGMEM icon_neopixel_png[] = {
   0x89, 0x50, 0x4E, 0x47, 0x0D, 0x0A, 0x1A, 0x0A, 0x00, 0x00, 0x00, 0x0D, 0x49, 0x48, 0x44, 0x52,
@@ -6387,6 +6568,7 @@ static const uint8_t PROGMEM icon_neopixel_png[] = {
   0xE0, 0x97, 0xE0, 0xE7, 0x09, 0xFE, 0x01, 0x66, 0x46, 0x7C, 0x5B, 0xED, 0xEF, 0x17, 0x7B, 0x00,
   0x00, 0x00, 0x00, 0x49, 0x45, 0x4E, 0x44, 0xAE, 0x42, 0x60, 0x82,
 };
+#endif
 
 // neopixel monochrome bitmap (32x32 = 128 bytes)
 static const uint8_t PROGMEM icon_neopixel_bitmap[] = {
@@ -6408,6 +6590,7 @@ static const uint8_t PROGMEM icon_neopixel_bitmap[] = {
   0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
 };
 
+#if EMBEDDED_ICONS_PNG
 // servo PNG data (841 bytes)
 static const uint8_t PROGMEM icon_servo_png[] = {
   0x89, 0x50, 0x4E, 0x47, 0x0D, 0x0A, 0x1A, 0x0A, 0x00, 0x00, 0x00, 0x0D, 0x49, 0x48, 0x44, 0x52,
@@ -6464,6 +6647,7 @@ static const uint8_t PROGMEM icon_servo_png[] = {
   0xBC, 0xFE, 0x3D, 0xC1, 0x1F, 0xC2, 0xC0, 0x63, 0x3C, 0x41, 0x05, 0x62, 0x78, 0x00, 0x00, 0x00,
   0x00, 0x49, 0x45, 0x4E, 0x44, 0xAE, 0x42, 0x60, 0x82,
 };
+#endif
 
 // servo monochrome bitmap (32x32 = 128 bytes)
 static const uint8_t PROGMEM icon_servo_bitmap[] = {
@@ -6485,6 +6669,7 @@ static const uint8_t PROGMEM icon_servo_bitmap[] = {
   0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
 };
 
+#if EMBEDDED_ICONS_PNG
 // camera PNG data (938 bytes)
 static const uint8_t PROGMEM icon_camera_png[] = {
   0x89, 0x50, 0x4E, 0x47, 0x0D, 0x0A, 0x1A, 0x0A, 0x00, 0x00, 0x00, 0x0D, 0x49, 0x48, 0x44, 0x52,
@@ -6547,6 +6732,7 @@ static const uint8_t PROGMEM icon_camera_png[] = {
   0x5F, 0xC7, 0x7F, 0x9F, 0xE0, 0x1B, 0x2F, 0xC9, 0x7F, 0xCB, 0x90, 0xAE, 0x50, 0x86, 0x00, 0x00,
   0x00, 0x00, 0x49, 0x45, 0x4E, 0x44, 0xAE, 0x42, 0x60, 0x82,
 };
+#endif
 
 // camera monochrome bitmap (32x32 = 128 bytes)
 static const uint8_t PROGMEM icon_camera_bitmap[] = {
@@ -6568,6 +6754,7 @@ static const uint8_t PROGMEM icon_camera_bitmap[] = {
   0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
 };
 
+#if EMBEDDED_ICONS_PNG
 // microphone PNG data (762 bytes)
 static const uint8_t PROGMEM icon_microphone_png[] = {
   0x89, 0x50, 0x4E, 0x47, 0x0D, 0x0A, 0x1A, 0x0A, 0x00, 0x00, 0x00, 0x0D, 0x49, 0x48, 0x44, 0x52,
@@ -6619,6 +6806,7 @@ static const uint8_t PROGMEM icon_microphone_png[] = {
   0x9B, 0xFE, 0x8B, 0x00, 0x3F, 0x00, 0x9E, 0x5B, 0x58, 0xF8, 0x2B, 0x57, 0x4F, 0x2A, 0x00, 0x00,
   0x00, 0x00, 0x49, 0x45, 0x4E, 0x44, 0xAE, 0x42, 0x60, 0x82,
 };
+#endif
 
 // microphone monochrome bitmap (32x32 = 128 bytes)
 static const uint8_t PROGMEM icon_microphone_bitmap[] = {
@@ -6640,6 +6828,7 @@ static const uint8_t PROGMEM icon_microphone_bitmap[] = {
   0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
 };
 
+#if EMBEDDED_ICONS_PNG
 // mic PNG data (762 bytes)
 static const uint8_t PROGMEM icon_mic_png[] = {
   0x89, 0x50, 0x4E, 0x47, 0x0D, 0x0A, 0x1A, 0x0A, 0x00, 0x00, 0x00, 0x0D, 0x49, 0x48, 0x44, 0x52,
@@ -6691,6 +6880,7 @@ static const uint8_t PROGMEM icon_mic_png[] = {
   0x9B, 0xFE, 0x8B, 0x00, 0x3F, 0x00, 0x9E, 0x5B, 0x58, 0xF8, 0x2B, 0x57, 0x4F, 0x2A, 0x00, 0x00,
   0x00, 0x00, 0x49, 0x45, 0x4E, 0x44, 0xAE, 0x42, 0x60, 0x82,
 };
+#endif
 
 // mic monochrome bitmap (32x32 = 128 bytes)
 static const uint8_t PROGMEM icon_mic_bitmap[] = {
@@ -6712,6 +6902,7 @@ static const uint8_t PROGMEM icon_mic_bitmap[] = {
   0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
 };
 
+#if EMBEDDED_ICONS_PNG
 // mqtt PNG data (800 bytes)
 static const uint8_t PROGMEM icon_mqtt_png[] = {
   0x89, 0x50, 0x4E, 0x47, 0x0D, 0x0A, 0x1A, 0x0A, 0x00, 0x00, 0x00, 0x0D, 0x49, 0x48, 0x44, 0x52,
@@ -6765,6 +6956,7 @@ static const uint8_t PROGMEM icon_mqtt_png[] = {
   0xBF, 0xF7, 0xDB, 0xF2, 0x1F, 0xE0, 0x3F, 0xC0, 0xDF, 0x07, 0xF8, 0x06, 0xF2, 0x28, 0x20, 0xB6,
   0x1D, 0xE7, 0x9C, 0x5D, 0x00, 0x00, 0x00, 0x00, 0x49, 0x45, 0x4E, 0x44, 0xAE, 0x42, 0x60, 0x82,
 };
+#endif
 
 // mqtt monochrome bitmap (32x32 = 128 bytes)
 static const uint8_t PROGMEM icon_mqtt_bitmap[] = {
@@ -6786,6 +6978,7 @@ static const uint8_t PROGMEM icon_mqtt_bitmap[] = {
   0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
 };
 
+#if EMBEDDED_ICONS_PNG
 // web PNG data (1192 bytes)
 static const uint8_t PROGMEM icon_web_png[] = {
   0x89, 0x50, 0x4E, 0x47, 0x0D, 0x0A, 0x1A, 0x0A, 0x00, 0x00, 0x00, 0x0D, 0x49, 0x48, 0x44, 0x52,
@@ -6864,6 +7057,7 @@ static const uint8_t PROGMEM icon_web_png[] = {
   0xF8, 0x65, 0xFC, 0x07, 0x29, 0xF7, 0x45, 0x36, 0x96, 0xC3, 0x2B, 0x0C, 0x00, 0x00, 0x00, 0x00,
   0x49, 0x45, 0x4E, 0x44, 0xAE, 0x42, 0x60, 0x82,
 };
+#endif
 
 // web monochrome bitmap (32x32 = 128 bytes)
 static const uint8_t PROGMEM icon_web_bitmap[] = {
@@ -6885,6 +7079,7 @@ static const uint8_t PROGMEM icon_web_bitmap[] = {
   0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
 };
 
+#if EMBEDDED_ICONS_PNG
 // presence PNG data (830 bytes)
 static const uint8_t PROGMEM icon_presence_png[] = {
   0x89, 0x50, 0x4E, 0x47, 0x0D, 0x0A, 0x1A, 0x0A, 0x00, 0x00, 0x00, 0x0D, 0x49, 0x48, 0x44, 0x52,
@@ -6940,6 +7135,7 @@ static const uint8_t PROGMEM icon_presence_png[] = {
   0xB6, 0xCB, 0xEE, 0x57, 0x32, 0xF8, 0x97, 0x6F, 0xD3, 0x3F, 0xDD, 0x84, 0xCA, 0x9E, 0x78, 0xC4,
   0x68, 0xDD, 0x00, 0x00, 0x00, 0x00, 0x49, 0x45, 0x4E, 0x44, 0xAE, 0x42, 0x60, 0x82,
 };
+#endif
 
 // presence monochrome bitmap (32x32 = 128 bytes)
 static const uint8_t PROGMEM icon_presence_bitmap[] = {
@@ -6961,6 +7157,7 @@ static const uint8_t PROGMEM icon_presence_bitmap[] = {
   0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
 };
 
+#if EMBEDDED_ICONS_PNG
 // rtc PNG data (1118 bytes)
 static const uint8_t PROGMEM icon_rtc_png[] = {
   0x89, 0x50, 0x4E, 0x47, 0x0D, 0x0A, 0x1A, 0x0A, 0x00, 0x00, 0x00, 0x0D, 0x49, 0x48, 0x44, 0x52,
@@ -7034,6 +7231,7 @@ static const uint8_t PROGMEM icon_rtc_png[] = {
   0xA8, 0xE4, 0xB7, 0xA7, 0x6B, 0x0E, 0x7E, 0x59, 0xFE, 0x01, 0xCD, 0x6C, 0x05, 0xE8, 0x0B, 0x5C,
   0x5F, 0x44, 0x00, 0x00, 0x00, 0x00, 0x49, 0x45, 0x4E, 0x44, 0xAE, 0x42, 0x60, 0x82,
 };
+#endif
 
 // rtc monochrome bitmap (32x32 = 128 bytes)
 static const uint8_t PROGMEM icon_rtc_bitmap[] = {
@@ -7055,6 +7253,7 @@ static const uint8_t PROGMEM icon_rtc_bitmap[] = {
   0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
 };
 
+#if EMBEDDED_ICONS_PNG
 // edgeimpulse PNG data (1067 bytes)
 static const uint8_t PROGMEM icon_edgeimpulse_png[] = {
   0x89, 0x50, 0x4E, 0x47, 0x0D, 0x0A, 0x1A, 0x0A, 0x00, 0x00, 0x00, 0x0D, 0x49, 0x48, 0x44, 0x52,
@@ -7125,6 +7324,7 @@ static const uint8_t PROGMEM icon_edgeimpulse_png[] = {
   0x4F, 0xC7, 0x5F, 0x7F, 0x5D, 0xFF, 0x05, 0x60, 0x4F, 0xA4, 0xD6, 0x40, 0x5D, 0x6D, 0x32, 0x00,
   0x00, 0x00, 0x00, 0x49, 0x45, 0x4E, 0x44, 0xAE, 0x42, 0x60, 0x82,
 };
+#endif
 
 // edgeimpulse monochrome bitmap (32x32 = 128 bytes)
 static const uint8_t PROGMEM icon_edgeimpulse_bitmap[] = {
@@ -7146,6 +7346,7 @@ static const uint8_t PROGMEM icon_edgeimpulse_bitmap[] = {
   0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
 };
 
+#if EMBEDDED_ICONS_PNG
 // espsr PNG data (872 bytes)
 static const uint8_t PROGMEM icon_espsr_png[] = {
   0x89, 0x50, 0x4E, 0x47, 0x0D, 0x0A, 0x1A, 0x0A, 0x00, 0x00, 0x00, 0x0D, 0x49, 0x48, 0x44, 0x52,
@@ -7204,6 +7405,7 @@ static const uint8_t PROGMEM icon_espsr_png[] = {
   0xFE, 0x75, 0xFD, 0x0B, 0xB0, 0x44, 0x31, 0x49, 0x2C, 0xBA, 0xCD, 0x4A, 0x00, 0x00, 0x00, 0x00,
   0x49, 0x45, 0x4E, 0x44, 0xAE, 0x42, 0x60, 0x82,
 };
+#endif
 
 // espsr monochrome bitmap (32x32 = 128 bytes)
 static const uint8_t PROGMEM icon_espsr_bitmap[] = {
@@ -7225,6 +7427,7 @@ static const uint8_t PROGMEM icon_espsr_bitmap[] = {
   0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
 };
 
+#if EMBEDDED_ICONS_PNG
 // vol_mute PNG data (720 bytes)
 static const uint8_t PROGMEM icon_vol_mute_png[] = {
   0x89, 0x50, 0x4E, 0x47, 0x0D, 0x0A, 0x1A, 0x0A, 0x00, 0x00, 0x00, 0x0D, 0x49, 0x48, 0x44, 0x52,
@@ -7273,6 +7476,7 @@ static const uint8_t PROGMEM icon_vol_mute_png[] = {
   0xE2, 0x77, 0x1F, 0x16, 0xF8, 0xFB, 0x36, 0xFD, 0xEF, 0x04, 0x7F, 0x00, 0x43, 0xCA, 0x12, 0x59,
   0x17, 0xB2, 0xC6, 0x26, 0x00, 0x00, 0x00, 0x00, 0x49, 0x45, 0x4E, 0x44, 0xAE, 0x42, 0x60, 0x82,
 };
+#endif
 
 // vol_mute monochrome bitmap (32x32 = 128 bytes)
 static const uint8_t PROGMEM icon_vol_mute_bitmap[] = {
@@ -7294,6 +7498,7 @@ static const uint8_t PROGMEM icon_vol_mute_bitmap[] = {
   0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
 };
 
+#if EMBEDDED_ICONS_PNG
 // vol_min PNG data (632 bytes)
 static const uint8_t PROGMEM icon_vol_min_png[] = {
   0x89, 0x50, 0x4E, 0x47, 0x0D, 0x0A, 0x1A, 0x0A, 0x00, 0x00, 0x00, 0x0D, 0x49, 0x48, 0x44, 0x52,
@@ -7337,6 +7542,7 @@ static const uint8_t PROGMEM icon_vol_min_png[] = {
   0xFF, 0x4E, 0xF0, 0x0D, 0x1B, 0xA8, 0x18, 0xDF, 0xD7, 0x88, 0x01, 0xA0, 0x00, 0x00, 0x00, 0x00,
   0x49, 0x45, 0x4E, 0x44, 0xAE, 0x42, 0x60, 0x82,
 };
+#endif
 
 // vol_min monochrome bitmap (32x32 = 128 bytes)
 static const uint8_t PROGMEM icon_vol_min_bitmap[] = {
@@ -7358,6 +7564,7 @@ static const uint8_t PROGMEM icon_vol_min_bitmap[] = {
   0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
 };
 
+#if EMBEDDED_ICONS_PNG
 // speaker PNG data (744 bytes)
 static const uint8_t PROGMEM icon_speaker_png[] = {
   0x89, 0x50, 0x4E, 0x47, 0x0D, 0x0A, 0x1A, 0x0A, 0x00, 0x00, 0x00, 0x0D, 0x49, 0x48, 0x44, 0x52,
@@ -7408,6 +7615,7 @@ static const uint8_t PROGMEM icon_speaker_png[] = {
   0xDF, 0x01, 0x7F, 0x00, 0xA9, 0xC2, 0x32, 0x58, 0xC8, 0xD3, 0x71, 0x8D, 0x00, 0x00, 0x00, 0x00,
   0x49, 0x45, 0x4E, 0x44, 0xAE, 0x42, 0x60, 0x82,
 };
+#endif
 
 // speaker monochrome bitmap (32x32 = 128 bytes)
 static const uint8_t PROGMEM icon_speaker_bitmap[] = {
@@ -7429,6 +7637,7 @@ static const uint8_t PROGMEM icon_speaker_bitmap[] = {
   0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
 };
 
+#if EMBEDDED_ICONS_PNG
 // vol_max PNG data (786 bytes)
 static const uint8_t PROGMEM icon_vol_max_png[] = {
   0x89, 0x50, 0x4E, 0x47, 0x0D, 0x0A, 0x1A, 0x0A, 0x00, 0x00, 0x00, 0x0D, 0x49, 0x48, 0x44, 0x52,
@@ -7482,6 +7691,7 @@ static const uint8_t PROGMEM icon_vol_max_png[] = {
   0x5F, 0x35, 0x03, 0x27, 0xF8, 0xBB, 0x00, 0x00, 0x00, 0x00, 0x49, 0x45, 0x4E, 0x44, 0xAE, 0x42,
   0x60, 0x82,
 };
+#endif
 
 // vol_max monochrome bitmap (32x32 = 128 bytes)
 static const uint8_t PROGMEM icon_vol_max_bitmap[] = {
@@ -7505,122 +7715,111 @@ static const uint8_t PROGMEM icon_vol_max_bitmap[] = {
 
 // Icon registry
 const EmbeddedIcon EMBEDDED_ICONS[] PROGMEM = {
-  {"smiley", icon_smiley_png, 1170, icon_smiley_bitmap, 32, 32},
-  {"frowny", icon_frowny_png, 1149, icon_frowny_bitmap, 32, 32},
-  {"folder", icon_folder_png, 491, icon_folder_bitmap, 32, 32},
-  {"file", icon_file_png, 502, icon_file_bitmap, 32, 32},
-  {"file_text", icon_file_text_png, 553, icon_file_text_bitmap, 32, 32},
-  {"file_code", icon_file_code_png, 955, icon_file_code_bitmap, 32, 32},
-  {"file_image", icon_file_image_png, 863, icon_file_image_bitmap, 32, 32},
-  {"file_zip", icon_file_zip_png, 765, icon_file_zip_bitmap, 32, 32},
-  {"file_json", icon_file_json_png, 873, icon_file_json_bitmap, 32, 32},
-  {"file_pdf", icon_file_pdf_png, 698, icon_file_pdf_bitmap, 32, 32},
-  {"file_bin", icon_file_bin_png, 879, icon_file_bin_bitmap, 32, 32},
-  {"sdcard", icon_sdcard_png, 1004, icon_sdcard_bitmap, 32, 32},
-  {"trash", icon_trash_png, 702, icon_trash_bitmap, 32, 32},
-  {"save", icon_save_png, 801, icon_save_bitmap, 32, 32},
-  {"edit", icon_edit_png, 448, icon_edit_bitmap, 32, 32},
-  {"wifi_0", icon_wifi_0_png, 326, icon_wifi_0_bitmap, 32, 32},
-  {"wifi_1", icon_wifi_1_png, 499, icon_wifi_1_bitmap, 32, 32},
-  {"wifi_2", icon_wifi_2_png, 719, icon_wifi_2_bitmap, 32, 32},
-  {"wifi_3", icon_wifi_3_png, 977, icon_wifi_3_bitmap, 32, 32},
-  {"wifi_off", icon_wifi_off_png, 863, icon_wifi_off_bitmap, 32, 32},
-  {"bt_off", icon_bt_off_png, 829, icon_bt_off_bitmap, 32, 32},
-  {"bt_idle", icon_bt_idle_png, 618, icon_bt_idle_bitmap, 32, 32},
-  {"bt_advertising", icon_bt_advertising_png, 903, icon_bt_advertising_bitmap, 32, 32},
-  {"bt_connected", icon_bt_connected_png, 1011, icon_bt_connected_bitmap, 32, 32},
-  {"notify_espnow", icon_notify_espnow_png, 673, icon_notify_espnow_bitmap, 32, 32},
-  {"notify_server", icon_notify_server_png, 505, icon_notify_server_bitmap, 32, 32},
-  {"radio", icon_radio_png, 982, icon_radio_bitmap, 32, 32},
-  {"upload", icon_upload_png, 581, icon_upload_bitmap, 32, 32},
-  {"download", icon_download_png, 610, icon_download_bitmap, 32, 32},
-  {"refresh", icon_refresh_png, 868, icon_refresh_bitmap, 32, 32},
-  {"battery_0", icon_battery_0_png, 519, icon_battery_0_bitmap, 32, 32},
-  {"battery_25", icon_battery_25_png, 547, icon_battery_25_bitmap, 32, 32},
-  {"battery_50", icon_battery_50_png, 542, icon_battery_50_bitmap, 32, 32},
-  {"battery_75", icon_battery_75_png, 526, icon_battery_75_bitmap, 32, 32},
-  {"battery_100", icon_battery_100_png, 435, icon_battery_100_bitmap, 32, 32},
-  {"battery_charging", icon_battery_charging_png, 846, icon_battery_charging_bitmap, 32, 32},
-  {"battery_full", icon_battery_full_png, 435, icon_battery_full_bitmap, 32, 32},
-  {"memory", icon_memory_png, 860, icon_memory_bitmap, 32, 32},
-  {"device", icon_device_png, 756, icon_device_bitmap, 32, 32},
-  {"terminal", icon_terminal_png, 795, icon_terminal_bitmap, 32, 32},
-  {"settings", icon_settings_png, 906, icon_settings_bitmap, 32, 32},
-  {"led", icon_led_png, 801, icon_led_bitmap, 32, 32},
-  {"sun", icon_sun_png, 824, icon_sun_bitmap, 32, 32},
-  {"moon", icon_moon_png, 701, icon_moon_bitmap, 32, 32},
-  {"arrow_left", icon_arrow_left_png, 545, icon_arrow_left_bitmap, 32, 32},
-  {"arrow_right", icon_arrow_right_png, 490, icon_arrow_right_bitmap, 32, 32},
-  {"arrow_up", icon_arrow_up_png, 444, icon_arrow_up_bitmap, 32, 32},
-  {"arrow_down", icon_arrow_down_png, 479, icon_arrow_down_bitmap, 32, 32},
-  {"chevron_left", icon_chevron_left_png, 387, icon_chevron_left_bitmap, 32, 32},
-  {"chevron_right", icon_chevron_right_png, 391, icon_chevron_right_bitmap, 32, 32},
-  {"plus", icon_plus_png, 463, icon_plus_bitmap, 32, 32},
-  {"minus", icon_minus_png, 248, icon_minus_bitmap, 32, 32},
-  {"check", icon_check_png, 567, icon_check_bitmap, 32, 32},
-  {"close", icon_close_png, 512, icon_close_bitmap, 32, 32},
-  {"menu", icon_menu_png, 232, icon_menu_bitmap, 32, 32},
-  {"search", icon_search_png, 780, icon_search_bitmap, 32, 32},
-  {"home", icon_home_png, 725, icon_home_bitmap, 32, 32},
-  {"back", icon_back_png, 545, icon_back_bitmap, 32, 32},
-  {"info", icon_info_png, 1094, icon_info_bitmap, 32, 32},
-  {"warning", icon_warning_png, 886, icon_warning_bitmap, 32, 32},
-  {"lock", icon_lock_png, 847, icon_lock_bitmap, 32, 32},
-  {"unlock", icon_unlock_png, 847, icon_unlock_bitmap, 32, 32},
-  {"user", icon_user_png, 626, icon_user_bitmap, 32, 32},
-  {"notify_bell", icon_notify_bell_png, 723, icon_notify_bell_bitmap, 32, 32},
-  {"notify_automation", icon_notify_automation_png, 1121, icon_notify_automation_bitmap, 32, 32},
-  {"notify_sensor", icon_notify_sensor_png, 963, icon_notify_sensor_bitmap, 32, 32},
-  {"notify_logging", icon_notify_logging_png, 559, icon_notify_logging_bitmap, 32, 32},
-  {"notify_files", icon_notify_files_png, 585, icon_notify_files_bitmap, 32, 32},
-  {"notify_system", icon_notify_system_png, 832, icon_notify_system_bitmap, 32, 32},
-  {"notify_cli", icon_notify_cli_png, 756, icon_notify_cli_bitmap, 32, 32},
-  {"compass", icon_compass_png, 1211, icon_compass_bitmap, 32, 32},
-  {"imu_axes", icon_imu_axes_png, 772, icon_imu_axes_bitmap, 32, 32},
-  {"thermal", icon_thermal_png, 820, icon_thermal_bitmap, 32, 32},
-  {"tof_radar", icon_tof_radar_png, 921, icon_tof_radar_bitmap, 32, 32},
-  {"smartphone", icon_smartphone_png, 574, icon_smartphone_bitmap, 32, 32},
-  {"laptop", icon_laptop_png, 504, icon_laptop_bitmap, 32, 32},
-  {"watch", icon_watch_png, 941, icon_watch_bitmap, 32, 32},
-  {"headphones", icon_headphones_png, 744, icon_headphones_bitmap, 32, 32},
-  {"smart_glasses", icon_smart_glasses_png, 713, icon_smart_glasses_bitmap, 32, 32},
-  {"gamepad", icon_gamepad_png, 784, icon_gamepad_bitmap, 32, 32},
-  {"gesture", icon_gesture_png, 1030, icon_gesture_bitmap, 32, 32},
-  {"clock", icon_clock_png, 1118, icon_clock_bitmap, 32, 32},
-  {"pair_link", icon_pair_link_png, 899, icon_pair_link_bitmap, 32, 32},
-  {"pair_link_off", icon_pair_link_off_png, 955, icon_pair_link_off_bitmap, 32, 32},
-  {"pair_sync", icon_pair_sync_png, 843, icon_pair_sync_bitmap, 32, 32},
-  {"pair_search", icon_pair_search_png, 797, icon_pair_search_bitmap, 32, 32},
-  {"help", icon_help_png, 1155, icon_help_bitmap, 32, 32},
-  {"debug", icon_debug_png, 622, icon_debug_bitmap, 32, 32},
-  {"power", icon_power_png, 921, icon_power_bitmap, 32, 32},
-  {"notify_display", icon_notify_display_png, 747, icon_notify_display_bitmap, 32, 32},
-  {"neopixel", icon_neopixel_png, 843, icon_neopixel_bitmap, 32, 32},
-  {"servo", icon_servo_png, 841, icon_servo_bitmap, 32, 32},
-  {"camera", icon_camera_png, 938, icon_camera_bitmap, 32, 32},
-  {"microphone", icon_microphone_png, 762, icon_microphone_bitmap, 32, 32},
-  {"mic", icon_mic_png, 762, icon_mic_bitmap, 32, 32},
-  {"mqtt", icon_mqtt_png, 800, icon_mqtt_bitmap, 32, 32},
-  {"web", icon_web_png, 1192, icon_web_bitmap, 32, 32},
-  {"presence", icon_presence_png, 830, icon_presence_bitmap, 32, 32},
-  {"rtc", icon_rtc_png, 1118, icon_rtc_bitmap, 32, 32},
-  {"edgeimpulse", icon_edgeimpulse_png, 1067, icon_edgeimpulse_bitmap, 32, 32},
-  {"espsr", icon_espsr_png, 872, icon_espsr_bitmap, 32, 32},
-  {"vol_mute", icon_vol_mute_png, 720, icon_vol_mute_bitmap, 32, 32},
-  {"vol_min", icon_vol_min_png, 632, icon_vol_min_bitmap, 32, 32},
-  {"speaker", icon_speaker_png, 744, icon_speaker_bitmap, 32, 32},
-  {"vol_max", icon_vol_max_png, 786, icon_vol_max_bitmap, 32, 32},
+  {"smiley", ICON_PNG(icon_smiley_png, 1170), icon_smiley_bitmap, 32, 32},
+  {"frowny", ICON_PNG(icon_frowny_png, 1149), icon_frowny_bitmap, 32, 32},
+  {"folder", ICON_PNG(icon_folder_png, 491), icon_folder_bitmap, 32, 32},
+  {"file", ICON_PNG(icon_file_png, 502), icon_file_bitmap, 32, 32},
+  {"file_text", ICON_PNG(icon_file_text_png, 553), icon_file_text_bitmap, 32, 32},
+  {"file_code", ICON_PNG(icon_file_code_png, 955), icon_file_code_bitmap, 32, 32},
+  {"file_image", ICON_PNG(icon_file_image_png, 863), icon_file_image_bitmap, 32, 32},
+  {"file_zip", ICON_PNG(icon_file_zip_png, 765), icon_file_zip_bitmap, 32, 32},
+  {"file_json", ICON_PNG(icon_file_json_png, 873), icon_file_json_bitmap, 32, 32},
+  {"file_pdf", ICON_PNG(icon_file_pdf_png, 698), icon_file_pdf_bitmap, 32, 32},
+  {"file_bin", ICON_PNG(icon_file_bin_png, 879), icon_file_bin_bitmap, 32, 32},
+  {"sdcard", ICON_PNG(icon_sdcard_png, 1004), icon_sdcard_bitmap, 32, 32},
+  {"trash", ICON_PNG(icon_trash_png, 702), icon_trash_bitmap, 32, 32},
+  {"save", ICON_PNG(icon_save_png, 801), icon_save_bitmap, 32, 32},
+  {"edit", ICON_PNG(icon_edit_png, 448), icon_edit_bitmap, 32, 32},
+  {"wifi_0", ICON_PNG(icon_wifi_0_png, 326), icon_wifi_0_bitmap, 32, 32},
+  {"wifi_1", ICON_PNG(icon_wifi_1_png, 499), icon_wifi_1_bitmap, 32, 32},
+  {"wifi_2", ICON_PNG(icon_wifi_2_png, 719), icon_wifi_2_bitmap, 32, 32},
+  {"wifi_3", ICON_PNG(icon_wifi_3_png, 977), icon_wifi_3_bitmap, 32, 32},
+  {"wifi_off", ICON_PNG(icon_wifi_off_png, 863), icon_wifi_off_bitmap, 32, 32},
+  {"bt_off", ICON_PNG(icon_bt_off_png, 829), icon_bt_off_bitmap, 32, 32},
+  {"bt_idle", ICON_PNG(icon_bt_idle_png, 618), icon_bt_idle_bitmap, 32, 32},
+  {"bt_advertising", ICON_PNG(icon_bt_advertising_png, 903), icon_bt_advertising_bitmap, 32, 32},
+  {"bt_connected", ICON_PNG(icon_bt_connected_png, 1011), icon_bt_connected_bitmap, 32, 32},
+  {"notify_espnow", ICON_PNG(icon_notify_espnow_png, 673), icon_notify_espnow_bitmap, 32, 32},
+  {"notify_server", ICON_PNG(icon_notify_server_png, 505), icon_notify_server_bitmap, 32, 32},
+  {"radio", ICON_PNG(icon_radio_png, 982), icon_radio_bitmap, 32, 32},
+  {"upload", ICON_PNG(icon_upload_png, 581), icon_upload_bitmap, 32, 32},
+  {"download", ICON_PNG(icon_download_png, 610), icon_download_bitmap, 32, 32},
+  {"refresh", ICON_PNG(icon_refresh_png, 868), icon_refresh_bitmap, 32, 32},
+  {"battery_0", ICON_PNG(icon_battery_0_png, 519), icon_battery_0_bitmap, 32, 32},
+  {"battery_25", ICON_PNG(icon_battery_25_png, 547), icon_battery_25_bitmap, 32, 32},
+  {"battery_50", ICON_PNG(icon_battery_50_png, 542), icon_battery_50_bitmap, 32, 32},
+  {"battery_75", ICON_PNG(icon_battery_75_png, 526), icon_battery_75_bitmap, 32, 32},
+  {"battery_100", ICON_PNG(icon_battery_100_png, 435), icon_battery_100_bitmap, 32, 32},
+  {"battery_charging", ICON_PNG(icon_battery_charging_png, 846), icon_battery_charging_bitmap, 32, 32},
+  {"battery_full", ICON_PNG(icon_battery_full_png, 435), icon_battery_full_bitmap, 32, 32},
+  {"memory", ICON_PNG(icon_memory_png, 860), icon_memory_bitmap, 32, 32},
+  {"device", ICON_PNG(icon_device_png, 756), icon_device_bitmap, 32, 32},
+  {"terminal", ICON_PNG(icon_terminal_png, 795), icon_terminal_bitmap, 32, 32},
+  {"settings", ICON_PNG(icon_settings_png, 906), icon_settings_bitmap, 32, 32},
+  {"led", ICON_PNG(icon_led_png, 801), icon_led_bitmap, 32, 32},
+  {"sun", ICON_PNG(icon_sun_png, 824), icon_sun_bitmap, 32, 32},
+  {"moon", ICON_PNG(icon_moon_png, 701), icon_moon_bitmap, 32, 32},
+  {"arrow_left", ICON_PNG(icon_arrow_left_png, 545), icon_arrow_left_bitmap, 32, 32},
+  {"arrow_right", ICON_PNG(icon_arrow_right_png, 490), icon_arrow_right_bitmap, 32, 32},
+  {"arrow_up", ICON_PNG(icon_arrow_up_png, 444), icon_arrow_up_bitmap, 32, 32},
+  {"arrow_down", ICON_PNG(icon_arrow_down_png, 479), icon_arrow_down_bitmap, 32, 32},
+  {"chevron_left", ICON_PNG(icon_chevron_left_png, 387), icon_chevron_left_bitmap, 32, 32},
+  {"chevron_right", ICON_PNG(icon_chevron_right_png, 391), icon_chevron_right_bitmap, 32, 32},
+  {"plus", ICON_PNG(icon_plus_png, 463), icon_plus_bitmap, 32, 32},
+  {"minus", ICON_PNG(icon_minus_png, 248), icon_minus_bitmap, 32, 32},
+  {"check", ICON_PNG(icon_check_png, 567), icon_check_bitmap, 32, 32},
+  {"close", ICON_PNG(icon_close_png, 512), icon_close_bitmap, 32, 32},
+  {"menu", ICON_PNG(icon_menu_png, 232), icon_menu_bitmap, 32, 32},
+  {"search", ICON_PNG(icon_search_png, 780), icon_search_bitmap, 32, 32},
+  {"home", ICON_PNG(icon_home_png, 725), icon_home_bitmap, 32, 32},
+  {"back", ICON_PNG(icon_back_png, 545), icon_back_bitmap, 32, 32},
+  {"info", ICON_PNG(icon_info_png, 1094), icon_info_bitmap, 32, 32},
+  {"warning", ICON_PNG(icon_warning_png, 886), icon_warning_bitmap, 32, 32},
+  {"lock", ICON_PNG(icon_lock_png, 847), icon_lock_bitmap, 32, 32},
+  {"unlock", ICON_PNG(icon_unlock_png, 847), icon_unlock_bitmap, 32, 32},
+  {"user", ICON_PNG(icon_user_png, 626), icon_user_bitmap, 32, 32},
+  {"notify_bell", ICON_PNG(icon_notify_bell_png, 723), icon_notify_bell_bitmap, 32, 32},
+  {"notify_automation", ICON_PNG(icon_notify_automation_png, 1121), icon_notify_automation_bitmap, 32, 32},
+  {"notify_sensor", ICON_PNG(icon_notify_sensor_png, 963), icon_notify_sensor_bitmap, 32, 32},
+  {"notify_logging", ICON_PNG(icon_notify_logging_png, 559), icon_notify_logging_bitmap, 32, 32},
+  {"notify_files", ICON_PNG(icon_notify_files_png, 585), icon_notify_files_bitmap, 32, 32},
+  {"notify_system", ICON_PNG(icon_notify_system_png, 832), icon_notify_system_bitmap, 32, 32},
+  {"notify_cli", ICON_PNG(icon_notify_cli_png, 756), icon_notify_cli_bitmap, 32, 32},
+  {"compass", ICON_PNG(icon_compass_png, 1211), icon_compass_bitmap, 32, 32},
+  {"imu_axes", ICON_PNG(icon_imu_axes_png, 772), icon_imu_axes_bitmap, 32, 32},
+  {"thermal", ICON_PNG(icon_thermal_png, 820), icon_thermal_bitmap, 32, 32},
+  {"tof_radar", ICON_PNG(icon_tof_radar_png, 921), icon_tof_radar_bitmap, 32, 32},
+  {"smartphone", ICON_PNG(icon_smartphone_png, 574), icon_smartphone_bitmap, 32, 32},
+  {"laptop", ICON_PNG(icon_laptop_png, 504), icon_laptop_bitmap, 32, 32},
+  {"watch", ICON_PNG(icon_watch_png, 941), icon_watch_bitmap, 32, 32},
+  {"headphones", ICON_PNG(icon_headphones_png, 744), icon_headphones_bitmap, 32, 32},
+  {"smart_glasses", ICON_PNG(icon_smart_glasses_png, 713), icon_smart_glasses_bitmap, 32, 32},
+  {"gamepad", ICON_PNG(icon_gamepad_png, 784), icon_gamepad_bitmap, 32, 32},
+  {"gesture", ICON_PNG(icon_gesture_png, 1030), icon_gesture_bitmap, 32, 32},
+  {"clock", ICON_PNG(icon_clock_png, 1118), icon_clock_bitmap, 32, 32},
+  {"pair_link", ICON_PNG(icon_pair_link_png, 899), icon_pair_link_bitmap, 32, 32},
+  {"pair_link_off", ICON_PNG(icon_pair_link_off_png, 955), icon_pair_link_off_bitmap, 32, 32},
+  {"pair_sync", ICON_PNG(icon_pair_sync_png, 843), icon_pair_sync_bitmap, 32, 32},
+  {"pair_search", ICON_PNG(icon_pair_search_png, 797), icon_pair_search_bitmap, 32, 32},
+  {"help", ICON_PNG(icon_help_png, 1155), icon_help_bitmap, 32, 32},
+  {"debug", ICON_PNG(icon_debug_png, 622), icon_debug_bitmap, 32, 32},
+  {"power", ICON_PNG(icon_power_png, 921), icon_power_bitmap, 32, 32},
+  {"notify_display", ICON_PNG(icon_notify_display_png, 747), icon_notify_display_bitmap, 32, 32},
+  {"neopixel", ICON_PNG(icon_neopixel_png, 843), icon_neopixel_bitmap, 32, 32},
+  {"servo", ICON_PNG(icon_servo_png, 841), icon_servo_bitmap, 32, 32},
+  {"camera", ICON_PNG(icon_camera_png, 938), icon_camera_bitmap, 32, 32},
+  {"microphone", ICON_PNG(icon_microphone_png, 762), icon_microphone_bitmap, 32, 32},
+  {"mic", ICON_PNG(icon_mic_png, 762), icon_mic_bitmap, 32, 32},
+  {"mqtt", ICON_PNG(icon_mqtt_png, 800), icon_mqtt_bitmap, 32, 32},
+  {"web", ICON_PNG(icon_web_png, 1192), icon_web_bitmap, 32, 32},
+  {"presence", ICON_PNG(icon_presence_png, 830), icon_presence_bitmap, 32, 32},
+  {"rtc", ICON_PNG(icon_rtc_png, 1118), icon_rtc_bitmap, 32, 32},
+  {"edgeimpulse", ICON_PNG(icon_edgeimpulse_png, 1067), icon_edgeimpulse_bitmap, 32, 32},
+  {"espsr", ICON_PNG(icon_espsr_png, 872), icon_espsr_bitmap, 32, 32},
+  {"vol_mute", ICON_PNG(icon_vol_mute_png, 720), icon_vol_mute_bitmap, 32, 32},
+  {"vol_min", ICON_PNG(icon_vol_min_png, 632), icon_vol_min_bitmap, 32, 32},
+  {"speaker", ICON_PNG(icon_speaker_png, 744), icon_speaker_bitmap, 32, 32},
+  {"vol_max", ICON_PNG(icon_vol_max_png, 786), icon_vol_max_bitmap, 32, 32},
 };
 
 const size_t EMBEDDED_ICONS_COUNT = 105;
-
-const EmbeddedIcon* findEmbeddedIcon(const char* name) {
-  for (size_t i = 0; i < EMBEDDED_ICONS_COUNT; i++) {
-    char iconName[32];
-    strcpy_P(iconName, (PGM_P)pgm_read_ptr(&EMBEDDED_ICONS[i].name));
-    if (strcmp(iconName, name) == 0) {
-      return &EMBEDDED_ICONS[i];
-    }
-  }
-  return nullptr;
-}
@@ -2,12 +2,25 @@
 #define ICONS_EMBEDDED_H
 
 #include <Arduino.h>
+#include "System_BuildConfig.h"
+
+// PNG copies are only ever served by the web UI (/api/icon); display builds
+// draw from the 1-bpp bitmaps and leave the PNG arrays out of flash.
+#ifndef EMBEDDED_ICONS_PNG
+  #define EMBEDDED_ICONS_PNG ENABLE_HTTP_SERVER
+#endif
+
+#if EMBEDDED_ICONS_PNG
+  #define ICON_PNG(data, size) data, size
+#else
+  #define ICON_PNG(data, size) nullptr, 0
+#endif
 
 struct EmbeddedIcon {
   const char* name;
-  const uint8_t* pngData;
+  const uint8_t* pngData;   // nullptr when EMBEDDED_ICONS_PNG is 0
   size_t pngSize;
-  const uint8_t* bitmapData;
+  const uint8_t* bitmapData;  // width x height, 1 bpp, row-major, LSB = leftmost pixel
   uint8_t width;
   uint8_t height;
 };
@@ -15,6 +28,15 @@ struct EmbeddedIcon {
 extern const EmbeddedIcon EMBEDDED_ICONS[];
 extern const size_t EMBEDDED_ICONS_COUNT;
 
+// Hashed name lookup (first entry wins on duplicate names)
 const EmbeddedIcon* findEmbeddedIcon(const char* name);
 
+// Packed 1-bpp raster of an icon at size x size pixels in Adafruit drawBitmap
+// layout (MSB = leftmost, rows padded to whole bytes). Rasters are built on
+// first use with the same sampling drawIconScaled() always used and kept in a
+// small cache, so steady-state drawing is a single drawBitmap() call.
+// size must be 1..ICON_ATLAS_MAX_SIZE; returns nullptr if unavailable.
+#define ICON_ATLAS_MAX_SIZE  32
+const uint8_t* embeddedIconRaster(const EmbeddedIcon* icon, uint8_t size);
+
 #endif
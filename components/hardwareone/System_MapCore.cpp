@@ -0,0 +1,4746 @@
+#include <LittleFS.h>
+#include <ArduinoJson.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+#include <cstring>
+#include <algorithm>
+
+#include "System_Maps.h"
+#include "System_BuildConfig.h"
+#include "System_Debug.h"
+#include "System_MemUtil.h"
+#include "System_Mutex.h"
+
+// =============================================================================
+// MapCore Static Member (works without GPS)
+// =============================================================================
+
+LoadedMap MapCore::_currentMap = {};
+uint32_t MapCore::_mapGeneration = 0;
+LocationContext LocationContextManager::_context = {"", 0, MAP_FEATURE_HIGHWAY, "", 0, MAP_FEATURE_PARK, 0, 0, 0, false};
+
+float gMapRotation = 0.0f;  // Rotation angle in degrees
+
+// Center position for map viewing without GPS
+float gMapCenterLat = 0.0f;
+float gMapCenterLon = 0.0f;
+bool gMapCenterSet = false;  // Non-static for external access from file browser
+bool gMapManuallyPanned = false;  // Track if user has manually moved the map
+
+// Momentum-based scrolling for smoother panning
+float gMapVelocityLat = 0.0f;
+float gMapVelocityLon = 0.0f;
+float gMapRotationVelocity = 0.0f;  // For smooth rotation
+unsigned long gMapLastMomentumUpdate = 0;
+
+// Zoom level (1.0 = default, higher = zoomed in)
+float gMapZoom = 1.0f;
+
+// =============================================================================
+// Map Feature Highlighting System
+// =============================================================================
+
+MapHighlight gMapHighlight = {HIGHLIGHT_NONE, "", 0, false, 300, 0, false};
+
+void mapHighlightClear() {
+  MapCacheGuard cacheGuard("mapHighlight");
+  gMapHighlight.mode = HIGHLIGHT_NONE;
+  gMapHighlight.name[0] = '\0';
+  gMapHighlight.active = false;
+}
+
+void mapHighlightByName(const char* name, bool prefixMatch, uint32_t blinkMs) {
+  MapCacheGuard cacheGuard("mapHighlight");
+  gMapHighlight.mode = HIGHLIGHT_BY_NAME;
+  strncpy(gMapHighlight.name, name, sizeof(gMapHighlight.name) - 1);
+  gMapHighlight.name[sizeof(gMapHighlight.name) - 1] = '\0';
+  gMapHighlight.prefixMatch = prefixMatch;
+  gMapHighlight.blinkIntervalMs = blinkMs;
+  gMapHighlight.startTime = millis();
+  gMapHighlight.active = true;
+}
+
+void mapHighlightByType(uint8_t featureType, uint32_t blinkMs) {
+  MapCacheGuard cacheGuard("mapHighlight");
+  gMapHighlight.mode = HIGHLIGHT_BY_TYPE;
+  gMapHighlight.featureType = featureType;
+  gMapHighlight.blinkIntervalMs = blinkMs;
+  gMapHighlight.startTime = millis();
+  gMapHighlight.active = true;
+}
+
+void mapHighlightByNameAndType(const char* name, uint8_t featureType, uint32_t blinkMs) {
+  MapCacheGuard cacheGuard("mapHighlight");
+  gMapHighlight.mode = HIGHLIGHT_BY_NAME_AND_TYPE;
+  strncpy(gMapHighlight.name, name, sizeof(gMapHighlight.name) - 1);
+  gMapHighlight.name[sizeof(gMapHighlight.name) - 1] = '\0';
+  gMapHighlight.featureType = featureType;
+  gMapHighlight.prefixMatch = false;
+  gMapHighlight.blinkIntervalMs = blinkMs;
+  gMapHighlight.startTime = millis();
+  gMapHighlight.active = true;
+}
+
+void mapHighlightRoute(uint32_t blinkMs) {
+  MapCacheGuard cacheGuard("mapHighlight");
+  gMapHighlight.mode = HIGHLIGHT_ROUTE;
+  gMapHighlight.name[0] = '\0';
+  gMapHighlight.blinkIntervalMs = blinkMs;
+  gMapHighlight.startTime = millis();
+  gMapHighlight.active = true;
+}
+
+bool mapHighlightMatches(uint16_t nameIndex, uint8_t featureType) {
+  if (!gMapHighlight.active || gMapHighlight.mode == HIGHLIGHT_NONE) return false;
+  if (gMapHighlight.mode == HIGHLIGHT_ROUTE) return false;  // Drawn separately by renderMap
+  
+  bool typeMatches = (gMapHighlight.featureType == featureType);
+  bool nameMatches = false;
+  
+  if (gMapHighlight.mode == HIGHLIGHT_BY_TYPE) {
+    return typeMatches;
+  }
+  
+  // Check name match
+  if (nameIndex != HWMAP_NO_NAME) {
+    const char* featureName = MapCore::getName(nameIndex);
+    if (featureName) {
+      if (gMapHighlight.prefixMatch) {
+        nameMatches = (strncmp(featureName, gMapHighlight.name, strlen(gMapHighlight.name)) == 0);
+      } else {
+        nameMatches = (strcmp(featureName, gMapHighlight.name) == 0);
+      }
+    }
+  }
+  
+  if (gMapHighlight.mode == HIGHLIGHT_BY_NAME) {
+    return nameMatches;
+  }
+  
+  // HIGHLIGHT_BY_NAME_AND_TYPE
+  return nameMatches && typeMatches;
+}
+
+bool mapHighlightIsVisible() {
+  if (!gMapHighlight.active) return false;
+  if (gMapHighlight.blinkIntervalMs == 0) return true;  // Solid highlight
+  
+  // Blink: alternate on/off based on time
+  uint32_t elapsed = millis() - gMapHighlight.startTime;
+  return ((elapsed / gMapHighlight.blinkIntervalMs) % 2) == 0;
+}
+
+// =============================================================================
+// Layer Visibility System
+// =============================================================================
+
+static uint16_t gVisibleLayers = LAYER_ALL;  // All layers visible by default
+
+// Per-subtype visibility bitmask: bit N = subtype N is visible.
+// Indexed directly by MapFeatureType value. Max value is 0x40=64, so 65 bytes.
+// All bits 1 = all subtypes visible (default).
+static uint8_t gSubtypeVisibility[65];
+static bool gSubtypeVisibilityInited = false;
+
+static void ensureSubtypeVisibilityInited() {
+  if (!gSubtypeVisibilityInited) {
+    memset(gSubtypeVisibility, 0xFF, sizeof(gSubtypeVisibility));
+    gSubtypeVisibilityInited = true;
+  }
+}
+
+uint16_t mapLayersGetVisible() {
+  return gVisibleLayers;
+}
+
+void mapLayersSetVisible(uint16_t layers) {
+  gVisibleLayers = layers;
+}
+
+void mapLayerToggle(uint16_t layer) {
+  gVisibleLayers ^= layer;
+}
+
+bool mapSubtypeIsVisible(uint8_t featureType, uint8_t subtype) {
+  ensureSubtypeVisibilityInited();
+  if (featureType > 64 || subtype > 7) return true;
+  return (gSubtypeVisibility[featureType] >> subtype) & 1;
+}
+
+void mapSubtypeToggle(uint8_t featureType, uint8_t subtype) {
+  ensureSubtypeVisibilityInited();
+  if (featureType <= 64 && subtype <= 7) gSubtypeVisibility[featureType] ^= (1 << subtype);
+}
+
+uint8_t mapSubtypeGetMask(uint8_t featureType) {
+  ensureSubtypeVisibilityInited();
+  if (featureType > 64) return 0xFF;
+  return gSubtypeVisibility[featureType];
+}
+
+void mapSubtypeSetMask(uint8_t featureType, uint8_t mask) {
+  ensureSubtypeVisibilityInited();
+  if (featureType <= 64) gSubtypeVisibility[featureType] = mask;
+}
+
+bool mapLayerIsVisible(uint8_t featureType) {
+  switch (featureType) {
+    case MAP_FEATURE_HIGHWAY:  return (gVisibleLayers & LAYER_HIGHWAYS) != 0;
+    case MAP_FEATURE_ROAD_MAJOR: return (gVisibleLayers & LAYER_MAJOR) != 0;
+    case MAP_FEATURE_ROAD_MINOR: return (gVisibleLayers & LAYER_MINOR) != 0;
+    case MAP_FEATURE_PATH:     return (gVisibleLayers & LAYER_PATHS) != 0;
+    case MAP_FEATURE_WATER:    return (gVisibleLayers & LAYER_WATER) != 0;
+    case MAP_FEATURE_PARK:     return (gVisibleLayers & LAYER_PARKS) != 0;
+    case MAP_FEATURE_LAND_MASK: return (gVisibleLayers & LAYER_LAND_MASK) != 0;
+    case MAP_FEATURE_RAILWAY:  return (gVisibleLayers & LAYER_RAILWAYS) != 0;
+    case MAP_FEATURE_BUS:      return (gVisibleLayers & LAYER_TRANSIT) != 0;
+    case MAP_FEATURE_FERRY:    return (gVisibleLayers & LAYER_TRANSIT) != 0;
+    case MAP_FEATURE_BUILDING: return (gVisibleLayers & LAYER_BUILDINGS) != 0;
+    case MAP_FEATURE_STATION:  return (gVisibleLayers & LAYER_TRANSIT) != 0;
+    default: return true;
+  }
+}
+
+// Build a MapRenderParams snapshot from current global state
+MapRenderParams mapRenderParamsFromGlobals() {
+  ensureSubtypeVisibilityInited();
+  MapRenderParams p;
+  p.zoom = gMapZoom;
+  p.rotation = gMapRotation;
+  p.visibleLayers = gVisibleLayers;
+  memcpy(p.subtypeVisibility, gSubtypeVisibility, sizeof(p.subtypeVisibility));
+  p.liveOverlays = true;
+  return p;
+}
+
+// Static helpers: check visibility against a MapRenderParams (no global reads)
+static bool paramLayerIsVisible(const MapRenderParams& p, uint8_t featureType) {
+  switch (featureType) {
+    case MAP_FEATURE_HIGHWAY:    return (p.visibleLayers & LAYER_HIGHWAYS) != 0;
+    case MAP_FEATURE_ROAD_MAJOR: return (p.visibleLayers & LAYER_MAJOR) != 0;
+    case MAP_FEATURE_ROAD_MINOR: return (p.visibleLayers & LAYER_MINOR) != 0;
+    case MAP_FEATURE_PATH:       return (p.visibleLayers & LAYER_PATHS) != 0;
+    case MAP_FEATURE_WATER:      return (p.visibleLayers & LAYER_WATER) != 0;
+    case MAP_FEATURE_PARK:       return (p.visibleLayers & LAYER_PARKS) != 0;
+    case MAP_FEATURE_LAND_MASK:  return (p.visibleLayers & LAYER_LAND_MASK) != 0;
+    case MAP_FEATURE_RAILWAY:    return (p.visibleLayers & LAYER_RAILWAYS) != 0;
+    case MAP_FEATURE_BUS:        return (p.visibleLayers & LAYER_TRANSIT) != 0;
+    case MAP_FEATURE_FERRY:      return (p.visibleLayers & LAYER_TRANSIT) != 0;
+    case MAP_FEATURE_BUILDING:   return (p.visibleLayers & LAYER_BUILDINGS) != 0;
+    case MAP_FEATURE_STATION:    return (p.visibleLayers & LAYER_TRANSIT) != 0;
+    default: return true;
+  }
+}
+
+static bool paramSubtypeIsVisible(const MapRenderParams& p, uint8_t featureType, uint8_t subtype) {
+  if (featureType > 64 || subtype > 7) return true;
+  return (p.subtypeVisibility[featureType] >> subtype) & 1;
+}
+
+// Type-level LOD: progressively hide feature types at lower zoom levels
+static bool lodTypeIsVisible(uint8_t ftype, float zoom) {
+  if (zoom < LOD_ZOOM_MAJOR_ROAD) {
+    // Very far out: only highways
+    if (ftype != MAP_FEATURE_HIGHWAY) return false;
+  } else if (zoom < LOD_ZOOM_WATER) {
+    // Far out: hide everything except highways + major roads
+    if (ftype != MAP_FEATURE_HIGHWAY && ftype != MAP_FEATURE_ROAD_MAJOR) return false;
+  } else if (zoom < LOD_ZOOM_MINOR_ROAD) {
+    // Hide minor roads, paths, buildings, parks, transit
+    if (ftype == MAP_FEATURE_ROAD_MINOR || ftype == MAP_FEATURE_PATH ||
+        ftype == MAP_FEATURE_BUILDING || ftype == MAP_FEATURE_PARK ||
+        ftype == MAP_FEATURE_BUS || ftype == MAP_FEATURE_STATION) return false;
+  } else if (zoom < LOD_ZOOM_PATH) {
+    if (ftype == MAP_FEATURE_PATH) return false;
+  }
+  // Buildings: only show when zoomed in enough to avoid blob effect
+  if (ftype == MAP_FEATURE_BUILDING && zoom < LOD_ZOOM_BUILDING) return false;
+  return true;
+}
+
+// HWMAP_FTYPE_* bit for a feature type
+static uint16_t featureTypeBit(uint8_t ftype) {
+  switch (ftype) {
+    case MAP_FEATURE_HIGHWAY:    return HWMAP_FTYPE_HIGHWAY;
+    case MAP_FEATURE_ROAD_MAJOR: return HWMAP_FTYPE_MAJOR;
+    case MAP_FEATURE_ROAD_MINOR: return HWMAP_FTYPE_MINOR;
+    case MAP_FEATURE_PATH:       return HWMAP_FTYPE_PATH;
+    case MAP_FEATURE_WATER:      return HWMAP_FTYPE_WATER;
+    case MAP_FEATURE_PARK:       return HWMAP_FTYPE_PARK;
+    case MAP_FEATURE_LAND_MASK:  return HWMAP_FTYPE_LAND;
+    case MAP_FEATURE_RAILWAY:    return HWMAP_FTYPE_RAILWAY;
+    case MAP_FEATURE_BUS:        return HWMAP_FTYPE_BUS;
+    case MAP_FEATURE_FERRY:      return HWMAP_FTYPE_FERRY;
+    case MAP_FEATURE_BUILDING:   return HWMAP_FTYPE_BUILDING;
+    case MAP_FEATURE_STATION:    return HWMAP_FTYPE_STATION;
+    default: return HWMAP_FTYPE_OTHER;
+  }
+}
+
+// HWMAP_FTYPE_* bits of types that survive layer toggles and type LOD at this zoom
+static uint16_t paramVisibleTypeMask(const MapRenderParams& p, float zoom) {
+  static const uint8_t kTypes[] = {
+    MAP_FEATURE_HIGHWAY, MAP_FEATURE_ROAD_MAJOR, MAP_FEATURE_ROAD_MINOR, MAP_FEATURE_PATH,
+    MAP_FEATURE_WATER, MAP_FEATURE_PARK, MAP_FEATURE_LAND_MASK, MAP_FEATURE_RAILWAY,
+    MAP_FEATURE_BUS, MAP_FEATURE_FERRY, MAP_FEATURE_BUILDING, MAP_FEATURE_STATION
+  };
+  uint16_t mask = HWMAP_FTYPE_OTHER;
+  for (size_t i = 0; i < sizeof(kTypes); i++) {
+    if (paramLayerIsVisible(p, kTypes[i]) && lodTypeIsVisible(kTypes[i], zoom)) {
+      mask |= featureTypeBit(kTypes[i]);
+    }
+  }
+  return mask;
+}
+
+// =============================================================================
+// MapRenderer Base Class - Default Feature Styles
+// =============================================================================
+
+MapFeatureStyle MapRenderer::getFeatureStyle(MapFeatureType type) {
+  // Default styles (can be overridden by subclasses)
+  switch (type) {
+    case MAP_FEATURE_HIGHWAY:
+      return {LINE_SOLID, 3, 10, true, 0xFFFF};  // White, thicker (was 2)
+    case MAP_FEATURE_ROAD_MAJOR:
+      return {LINE_SOLID, 2, 9, true, 0xFFFF};   // White, medium (was 1)
+    case MAP_FEATURE_ROAD_MINOR:
+      return {LINE_DASHED, 1, 5, true, 0xC618};  // Gray, thin, dashed
+    case MAP_FEATURE_PATH:
+      return {LINE_DOTTED, 1, 3, true, 0x8410};  // Dark gray, dotted
+    case MAP_FEATURE_WATER:
+      return {LINE_SOLID, 1, 8, true, 0x001F};   // Blue
+    case MAP_FEATURE_PARK:
+      return {LINE_DOTTED, 1, 2, false, 0x07E0}; // Green, skip on mono
+    case MAP_FEATURE_LAND_MASK:
+      return {LINE_DOTTED, 1, 1, true, 0x8410};  // Coastline, thin dotted, lowest priority
+    case MAP_FEATURE_RAILWAY:
+      return {LINE_DASHED, 1, 7, true, 0x7BEF};  // Gray, dashed
+    case MAP_FEATURE_BUS:
+      return {LINE_DASHED, 1, 4, true, 0xFD20};  // Orange, dashed
+    case MAP_FEATURE_FERRY:
+      return {LINE_DASHED, 2, 6, true, 0x07FF};  // Cyan, dashed, thicker
+    case MAP_FEATURE_BUILDING:
+      return {LINE_NONE, 1, 1, false, 0x4208};   // Skip
+    case MAP_FEATURE_STATION:
+      return {LINE_SOLID, 1, 7, true, 0xF81F};   // Magenta, point marker
+    default:
+      return {LINE_SOLID, 1, 5, true, 0xFFFF};
+  }
+}
+
+// =============================================================================
+// MapCore - Map File Loading (Display-Agnostic)
+// =============================================================================
+
+bool MapCore::loadMapFile(const char* path) {
+  // No render, lookup or route may touch the cache while it is rebuilt
+  MapCacheGuard cacheGuard("MapCore.loadMapFile");
+  
+  // Unload any existing map
+  unloadMap();
+  
+  // Pause sensor polling during file I/O to prevent I2C contention
+  extern volatile bool gSensorPollingPaused;
+  bool wasPaused = gSensorPollingPaused;
+  gSensorPollingPaused = true;
+  vTaskDelay(pdMS_TO_TICKS(50));  // Let any in-flight I2C complete
+
+  FsLockGuard fsGuard("MapCore.loadMapFile");
+  
+  if (!LittleFS.exists(path)) {
+    WARN_SENSORSF("Map file not found: %s", path);
+    gSensorPollingPaused = wasPaused;
+    return false;
+  }
+  
+  File f = LittleFS.open(path, "r");
+  if (!f) {
+    ERROR_SENSORSF("Failed to open map file: %s", path);
+    gSensorPollingPaused = wasPaused;
+    return false;
+  }
+  
+  size_t fileSize = f.size();
+  if (fileSize < sizeof(HWMapHeader)) {
+    ERROR_SENSORSF("Map file too small: %zu bytes", fileSize);
+    f.close();
+    gSensorPollingPaused = wasPaused;
+    return false;
+  }
+  
+  // Read header first
+  HWMapHeader header;
+  if (f.read((uint8_t*)&header, sizeof(header)) != sizeof(header)) {
+    ERROR_SENSORSF("Failed to read map header");
+    f.close();
+    gSensorPollingPaused = wasPaused;
+    return false;
+  }
+  
+  // Validate magic
+  if (memcmp(header.magic, "HWMP", 4) != 0) {
+    ERROR_SENSORSF("Invalid map magic: %.4s", header.magic);
+    f.close();
+    gSensorPollingPaused = wasPaused;
+    return false;
+  }
+  
+  // Validate version (v6 fixed-point tiles, v7 varint-delta tiles)
+  if (header.version != 6 && header.version != 7) {
+    ERROR_SENSORSF("Unsupported map version: %u (need v6 or v7)", header.version);
+    f.close();
+    gSensorPollingPaused = wasPaused;
+    return false;
+  }
+  
+  // Store basic info (cache allocated after tile directory is parsed)
+  _currentMap.valid = true;
+  _mapGeneration++;
+  memcpy(&_currentMap.header, &header, sizeof(header));
+  
+  // Normalize bounds: map tool writes lat/lon * 10^7 (deci-microdegrees)
+  // but all device code expects lat/lon * 10^6 (microdegrees)
+  _currentMap.header.minLat /= 10;
+  _currentMap.header.minLon /= 10;
+  _currentMap.header.maxLat /= 10;
+  _currentMap.header.maxLon /= 10;
+  
+  _currentMap.fileSize = fileSize;
+  _currentMap.cachePool = nullptr;
+  _currentMap.cachePoolSize = 0;
+  _currentMap.slotSize = 0;
+  _currentMap.numSlots = 0;
+  _currentMap.accessSeq = 0;
+  _currentMap.slots = nullptr;
+  _currentMap.cacheHits = 0;
+  _currentMap.cacheMisses = 0;
+  _currentMap.bytesRead = 0;
+  _currentMap.namePool = nullptr;
+  _currentMap.nameOffsets = nullptr;
+  _currentMap.nameSorted = nullptr;
+  _currentMap.nameCount = 0;
+  _currentMap.nameRefStart = nullptr;
+  _currentMap.nameRefs = nullptr;
+  _currentMap.nameRefCount = 0;
+  _currentMap.tileDir = nullptr;
+  _currentMap.tileCount = 0;
+  _currentMap.tileTypeMask = nullptr;
+  _currentMap.sections = nullptr;
+  _currentMap.sectionCount = 0;
+  
+  // Extract tiling parameters from flags
+  _currentMap.tileGridSize = HWMAP_GET_TILE_GRID_SIZE(header.flags);
+  _currentMap.haloPct = HWMAP_GET_HALO_PCT(header.flags);
+  _currentMap.quantBits = HWMAP_GET_QUANT_BITS(header.flags);
+  _currentMap.tileCount = _currentMap.tileGridSize * _currentMap.tileGridSize;
+  
+  // Precompute tile geometry for dequantization (use normalized bounds)
+  int32_t mapWidth = _currentMap.header.maxLon - _currentMap.header.minLon;
+  int32_t mapHeight = _currentMap.header.maxLat - _currentMap.header.minLat;
+  _currentMap.tileW = mapWidth / _currentMap.tileGridSize;
+  _currentMap.tileH = mapHeight / _currentMap.tileGridSize;
+  _currentMap.haloW = (int32_t)(_currentMap.tileW * _currentMap.haloPct);
+  _currentMap.haloH = (int32_t)(_currentMap.tileH * _currentMap.haloPct);
+  
+  // Store path for later reads
+  strncpy(_currentMap.filepath, path, sizeof(_currentMap.filepath) - 1);
+  _currentMap.filepath[sizeof(_currentMap.filepath) - 1] = '\0';
+  
+  // Extract filename from path
+  const char* fname = strrchr(path, '/');
+  if (fname) fname++; else fname = path;
+  strncpy(_currentMap.filename, fname, sizeof(_currentMap.filename) - 1);
+  _currentMap.filename[sizeof(_currentMap.filename) - 1] = '\0';
+  
+  INFO_SENSORSF("Loading map v%u: %s (%zu bytes, %u features, %ux%u tiles)", 
+               header.version, _currentMap.filename, fileSize, header.featureCount,
+               _currentMap.tileGridSize, _currentMap.tileGridSize);
+  
+  // === PARSE NAME TABLE (small, keep in RAM) ===
+  size_t nameTableEnd = sizeof(HWMapHeader);
+  bool nameTableScanOk = true;
+  if (header.nameCount > 0) {
+    f.seek(sizeof(HWMapHeader));
+    for (uint16_t i = 0; i < header.nameCount; i++) {
+      int c = f.read();
+      if (c < 0) {
+        nameTableScanOk = false;
+        break;
+      }
+      uint8_t strLen = (uint8_t)c;
+      size_t nextPos = (size_t)f.position() + (size_t)strLen;
+      if (!f.seek(nextPos)) {
+        nameTableScanOk = false;
+        break;
+      }
+    }
+    if (nameTableScanOk) {
+      nameTableEnd = (size_t)f.position();
+    } else {
+      ERROR_SENSORSF("Failed to scan name table");
+      f.close();
+      gSensorPollingPaused = wasPaused;
+      unloadMap();
+      return false;
+    }
+  }
+  if (header.nameCount > 0) {
+    loadNameTable(f, nameTableEnd);
+  }
+  
+  // === PARSE TILE DIRECTORY (small, keep in RAM) ===
+  if (_currentMap.tileCount == 0) {
+    ERROR_SENSORSF("Tile count is 0 (gridSize=%u, flags=0x%04X)", _currentMap.tileGridSize, header.flags);
+  } else if (_currentMap.tileCount > HWMAP_MAX_TILES) {
+    ERROR_SENSORSF("Tile count %u exceeds max %u (gridSize=%u)", _currentMap.tileCount, HWMAP_MAX_TILES, _currentMap.tileGridSize);
+  }
+  if (_currentMap.tileCount > 0 && _currentMap.tileCount <= HWMAP_MAX_TILES) {
+    size_t tileDirSize = sizeof(HWMapTileDirEntry) * _currentMap.tileCount;
+    HWMapTileDirEntry* tileDir = (HWMapTileDirEntry*)ps_malloc(tileDirSize);
+    
+    if (tileDir) {
+      f.seek(nameTableEnd);
+      size_t readBytes = f.read((uint8_t*)tileDir, tileDirSize);
+      if (readBytes == tileDirSize) {
+        _currentMap.tileDir = tileDir;
+        INFO_SENSORSF("Tile directory: %u tiles, first at offset %u", 
+                      _currentMap.tileCount, tileDir[0].offset);
+        // Detailed tile stats for debugging
+        int nonEmpty = 0;
+        for (uint16_t i = 0; i < _currentMap.tileCount; i++) {
+          if (tileDir[i].payloadSize > 0) nonEmpty++;
+        }
+        DEBUG_MAPS_LOADINGF("[MAPS] tileDir: %u total, %d non-empty, tileW=%ld tileH=%ld haloW=%ld haloH=%ld",
+                            _currentMap.tileCount, nonEmpty,
+                            (long)_currentMap.tileW, (long)_currentMap.tileH,
+                            (long)_currentMap.haloW, (long)_currentMap.haloH);
+      } else {
+        free(tileDir);
+        ERROR_SENSORSF("Failed to read tile directory");
+      }
+    }
+  }
+  
+  // === OPTIONAL EXTENSION SECTIONS ===
+  loadSectionDirectory(f, fileSize);
+  if (_currentMap.tileDir) loadTileTypeMasks(f);
+  
+  // Keep file open as persistent handle (closed in unloadMap)
+  _currentMap.mapFile = f;
+  
+  // === ALLOCATE MULTI-SLOT TILE CACHE ===
+  // Scan tile directory to find max tile payload size → determines slot size
+  uint32_t maxPayload = 0;
+  uint32_t totalPayload = 0;
+  uint16_t nonEmptyTiles = 0;
+  if (_currentMap.tileDir) {
+    for (uint16_t i = 0; i < _currentMap.tileCount; i++) {
+      uint32_t ps = _currentMap.tileDir[i].payloadSize;
+      if (ps > 0) {
+        nonEmptyTiles++;
+        totalPayload += ps;
+        if (ps > maxPayload) maxPayload = ps;
+      }
+    }
+  }
+  
+  // Slot size = max payload rounded up to 4KB boundary, with minimum
+  uint32_t slotSize = (maxPayload + 4095) & ~4095u;  // Round up to 4KB
+  if (slotSize < MAP_CACHE_MIN_SLOT) slotSize = MAP_CACHE_MIN_SLOT;
+  
+  // Try to allocate pool (4MB default, fall back to smaller if needed)
+  size_t poolSize = MAP_CACHE_POOL_SIZE;
+  uint8_t* pool = nullptr;
+  while (poolSize >= slotSize && !pool) {
+    pool = (uint8_t*)ps_malloc(poolSize);
+    if (!pool) {
+      poolSize /= 2;  // Try half size
+    }
+  }
+  if (!pool) {
+    ERROR_SENSORSF("Failed to allocate tile cache pool in PSRAM");
+    gSensorPollingPaused = wasPaused;
+    unloadMap();
+    return false;
+  }
+  
+  uint16_t numSlots = (uint16_t)(poolSize / slotSize);
+  if (numSlots > MAP_CACHE_MAX_SLOTS) numSlots = MAP_CACHE_MAX_SLOTS;
+  if (numSlots == 0) numSlots = 1;
+  
+  // Allocate slot metadata array
+  TileCacheSlot* slots = (TileCacheSlot*)ps_malloc(sizeof(TileCacheSlot) * numSlots);
+  if (!slots) {
+    free(pool);
+    ERROR_SENSORSF("Failed to allocate %u tile cache slot entries", numSlots);
+    gSensorPollingPaused = wasPaused;
+    unloadMap();
+    return false;
+  }
+  // Initialize all slots as empty
+  for (uint16_t i = 0; i < numSlots; i++) {
+    slots[i].tileIdx = -1;
+    slots[i].dataSize = 0;
+    slots[i].lastAccessSeq = 0;
+    slots[i].features = nullptr;
+    slots[i].featureRefCount = 0;
+    slots[i].lod = nullptr;
+    slots[i].segGrid = nullptr;
+  }
+  
+  _currentMap.cachePool = pool;
+  _currentMap.cachePoolSize = poolSize;
+  _currentMap.slotSize = slotSize;
+  _currentMap.numSlots = numSlots;
+  _currentMap.accessSeq = 0;
+  _currentMap.slots = slots;
+  _currentMap.cacheHits = 0;
+  _currentMap.cacheMisses = 0;
+  _currentMap.bytesRead = 0;
+  
+  size_t metadataSize = (_currentMap.namePool ? nameTableEnd - sizeof(HWMapHeader) : 0) +
+                        (sizeof(uint32_t) + sizeof(uint16_t)) * _currentMap.nameCount + 
+                        sizeof(HWMapTileDirEntry) * _currentMap.tileCount +
+                        (_currentMap.tileTypeMask ? sizeof(uint16_t) * _currentMap.tileCount : 0) +
+                        sizeof(TileCacheSlot) * numSlots;
+  uint32_t avgPayload = nonEmptyTiles ? (totalPayload / nonEmptyTiles) : 0;
+  INFO_SENSORSF("Tile cache: %uKB pool, %u slots x %uKB | tiles: %u non-empty, avg %uB, max %uB | meta: %zuB",
+                (unsigned)(poolSize / 1024), numSlots, (unsigned)(slotSize / 1024),
+                nonEmptyTiles, avgPayload, maxPayload, metadataSize);
+  
+  // === PRE-WARM CACHE: load all tiles that fit into slots at load time ===
+  // This eliminates ALL runtime cache misses for maps that fit in the pool
+  if (_currentMap.mapFile && _currentMap.tileDir && nonEmptyTiles <= numSlots) {
+    uint16_t slotIdx = 0;
+    uint16_t preloaded = 0;
+    uint32_t preloadStart = millis();
+    for (uint16_t i = 0; i < _currentMap.tileCount && slotIdx < numSlots; i++) {
+      uint32_t ps = _currentMap.tileDir[i].payloadSize;
+      if (ps == 0) continue;
+      if (ps > slotSize) {
+        DEBUG_MAPS_LOADINGF("[MAPS] prewarm: tile %u payload %u > slotSize %u, skipping", i, ps, slotSize);
+        continue;
+      }
+      uint8_t* slotData = pool + ((size_t)slotIdx * slotSize);
+      _currentMap.mapFile.seek(_currentMap.tileDir[i].offset);
+      size_t got = _currentMap.mapFile.read(slotData, ps);
+      if (got == ps) {
+        slots[slotIdx].tileIdx = (int16_t)i;
+        slots[slotIdx].dataSize = ps;
+        slots[slotIdx].lastAccessSeq = ++_currentMap.accessSeq;
+        slotIdx++;
+        preloaded++;
+      }
+    }
+    INFO_SENSORSF("Cache pre-warmed: %u tiles loaded in %lums (zero runtime misses expected)",
+                  preloaded, (unsigned long)(millis() - preloadStart));
+  } else if (nonEmptyTiles > numSlots) {
+    INFO_SENSORSF("Map too large for full pre-warm: %u tiles > %u slots (LRU will handle misses)",
+                  nonEmptyTiles, numSlots);
+  }
+  
+  // Invalidate location context since map changed
+  LocationContextManager::invalidate();
+  
+  // Load waypoints for this map
+  WaypointManager::loadWaypoints();
+  
+  // Resume sensor polling
+  gSensorPollingPaused = wasPaused;
+  
+  return true;
+}
+
+void MapCore::unloadMap() {
+  MapCacheGuard cacheGuard("MapCore.unloadMap");
+  
+  // Log cache stats before freeing
+  if (_currentMap.valid && (_currentMap.cacheHits > 0 || _currentMap.cacheMisses > 0)) {
+    uint32_t total = _currentMap.cacheHits + _currentMap.cacheMisses;
+    INFO_SENSORSF("Tile cache stats: %u hits, %u misses (%.1f%% hit rate), %u slots",
+                  _currentMap.cacheHits, _currentMap.cacheMisses,
+                  total > 0 ? (100.0f * _currentMap.cacheHits / total) : 0.0f,
+                  _currentMap.numSlots);
+  }
+  
+  // Close persistent file handle
+  if (_currentMap.mapFile) {
+    _currentMap.mapFile.close();
+  }
+  
+  // Free multi-slot cache
+  if (_currentMap.slots) {
+    for (uint16_t i = 0; i < _currentMap.numSlots; i++) {
+      freeSlotIndex(_currentMap.slots[i]);
+    }
+    free(_currentMap.slots);
+    _currentMap.slots = nullptr;
+  }
+  if (_currentMap.cachePool) {
+    free(_currentMap.cachePool);
+    _currentMap.cachePool = nullptr;
+  }
+  _currentMap.cachePoolSize = 0;
+  _currentMap.slotSize = 0;
+  _currentMap.numSlots = 0;
+  _currentMap.accessSeq = 0;
+  _currentMap.cacheHits = 0;
+  _currentMap.cacheMisses = 0;
+  _currentMap.bytesRead = 0;
+  
+  if (_currentMap.namePool) {
+    free(_currentMap.namePool);
+    _currentMap.namePool = nullptr;
+  }
+  if (_currentMap.nameOffsets) {
+    free(_currentMap.nameOffsets);
+    _currentMap.nameOffsets = nullptr;
+  }
+  if (_currentMap.nameSorted) {
+    free(_currentMap.nameSorted);
+    _currentMap.nameSorted = nullptr;
+  }
+  if (_currentMap.nameRefStart) {
+    free(_currentMap.nameRefStart);
+    _currentMap.nameRefStart = nullptr;
+  }
+  if (_currentMap.nameRefs) {
+    free(_currentMap.nameRefs);
+    _currentMap.nameRefs = nullptr;
+  }
+  _currentMap.nameRefCount = 0;
+  // Free tile directory
+  if (_currentMap.tileDir) {
+    free(_currentMap.tileDir);
+    _currentMap.tileDir = nullptr;
+  }
+  if (_currentMap.tileTypeMask) {
+    free(_currentMap.tileTypeMask);
+    _currentMap.tileTypeMask = nullptr;
+  }
+  if (_currentMap.sections) {
+    free(_currentMap.sections);
+    _currentMap.sections = nullptr;
+  }
+  _currentMap.sectionCount = 0;
+  _currentMap.tileCount = 0;
+  _currentMap.tileGridSize = 0;
+  
+  _currentMap.valid = false;
+  _mapGeneration++;
+  _currentMap.fileSize = 0;
+  _currentMap.filename[0] = '\0';
+  _currentMap.filepath[0] = '\0';
+  _currentMap.nameCount = 0;
+  
+  // Invalidate context when map unloaded
+  LocationContextManager::invalidate();
+}
+
+const char* MapCore::getName(uint16_t index) {
+  if (!_currentMap.valid || !_currentMap.namePool || index >= _currentMap.nameCount) {
+    return nullptr;
+  }
+  return _currentMap.namePool + _currentMap.nameOffsets[index];
+}
+
+// Read the whole name table in one go and unpack it in place: each
+// [len][chars] record becomes [chars][NUL] at the same position.
+bool MapCore::loadNameTable(File& f, size_t nameTableEnd) {
+  size_t tableBytes = nameTableEnd - sizeof(HWMapHeader);
+  uint16_t count = _currentMap.header.nameCount;
+  if (count > MAX_MAP_NAMES) {
+    WARN_SENSORSF("Map has %u names, loading first %u", count, MAX_MAP_NAMES);
+    count = MAX_MAP_NAMES;
+  }
+  
+  char* pool = (char*)ps_alloc(tableBytes + 1, AllocPref::PreferPSRAM, "map.names");
+  uint32_t* offsets = (uint32_t*)ps_alloc(sizeof(uint32_t) * count, AllocPref::PreferPSRAM, "map.names");
+  uint16_t* sorted = (uint16_t*)ps_alloc(sizeof(uint16_t) * count, AllocPref::PreferPSRAM, "map.names");
+  if (!pool || !offsets || !sorted) {
+    ERROR_SENSORSF("Failed to allocate name table (%u names, %zu bytes)", count, tableBytes);
+    free(pool); free(offsets); free(sorted);
+    return false;
+  }
+  
+  f.seek(sizeof(HWMapHeader));
+  if (f.read((uint8_t*)pool, tableBytes) != tableBytes) {
+    ERROR_SENSORSF("Failed to read name table");
+    free(pool); free(offsets); free(sorted);
+    return false;
+  }
+  pool[tableBytes] = '\0';
+  
+  size_t pos = 0;
+  uint16_t parsed = 0;
+  while (parsed < count && pos < tableBytes) {
+    uint8_t len = (uint8_t)pool[pos];
+    if (pos + 1 + len > tableBytes) break;
+    memmove(pool + pos, pool + pos + 1, len);
+    pool[pos + len] = '\0';
+    if (len > MAP_NAME_MAX_LEN) pool[pos + MAP_NAME_MAX_LEN] = '\0';
+    offsets[parsed++] = (uint32_t)pos;
+    pos += (size_t)len + 1;
+  }
+  
+  // Case-folded order; equal names keep file order so duplicates list stably
+  for (uint16_t i = 0; i < parsed; i++) sorted[i] = i;
+  std::sort(sorted, sorted + parsed, [pool, offsets](uint16_t a, uint16_t b) {
+    int c = strcasecmp(pool + offsets[a], pool + offsets[b]);
+    return c < 0 || (c == 0 && a < b);
+  });
+  
+  _currentMap.namePool = pool;
+  _currentMap.nameOffsets = offsets;
+  _currentMap.nameSorted = sorted;
+  _currentMap.nameCount = parsed;
+  INFO_SENSORSF("Parsed %u names (%zu bytes)", parsed, tableBytes);
+  return true;
+}
+
+// Helper: Load tile data via multi-slot cache
+// Returns pointer to tile data in cache slot, or nullptr on error. The pointer
+// (and the slot's indexes) stay valid only while the caller holds MapCacheGuard.
+const uint8_t* MapCore::loadTileData(uint16_t tileIdx, size_t* outSize) {
+  MapCacheGuard cacheGuard("MapCore.loadTileData");
+  
+  if (!_currentMap.valid || !_currentMap.tileDir || tileIdx >= _currentMap.tileCount) {
+    return nullptr;
+  }
+  
+  HWMapTileDirEntry& tile = _currentMap.tileDir[tileIdx];
+  if (tile.payloadSize == 0) {
+    if (outSize) *outSize = 0;
+    return nullptr;
+  }
+  
+  if (!_currentMap.cachePool || !_currentMap.slots || _currentMap.numSlots == 0) {
+    DEBUG_MAPS_RENDERINGF("[MAPS] loadTileData: cache not initialized!");
+    return nullptr;
+  }
+  
+  // === CACHE LOOKUP: search slots for this tile ===
+  for (uint16_t i = 0; i < _currentMap.numSlots; i++) {
+    if (_currentMap.slots[i].tileIdx == (int16_t)tileIdx) {
+      // Cache hit - update LRU counter and return
+      _currentMap.slots[i].lastAccessSeq = ++_currentMap.accessSeq;
+      _currentMap.cacheHits++;
+      if (outSize) *outSize = _currentMap.slots[i].dataSize;
+      const uint8_t* hitPtr = _currentMap.cachePool + ((size_t)i * _currentMap.slotSize);
+      return hitPtr;
+    }
+  }
+  
+  // === CACHE MISS ===
+  _currentMap.cacheMisses++;
+  
+  uint32_t payloadSize = tile.payloadSize;
+  
+  // If tile is larger than slot size, log warning and read directly into slot 0
+  // (evicting whatever was there - this should be rare/never with proper slot sizing)
+  if (payloadSize > _currentMap.slotSize) {
+    DEBUG_MAPS_RENDERINGF("[MAPS] WARNING: tile %u payload %u > slotSize %u, truncating read!",
+                          tileIdx, payloadSize, _currentMap.slotSize);
+    payloadSize = _currentMap.slotSize;
+  }
+  
+  // Find a slot: prefer empty, otherwise evict LRU
+  int16_t targetSlot = -1;
+  uint32_t oldestSeq = UINT32_MAX;
+  for (uint16_t i = 0; i < _currentMap.numSlots; i++) {
+    if (_currentMap.slots[i].tileIdx == -1) {
+      targetSlot = i;
+      break;  // Empty slot found, use it
+    }
+    if (_currentMap.slots[i].lastAccessSeq < oldestSeq) {
+      oldestSeq = _currentMap.slots[i].lastAccessSeq;
+      targetSlot = i;
+    }
+  }
+  
+  if (targetSlot < 0) targetSlot = 0;  // Shouldn't happen, but safety
+  
+  DEBUG_MAPS_PERFF("[TILE_CACHE] miss tile=%u slot=%d payload=%uB %s (hits=%u misses=%u seq=%u)",
+                   tileIdx, targetSlot, tile.payloadSize,
+                   _currentMap.slots[targetSlot].tileIdx == -1 ? "empty" : "evict",
+                   _currentMap.cacheHits, _currentMap.cacheMisses, _currentMap.accessSeq);
+  
+  // Feature index belongs to the evicted tile
+  freeSlotIndex(_currentMap.slots[targetSlot]);
+  _currentMap.slots[targetSlot].tileIdx = -1;
+  
+  // Read tile data from file into the target slot
+  uint8_t* slotData = _currentMap.cachePool + ((size_t)targetSlot * _currentMap.slotSize);
+  
+  {
+    // Exclusive per map file: the persistent handle's seek+read must not interleave
+    FsPathWriteGuard fsGuard(_currentMap.filepath);
+    bool usedPersistent = false;
+    size_t bytesRead = 0;
+    
+    // Prefer persistent handle (no open/close overhead)
+    if (_currentMap.mapFile) {
+      _currentMap.mapFile.seek(tile.offset);
+      bytesRead = _currentMap.mapFile.read(slotData, payloadSize);
+      usedPersistent = true;
+    } else {
+      // Fallback: open/close per miss
+      File f = LittleFS.open(_currentMap.filepath, "r");
+      if (!f) {
+        DEBUG_MAPS_RENDERINGF("[MAPS] loadTileData: failed to open '%s'", _currentMap.filepath);
+        return nullptr;
+      }
+      f.seek(tile.offset);
+      bytesRead = f.read(slotData, payloadSize);
+      f.close();
+    }
+    
+    _currentMap.bytesRead += bytesRead;
+    if (bytesRead != payloadSize) {
+      DEBUG_MAPS_RENDERINGF("[MAPS] loadTileData: short read tile %u: got %zu, expected %u (persistent=%d)",
+                            tileIdx, bytesRead, payloadSize, usedPersistent);
+      if (bytesRead == 0) { return nullptr; }
+      payloadSize = bytesRead;
+    }
+  }
+  
+  // Update slot metadata
+  _currentMap.slots[targetSlot].tileIdx = (int16_t)tileIdx;
+  _currentMap.slots[targetSlot].dataSize = payloadSize;
+  _currentMap.slots[targetSlot].lastAccessSeq = ++_currentMap.accessSeq;
+  
+  if (outSize) *outSize = payloadSize;
+  return slotData;
+}
+
+size_t MapCore::readMapFile(uint32_t offset, uint8_t* buf, size_t len) {
+  if (!_currentMap.valid || !buf || offset >= _currentMap.fileSize) return 0;
+  if (len > _currentMap.fileSize - offset) len = _currentMap.fileSize - offset;
+  
+  // Same exclusion as loadTileData: the persistent handle's seek+read must not interleave
+  FsPathWriteGuard fsGuard(_currentMap.filepath);
+  if (_currentMap.mapFile) {
+    if (!_currentMap.mapFile.seek(offset)) return 0;
+    return _currentMap.mapFile.read(buf, len);
+  }
+  File f = LittleFS.open(_currentMap.filepath, "r");
+  if (!f) return 0;
+  size_t got = f.seek(offset) ? f.read(buf, len) : 0;
+  f.close();
+  return got;
+}
+
+// =============================================================================
+// MapTileReader - tile payload decoding (v6 / v7)
+// =============================================================================
+
+static bool decodeVarint(const uint8_t*& p, const uint8_t* end, uint32_t& v) {
+  v = 0;
+  for (uint8_t shift = 0; shift < 32 && p < end; shift += 7) {
+    uint8_t b = *p++;
+    v |= (uint32_t)(b & 0x7F) << shift;
+    if (!(b & 0x80)) return true;
+  }
+  return false;
+}
+
+MapTileReader::MapTileReader(const uint8_t* data, size_t size, uint16_t version)
+  : _data(data), _end(data ? data + size : nullptr), _ptr(nullptr), _pointsEnd(nullptr),
+    _nextRecord(nullptr), _dict(nullptr), _dictCount(0), _featureCount(0), _featuresRead(0),
+    _pointsLeft(0), _qLat(0), _qLon(0), _compact(version >= 7), _firstPoint(false) {
+  if (!data || size < 2) return;
+  const uint8_t* p = data + 2;
+  
+  if (_compact) {
+    if (p >= _end) return;
+    uint8_t tileFlags = *p++;
+    if (tileFlags & HWMAP_TILE_HAS_DICT) {
+      uint32_t entries;
+      if (!decodeVarint(p, _end, entries) || entries > 0xFFFF || p + entries * 4 > _end) return;
+      _dict = p;
+      _dictCount = (uint16_t)entries;
+      p += entries * 4;
+    }
+  }
+  
+  _featureCount = data[0] | (data[1] << 8);
+  _nextRecord = p;
+}
+
+bool MapTileReader::readHeader(const uint8_t* rec, MapFeatureInfo& info) {
+  const uint8_t* p = rec;
+  uint32_t pointBytes;
+  
+  if (!_compact) {
+    if (p + HWMAP_FEATURE_HEADER_SIZE > _end) return false;
+    info.type = p[0];
+    info.subtype = p[1];
+    info.nameIndex = p[2] | (p[3] << 8);
+    info.pointCount = p[4] | (p[5] << 8);
+    p += HWMAP_FEATURE_HEADER_SIZE;
+    pointBytes = (uint32_t)info.pointCount * 4;
+  } else {
+    const uint8_t* hdr;
+    if (_dict) {
+      uint32_t entry;
+      if (!decodeVarint(p, _end, entry) || entry >= _dictCount) return false;
+      hdr = _dict + entry * 4;
+    } else {
+      if (p + 4 > _end) return false;
+      hdr = p;
+      p += 4;
+    }
+    info.type = hdr[0];
+    info.subtype = hdr[1];
+    info.nameIndex = hdr[2] | (hdr[3] << 8);
+    uint32_t pointCount;
+    if (!decodeVarint(p, _end, pointCount) || pointCount > 0xFFFF) return false;
+    if (!decodeVarint(p, _end, pointBytes)) return false;
+    info.pointCount = (uint16_t)pointCount;
+  }
+  
+  if ((size_t)(_end - p) < pointBytes) return false;
+  info.offset = (uint32_t)(rec - _data);
+  _ptr = p;
+  _pointsEnd = p + pointBytes;
+  _nextRecord = _pointsEnd;
+  _pointsLeft = info.pointCount;
+  _firstPoint = true;
+  return true;
+}
+
+bool MapTileReader::next(MapFeatureInfo& info) {
+  if (!_nextRecord || _featuresRead >= _featureCount) return false;
+  if (!readHeader(_nextRecord, info)) {
+    _featuresRead = _featureCount;  // Truncated tile: stop here
+    return false;
+  }
+  _featuresRead++;
+  return true;
+}
+
+bool MapTileReader::seek(uint32_t offset, MapFeatureInfo& info) {
+  if (!_data || offset >= (size_t)(_end - _data)) return false;
+  return readHeader(_data + offset, info);
+}
+
+// =============================================================================
+// MapCore - Extension Sections and Per-Tile Feature Index
+// =============================================================================
+
+void MapCore::loadSectionDirectory(File& f, size_t fileSize) {
+  if (fileSize < sizeof(HWMapHeader) + HWMAP_TRAILER_SIZE) return;
+  
+  uint8_t trailer[HWMAP_TRAILER_SIZE];
+  f.seek(fileSize - HWMAP_TRAILER_SIZE);
+  if (f.read(trailer, sizeof(trailer)) != sizeof(trailer)) return;
+  if (memcmp(trailer, HWMAP_TRAILER_MAGIC, 4) != 0) return;  // No sections (plain v6 file)
+  
+  uint32_t dirOffset, count;
+  memcpy(&dirOffset, trailer + 4, 4);
+  memcpy(&count, trailer + 8, 4);
+  if (count == 0) return;
+  if (count > HWMAP_MAX_SECTIONS) {
+    WARN_SENSORSF("Map has %u sections, using first %u", (unsigned)count, HWMAP_MAX_SECTIONS);
+    count = HWMAP_MAX_SECTIONS;
+  }
+  size_t dirSize = sizeof(HWMapSectionEntry) * count;
+  if (dirOffset < sizeof(HWMapHeader) || (size_t)dirOffset + dirSize > fileSize - HWMAP_TRAILER_SIZE) {
+    WARN_SENSORSF("Map section directory out of range (offset=%u count=%u)", (unsigned)dirOffset, (unsigned)count);
+    return;
+  }
+  
+  HWMapSectionEntry* sections = (HWMapSectionEntry*)ps_malloc(dirSize);
+  if (!sections) return;
+  f.seek(dirOffset);
+  if (f.read((uint8_t*)sections, dirSize) != dirSize) {
+    free(sections);
+    return;
+  }
+  
+  // Drop entries that point outside the file rather than trusting them later
+  uint8_t valid = 0;
+  for (uint32_t i = 0; i < count; i++) {
+    if ((size_t)sections[i].offset + sections[i].size <= fileSize) {
+      sections[valid++] = sections[i];
+    }
+  }
+  _currentMap.sections = sections;
+  _currentMap.sectionCount = valid;
+  for (uint8_t i = 0; i < valid; i++) {
+    DEBUG_MAPS_LOADINGF("[MAPS] section %.4s: offset=%u size=%u",
+                        sections[i].tag, sections[i].offset, sections[i].size);
+  }
+  INFO_SENSORSF("Map extension sections: %u", valid);
+}
+
+const HWMapSectionEntry* MapCore::findSection(const char* tag) {
+  if (!_currentMap.valid || !_currentMap.sections || !tag) return nullptr;
+  for (uint8_t i = 0; i < _currentMap.sectionCount; i++) {
+    if (memcmp(_currentMap.sections[i].tag, tag, 4) == 0) return &_currentMap.sections[i];
+  }
+  return nullptr;
+}
+
+void MapCore::loadTileTypeMasks(File& f) {
+  size_t bytes = sizeof(uint16_t) * _currentMap.tileCount;
+  uint16_t* masks = (uint16_t*)ps_malloc(bytes);
+  if (!masks) return;
+  // Unknown until the FBOX section or the tile's own index says otherwise
+  for (uint16_t i = 0; i < _currentMap.tileCount; i++) masks[i] = 0xFFFF;
+  
+  const HWMapSectionEntry* fbox = findSection(HWMAP_SECTION_FBOX);
+  if (fbox && fbox->size >= bytes + sizeof(uint32_t) * _currentMap.tileCount) {
+    f.seek(fbox->offset);
+    if (f.read((uint8_t*)masks, bytes) != bytes) {
+      for (uint16_t i = 0; i < _currentMap.tileCount; i++) masks[i] = 0xFFFF;
+    }
+  }
+  _currentMap.tileTypeMask = masks;
+}
+
+void MapCore::freeSlotIndex(TileCacheSlot& slot) {
+  if (slot.features) {
+    free(slot.features);
+    slot.features = nullptr;
+  }
+  slot.featureRefCount = 0;
+  if (slot.lod) {
+    free(slot.lod->spans);
+    free(slot.lod->points);
+    free(slot.lod);
+    slot.lod = nullptr;
+  }
+  if (slot.segGrid) {
+    free(slot.segGrid->segments);
+    free(slot.segGrid->features);
+    free(slot.segGrid);
+    slot.segGrid = nullptr;
+  }
+}
+
+// Cache slot holding tileData, if it is the one loadTileData() returned for tileIdx
+TileCacheSlot* MapCore::slotForTileData(uint16_t tileIdx, const uint8_t* tileData) {
+  if (!_currentMap.valid || !_currentMap.cachePool || !_currentMap.slots || !tileData) return nullptr;
+  
+  // loadTileData() always hands out the start of a cache slot
+  const uint8_t* poolEnd = _currentMap.cachePool + (size_t)_currentMap.numSlots * _currentMap.slotSize;
+  if (tileData < _currentMap.cachePool || tileData >= poolEnd) return nullptr;
+  TileCacheSlot& slot = _currentMap.slots[(tileData - _currentMap.cachePool) / _currentMap.slotSize];
+  if (slot.tileIdx != (int16_t)tileIdx) return nullptr;
+  return &slot;
+}
+
+// Bounds of the reader's current feature (consumes its points)
+static HWMapFeatureBox scanFeatureBox(MapTileReader& reader) {
+  HWMapFeatureBox box = {0xFFFF, 0xFFFF, 0, 0};  // Empty: rejected by any view test
+  uint16_t qLat, qLon;
+  while (reader.point(qLat, qLon)) {
+    if (qLat < box.qMinLat) box.qMinLat = qLat;
+    if (qLat > box.qMaxLat) box.qMaxLat = qLat;
+    if (qLon < box.qMinLon) box.qMinLon = qLon;
+    if (qLon > box.qMaxLon) box.qMaxLon = qLon;
+  }
+  return box;
+}
+
+// Fill refs[].box from the tile's FBOX record. Returns false if the map has no
+// usable record for this tile (caller then derives the boxes from the points).
+bool MapCore::readTileFeatureBoxes(uint16_t tileIdx, TileFeatureRef* refs, uint16_t count) {
+  const HWMapSectionEntry* fbox = findSection(HWMAP_SECTION_FBOX);
+  if (!fbox || !_currentMap.mapFile) return false;
+  
+  size_t tableBytes = (sizeof(uint16_t) + sizeof(uint32_t)) * _currentMap.tileCount;
+  if (fbox->size < tableBytes) return false;
+  
+  FsPathWriteGuard fsGuard(_currentMap.filepath);
+  File& f = _currentMap.mapFile;
+  
+  uint32_t recordOffset;
+  f.seek(fbox->offset + sizeof(uint16_t) * _currentMap.tileCount + sizeof(uint32_t) * tileIdx);
+  if (f.read((uint8_t*)&recordOffset, sizeof(recordOffset)) != sizeof(recordOffset)) return false;
+  if (recordOffset == HWMAP_FBOX_NO_RECORD) return false;
+  if ((size_t)recordOffset + 2 + sizeof(HWMapFeatureBox) * count > fbox->size) return false;
+  
+  uint16_t recordCount;
+  f.seek(fbox->offset + recordOffset);
+  if (f.read((uint8_t*)&recordCount, sizeof(recordCount)) != sizeof(recordCount)) return false;
+  if (recordCount != count) return false;  // Stale section - don't trust it
+  
+  HWMapFeatureBox boxes[32];
+  for (uint16_t i = 0; i < count; ) {
+    uint16_t n = (count - i < 32) ? (count - i) : 32;
+    size_t bytes = sizeof(HWMapFeatureBox) * n;
+    if (f.read((uint8_t*)boxes, bytes) != bytes) return false;
+    for (uint16_t j = 0; j < n; j++) refs[i + j].box = boxes[j];
+    i += n;
+  }
+  return true;
+}
+
+const TileFeatureRef* MapCore::getTileFeatureRefs(uint16_t tileIdx, const uint8_t* tileData,
+                                                  size_t tileDataSize, uint16_t* outCount) {
+  MapCacheGuard cacheGuard("MapCore.getTileFeatureRefs");
+  if (outCount) *outCount = 0;
+  if (tileDataSize < 2) return nullptr;
+  TileCacheSlot* slotPtr = slotForTileData(tileIdx, tileData);
+  if (!slotPtr) return nullptr;
+  TileCacheSlot& slot = *slotPtr;
+  
+  if (slot.features) {
+    if (outCount) *outCount = slot.featureRefCount;
+    return slot.features;
+  }
+  
+  uint16_t featureCount = tileData[0] | (tileData[1] << 8);
+  if (featureCount == 0) return nullptr;
+  TileFeatureRef* refs = (TileFeatureRef*)ps_alloc(sizeof(TileFeatureRef) * featureCount,
+                                                   AllocPref::PreferPSRAM, "map.fidx");
+  if (!refs) return nullptr;
+  
+  // Feature offsets and tile type mask from the headers; bounds come from the
+  // FBOX section when the map has one, otherwise from the points in the same pass
+  MapTileReader reader(tileData, tileDataSize, _currentMap.header.version);
+  bool wantBoxes = (findSection(HWMAP_SECTION_FBOX) == nullptr);
+  MapFeatureInfo info;
+  uint16_t count = 0;
+  uint16_t typeMask = 0;
+  while (count < featureCount && reader.next(info)) {
+    refs[count].offset = info.offset;
+    typeMask |= featureTypeBit(info.type);
+    if (wantBoxes) refs[count].box = scanFeatureBox(reader);
+    count++;
+  }
+  
+  if (!wantBoxes && !readTileFeatureBoxes(tileIdx, refs, count)) {
+    for (uint16_t f = 0; f < count; f++) {
+      if (reader.seek(refs[f].offset, info)) refs[f].box = scanFeatureBox(reader);
+    }
+  }
+  
+  slot.features = refs;
+  slot.featureRefCount = count;
+  if (_currentMap.tileTypeMask) _currentMap.tileTypeMask[tileIdx] = typeMask;
+  
+  if (outCount) *outCount = count;
+  return refs;
+}
+
+// Douglas-Peucker over pts[0..n) (qLat, qLon pairs), marking kept vertices in
+// keep[]. Iterative with an explicit range stack so long ways can't overflow the
+// task stack; tolerance is in quantized units.
+static void simplifyLine(const uint16_t* pts, uint16_t n, uint32_t tolerance,
+                         uint8_t* keep, uint16_t* stack) {
+  memset(keep, 0, n);
+  keep[0] = 1;
+  keep[n - 1] = 1;
+  if (n < 3) return;
+  
+  const int64_t tol2 = (int64_t)tolerance * tolerance;
+  uint32_t sp = 0;
+  stack[sp++] = 0;
+  stack[sp++] = n - 1;
+  while (sp) {
+    uint16_t b = stack[--sp];
+    uint16_t a = stack[--sp];
+    if (b - a < 2) continue;
+    
+    int64_t ax = pts[a * 2 + 1], ay = pts[a * 2];
+    int64_t dx = (int64_t)pts[b * 2 + 1] - ax;
+    int64_t dy = (int64_t)pts[b * 2] - ay;
+    int64_t len2 = dx * dx + dy * dy;
+    
+    // Distance to the segment ab, squared and scaled by |ab|^2 so no vertex
+    // needs a divide: cross^2 where the vertex projects inside ab, else the
+    // distance to the nearer end (a spike running back past either end must
+    // not be dropped). Closed rings (a and b at the same position) use plain
+    // distance to a.
+    const float scale = (len2 == 0) ? 1.0f : (float)len2;
+    float best = -1.0f;
+    uint16_t bestIdx = a;
+    for (uint16_t i = a + 1; i < b; i++) {
+      int64_t px = (int64_t)pts[i * 2 + 1] - ax;
+      int64_t py = (int64_t)pts[i * 2] - ay;
+      int64_t t = px * dx + py * dy;
+      float d;
+      if (t > 0 && t < len2) {
+        float cross = (float)(px * dy - py * dx);
+        d = cross * cross;
+      } else {
+        if (len2 != 0 && t >= len2) { px -= dx; py -= dy; }
+        d = (float)(px * px + py * py) * scale;
+      }
+      if (d > best) { best = d; bestIdx = i; }
+    }
+    
+    if (best > (float)tol2 * scale) {
+      keep[bestIdx] = 1;
+      stack[sp++] = a;
+      stack[sp++] = bestIdx;
+      stack[sp++] = bestIdx;
+      stack[sp++] = b;
+    }
+  }
+}
+
+const TileLod* MapCore::getTileLod(uint16_t tileIdx, const uint8_t* tileData, size_t tileDataSize) {
+  MapCacheGuard cacheGuard("MapCore.getTileLod");
+  uint16_t refCount = 0;
+  const TileFeatureRef* refs = getTileFeatureRefs(tileIdx, tileData, tileDataSize, &refCount);
+  if (!refs || refCount == 0) return nullptr;
+  TileCacheSlot* slot = slotForTileData(tileIdx, tileData);
+  if (!slot) return nullptr;
+  if (slot->lod) return slot->lod;
+  
+  MapTileReader reader(tileData, tileDataSize, _currentMap.header.version);
+  MapFeatureInfo info;
+  uint16_t maxPoints = 0;
+  uint32_t totalPoints = 0;
+  for (uint16_t f = 0; f < refCount; f++) {
+    if (!reader.seek(refs[f].offset, info)) continue;
+    if (info.pointCount > maxPoints) maxPoints = info.pointCount;
+    totalPoints += info.pointCount;
+  }
+  if (maxPoints == 0) return nullptr;
+  
+  // Scratch: one decoded feature, its keep flags and the DP range stack
+  // (each split pushes two ranges, at most one per vertex)
+  uint16_t* full = (uint16_t*)ps_alloc(sizeof(uint16_t) * 2 * maxPoints, AllocPref::PreferPSRAM, "map.lod.tmp");
+  uint8_t* keep = (uint8_t*)ps_alloc(maxPoints, AllocPref::PreferPSRAM, "map.lod.keep");
+  uint16_t* stack = (uint16_t*)ps_alloc(sizeof(uint16_t) * 4 * maxPoints, AllocPref::PreferPSRAM, "map.lod.stk");
+  TileLod* lod = (TileLod*)ps_calloc(1, sizeof(TileLod), AllocPref::PreferPSRAM, "map.lod");
+  if (lod) {
+    lod->spans = (TileLodSpan*)ps_calloc((size_t)refCount * MAP_LOD_LEVELS, sizeof(TileLodSpan),
+                                         AllocPref::PreferPSRAM, "map.lod.span");
+  }
+  // Start with a quarter of the full geometry across all levels and grow on demand
+  uint32_t capacity = totalPoints / 4 + 16;
+  uint16_t* out = (uint16_t*)ps_alloc(sizeof(uint16_t) * 2 * capacity, AllocPref::PreferPSRAM, "map.lod.pts");
+  
+  bool ok = full && keep && stack && lod && lod->spans && out;
+  uint32_t used = 0;
+  for (uint16_t f = 0; ok && f < refCount; f++) {
+    if (!reader.seek(refs[f].offset, info)) continue;
+    uint16_t n = 0;
+    while (n < info.pointCount && reader.point(full[n * 2], full[n * 2 + 1])) n++;
+    if (n < 2) continue;
+    
+    // Every level simplifies the full line, so its error is its own tolerance
+    // (chaining levels would add the finer levels' error on top)
+    uint32_t tolerance = MAP_LOD_BASE_TOLERANCE;
+    for (uint8_t level = 0; level < MAP_LOD_LEVELS; level++, tolerance *= 4) {
+      simplifyLine(full, n, tolerance, keep, stack);
+      uint16_t kept = 0;
+      for (uint16_t i = 0; i < n; i++) kept += keep[i];
+      
+      if (used + kept > capacity) {
+        uint32_t grow = capacity * 2 > used + kept ? capacity * 2 : used + kept;
+        uint16_t* bigger = (uint16_t*)ps_realloc(out, sizeof(uint16_t) * 2 * grow, AllocPref::PreferPSRAM, "map.lod.pts");
+        if (!bigger) { ok = false; break; }
+        out = bigger;
+        capacity = grow;
+      }
+      
+      TileLodSpan& span = lod->spans[(size_t)f * MAP_LOD_LEVELS + level];
+      span.start = used;
+      span.count = kept;
+      uint16_t m = 0;
+      for (uint16_t i = 0; i < n; i++) {
+        if (!keep[i]) continue;
+        out[(used + m) * 2] = full[i * 2];
+        out[(used + m) * 2 + 1] = full[i * 2 + 1];
+        m++;
+      }
+      used += kept;
+    }
+  }
+  
+  free(full);
+  free(keep);
+  free(stack);
+  if (!ok) {
+    if (lod) free(lod->spans);
+    free(lod);
+    free(out);
+    return nullptr;
+  }
+  
+  lod->points = out;
+  lod->pointCount = used;
+  slot->lod = lod;
+  DEBUG_MAPS_RENDERINGF("[MAPS] tile %u LOD: %u features, %lu points -> %lu kept over %d levels",
+                        tileIdx, refCount, (unsigned long)totalPoints, (unsigned long)used, MAP_LOD_LEVELS);
+  return lod;
+}
+
+// Location context classes: 0 = road, 1 = area, -1 = not indexed
+static int contextFeatureClass(uint8_t type) {
+  switch (type) {
+    case MAP_FEATURE_HIGHWAY:
+    case MAP_FEATURE_ROAD_MAJOR:
+    case MAP_FEATURE_ROAD_MINOR:
+    case MAP_FEATURE_PATH:
+      return 0;
+    case MAP_FEATURE_PARK:
+    case MAP_FEATURE_WATER:
+      return 1;
+    default:
+      return -1;
+  }
+}
+
+// Grid cells covered by the bounding box of a quantized segment
+static inline void segmentCells(uint16_t qLat1, uint16_t qLon1, uint16_t qLat2, uint16_t qLon2,
+                                uint8_t& r0, uint8_t& r1, uint8_t& c0, uint8_t& c1) {
+  r0 = (qLat1 < qLat2 ? qLat1 : qLat2) >> SEG_GRID_SHIFT;
+  r1 = (qLat1 < qLat2 ? qLat2 : qLat1) >> SEG_GRID_SHIFT;
+  c0 = (qLon1 < qLon2 ? qLon1 : qLon2) >> SEG_GRID_SHIFT;
+  c1 = (qLon1 < qLon2 ? qLon2 : qLon1) >> SEG_GRID_SHIFT;
+}
+
+const TileSegmentGrid* MapCore::getTileSegmentGrid(uint16_t tileIdx, const uint8_t* tileData, size_t tileDataSize) {
+  MapCacheGuard cacheGuard("MapCore.getTileSegmentGrid");
+  if (tileDataSize < 2) return nullptr;
+  TileCacheSlot* slot = slotForTileData(tileIdx, tileData);
+  if (!slot) return nullptr;
+  if (slot->segGrid) return slot->segGrid;
+  
+  TileSegmentGrid* grid = (TileSegmentGrid*)ps_calloc(1, sizeof(TileSegmentGrid), AllocPref::PreferPSRAM, "map.seg");
+  if (!grid) return nullptr;
+  
+  // Pass 1: size each cell's bucket
+  const uint16_t version = _currentMap.header.version;
+  uint32_t counts[SEG_GRID_DIM * SEG_GRID_DIM] = {0};
+  uint16_t featureCount = 0;
+  MapTileReader reader(tileData, tileDataSize, version);
+  MapFeatureInfo info;
+  uint16_t qLat, qLon, pLat, pLon;
+  uint8_t r0, r1, c0, c1;
+  while (reader.next(info)) {
+    if (info.pointCount < 2 || contextFeatureClass(info.type) < 0) continue;
+    featureCount++;
+    if (!reader.point(pLat, pLon)) continue;
+    while (reader.point(qLat, qLon)) {
+      segmentCells(pLat, pLon, qLat, qLon, r0, r1, c0, c1);
+      for (uint8_t r = r0; r <= r1; r++) {
+        for (uint8_t c = c0; c <= c1; c++) counts[r * SEG_GRID_DIM + c]++;
+      }
+      pLat = qLat;
+      pLon = qLon;
+    }
+  }
+  
+  uint32_t total = 0;
+  for (uint16_t c = 0; c < SEG_GRID_DIM * SEG_GRID_DIM; c++) {
+    grid->cellStart[c] = total;
+    total += counts[c];
+  }
+  grid->cellStart[SEG_GRID_DIM * SEG_GRID_DIM] = total;
+  
+  if (featureCount > 0) {
+    grid->features = (TileSegFeature*)ps_alloc(sizeof(TileSegFeature) * featureCount,
+                                                AllocPref::PreferPSRAM, "map.seg.feat");
+  }
+  if (total > 0) {
+    grid->segments = (TileSegment*)ps_alloc(sizeof(TileSegment) * total, AllocPref::PreferPSRAM, "map.seg.list");
+  }
+  if ((featureCount > 0 && !grid->features) || (total > 0 && !grid->segments)) {
+    free(grid->features);
+    free(grid->segments);
+    free(grid);
+    return nullptr;
+  }
+  
+  // Pass 2: fill the buckets (counts[] becomes each cell's write cursor)
+  for (uint16_t c = 0; c < SEG_GRID_DIM * SEG_GRID_DIM; c++) counts[c] = grid->cellStart[c];
+  MapTileReader fill(tileData, tileDataSize, version);
+  uint16_t feature = 0;
+  while (feature < featureCount && fill.next(info)) {
+    if (info.pointCount < 2 || contextFeatureClass(info.type) < 0) continue;
+    grid->features[feature].nameIndex = info.nameIndex;
+    grid->features[feature].type = info.type;
+    if (fill.point(pLat, pLon)) {
+      while (fill.point(qLat, qLon)) {
+        TileSegment seg = {feature, pLat, pLon, qLat, qLon};
+        segmentCells(pLat, pLon, qLat, qLon, r0, r1, c0, c1);
+        for (uint8_t r = r0; r <= r1; r++) {
+          for (uint8_t c = c0; c <= c1; c++) grid->segments[counts[r * SEG_GRID_DIM + c]++] = seg;
+        }
+        pLat = qLat;
+        pLon = qLon;
+      }
+    }
+    feature++;
+  }
+  grid->featureCount = featureCount;
+  
+  slot->segGrid = grid;
+  DEBUG_MAPS_RENDERINGF("[MAPS] tile %u segment grid: %u features, %lu cell entries",
+                        tileIdx, featureCount, (unsigned long)total);
+  return grid;
+}
+
+int MapCore::searchNamesByPrefix(const char* prefix, const char** results, int maxResults) {
+  if (!results || maxResults <= 0) return 0;
+  
+  uint32_t first = 0;
+  uint32_t matches = findNamePrefixRange(prefix, &first);
+  int count = (matches < (uint32_t)maxResults) ? (int)matches : maxResults;
+  for (int i = 0; i < count; i++) {
+    results[i] = getName(_currentMap.nameSorted[first + i]);
+  }
+  return count;
+}
+
+uint32_t MapCore::findNamePrefixRange(const char* prefix, uint32_t* outFirst) {
+  if (outFirst) *outFirst = 0;
+  if (!_currentMap.valid || !_currentMap.nameSorted || _currentMap.nameCount == 0) return 0;
+  if (!prefix || prefix[0] == '\0') return _currentMap.nameCount;
+  
+  // Comparing only the first prefixLen characters is monotonic over the
+  // case-folded sort order, so matches form one contiguous run
+  size_t prefixLen = strlen(prefix);
+  uint32_t lo = 0, hi = _currentMap.nameCount;
+  while (lo < hi) {
+    uint32_t mid = (lo + hi) / 2;
+    if (strncasecmp(getName(_currentMap.nameSorted[mid]), prefix, prefixLen) < 0) lo = mid + 1;
+    else hi = mid;
+  }
+  uint32_t first = lo;
+  hi = _currentMap.nameCount;
+  while (lo < hi) {
+    uint32_t mid = (lo + hi) / 2;
+    if (strncasecmp(getName(_currentMap.nameSorted[mid]), prefix, prefixLen) <= 0) lo = mid + 1;
+    else hi = mid;
+  }
+  if (outFirst) *outFirst = first;
+  return lo - first;
+}
+
+uint16_t MapCore::getSortedNameIndex(uint32_t sortedPos) {
+  if (!_currentMap.nameSorted || sortedPos >= _currentMap.nameCount) return HWMAP_NO_NAME;
+  return _currentMap.nameSorted[sortedPos];
+}
+
+// One pass over every tile collecting (name, tile, offset), then a counting
+// sort into per-name ranges
+bool MapCore::buildNameRefs() {
+  if (_currentMap.nameRefStart) return true;
+  if (!_currentMap.valid || !_currentMap.tileDir || _currentMap.nameCount == 0) return false;
+  
+  struct PendingRef { uint16_t nameIndex; uint16_t tileIdx; uint32_t offset; };
+  PendingRef* pending = nullptr;
+  uint32_t pendingCount = 0, pendingCap = 0;
+  uint32_t startMs = millis();
+  
+  for (uint16_t tileIdx = 0; tileIdx < _currentMap.tileCount; tileIdx++) {
+    size_t tileDataSize;
+    const uint8_t* tileData = loadTileData(tileIdx, &tileDataSize);
+    if (!tileData || tileDataSize < 2) continue;
+    
+    MapTileReader reader(tileData, tileDataSize, _currentMap.header.version);
+    MapFeatureInfo info;
+    while (reader.next(info)) {
+      uint16_t nameIndex = info.nameIndex;
+      if (nameIndex < _currentMap.nameCount) {
+        if (pendingCount == pendingCap) {
+          uint32_t newCap = pendingCap ? pendingCap * 2 : 256;
+          PendingRef* grown = (PendingRef*)ps_realloc(pending, sizeof(PendingRef) * newCap,
+                                                      AllocPref::PreferPSRAM, "map.namerefs");
+          if (!grown) {
+            free(pending);
+            ERROR_SENSORSF("Out of memory building name references (%u refs)", pendingCount);
+            return false;
+          }
+          pending = grown;
+          pendingCap = newCap;
+        }
+        pending[pendingCount++] = {nameIndex, tileIdx, info.offset};
+      }
+    }
+  }
+  
+  uint32_t* start = (uint32_t*)ps_calloc(_currentMap.nameCount + 1, sizeof(uint32_t),
+                                         AllocPref::PreferPSRAM, "map.namerefs");
+  MapNameRef* refs = pendingCount ? (MapNameRef*)ps_alloc(sizeof(MapNameRef) * pendingCount,
+                                                          AllocPref::PreferPSRAM, "map.namerefs") : nullptr;
+  if (!start || (pendingCount && !refs)) {
+    free(start); free(refs); free(pending);
+    ERROR_SENSORSF("Out of memory building name references (%u refs)", pendingCount);
+    return false;
+  }
+  
+  for (uint32_t i = 0; i < pendingCount; i++) start[pending[i].nameIndex + 1]++;
+  for (uint16_t n = 0; n < _currentMap.nameCount; n++) start[n + 1] += start[n];
+  // Fill using start[] as a cursor, then shift back; keeps tile order within a name
+  for (uint32_t i = 0; i < pendingCount; i++) {
+    uint32_t slot = start[pending[i].nameIndex]++;
+    refs[slot].tileIdx = pending[i].tileIdx;
+    refs[slot].offset = pending[i].offset;
+  }
+  for (uint16_t n = _currentMap.nameCount; n > 0; n--) start[n] = start[n - 1];
+  start[0] = 0;
+  free(pending);
+  
+  _currentMap.nameRefStart = start;
+  _currentMap.nameRefs = refs;
+  _currentMap.nameRefCount = pendingCount;
+  INFO_SENSORSF("Name references: %u features for %u names in %lums",
+                pendingCount, _currentMap.nameCount, (unsigned long)(millis() - startMs));
+  return true;
+}
+
+int MapCore::findFeaturesByName(uint16_t nameIndex, MapNameRef* results, int maxResults) {
+  MapCacheGuard cacheGuard("MapCore.findFeaturesByName");
+  if (!results || maxResults <= 0 || nameIndex >= _currentMap.nameCount) return 0;
+  if (!buildNameRefs()) return 0;
+  
+  uint32_t first = _currentMap.nameRefStart[nameIndex];
+  uint32_t last = _currentMap.nameRefStart[nameIndex + 1];
+  int count = 0;
+  for (uint32_t i = first; i < last && count < maxResults; i++) {
+    results[count++] = _currentMap.nameRefs[i];
+  }
+  return count;
+}
+
+bool MapCore::isPositionInMap(float lat, float lon) {
+  if (!_currentMap.valid) return false;
+  
+  int32_t latMicro = (int32_t)(lat * 1000000);
+  int32_t lonMicro = (int32_t)(lon * 1000000);
+  
+  return (latMicro >= _currentMap.header.minLat &&
+          latMicro <= _currentMap.header.maxLat &&
+          lonMicro >= _currentMap.header.minLon &&
+          lonMicro <= _currentMap.header.maxLon);
+}
+
+int MapCore::getAvailableMaps(char maps[][96], int maxMaps) {
+  int count = 0;
+
+  FsLockGuard fsGuard("MapCore.getAvailableMaps");
+  
+  if (!LittleFS.exists("/maps")) {
+    return 0;
+  }
+  
+  File dir = LittleFS.open("/maps");
+  if (!dir || !dir.isDirectory()) {
+    if (dir) dir.close();
+    return 0;
+  }
+  
+  File entry = dir.openNextFile();
+  while (entry && count < maxMaps) {
+    if (entry.isDirectory()) {
+      String dirName = String(entry.name());
+      if (dirName.startsWith("/maps/")) dirName = dirName.substring(6);
+      if (dirName.startsWith("/")) dirName = dirName.substring(1);
+      if (dirName.length() > 0 && dirName.indexOf('/') == -1) {
+        char subPathBuf[64];
+        snprintf(subPathBuf, sizeof(subPathBuf), "/maps/%s", dirName.c_str());
+        String subPath = subPathBuf;
+        File sub = LittleFS.open(subPath);
+        if (sub && sub.isDirectory()) {
+          String preferred = dirName + ".hwmap";
+          String found = "";
+          File f = sub.openNextFile();
+          while (f) {
+            if (!f.isDirectory()) {
+              String fn = String(f.name());
+              String prefix = subPath + "/";
+              if (fn.startsWith(prefix)) fn = fn.substring(prefix.length());
+              if (fn.indexOf('/') == -1) {
+                if (fn.length() > 6 && fn.substring(fn.length() - 6).equalsIgnoreCase(".hwmap")) {
+                  if (fn == preferred) { found = fn; break; }
+                  if (found.length() == 0) found = fn;
+                }
+              }
+            }
+            f = sub.openNextFile();
+          }
+          sub.close();
+          if (found.length() > 0) {
+            String rel = dirName + "/" + found;
+            strncpy(maps[count], rel.c_str(), 95);
+            maps[count][95] = '\0';
+            count++;
+          }
+        } else {
+          if (sub) sub.close();
+        }
+      }
+    }
+    entry = dir.openNextFile();
+  }
+  dir.close();
+  
+  return count;
+}
+
+// =============================================================================
+// MapCore - Display-Agnostic Rendering
+// =============================================================================
+
+void MapCore::geoToScreen(int32_t lat, int32_t lon,
+                          int32_t centerLat, int32_t centerLon,
+                          int32_t scaleX, int32_t scaleY,
+                          int viewWidth, int viewHeight,
+                          int16_t& screenX, int16_t& screenY) {
+  // Center of viewport
+  const int16_t cx = viewWidth / 2;
+  const int16_t cy = viewHeight / 2;
+  
+  // Delta from center in microdegrees
+  int32_t dLon = lon - centerLon;
+  int32_t dLat = lat - centerLat;
+  
+  // Convert to screen pixels (scaleX/Y = microdegrees per pixel)
+  float x = (float)dLon / (float)scaleX;
+  float y = -(float)dLat / (float)scaleY;  // Y is inverted (north = up)
+  
+  // Apply rotation around center if rotation is set
+  if (gMapRotation != 0.0f) {
+    float rad = gMapRotation * PI / 180.0f;
+    float cosR = cosf(rad);
+    float sinR = sinf(rad);
+    float rx = x * cosR - y * sinR;
+    float ry = x * sinR + y * cosR;
+    x = rx;
+    y = ry;
+  }
+  
+  screenX = cx + (int16_t)x;
+  screenY = cy + (int16_t)y;
+}
+
+struct MapLayerView {
+  int32_t scaleX, scaleY;
+  int minTileX, maxTileX, minTileY, maxTileY, tileStep;
+  int32_t cullMinLat, cullMaxLat, cullMinLon, cullMaxLon;
+  
+  // Viewport transform (renderMap): float, optional rotation, +-50 px segment test
+  int32_t centerLatMicro, centerLonMicro;
+  float invScaleX, invScaleY, cosR, sinR;
+  bool hasRotation;
+  int16_t cx, cy;
+  int viewWidth, viewHeight;
+  
+  // World-pixel transform (renderMapLayer): integer floor, exact clip rect test
+  bool worldGrid;
+  int32_t originLon, originLatTop;  // Microdegrees of renderer pixel (0, 0)'s top-left
+  int32_t clipX0, clipY0, clipX1, clipY1;
+};
+
+struct MapLayerCounts {
+  int totalFeatures, totalDrawn, tilesLoaded, tilesEmpty;
+  int tilesTypeCulled, featuresBoxCulled, tilesSimplified;
+  uint32_t pointsSkipped, bytesDecoded, tileIOUs;
+};
+
+// Floor division for a positive divisor (world pixels must not round toward 0)
+static inline int32_t mapFloorDiv(int32_t a, int32_t b) {
+  int32_t q = a / b;
+  return (a % b != 0 && a < 0) ? q - 1 : q;
+}
+
+void MapCore::scaleForZoom(float zoom, int32_t& scaleX, int32_t& scaleY) {
+  const int32_t baseScaleY = 188;   // Microdegrees per pixel (latitude) at 1x
+  const int32_t baseScaleX = 246;   // Microdegrees per pixel (longitude) at 1x
+  scaleY = (int32_t)(baseScaleY / zoom);
+  scaleX = (int32_t)(baseScaleX / zoom);
+  if (scaleX < 10) scaleX = 10;
+  if (scaleY < 10) scaleY = 10;
+}
+
+// Thread-safe renderMap: all mutable state comes from params, no global reads
+void MapCore::renderMap(MapRenderer* renderer, float centerLat, float centerLon,
+                        const MapRenderParams& params, MapRenderStats* stats) {
+  MapCacheGuard cacheGuard("MapCore.renderMap");
+  if (!_currentMap.valid || !renderer || !_currentMap.tileDir) {
+    DEBUG_MAPS_RENDERINGF("[MAPS] renderMap early exit: valid=%d renderer=%p tileDir=%p",
+                          _currentMap.valid, renderer, _currentMap.tileDir);
+    return;
+  }
+  
+  const float zoom = params.zoom;
+  const float rotation = params.rotation;
+  
+  const uint32_t perfStart = millis();
+  const uint32_t perfStartUs = micros();
+  const uint32_t hitsBefore = _currentMap.cacheHits;
+  const uint32_t missesBefore = _currentMap.cacheMisses;
+  const uint32_t readBefore = _currentMap.bytesRead;
+  
+  MapLayerView view = {};
+  view.viewWidth = renderer->getWidth();
+  view.viewHeight = renderer->getHeight();
+  const int viewWidth = view.viewWidth;
+  const int viewHeight = view.viewHeight;
+  
+  // Convert center to microdegrees
+  int32_t centerLatMicro = (int32_t)(centerLat * 1000000);
+  int32_t centerLonMicro = (int32_t)(centerLon * 1000000);
+  view.centerLatMicro = centerLatMicro;
+  view.centerLonMicro = centerLonMicro;
+  
+  // Calculate scale: how many microdegrees per pixel
+  scaleForZoom(zoom, view.scaleX, view.scaleY);
+  const int32_t scaleX = view.scaleX;
+  const int32_t scaleY = view.scaleY;
+  
+  // Pre-compute values for fast coordinate transform (avoids per-point division + trig)
+  view.invScaleX = 1.0f / (float)scaleX;
+  view.invScaleY = 1.0f / (float)scaleY;
+  view.cx = viewWidth / 2;
+  view.cy = viewHeight / 2;
+  view.hasRotation = (rotation != 0.0f);
+  view.cosR = 1.0f;
+  view.sinR = 0.0f;
+  if (view.hasRotation) {
+    float rad = rotation * (float)PI / 180.0f;
+    view.cosR = cosf(rad);
+    view.sinR = sinf(rad);
+  }
+  
+  // Calculate visible tile range based on viewport
+  int32_t viewHalfWidth = (viewWidth / 2) * scaleX;
+  int32_t viewHalfHeight = (viewHeight / 2) * scaleY;
+  int32_t viewMinLon = centerLonMicro - viewHalfWidth;
+  int32_t viewMaxLon = centerLonMicro + viewHalfWidth;
+  int32_t viewMinLat = centerLatMicro - viewHalfHeight;
+  int32_t viewMaxLat = centerLatMicro + viewHalfHeight;
+  
+  // Determine which tiles intersect the viewport
+  int minTileX = (viewMinLon - _currentMap.header.minLon) / _currentMap.tileW;
+  int maxTileX = (viewMaxLon - _currentMap.header.minLon) / _currentMap.tileW;
+  int minTileY = (viewMinLat - _currentMap.header.minLat) / _currentMap.tileH;
+  int maxTileY = (viewMaxLat - _currentMap.header.minLat) / _currentMap.tileH;
+  
+  // Clamp to valid tile range
+  int rawMinTX = minTileX, rawMaxTX = maxTileX, rawMinTY = minTileY, rawMaxTY = maxTileY;
+  if (minTileX < 0) minTileX = 0;
+  if (maxTileX >= _currentMap.tileGridSize) maxTileX = _currentMap.tileGridSize - 1;
+  if (minTileY < 0) minTileY = 0;
+  if (maxTileY >= _currentMap.tileGridSize) maxTileY = _currentMap.tileGridSize - 1;
+  
+  // If viewport spans more tiles than cache can hold, use stride to prevent thrashing.
+  // At low zoom on the OLED, each tile is only a few pixels — small gaps are invisible.
+  int tileStep = 1;
+  int numTilesX = maxTileX - minTileX + 1;
+  int numTilesY = maxTileY - minTileY + 1;
+  if (_currentMap.numSlots > 0) {
+    while (((numTilesX + tileStep - 1) / tileStep) * ((numTilesY + tileStep - 1) / tileStep) > (int)_currentMap.numSlots && tileStep < 6) {
+      tileStep++;
+    }
+  }
+  view.minTileX = minTileX;
+  view.maxTileX = maxTileX;
+  view.minTileY = minTileY;
+  view.maxTileY = maxTileY;
+  view.tileStep = tileStep;
+  
+  DEBUG_MAPS_RENDERINGF("[MAPS] render: center=%.5f,%.5f zoom=%.2f scale=%ld,%ld grid=%d tiles=%d-%d/%d-%d (raw %d-%d/%d-%d) step=%d",
+                        centerLat, centerLon, zoom, (long)scaleX, (long)scaleY,
+                        _currentMap.tileGridSize,
+                        minTileX, maxTileX, minTileY, maxTileY,
+                        rawMinTX, rawMaxTX, rawMinTY, rawMaxTY, tileStep);
+
+  // Feature cull window: everything the per-segment test could accept
+  // (screen +-50 px, plus a pixel for truncation). Rotation can bring any point
+  // within the half-diagonal on screen, so use that radius on both axes.
+  int32_t cullPxX = view.cx + 52;
+  int32_t cullPxY = view.cy + 52;
+  if (view.hasRotation) {
+    int32_t r = (int32_t)ceilf(sqrtf((float)(cullPxX * cullPxX + cullPxY * cullPxY)));
+    cullPxX = r;
+    cullPxY = r;
+  }
+  view.cullMinLon = centerLonMicro - cullPxX * scaleX;
+  view.cullMaxLon = centerLonMicro + cullPxX * scaleX;
+  view.cullMinLat = centerLatMicro - cullPxY * scaleY;
+  view.cullMaxLat = centerLatMicro + cullPxY * scaleY;
+  
+  MapLayerCounts counts = {};
+  if (!renderFeatures(renderer, params, view, counts)) return;
+  
+  DEBUG_MAPS_RENDERINGF("[MAPS] render done: %d tiles loaded, %d empty, %d type-culled, %d features (%d box-culled), %d lines drawn",
+                        counts.tilesLoaded, counts.tilesEmpty, counts.tilesTypeCulled,
+                        counts.totalFeatures, counts.featuresBoxCulled, counts.totalDrawn);
+  DEBUG_MAPS_RENDERINGF("[MAPS] render LOD: %d tiles simplified, %lu points skipped",
+                        counts.tilesSimplified, (unsigned long)counts.pointsSkipped);
+
+  renderMapOverlays(renderer, centerLat, centerLon, params);
+  
+  uint32_t perfTotal = millis() - perfStart;
+  if (stats) {
+    stats->frameUs = micros() - perfStartUs;
+    stats->tileIOUs = counts.tileIOUs;
+    stats->tilesLoaded = counts.tilesLoaded;
+    stats->features = counts.totalFeatures;
+    stats->linesDrawn = counts.totalDrawn;
+    stats->cacheHits = _currentMap.cacheHits - hitsBefore;
+    stats->cacheMisses = _currentMap.cacheMisses - missesBefore;
+    stats->bytesRead = _currentMap.bytesRead - readBefore;
+    stats->bytesDecoded = counts.bytesDecoded;
+  }
+  DEBUG_MAPS_PERFF("[MAP_PERF] render: %lums total | tileIO: %luus | tiles:%d feat:%d lines:%d | zoom:%.2f viewport:%dx%d",
+                   (unsigned long)perfTotal, (unsigned long)counts.tileIOUs,
+                   counts.tilesLoaded, counts.totalFeatures, counts.totalDrawn, zoom, viewWidth, viewHeight);
+}
+
+bool MapCore::renderMapLayer(MapRenderer* renderer, int32_t originX, int32_t originY,
+                             int16_t clipX0, int16_t clipY0, int16_t clipX1, int16_t clipY1,
+                             const MapRenderParams& params) {
+  MapCacheGuard cacheGuard("MapCore.renderMapLayer");
+  if (!_currentMap.valid || !renderer || !_currentMap.tileDir) return false;
+  if (clipX0 >= clipX1 || clipY0 >= clipY1) return true;
+  
+  MapLayerView view = {};
+  view.worldGrid = true;
+  scaleForZoom(params.zoom, view.scaleX, view.scaleY);
+  const int32_t scaleX = view.scaleX;
+  const int32_t scaleY = view.scaleY;
+  view.originLon = (int32_t)((int64_t)originX * scaleX);
+  view.originLatTop = (int32_t)(-(int64_t)originY * scaleY);
+  view.clipX0 = clipX0;
+  view.clipY0 = clipY0;
+  view.clipX1 = clipX1;
+  view.clipY1 = clipY1;
+  view.viewWidth = renderer->getWidth();
+  view.viewHeight = renderer->getHeight();
+  
+  // Cull window: the clip rect in microdegrees, plus a pixel of slack
+  view.cullMinLon = view.originLon + (clipX0 - 1) * scaleX;
+  view.cullMaxLon = view.originLon + (clipX1 + 1) * scaleX;
+  view.cullMaxLat = view.originLatTop - (clipY0 - 1) * scaleY;
+  view.cullMinLat = view.originLatTop - (clipY1 + 1) * scaleY;
+  
+  // Every tile whose halo box reaches the window. Quantization keeps a tile's
+  // features inside its halo box, so no other tile can touch the clip rect.
+  const int32_t mapMinLon = _currentMap.header.minLon;
+  const int32_t mapMinLat = _currentMap.header.minLat;
+  view.minTileX = mapFloorDiv(view.cullMinLon - mapMinLon - _currentMap.haloW, _currentMap.tileW) - 1;
+  view.maxTileX = mapFloorDiv(view.cullMaxLon - mapMinLon + _currentMap.haloW, _currentMap.tileW);
+  view.minTileY = mapFloorDiv(view.cullMinLat - mapMinLat - _currentMap.haloH, _currentMap.tileH) - 1;
+  view.maxTileY = mapFloorDiv(view.cullMaxLat - mapMinLat + _currentMap.haloH, _currentMap.tileH);
+  if (view.minTileX < 0) view.minTileX = 0;
+  if (view.maxTileX >= _currentMap.tileGridSize) view.maxTileX = _currentMap.tileGridSize - 1;
+  if (view.minTileY < 0) view.minTileY = 0;
+  if (view.maxTileY >= _currentMap.tileGridSize) view.maxTileY = _currentMap.tileGridSize - 1;
+  view.tileStep = 1;
+  
+  // No stride here (it would make the output depend on the rect), so refuse instead
+  if (view.maxTileX >= view.minTileX && view.maxTileY >= view.minTileY && _currentMap.numSlots > 0 &&
+      (view.maxTileX - view.minTileX + 1) * (view.maxTileY - view.minTileY + 1) > (int)_currentMap.numSlots) {
+    DEBUG_MAPS_RENDERINGF("[MAPS] layer: tiles %d-%d/%d-%d exceed %u cache slots",
+                          view.minTileX, view.maxTileX, view.minTileY, view.maxTileY,
+                          (unsigned)_currentMap.numSlots);
+    return false;
+  }
+  
+  MapLayerCounts counts = {};
+  if (!renderFeatures(renderer, params, view, counts)) return false;
+  
+  DEBUG_MAPS_RENDERINGF("[MAPS] layer: origin=%ld,%ld clip=%d,%d-%d,%d tiles=%d features=%d lines=%d",
+                        (long)originX, (long)originY, clipX0, clipY0, clipX1, clipY1,
+                        counts.tilesLoaded, counts.totalFeatures, counts.totalDrawn);
+  return true;
+}
+
+void MapCore::renderMapOverlays(MapRenderer* renderer, float centerLat, float centerLon,
+                                const MapRenderParams& params) {
+  // Route points and the highlight are written by the CLI task under this lock
+  MapCacheGuard cacheGuard("MapCore.renderMapOverlays");
+  if (!params.liveOverlays) return;
+  int32_t scaleX, scaleY;
+  scaleForZoom(params.zoom, scaleX, scaleY);
+  
+  // Computed route goes over the features while its highlight is showing
+  if (gMapHighlight.mode == HIGHLIGHT_ROUTE && mapHighlightIsVisible()) {
+    MapRouter::renderRoute(renderer, (int32_t)(centerLat * 1000000), (int32_t)(centerLon * 1000000),
+                           scaleX, scaleY, params.rotation);
+  }
+  
+  // Draw waypoints on map
+  WaypointManager::renderWaypoints(renderer, centerLat, centerLon, scaleX, scaleY);
+  
+  // Draw GPS position marker at center
+  renderer->drawPositionMarker(renderer->getWidth() / 2, renderer->getHeight() / 2);
+}
+
+// Feature pass shared by renderMap and renderMapLayer. Returns false if the map
+// was unloaded mid-render.
+bool MapCore::renderFeatures(MapRenderer* renderer, const MapRenderParams& params,
+                             const MapLayerView& view, MapLayerCounts& counts) {
+  const float zoom = params.zoom;
+  const int32_t scaleX = view.scaleX;
+  const int32_t scaleY = view.scaleY;
+  const int32_t cullMinLat = view.cullMinLat, cullMaxLat = view.cullMaxLat;
+  const int32_t cullMinLon = view.cullMinLon, cullMaxLon = view.cullMaxLon;
+  
+  // Tiles whose types are all hidden at this zoom/layer setting are skipped unread
+  const uint16_t visibleTypeMask = paramVisibleTypeMask(params, zoom);
+  
+  // Screen position of a point in the pass's pixel space
+  auto project = [&view](int32_t lat, int32_t lon, int32_t& x, int32_t& y) {
+    if (view.worldGrid) {
+      x = mapFloorDiv(lon - view.originLon, view.scaleX);
+      y = mapFloorDiv(view.originLatTop - lat, view.scaleY);
+      return;
+    }
+    float fx = (float)(lon - view.centerLonMicro) * view.invScaleX;
+    float fy = -(float)(lat - view.centerLatMicro) * view.invScaleY;
+    if (view.hasRotation) { float rx = fx*view.cosR - fy*view.sinR; fy = fx*view.sinR + fy*view.cosR; fx = rx; }
+    x = (int16_t)(view.cx + (int16_t)fx);
+    y = (int16_t)(view.cy + (int16_t)fy);
+  };
+
+  // Iterate through visible tiles (with stride to cap tile count within cache budget)
+  for (int ty = view.minTileY; ty <= view.maxTileY; ty += view.tileStep) {
+    for (int tx = view.minTileX; tx <= view.maxTileX; tx += view.tileStep) {
+      uint16_t tileIdx = ty * _currentMap.tileGridSize + tx;
+      if (tileIdx >= _currentMap.tileCount) continue;
+      
+      // Bail early if map was unloaded mid-render (async safety)
+      if (!_currentMap.valid) return false;
+      
+      HWMapTileDirEntry& tile = _currentMap.tileDir[tileIdx];
+      if (tile.payloadSize == 0) { counts.tilesEmpty++; continue; }
+      if (_currentMap.tileTypeMask && !(_currentMap.tileTypeMask[tileIdx] & visibleTypeMask)) {
+        counts.tilesTypeCulled++;
+        continue;
+      }
+      
+      // Calculate tile halo bounds for dequantization
+      int32_t tileMinLon = _currentMap.header.minLon + tx * _currentMap.tileW - _currentMap.haloW;
+      int32_t tileMaxLon = _currentMap.header.minLon + (tx + 1) * _currentMap.tileW + _currentMap.haloW;
+      int32_t tileMinLat = _currentMap.header.minLat + ty * _currentMap.tileH - _currentMap.haloH;
+      int32_t tileMaxLat = _currentMap.header.minLat + (ty + 1) * _currentMap.tileH + _currentMap.haloH;
+      int32_t haloLonSpan = tileMaxLon - tileMinLon;
+      int32_t haloLatSpan = tileMaxLat - tileMinLat;
+      
+      // Load tile data
+      size_t tileDataSize;
+      uint32_t tileIOStart = micros();
+      const uint8_t* tileData = loadTileData(tileIdx, &tileDataSize);
+      counts.tileIOUs += (uint32_t)(micros() - tileIOStart);
+      if (!tileData || tileDataSize == 0) {
+        DEBUG_MAPS_RENDERINGF("[MAPS] tile(%d,%d) idx=%u: loadTileData failed (ptr=%p size=%zu offset=%u payloadSize=%u)",
+                              tx, ty, tileIdx, tileData, tileDataSize, tile.offset, tile.payloadSize);
+        continue;
+      }
+      
+      if (tileDataSize < 2) continue;
+      MapTileReader reader(tileData, tileDataSize, _currentMap.header.version);
+      uint16_t featureCount = reader.featureCount();
+      counts.tilesLoaded++;
+      counts.bytesDecoded += tileDataSize;
+      counts.totalFeatures += featureCount;
+      
+      // With a feature index, jump straight to features whose bounds reach the view
+      uint16_t refCount = 0;
+      const TileFeatureRef* refs = getTileFeatureRefs(tileIdx, tileData, tileDataSize, &refCount);
+      if (refs) featureCount = refCount;
+      
+      // Coarsest simplified level whose error stays under MAP_LOD_MAX_ERROR_PX
+      const TileLod* lod = nullptr;
+      uint8_t lodLevel = 0;
+      if (refs) {
+        float qPerPxLon = (float)scaleX * 65536.0f / (float)haloLonSpan;
+        float qPerPxLat = (float)scaleY * 65536.0f / (float)haloLatSpan;
+        float maxError = (qPerPxLon < qPerPxLat ? qPerPxLon : qPerPxLat) * MAP_LOD_MAX_ERROR_PX;
+        float tolerance = MAP_LOD_BASE_TOLERANCE;
+        while (lodLevel < MAP_LOD_LEVELS && tolerance <= maxError) {
+          lodLevel++;
+          tolerance *= 4.0f;
+        }
+        if (lodLevel > 0) {
+          lod = getTileLod(tileIdx, tileData, tileDataSize);
+          if (lod) counts.tilesSimplified++;
+        }
+      }
+      
+      // Parse and render features in this tile
+      MapFeatureInfo info;
+      for (uint16_t f = 0; f < featureCount; f++) {
+        if (refs) {
+          const HWMapFeatureBox& box = refs[f].box;
+          if (tileMinLat + (int32_t)((int64_t)box.qMaxLat * haloLatSpan >> 16) < cullMinLat ||
+              tileMinLat + (int32_t)((int64_t)box.qMinLat * haloLatSpan >> 16) > cullMaxLat ||
+              tileMinLon + (int32_t)((int64_t)box.qMaxLon * haloLonSpan >> 16) < cullMinLon ||
+              tileMinLon + (int32_t)((int64_t)box.qMinLon * haloLonSpan >> 16) > cullMaxLon) {
+            counts.featuresBoxCulled++;
+            continue;
+          }
+          if (!reader.seek(refs[f].offset, info)) continue;
+        } else if (!reader.next(info)) {
+          break;
+        }
+        
+        uint8_t ftype = info.type;
+        uint8_t fsubtype = info.subtype;
+        uint16_t nameIndex = info.nameIndex;
+        uint16_t pointCount = info.pointCount;
+        
+        if (pointCount < 2) continue;
+        
+        // Check layer visibility (uses snapshot, not globals)
+        if (!paramLayerIsVisible(params, ftype)) {
+          continue;
+        }
+        
+        // Check per-subtype visibility (uses snapshot)
+        if (!paramSubtypeIsVisible(params, ftype, fsubtype)) {
+          continue;
+        }
+        
+        // Subtype-based LOD: hide less important subtypes at low zoom
+        if (ftype == MAP_FEATURE_ROAD_MINOR && fsubtype == SUBTYPE_MINOR_SERVICE && zoom < LOD_ZOOM_SERVICE_ROAD) {
+          continue;
+        }
+        if (ftype == MAP_FEATURE_PATH && fsubtype == SUBTYPE_PATH_TRACK && zoom < LOD_ZOOM_TRACK) {
+          continue;
+        }
+        
+        // LOD culling - progressively hide features at lower zoom levels
+        if (!lodTypeIsVisible(ftype, zoom)) {
+          continue;
+        }
+        
+        // Subtype-level filtering (renderer can skip specific type+subtype combos)
+        if (!renderer->shouldRenderFeature(ftype, fsubtype)) {
+          continue;
+        }
+        
+        // Get style
+        MapFeatureStyle style = renderer->getFeatureStyle((MapFeatureType)ftype);
+        if (!style.render || style.lineStyle == LINE_NONE) {
+          continue;
+        }
+        
+        // Check highlighting
+        bool isHighlighted = params.liveOverlays && mapHighlightMatches(nameIndex, ftype);
+        if (isHighlighted && !mapHighlightIsVisible()) {
+          continue;
+        }
+        
+        // Points come from the simplified level when one applies, else the tile
+        const uint16_t* lodPts = nullptr;
+        uint16_t lodLeft = 0;
+        if (lod) {
+          const TileLodSpan& span = lod->spans[(size_t)f * MAP_LOD_LEVELS + lodLevel - 1];
+          lodPts = lod->points + (size_t)span.start * 2;
+          lodLeft = span.count;
+          counts.pointsSkipped += pointCount - span.count;
+        }
+        auto nextPoint = [&](uint16_t& a, uint16_t& b) -> bool {
+          if (!lodPts) return reader.point(a, b);
+          if (lodLeft == 0) return false;
+          a = lodPts[0];
+          b = lodPts[1];
+          lodPts += 2;
+          lodLeft--;
+          return true;
+        };
+        
+        // Read and dequantize first point
+        uint16_t qLat, qLon;
+        if (!nextPoint(qLat, qLon)) continue;
+        
+        int32_t lat = tileMinLat + (int32_t)((int64_t)qLat * haloLatSpan >> 16);
+        int32_t lon = tileMinLon + (int32_t)((int64_t)qLon * haloLonSpan >> 16);
+        
+        int32_t prevX, prevY;
+        project(lat, lon, prevX, prevY);
+        
+        // Process remaining points
+        while (nextPoint(qLat, qLon)) {
+          lat = tileMinLat + (int32_t)((int64_t)qLat * haloLatSpan >> 16);
+          lon = tileMinLon + (int32_t)((int64_t)qLon * haloLonSpan >> 16);
+          
+          int32_t curX, curY;
+          project(lat, lon, curX, curY);
+          
+          bool visible;
+          if (view.worldGrid) {
+            // Segment box against the clip rect (ends beyond int16 are dropped)
+            visible = (prevX > curX ? prevX : curX) >= view.clipX0 &&
+                      (prevX < curX ? prevX : curX) < view.clipX1 &&
+                      (prevY > curY ? prevY : curY) >= view.clipY0 &&
+                      (prevY < curY ? prevY : curY) < view.clipY1 &&
+                      prevX >= INT16_MIN && prevX <= INT16_MAX && curX >= INT16_MIN && curX <= INT16_MAX &&
+                      prevY >= INT16_MIN && prevY <= INT16_MAX && curY >= INT16_MIN && curY <= INT16_MAX;
+          } else {
+            // Simple visibility check
+            visible = (prevX >= -50 && prevX < view.viewWidth + 50 &&
+                       prevY >= -50 && prevY < view.viewHeight + 50) ||
+                      (curX >= -50 && curX < view.viewWidth + 50 &&
+                       curY >= -50 && curY < view.viewHeight + 50);
+          }
+          
+          if (visible) {
+            renderer->drawLine((int16_t)prevX, (int16_t)prevY, (int16_t)curX, (int16_t)curY, style);
+            counts.totalDrawn++;
+          }
+          
+          prevX = curX;
+          prevY = curY;
+        }
+      }
+    }
+  }
+  return true;
+}
+
+// =============================================================================
+// OffscreenMapRenderer Implementation (1-bit framebuffer for async rendering)
+// =============================================================================
+
+OffscreenMapRenderer::OffscreenMapRenderer(uint8_t* buffer, int width, int height, int offsetY)
+  : _buffer(buffer), _offsetY(offsetY) {
+  _width = width;
+  _height = height;
+}
+
+void OffscreenMapRenderer::setViewport(int width, int height) {
+  _width = width;
+  _height = height;
+}
+
+void OffscreenMapRenderer::clear() {
+  if (_buffer) memset(_buffer, 0, OFFSCREEN_BUF_SIZE);
+}
+
+// SSD1306-compatible pixel layout: byte = 8 vertical pixels, LSB = top
+void OffscreenMapRenderer::drawPixel(int16_t x, int16_t y) {
+  int16_t ay = y + _offsetY;
+  if (x < 0 || x >= 128 || ay < 0 || ay >= 64) return;
+  _buffer[x + (ay / 8) * 128] |= (1 << (ay & 7));
+}
+
+bool OffscreenMapRenderer::clipLine(int16_t& x0, int16_t& y0, int16_t& x1, int16_t& y1) {
+  // Cohen-Sutherland clipping to [0, _offsetY] .. [_width-1, _offsetY+_height-1]
+  const int16_t xmin = 0, ymin = _offsetY, xmax = _width - 1, ymax = _offsetY + _height - 1;
+  
+  auto outcode = [&](int16_t x, int16_t y) -> int {
+    int code = 0;
+    if (x < xmin) code |= 1;
+    else if (x > xmax) code |= 2;
+    if (y < ymin) code |= 4;
+    else if (y > ymax) code |= 8;
+    return code;
+  };
+  
+  int code0 = outcode(x0, y0);
+  int code1 = outcode(x1, y1);
+  
+  for (int iter = 0; iter < 10; iter++) {
+    if (!(code0 | code1)) return true;
+    if (code0 & code1) return false;
+    
+    int codeOut = code0 ? code0 : code1;
+    int16_t x, y;
+    int32_t dx = x1 - x0, dy = y1 - y0;
+    
+    if (codeOut & 8) {
+      x = (dy != 0) ? (int16_t)(x0 + dx * (int32_t)(ymax - y0) / dy) : x0;
+      y = ymax;
+    } else if (codeOut & 4) {
+      x = (dy != 0) ? (int16_t)(x0 + dx * (int32_t)(ymin - y0) / dy) : x0;
+      y = ymin;
+    } else if (codeOut & 2) {
+      y = (dx != 0) ? (int16_t)(y0 + dy * (int32_t)(xmax - x0) / dx) : y0;
+      x = xmax;
+    } else {
+      y = (dx != 0) ? (int16_t)(y0 + dy * (int32_t)(xmin - x0) / dx) : y0;
+      x = xmin;
+    }
+    
+    if (codeOut == code0) {
+      x0 = x; y0 = y;
+      code0 = outcode(x0, y0);
+    } else {
+      x1 = x; y1 = y;
+      code1 = outcode(x1, y1);
+    }
+  }
+  return false;
+}
+
+void OffscreenMapRenderer::bresenhamLine(int16_t x0, int16_t y0, int16_t x1, int16_t y1) {
+  int16_t dx = abs(x1 - x0), sx = x0 < x1 ? 1 : -1;
+  int16_t dy = -abs(y1 - y0), sy = y0 < y1 ? 1 : -1;
+  int16_t err = dx + dy;
+  
+  for (;;) {
+    // Direct pixel set (already clipped)
+    int16_t ay = y0;  // y0 already includes _offsetY from clipLine
+    if (ay >= 0 && ay < 64 && x0 >= 0 && x0 < 128)
+      _buffer[x0 + (ay / 8) * 128] |= (1 << (ay & 7));
+    
+    if (x0 == x1 && y0 == y1) break;
+    int16_t e2 = 2 * err;
+    if (e2 >= dy) { err += dy; x0 += sx; }
+    if (e2 <= dx) { err += dx; y0 += sy; }
+  }
+}
+
+void OffscreenMapRenderer::drawDashedLine(int16_t x0, int16_t y0, int16_t x1, int16_t y1, int dashLen) {
+  int adx = abs(x1 - x0), ady = abs(y1 - y0);
+  int len = (adx > ady) ? (adx + ady / 2) : (ady + adx / 2);
+  if (len < 1) return;
+  
+  float invLen = 1.0f / len;
+  float dx = (x1 - x0) * invLen;
+  float dy = (y1 - y0) * invLen;
+  float x = x0, y = y0;
+  bool draw = true;
+  int segLen = 0;
+  
+  for (int t = 0; t < len; t++) {
+    if (draw) {
+      int16_t px = (int16_t)x, py = (int16_t)y;
+      if (px >= 0 && px < 128 && py >= 0 && py < 64)
+        _buffer[px + (py / 8) * 128] |= (1 << (py & 7));
+    }
+    x += dx; y += dy;
+    if (++segLen >= dashLen) { segLen = 0; draw = !draw; }
+  }
+}
+
+void OffscreenMapRenderer::drawDottedLine(int16_t x0, int16_t y0, int16_t x1, int16_t y1, int spacing) {
+  int adx = abs(x1 - x0), ady = abs(y1 - y0);
+  int len = (adx > ady) ? (adx + ady / 2) : (ady + adx / 2);
+  if (len < 1) return;
+  
+  float invLen = 1.0f / len;
+  float dx = (x1 - x0) * invLen;
+  float dy = (y1 - y0) * invLen;
+  
+  for (int t = 0; t <= len; t += spacing) {
+    int16_t px = x0 + (int16_t)(dx * t);
+    int16_t py = y0 + (int16_t)(dy * t);
+    if (px >= 0 && px < 128 && py >= 0 && py < 64)
+      _buffer[px + (py / 8) * 128] |= (1 << (py & 7));
+  }
+}
+
+void OffscreenMapRenderer::drawLine(int16_t x0, int16_t y0, int16_t x1, int16_t y1,
+                                     const MapFeatureStyle& style) {
+  if (!_buffer) return;
+  
+  // Apply content area offset
+  y0 += _offsetY;
+  y1 += _offsetY;
+  
+  // Clip to content area
+  if (!clipLine(x0, y0, x1, y1)) return;
+  
+  switch (style.lineStyle) {
+    case LINE_SOLID:
+      bresenhamLine(x0, y0, x1, y1);
+      break;
+    case LINE_DASHED:
+      drawDashedLine(x0, y0, x1, y1, 4);
+      break;
+    case LINE_DOTTED:
+      drawDottedLine(x0, y0, x1, y1, 3);
+      break;
+    case LINE_NONE:
+    default:
+      break;
+  }
+}
+
+void OffscreenMapRenderer::drawPositionMarker(int16_t x, int16_t y) {
+  if (!_buffer) return;
+  y += _offsetY;
+  
+  const int16_t ymin = _offsetY, ymax = _offsetY + _height - 1;
+  if (y < ymin || y > ymax) return;
+  
+  // Crosshair
+  MapFeatureStyle solid = {LINE_SOLID, 1, 15, true, 0xFFFF};
+  int16_t x0 = x - 4, x1 = x + 4;
+  int16_t yt = (y - 4 < ymin) ? ymin : y - 4;
+  int16_t yb = (y + 4 > ymax) ? ymax : y + 4;
+  
+  // Horizontal
+  int16_t cy0 = y, cy1 = y;
+  if (clipLine(x0, cy0, x1, cy1)) bresenhamLine(x0, cy0, x1, cy1);
+  // Vertical
+  int16_t cx0 = x, cx1 = x;
+  if (clipLine(cx0, yt, cx1, yb)) bresenhamLine(cx0, yt, cx1, yb);
+  
+  // Simple circle (midpoint algorithm, r=3)
+  if (y - 3 >= ymin && y + 3 <= ymax) {
+    int16_t r = 3, px = r, py = 0, err = 1 - r;
+    while (px >= py) {
+      drawPixel(x + px, y + py - _offsetY);
+      drawPixel(x - px, y + py - _offsetY);
+      drawPixel(x + px, y - py - _offsetY);
+      drawPixel(x - px, y - py - _offsetY);
+      drawPixel(x + py, y + px - _offsetY);
+      drawPixel(x - py, y + px - _offsetY);
+      drawPixel(x + py, y - px - _offsetY);
+      drawPixel(x - py, y - px - _offsetY);
+      py++;
+      if (err < 0) {
+        err += 2 * py + 1;
+      } else {
+        px--;
+        err += 2 * (py - px) + 1;
+      }
+    }
+  }
+}
+
+// Reuse OLED styles for offscreen (same 1-bit rendering characteristics)
+MapFeatureStyle OffscreenMapRenderer::getFeatureStyle(MapFeatureType type) {
+  switch (type) {
+    case MAP_FEATURE_HIGHWAY:    return {LINE_SOLID, 1, 10, true, 0xFFFF};
+    case MAP_FEATURE_ROAD_MAJOR: return {LINE_SOLID, 1, 9, true, 0xFFFF};
+    case MAP_FEATURE_ROAD_MINOR: return {LINE_SOLID, 1, 5, true, 0xFFFF};
+    case MAP_FEATURE_PATH:       return {LINE_DOTTED, 1, 3, true, 0xFFFF};
+    case MAP_FEATURE_WATER:      return {LINE_SOLID, 1, 8, true, 0xFFFF};
+    case MAP_FEATURE_PARK:       return {LINE_NONE, 1, 0, false, 0xFFFF};
+    case MAP_FEATURE_LAND_MASK:  return {LINE_NONE, 1, 0, false, 0xFFFF};
+    case MAP_FEATURE_RAILWAY:    return {LINE_DASHED, 1, 7, true, 0xFFFF};
+    case MAP_FEATURE_BUS:        return {LINE_DASHED, 1, 4, true, 0xFFFF};
+    case MAP_FEATURE_FERRY:      return {LINE_DASHED, 1, 6, true, 0xFFFF};
+    case MAP_FEATURE_BUILDING:   return {LINE_DOTTED, 1, 1, true, 0xFFFF};
+    case MAP_FEATURE_STATION:    return {LINE_SOLID, 1, 7, true, 0xFFFF};
+    default:                     return {LINE_SOLID, 1, 5, true, 0xFFFF};
+  }
+}
+
+bool OffscreenMapRenderer::shouldRenderFeature(uint8_t type, uint8_t subtype) {
+  switch (type) {
+    case MAP_FEATURE_WATER:
+      return (subtype == SUBTYPE_WATER_RIVER);
+    case MAP_FEATURE_PARK:
+    case MAP_FEATURE_LAND_MASK:
+      return false;
+    default:
+      return true;
+  }
+}
+
+// =============================================================================
+// MapCanvasRenderer / MapCanvas Implementation (world-pixel feature cache)
+// =============================================================================
+
+MapCanvasRenderer::MapCanvasRenderer(uint8_t* buffer, int width, int height)
+  : OffscreenMapRenderer(buffer, width, height), _canvas(buffer),
+    _clipX0(0), _clipY0(0), _clipX1(width), _clipY1(height) {}
+
+void MapCanvasRenderer::setClip(int16_t x0, int16_t y0, int16_t x1, int16_t y1) {
+  _clipX0 = x0 < 0 ? 0 : x0;
+  _clipY0 = y0 < 0 ? 0 : y0;
+  _clipX1 = x1 > _width ? _width : x1;
+  _clipY1 = y1 > _height ? _height : y1;
+}
+
+void MapCanvasRenderer::clear() {
+  if (!_canvas) return;
+  for (int16_t page = _clipY0 >> 3; page <= (_clipY1 - 1) >> 3; page++) {
+    uint8_t mask = 0;
+    for (int16_t y = page * 8; y < page * 8 + 8; y++) {
+      if (y >= _clipY0 && y < _clipY1) mask |= (1 << (y & 7));
+    }
+    uint8_t* row = _canvas + page * _width;
+    for (int16_t x = _clipX0; x < _clipX1; x++) row[x] &= ~mask;
+  }
+}
+
+// Lines are stepped from their real endpoints (never from a clipped one), so
+// every pixel depends only on the segment and strips join without seams.
+void MapCanvasRenderer::drawLine(int16_t x0, int16_t y0, int16_t x1, int16_t y1,
+                                 const MapFeatureStyle& style) {
+  if (!_canvas) return;
+  if ((x0 > x1 ? x0 : x1) < _clipX0 || (x0 < x1 ? x0 : x1) >= _clipX1 ||
+      (y0 > y1 ? y0 : y1) < _clipY0 || (y0 < y1 ? y0 : y1) >= _clipY1) return;
+  
+  const int32_t dx = x1 - x0, dy = y1 - y0;
+  switch (style.lineStyle) {
+    case LINE_SOLID: {
+      int32_t adx = abs(dx), sx = dx > 0 ? 1 : -1;
+      int32_t ady = -abs(dy), sy = dy > 0 ? 1 : -1;
+      int32_t err = adx + ady;
+      int32_t x = x0, y = y0;
+      for (;;) {
+        plot(x, y);
+        if (x == x1 && y == y1) break;
+        int32_t e2 = 2 * err;
+        if (e2 >= ady) { err += ady; x += sx; }
+        if (e2 <= adx) { err += adx; y += sy; }
+      }
+      break;
+    }
+    case LINE_DASHED:
+    case LINE_DOTTED: {
+      int32_t adx = abs(dx), ady = abs(dy);
+      int32_t len = (adx > ady) ? (adx + ady / 2) : (ady + adx / 2);
+      if (len < 1) return;
+      auto along = [len](int32_t d, int32_t t) -> int32_t {
+        int64_t n = (int64_t)d * t;
+        return (int32_t)(n >= 0 ? n / len : -((-n + len - 1) / len));
+      };
+      if (style.lineStyle == LINE_DASHED) {
+        for (int32_t t = 0; t < len; t++) {
+          if ((t / 4) & 1) continue;  // 4 on, 4 off
+          plot(x0 + along(dx, t), y0 + along(dy, t));
+        }
+      } else {
+        for (int32_t t = 0; t <= len; t += 3) {
+          plot(x0 + along(dx, t), y0 + along(dy, t));
+        }
+      }
+      break;
+    }
+    case LINE_NONE:
+    default:
+      break;
+  }
+}
+
+bool MapCanvas::begin(int viewWidth, int viewHeight) {
+  if (_front) return true;
+  _viewW = viewWidth;
+  _viewH = viewHeight;
+  _w = viewWidth + 2 * MAP_CANVAS_MARGIN;
+  _h = ((viewHeight + 2 * MAP_CANVAS_MARGIN + 7) / 8) * 8;
+  _front = (uint8_t*)ps_alloc(pixelBytes(), AllocPref::PreferPSRAM, "map.canvas");
+  _back = (uint8_t*)ps_alloc(pixelBytes(), AllocPref::PreferPSRAM, "map.canvas");
+  if (!_front || !_back) {
+    end();
+    return false;
+  }
+  _valid = false;
+  return true;
+}
+
+void MapCanvas::end() {
+  if (_front) free(_front);
+  if (_back) free(_back);
+  _front = nullptr;
+  _back = nullptr;
+  _valid = false;
+}
+
+bool MapCanvas::update(float centerLat, float centerLon, const MapRenderParams& params) {
+  // One map and one highlight state for all strips of this update
+  MapCacheGuard cacheGuard("MapCanvas.update");
+  _lastRenderedPx = 0;
+  
+  // Rotation leaves the pixel grid, and a blinking feature highlight would get
+  // frozen into cached pixels (the route highlight is an overlay, so it is fine)
+  if (!_front || params.rotation != 0.0f || !MapCore::hasValidMap() ||
+      (params.liveOverlays && gMapHighlight.active && gMapHighlight.mode != HIGHLIGHT_ROUTE)) {
+    _valid = false;
+    return false;
+  }
+  
+  int32_t scaleX, scaleY;
+  MapCore::scaleForZoom(params.zoom, scaleX, scaleY);
+  
+  // The centre's world pixel lands on the viewport's middle pixel, as in renderMap
+  int32_t centerX = mapFloorDiv((int32_t)(centerLon * 1000000), scaleX);
+  int32_t centerY = mapFloorDiv(-(int32_t)(centerLat * 1000000), scaleY);
+  _viewX = centerX - _viewW / 2;
+  _viewY = centerY - _viewH / 2;
+  _snapLonMicro = centerX * scaleX + scaleX / 2;
+  _snapLatMicro = -(centerY * scaleY + scaleY / 2);
+  
+  bool sameView = _valid &&
+                  params.zoom == _params.zoom &&
+                  params.visibleLayers == _params.visibleLayers &&
+                  memcmp(params.subtypeVisibility, _params.subtypeVisibility, sizeof(_params.subtypeVisibility)) == 0 &&
+                  _mapGeneration == MapCore::getMapGeneration();
+  
+  // Window still inside the canvas: nothing to render
+  if (sameView && _viewX >= _originX && _viewY >= _originY &&
+      _viewX + _viewW <= _originX + _w && _viewY + _viewH <= _originY + _h) {
+    return true;
+  }
+  
+  // Re-centre the canvas on the window
+  int32_t originX = _viewX - (_w - _viewW) / 2;
+  int32_t originY = _viewY - (_h - _viewH) / 2;
+  int32_t dx = originX - _originX;
+  int32_t dy = originY - _originY;
+  _originX = originX;
+  _originY = originY;
+  _params = params;
+  _mapGeneration = MapCore::getMapGeneration();
+  
+  if (sameView && abs(dx) < _w / 2 && abs(dy) < _h / 2) {
+    // Keep the overlap; render exposed columns at full height, then exposed rows
+    scrollInto(dx, dy);
+    bool ok = true;
+    if (dx != 0) {
+      ok = renderRect(dx > 0 ? _w - dx : 0, 0, dx > 0 ? _w : -dx, _h);
+    }
+    if (ok && dy != 0) {
+      ok = renderRect(dx > 0 ? 0 : -dx, dy > 0 ? _h - dy : 0, dx > 0 ? _w - dx : _w, dy > 0 ? _h : -dy);
+    }
+    _valid = ok;
+  } else {
+    _valid = renderRect(0, 0, _w, _h);
+  }
+  
+  DEBUG_MAPS_RENDERINGF("[MAPS] canvas: shift=%ld,%ld rendered=%lupx valid=%d",
+                        (long)dx, (long)dy, (unsigned long)_lastRenderedPx, _valid);
+  return _valid;
+}
+
+void MapCanvas::blit(uint8_t* frame, int offsetY) const {
+  if (!_front || !_valid || !frame) return;
+  const int32_t winX = _viewX - _originX;
+  const int32_t winY = _viewY - _originY;
+  for (int y = 0; y < _viewH; y++) {
+    int fy = y + offsetY;
+    if (fy < 0 || fy >= 64) continue;
+    int32_t cy = winY + y;
+    const uint8_t* src = _front + (cy >> 3) * _w + winX;
+    const uint8_t srcBit = 1 << (cy & 7);
+    uint8_t* dst = frame + (fy >> 3) * 128;
+    const uint8_t dstBit = 1 << (fy & 7);
+    for (int x = 0; x < _viewW && x < 128; x++) {
+      if (src[x] & srcBit) dst[x] |= dstBit;
+    }
+  }
+}
+
+bool MapCanvas::renderRect(int16_t x0, int16_t y0, int16_t x1, int16_t y1) {
+  MapCanvasRenderer renderer(_front, _w, _h);
+  renderer.setClip(x0, y0, x1, y1);
+  renderer.clear();
+  _lastRenderedPx += (uint32_t)(x1 - x0) * (uint32_t)(y1 - y0);
+  return MapCore::renderMapLayer(&renderer, _originX, _originY, x0, y0, x1, y1, _params);
+}
+
+// Back buffer = front moved by (dx, dy): new pixel (x, y) is old (x + dx, y + dy).
+// Pages hold 8 rows LSB-top, so vertical moves are byte shifts across pages.
+void MapCanvas::scrollInto(int32_t dx, int32_t dy) {
+  const int pages = _h / 8;
+  const int32_t ady = dy >= 0 ? dy : -dy;
+  const int32_t q = ady >> 3, r = ady & 7;
+  for (int x = 0; x < _w; x++) {
+    const int32_t sx = x + dx;
+    const bool inside = (sx >= 0 && sx < _w);
+    auto src = [&](int32_t page) -> uint8_t {
+      return (page >= 0 && page < pages) ? _front[sx + page * _w] : 0;
+    };
+    for (int p = 0; p < pages; p++) {
+      uint8_t out = 0;
+      if (inside) {
+        if (dy >= 0) {
+          out = r ? (uint8_t)((src(p + q) >> r) | (src(p + q + 1) << (8 - r))) : src(p + q);
+        } else {
+          out = r ? (uint8_t)((src(p - q) << r) | (src(p - q - 1) >> (8 - r))) : src(p - q);
+        }
+      }
+      _back[x + p * _w] = out;
+    }
+  }
+  uint8_t* t = _front;
+  _front = _back;
+  _back = t;
+}
+
+// =============================================================================
+// WaypointManager Implementation
+// =============================================================================
+
+static void sanitizeWaypointTextCopy(char* dst, size_t dstSize, const char* src, const char* fallback, bool allowNewlines) {
+  if (!dst || dstSize == 0) return;
+  const char* in = src ? src : "";
+  size_t j = 0;
+  for (size_t i = 0; in[i] && j + 1 < dstSize; i++) {
+    unsigned char c = static_cast<unsigned char>(in[i]);
+    if (allowNewlines && c == '\n') {
+      dst[j++] = '\n';
+      continue;
+    }
+    if (c < 0x20 || c == 0x7F) continue;
+    dst[j++] = static_cast<char>(c);
+  }
+  dst[j] = '\0';
+
+  if (fallback && fallback[0] && dst[0] == '\0') {
+    strlcpy(dst, fallback, dstSize);
+  }
+}
+
+Waypoint WaypointManager::_waypoints[MAX_WAYPOINTS] = {};
+int WaypointManager::_selectedTarget = -1;
+
+bool WaypointManager::loadWaypoints() {
+  const LoadedMap& map = MapCore::getCurrentMap();
+  if (!map.valid) return false;
+
+  FsLockGuard fsGuard("WaypointManager.loadWaypoints");
+  
+  String mapPath = String(map.filepath);
+  int slash = mapPath.lastIndexOf('/');
+  String mapDir = (slash > 0) ? mapPath.substring(0, slash) : String("/maps");
+  
+  // Extract map base name from filepath (e.g., "/maps/staten/staten.hwmap" -> "staten")
+  String mapFileName = mapPath.substring(slash + 1);
+  String mapBase = mapFileName;
+  if (mapBase.endsWith(".hwmap")) {
+    mapBase = mapBase.substring(0, mapBase.length() - 6);
+  }
+  
+  // Try to find waypoints file with pattern: waypoints_<mapbase>.json or waypoints_<mapbase>.hwmap.json
+  char wp1[128], wp2[128], wp3[128];
+  snprintf(wp1, sizeof(wp1), "%s/waypoints_%s.hwmap.json", mapDir.c_str(), mapBase.c_str());
+  snprintf(wp2, sizeof(wp2), "%s/waypoints_%s.json", mapDir.c_str(), mapBase.c_str());
+  snprintf(wp3, sizeof(wp3), "%s/waypoints.json", mapDir.c_str());
+  String wpPathStr1 = wp1;
+  String wpPathStr2 = wp2;
+  String wpPathStr3 = wp3;  // Fallback to old format
+  
+  String wpPathStr;
+  if (LittleFS.exists(wpPathStr1.c_str())) {
+    wpPathStr = wpPathStr1;
+  } else if (LittleFS.exists(wpPathStr2.c_str())) {
+    wpPathStr = wpPathStr2;
+  } else if (LittleFS.exists(wpPathStr3.c_str())) {
+    wpPathStr = wpPathStr3;
+  } else {
+    // No waypoints file for this map — clear any stale data from a previous map
+    memset(_waypoints, 0, sizeof(_waypoints));
+    _selectedTarget = -1;
+    return false;
+  }
+  
+  char wpPath[128];
+  strlcpy(wpPath, wpPathStr.c_str(), sizeof(wpPath));
+  
+  File f = LittleFS.open(wpPath, "r");
+  if (!f) return false;
+  
+  PSRAM_JSON_DOC(doc);
+  DeserializationError err = deserializeJson(doc, f);
+  f.close();
+  
+  if (err) {
+    WARN_SENSORSF("Waypoint JSON parse error: %s", err.c_str());
+    return false;
+  }
+  
+  // Clear existing
+  memset(_waypoints, 0, sizeof(_waypoints));
+  _selectedTarget = -1;
+  
+  JsonArray arr = doc["waypoints"].as<JsonArray>();
+  int i = 0;
+  for (JsonObject wp : arr) {
+    if (i >= MAX_WAYPOINTS) break;
+    _waypoints[i].lat = wp["lat"] | 0.0f;
+    _waypoints[i].lon = wp["lon"] | 0.0f;
+    sanitizeWaypointTextCopy(_waypoints[i].name, WAYPOINT_NAME_LEN, wp["name"] | "WP", "WP", false);
+    sanitizeWaypointTextCopy(_waypoints[i].notes, WAYPOINT_NOTES_LEN, wp["notes"] | "", "", true);
+    _waypoints[i].active = true;
+    
+    // Load files array
+    _waypoints[i].fileCount = 0;
+    memset(_waypoints[i].files, 0, sizeof(_waypoints[i].files));
+    if (wp["files"].is<JsonArray>()) {
+      JsonArray files = wp["files"].as<JsonArray>();
+      for (JsonVariant file : files) {
+        if (_waypoints[i].fileCount >= MAX_WAYPOINT_FILES) break;
+        const char* path = file.as<const char*>();
+        if (path && path[0]) {
+          sanitizeWaypointTextCopy(_waypoints[i].files[_waypoints[i].fileCount], WAYPOINT_FILE_PATH_LEN, path, "", false);
+          _waypoints[i].fileCount++;
+        }
+      }
+    }
+    i++;
+  }
+  
+  _selectedTarget = doc["target"] | -1;
+  if (_selectedTarget >= MAX_WAYPOINTS || (_selectedTarget >= 0 && !_waypoints[_selectedTarget].active)) {
+    _selectedTarget = -1;
+  }
+  
+  INFO_SENSORSF("Loaded %d waypoints", i);
+  return true;
+}
+
+bool WaypointManager::saveWaypoints() {
+  const LoadedMap& map = MapCore::getCurrentMap();
+  if (!map.valid) return false;
+
+  FsLockGuard fsGuard("WaypointManager.saveWaypoints");
+  
+  PSRAM_JSON_DOC(doc);
+  JsonArray arr = doc["waypoints"].to<JsonArray>();
+  
+  for (int i = 0; i < MAX_WAYPOINTS; i++) {
+    if (_waypoints[i].active) {
+      JsonObject wp = arr.add<JsonObject>();
+      wp["lat"] = _waypoints[i].lat;
+      wp["lon"] = _waypoints[i].lon;
+      wp["name"] = _waypoints[i].name;
+      wp["notes"] = _waypoints[i].notes;
+      
+      // Save files array if any
+      if (_waypoints[i].fileCount > 0) {
+        JsonArray files = wp["files"].to<JsonArray>();
+        for (int j = 0; j < _waypoints[i].fileCount && j < MAX_WAYPOINT_FILES; j++) {
+          if (_waypoints[i].files[j][0]) {
+            files.add(_waypoints[i].files[j]);
+          }
+        }
+      }
+    }
+  }
+  
+  doc["target"] = _selectedTarget;
+  
+  String mapPath = String(map.filepath);
+  int slash = mapPath.lastIndexOf('/');
+  String mapDir = (slash > 0) ? mapPath.substring(0, slash) : String("/maps");
+  if (!LittleFS.exists(mapDir)) {
+    LittleFS.mkdir(mapDir);
+  }
+  
+  // Extract map base name and save with pattern: waypoints_<mapbase>.json
+  String mapFileName = mapPath.substring(slash + 1);
+  String mapBase = mapFileName;
+  if (mapBase.endsWith(".hwmap")) {
+    mapBase = mapBase.substring(0, mapBase.length() - 6);
+  }
+  
+  char wpPath[128];
+  snprintf(wpPath, sizeof(wpPath), "%s/waypoints_%s.json", mapDir.c_str(), mapBase.c_str());
+  
+  File f = LittleFS.open(wpPath, "w");
+  if (!f) {
+    ERROR_SENSORSF("Failed to write waypoints file: %s", wpPath);
+    return false;
+  }
+  
+  serializeJson(doc, f);
+  f.close();
+  return true;
+}
+
+int WaypointManager::addWaypoint(float lat, float lon, const char* name) {
+  for (int i = 0; i < MAX_WAYPOINTS; i++) {
+    if (!_waypoints[i].active) {
+      _waypoints[i].lat = lat;
+      _waypoints[i].lon = lon;
+      sanitizeWaypointTextCopy(_waypoints[i].name, WAYPOINT_NAME_LEN, name, "WP", false);
+      _waypoints[i].notes[0] = '\0';
+      _waypoints[i].fileCount = 0;
+      memset(_waypoints[i].files, 0, sizeof(_waypoints[i].files));
+      _waypoints[i].active = true;
+      saveWaypoints();
+      return i;
+    }
+  }
+  return -1;  // No free slots
+}
+
+int WaypointManager::addWaypoint(float lat, float lon, const char* name, const char* notes) {
+  for (int i = 0; i < MAX_WAYPOINTS; i++) {
+    if (!_waypoints[i].active) {
+      _waypoints[i].lat = lat;
+      _waypoints[i].lon = lon;
+      sanitizeWaypointTextCopy(_waypoints[i].name, WAYPOINT_NAME_LEN, name, "WP", false);
+      sanitizeWaypointTextCopy(_waypoints[i].notes, WAYPOINT_NOTES_LEN, notes ? notes : "", "", true);
+      _waypoints[i].fileCount = 0;
+      memset(_waypoints[i].files, 0, sizeof(_waypoints[i].files));
+      _waypoints[i].active = true;
+      saveWaypoints();
+      return i;
+    }
+  }
+  return -1;
+}
+
+bool WaypointManager::setNotes(int index, const char* notes) {
+  if (index < 0 || index >= MAX_WAYPOINTS) return false;
+  if (!_waypoints[index].active) return false;
+  sanitizeWaypointTextCopy(_waypoints[index].notes, WAYPOINT_NOTES_LEN, notes ? notes : "", "", true);
+  saveWaypoints();
+  return true;
+}
+
+bool WaypointManager::setName(int index, const char* name) {
+  if (index < 0 || index >= MAX_WAYPOINTS) return false;
+  if (!_waypoints[index].active) return false;
+  sanitizeWaypointTextCopy(_waypoints[index].name, WAYPOINT_NAME_LEN, name ? name : "WP", "WP", false);
+  saveWaypoints();
+  return true;
+}
+
+// File attachment management methods
+bool WaypointManager::addFile(int waypointIndex, const char* filePath) {
+  if (waypointIndex < 0 || waypointIndex >= MAX_WAYPOINTS) return false;
+  if (!_waypoints[waypointIndex].active) return false;
+  if (!filePath || !filePath[0]) return false;
+  if (_waypoints[waypointIndex].fileCount >= MAX_WAYPOINT_FILES) return false;
+
+  char sanitized[WAYPOINT_FILE_PATH_LEN];
+  sanitizeWaypointTextCopy(sanitized, sizeof(sanitized), filePath, "", false);
+  if (!sanitized[0]) return false;
+  
+  // Check if file already exists
+  for (int i = 0; i < _waypoints[waypointIndex].fileCount; i++) {
+    if (strcmp(_waypoints[waypointIndex].files[i], sanitized) == 0) {
+      return false;  // Already linked
+    }
+  }
+  
+  strlcpy(_waypoints[waypointIndex].files[_waypoints[waypointIndex].fileCount], 
+          sanitized, WAYPOINT_FILE_PATH_LEN);
+  _waypoints[waypointIndex].fileCount++;
+  saveWaypoints();
+  return true;
+}
+
+bool WaypointManager::removeFile(int waypointIndex, int fileIndex) {
+  if (waypointIndex < 0 || waypointIndex >= MAX_WAYPOINTS) return false;
+  if (!_waypoints[waypointIndex].active) return false;
+  if (fileIndex < 0 || fileIndex >= _waypoints[waypointIndex].fileCount) return false;
+  
+  // Shift remaining files down
+  for (int i = fileIndex; i < _waypoints[waypointIndex].fileCount - 1; i++) {
+    strlcpy(_waypoints[waypointIndex].files[i], 
+            _waypoints[waypointIndex].files[i + 1], WAYPOINT_FILE_PATH_LEN);
+  }
+  _waypoints[waypointIndex].fileCount--;
+  _waypoints[waypointIndex].files[_waypoints[waypointIndex].fileCount][0] = '\0';
+  saveWaypoints();
+  return true;
+}
+
+int WaypointManager::getFileCount(int waypointIndex) {
+  if (waypointIndex < 0 || waypointIndex >= MAX_WAYPOINTS) return 0;
+  if (!_waypoints[waypointIndex].active) return 0;
+  return _waypoints[waypointIndex].fileCount;
+}
+
+const char* WaypointManager::getFile(int waypointIndex, int fileIndex) {
+  if (waypointIndex < 0 || waypointIndex >= MAX_WAYPOINTS) return nullptr;
+  if (!_waypoints[waypointIndex].active) return nullptr;
+  if (fileIndex < 0 || fileIndex >= _waypoints[waypointIndex].fileCount) return nullptr;
+  return _waypoints[waypointIndex].files[fileIndex];
+}
+
+int WaypointManager::findWaypointByName(const char* name) {
+  if (!name || !name[0]) return -1;
+  for (int i = 0; i < MAX_WAYPOINTS; i++) {
+    if (_waypoints[i].active && strcasecmp(_waypoints[i].name, name) == 0) {
+      return i;
+    }
+  }
+  return -1;
+}
+
+bool WaypointManager::clearAll() {
+  bool hadAny = false;
+  for (int i = 0; i < MAX_WAYPOINTS; i++) {
+    if (_waypoints[i].active) {
+      _waypoints[i].active = false;
+      hadAny = true;
+    }
+  }
+  _selectedTarget = -1;
+  if (hadAny) saveWaypoints();
+  return true;
+}
+
+bool WaypointManager::deleteWaypoint(int index) {
+  if (index < 0 || index >= MAX_WAYPOINTS) return false;
+  if (!_waypoints[index].active) return false;
+  
+  _waypoints[index].active = false;
+  if (_selectedTarget == index) _selectedTarget = -1;
+  saveWaypoints();
+  return true;
+}
+
+const Waypoint* WaypointManager::getWaypoint(int index) {
+  if (index < 0 || index >= MAX_WAYPOINTS) return nullptr;
+  if (!_waypoints[index].active) return nullptr;
+  return &_waypoints[index];
+}
+
+int WaypointManager::getActiveCount() {
+  int count = 0;
+  for (int i = 0; i < MAX_WAYPOINTS; i++) {
+    if (_waypoints[i].active) count++;
+  }
+  return count;
+}
+
+void WaypointManager::selectTarget(int index) {
+  if (index < 0 || index >= MAX_WAYPOINTS) {
+    _selectedTarget = -1;
+  } else if (_waypoints[index].active) {
+    _selectedTarget = index;
+  } else {
+    _selectedTarget = -1;
+  }
+  saveWaypoints();
+}
+
+bool WaypointManager::getDistanceBearing(float fromLat, float fromLon,
+                                          float& distanceM, float& bearingDeg) {
+  if (_selectedTarget < 0 || !_waypoints[_selectedTarget].active) {
+    return false;
+  }
+  
+  const Waypoint& wp = _waypoints[_selectedTarget];
+  
+  // Haversine distance
+  const float R = 6371000.0f;  // Earth radius in meters
+  float lat1 = fromLat * PI / 180.0f;
+  float lat2 = wp.lat * PI / 180.0f;
+  float dLat = (wp.lat - fromLat) * PI / 180.0f;
+  float dLon = (wp.lon - fromLon) * PI / 180.0f;
+  
+  float a = sinf(dLat/2) * sinf(dLat/2) +
+            cosf(lat1) * cosf(lat2) * sinf(dLon/2) * sinf(dLon/2);
+  float c = 2 * atan2f(sqrtf(a), sqrtf(1-a));
+  distanceM = R * c;
+  
+  // Bearing
+  float y = sinf(dLon) * cosf(lat2);
+  float x = cosf(lat1) * sinf(lat2) - sinf(lat1) * cosf(lat2) * cosf(dLon);
+  bearingDeg = atan2f(y, x) * 180.0f / PI;
+  if (bearingDeg < 0) bearingDeg += 360.0f;
+  
+  return true;
+}
+
+void WaypointManager::renderWaypoints(MapRenderer* renderer,
+                                       float centerLat, float centerLon,
+                                       int32_t scaleX, int32_t scaleY) {
+  int viewWidth = renderer->getWidth();
+  int viewHeight = renderer->getHeight();
+  int32_t centerLatMicro = (int32_t)(centerLat * 1000000);
+  int32_t centerLonMicro = (int32_t)(centerLon * 1000000);
+  
+  for (int i = 0; i < MAX_WAYPOINTS; i++) {
+    if (!_waypoints[i].active) continue;
+    
+    int32_t wpLatMicro = (int32_t)(_waypoints[i].lat * 1000000);
+    int32_t wpLonMicro = (int32_t)(_waypoints[i].lon * 1000000);
+    
+    int16_t screenX, screenY;
+    MapCore::geoToScreen(wpLatMicro, wpLonMicro, centerLatMicro, centerLonMicro,
+                         scaleX, scaleY, viewWidth, viewHeight, screenX, screenY);
+    
+    // Only render if on screen
+    if (screenX >= 0 && screenX < viewWidth && screenY >= 0 && screenY < viewHeight) {
+      // Draw waypoint marker: X shape, or filled for selected target
+      bool isTarget = (i == _selectedTarget);
+      if (isTarget) {
+        // Filled diamond for target
+        MapFeatureStyle style = {LINE_SOLID, 1, 15, true, 0xFFFF};
+        renderer->drawLine(screenX - 3, screenY, screenX, screenY - 3, style);
+        renderer->drawLine(screenX, screenY - 3, screenX + 3, screenY, style);
+        renderer->drawLine(screenX + 3, screenY, screenX, screenY + 3, style);
+        renderer->drawLine(screenX, screenY + 3, screenX - 3, screenY, style);
+      } else {
+        // Small X for regular waypoints
+        MapFeatureStyle style = {LINE_SOLID, 1, 15, true, 0xFFFF};
+        renderer->drawLine(screenX - 2, screenY - 2, screenX + 2, screenY + 2, style);
+        renderer->drawLine(screenX - 2, screenY + 2, screenX + 2, screenY - 2, style);
+      }
+    }
+  }
+}
+
+// =============================================================================
+// GPS Track Manager Implementation
+// =============================================================================
+
+GPSTrackPoint* GPSTrackManager::_points = nullptr;
+int GPSTrackManager::_pointCount = 0;
+GPSTrackBounds GPSTrackManager::_bounds = {0, 0, 0, 0, false};
+GPSTrackStats GPSTrackManager::_stats = {0, 0, 0, false};
+char GPSTrackManager::_filename[64] = "";
+bool GPSTrackManager::_liveTracking = false;
+uint32_t GPSTrackManager::_lastUpdateMs = 0;
+bool GPSTrackManager::_binary = false;
+File GPSTrackManager::_trackFile;
+char GPSTrackManager::_trackPath[96] = "";
+GPSTrackFileHeader GPSTrackManager::_header = {};
+GPSTrackChunkEntry* GPSTrackManager::_chunks = nullptr;
+uint32_t* GPSTrackManager::_chunkFirst = nullptr;
+
+// Last chunk decoded by readPoints() (sequential reads decode each chunk once)
+static GPSTrackFixedPoint* sTrackReadPts = nullptr;
+static int32_t sTrackReadChunk = -1;
+static int sTrackReadCount = 0;
+
+// -----------------------------------------------------------------------------
+// Binary track chunk codec (layout in System_Maps.h, GPS_TRACK_*)
+// -----------------------------------------------------------------------------
+
+static inline uint8_t* putTrackVarint(uint8_t* p, uint32_t v) {
+  while (v >= 0x80) {
+    *p++ = (uint8_t)(v | 0x80);
+    v >>= 7;
+  }
+  *p++ = (uint8_t)v;
+  return p;
+}
+
+size_t encodeTrackChunk(const GPSTrackFixedPoint* pts, int count, uint8_t* out) {
+  if (count <= 0) return 0;
+  uint8_t* p = out;
+  memcpy(p, &pts[0].lat, 4);
+  memcpy(p + 4, &pts[0].lon, 4);
+  memcpy(p + 8, &pts[0].timeMs, 4);
+  p += 12;
+  for (int i = 1; i < count; i++) {
+    int32_t dLat = (int32_t)((uint32_t)pts[i].lat - (uint32_t)pts[i - 1].lat);
+    int32_t dLon = (int32_t)((uint32_t)pts[i].lon - (uint32_t)pts[i - 1].lon);
+    p = putTrackVarint(p, ((uint32_t)dLat << 1) ^ (uint32_t)(dLat >> 31));
+    p = putTrackVarint(p, ((uint32_t)dLon << 1) ^ (uint32_t)(dLon >> 31));
+    p = putTrackVarint(p, pts[i].timeMs - pts[i - 1].timeMs);
+  }
+  return (size_t)(p - out);
+}
+
+int decodeTrackChunk(const uint8_t* data, size_t size, GPSTrackFixedPoint* out, int maxPoints) {
+  if (!data || size < 12 || maxPoints <= 0) return -1;
+  const uint8_t* p = data;
+  const uint8_t* end = data + size;
+  memcpy(&out[0].lat, p, 4);
+  memcpy(&out[0].lon, p + 4, 4);
+  memcpy(&out[0].timeMs, p + 8, 4);
+  p += 12;
+  int n = 1;
+  while (p < end) {
+    uint32_t a, b, dt;
+    if (n >= maxPoints) return -1;
+    if (!decodeVarint(p, end, a) || !decodeVarint(p, end, b) || !decodeVarint(p, end, dt)) return -1;
+    out[n].lat = (int32_t)((uint32_t)out[n - 1].lat + ((a >> 1) ^ (0u - (a & 1))));
+    out[n].lon = (int32_t)((uint32_t)out[n - 1].lon + ((b >> 1) ^ (0u - (b & 1))));
+    out[n].timeMs = out[n - 1].timeMs + dt;
+    n++;
+  }
+  return n;
+}
+
+// Time of day from a track CSV line ("HH:MM:SS,lat,lon,...") in ms.
+// Sensor logs and the older millis/index column carry no usable clock.
+static bool parseTrackTime(const char* line, uint32_t& timeMs) {
+  char* endptr;
+  unsigned long h = strtoul(line, &endptr, 10);
+  if (endptr == line || *endptr != ':') return false;
+  unsigned long m = strtoul(endptr + 1, &endptr, 10);
+  if (*endptr != ':') return false;
+  unsigned long s = strtoul(endptr + 1, &endptr, 10);
+  if (*endptr != ',' || h > 23 || m > 59 || s > 60) return false;
+  timeMs = (uint32_t)((h * 3600UL + m * 60UL + s) * 1000UL);
+  return true;
+}
+
+// Length of a short track segment (equirectangular, exact enough at GPS spacing)
+static float trackSegmentMeters(const GPSTrackFixedPoint& a, const GPSTrackFixedPoint& b) {
+  const float metersPerMicroDeg = 0.111195f;  // 6371 km * pi / 180 / 1e6
+  float midLat = ((float)a.lat + (float)b.lat) * 0.5e-6f * (float)M_PI / 180.0f;
+  float dx = (float)((int64_t)b.lon - a.lon) * cosf(midLat);
+  float dy = (float)((int64_t)b.lat - a.lat);
+  return sqrtf(dx * dx + dy * dy) * metersPerMicroDeg;
+}
+
+// Haversine formula for distance between two GPS points (returns meters)
+float GPSTrackManager::haversineDistance(float lat1, float lon1, float lat2, float lon2) {
+  const float R = 6371000.0f;  // Earth radius in meters
+  float dLat = (lat2 - lat1) * M_PI / 180.0f;
+  float dLon = (lon2 - lon1) * M_PI / 180.0f;
+  float lat1Rad = lat1 * M_PI / 180.0f;
+  float lat2Rad = lat2 * M_PI / 180.0f;
+  
+  float a = sinf(dLat / 2) * sinf(dLat / 2) +
+            cosf(lat1Rad) * cosf(lat2Rad) * sinf(dLon / 2) * sinf(dLon / 2);
+  float c = 2 * atan2f(sqrtf(a), sqrtf(1 - a));
+  
+  return R * c;
+}
+
+// Calculate track statistics (total distance point-to-point, duration, avg speed)
+void GPSTrackManager::calculateStats() {
+  _stats.valid = false;
+  _stats.totalDistanceM = 0;
+  _stats.durationSec = 0;
+  _stats.avgSpeedMps = 0;
+  
+  if (_pointCount < 2) return;
+  
+  // Sum distances between consecutive points
+  for (int i = 1; i < _pointCount; i++) {
+    float dist = haversineDistance(
+      _points[i-1].lat, _points[i-1].lon,
+      _points[i].lat, _points[i].lon
+    );
+    _stats.totalDistanceM += dist;
+  }
+  
+  // Duration from first to last point (using timestamps if available)
+  if (_points[_pointCount - 1].timestamp > _points[0].timestamp) {
+    _stats.durationSec = (_points[_pointCount - 1].timestamp - _points[0].timestamp) / 1000.0f;
+  } else {
+    // Estimate based on point count and typical logging interval (1 second)
+    _stats.durationSec = (float)(_pointCount - 1);
+  }
+  
+  // Average speed
+  if (_stats.durationSec > 0) {
+    _stats.avgSpeedMps = _stats.totalDistanceM / _stats.durationSec;
+  }
+  
+  _stats.valid = true;
+}
+
+bool GPSTrackManager::parseGPSLine(const char* line, double& lat, double& lon) {
+  // Skip comment lines
+  if (line[0] == '#') return false;
+  
+  // Skip signal loss/regain markers (contain "---" or "~~~")
+  if (strstr(line, "SIGNAL_LOST") || strstr(line, "SIGNAL_REGAINED")) {
+    return false;
+  }
+  
+  // Try Format 1: General sensor log
+  // "gps: lat=37.123456 lon=-122.123456 alt=10.5m speed=0.0kn sats=8 q=1"
+  const char* latPtr = strstr(line, "lat=");
+  const char* lonPtr = strstr(line, "lon=");
+  
+  if (latPtr && lonPtr) {
+    lat = atof(latPtr + 4);
+    lon = atof(lonPtr + 4);
+  } else {
+    // Try Format 2: Dedicated GPS track CSV
+    // "HH:MM:SS,lat,lon,alt_m,speed_kn,satellites" (new format with time)
+    // "timestamp_ms,lat,lon,alt_m,speed_kn,satellites" (old format with millis)
+    // e.g., "14:30:45,37.123456,-122.123456,10.5,0.0,8"
+    char* endptr;
+    
+    // Skip timestamp (first field - either HH:MM:SS or milliseconds)
+    const char* p = strchr(line, ',');
+    if (!p) return false;
+    p++;  // Skip comma
+    
+    // Check for signal markers (second field is "---" or "~~~")
+    if (*p == '-' || *p == '~') return false;
+    
+    // Parse lat
+    lat = strtod(p, &endptr);
+    if (endptr == p || *endptr != ',') return false;
+    p = endptr + 1;
+    
+    // Parse lon
+    lon = strtod(p, &endptr);
+    if (endptr == p) return false;
+  }
+  
+  // Basic sanity check
+  if (lat < -90.0 || lat > 90.0 || lon < -180.0 || lon > 180.0) {
+    return false;
+  }
+  
+  return true;
+}
+
+void GPSTrackManager::calculateBounds() {
+  if (_pointCount == 0) {
+    _bounds.valid = false;
+    return;
+  }
+  
+  _bounds.minLat = _points[0].lat;
+  _bounds.maxLat = _points[0].lat;
+  _bounds.minLon = _points[0].lon;
+  _bounds.maxLon = _points[0].lon;
+  
+  for (int i = 1; i < _pointCount; i++) {
+    if (_points[i].lat < _bounds.minLat) _bounds.minLat = _points[i].lat;
+    if (_points[i].lat > _bounds.maxLat) _bounds.maxLat = _points[i].lat;
+    if (_points[i].lon < _bounds.minLon) _bounds.minLon = _points[i].lon;
+    if (_points[i].lon > _bounds.maxLon) _bounds.maxLon = _points[i].lon;
+  }
+  
+  _bounds.valid = true;
+}
+
+bool GPSTrackManager::importCSV(const char* csvPath, const char* outPath, String& errorMsg) {
+  if (!csvPath || !outPath || csvPath[0] != '/' || outPath[0] != '/') {
+    errorMsg = "Invalid path";
+    return false;
+  }
+  
+  // One chunk of points plus its encoded payload; the index grows as chunks are written
+  uint32_t indexCap = 16;
+  GPSTrackFixedPoint* pts = (GPSTrackFixedPoint*)ps_alloc(GPS_TRACK_CHUNK_MAX * sizeof(GPSTrackFixedPoint),
+                                                          AllocPref::PreferPSRAM, "gps.import");
+  uint8_t* payload = (uint8_t*)ps_alloc(GPS_TRACK_CHUNK_BYTES, AllocPref::PreferPSRAM, "gps.import");
+  GPSTrackChunkEntry* index = (GPSTrackChunkEntry*)ps_alloc(indexCap * sizeof(GPSTrackChunkEntry),
+                                                            AllocPref::PreferPSRAM, "gps.import");
+  if (!pts || !payload || !index) {
+    free(pts);
+    free(payload);
+    free(index);
+    errorMsg = "Memory allocation failed";
+    return false;
+  }
+  
+  FsLockGuard fsGuard("GPSTrackManager.importCSV");
+  
+  bool ok = false;
+  bool created = false;
+  File in = LittleFS.exists(csvPath) ? LittleFS.open(csvPath, "r") : File();
+  File out;
+  if (!in) {
+    errorMsg = "File not found";
+  } else {
+    out = LittleFS.open(outPath, "w");
+    created = (bool)out;
+    if (!out) errorMsg = "Failed to create track file";
+  }
+  
+  if (in && out) {
+    GPSTrackFileHeader h = {};
+    memcpy(h.magic, GPS_TRACK_MAGIC, 4);
+    h.version = GPS_TRACK_VERSION;
+    h.chunkPoints = GPS_TRACK_CHUNK_POINTS;
+    h.sourceSize = in.size();
+    h.minLat = h.minLon = INT32_MAX;
+    h.maxLat = h.maxLon = INT32_MIN;
+    // Placeholder; rewritten once the counts and index offset are known
+    bool writeOk = out.write((const uint8_t*)&h, sizeof(h)) == sizeof(h);
+    
+    int n = 0;               // Buffered points, including the overlap point
+    int fresh = 0;           // Buffered points not yet written in any chunk
+    bool haveTime = false;
+    uint32_t firstTimeMs = 0, lastTimeMs = 0, dayOffsetMs = 0;
+    
+    auto flushChunk = [&]() -> bool {
+      if (h.chunkCount == indexCap) {
+        GPSTrackChunkEntry* grown = (GPSTrackChunkEntry*)ps_realloc(
+            index, indexCap * 2 * sizeof(GPSTrackChunkEntry), AllocPref::PreferPSRAM, "gps.import");
+        if (!grown) return false;
+        index = grown;
+        indexCap *= 2;
+      }
+      GPSTrackChunkEntry& e = index[h.chunkCount];
+      size_t size = encodeTrackChunk(pts, n, payload);
+      e.offset = out.position();
+      e.size = (uint16_t)size;
+      e.pointCount = (uint16_t)n;
+      e.minLat = e.maxLat = pts[0].lat;
+      e.minLon = e.maxLon = pts[0].lon;
+      for (int i = 1; i < n; i++) {
+        if (pts[i].lat < e.minLat) e.minLat = pts[i].lat;
+        if (pts[i].lat > e.maxLat) e.maxLat = pts[i].lat;
+        if (pts[i].lon < e.minLon) e.minLon = pts[i].lon;
+        if (pts[i].lon > e.maxLon) e.maxLon = pts[i].lon;
+      }
+      if (out.write(payload, size) != size) return false;
+      h.chunkCount++;
+      // Next chunk starts from this one's last point so it draws on its own
+      pts[0] = pts[n - 1];
+      n = 1;
+      fresh = 0;
+      return true;
+    };
+    
+    while (writeOk && in.available()) {
+      String line = in.readStringUntil('\n');
+      line.trim();
+      
+      if (line.length() == 0) continue;
+      
+      double lat, lon;
+      if (!parseGPSLine(line.c_str(), lat, lon)) continue;
+      
+      // Timestamps must not go backwards: deltas are unsigned
+      uint32_t timeMs;
+      if (parseTrackTime(line.c_str(), timeMs)) {
+        timeMs += dayOffsetMs;
+        if (haveTime && timeMs < lastTimeMs) {
+          if (lastTimeMs - timeMs > 12UL * 3600000UL) {
+            dayOffsetMs += 86400000UL;  // Crossed midnight
+            timeMs += 86400000UL;
+          } else {
+            timeMs = lastTimeMs;
+          }
+        }
+        if (!haveTime) firstTimeMs = timeMs;
+        haveTime = true;
+        lastTimeMs = timeMs;
+      }
+      
+      GPSTrackFixedPoint& pt = pts[n];
+      pt.lat = (int32_t)lround(lat * 1000000.0);
+      pt.lon = (int32_t)lround(lon * 1000000.0);
+      pt.timeMs = lastTimeMs;
+      
+      if (h.pointCount == 0) {
+        h.startLat = pt.lat;
+        h.startLon = pt.lon;
+      } else {
+        h.distanceM += trackSegmentMeters(pts[n - 1], pt);
+      }
+      h.endLat = pt.lat;
+      h.endLon = pt.lon;
+      if (pt.lat < h.minLat) h.minLat = pt.lat;
+      if (pt.lat > h.maxLat) h.maxLat = pt.lat;
+      if (pt.lon < h.minLon) h.minLon = pt.lon;
+      if (pt.lon > h.maxLon) h.maxLon = pt.lon;
+      h.pointCount++;
+      n++;
+      fresh++;
+      
+      if (fresh == GPS_TRACK_CHUNK_POINTS) writeOk = flushChunk();
+    }
+    
+    if (writeOk && fresh > 0) writeOk = flushChunk();
+    h.durationMs = haveTime ? lastTimeMs - firstTimeMs : 0;
+    
+    if (!writeOk) {
+      errorMsg = "Failed to write track file";
+    } else if (h.pointCount == 0) {
+      errorMsg = "No GPS data found in file";
+    } else {
+      h.indexOffset = out.position();
+      size_t indexBytes = h.chunkCount * sizeof(GPSTrackChunkEntry);
+      ok = out.write((const uint8_t*)index, indexBytes) == indexBytes &&
+           out.seek(0) && out.write((const uint8_t*)&h, sizeof(h)) == sizeof(h);
+      if (!ok) errorMsg = "Failed to write track file";
+    }
+    
+    if (ok) {
+      INFO_SENSORSF("Imported GPS track: %lu points in %lu chunks, %lu -> %lu bytes (%s)",
+                    (unsigned long)h.pointCount, (unsigned long)h.chunkCount,
+                    (unsigned long)h.sourceSize, (unsigned long)out.size(), outPath);
+    }
+  }
+  
+  if (in) in.close();
+  if (out) out.close();
+  if (!ok && created) LittleFS.remove(outPath);
+  
+  free(pts);
+  free(payload);
+  free(index);
+  return ok;
+}
+
+bool GPSTrackManager::openBinaryTrack(const char* path, String& errorMsg) {
+  FsLockGuard fsGuard("GPSTrackManager.openBinaryTrack");
+  
+  File f = LittleFS.open(path, "r");
+  if (!f) {
+    errorMsg = "Failed to open file";
+    return false;
+  }
+  
+  GPSTrackFileHeader h;
+  size_t fileSize = f.size();
+  if (f.read((uint8_t*)&h, sizeof(h)) != sizeof(h) ||
+      memcmp(h.magic, GPS_TRACK_MAGIC, 4) != 0 || h.version != GPS_TRACK_VERSION ||
+      h.pointCount == 0 || h.pointCount > (uint32_t)INT32_MAX || h.chunkCount == 0 ||
+      h.indexOffset < sizeof(h) ||
+      (uint64_t)h.indexOffset + (uint64_t)h.chunkCount * sizeof(GPSTrackChunkEntry) > fileSize) {
+    f.close();
+    errorMsg = "Invalid track file";
+    return false;
+  }
+  
+  _chunks = (GPSTrackChunkEntry*)ps_alloc(h.chunkCount * sizeof(GPSTrackChunkEntry),
+                                          AllocPref::PreferPSRAM, "gps.track");
+  _chunkFirst = (uint32_t*)ps_alloc(h.chunkCount * sizeof(uint32_t), AllocPref::PreferPSRAM, "gps.track");
+  if (!_chunks || !_chunkFirst) {
+    f.close();
+    free(_chunks);
+    free(_chunkFirst);
+    _chunks = nullptr;
+    _chunkFirst = nullptr;
+    errorMsg = "Memory allocation failed";
+    return false;
+  }
+  
+  size_t indexBytes = h.chunkCount * sizeof(GPSTrackChunkEntry);
+  bool valid = f.seek(h.indexOffset) && f.read((uint8_t*)_chunks, indexBytes) == indexBytes;
+  
+  // Chunk k > 0 repeats the previous chunk's last point; it is not a new point
+  uint32_t first = 0;
+  for (uint32_t k = 0; valid && k < h.chunkCount; k++) {
+    const GPSTrackChunkEntry& e = _chunks[k];
+    uint32_t overlap = (k > 0) ? 1 : 0;
+    if (e.pointCount <= overlap || e.pointCount > GPS_TRACK_CHUNK_MAX || e.size > GPS_TRACK_CHUNK_BYTES ||
+        e.offset < sizeof(h) || (uint64_t)e.offset + e.size > h.indexOffset) {
+      valid = false;
+      break;
+    }
+    _chunkFirst[k] = first;
+    first += e.pointCount - overlap;
+  }
+  if (!valid || first != h.pointCount) {
+    f.close();
+    free(_chunks);
+    free(_chunkFirst);
+    _chunks = nullptr;
+    _chunkFirst = nullptr;
+    errorMsg = "Invalid track file";
+    return false;
+  }
+  
+  // Keep the handle open: rendering reads chunks on demand
+  _trackFile = f;
+  _header = h;
+  _binary = true;
+  strlcpy(_trackPath, path, sizeof(_trackPath));
+  _pointCount = (int)h.pointCount;
+  
+  _bounds.minLat = h.minLat / 1000000.0f;
+  _bounds.minLon = h.minLon / 1000000.0f;
+  _bounds.maxLat = h.maxLat / 1000000.0f;
+  _bounds.maxLon = h.maxLon / 1000000.0f;
+  _bounds.valid = true;
+  
+  _stats.totalDistanceM = h.distanceM;
+  // Without timestamps, estimate the typical logging interval (1 second)
+  _stats.durationSec = (h.durationMs > 0) ? h.durationMs / 1000.0f : (float)(h.pointCount - 1);
+  _stats.avgSpeedMps = (_stats.durationSec > 0) ? _stats.totalDistanceM / _stats.durationSec : 0;
+  _stats.valid = (h.pointCount >= 2);
+  return true;
+}
+
+int GPSTrackManager::readChunk(uint32_t chunkIdx, GPSTrackFixedPoint* out) {
+  if (!_binary || !_chunks || !out || chunkIdx >= _header.chunkCount) return -1;
+  const GPSTrackChunkEntry& e = _chunks[chunkIdx];
+  
+  // Exclusive per track file: the persistent handle's seek+read must not interleave.
+  // The payload scratch is only touched while the guard is held.
+  FsPathWriteGuard fsGuard(_trackPath);
+  static uint8_t* sPayload = nullptr;
+  if (!sPayload) {
+    sPayload = (uint8_t*)ps_alloc(GPS_TRACK_CHUNK_BYTES, AllocPref::PreferPSRAM, "gps.chunk");
+    if (!sPayload) return -1;
+  }
+  if (!_trackFile || !_trackFile.seek(e.offset) || _trackFile.read(sPayload, e.size) != e.size) {
+    DEBUG_MAPS_RENDERINGF("[MAPS] readChunk: short read track chunk %lu", (unsigned long)chunkIdx);
+    return -1;
+  }
+  int n = decodeTrackChunk(sPayload, e.size, out, GPS_TRACK_CHUNK_MAX);
+  return (n == e.pointCount) ? n : -1;
+}
+
+int GPSTrackManager::readPoints(uint32_t first, GPSTrackPoint* out, int maxPoints) {
+  if (!out || maxPoints <= 0 || _pointCount <= 0 || first >= (uint32_t)_pointCount) return 0;
+  
+  if (!_binary) {
+    if (!_points) return 0;
+    int count = _pointCount - (int)first;
+    if (count > maxPoints) count = maxPoints;
+    memcpy(out, &_points[first], count * sizeof(GPSTrackPoint));
+    return count;
+  }
+  
+  if (!sTrackReadPts) {
+    sTrackReadPts = (GPSTrackFixedPoint*)ps_alloc(GPS_TRACK_CHUNK_MAX * sizeof(GPSTrackFixedPoint),
+                                                  AllocPref::PreferPSRAM, "gps.read");
+    if (!sTrackReadPts) return 0;
+  }
+  
+  int copied = 0;
+  while (copied < maxPoints && first < (uint32_t)_pointCount) {
+    // Last chunk whose first new point is <= first
+    uint32_t k = (uint32_t)(std::upper_bound(_chunkFirst, _chunkFirst + _header.chunkCount, first) - _chunkFirst) - 1;
+    if (sTrackReadChunk != (int32_t)k) {
+      sTrackReadCount = readChunk(k, sTrackReadPts);
+      if (sTrackReadCount < 0) {
+        sTrackReadChunk = -1;
+        break;
+      }
+      sTrackReadChunk = (int32_t)k;
+    }
+    int i = (int)(first - _chunkFirst[k]) + ((k > 0) ? 1 : 0);
+    for (; i < sTrackReadCount && copied < maxPoints; i++, first++, copied++) {
+      out[copied].lat = sTrackReadPts[i].lat / 1000000.0f;
+      out[copied].lon = sTrackReadPts[i].lon / 1000000.0f;
+      out[copied].timestamp = sTrackReadPts[i].timeMs;
+    }
+  }
+  return copied;
+}
+
+bool GPSTrackManager::loadTrack(const char* filepath, String& errorMsg) {
+  clearTrack();
+  
+  // Binary tracks open in place. CSV and sensor logs are imported once into a
+  // sibling <file>.hwtrk, rebuilt when the source file's size changes.
+  char binPath[96];
+  bool isBinary = false;
+  bool cacheValid = false;
+  {
+    FsLockGuard fsGuard("GPSTrackManager.loadTrack");
+    
+    if (!LittleFS.exists(filepath)) {
+      errorMsg = "File not found";
+      return false;
+    }
+    
+    File f = LittleFS.open(filepath, "r");
+    if (!f) {
+      errorMsg = "Failed to open file";
+      return false;
+    }
+    char magic[4];
+    isBinary = f.read((uint8_t*)magic, 4) == 4 && memcmp(magic, GPS_TRACK_MAGIC, 4) == 0;
+    size_t sourceSize = f.size();
+    f.close();
+    
+    if (!isBinary) {
+      if (snprintf(binPath, sizeof(binPath), "%s%s", filepath, GPS_TRACK_EXT) >= (int)sizeof(binPath)) {
+        errorMsg = "Path too long";
+        return false;
+      }
+      if (LittleFS.exists(binPath)) {
+        File c = LittleFS.open(binPath, "r");
+        GPSTrackFileHeader h;
+        cacheValid = c && c.read((uint8_t*)&h, sizeof(h)) == sizeof(h) &&
+                     memcmp(h.magic, GPS_TRACK_MAGIC, 4) == 0 &&
+                     h.version == GPS_TRACK_VERSION && h.sourceSize == sourceSize;
+        if (c) c.close();
+      }
+    }
+  }
+  
+  if (isBinary) {
+    if (!openBinaryTrack(filepath, errorMsg)) return false;
+  } else {
+    if (!cacheValid && !importCSV(filepath, binPath, errorMsg)) return false;
+    if (!openBinaryTrack(binPath, errorMsg)) return false;
+  }
+  
+  strlcpy(_filename, filepath, sizeof(_filename));
+  
+  INFO_SENSORSF("Loaded GPS track: %d points (%lu chunks) from %s", _pointCount,
+                (unsigned long)_header.chunkCount, filepath);
+  return true;
+}
+
+void GPSTrackManager::clearTrack() {
+  if (_points) {
+    free(_points);
+    _points = nullptr;
+  }
+  if (_binary) {
+    FsPathWriteGuard fsGuard(_trackPath);
+    _trackFile.close();
+  }
+  free(_chunks);
+  free(_chunkFirst);
+  _chunks = nullptr;
+  _chunkFirst = nullptr;
+  _binary = false;
+  _header = {};
+  _trackPath[0] = '\0';
+  sTrackReadChunk = -1;
+  _pointCount = 0;
+  _bounds.valid = false;
+  _stats.valid = false;
+  _filename[0] = '\0';
+}
+
+bool GPSTrackManager::deleteTrackFile(const char* filepath) {
+  if (!filepath || filepath[0] != '/') return false;
+  
+  // Clear if this is the currently loaded track
+  if (strcmp(_filename, filepath) == 0) {
+    clearTrack();
+  }
+  
+  fsLock("gpstrack.delete");
+  bool success = LittleFS.remove(filepath);
+  // Drop the binary copy imported from this file, if any
+  char binPath[96];
+  if (snprintf(binPath, sizeof(binPath), "%s%s", filepath, GPS_TRACK_EXT) < (int)sizeof(binPath) &&
+      LittleFS.exists(binPath)) {
+    LittleFS.remove(binPath);
+  }
+  fsUnlock();
+  
+  return success;
+}
+
+bool GPSTrackManager::saveTrack(char* outPath, size_t outPathSize) {
+  if (!_points || _pointCount == 0) return false;
+
+  // Generate timestamped filename
+  const char* dir = "/logging_captures/tracks";
+  fsLock("gpstrack.save");
+  if (!LittleFS.exists(dir)) {
+    LittleFS.mkdir(dir);
+  }
+
+  time_t now = time(nullptr);
+  char timestamp[24];
+  if (now > 1609459200) {
+    struct tm* ti = localtime(&now);
+    strftime(timestamp, sizeof(timestamp), "%Y-%m-%dT%H-%M-%S", ti);
+  } else {
+    snprintf(timestamp, sizeof(timestamp), "%lu", millis());
+  }
+
+  snprintf(outPath, outPathSize, "%s/track-%s.csv", dir, timestamp);
+
+  File f = LittleFS.open(outPath, "w");
+  if (!f) {
+    fsUnlock();
+    return false;
+  }
+
+  f.print("# GPS Track\n# time,lat,lon\n");
+  char line[64];
+  for (int i = 0; i < _pointCount; i++) {
+    int len = snprintf(line, sizeof(line), "%d,%.6f,%.6f\n", i, _points[i].lat, _points[i].lon);
+    f.write((const uint8_t*)line, len);
+  }
+  f.close();
+  fsUnlock();
+
+  INFO_SENSORSF("Saved GPS track: %d points to %s", _pointCount, outPath);
+  return true;
+}
+
+void GPSTrackManager::setLiveTracking(bool enabled) {
+  if (enabled && !_liveTracking) {
+    // Live points are kept in RAM; drop a file-backed track first
+    if (_binary) clearTrack();
+    // Starting live tracking - allocate buffer if not already allocated
+    if (!_points) {
+      _points = (GPSTrackPoint*)ps_alloc(MAX_TRACK_POINTS * sizeof(GPSTrackPoint), 
+                                          AllocPref::PreferPSRAM, "gps.live");
+      if (!_points) {
+        ERROR_SENSORSF("Failed to allocate live track buffer");
+        return;
+      }
+    }
+    _pointCount = 0;
+    _bounds.valid = false;
+    _stats.valid = false;
+    strlcpy(_filename, "[LIVE]", sizeof(_filename));
+    INFO_SENSORSF("Live tracking started");
+  } else if (!enabled && _liveTracking) {
+    INFO_SENSORSF("Live tracking stopped (%d points)", _pointCount);
+    // Calculate final stats
+    calculateBounds();
+    calculateStats();
+  }
+  _liveTracking = enabled;
+}
+
+bool GPSTrackManager::appendPoint(float lat, float lon) {
+  if (!_liveTracking || !_points) return false;
+  if (_pointCount >= MAX_TRACK_POINTS) return false;
+  
+  // Skip if too close to last point (avoid clutter)
+  if (_pointCount > 0) {
+    float dist = haversineDistance(_points[_pointCount-1].lat, _points[_pointCount-1].lon, lat, lon);
+    if (dist < 2.0f) return false;  // Less than 2 meters, skip
+  }
+  
+  _points[_pointCount].lat = lat;
+  _points[_pointCount].lon = lon;
+  _points[_pointCount].timestamp = millis();
+  _pointCount++;
+  _lastUpdateMs = millis();
+  
+  // Update bounds incrementally
+  if (_pointCount == 1) {
+    _bounds.minLat = _bounds.maxLat = lat;
+    _bounds.minLon = _bounds.maxLon = lon;
+    _bounds.valid = true;
+  } else {
+    if (lat < _bounds.minLat) _bounds.minLat = lat;
+    if (lat > _bounds.maxLat) _bounds.maxLat = lat;
+    if (lon < _bounds.minLon) _bounds.minLon = lon;
+    if (lon > _bounds.maxLon) _bounds.maxLon = lon;
+  }
+  
+  // Update stats incrementally
+  if (_pointCount >= 2) {
+    float dist = haversineDistance(_points[_pointCount-2].lat, _points[_pointCount-2].lon, lat, lon);
+    _stats.totalDistanceM += dist;
+    _stats.durationSec = (_points[_pointCount-1].timestamp - _points[0].timestamp) / 1000.0f;
+    if (_stats.durationSec > 0) {
+      _stats.avgSpeedMps = _stats.totalDistanceM / _stats.durationSec;
+    }
+    _stats.valid = true;
+  }
+  
+  return true;
+}
+
+TrackValidation GPSTrackManager::validateTrack(float& coveragePercent) {
+  if (_pointCount == 0) {
+    coveragePercent = 0.0f;
+    return TRACK_EMPTY;
+  }
+  
+  if (!MapCore::hasValidMap()) {
+    coveragePercent = 0.0f;
+    return TRACK_NO_MAP_LOADED;
+  }
+  
+  const LoadedMap& map = MapCore::getCurrentMap();
+  float mapMinLat = map.header.minLat / 1000000.0f;
+  float mapMaxLat = map.header.maxLat / 1000000.0f;
+  float mapMinLon = map.header.minLon / 1000000.0f;
+  float mapMaxLon = map.header.maxLon / 1000000.0f;
+  
+  int pointsInBounds = 0;
+  if (_binary) {
+    // Chunks wholly inside or outside the map are decided by their bounding box;
+    // only chunks straddling the map edge are decoded
+    int32_t minLat = map.header.minLat, maxLat = map.header.maxLat;
+    int32_t minLon = map.header.minLon, maxLon = map.header.maxLon;
+    GPSTrackFixedPoint* pts = nullptr;
+    for (uint32_t k = 0; k < _header.chunkCount; k++) {
+      const GPSTrackChunkEntry& e = _chunks[k];
+      int overlap = (k > 0) ? 1 : 0;
+      if (e.minLat >= minLat && e.maxLat <= maxLat && e.minLon >= minLon && e.maxLon <= maxLon) {
+        pointsInBounds += e.pointCount - overlap;
+        continue;
+      }
+      if (e.maxLat < minLat || e.minLat > maxLat || e.maxLon < minLon || e.minLon > maxLon) continue;
+      if (!pts) {
+        pts = (GPSTrackFixedPoint*)ps_alloc(GPS_TRACK_CHUNK_MAX * sizeof(GPSTrackFixedPoint),
+                                            AllocPref::PreferPSRAM, "gps.validate");
+        if (!pts) break;
+      }
+      int n = readChunk(k, pts);
+      for (int i = overlap; i < n; i++) {
+        if (pts[i].lat >= minLat && pts[i].lat <= maxLat &&
+            pts[i].lon >= minLon && pts[i].lon <= maxLon) {
+          pointsInBounds++;
+        }
+      }
+    }
+    free(pts);
+  } else {
+    for (int i = 0; i < _pointCount; i++) {
+      if (_points[i].lat >= mapMinLat && _points[i].lat <= mapMaxLat &&
+          _points[i].lon >= mapMinLon && _points[i].lon <= mapMaxLon) {
+        pointsInBounds++;
+      }
+    }
+  }
+  
+  coveragePercent = (pointsInBounds * 100.0f) / _pointCount;
+  
+  if (coveragePercent > 90.0f) return TRACK_VALID;
+  if (coveragePercent >= 50.0f) return TRACK_PARTIAL;
+  return TRACK_OUT_OF_BOUNDS;
+}
+
+const char* GPSTrackManager::getValidationMessage(TrackValidation result, float coverage) {
+  static char msg[128];
+  
+  switch (result) {
+    case TRACK_VALID:
+      snprintf(msg, sizeof(msg), "Track valid (%.0f%% visible)", coverage);
+      break;
+    case TRACK_PARTIAL:
+      snprintf(msg, sizeof(msg), "Warning: Only %.0f%% of track visible on map", coverage);
+      break;
+    case TRACK_OUT_OF_BOUNDS:
+      snprintf(msg, sizeof(msg), "Error: Track outside map bounds (%.0f%% visible)", coverage);
+      break;
+    case TRACK_NO_MAP_LOADED:
+      strcpy(msg, "Error: No map loaded for validation");
+      break;
+    case TRACK_EMPTY:
+      strcpy(msg, "Error: No track loaded");
+      break;
+    default:
+      strcpy(msg, "Unknown validation status");
+  }
+  
+  return msg;
+}
+
+void GPSTrackManager::drawTrackPoints(MapRenderer* renderer, const GPSTrackFixedPoint* pts, int count,
+                                      int32_t centerLatMicro, int32_t centerLonMicro,
+                                      int32_t scaleX, int32_t scaleY, const MapFeatureStyle& style) {
+  int viewWidth = renderer->getWidth();
+  int viewHeight = renderer->getHeight();
+  
+  // Draw track as connected line segments
+  int16_t prevX = -1, prevY = -1;
+  bool prevValid = false;
+  bool havePrev = false;
+  
+  for (int i = 0; i < count; i++) {
+    int16_t screenX, screenY;
+    MapCore::geoToScreen(pts[i].lat, pts[i].lon, centerLatMicro, centerLonMicro,
+                         scaleX, scaleY, viewWidth, viewHeight, screenX, screenY);
+    
+    // Zoomed out, many points share a pixel: only pixel steps become lines
+    if (havePrev && screenX == prevX && screenY == prevY) continue;
+    
+    // Check if point is on screen (with margin)
+    bool onScreen = (screenX >= -10 && screenX < viewWidth + 10 &&
+                     screenY >= -10 && screenY < viewHeight + 10);
+    
+    if (onScreen && prevValid) {
+      renderer->drawLine(prevX, prevY, screenX, screenY, style);
+    }
+    
+    prevX = screenX;
+    prevY = screenY;
+    prevValid = onScreen;
+    havePrev = true;
+  }
+}
+
+void GPSTrackManager::renderTrack(MapRenderer* renderer,
+                                   float centerLat, float centerLon,
+                                   int32_t scaleX, int32_t scaleY) {
+  if (_pointCount < 2) return;
+  
+  int viewWidth = renderer->getWidth();
+  int viewHeight = renderer->getHeight();
+  int32_t centerLatMicro = (int32_t)(centerLat * 1000000);
+  int32_t centerLonMicro = (int32_t)(centerLon * 1000000);
+  
+  // Track style: dotted line to distinguish from roads
+  MapFeatureStyle trackStyle = {LINE_DOTTED, 2, 12, true, 0xFFFF};
+  
+  int32_t startLatMicro, startLonMicro, endLatMicro, endLonMicro;
+  
+  if (_binary) {
+    // Only chunks whose bounding box reaches the viewport are read and decoded.
+    // The half-diagonal (plus the on-screen margin) covers any map rotation.
+    static GPSTrackFixedPoint* sRenderPts = nullptr;
+    if (!sRenderPts) {
+      sRenderPts = (GPSTrackFixedPoint*)ps_alloc(GPS_TRACK_CHUNK_MAX * sizeof(GPSTrackFixedPoint),
+                                                 AllocPref::PreferPSRAM, "gps.render");
+      if (!sRenderPts) return;
+    }
+    int32_t reachPx = (int32_t)sqrtf((float)(viewWidth * viewWidth + viewHeight * viewHeight)) / 2 + 10;
+    int64_t reachLat = (int64_t)reachPx * scaleY;
+    int64_t reachLon = (int64_t)reachPx * scaleX;
+    uint32_t chunksDrawn = 0;
+    for (uint32_t k = 0; k < _header.chunkCount; k++) {
+      const GPSTrackChunkEntry& e = _chunks[k];
+      if (e.maxLat < centerLatMicro - reachLat || e.minLat > centerLatMicro + reachLat ||
+          e.maxLon < centerLonMicro - reachLon || e.minLon > centerLonMicro + reachLon) {
+        continue;
+      }
+      int n = readChunk(k, sRenderPts);
+      if (n < 2) continue;
+      drawTrackPoints(renderer, sRenderPts, n, centerLatMicro, centerLonMicro, scaleX, scaleY, trackStyle);
+      chunksDrawn++;
+    }
+    DEBUG_MAPS_RENDERINGF("[MAPS] renderTrack: %lu/%lu chunks in view",
+                          (unsigned long)chunksDrawn, (unsigned long)_header.chunkCount);
+    
+    startLatMicro = _header.startLat;
+    startLonMicro = _header.startLon;
+    endLatMicro = _header.endLat;
+    endLonMicro = _header.endLon;
+  } else {
+    // In-RAM track: converted in small batches that share their boundary point
+    const int batchSize = 32;
+    GPSTrackFixedPoint batch[batchSize];
+    for (int first = 0; first < _pointCount - 1; first += batchSize - 1) {
+      int n = _pointCount - first;
+      if (n > batchSize) n = batchSize;
+      for (int i = 0; i < n; i++) {
+        batch[i].lat = (int32_t)(_points[first + i].lat * 1000000);
+        batch[i].lon = (int32_t)(_points[first + i].lon * 1000000);
+        batch[i].timeMs = 0;
+      }
+      drawTrackPoints(renderer, batch, n, centerLatMicro, centerLonMicro, scaleX, scaleY, trackStyle);
+    }
+    
+    startLatMicro = (int32_t)(_points[0].lat * 1000000);
+    startLonMicro = (int32_t)(_points[0].lon * 1000000);
+    endLatMicro = (int32_t)(_points[_pointCount - 1].lat * 1000000);
+    endLonMicro = (int32_t)(_points[_pointCount - 1].lon * 1000000);
+  }
+  
+  // Draw start marker (small circle)
+  {
+    int16_t startX, startY;
+    MapCore::geoToScreen(startLatMicro, startLonMicro, centerLatMicro, centerLonMicro,
+                         scaleX, scaleY, viewWidth, viewHeight, startX, startY);
+    
+    if (startX >= 0 && startX < viewWidth && startY >= 0 && startY < viewHeight) {
+      MapFeatureStyle markerStyle = {LINE_SOLID, 1, 14, true, 0xFFFF};
+      // Draw small circle for start
+      renderer->drawLine(startX - 2, startY, startX + 2, startY, markerStyle);
+      renderer->drawLine(startX, startY - 2, startX, startY + 2, markerStyle);
+    }
+  }
+  
+  // Draw end marker (small square)
+  {
+    int16_t endX, endY;
+    MapCore::geoToScreen(endLatMicro, endLonMicro, centerLatMicro, centerLonMicro,
+                         scaleX, scaleY, viewWidth, viewHeight, endX, endY);
+    
+    if (endX >= 0 && endX < viewWidth && endY >= 0 && endY < viewHeight) {
+      MapFeatureStyle markerStyle = {LINE_SOLID, 1, 14, true, 0xFFFF};
+      // Draw small square for end
+      renderer->drawLine(endX - 2, endY - 2, endX + 2, endY - 2, markerStyle);
+      renderer->drawLine(endX + 2, endY - 2, endX + 2, endY + 2, markerStyle);
+      renderer->drawLine(endX + 2, endY + 2, endX - 2, endY + 2, markerStyle);
+      renderer->drawLine(endX - 2, endY + 2, endX - 2, endY - 2, markerStyle);
+    }
+  }
+}
+// =============================================================================
+// LocationContextManager Implementation
+// =============================================================================
+
+bool LocationContextManager::shouldUpdate(float lat, float lon) {
+  if (!MapCore::hasValidMap()) {
+    return false;
+  }
+  
+  uint32_t now = millis();
+  
+  // Check if enough time has passed
+  if (_context.valid && (now - _context.lastUpdateMs) < CONTEXT_UPDATE_INTERVAL_MS) {
+    // Also check if we've moved enough
+    float dist = haversineDistance(_context.lastLat, _context.lastLon, lat, lon);
+    if (dist < CONTEXT_UPDATE_MIN_DISTANCE) {
+      return false;
+    }
+  }
+  
+  return true;
+}
+
+void LocationContextManager::updateContext(float lat, float lon) {
+  // The segment grids walked below belong to cache slots
+  MapCacheGuard cacheGuard("LocationContext.update");
+  const LoadedMap& map = MapCore::getCurrentMap();
+  if (!map.valid || !map.tileDir) {
+    _context.valid = false;
+    return;
+  }
+  
+  // Reset context
+  _context.nearestRoad[0] = '\0';
+  _context.roadDistanceM = 999999.0f;
+  _context.nearestArea[0] = '\0';
+  _context.areaDistanceM = 999999.0f;
+  
+  // Convert position to microdegrees for tile lookup
+  int32_t latMicro = (int32_t)(lat * 1000000);
+  int32_t lonMicro = (int32_t)(lon * 1000000);
+  
+  // Candidates are ranked in a local equirectangular projection (longitude
+  // shrunk by cos(lat)); only the two winners get a haversine distance
+  const int32_t cosLatQ16 = (int32_t)(cosf(lat * PI / 180.0f) * 65536.0f);
+  
+  struct Nearest {
+    float d2;                 // Squared projected distance (microdegrees^2)
+    int32_t lat, lon;         // Closest point on the winning segment
+    uint16_t nameIndex;
+    uint8_t type;
+    bool found;
+  };
+  Nearest best[2] = {};       // [0] = road, [1] = area
+  best[0].d2 = best[1].d2 = INFINITY;
+  
+  // Find which tile contains this position
+  int tileX = (lonMicro - map.header.minLon) / map.tileW;
+  int tileY = (latMicro - map.header.minLat) / map.tileH;
+  
+  // Clamp to valid range
+  if (tileX < 0) tileX = 0;
+  if (tileX >= map.tileGridSize) tileX = map.tileGridSize - 1;
+  if (tileY < 0) tileY = 0;
+  if (tileY >= map.tileGridSize) tileY = map.tileGridSize - 1;
+  
+  // Squared projected distance from the position to a microdegree rectangle
+  auto rectDistance2 = [&](int32_t minLat, int32_t maxLat, int32_t minLon, int32_t maxLon) -> float {
+    int32_t dLat = latMicro < minLat ? minLat - latMicro : (latMicro > maxLat ? latMicro - maxLat : 0);
+    int32_t dLon = lonMicro < minLon ? minLon - lonMicro : (lonMicro > maxLon ? lonMicro - maxLon : 0);
+    float x = (float)(((int64_t)dLon * cosLatQ16) >> 16);
+    float y = (float)dLat;
+    return x * x + y * y;
+  };
+  
+  // Check this tile and adjacent tiles (3x3 neighborhood)
+  for (int dy = -1; dy <= 1; dy++) {
+    for (int dx = -1; dx <= 1; dx++) {
+      int tx = tileX + dx;
+      int ty = tileY + dy;
+      if (tx < 0 || tx >= map.tileGridSize || ty < 0 || ty >= map.tileGridSize) continue;
+      
+      uint16_t tileIdx = ty * map.tileGridSize + tx;
+      if (tileIdx >= map.tileCount) continue;
+      
+      HWMapTileDirEntry& tile = map.tileDir[tileIdx];
+      if (tile.payloadSize == 0) continue;
+      
+      // Calculate tile halo bounds for dequantization
+      int32_t tileMinLon = map.header.minLon + tx * map.tileW - map.haloW;
+      int32_t tileMaxLon = map.header.minLon + (tx + 1) * map.tileW + map.haloW;
+      int32_t tileMinLat = map.header.minLat + ty * map.tileH - map.haloH;
+      int32_t tileMaxLat = map.header.minLat + (ty + 1) * map.tileH + map.haloH;
+      int32_t haloLonSpan = tileMaxLon - tileMinLon;
+      int32_t haloLatSpan = tileMaxLat - tileMinLat;
+      
+      // A tile that can't beat either current answer isn't even loaded
+      float bound = best[0].d2 > best[1].d2 ? best[0].d2 : best[1].d2;
+      if (rectDistance2(tileMinLat, tileMaxLat, tileMinLon, tileMaxLon) > bound) continue;
+      
+      // Load tile data
+      size_t tileDataSize;
+      const uint8_t* tileData = MapCore::loadTileData(tileIdx, &tileDataSize);
+      if (!tileData || tileDataSize == 0) continue;
+      
+      const TileSegmentGrid* grid = MapCore::getTileSegmentGrid(tileIdx, tileData, tileDataSize);
+      if (!grid || !grid->segments) continue;
+      
+      // Segments [begin, end) that lie at least cellD2 away
+      auto scanSegments = [&](uint32_t begin, uint32_t end, float cellD2) {
+        for (uint32_t i = begin; i < end; i++) {
+          const TileSegment& seg = grid->segments[i];
+          const TileSegFeature& feat = grid->features[seg.feature];
+          Nearest& nearest = best[contextFeatureClass(feat.type)];
+          if (cellD2 > nearest.d2) continue;
+          
+          int32_t lat1 = tileMinLat + (int32_t)((int64_t)seg.qLat1 * haloLatSpan >> 16);
+          int32_t lon1 = tileMinLon + (int32_t)((int64_t)seg.qLon1 * haloLonSpan >> 16);
+          int32_t lat2 = tileMinLat + (int32_t)((int64_t)seg.qLat2 * haloLatSpan >> 16);
+          int32_t lon2 = tileMinLon + (int32_t)((int64_t)seg.qLon2 * haloLonSpan >> 16);
+          int32_t closestLat, closestLon;
+          float d2 = segmentDistance2(latMicro, lonMicro, cosLatQ16, lat1, lon1, lat2, lon2,
+                                      closestLat, closestLon);
+          if (d2 < nearest.d2) {
+            nearest.d2 = d2;
+            nearest.lat = closestLat;
+            nearest.lon = closestLon;
+            nearest.nameIndex = feat.nameIndex;
+            nearest.type = feat.type;
+            nearest.found = true;
+          }
+        }
+      };
+      
+      // A sparse tile is cheaper to scan whole than to order its cells
+      uint32_t segmentCount = grid->cellStart[SEG_GRID_DIM * SEG_GRID_DIM];
+      if (segmentCount <= SEG_GRID_SCAN_ALL) {
+        scanSegments(0, segmentCount, 0.0f);
+        continue;
+      }
+      
+      // Visit cells nearest-first and stop once no cell can improve either class.
+      // Cell rectangles share their edges so points between two quantized steps are covered.
+      struct CellOrder { float d2; uint8_t cell; };
+      CellOrder order[SEG_GRID_DIM * SEG_GRID_DIM];
+      uint8_t cellCount = 0;
+      for (uint8_t r = 0; r < SEG_GRID_DIM; r++) {
+        int32_t cMinLat = tileMinLat + (int32_t)((int64_t)(r << SEG_GRID_SHIFT) * haloLatSpan >> 16);
+        int32_t cMaxLat = tileMinLat + (int32_t)((int64_t)((r + 1) << SEG_GRID_SHIFT) * haloLatSpan >> 16);
+        for (uint8_t c = 0; c < SEG_GRID_DIM; c++) {
+          uint8_t cell = r * SEG_GRID_DIM + c;
+          if (grid->cellStart[cell] == grid->cellStart[cell + 1]) continue;
+          int32_t cMinLon = tileMinLon + (int32_t)((int64_t)(c << SEG_GRID_SHIFT) * haloLonSpan >> 16);
+          int32_t cMaxLon = tileMinLon + (int32_t)((int64_t)((c + 1) << SEG_GRID_SHIFT) * haloLonSpan >> 16);
+          order[cellCount].d2 = rectDistance2(cMinLat, cMaxLat, cMinLon, cMaxLon);
+          order[cellCount].cell = cell;
+          cellCount++;
+        }
+      }
+      std::sort(order, order + cellCount, [](const CellOrder& a, const CellOrder& b) { return a.d2 < b.d2; });
+      
+      for (uint8_t k = 0; k < cellCount; k++) {
+        float cellD2 = order[k].d2;
+        if (cellD2 > best[0].d2 && cellD2 > best[1].d2) break;
+        uint8_t cell = order[k].cell;
+        scanSegments(grid->cellStart[cell], grid->cellStart[cell + 1], cellD2);
+      }
+    }
+  }
+  
+  if (best[0].found) {
+    _context.roadDistanceM = haversineDistance(lat, lon, best[0].lat / 1000000.0f, best[0].lon / 1000000.0f);
+    _context.roadType = (MapFeatureType)best[0].type;
+    const char* featureName = MapCore::getName(best[0].nameIndex);
+    if (featureName) {
+      strncpy(_context.nearestRoad, featureName, sizeof(_context.nearestRoad) - 1);
+      _context.nearestRoad[sizeof(_context.nearestRoad) - 1] = '\0';
+    }
+  }
+  
+  if (best[1].found) {
+    _context.areaDistanceM = haversineDistance(lat, lon, best[1].lat / 1000000.0f, best[1].lon / 1000000.0f);
+    _context.areaType = (MapFeatureType)best[1].type;
+    const char* featureName = MapCore::getName(best[1].nameIndex);
+    if (featureName) {
+      strncpy(_context.nearestArea, featureName, sizeof(_context.nearestArea) - 1);
+      _context.nearestArea[sizeof(_context.nearestArea) - 1] = '\0';
+    }
+  }
+  
+  _context.lastUpdateMs = millis();
+  _context.lastLat = lat;
+  _context.lastLon = lon;
+  _context.valid = true;
+}
+
+float LocationContextManager::segmentDistance2(int32_t lat, int32_t lon, int32_t cosLatQ16,
+                                               int32_t lat1, int32_t lon1, int32_t lat2, int32_t lon2,
+                                               int32_t& closestLat, int32_t& closestLon) {
+  // Projected offsets from the query point (x = scaled longitude, y = latitude)
+  int64_t ax = ((int64_t)(lon1 - lon) * cosLatQ16) >> 16;
+  int64_t ay = lat1 - lat;
+  int64_t bx = ((int64_t)(lon2 - lon) * cosLatQ16) >> 16;
+  int64_t by = lat2 - lat;
+  int64_t abx = bx - ax;
+  int64_t aby = by - ay;
+  
+  // Clamp the projection of the origin onto AB to the segment
+  int64_t ab2 = abx * abx + aby * aby;
+  int64_t dot = -(ax * abx + ay * aby);
+  if (ab2 == 0 || dot <= 0) {
+    closestLat = lat1;
+    closestLon = lon1;
+    return (float)ax * (float)ax + (float)ay * (float)ay;
+  }
+  if (dot >= ab2) {
+    closestLat = lat2;
+    closestLon = lon2;
+    return (float)bx * (float)bx + (float)by * (float)by;
+  }
+  
+  float t = (float)dot / (float)ab2;
+  closestLat = lat1 + (int32_t)(t * (float)(lat2 - lat1));
+  closestLon = lon1 + (int32_t)(t * (float)(lon2 - lon1));
+  float px = (float)ax + t * (float)abx;
+  float py = (float)ay + t * (float)aby;
+  return px * px + py * py;
+}
+
+float LocationContextManager::haversineDistance(float lat1, float lon1, float lat2, float lon2) {
+  const float R = 6371000.0f;  // Earth radius in meters
+  
+  float dLat = (lat2 - lat1) * PI / 180.0f;
+  float dLon = (lon2 - lon1) * PI / 180.0f;
+  
+  float a = sinf(dLat / 2) * sinf(dLat / 2) +
+            cosf(lat1 * PI / 180.0f) * cosf(lat2 * PI / 180.0f) *
+            sinf(dLon / 2) * sinf(dLon / 2);
+  
+  float c = 2 * atan2f(sqrtf(a), sqrtf(1 - a));
+  
+  return R * c;
+}
+
+// =============================================================================
+// MapRouter Implementation
+// =============================================================================
+
+MapRoute MapRouter::_route = {};
+
+// Metres per microdegree of latitude (spherical Earth, R = 6371 km)
+#define ROUTE_M_PER_MICRO_LAT  0.1111949f
+
+struct RouteNode {
+  int32_t lat, lon;          // Microdegrees (first vertex seen)
+  float g;                   // Best known cost from start
+  float f;                   // g + heuristic while open
+  int32_t firstEdge;         // Adjacency list head (-1 = none)
+  int32_t parent;            // Predecessor on the best path (-1 = none)
+  int32_t hashNext;          // Next node in the same lookup bucket
+  int32_t heapPos;           // Index in the open heap (-1 = not open)
+  bool closed;
+};
+
+struct RouteEdge {
+  int32_t to;
+  int32_t next;              // Next edge out of the same node
+  float cost;
+};
+
+// Graph and search state for one computeRoute() call, all in PSRAM
+struct RouteGraph {
+  RouteNode* nodes = nullptr;
+  RouteEdge* edges = nullptr;
+  int32_t* buckets = nullptr;
+  int32_t* heap = nullptr;
+  uint8_t* tileLoaded = nullptr;
+  uint8_t* tileBuf = nullptr;   // Private copy of one payload (keeps the render cache intact)
+  uint32_t tileBufSize = 0;
+  int32_t nodeCount = 0;
+  int32_t edgeCount = 0;
+  int32_t heapCount = 0;
+  uint16_t tilesLoaded = 0;
+  bool overflow = false;     // A bound was hit; the result is incomplete
+  
+  int32_t mergeTol = 1;      // Vertex merge distance (microdegrees)
+  float mPerMicroLon = ROUTE_M_PER_MICRO_LAT;
+  
+  ~RouteGraph() {
+    free(nodes);
+    free(edges);
+    free(buckets);
+    free(heap);
+    free(tileLoaded);
+    free(tileBuf);
+  }
+  
+  bool alloc(uint16_t tileCount) {
+    nodes = (RouteNode*)ps_alloc(sizeof(RouteNode) * ROUTE_MAX_NODES, AllocPref::PreferPSRAM, "route.nodes");
+    edges = (RouteEdge*)ps_alloc(sizeof(RouteEdge) * ROUTE_MAX_EDGES, AllocPref::PreferPSRAM, "route.edges");
+    buckets = (int32_t*)ps_alloc(sizeof(int32_t) * ROUTE_HASH_BUCKETS, AllocPref::PreferPSRAM, "route.hash");
+    heap = (int32_t*)ps_alloc(sizeof(int32_t) * ROUTE_MAX_OPEN, AllocPref::PreferPSRAM, "route.open");
+    tileLoaded = (uint8_t*)ps_calloc(tileCount, 1, AllocPref::PreferPSRAM, "route.tiles");
+    if (!nodes || !edges || !buckets || !heap || !tileLoaded) return false;
+    for (uint32_t i = 0; i < ROUTE_HASH_BUCKETS; i++) buckets[i] = -1;
+    return true;
+  }
+  
+  float distance(int32_t lat1, int32_t lon1, int32_t lat2, int32_t lon2) const {
+    float dy = (float)(lat2 - lat1) * ROUTE_M_PER_MICRO_LAT;
+    float dx = (float)(lon2 - lon1) * mPerMicroLon;
+    return sqrtf(dx * dx + dy * dy);
+  }
+  
+  static int32_t floorDiv(int32_t a, int32_t b) {
+    int32_t q = a / b;
+    return (a % b != 0 && (a < 0)) ? q - 1 : q;
+  }
+  
+  static uint32_t bucketOf(int32_t cy, int32_t cx) {
+    return ((uint32_t)cy * 73856093u ^ (uint32_t)cx * 19349663u) & (ROUTE_HASH_BUCKETS - 1);
+  }
+  
+  // Node for a vertex, merging with any existing node within mergeTol
+  int32_t nodeAt(int32_t lat, int32_t lon) {
+    int32_t cy = floorDiv(lat, mergeTol);
+    int32_t cx = floorDiv(lon, mergeTol);
+    for (int32_t dy = -1; dy <= 1; dy++) {
+      for (int32_t dx = -1; dx <= 1; dx++) {
+        for (int32_t n = buckets[bucketOf(cy + dy, cx + dx)]; n >= 0; n = nodes[n].hashNext) {
+          if (abs(nodes[n].lat - lat) <= mergeTol && abs(nodes[n].lon - lon) <= mergeTol) return n;
+        }
+      }
+    }
+    if (nodeCount >= ROUTE_MAX_NODES) {
+      overflow = true;
+      return -1;
+    }
+    int32_t id = nodeCount++;
+    RouteNode& node = nodes[id];
+    node.lat = lat;
+    node.lon = lon;
+    node.g = INFINITY;
+    node.f = INFINITY;
+    node.firstEdge = -1;
+    node.parent = -1;
+    node.heapPos = -1;
+    node.closed = false;
+    uint32_t b = bucketOf(cy, cx);
+    node.hashNext = buckets[b];
+    buckets[b] = id;
+    return id;
+  }
+  
+  bool addEdge(int32_t from, int32_t to, float cost) {
+    for (int32_t e = nodes[from].firstEdge; e >= 0; e = edges[e].next) {
+      if (edges[e].to == to) {
+        if (cost < edges[e].cost) edges[e].cost = cost;
+        return true;
+      }
+    }
+    if (edgeCount >= ROUTE_MAX_EDGES) {
+      overflow = true;
+      return false;
+    }
+    RouteEdge& edge = edges[edgeCount];
+    edge.to = to;
+    edge.cost = cost;
+    edge.next = nodes[from].firstEdge;
+    nodes[from].firstEdge = edgeCount++;
+    return true;
+  }
+  
+  // Add the road segments of one tile that have an endpoint inside its core
+  // (tile without halo, widened by mergeTol). Any edge touching a vertex is
+  // therefore present once the tile around that vertex is loaded.
+  bool loadTile(const LoadedMap& map, int tx, int ty) {
+    uint16_t tileIdx = ty * map.tileGridSize + tx;
+    if (tileIdx >= map.tileCount || tileLoaded[tileIdx]) return true;
+    tileLoaded[tileIdx] = 1;
+    tilesLoaded++;
+    uint32_t payloadSize = map.tileDir[tileIdx].payloadSize;
+    if (payloadSize == 0) return true;
+    
+    // Read straight from the file: a route touches many tiles once each, and
+    // pulling them through the tile cache would evict the OLED's working set
+    if (payloadSize > tileBufSize) {
+      uint8_t* grown = (uint8_t*)ps_realloc(tileBuf, payloadSize, AllocPref::PreferPSRAM, "route.tile");
+      if (!grown) return true;
+      tileBuf = grown;
+      tileBufSize = payloadSize;
+    }
+    size_t tileDataSize = MapCore::readMapFile(map.tileDir[tileIdx].offset, tileBuf, payloadSize);
+    const uint8_t* tileData = tileBuf;
+    if (tileDataSize < 2) return true;
+    
+    int32_t tileMinLon = map.header.minLon + tx * map.tileW - map.haloW;
+    int32_t tileMinLat = map.header.minLat + ty * map.tileH - map.haloH;
+    int32_t haloLonSpan = map.tileW + 2 * map.haloW;
+    int32_t haloLatSpan = map.tileH + 2 * map.haloH;
+    int32_t coreMinLon = map.header.minLon + tx * map.tileW - mergeTol;
+    int32_t coreMaxLon = coreMinLon + map.tileW + 2 * mergeTol;
+    int32_t coreMinLat = map.header.minLat + ty * map.tileH - mergeTol;
+    int32_t coreMaxLat = coreMinLat + map.tileH + 2 * mergeTol;
+    
+    MapTileReader reader(tileData, tileDataSize, map.header.version);
+    MapFeatureInfo info;
+    while (reader.next(info)) {
+      float weight = MapRouter::classWeight(info.type);
+      if (weight <= 0.0f || info.pointCount < 2) continue;
+      
+      uint16_t qLat, qLon;
+      if (!reader.point(qLat, qLon)) continue;
+      int32_t prevLat = tileMinLat + (int32_t)((int64_t)qLat * haloLatSpan >> 16);
+      int32_t prevLon = tileMinLon + (int32_t)((int64_t)qLon * haloLonSpan >> 16);
+      bool prevIn = prevLat >= coreMinLat && prevLat <= coreMaxLat && prevLon >= coreMinLon && prevLon <= coreMaxLon;
+      int32_t prevNode = -1;
+      
+      while (reader.point(qLat, qLon)) {
+        int32_t lat = tileMinLat + (int32_t)((int64_t)qLat * haloLatSpan >> 16);
+        int32_t lon = tileMinLon + (int32_t)((int64_t)qLon * haloLonSpan >> 16);
+        bool in = lat >= coreMinLat && lat <= coreMaxLat && lon >= coreMinLon && lon <= coreMaxLon;
+        int32_t node = -1;
+        
+        if (in || prevIn) {
+          if (prevNode < 0) prevNode = nodeAt(prevLat, prevLon);
+          node = nodeAt(lat, lon);
+          if (prevNode < 0 || node < 0) return false;
+          if (node != prevNode) {
+            float cost = distance(prevLat, prevLon, lat, lon) * weight;
+            if (!addEdge(prevNode, node, cost) || !addEdge(node, prevNode, cost)) return false;
+          }
+        }
+        
+        prevLat = lat;
+        prevLon = lon;
+        prevIn = in;
+        prevNode = node;
+      }
+    }
+    return true;
+  }
+  
+  // Load the tiles whose widened core contains the position, or the whole
+  // 3x3 block around it
+  bool loadTilesAround(const LoadedMap& map, int32_t lat, int32_t lon, bool wholeBlock) {
+    int tx = (lon - map.header.minLon) / map.tileW;
+    int ty = (lat - map.header.minLat) / map.tileH;
+    for (int dy = -1; dy <= 1; dy++) {
+      for (int dx = -1; dx <= 1; dx++) {
+        int x = tx + dx, y = ty + dy;
+        if (x < 0 || x >= map.tileGridSize || y < 0 || y >= map.tileGridSize) continue;
+        if (!wholeBlock) {
+          // Neighbours only matter when the vertex sits on their edge
+          int32_t minLon = map.header.minLon + x * map.tileW - mergeTol;
+          int32_t minLat = map.header.minLat + y * map.tileH - mergeTol;
+          if (lon < minLon || lon > minLon + map.tileW + 2 * mergeTol ||
+              lat < minLat || lat > minLat + map.tileH + 2 * mergeTol) {
+            continue;
+          }
+        }
+        if (!loadTile(map, x, y)) return false;
+      }
+    }
+    return true;
+  }
+  
+  // Closest connected node to a position, or -1 if none within maxM
+  int32_t nearestNode(int32_t lat, int32_t lon, float maxM) const {
+    int32_t best = -1;
+    float bestD = maxM;
+    for (int32_t n = 0; n < nodeCount; n++) {
+      if (nodes[n].firstEdge < 0) continue;
+      float d = distance(lat, lon, nodes[n].lat, nodes[n].lon);
+      if (d <= bestD) {
+        bestD = d;
+        best = n;
+      }
+    }
+    return best;
+  }
+  
+  void heapSwap(int32_t a, int32_t b) {
+    int32_t na = heap[a], nb = heap[b];
+    heap[a] = nb;
+    heap[b] = na;
+    nodes[nb].heapPos = a;
+    nodes[na].heapPos = b;
+  }
+  
+  void heapUp(int32_t i) {
+    while (i > 0) {
+      int32_t parent = (i - 1) / 2;
+      if (nodes[heap[parent]].f <= nodes[heap[i]].f) break;
+      heapSwap(i, parent);
+      i = parent;
+    }
+  }
+  
+  void heapDown(int32_t i) {
+    for (;;) {
+      int32_t l = 2 * i + 1, r = l + 1, m = i;
+      if (l < heapCount && nodes[heap[l]].f < nodes[heap[m]].f) m = l;
+      if (r < heapCount && nodes[heap[r]].f < nodes[heap[m]].f) m = r;
+      if (m == i) break;
+      heapSwap(i, m);
+      i = m;
+    }
+  }
+  
+  // Insert or decrease-key; false when the open set is full
+  bool heapPush(int32_t n) {
+    if (nodes[n].heapPos >= 0) {
+      heapUp(nodes[n].heapPos);
+      return true;
+    }
+    if (heapCount >= ROUTE_MAX_OPEN) {
+      overflow = true;
+      return false;
+    }
+    heap[heapCount] = n;
+    nodes[n].heapPos = heapCount++;
+    heapUp(nodes[n].heapPos);
+    return true;
+  }
+  
+  int32_t heapPop() {
+    int32_t top = heap[0];
+    heapSwap(0, --heapCount);
+    nodes[top].heapPos = -1;
+    heapDown(0);
+    return top;
+  }
+};
+
+float MapRouter::classWeight(uint8_t featureType) {
+  switch (featureType) {
+    case MAP_FEATURE_HIGHWAY:    return 1.0f;
+    case MAP_FEATURE_ROAD_MAJOR: return 1.2f;
+    case MAP_FEATURE_ROAD_MINOR: return 1.5f;
+    case MAP_FEATURE_PATH:       return 2.5f;
+    default:                     return 0.0f;
+  }
+}
+
+const char* MapRouter::resultString(MapRouteResult result) {
+  switch (result) {
+    case ROUTE_OK:               return "OK";
+    case ROUTE_NO_MAP:           return "No map loaded";
+    case ROUTE_NO_ROAD_AT_START: return "No road near start";
+    case ROUTE_NO_ROAD_AT_GOAL:  return "No road near destination";
+    case ROUTE_NO_PATH:          return "No connected path";
+    case ROUTE_OUT_OF_MEMORY:    return "Out of memory";
+    case ROUTE_LIMIT_REACHED:    return "Route search limit reached";
+    default:                     return "Unknown";
+  }
+}
+
+void MapRouter::clearRoute() {
+  MapCacheGuard cacheGuard("MapRouter.clearRoute");
+  _route.pointCount = 0;
+  _route.valid = false;
+  if (gMapHighlight.mode == HIGHLIGHT_ROUTE) mapHighlightClear();
+}
+
+MapRouteResult MapRouter::computeRoute(float fromLat, float fromLon, float toLat, float toLon) {
+  // Streams tiles (and rewrites _route) while the render task may be drawing
+  MapCacheGuard cacheGuard("MapRouter.computeRoute");
+  const LoadedMap& map = MapCore::getCurrentMap();
+  if (!map.valid || !map.tileDir || map.tileCount == 0) return ROUTE_NO_MAP;
+  uint32_t startMs = millis();
+  
+  if (!_route.lat) {
+    _route.lat = (int32_t*)ps_alloc(sizeof(int32_t) * (ROUTE_MAX_POINTS + 2), AllocPref::PreferPSRAM, "route.lat");
+    _route.lon = (int32_t*)ps_alloc(sizeof(int32_t) * (ROUTE_MAX_POINTS + 2), AllocPref::PreferPSRAM, "route.lon");
+    if (!_route.lat || !_route.lon) {
+      free(_route.lat);
+      free(_route.lon);
+      _route.lat = _route.lon = nullptr;
+      return ROUTE_OUT_OF_MEMORY;
+    }
+  }
+  
+  RouteGraph graph;
+  if (!graph.alloc(map.tileCount)) return ROUTE_OUT_OF_MEMORY;
+  
+  // One quantization step of the widest tile: copies of a vertex in
+  // neighbouring tiles can be off by that much
+  int32_t span = map.tileW + 2 * map.haloW;
+  if (map.tileH + 2 * map.haloH > span) span = map.tileH + 2 * map.haloH;
+  graph.mergeTol = span / 65536 + 1;
+  float midLat = (map.header.minLat + map.header.maxLat) / 2000000.0f;
+  graph.mPerMicroLon = ROUTE_M_PER_MICRO_LAT * cosf(midLat * PI / 180.0f);
+  
+  int32_t fromLatMicro = (int32_t)(fromLat * 1000000);
+  int32_t fromLonMicro = (int32_t)(fromLon * 1000000);
+  int32_t toLatMicro = (int32_t)(toLat * 1000000);
+  int32_t toLonMicro = (int32_t)(toLon * 1000000);
+  
+  // Snap both ends to the nearest road node in their 3x3 tile block
+  if (!graph.loadTilesAround(map, fromLatMicro, fromLonMicro, true) ||
+      !graph.loadTilesAround(map, toLatMicro, toLonMicro, true)) {
+    return ROUTE_LIMIT_REACHED;
+  }
+  int32_t start = graph.nearestNode(fromLatMicro, fromLonMicro, ROUTE_SNAP_MAX_M);
+  if (start < 0) return ROUTE_NO_ROAD_AT_START;
+  int32_t goal = graph.nearestNode(toLatMicro, toLonMicro, ROUTE_SNAP_MAX_M);
+  if (goal < 0) return ROUTE_NO_ROAD_AT_GOAL;
+  
+  const int32_t goalLat = graph.nodes[goal].lat;
+  const int32_t goalLon = graph.nodes[goal].lon;
+  RouteNode* nodes = graph.nodes;
+  
+  nodes[start].g = 0.0f;
+  nodes[start].f = graph.distance(nodes[start].lat, nodes[start].lon, goalLat, goalLon);
+  graph.heapPush(start);
+  
+  uint32_t expanded = 0;
+  bool found = false;
+  while (graph.heapCount > 0) {
+    int32_t u = graph.heapPop();
+    nodes[u].closed = true;
+    expanded++;
+    if (u == goal) {
+      found = true;
+      break;
+    }
+    
+    // Stream in the tiles holding this vertex's edges
+    if (!graph.loadTilesAround(map, nodes[u].lat, nodes[u].lon, false)) break;
+    
+    for (int32_t e = nodes[u].firstEdge; e >= 0; e = graph.edges[e].next) {
+      int32_t v = graph.edges[e].to;
+      if (nodes[v].closed) continue;
+      float g = nodes[u].g + graph.edges[e].cost;
+      if (g >= nodes[v].g) continue;
+      nodes[v].g = g;
+      nodes[v].f = g + graph.distance(nodes[v].lat, nodes[v].lon, goalLat, goalLon);
+      nodes[v].parent = u;
+      if (!graph.heapPush(v)) break;
+    }
+    if (graph.overflow) break;
+  }
+  
+  uint32_t elapsed = millis() - startMs;
+  DEBUG_MAPS_PERFF("[MAP_PERF] route: %lums | expanded:%lu nodes:%ld edges:%ld tiles:%u found:%d overflow:%d",
+                   (unsigned long)elapsed, (unsigned long)expanded, (long)graph.nodeCount,
+                   (long)graph.edgeCount, graph.tilesLoaded, found ? 1 : 0, graph.overflow ? 1 : 0);
+  if (!found) return graph.overflow ? ROUTE_LIMIT_REACHED : ROUTE_NO_PATH;
+  
+  // Walk back from the goal: count, measure, then emit start -> goal
+  uint32_t pathCount = 0;
+  float lengthM = 0.0f;
+  for (int32_t n = goal; n >= 0; n = nodes[n].parent) {
+    int32_t p = nodes[n].parent;
+    if (p >= 0) lengthM += graph.distance(nodes[p].lat, nodes[p].lon, nodes[n].lat, nodes[n].lon);
+    pathCount++;
+  }
+  
+  // Keep every step-th vertex (counted from the goal) when the path is longer
+  // than the buffer; the start vertex is always kept
+  uint32_t step = (pathCount + ROUTE_MAX_POINTS - 2) / (ROUTE_MAX_POINTS - 1);
+  if (step < 1) step = 1;
+  uint32_t kept = (pathCount - 1) / step + 1;
+  if ((pathCount - 1) % step != 0) kept++;
+  
+  // Connectors from the requested positions to the snapped nodes
+  uint16_t total = (uint16_t)(kept + 2);
+  _route.lat[0] = fromLatMicro;
+  _route.lon[0] = fromLonMicro;
+  _route.lat[total - 1] = toLatMicro;
+  _route.lon[total - 1] = toLonMicro;
+  
+  uint32_t out = kept;  // Fill slots [1..kept] backwards, goal last
+  uint32_t idx = 0;
+  for (int32_t n = goal; n >= 0; n = nodes[n].parent, idx++) {
+    bool isStart = (nodes[n].parent < 0);
+    if (idx % step != 0 && !isStart) continue;
+    _route.lat[out] = nodes[n].lat;
+    _route.lon[out] = nodes[n].lon;
+    out--;
+  }
+  
+  _route.pointCount = total;
+  _route.lengthM = lengthM +
+                   graph.distance(fromLatMicro, fromLonMicro, nodes[start].lat, nodes[start].lon) +
+                   graph.distance(goalLat, goalLon, toLatMicro, toLonMicro);
+  _route.costM = nodes[goal].g;
+  _route.computeMs = elapsed;
+  _route.nodesExpanded = expanded;
+  _route.tilesLoaded = graph.tilesLoaded;
+  _route.valid = true;
+  return ROUTE_OK;
+}
+
+void MapRouter::renderRoute(MapRenderer* renderer, int32_t centerLatMicro, int32_t centerLonMicro,
+                            int32_t scaleX, int32_t scaleY, float rotation) {
+  if (!renderer || !_route.valid || _route.pointCount < 2) return;
+  
+  const int viewWidth = renderer->getWidth();
+  const int viewHeight = renderer->getHeight();
+  const int16_t cx = viewWidth / 2;
+  const int16_t cy = viewHeight / 2;
+  const float invScaleX = 1.0f / (float)scaleX;
+  const float invScaleY = 1.0f / (float)scaleY;
+  const bool hasRotation = (rotation != 0.0f);
+  float cosR = 1.0f, sinR = 0.0f;
+  if (hasRotation) {
+    float rad = rotation * (float)PI / 180.0f;
+    cosR = cosf(rad);
+    sinR = sinf(rad);
+  }
+  
+  MapFeatureStyle style = {LINE_SOLID, 3, 20, true, 0xF800};
+  int16_t prevX = 0, prevY = 0;
+  for (uint16_t i = 0; i < _route.pointCount; i++) {
+    float fx = (float)(_route.lon[i] - centerLonMicro) * invScaleX;
+    float fy = -(float)(_route.lat[i] - centerLatMicro) * invScaleY;
+    if (hasRotation) { float rx = fx*cosR - fy*sinR; fy = fx*sinR + fy*cosR; fx = rx; }
+    int16_t curX = cx + (int16_t)fx;
+    int16_t curY = cy + (int16_t)fy;
+    
+    if (i > 0) {
+      bool visible = (prevX >= -50 && prevX < viewWidth + 50 &&
+                      prevY >= -50 && prevY < viewHeight + 50) ||
+                     (curX >= -50 && curX < viewWidth + 50 &&
+                      curY >= -50 && curY < viewHeight + 50);
+      if (visible) renderer->drawLine(prevX, prevY, curX, curY, style);
+    }
+    prevX = curX;
+    prevY = curY;
+  }
+}
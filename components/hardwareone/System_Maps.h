@@ -7,13 +7,13 @@
 #include "System_BuildConfig.h"
 
 // =============================================================================
-// HardwareOne Map (.hwmap) File Format - VERSION 6 (TILED + SUBTYPES)
+// HardwareOne Map (.hwmap) File Format - VERSION 6/7 (TILED + SUBTYPES)
 // =============================================================================
 // Binary format for compact offline maps on ESP32
 //
 // Header (40 bytes):
 //   Magic: "HWMP" (4 bytes)
-//   Version: uint16 = 6 (2 bytes)
+//   Version: uint16 = 6 or 7 (2 bytes; only the tile payload encoding differs)
 //   Flags: uint16 (encodes tiling params):
 //     bits 0-1:  tileGridCode (0=16, 1=32, 2=64)
 //     bits 2-6:  haloPct (0-31, representing %)
@@ -42,6 +42,33 @@
 //     PointCount: uint16
 //     Points: PointCount * (qLat: uint16, qLon: uint16)
 //       Quantized to tile+halo local coords, decode with qMax=(1<<quantBits)-1
+//
+// Tile Payload, v7 (compact: varints are unsigned LEB128, zigzag for deltas):
+//   uint16 featureCount
+//   uint8  tileFlags (bit 0: header dictionary present)
+//   Dictionary (if flagged): varint entryCount,
+//     entryCount * (type uint8, subtype uint8, nameIndex uint16)
+//   Per feature:
+//     Header: varint dictionary index, or type/subtype/nameIndex inline (4 bytes)
+//     varint PointCount
+//     varint PointBytes (size of the point stream, so skipping is O(1))
+//     First point: varint qLat, varint qLon
+//     Other points: zigzag varint dLat, dLon from the previous point (mod 2^16)
+//
+// Extension Sections (optional, appended after the last tile payload):
+//   Everything above is reached through fixed offsets and the tile directory,
+//   so firmware that predates a section never reads it.
+//   Trailer (last 12 bytes of the file):
+//     Magic: "HWXS" (4 bytes)
+//     DirOffset: uint32 (absolute file offset of the section directory)
+//     SectionCount: uint32
+//   Section directory (12 bytes per section): Tag char[4], Offset uint32, Size uint32
+//
+// "FBOX" section - per-feature bounding boxes for viewport culling:
+//   TypeMask: uint16[tileCount] (HWMAP_FTYPE_* bits present in each tile)
+//   RecordOffset: uint32[tileCount] (relative to section start, 0xFFFFFFFF = none)
+//   Record: uint16 featureCount, then per feature in payload order
+//           qMinLat, qMinLon, qMaxLat, qMaxLon (uint16, same quantization as points)
 
 // =============================================================================
 // Feature Types (must match web tool)
@@ -203,15 +230,126 @@ struct HWMapFeatureHeader {
 // Feature header size (always 6 bytes for v6)
 #define HWMAP_FEATURE_HEADER_SIZE 6
 
+// v7 tile flags
+#define HWMAP_TILE_HAS_DICT  0x01
+
 // Marker for unnamed features
 #define HWMAP_NO_NAME 0xFFFF
 
-// Maximum names to load (memory limit)
-#define MAX_MAP_NAMES 512
+// Maximum names to load. Names live in one packed PSRAM pool (~length + 7 bytes
+// each), so this is bounded by the uint16 name index rather than RAM.
+#define MAX_MAP_NAMES 16384
+
+// Longest name kept (longer names are truncated, matching the 64-byte UI buffers)
+#define MAP_NAME_MAX_LEN 63
 
 // Maximum tiles (64x64 = 4096 max; tool generates 16/32/64 grids)
 #define HWMAP_MAX_TILES 4096
 
+// Extension section trailer/directory (see format description above)
+#define HWMAP_TRAILER_MAGIC   "HWXS"
+#define HWMAP_TRAILER_SIZE    12
+#define HWMAP_MAX_SECTIONS    16
+#define HWMAP_SECTION_FBOX    "FBOX"
+#define HWMAP_FBOX_NO_RECORD  0xFFFFFFFF
+
+// Tile type mask bit for types outside HWMAP_FTYPE_* (always treated as visible)
+#define HWMAP_FTYPE_OTHER     (1 << 15)
+
+struct HWMapSectionEntry {
+  char tag[4];
+  uint32_t offset;         // Absolute file offset of the section
+  uint32_t size;           // Section size in bytes
+} __attribute__((packed));
+
+// Feature bounding box in tile-local quantized coords ("FBOX" record entry)
+struct HWMapFeatureBox {
+  uint16_t qMinLat;
+  uint16_t qMinLon;
+  uint16_t qMaxLat;
+  uint16_t qMaxLon;
+} __attribute__((packed));
+
+// =============================================================================
+// Tile Payload Reader (v6 fixed pairs and v7 varint deltas)
+// =============================================================================
+
+// Feature header as decoded from a tile payload
+struct MapFeatureInfo {
+  uint8_t type;
+  uint8_t subtype;
+  uint16_t nameIndex;
+  uint16_t pointCount;
+  uint32_t offset;         // Payload offset of the feature record (for seek())
+};
+
+// Walks the features of one tile payload. Points of the current feature are
+// read with point(); next() skips whatever was not read.
+class MapTileReader {
+public:
+  MapTileReader(const uint8_t* data, size_t size, uint16_t version);
+  
+  uint16_t featureCount() const { return _featureCount; }
+  
+  // Advance to the next feature record. False at the end or on truncation.
+  bool next(MapFeatureInfo& info);
+  
+  // Position on the feature record at a payload offset (from the feature index)
+  bool seek(uint32_t offset, MapFeatureInfo& info);
+  
+  // Next quantized point of the current feature. False when exhausted.
+  inline bool point(uint16_t& qLat, uint16_t& qLon) {
+    if (_pointsLeft == 0) return false;
+    if (!_compact) {
+      if (_ptr + 4 > _pointsEnd) return false;
+      qLat = _ptr[0] | (_ptr[1] << 8);
+      qLon = _ptr[2] | (_ptr[3] << 8);
+      _ptr += 4;
+    } else {
+      uint32_t a, b;
+      if (!readVarint(a) || !readVarint(b)) return false;
+      if (_firstPoint) {
+        _qLat = (uint16_t)a;
+        _qLon = (uint16_t)b;
+        _firstPoint = false;
+      } else {
+        _qLat = (uint16_t)(_qLat + (int32_t)((a >> 1) ^ (0u - (a & 1))));
+        _qLon = (uint16_t)(_qLon + (int32_t)((b >> 1) ^ (0u - (b & 1))));
+      }
+      qLat = _qLat;
+      qLon = _qLon;
+    }
+    _pointsLeft--;
+    return true;
+  }
+  
+private:
+  inline bool readVarint(uint32_t& v) {
+    v = 0;
+    for (uint8_t shift = 0; shift < 32 && _ptr < _pointsEnd; shift += 7) {
+      uint8_t b = *_ptr++;
+      v |= (uint32_t)(b & 0x7F) << shift;
+      if (!(b & 0x80)) return true;
+    }
+    return false;
+  }
+  bool readHeader(const uint8_t* rec, MapFeatureInfo& info);
+  
+  const uint8_t* _data;
+  const uint8_t* _end;
+  const uint8_t* _ptr;          // Cursor inside the current point stream
+  const uint8_t* _pointsEnd;    // End of the current point stream
+  const uint8_t* _nextRecord;   // Start of the next feature record
+  const uint8_t* _dict;         // v7 header dictionary (4 bytes per entry)
+  uint16_t _dictCount;
+  uint16_t _featureCount;
+  uint16_t _featuresRead;
+  uint16_t _pointsLeft;
+  uint16_t _qLat, _qLon;        // v7 delta accumulator
+  bool _compact;
+  bool _firstPoint;
+};
+
 // =============================================================================
 // Map Feature Highlighting System (generic, can highlight any feature)
 // =============================================================================
@@ -221,7 +359,8 @@ enum MapHighlightMode : uint8_t {
   HIGHLIGHT_NONE = 0,        // No highlighting active
   HIGHLIGHT_BY_NAME,         // Match features by name (exact or prefix)
   HIGHLIGHT_BY_TYPE,         // Match all features of a type
-  HIGHLIGHT_BY_NAME_AND_TYPE // Match name AND type
+  HIGHLIGHT_BY_NAME_AND_TYPE, // Match name AND type
+  HIGHLIGHT_ROUTE            // Draw the computed route (MapRouter), no feature match
 };
 
 // Highlight configuration
@@ -243,6 +382,7 @@ void mapHighlightClear();
 void mapHighlightByName(const char* name, bool prefixMatch = false, uint32_t blinkMs = 300);
 void mapHighlightByType(uint8_t featureType, uint32_t blinkMs = 300);
 void mapHighlightByNameAndType(const char* name, uint8_t featureType, uint32_t blinkMs = 300);
+void mapHighlightRoute(uint32_t blinkMs = 0);
 bool mapHighlightMatches(uint16_t nameIndex, uint8_t featureType);
 bool mapHighlightIsVisible();  // Returns false during "off" phase of blink
 
@@ -275,9 +415,10 @@ void    mapSubtypeToggle(uint8_t featureType, uint8_t subtype);
 uint8_t mapSubtypeGetMask(uint8_t featureType);
 void    mapSubtypeSetMask(uint8_t featureType, uint8_t mask);
 
-// Name entry (parsed from name table)
-struct MapNameEntry {
-  char name[64];  // Truncated if longer than 63
+// Name -> feature back-reference (built on first lookup by name)
+struct MapNameRef {
+  uint16_t tileIdx;        // Tile containing the feature
+  uint32_t offset;         // Payload offset of the feature header
 };
 
 // Multi-slot tile cache configuration
@@ -285,11 +426,66 @@ struct MapNameEntry {
 #define MAP_CACHE_MAX_SLOTS  256                  // Max tracked slots
 #define MAP_CACHE_MIN_SLOT   4096                 // Minimum 4KB per slot
 
+// Feature index entry, built per cached tile so the renderer can reject
+// features by bounding box without walking their point arrays
+struct TileFeatureRef {
+  uint32_t offset;         // Payload offset of the feature header
+  HWMapFeatureBox box;     // Tile-local quantized bounds
+};
+
+// Simplified geometry levels (Douglas-Peucker), built per cached tile the first
+// time it is drawn zoomed out. Level k keeps vertices within
+// MAP_LOD_BASE_TOLERANCE * 4^(k-1) quantized units of the full line; level 0 is
+// the full geometry. renderMap picks the coarsest level whose error stays
+// under MAP_LOD_MAX_ERROR_PX on screen.
+#define MAP_LOD_LEVELS          3
+#define MAP_LOD_BASE_TOLERANCE  128
+#define MAP_LOD_MAX_ERROR_PX    1.0f
+
+struct TileLodSpan {
+  uint32_t start;          // First point in TileLod::points (pairs)
+  uint16_t count;          // Points kept at this level
+};
+
+struct TileLod {
+  TileLodSpan* spans;      // [featureCount * MAP_LOD_LEVELS], level-major per feature
+  uint16_t* points;        // qLat, qLon pairs for all levels
+  uint32_t pointCount;
+};
+
+// Road/area segments of a tile bucketed into a SEG_GRID_DIM^2 grid over its
+// quantized halo space, for nearest-feature queries (LocationContextManager).
+// A segment is copied into every cell its bounding box touches.
+#define SEG_GRID_DIM    8
+#define SEG_GRID_SHIFT  13    // 65536 / SEG_GRID_DIM = 1 << 13
+#define SEG_GRID_SCAN_ALL 64  // Tiles with this many segment entries or fewer skip the cell ordering
+
+struct TileSegment {
+  uint16_t feature;        // Index into TileSegmentGrid::features
+  uint16_t qLat1, qLon1, qLat2, qLon2;
+};
+
+struct TileSegFeature {
+  uint16_t nameIndex;
+  uint8_t  type;
+};
+
+struct TileSegmentGrid {
+  uint32_t cellStart[SEG_GRID_DIM * SEG_GRID_DIM + 1];  // CSR offsets into segments
+  TileSegment* segments;
+  TileSegFeature* features;
+  uint16_t featureCount;
+};
+
 // Per-slot cache entry
 struct TileCacheSlot {
   int16_t  tileIdx;        // Which tile is cached here (-1 = empty)
   uint32_t dataSize;       // Actual tile payload bytes stored
   uint32_t lastAccessSeq;  // Monotonic counter for LRU eviction
+  TileFeatureRef* features;  // Lazily built feature index (nullptr = not built)
+  uint16_t featureRefCount;
+  TileLod* lod;            // Lazily built simplified levels (nullptr = not built)
+  TileSegmentGrid* segGrid;  // Lazily built road/area segment grid (nullptr = not built)
 };
 
 // Loaded map state - v6 tiled architecture
@@ -300,10 +496,18 @@ struct LoadedMap {
   char filepath[128];       // Full path for reopening file
   size_t fileSize;         // Total file size
   
-  // Name table (always in RAM - typically small)
-  MapNameEntry* names;     // Array of names
+  // Name table (always in RAM)
+  char* namePool;          // Names in file order, NUL-terminated, packed
+  uint32_t* nameOffsets;   // [nameCount] offset of each name in namePool
+  uint16_t* nameSorted;    // [nameCount] name indices, case-folded sort order
   uint16_t nameCount;      // Number of names loaded
   
+  // Name -> feature back-references, CSR layout: features named i are
+  // nameRefs[nameRefStart[i] .. nameRefStart[i + 1])
+  uint32_t* nameRefStart;  // [nameCount + 1], nullptr until first lookup
+  MapNameRef* nameRefs;
+  uint32_t nameRefCount;
+  
   // Tiling parameters (extracted from header.flags)
   uint8_t tileGridSize;    // e.g., 4 = 4x4 = 16 tiles
   float haloPct;           // Halo fraction (e.g., 0.10)
@@ -312,6 +516,11 @@ struct LoadedMap {
   // Tile directory (always in RAM - small: 6 bytes per tile)
   HWMapTileDirEntry* tileDir;  // Array of tile offsets/counts
   uint16_t tileCount;      // tileGridSize * tileGridSize
+  uint16_t* tileTypeMask;  // HWMAP_FTYPE_* bits per tile (0xFFFF = not known yet)
+  
+  // Optional extension sections (directory only; sections are read on demand)
+  HWMapSectionEntry* sections;
+  uint8_t sectionCount;
   
   // Precomputed tile geometry (for fast dequantization)
   int32_t tileW;           // Tile width in microdegrees
@@ -331,6 +540,20 @@ struct LoadedMap {
   TileCacheSlot* slots;     // Array of slot metadata [numSlots]
   uint32_t cacheHits;       // Debug: total cache hits since load
   uint32_t cacheMisses;     // Debug: total cache misses since load
+  uint32_t bytesRead;       // Debug: tile payload bytes read from storage since load
+};
+
+// Counters for one renderMap() call
+struct MapRenderStats {
+  uint32_t frameUs;         // Whole call, including waypoints and markers
+  uint32_t tileIOUs;        // Time inside loadTileData
+  uint32_t cacheHits;       // Tile cache hits/misses during the frame
+  uint32_t cacheMisses;
+  uint32_t bytesRead;       // Payload bytes read from storage (misses)
+  uint32_t bytesDecoded;    // Payload bytes of the tiles walked by the decoder
+  uint32_t features;
+  uint32_t linesDrawn;
+  uint16_t tilesLoaded;
 };
 
 // =============================================================================
@@ -342,6 +565,7 @@ struct MapRenderParams {
   float rotation;
   uint16_t visibleLayers;
   uint8_t subtypeVisibility[65];  // Snapshot of per-subtype masks
+  bool liveOverlays;              // Route, waypoints, position marker and highlight blinking
 };
 
 // Build a MapRenderParams from current global state
@@ -351,6 +575,10 @@ MapRenderParams mapRenderParamsFromGlobals();
 // Abstract Map Renderer Interface
 // =============================================================================
 
+// Transform, cull window and tile range for one feature pass (System_MapCore.cpp)
+struct MapLayerView;
+struct MapLayerCounts;
+
 class MapRenderer {
 public:
   virtual ~MapRenderer() {}
@@ -412,8 +640,30 @@ public:
   static int getAvailableMaps(char maps[][96], int maxMaps);
   
   // Render map with explicit parameters (thread-safe — no global reads during render)
+  // Fills *stats when given (per call, so concurrent renders don't mix counters)
   static void renderMap(MapRenderer* renderer, float centerLat, float centerLon,
-                        const MapRenderParams& params);
+                        const MapRenderParams& params, MapRenderStats* stats = nullptr);
+  
+  // Map features only, in world pixels: renderer pixel (x, y) is world pixel
+  // (originX + x, originY + y), where world x = floor(lonMicro / scaleX) and
+  // world y = floor(-latMicro / scaleY) at the zoom's scale. Only pixels inside
+  // [clipX0, clipX1) x [clipY0, clipY1) are drawn, and what lands there does not
+  // depend on the clip rect, so a canvas can be scrolled by whole pixels and only
+  // the exposed strips redrawn (see MapCanvas). No rotation, overlays or stats.
+  // Returns false if the tiles under the rect would not fit the tile cache.
+  static bool renderMapLayer(MapRenderer* renderer, int32_t originX, int32_t originY,
+                             int16_t clipX0, int16_t clipY0, int16_t clipX1, int16_t clipY1,
+                             const MapRenderParams& params);
+  
+  // What renderMap draws over the features: route, waypoints, position marker
+  static void renderMapOverlays(MapRenderer* renderer, float centerLat, float centerLon,
+                                const MapRenderParams& params);
+  
+  // Microdegrees per pixel at a zoom level
+  static void scaleForZoom(float zoom, int32_t& scaleX, int32_t& scaleY);
+  
+  // Bumped on every map load/unload (lets caches of rendered pixels notice)
+  static uint32_t getMapGeneration() { return _mapGeneration; }
   
   // Get current map info
   static const LoadedMap& getCurrentMap() { return _currentMap; }
@@ -422,9 +672,19 @@ public:
   // Name table access
   static const char* getName(uint16_t index);
   
-  // Search names by prefix (case-insensitive) - for autocomplete
+  // Search names by prefix (case-insensitive) - for autocomplete.
+  // Results come back in case-folded alphabetical order.
   static int searchNamesByPrefix(const char* prefix, const char** results, int maxResults);
   
+  // Sorted name index: names matching prefix occupy sorted positions
+  // [*outFirst, *outFirst + return value). Empty prefix matches every name.
+  static uint32_t findNamePrefixRange(const char* prefix, uint32_t* outFirst);
+  static uint16_t getSortedNameIndex(uint32_t sortedPos);
+  
+  // Features carrying a name (tile + payload offset). Builds the back-reference
+  // table on first use, which reads every tile once.
+  static int findFeaturesByName(uint16_t nameIndex, MapNameRef* results, int maxResults);
+  
   // Convert geo coordinates to screen coordinates (public for waypoint rendering)
   static void geoToScreen(int32_t lat, int32_t lon,
                           int32_t centerLat, int32_t centerLon,
@@ -432,11 +692,44 @@ public:
                           int viewWidth, int viewHeight,
                           int16_t& screenX, int16_t& screenY);
   
-  // Streaming helpers - load tile data from cache or file
+  // Streaming helpers - load tile data from cache or file. Hold MapCacheGuard
+  // while using the result or any index below: a miss in another task can
+  // evict the slot and free them.
   static const uint8_t* loadTileData(uint16_t tileIdx, size_t* outSize = nullptr);
   
+  // Raw bytes of the loaded map file via the persistent handle (does not touch
+  // the tile cache, so it is safe alongside rendering). Returns bytes read.
+  static size_t readMapFile(uint32_t offset, uint8_t* buf, size_t len);
+  
+  // Feature index for a tile returned by loadTileData (built on first use from
+  // the FBOX section, or by scanning the payload). nullptr if unavailable.
+  static const TileFeatureRef* getTileFeatureRefs(uint16_t tileIdx, const uint8_t* tileData,
+                                                  size_t tileDataSize, uint16_t* outCount);
+  
+  // Simplified geometry for a tile returned by loadTileData (built on first use;
+  // indexed by the feature's position in getTileFeatureRefs). nullptr if unavailable.
+  static const TileLod* getTileLod(uint16_t tileIdx, const uint8_t* tileData, size_t tileDataSize);
+  
+  // Road/area segment grid for a tile returned by loadTileData (built on first use)
+  static const TileSegmentGrid* getTileSegmentGrid(uint16_t tileIdx, const uint8_t* tileData, size_t tileDataSize);
+  
+  // Extension section lookup by 4-char tag (nullptr if the map has none)
+  static const HWMapSectionEntry* findSection(const char* tag);
+  
 private:
   static LoadedMap _currentMap;
+  static uint32_t _mapGeneration;
+  
+  static bool renderFeatures(MapRenderer* renderer, const MapRenderParams& params,
+                             const MapLayerView& view, MapLayerCounts& counts);
+  
+  static void loadSectionDirectory(File& f, size_t fileSize);
+  static void loadTileTypeMasks(File& f);
+  static bool readTileFeatureBoxes(uint16_t tileIdx, TileFeatureRef* refs, uint16_t count);
+  static void freeSlotIndex(TileCacheSlot& slot);
+  static TileCacheSlot* slotForTileData(uint16_t tileIdx, const uint8_t* tileData);
+  static bool loadNameTable(File& f, size_t nameTableEnd);
+  static bool buildNameRefs();
 };
 
 // =============================================================================
@@ -480,15 +773,77 @@ public:
 private:
   static LocationContext _context;
   
-  // Calculate distance from point to line segment (returns meters)
-  static float pointToSegmentDistance(float lat, float lon,
-                                      int32_t lat1, int32_t lon1,
-                                      int32_t lat2, int32_t lon2);
+  // Squared local equirectangular distance (microdegrees, longitude scaled by
+  // cosLatQ16) from a point to segment 1-2; also returns the closest point
+  static float segmentDistance2(int32_t lat, int32_t lon, int32_t cosLatQ16,
+                                int32_t lat1, int32_t lon1, int32_t lat2, int32_t lon2,
+                                int32_t& closestLat, int32_t& closestLon);
   
   // Haversine distance between two points (meters)
   static float haversineDistance(float lat1, float lon1, float lat2, float lon2);
 };
 
+// =============================================================================
+// Offline Routing
+// =============================================================================
+// The road graph comes from the road features of each tile, loaded only when
+// the search reaches that tile. Every vertex is a node and consecutive vertices
+// form a two-way edge. Vertices closer than one quantization step belong to
+// the same node, which joins roads that meet at shared vertices and stitches
+// copies of a road across tile halos. Edge cost is projected length times a
+// per-class weight, and the A* heuristic is straight-line length (weight 1.0),
+// so results match Dijkstra.
+
+#define ROUTE_MAX_NODES     24576
+#define ROUTE_MAX_EDGES     65536    // Directed; each road segment adds two
+#define ROUTE_MAX_OPEN      8192     // Open set (indexed binary heap) capacity
+#define ROUTE_HASH_BUCKETS  8192     // Node lookup buckets (power of two)
+#define ROUTE_MAX_POINTS    1024     // Stored route polyline (decimated beyond this)
+#define ROUTE_SNAP_MAX_M    300.0f   // Start/goal must be this close to a road node
+
+enum MapRouteResult : uint8_t {
+  ROUTE_OK = 0,
+  ROUTE_NO_MAP,
+  ROUTE_NO_ROAD_AT_START,
+  ROUTE_NO_ROAD_AT_GOAL,
+  ROUTE_NO_PATH,
+  ROUTE_OUT_OF_MEMORY,
+  ROUTE_LIMIT_REACHED        // Node/edge/open-set bounds exceeded
+};
+
+struct MapRoute {
+  int32_t* lat;              // Route polyline, microdegrees (PSRAM)
+  int32_t* lon;
+  uint16_t pointCount;
+  float lengthM;             // Path length
+  float costM;               // Class-weighted length A* minimized
+  uint32_t computeMs;
+  uint32_t nodesExpanded;
+  uint16_t tilesLoaded;
+  bool valid;
+};
+
+class MapRouter {
+public:
+  // Route between two positions over the loaded map's roads. On success the
+  // route replaces the previous one; call mapHighlightRoute() to show it.
+  static MapRouteResult computeRoute(float fromLat, float fromLon, float toLat, float toLon);
+  
+  static const MapRoute& getRoute() { return _route; }
+  static void clearRoute();
+  static const char* resultString(MapRouteResult result);
+  
+  // Cost multiplier for a road class (1.0 = highway); 0 = not routable
+  static float classWeight(uint8_t featureType);
+  
+  // Draw the route polyline (called by renderMap while HIGHLIGHT_ROUTE is visible)
+  static void renderRoute(MapRenderer* renderer, int32_t centerLatMicro, int32_t centerLonMicro,
+                          int32_t scaleX, int32_t scaleY, float rotation);
+  
+private:
+  static MapRoute _route;
+};
+
 // =============================================================================
 // Concrete Renderer Implementations
 // =============================================================================
@@ -528,6 +883,81 @@ private:
   void drawDottedLine(int16_t x0, int16_t y0, int16_t x1, int16_t y1, int spacing);
 };
 
+// =============================================================================
+// Map Canvas (features cached in world pixels, reused while panning)
+// =============================================================================
+
+// Extra pixels kept on each side of the viewport; pans within it only move the window
+#define MAP_CANVAS_MARGIN 16
+
+// Canvas pixels drawn through a clip rect. Lines are stepped whole and masked
+// per pixel, so a strip comes out exactly as in a full-canvas pass.
+class MapCanvasRenderer : public OffscreenMapRenderer {
+public:
+  // buffer: width x height page layout (height a multiple of 8, stride = width)
+  MapCanvasRenderer(uint8_t* buffer, int width, int height);
+  
+  void setClip(int16_t x0, int16_t y0, int16_t x1, int16_t y1);
+  void clear() override;  // Clip rect only
+  void drawLine(int16_t x0, int16_t y0, int16_t x1, int16_t y1,
+                const MapFeatureStyle& style) override;
+  void drawPositionMarker(int16_t x, int16_t y) override {}
+  
+private:
+  uint8_t* _canvas;
+  int16_t _clipX0, _clipY0, _clipX1, _clipY1;
+  
+  inline void plot(int32_t x, int32_t y) {
+    if (x >= _clipX0 && x < _clipX1 && y >= _clipY0 && y < _clipY1)
+      _canvas[x + (y >> 3) * _width] |= (1 << (y & 7));
+  }
+};
+
+// Map features for a viewport plus MAP_CANVAS_MARGIN, anchored to the world
+// pixel grid. update() moves the window for pans inside the margin, scrolls
+// the canvas and renders only the exposed strips for larger ones, and redraws
+// in full on zoom, layer or map changes. Rotated views, blinking feature
+// highlights and views needing more tiles than the cache holds are refused;
+// callers then fall back to renderMap(). Not thread-safe: one owner task.
+class MapCanvas {
+public:
+  bool begin(int viewWidth, int viewHeight);
+  void end();
+  void invalidate() { _valid = false; }
+  
+  // Bring the canvas up to date for a view centred on (centerLat, centerLon)
+  bool update(float centerLat, float centerLon, const MapRenderParams& params);
+  
+  // OR the viewport window into a 128-wide page-layout frame starting at row offsetY
+  void blit(uint8_t* frame, int offsetY) const;
+  
+  // Centre the window was snapped to (overlays must use it to line up)
+  float snappedLat() const { return _snapLatMicro / 1000000.0f; }
+  float snappedLon() const { return _snapLonMicro / 1000000.0f; }
+  
+  // Pixels rendered by the last update() (0 when the window just moved)
+  uint32_t lastRenderedPx() const { return _lastRenderedPx; }
+  
+  // Canvas as a full redraw would leave it, for identity checks
+  const uint8_t* pixels() const { return _front; }
+  size_t pixelBytes() const { return (size_t)_w * (_h / 8); }
+  
+private:
+  uint8_t* _front = nullptr;
+  uint8_t* _back = nullptr;
+  int _viewW = 0, _viewH = 0, _w = 0, _h = 0;
+  int32_t _originX = 0, _originY = 0;  // World pixel of canvas (0, 0)
+  int32_t _viewX = 0, _viewY = 0;      // World pixel of the viewport's top-left
+  int32_t _snapLatMicro = 0, _snapLonMicro = 0;
+  uint32_t _mapGeneration = 0;
+  uint32_t _lastRenderedPx = 0;
+  MapRenderParams _params = {};
+  bool _valid = false;
+  
+  bool renderRect(int16_t x0, int16_t y0, int16_t x1, int16_t y1);
+  void scrollInto(int32_t dx, int32_t dy);
+};
+
 #if ENABLE_OLED_DISPLAY
 class Adafruit_SSD1306;
 
@@ -567,7 +997,58 @@ private:
 // GPS Track System
 // =============================================================================
 
-#define MAX_TRACK_POINTS 500  // Memory limit for track points
+#define MAX_TRACK_POINTS 500  // Memory limit for in-RAM (live) track points
+
+// Binary track file (.hwtrk) - written by GPSTrackManager::importCSV()
+//
+// Header (64 bytes): GPSTrackFileHeader
+// Chunk payloads, followed by the chunk index (GPSTrackChunkEntry[chunkCount])
+// at header.indexOffset. Each chunk payload holds:
+//   First point: int32 lat, int32 lon (microdegrees), uint32 timeMs
+//   Other points: zigzag varint dLat, zigzag varint dLon, varint dtMs
+// Every chunk after the first starts with the previous chunk's last point, so a
+// chunk can be drawn on its own. That point is not counted again in pointCount.
+// Loading reads only the header and index; points are decoded per chunk.
+#define GPS_TRACK_MAGIC         "HWTK"
+#define GPS_TRACK_VERSION       1
+#define GPS_TRACK_EXT           ".hwtrk"
+#define GPS_TRACK_CHUNK_POINTS  256    // New points per chunk
+#define GPS_TRACK_CHUNK_MAX     (GPS_TRACK_CHUNK_POINTS + 1)  // Decoded points incl. overlap
+#define GPS_TRACK_CHUNK_BYTES   (12 + GPS_TRACK_CHUNK_POINTS * 15)  // Worst-case payload
+
+struct GPSTrackFileHeader {
+  char magic[4];            // "HWTK"
+  uint16_t version;
+  uint16_t chunkPoints;     // GPS_TRACK_CHUNK_POINTS at write time
+  uint32_t pointCount;
+  uint32_t chunkCount;
+  uint32_t indexOffset;
+  int32_t minLat, minLon, maxLat, maxLon;      // Microdegrees
+  int32_t startLat, startLon, endLat, endLon;
+  float distanceM;          // Point-to-point length
+  uint32_t durationMs;      // 0 = no timestamps in the source
+  uint32_t sourceSize;      // Size of the CSV this was imported from (cache check)
+} __attribute__((packed));
+
+struct GPSTrackChunkEntry {
+  uint32_t offset;          // Payload offset in the file
+  uint16_t size;            // Payload bytes
+  uint16_t pointCount;      // Points in the payload, including the overlap point
+  int32_t minLat, minLon, maxLat, maxLon;      // Includes the overlap point
+} __attribute__((packed));
+
+// Decoded point of a binary track chunk
+struct GPSTrackFixedPoint {
+  int32_t lat, lon;         // Microdegrees
+  uint32_t timeMs;
+};
+
+// Chunk payload codec. encodeTrackChunk() writes at most GPS_TRACK_CHUNK_BYTES
+// for GPS_TRACK_CHUNK_POINTS points and returns the size; decodeTrackChunk()
+// returns the point count, or -1 if the payload is malformed or holds more
+// than maxPoints points.
+size_t encodeTrackChunk(const GPSTrackFixedPoint* pts, int count, uint8_t* out);
+int decodeTrackChunk(const uint8_t* data, size_t size, GPSTrackFixedPoint* out, int maxPoints);
 
 struct GPSTrackPoint {
   float lat;
@@ -608,12 +1089,18 @@ public:
   // Clear current track
   static void clearTrack();
   
+  // Convert a track CSV/sensor log into a binary track file (streamed, no point limit)
+  static bool importCSV(const char* csvPath, const char* outPath, String& errorMsg);
+  
   // Check if track is loaded
   static bool hasTrack() { return _pointCount > 0; }
   
   // Get track info
   static int getPointCount() { return _pointCount; }
-  static const GPSTrackPoint* getPoints() { return _points; }
+  // In-RAM points (live/legacy tracks only; nullptr for a binary track)
+  static const GPSTrackPoint* getPoints() { return _binary ? nullptr : _points; }
+  // Copy points [first, first + maxPoints) of either kind of track; returns count
+  static int readPoints(uint32_t first, GPSTrackPoint* out, int maxPoints);
   static const GPSTrackBounds& getBounds() { return _bounds; }
   static const GPSTrackStats& getStats() { return _stats; }
   static const char* getFilename() { return _filename; }
@@ -644,6 +1131,20 @@ public:
 private:
   static GPSTrackPoint* _points;
   static int _pointCount;
+  
+  // Binary track state (header + chunk index only; points stay in the file)
+  static bool _binary;
+  static File _trackFile;
+  static char _trackPath[96];
+  static GPSTrackFileHeader _header;
+  static GPSTrackChunkEntry* _chunks;
+  static uint32_t* _chunkFirst;      // Index of each chunk's first new point
+  
+  static bool openBinaryTrack(const char* path, String& errorMsg);
+  static int readChunk(uint32_t chunkIdx, GPSTrackFixedPoint* out);
+  static void drawTrackPoints(MapRenderer* renderer, const GPSTrackFixedPoint* pts, int count,
+                              int32_t centerLatMicro, int32_t centerLonMicro,
+                              int32_t scaleX, int32_t scaleY, const MapFeatureStyle& style);
   static GPSTrackBounds _bounds;
   static GPSTrackStats _stats;
   static char _filename[64];
@@ -660,7 +1161,7 @@ private:
   static float haversineDistance(float lat1, float lon1, float lat2, float lon2);
   
   // Parse GPS coordinates from log line
-  static bool parseGPSLine(const char* line, float& lat, float& lon);
+  static bool parseGPSLine(const char* line, double& lat, double& lon);
 };
 
 // =============================================================================
@@ -9,7 +9,6 @@
 #if ENABLE_MICROPHONE_SENSOR
 
 #include <Arduino.h>
-#include <driver/i2s_pdm.h>
 #include <LittleFS.h>
 #include "System_MemUtil.h"
 #include "System_Debug.h"
@@ -17,13 +16,13 @@
 #include "System_Mutex.h"
 #include "System_Settings.h"
 #include "System_Microphone_OLED.h"
+#include "System_AudioCapture.h"
+#include "System_AudioAnalysis.h"
 
-// XIAO ESP32S3 Sense PDM Microphone Pins
-#define MIC_PDM_CLK_PIN     42        // PDM CLK (GPIO42 on XIAO Sense)
-#define MIC_PDM_DATA_PIN    41        // PDM DATA (GPIO41 on XIAO Sense)
-
-// I2S PDM RX channel handle (new driver)
-static i2s_chan_handle_t rx_handle = NULL;
+// Capture consumer used for level metering while the mic is open; recording,
+// the visualizer and one-shot captures attach their own consumers.
+static AudioConsumerId gMicConsumer = AUDIO_CONSUMER_INVALID;
+static AudioConsumerId gMicRecConsumer = AUDIO_CONSUMER_INVALID;
 
 // Default audio settings
 #define DEFAULT_SAMPLE_RATE   16000
@@ -31,7 +30,6 @@ static i2s_chan_handle_t rx_handle = NULL;
 #define DEFAULT_CHANNELS      1
 
 // Buffer for audio capture
-#define AUDIO_BUFFER_SIZE     1024
 #define RECORDING_CHUNK_SIZE  4096
 #define RECORDINGS_FOLDER     "/recordings"
 #define MAX_RECORDING_SEC     60
@@ -61,20 +59,77 @@ static char gMicCmdBuffer[512];
 static int lastAudioLevel = 0;
 static uint32_t lastAudioLevelMs = 0;
 
-// Audio preprocessing state (shared between mic and ESP-SR)
-static int32_t gMicDcOffset = 0;
-static bool gMicDcOffsetInitialized = false;
 static float gMicBaseSoftwareGain = 24.0f;
 
-// High-pass filter state (~50Hz cutoff at 16kHz sample rate)
-// alpha = 1 / (1 + 2*pi*fc/fs) where fc=50Hz, fs=16000Hz
-static const float kHighPassAlpha = 0.9806f;
-static float gMicHighPassState = 0.0f;
-static int16_t gMicHighPassPrevIn = 0;
+// High-pass filter (~50Hz cutoff): y[n] = a * (y[n-1] + x[n] - x[n-1])
+// a = 1 / (1 + 2*pi*fc/fs), held in Q15. The output state keeps 8 extra
+// fractional bits so low-level signals do not truncate into a dead band.
+#define MIC_HPF_CUTOFF_HZ     50.0f
+#define MIC_HPF_STATE_SHIFT   8
+
+// Pre-emphasis filter (boosts high frequencies for speech clarity): y[n] = x[n] - c * x[n-1]
+#define MIC_PREEMPH_COEFF     0.97f
+
+// Per-stream filter state. Each capture consumer keeps its own so concurrent
+// streams (recording, metering, ESP-SR) do not corrupt each other's history.
+struct MicDspState {
+  int32_t dcOffset = 0;
+  bool dcInitialized = false;
+  int32_t hpStateQ8 = 0;
+  int16_t hpPrevIn = 0;
+  int16_t preEmphPrev = 0;
+};
+static MicDspState gMicSharedDsp;  // applyMicAudioProcessing() callers (ESP-SR)
+static MicDspState gMicLevelDsp;   // getAudioLevel()
+
+// Fixed-point coefficients, recomputed only when sample rate or gain changes.
+// Blocks are processed on several tasks (recording, level meter, ESP-SR), so
+// each takes a private snapshot and republishes under sMicDspMux.
+#define MIC_GAIN_SHIFT        8
+struct MicDspCoeffs {
+  int sampleRate = 0;
+  float gain = -1.0f;
+  int32_t hpAlphaQ15 = 0;
+  int32_t preEmphQ15 = 0;
+  int32_t gainQ8 = 0;
+  int32_t gainSatLimit = 0;  // |x| above this saturates after gain
+};
+static MicDspCoeffs gMicDsp;
+static portMUX_TYPE sMicDspMux = portMUX_INITIALIZER_UNLOCKED;
+
+static inline int16_t micSat16(int32_t v) {
+  if (v > 32767) return 32767;
+  if (v < -32768) return -32768;
+  return (int16_t)v;
+}
 
-// Pre-emphasis filter coefficient (boosts high frequencies for speech clarity)
-static const float kPreEmphCoeff = 0.97f;
-static int16_t gMicPreEmphPrevSample = 0;
+// Consistent coefficient set for one block (gain and its saturation limit
+// always belong together, even while another task is changing the gain)
+static MicDspCoeffs micDspCoeffs(float gainMultiplier) {
+  int fs = micSampleRate > 0 ? micSampleRate : DEFAULT_SAMPLE_RATE;
+  portENTER_CRITICAL(&sMicDspMux);
+  MicDspCoeffs c = gMicDsp;
+  portEXIT_CRITICAL(&sMicDspMux);
+  if (c.sampleRate == fs && c.gain == gainMultiplier) return c;
+
+  if (c.sampleRate != fs) {
+    float alpha = 1.0f / (1.0f + 2.0f * (float)M_PI * MIC_HPF_CUTOFF_HZ / (float)fs);
+    c.hpAlphaQ15 = (int32_t)(alpha * 32768.0f + 0.5f);
+    c.preEmphQ15 = (int32_t)(MIC_PREEMPH_COEFF * 32768.0f + 0.5f);
+    c.sampleRate = fs;
+  }
+  if (c.gain != gainMultiplier) {
+    int32_t g = (int32_t)(gainMultiplier * (1 << MIC_GAIN_SHIFT) + 0.5f);
+    if (g < 0) g = 0;
+    c.gainQ8 = g;
+    c.gainSatLimit = g > 0 ? (int32_t)((32767LL << MIC_GAIN_SHIFT) / g) : INT32_MAX;
+    c.gain = gainMultiplier;
+  }
+  portENTER_CRITICAL(&sMicDspMux);
+  gMicDsp = c;
+  portEXIT_CRITICAL(&sMicDspMux);
+  return c;
+}
 
 float getMicSoftwareGainMultiplier() {
   if (micGain <= 0) return 0.0f;
@@ -82,24 +137,21 @@ float getMicSoftwareGainMultiplier() {
 }
 
 int32_t getMicDcOffset() {
-  return gMicDcOffset;
+  return gMicSharedDsp.dcOffset;
 }
 
 void resetMicAudioProcessingState() {
-  gMicDcOffset = 0;
-  gMicDcOffsetInitialized = false;
-  gMicHighPassState = 0.0f;
-  gMicHighPassPrevIn = 0;
-  gMicPreEmphPrevSample = 0;
+  gMicSharedDsp = MicDspState();
 }
 
-void applyMicAudioProcessing(int16_t* buf, size_t sampleCount, float gainMultiplier, bool filtersEnabled) {
+static void processMicBlock(MicDspState& st, int16_t* buf, size_t sampleCount, float gainMultiplier, bool filtersEnabled) {
   if (!buf || sampleCount == 0) return;
 
   // Use provided gain or calculate from micGain setting
   if (gainMultiplier <= 0.0f) {
     gainMultiplier = getMicSoftwareGainMultiplier();
   }
+  const MicDspCoeffs coeffs = micDspCoeffs(gainMultiplier);
 
   // Calculate DC offset from this chunk (running average)
   int64_t sum = 0;
@@ -109,48 +161,65 @@ void applyMicAudioProcessing(int16_t* buf, size_t sampleCount, float gainMultipl
   int32_t chunkDc = (int32_t)(sum / (int64_t)sampleCount);
 
   // Slowly adapt DC offset estimate (EMA with alpha=0.1)
-  if (!gMicDcOffsetInitialized) {
-    gMicDcOffset = chunkDc;
-    gMicDcOffsetInitialized = true;
+  if (!st.dcInitialized) {
+    st.dcOffset = chunkDc;
+    st.dcInitialized = true;
   } else {
-    gMicDcOffset = gMicDcOffset + (chunkDc - gMicDcOffset) / 10;
+    st.dcOffset = st.dcOffset + (chunkDc - st.dcOffset) / 10;
   }
 
-  // Apply audio preprocessing pipeline:
+  // Apply audio preprocessing pipeline over the whole block in integer math:
   // 1. DC offset removal (always)
   // 2. High-pass filter (~50Hz cutoff) - optional
   // 3. Pre-emphasis filter (boost high frequencies) - optional
-  // 4. Software gain (always)
-  for (size_t i = 0; i < sampleCount; i++) {
-    // Step 1: Remove DC offset
-    float sample = (float)(buf[i] - gMicDcOffset);
-    
-    if (filtersEnabled) {
-      // Step 2: High-pass filter (removes low-freq rumble/hum)
-      // y[n] = alpha * (y[n-1] + x[n] - x[n-1])
-      float hpOut = kHighPassAlpha * (gMicHighPassState + sample - (float)gMicHighPassPrevIn);
-      gMicHighPassState = hpOut;
-      gMicHighPassPrevIn = (int16_t)sample;
-      sample = hpOut;
-      
-      // Step 3: Pre-emphasis filter (boosts high frequencies for speech clarity)
-      // y[n] = x[n] - alpha * x[n-1]
-      float preEmphOut = sample - kPreEmphCoeff * (float)gMicPreEmphPrevSample;
-      gMicPreEmphPrevSample = (int16_t)sample;
-      sample = preEmphOut;
+  // 4. Software gain with saturation (always)
+  const int32_t dc = st.dcOffset;
+  const int32_t gainQ8 = coeffs.gainQ8;
+  const int32_t satLimit = coeffs.gainSatLimit;
+
+  if (filtersEnabled) {
+    const int64_t hpAlpha = coeffs.hpAlphaQ15;
+    const int32_t preEmph = coeffs.preEmphQ15;
+    int32_t hpState = st.hpStateQ8;
+    int32_t hpPrevIn = st.hpPrevIn;
+    int32_t pePrev = st.preEmphPrev;
+
+    for (size_t i = 0; i < sampleCount; i++) {
+      int32_t x = micSat16((int32_t)buf[i] - dc);
+
+      // Step 2: high-pass (removes low-freq rumble/hum)
+      int32_t acc = hpState + ((x - hpPrevIn) << MIC_HPF_STATE_SHIFT);
+      hpState = (int32_t)((hpAlpha * acc) >> 15);
+      hpPrevIn = x;
+      int32_t hp = micSat16(hpState >> MIC_HPF_STATE_SHIFT);
+
+      // Step 3: pre-emphasis
+      int32_t s = hp - ((preEmph * pePrev) >> 15);
+      pePrev = hp;
+
+      // Step 4: gain + clamp
+      if (s > satLimit) buf[i] = 32767;
+      else if (s < -satLimit) buf[i] = -32768;
+      else buf[i] = micSat16((s * gainQ8) >> MIC_GAIN_SHIFT);
+    }
+
+    st.hpStateQ8 = hpState;
+    st.hpPrevIn = (int16_t)hpPrevIn;
+    st.preEmphPrev = (int16_t)pePrev;
+  } else {
+    for (size_t i = 0; i < sampleCount; i++) {
+      int32_t s = (int32_t)buf[i] - dc;
+      if (s > satLimit) buf[i] = 32767;
+      else if (s < -satLimit) buf[i] = -32768;
+      else buf[i] = micSat16((s * gainQ8) >> MIC_GAIN_SHIFT);
     }
-    
-    // Step 4: Apply software gain
-    sample *= gainMultiplier;
-    
-    // Clamp to 16-bit range
-    int32_t sampleInt = (int32_t)sample;
-    if (sampleInt > 32767) sampleInt = 32767;
-    if (sampleInt < -32768) sampleInt = -32768;
-    buf[i] = (int16_t)sampleInt;
   }
 }
 
+void applyMicAudioProcessing(int16_t* buf, size_t sampleCount, float gainMultiplier, bool filtersEnabled) {
+  processMicBlock(gMicSharedDsp, buf, sampleCount, gainMultiplier, filtersEnabled);
+}
+
 // WAV header structure
 struct WavHeader {
   char riff[4] = {'R','I','F','F'};
@@ -195,6 +264,12 @@ static void recordingTask(void* param) {
   if (!buffer) {
     DEBUG_MICF("[MIC_REC_TASK] *** BUFFER ALLOCATION FAILED! ***");
     INFO_SENSORSF("[Microphone] Failed to allocate recording buffer");
+    audioCaptureRelease(gMicRecConsumer);
+    gMicRecConsumer = AUDIO_CONSUMER_INVALID;
+    {
+      FsLockGuard fsGuard("mic.record.abort");
+      recordingFile.close();
+    }
     micRecording = false;
     recordingTaskHandle = nullptr;
     vTaskDelete(NULL);
@@ -204,58 +279,41 @@ static void recordingTask(void* param) {
   uint32_t maxSamples = micSampleRate * MAX_RECORDING_SEC;
   DEBUG_MICF("[MIC_REC_TASK] Max samples: %lu (sampleRate=%d, maxSec=%d)", maxSamples, micSampleRate, MAX_RECORDING_SEC);
   
+  MicDspState dsp;
   uint32_t loopCount = 0;
   while (micRecording && micEnabled && recordingSamples < maxSamples) {
-    size_t bytesRead = 0;
-    esp_err_t err;
-    {
-      I2sMicLockGuard i2sGuard("mic.record.read");
-      err = i2s_channel_read(rx_handle, buffer, RECORDING_CHUNK_SIZE, &bytesRead, pdMS_TO_TICKS(100));
-    }
+    // Blocks until the capture ring has new samples; a slow flash write only
+    // makes this consumer lag (and eventually overrun), never stalls capture
+    size_t samplesRead = audioCaptureRead(gMicRecConsumer, buffer, RECORDING_CHUNK_SIZE / sizeof(int16_t), pdMS_TO_TICKS(100));
     
-    if (err == ESP_OK && bytesRead > 0 && recordingFile) {
-      {
-        int32_t sum = 0;
-        size_t sampleCount = bytesRead / sizeof(int16_t);
-
-        applyMicAudioProcessing(buffer, sampleCount);
+    if (samplesRead > 0 && recordingFile) {
+      processMicBlock(dsp, buffer, samplesRead, getMicSoftwareGainMultiplier(), true);
 
-        for (size_t i = 0; i < sampleCount; i++) {
-          int16_t v = buffer[i];
-          sum += (v < 0) ? -v : v;
-        }
-        int32_t avg = (sampleCount > 0) ? (sum / (int32_t)sampleCount) : 0;
-        int level = map(avg, 0, 16384, 0, 100);
-        level = constrain(level, 0, 100);
-        lastAudioLevel = level;
-        lastAudioLevelMs = millis();
-      }
       FsLockGuard fsGuard("mic.record.write");
-      size_t written = recordingFile.write((uint8_t*)buffer, bytesRead);
-      recordingSamples += bytesRead / sizeof(int16_t);
+      size_t written = recordingFile.write((uint8_t*)buffer, samplesRead * sizeof(int16_t));
+      recordingSamples += samplesRead;
       
       // Log every 100 iterations
       if (loopCount % 100 == 0) {
-        DEBUG_MICF("[MIC_REC_TASK] Loop %lu: read=%u, written=%u, totalSamples=%lu",
-                   loopCount, bytesRead, written, recordingSamples);
+        DEBUG_MICF("[MIC_REC_TASK] Loop %lu: read=%u, written=%u, totalSamples=%lu, overruns=%lu",
+                   loopCount, (unsigned)samplesRead, written, recordingSamples,
+                   (unsigned long)audioCaptureOverruns(gMicRecConsumer));
       }
-    } else if (err != ESP_OK) {
-      DEBUG_MICF("[MIC_REC_TASK] i2s_channel_read error: 0x%x", err);
-    } else if (bytesRead == 0) {
-      // Log zero-byte reads periodically
+    } else if (samplesRead == 0) {
+      // Log empty reads periodically
       if (loopCount % 50 == 0) {
-        DEBUG_MICF("[MIC_REC_TASK] Loop %lu: i2s_channel_read returned 0 bytes (no data from mic)", loopCount);
+        DEBUG_MICF("[MIC_REC_TASK] Loop %lu: no samples from capture ring (no data from mic)", loopCount);
       }
     }
     
     loopCount++;
-    // Don't add extra delay - i2s_channel_read already blocks for up to 100ms
-    taskYIELD();
   }
   
-  DEBUG_MICF("[MIC_REC_TASK] Recording loop ended: micRecording=%d micEnabled=%d samples=%lu",
-             micRecording, micEnabled, recordingSamples);
+  DEBUG_MICF("[MIC_REC_TASK] Recording loop ended: micRecording=%d micEnabled=%d samples=%lu overruns=%lu",
+             micRecording, micEnabled, recordingSamples, (unsigned long)audioCaptureOverruns(gMicRecConsumer));
   
+  audioCaptureRelease(gMicRecConsumer);
+  gMicRecConsumer = AUDIO_CONSUMER_INVALID;
   free(buffer);
   DEBUG_MICF("[MIC_REC_TASK] Buffer freed");
   
@@ -334,6 +392,16 @@ bool startRecording() {
   }
   DEBUG_MICF("[MIC_START_REC] Header written, file position: %lu", recordingFile.position());
   
+  // Attach to the shared capture ring; metering and ESP-SR keep running alongside
+  gMicRecConsumer = audioCaptureAcquire("mic.rec", (uint32_t)micSampleRate);
+  if (gMicRecConsumer == AUDIO_CONSUMER_INVALID) {
+    DEBUG_MICF("[MIC_START_REC] *** CAPTURE CONSUMER UNAVAILABLE! ***");
+    FsLockGuard fsGuard("mic.record.abort");
+    recordingFile.close();
+    LittleFS.remove(currentRecordingPath);
+    return false;
+  }
+  
   recordingStartTime = millis();
   recordingSamples = 0;
   micRecording = true;
@@ -356,6 +424,8 @@ bool startRecording() {
     DEBUG_MICF("[MIC_START_REC] *** TASK CREATION FAILED! ***");
     micRecording = false;
     sensorStatusBumpWith("micrecstop");
+    audioCaptureRelease(gMicRecConsumer);
+    gMicRecConsumer = AUDIO_CONSUMER_INVALID;
     recordingFile.close();
     return false;
   }
@@ -450,10 +520,7 @@ bool initMicrophone() {
                (unsigned)heap_caps_get_free_size(MALLOC_CAP_SPIRAM));
   WARN_SYSTEMF("[MIC_INIT] Current state: micEnabled=%d, micConnected=%d", micEnabled, micConnected);
 
-  gMicDcOffset = 0;
-  gMicDcOffsetInitialized = false;
-
-  I2sMicLockGuard i2sGuard("mic.init");
+  gMicLevelDsp = MicDspState();
   
   if (micEnabled) {
     WARN_SYSTEMF("[MIC_INIT] Already initialized - returning true");
@@ -475,112 +542,38 @@ bool initMicrophone() {
 
   WARN_SYSTEMF("[MIC_INIT] Audio settings: sampleRate=%d, bitDepth=%d, channels=%d, gain=%d%%",
                micSampleRate, micBitDepth, micChannels, micGain);
-  WARN_SYSTEMF("[MIC_INIT] Pin config: CLK=%d, DATA=%d", MIC_PDM_CLK_PIN, MIC_PDM_DATA_PIN);
   INFO_SENSORSF("[Microphone] Initializing PDM microphone...");
 
-  // Configure I2S channel for PDM RX (new driver API)
-  WARN_SYSTEMF("[MIC_INIT] Creating I2S channel config...");
-  i2s_chan_config_t chan_cfg = I2S_CHANNEL_DEFAULT_CONFIG(I2S_NUM_0, I2S_ROLE_MASTER);
-  chan_cfg.dma_desc_num = 4;
-  chan_cfg.dma_frame_num = AUDIO_BUFFER_SIZE;
-  
-  WARN_SYSTEMF("[MIC_INIT] Channel config: i2s_num=0, dma_desc_num=%d, dma_frame_num=%d",
-               (int)chan_cfg.dma_desc_num, (int)chan_cfg.dma_frame_num);
-  
-  WARN_SYSTEMF("[MIC_INIT] Calling i2s_new_channel()...");
-  esp_err_t err = i2s_new_channel(&chan_cfg, NULL, &rx_handle);
-  WARN_SYSTEMF("[MIC_INIT] i2s_new_channel returned: 0x%x (%s), handle=%p", 
-               err, esp_err_to_name(err), rx_handle);
-  
-  if (err != ESP_OK) {
-    WARN_SYSTEMF("[MIC_INIT] *** I2S CHANNEL CREATE FAILED! ***");
-    INFO_SENSORSF("[Microphone] Failed to create I2S channel: 0x%x", err);
-    return false;
-  }
-
-  // Configure PDM RX mode
-  WARN_SYSTEMF("[MIC_INIT] Configuring PDM RX mode...");
-  i2s_pdm_rx_config_t pdm_rx_cfg = {
-    .clk_cfg = I2S_PDM_RX_CLK_DEFAULT_CONFIG((uint32_t)micSampleRate),
-    .slot_cfg = I2S_PDM_RX_SLOT_DEFAULT_CONFIG(I2S_DATA_BIT_WIDTH_16BIT, I2S_SLOT_MODE_MONO),
-    .gpio_cfg = {
-      .clk = (gpio_num_t)MIC_PDM_CLK_PIN,
-      .din = (gpio_num_t)MIC_PDM_DATA_PIN,
-      .invert_flags = {
-        .clk_inv = false,
-      },
-    },
-  };
-  
-  WARN_SYSTEMF("[MIC_INIT] PDM clk_cfg: sample_rate_hz=%u, clk_src=%d, mclk_mult=%d, bclk_div=%u",
-               (unsigned)pdm_rx_cfg.clk_cfg.sample_rate_hz,
-               (int)pdm_rx_cfg.clk_cfg.clk_src,
-               (int)pdm_rx_cfg.clk_cfg.mclk_multiple,
-               (unsigned)pdm_rx_cfg.clk_cfg.bclk_div);
-  WARN_SYSTEMF("[MIC_INIT] PDM gpio_cfg: clk=%d, din=%d, clk_inv=%d",
-               (int)pdm_rx_cfg.gpio_cfg.clk, (int)pdm_rx_cfg.gpio_cfg.din,
-               (int)pdm_rx_cfg.gpio_cfg.invert_flags.clk_inv);
-  WARN_SYSTEMF("[MIC_INIT] PDM slot_cfg: data_bit_width=16, slot_mode=MONO");
-  
-  WARN_SYSTEMF("[MIC_INIT] Calling i2s_channel_init_pdm_rx_mode()...");
-  err = i2s_channel_init_pdm_rx_mode(rx_handle, &pdm_rx_cfg);
-  WARN_SYSTEMF("[MIC_INIT] i2s_channel_init_pdm_rx_mode returned: 0x%x (%s)", err, esp_err_to_name(err));
-  
-  if (err != ESP_OK) {
-    WARN_SYSTEMF("[MIC_INIT] *** PDM RX INIT FAILED! ***");
-    INFO_SENSORSF("[Microphone] Failed to init PDM RX: 0x%x", err);
-    i2s_del_channel(rx_handle);
-    rx_handle = NULL;
+  // Attach to the shared capture ring (starts I2S if nothing else is using it)
+  gMicConsumer = audioCaptureAcquire("mic", (uint32_t)micSampleRate);
+  if (gMicConsumer == AUDIO_CONSUMER_INVALID) {
+    WARN_SYSTEMF("[MIC_INIT] *** CAPTURE UNAVAILABLE (running at %lu Hz?) ***", (unsigned long)audioCaptureSampleRate());
+    INFO_SENSORSF("[Microphone] Failed to start audio capture at %d Hz", micSampleRate);
     return false;
   }
 
-  // Enable the channel
-  WARN_SYSTEMF("[MIC_INIT] Calling i2s_channel_enable()...");
-  err = i2s_channel_enable(rx_handle);
-  WARN_SYSTEMF("[MIC_INIT] i2s_channel_enable returned: 0x%x (%s)", err, esp_err_to_name(err));
-  
-  if (err != ESP_OK) {
-    WARN_SYSTEMF("[MIC_INIT] *** I2S CHANNEL ENABLE FAILED! ***");
-    INFO_SENSORSF("[Microphone] Failed to enable I2S channel: 0x%x", err);
-    i2s_del_channel(rx_handle);
-    rx_handle = NULL;
-    return false;
+  // Wait for the first block past the PDM warm-up to confirm the mic is producing data
+  int16_t probeBuf[256];
+  size_t probeSamples = 0;
+  uint32_t probeStart = millis();
+  while (probeSamples == 0 && (millis() - probeStart) < 500) {
+    probeSamples = audioCaptureRead(gMicConsumer, probeBuf, 256, pdMS_TO_TICKS(100));
   }
-
-  // Flush initial samples (PDM needs warm-up time)
-  WARN_SYSTEMF("[MIC_INIT] Starting PDM warm-up flush (10 reads of 512 bytes)...");
-  int16_t flushBuf[256];
-  size_t bytesRead = 0;
-  int flushCount = 0;
-  int successCount = 0;
-  for (int i = 0; i < 10; i++) {
-    uint32_t readStart = millis();
-    esp_err_t readErr = i2s_channel_read(rx_handle, flushBuf, sizeof(flushBuf), &bytesRead, pdMS_TO_TICKS(100));
-    uint32_t readMs = millis() - readStart;
-    flushCount++;
-    if (readErr == ESP_OK && bytesRead > 0) {
-      successCount++;
-      if (i == 9) {
-        int16_t mn = 32767, mx = -32768;
-        for (size_t j = 0; j < bytesRead / 2; j++) {
-          if (flushBuf[j] < mn) mn = flushBuf[j];
-          if (flushBuf[j] > mx) mx = flushBuf[j];
-        }
-        WARN_SYSTEMF("[MIC_INIT] Flush[%d]: %u bytes in %u ms, min=%d, max=%d", i, (unsigned)bytesRead, readMs, mn, mx);
-      }
-    } else {
-      WARN_SYSTEMF("[MIC_INIT] Flush[%d]: err=0x%x, bytes=%u, took %u ms", i, readErr, (unsigned)bytesRead, readMs);
+  if (probeSamples > 0) {
+    int16_t mn = 32767, mx = -32768;
+    for (size_t j = 0; j < probeSamples; j++) {
+      if (probeBuf[j] < mn) mn = probeBuf[j];
+      if (probeBuf[j] > mx) mx = probeBuf[j];
     }
-  }
-  WARN_SYSTEMF("[MIC_INIT] Warm-up flush complete: %d/%d successful reads", successCount, flushCount);
-  
-  if (successCount == 0) {
-    WARN_SYSTEMF("[MIC_INIT] WARNING: No data received from microphone during flush!");
+    WARN_SYSTEMF("[MIC_INIT] First samples after %u ms: %u samples, min=%d, max=%d",
+                 (unsigned)(millis() - probeStart), (unsigned)probeSamples, mn, mx);
+  } else {
+    WARN_SYSTEMF("[MIC_INIT] WARNING: No data received from microphone!");
     INFO_SENSORSF("[Microphone] WARNING: Microphone may not be connected or responding");
   }
 
   micEnabled = true;
-  micConnected = (successCount > 0);  // Only mark connected if we got data
+  micConnected = (probeSamples > 0);  // Only mark connected if we got data
   sensorStatusBumpWith("openmic");
 
   WARN_SYSTEMF("[MIC_INIT] ########## initMicrophone() SUCCESS ##########");
@@ -595,9 +588,7 @@ bool initMicrophone() {
 
 void stopMicrophone() {
   WARN_SYSTEMF("[MIC_STOP] ########## stopMicrophone() BEGIN ##########");
-  WARN_SYSTEMF("[MIC_STOP] Current state: micEnabled=%d, rx_handle=%p", micEnabled, rx_handle);
-
-  I2sMicLockGuard i2sGuard("mic.stop");
+  WARN_SYSTEMF("[MIC_STOP] Current state: micEnabled=%d, consumer=%d", micEnabled, (int)gMicConsumer);
   
   if (!micEnabled) {
     WARN_SYSTEMF("[MIC_STOP] Already stopped - returning");
@@ -609,17 +600,14 @@ void stopMicrophone() {
                (unsigned)esp_get_free_heap_size(), 
                (unsigned)heap_caps_get_free_size(MALLOC_CAP_SPIRAM));
   
-  if (rx_handle) {
-    WARN_SYSTEMF("[MIC_STOP] Calling i2s_channel_disable()...");
-    esp_err_t err = i2s_channel_disable(rx_handle);
-    WARN_SYSTEMF("[MIC_STOP] i2s_channel_disable returned: 0x%x (%s)", err, esp_err_to_name(err));
-    
-    WARN_SYSTEMF("[MIC_STOP] Calling i2s_del_channel()...");
-    err = i2s_del_channel(rx_handle);
-    WARN_SYSTEMF("[MIC_STOP] i2s_del_channel returned: 0x%x (%s)", err, esp_err_to_name(err));
-    rx_handle = NULL;
+  // Recording holds its own capture consumer; let it finalize the WAV first
+  if (micRecording) {
+    stopRecording();
   }
 
+  audioCaptureRelease(gMicConsumer);
+  gMicConsumer = AUDIO_CONSUMER_INVALID;
+
   micEnabled = false;
   micRecording = false;
   sensorStatusBumpWith("closemic");
@@ -633,7 +621,7 @@ void stopMicrophone() {
 
 int16_t* captureAudioSamples(size_t sampleCount, size_t* outLen) {
   WARN_SYSTEMF("[MIC_CAPTURE] captureAudioSamples(count=%u) called", (unsigned)sampleCount);
-  WARN_SYSTEMF("[MIC_CAPTURE] micEnabled=%d, rx_handle=%p", micEnabled, rx_handle);
+  WARN_SYSTEMF("[MIC_CAPTURE] micEnabled=%d", micEnabled);
   
   if (!micEnabled) {
     WARN_SYSTEMF("[MIC_CAPTURE] Mic not enabled - returning NULL");
@@ -657,28 +645,39 @@ int16_t* captureAudioSamples(size_t sampleCount, size_t* outLen) {
     return nullptr;
   }
 
-  WARN_SYSTEMF("[MIC_CAPTURE] Calling i2s_channel_read(handle=%p, bufSize=%u, timeout=MAX)...", rx_handle, (unsigned)bufferSize);
+  // Dedicated consumer so this one-shot capture sees a contiguous stream from "now"
+  AudioConsumerId consumer = audioCaptureAcquire("mic.capture", (uint32_t)micSampleRate);
+  if (consumer == AUDIO_CONSUMER_INVALID) {
+    WARN_SYSTEMF("[MIC_CAPTURE] *** CAPTURE CONSUMER UNAVAILABLE! ***");
+    free(buffer);
+    if (outLen) *outLen = 0;
+    return nullptr;
+  }
+
   unsigned long startMs = millis();
-  size_t bytesRead = 0;
-  esp_err_t err;
-  {
-    I2sMicLockGuard i2sGuard("mic.capture.read");
-    err = i2s_channel_read(rx_handle, buffer, bufferSize, &bytesRead, portMAX_DELAY);
+  unsigned long budgetMs = (unsigned long)((uint64_t)sampleCount * 1000 / (uint32_t)micSampleRate) + 500;
+  size_t got = 0;
+  while (got < sampleCount && (millis() - startMs) < budgetMs) {
+    got += audioCaptureRead(consumer, buffer + got, sampleCount - got, pdMS_TO_TICKS(100));
   }
+  uint32_t overruns = audioCaptureOverruns(consumer);
+  audioCaptureRelease(consumer);
   unsigned long elapsed = millis() - startMs;
+  size_t bytesRead = got * sizeof(int16_t);
   
-  WARN_SYSTEMF("[MIC_CAPTURE] i2s_channel_read returned 0x%x (%s) in %lu ms, bytesRead=%u", 
-               err, esp_err_to_name(err), elapsed, (unsigned)bytesRead);
+  WARN_SYSTEMF("[MIC_CAPTURE] Captured %u/%u samples in %lu ms (overruns=%lu)", 
+               (unsigned)got, (unsigned)sampleCount, elapsed, (unsigned long)overruns);
   
-  if (err != ESP_OK) {
-    WARN_SYSTEMF("[MIC_CAPTURE] *** I2S READ FAILED! ***");
-    INFO_SENSORSF("[Microphone] Failed to read samples: 0x%x", err);
+  if (got == 0) {
+    WARN_SYSTEMF("[MIC_CAPTURE] *** NO SAMPLES CAPTURED! ***");
+    INFO_SENSORSF("[Microphone] Failed to read samples");
     free(buffer);
     if (outLen) *outLen = 0;
     return nullptr;
   }
 
-  applyMicAudioProcessing(buffer, bytesRead / sizeof(int16_t));
+  MicDspState dsp;
+  processMicBlock(dsp, buffer, got, getMicSoftwareGainMultiplier(), true);
 
   // Log sample statistics
   if (bytesRead >= 4) {
@@ -717,43 +716,22 @@ int getAudioLevel() {
   }
 
   uint32_t now = millis();
-  if (micRecording) {
-    return lastAudioLevel;
-  }
   if (lastAudioLevelMs != 0 && (now - lastAudioLevelMs) < 150) {
     return lastAudioLevel;
   }
 
-  // Read a small sample to calculate level
+  // Meter the most recent samples from the capture ring (never blocks, and
+  // runs alongside recording and ESP-SR)
   int16_t samples[256];
-  size_t bytesRead = 0;
-
-  bool took = false;
-  if (i2sMicMutex && xSemaphoreTake(i2sMicMutex, 0) == pdTRUE) {
-    took = true;
-  } else {
-    if (shouldLog) {
-      DEBUG_MICF("[MIC_LEVEL] i2sMicMutex busy; returning cached last=%d", lastAudioLevel);
-    }
-    return lastAudioLevel;
-  }
-
-  esp_err_t err = i2s_channel_read(rx_handle, samples, sizeof(samples), &bytesRead, pdMS_TO_TICKS(50));
-
-  if (took && i2sMicMutex) {
-    xSemaphoreGive(i2sMicMutex);
-  }
-  
-  if (err != ESP_OK || bytesRead == 0) {
+  size_t sampleCount = audioCaptureReadLatest(gMicConsumer, samples, 256);
+  if (sampleCount == 0) {
     if (shouldLog) {
-      DEBUG_MICF("[MIC_LEVEL] i2s_channel_read failed or no data: err=0x%x bytesRead=%u, returning last=%d",
-                 err, bytesRead, lastAudioLevel);
+      DEBUG_MICF("[MIC_LEVEL] No samples in capture ring, returning last=%d", lastAudioLevel);
     }
     return lastAudioLevel;
   }
 
-  size_t sampleCount = bytesRead / sizeof(int16_t);
-  applyMicAudioProcessing(samples, sampleCount);
+  processMicBlock(gMicLevelDsp, samples, sampleCount, getMicSoftwareGainMultiplier(), true);
 
   // Calculate RMS level
   int32_t sum = 0;
@@ -781,15 +759,26 @@ int getAudioLevel() {
 }
 
 const char* buildMicrophoneStatusJson() {
-  snprintf(gMicCmdBuffer, sizeof(gMicCmdBuffer),
+  int len = snprintf(gMicCmdBuffer, sizeof(gMicCmdBuffer),
     "{\"enabled\":%s,\"connected\":%s,\"recording\":%s,"
-    "\"sampleRate\":%d,\"bitDepth\":%d,\"channels\":%d,\"level\":%d}",
+    "\"sampleRate\":%d,\"bitDepth\":%d,\"channels\":%d,\"level\":%d,\"speech\":%s,\"spectrum\":[",
     micEnabled ? "true" : "false",
     micConnected ? "true" : "false",
     micRecording ? "true" : "false",
     micSampleRate, micBitDepth, micChannels,
-    micEnabled ? getAudioLevel() : 0
+    micEnabled ? getAudioLevel() : 0,
+    (micEnabled && audioCaptureSpeechActive()) ? "true" : "false"
   );
+
+  // Band power in 1/8-octave steps (see System_AudioAnalysis.h); empty when idle
+  uint8_t bins[AUDIO_SPECTRUM_DEFAULT_BINS];
+  size_t count = micEnabled ? audioSpectrumLatest(bins, AUDIO_SPECTRUM_DEFAULT_BINS) : 0;
+  for (size_t i = 0; i < count && len > 0 && len < (int)sizeof(gMicCmdBuffer) - 8; i++) {
+    len += snprintf(gMicCmdBuffer + len, sizeof(gMicCmdBuffer) - len, i ? ",%u" : "%u", (unsigned)bins[i]);
+  }
+  if (len > 0 && len < (int)sizeof(gMicCmdBuffer) - 3) {
+    snprintf(gMicCmdBuffer + len, sizeof(gMicCmdBuffer) - len, "]}");
+  }
   return gMicCmdBuffer;
 }
 
@@ -1033,16 +1022,24 @@ static void micVisualizerTaskFunc(void* param) {
     return;
   }
   
+  AudioConsumerId consumer = audioCaptureAcquire("mic.viz", (uint32_t)micSampleRate);
+  if (consumer == AUDIO_CONSUMER_INVALID) {
+    heap_caps_free(samples);
+    gMicVisualizerRunning = false;
+    gMicVisualizerTask = nullptr;
+    vTaskDelete(nullptr);
+    return;
+  }
+  MicDspState dsp;
+  
   Serial.println("\n=== AUDIO VISUALIZER (press any key to stop) ===");
   Serial.println("Level: [--------------------] Peak | Min/Max samples");
   
   while (gMicVisualizerRunning && micEnabled) {
-    size_t bytesRead = 0;
-    esp_err_t err = i2s_channel_read(rx_handle, samples, bufSize * sizeof(int16_t), &bytesRead, pdMS_TO_TICKS(100));
+    size_t sampleCount = audioCaptureReadLatest(consumer, samples, bufSize);
     
-    if (err == ESP_OK && bytesRead > 0) {
-      size_t sampleCount = bytesRead / sizeof(int16_t);
-      applyMicAudioProcessing(samples, sampleCount);
+    if (sampleCount > 0) {
+      processMicBlock(dsp, samples, sampleCount, getMicSoftwareGainMultiplier(), true);
       
       // Calculate stats
       int16_t minVal = 32767, maxVal = -32768;
@@ -1086,6 +1083,7 @@ static void micVisualizerTaskFunc(void* param) {
   }
   
   Serial.println("\n=== VISUALIZER STOPPED ===");
+  audioCaptureRelease(consumer);
   heap_caps_free(samples);
   gMicVisualizerRunning = false;
   gMicVisualizerTask = nullptr;
@@ -1140,6 +1138,7 @@ const CommandEntry micCommands[] = {
   { "micsamplerate", "Get/set sample rate.", false, cmd_micsamplerate, "Usage: micsamplerate [8000-48000]" },
   { "micgain", "Get/set microphone gain.", false, cmd_micgain, "Usage: micgain [0-100]" },
   { "micbitdepth", "Get/set bit depth.", false, cmd_micbitdepth, "Usage: micbitdepth [16|32]" },
+  { "audiocapture", "Show shared audio capture ring and consumer status.", false, cmd_audiocapture, "Usage: audiocapture" },
   
   // Auto-start
   { "micautostart", "Enable/disable microphone auto-start after boot [on|off]", false, cmd_micautostart, "Usage: micautostart [on|off]" },
@@ -8,10 +8,15 @@
 
 #include "OLED_Display.h"
 #include "OLED_Utils.h"
+#include "System_AudioAnalysis.h"
+#include "System_AudioCapture.h"
 #include "System_Microphone.h"
 #include <Adafruit_SSD1306.h>
+#if DISPLAY_IS_COLOR
+#include "HAL_TFTCompositor.h"
+#endif
 
-// Microphone OLED display function - shows VU meter and recording status
+// Microphone OLED display function - shows VU meter, spectrum and recording status
 static void displayMicrophone() {
   extern void oledDrawIcon(int x, int y, const char* iconName, int targetSize);
   extern void oledDrawLevelBars(int x, int y, int level, int maxBars, int barHeight);
@@ -66,6 +71,51 @@ static void displayMicrophone() {
   // Level percentage
   oledDisplay->setCursor(barX + barWidth + 4, y + 1);
   oledDisplay->printf("%d%%", level);
+  y += barHeight + 2;
+
+  // Spectrum bars in the remaining content area (low frequencies on the left)
+  int specHeight = OLED_CONTENT_START_Y + OLED_CONTENT_HEIGHT - y;
+  uint8_t bins[AUDIO_SPECTRUM_DEFAULT_BINS];
+  size_t count = (specHeight >= 6) ? audioSpectrumLatest(bins, AUDIO_SPECTRUM_DEFAULT_BINS) : 0;
+  // Show the top ~48 dB of the 0..255 (0.38 dB/step) scale
+  const int floorVal = 80;
+  const int span = 128;
+#if DISPLAY_IS_COLOR
+  // Color panels: palette-graded spectrum (top half) and live waveform
+  // (bottom half) composited in bands
+  if (count > 0) {
+    for (size_t i = 0; i < count; i++) {
+      int v = (int)bins[i] - floorVal;
+      bins[i] = (uint8_t)(v <= 0 ? 0 : (v > span ? span : v));
+    }
+    static int16_t wave[512];
+    size_t waveCount = audioCapturePeekLatest(wave, sizeof(wave) / sizeof(wave[0]), nullptr);
+    int barsH = specHeight / 2;
+    TFTCompositor spectrum(0, y, SCREEN_WIDTH, barsH, DISPLAY_BG);
+    spectrum.setBars(bins, (uint8_t)count, span);
+    spectrum.render(oledDisplay);
+    TFTCompositor scope(0, y + barsH, SCREEN_WIDTH, specHeight - barsH, DISPLAY_BG);
+    scope.setWaveform(wave, waveCount, DISPLAY_FG);
+    scope.render(oledDisplay);
+  }
+#else
+  if (count > 0) {
+    int colWidth = SCREEN_WIDTH / (int)count;
+    for (size_t i = 0; i < count; i++) {
+      int v = (int)bins[i] - floorVal;
+      if (v <= 0) continue;
+      int h = (v * specHeight) / span;
+      if (h > specHeight) h = specHeight;
+      oledDisplay->fillRect((int)i * colWidth, y + specHeight - h, colWidth > 1 ? colWidth - 1 : 1, h, SSD1306_WHITE);
+    }
+  }
+#endif
+
+  // Speech indicator next to the status line
+  if (audioCaptureSpeechActive()) {
+    oledDisplay->setCursor(SCREEN_WIDTH - 32, OLED_CONTENT_START_Y);
+    oledDisplay->print("VOX");
+  }
 }
 
 // Availability check for Microphone OLED mode
@@ -122,7 +172,8 @@ static const OLEDModeEntry microphoneOLEDModes[] = {
     microphoneInputHandler,      // inputFunc
     true,                        // showInMenu
     65,                          // menuOrder (after FM Radio at 60)
-    nullptr                      // hints
+    nullptr,                     // hints
+    OLED_REFRESH_LIVE_FAST       // refreshMs
   }
 };
 
@@ -34,6 +34,8 @@ inline void streamMicrophoneSensorCard(httpd_req_t* req) {
       </div>
       <span class="vu-meter-label" id="mic-level-text">0%</span>
     </div>
+    <div class="mic-spectrum" id="mic-spectrum" title="Spectrum (low to high frequency)"></div>
+    <div class="info-row"><span>Voice activity:</span><span id="mic-speech">--</span></div>
     <div class="sensor-controls">
       <button class="btn btn-primary" id="btn-mic-start">Open</button>
       <button class="btn btn-secondary" id="btn-mic-stop">Close</button>
@@ -139,6 +141,20 @@ inline void streamMicrophoneSensorJS(httpd_req_t* req) {
     "      if (levelText && data.level !== undefined) {\n"
     "        levelText.textContent = data.level + '%';\n"
     "      }\n"
+    "      var speechEl = document.getElementById('mic-speech');\n"
+    "      if (speechEl) speechEl.textContent = data.enabled ? (data.speech ? 'Speech' : 'Silence') : '--';\n"
+    "      var specEl = document.getElementById('mic-spectrum');\n"
+    "      if (specEl && data.spectrum) {\n"
+    "        var n = data.spectrum.length;\n"
+    "        if (specEl.children.length !== n) {\n"
+    "          specEl.innerHTML = '';\n"
+    "          for (var i = 0; i < n; i++) specEl.appendChild(document.createElement('div'));\n"
+    "        }\n"
+    "        for (var j = 0; j < n; j++) {\n"
+    "          var pct = Math.max(0, Math.min(100, (data.spectrum[j] - 80) * 100 / 128));\n"
+    "          specEl.children[j].style.height = pct + '%';\n"
+    "        }\n"
+    "      }\n"
     "      return data;\n"
     "    })\n"
     "    .catch(function(e) {\n"
@@ -286,6 +302,22 @@ inline void streamMicrophoneSensorCSS(httpd_req_t* req) {
   text-align: right;
   font-weight: bold;
 }
+.mic-spectrum {
+  display: flex;
+  align-items: flex-end;
+  gap: 1px;
+  height: 48px;
+  margin: 0 0 10px 0;
+  background: #333;
+  border-radius: 4px;
+  overflow: hidden;
+}
+.mic-spectrum div {
+  flex: 1;
+  height: 0;
+  background: #3498db;
+  transition: height 0.1s ease;
+}
 .recordings-list {
   max-height: 300px;
   overflow-y: auto;
@@ -18,6 +18,7 @@ SemaphoreHandle_t gMeshRetryMutex = nullptr;
 SemaphoreHandle_t gFileTransferMutex = nullptr;
 SemaphoreHandle_t gTopoStreamsMutex = nullptr;
 SemaphoreHandle_t i2sMicMutex = nullptr;
+SemaphoreHandle_t gMapCacheMutex = nullptr;
 
 // ============================================================================
 // Initialization
@@ -31,13 +32,15 @@ void initMutexes() {
   gFileTransferMutex = xSemaphoreCreateMutex();
   gTopoStreamsMutex = xSemaphoreCreateMutex();
   i2sMicMutex = xSemaphoreCreateMutex();
+  gMapCacheMutex = xSemaphoreCreateMutex();
   
   // i2cMutex removed — I2cLockGuard and i2cLock/Unlock go through I2CDeviceManager::getBusMutex() directly
 
   // Log creation status
   bool allCreated = (fsMutex != nullptr) && (gJsonResponseMutex != nullptr) && 
                     (gMeshRetryMutex != nullptr) && (gFileTransferMutex != nullptr) &&
-                    (gTopoStreamsMutex != nullptr) && (i2sMicMutex != nullptr);
+                    (gTopoStreamsMutex != nullptr) && (i2sMicMutex != nullptr) &&
+                    (gMapCacheMutex != nullptr);
   
   if (!allCreated) {
     if (gOutputFlags & OUTPUT_SERIAL) {
@@ -71,6 +74,246 @@ bool isI2cLockedByCurrentTask() {
   return mgr ? isHeldByCurrentTask(mgr->getBusMutex()) : false;
 }
 
+// ============================================================================
+// Per-Path Lock Table
+// ============================================================================
+// gFsPathTableMutex guards only the table bookkeeping (never held across I/O).
+// Waiters sleep on a single event bit that every release sets; the bit is only
+// cleared under the table mutex, so a release cannot be missed.
+
+struct FsPathSlot {
+  uint32_t key;          // FNV-1a of the path (0 = free)
+  uint16_t readers;
+  uint16_t writerDepth;
+  TaskHandle_t writer;
+};
+
+struct FsSharedHolder {
+  TaskHandle_t task;
+  uint16_t depth;
+};
+
+static FsPathSlot gFsPathSlots[FS_PATH_LOCK_SLOTS];
+static FsSharedHolder gFsSharedHolders[FS_PATH_LOCK_SLOTS];
+static uint16_t gFsSharedTotal = 0;
+static SemaphoreHandle_t gFsPathTableMutex = nullptr;
+static EventGroupHandle_t gFsPathEvents = nullptr;
+static const EventBits_t FS_PATH_RELEASED_BIT = (1 << 0);
+static const EventBits_t FS_SHARED_DRAINED_BIT = (1 << 1);
+
+// Hash of the VFS::normalize() form of the path (trimmed, leading '/', no repeated
+// or trailing slashes), computed in place so "a/b", "/a//b" and "/a/b/" share a lock
+static uint32_t fsPathKey(const char* path) {
+  uint32_t h = 2166136261u;
+  const char* s = path ? path : "";
+  const char* e = s + strlen(s);
+  while (s < e && isspace((unsigned char)*s)) s++;
+  while (e > s && isspace((unsigned char)e[-1])) e--;
+  while (e > s && e[-1] == '/') e--;
+
+  char prev = '/';
+  h ^= (uint8_t)'/'; h *= 16777619u;
+  for (const char* p = s; p < e; ++p) {
+    if (*p == '/' && prev == '/') continue;
+    h ^= (uint8_t)*p; h *= 16777619u;
+    prev = *p;
+  }
+  return h ? h : 1;
+}
+
+static bool ensureFsPathTable() {
+  if (gFsPathTableMutex && gFsPathEvents) return true;
+  // Lazily created so guards work before initMutexes() during early boot
+  static portMUX_TYPE initMux = portMUX_INITIALIZER_UNLOCKED;
+  SemaphoreHandle_t m = xSemaphoreCreateMutex();
+  EventGroupHandle_t e = xEventGroupCreate();
+  bool used = false;
+  portENTER_CRITICAL(&initMux);
+  if (!gFsPathTableMutex && m && e) {
+    gFsPathTableMutex = m;
+    gFsPathEvents = e;
+    used = true;
+  }
+  portEXIT_CRITICAL(&initMux);
+  if (!used) {
+    if (m) vSemaphoreDelete(m);
+    if (e) vEventGroupDelete(e);
+  }
+  return gFsPathTableMutex && gFsPathEvents;
+}
+
+static FsSharedHolder* findSharedHolder(TaskHandle_t task) {
+  for (int i = 0; i < FS_PATH_LOCK_SLOTS; i++) {
+    if (gFsSharedHolders[i].task == task) return &gFsSharedHolders[i];
+  }
+  return nullptr;
+}
+
+// Enter the global lock in shared mode. Skipped when this task already holds
+// fsMutex exclusively (it already excludes everyone).
+static void fsSharedEnter(TaskHandle_t self) {
+  if (isHeldByCurrentTask(fsMutex)) return;
+
+  xSemaphoreTake(gFsPathTableMutex, portMAX_DELAY);
+  FsSharedHolder* h = findSharedHolder(self);
+  if (h) {
+    h->depth++;
+    gFsSharedTotal++;
+    xSemaphoreGive(gFsPathTableMutex);
+    return;
+  }
+  xSemaphoreGive(gFsPathTableMutex);
+
+  // First shared hold for this task: queue behind any exclusive (legacy) holder
+  if (fsMutex) xSemaphoreTake(fsMutex, portMAX_DELAY);
+  while (true) {
+    xSemaphoreTake(gFsPathTableMutex, portMAX_DELAY);
+    h = findSharedHolder(nullptr);
+    if (h) {
+      h->task = self;
+      h->depth = 1;
+      gFsSharedTotal++;
+      xSemaphoreGive(gFsPathTableMutex);
+      break;
+    }
+    // Holder table full: wait for another task's last guard to go (every path
+    // release sets the bit) rather than proceeding unlocked
+    xEventGroupClearBits(gFsPathEvents, FS_PATH_RELEASED_BIT);
+    xSemaphoreGive(gFsPathTableMutex);
+    xEventGroupWaitBits(gFsPathEvents, FS_PATH_RELEASED_BIT, pdFALSE, pdTRUE, pdMS_TO_TICKS(50));
+  }
+  if (fsMutex) xSemaphoreGive(fsMutex);
+}
+
+// Caller holds gFsPathTableMutex
+static void fsSharedLeaveLocked(TaskHandle_t self) {
+  FsSharedHolder* h = findSharedHolder(self);
+  if (!h) return;
+  if (--h->depth == 0) h->task = nullptr;
+  if (gFsSharedTotal > 0) gFsSharedTotal--;
+  if (gFsSharedTotal == 0) xEventGroupSetBits(gFsPathEvents, FS_SHARED_DRAINED_BIT);
+}
+
+// A task inside a path guard that calls legacy fsLock() code (e.g. VFS::open)
+// stays at shared level: taking fsMutex there could deadlock against an
+// exclusive holder that is waiting for this task's shared hold to drain.
+static bool fsSharedHeldByCurrentTask() {
+  if (!gFsPathTableMutex) return false;
+  xSemaphoreTake(gFsPathTableMutex, portMAX_DELAY);
+  bool held = findSharedHolder(xTaskGetCurrentTaskHandle()) != nullptr;
+  xSemaphoreGive(gFsPathTableMutex);
+  return held;
+}
+
+// After taking fsMutex exclusively: wait until all shared holders have left
+static void fsWaitForSharedDrain() {
+  if (!gFsPathTableMutex) return;
+  while (true) {
+    xSemaphoreTake(gFsPathTableMutex, portMAX_DELAY);
+    if (gFsSharedTotal == 0) {
+      xSemaphoreGive(gFsPathTableMutex);
+      return;
+    }
+    xEventGroupClearBits(gFsPathEvents, FS_SHARED_DRAINED_BIT);
+    xSemaphoreGive(gFsPathTableMutex);
+    xEventGroupWaitBits(gFsPathEvents, FS_SHARED_DRAINED_BIT, pdFALSE, pdTRUE, pdMS_TO_TICKS(50));
+  }
+}
+
+bool fsPathLock(const char* path, bool write) {
+  if (!ensureFsPathTable()) return false;
+  TaskHandle_t self = xTaskGetCurrentTaskHandle();
+  uint32_t key = fsPathKey(path);
+
+  fsSharedEnter(self);
+
+  while (true) {
+    xSemaphoreTake(gFsPathTableMutex, portMAX_DELAY);
+
+    FsPathSlot* slot = nullptr;
+    FsPathSlot* freeSlot = nullptr;
+    for (int i = 0; i < FS_PATH_LOCK_SLOTS; i++) {
+      if (gFsPathSlots[i].key == key) { slot = &gFsPathSlots[i]; break; }
+      if (!freeSlot && gFsPathSlots[i].key == 0) freeSlot = &gFsPathSlots[i];
+    }
+    if (!slot && freeSlot) {
+      slot = freeSlot;
+      slot->key = key;
+      slot->readers = 0;
+      slot->writerDepth = 0;
+      slot->writer = nullptr;
+    }
+
+    if (slot) {
+      bool ownsWrite = (slot->writer == self);
+      bool granted = false;
+      if (write) {
+        if (ownsWrite) { slot->writerDepth++; granted = true; }
+        else if (!slot->writer && slot->readers == 0) {
+          slot->writer = self;
+          slot->writerDepth = 1;
+          granted = true;
+        }
+      } else if (ownsWrite || !slot->writer) {
+        slot->readers++;
+        granted = true;
+      }
+      if (granted) {
+        xSemaphoreGive(gFsPathTableMutex);
+        return true;
+      }
+    }
+
+    // Contended path (or table full): sleep until the next release
+    xEventGroupClearBits(gFsPathEvents, FS_PATH_RELEASED_BIT);
+    xSemaphoreGive(gFsPathTableMutex);
+    xEventGroupWaitBits(gFsPathEvents, FS_PATH_RELEASED_BIT, pdFALSE, pdTRUE, pdMS_TO_TICKS(50));
+  }
+}
+
+static void fsPathUnlockKey(uint32_t key, bool write) {
+  if (!gFsPathTableMutex) return;
+  TaskHandle_t self = xTaskGetCurrentTaskHandle();
+
+  xSemaphoreTake(gFsPathTableMutex, portMAX_DELAY);
+  for (int i = 0; i < FS_PATH_LOCK_SLOTS; i++) {
+    FsPathSlot& slot = gFsPathSlots[i];
+    if (slot.key != key) continue;
+    if (write) {
+      if (slot.writer == self && slot.writerDepth > 0 && --slot.writerDepth == 0) {
+        slot.writer = nullptr;
+      }
+    } else if (slot.readers > 0) {
+      slot.readers--;
+    }
+    if (!slot.writer && slot.readers == 0) slot.key = 0;
+    break;
+  }
+  fsSharedLeaveLocked(self);
+  xEventGroupSetBits(gFsPathEvents, FS_PATH_RELEASED_BIT);
+  xSemaphoreGive(gFsPathTableMutex);
+}
+
+void fsPathUnlock(const char* path, bool write) {
+  fsPathUnlockKey(fsPathKey(path), write);
+}
+
+FsPathReadGuard::FsPathReadGuard(const char* path) : held(false), key(fsPathKey(path)) {
+  held = fsPathLock(path, false);
+}
+
+FsPathReadGuard::~FsPathReadGuard() {
+  if (held) fsPathUnlockKey(key, false);
+}
+
+FsPathWriteGuard::FsPathWriteGuard(const char* path) : held(false), key(fsPathKey(path)) {
+  held = fsPathLock(path, true);
+}
+
+FsPathWriteGuard::~FsPathWriteGuard() {
+  if (held) fsPathUnlockKey(key, true);
+}
+
 // ============================================================================
 // FsLockGuard Implementation
 // ============================================================================
@@ -78,13 +321,14 @@ bool isI2cLockedByCurrentTask() {
 FsLockGuard::FsLockGuard(const char* owner) : held(false) {
   if (fsMutex) {
     // Reentrant-safe: if already owned by this task, skip
-    if (isHeldByCurrentTask(fsMutex)) {
+    if (isHeldByCurrentTask(fsMutex) || fsSharedHeldByCurrentTask()) {
       // Debug: uncomment to trace reentrant calls
       // Serial.printf("[MUTEX] FsLockGuard reentry (owner=%s)\n", owner ? owner : "");
       return;
     }
     if (xSemaphoreTake(fsMutex, portMAX_DELAY) == pdTRUE) {
       held = true;
+      fsWaitForSharedDrain();
     }
   }
 }
@@ -97,8 +341,9 @@ FsLockGuard::~FsLockGuard() {
 
 // Manual lock/unlock
 void fsLock(const char* owner) {
-  if (fsMutex && !isHeldByCurrentTask(fsMutex)) {
+  if (fsMutex && !isHeldByCurrentTask(fsMutex) && !fsSharedHeldByCurrentTask()) {
     xSemaphoreTake(fsMutex, portMAX_DELAY);
+    fsWaitForSharedDrain();
   }
 }
 
@@ -241,3 +486,24 @@ TopoStreamsGuard::~TopoStreamsGuard() {
   }
 }
 
+
+// ============================================================================
+// MapCacheGuard Implementation
+// ============================================================================
+
+MapCacheGuard::MapCacheGuard(const char* owner) : held(false) {
+  if (gMapCacheMutex) {
+    if (isHeldByCurrentTask(gMapCacheMutex)) {
+      return;
+    }
+    if (xSemaphoreTake(gMapCacheMutex, portMAX_DELAY) == pdTRUE) {
+      held = true;
+    }
+  }
+}
+
+MapCacheGuard::~MapCacheGuard() {
+  if (held && gMapCacheMutex) {
+    xSemaphoreGive(gMapCacheMutex);
+  }
+}
@@ -11,6 +11,7 @@
 #include <Arduino.h>
 #include <freertos/FreeRTOS.h>
 #include <freertos/semphr.h>
+#include <freertos/event_groups.h>
 
 // ============================================================================
 // Global Mutexes (created by initMutexes() in setup())
@@ -152,6 +153,76 @@ struct TopoStreamsGuard {
   TopoStreamsGuard& operator=(const TopoStreamsGuard&) = delete;
 };
 
+// Map tile cache mutex - protects MapCore's tile cache slots, their per-slot
+// indexes (feature refs, LOD, segment grid) and map load/unload
+extern SemaphoreHandle_t gMapCacheMutex;
+
+/**
+ * MapCacheGuard - RAII guard for the map tile cache
+ * 
+ * Hold it from MapCore::loadTileData() until the tile bytes and any index
+ * built for that slot are no longer used: another task's cache miss may evict
+ * the slot and free its indexes. Reentrant for the owning task. Take it before
+ * any filesystem guard (tile misses lock the map file inside).
+ */
+struct MapCacheGuard {
+  bool held;
+  explicit MapCacheGuard(const char* owner = nullptr);
+  ~MapCacheGuard();
+  
+  MapCacheGuard(const MapCacheGuard&) = delete;
+  MapCacheGuard& operator=(const MapCacheGuard&) = delete;
+};
+
+// ============================================================================
+// Per-Path Filesystem Locks
+// ============================================================================
+// Reader/writer locks keyed by file path. Operations on different paths run
+// concurrently (LittleFS serializes individual VFS calls internally); readers of
+// the same path share, writers are exclusive per path.
+//
+// Path guards hold the global fsMutex in *shared* mode: legacy fsLock()/FsLockGuard
+// users remain exclusive against everything, so unconverted code keeps its old
+// guarantees. Reentrant for the owning task (write implies read). Do not try to
+// upgrade a read guard to a write guard on the same path. Paths are keyed in
+// their VFS::normalize() form, so raw, decoded and normalized spellings of one
+// file share the same lock.
+//
+// Usage:
+//   {
+//     FsPathReadGuard guard(path);
+//     File f = LittleFS.open(path, "r");
+//     // ... a slow download does not block settings saves or log appends ...
+//   }
+
+#define FS_PATH_LOCK_SLOTS 16   // Max distinct paths locked at once
+
+struct FsPathReadGuard {
+  bool held;
+  uint32_t key;
+  explicit FsPathReadGuard(const char* path);
+  explicit FsPathReadGuard(const String& path) : FsPathReadGuard(path.c_str()) {}
+  ~FsPathReadGuard();
+
+  FsPathReadGuard(const FsPathReadGuard&) = delete;
+  FsPathReadGuard& operator=(const FsPathReadGuard&) = delete;
+};
+
+struct FsPathWriteGuard {
+  bool held;
+  uint32_t key;
+  explicit FsPathWriteGuard(const char* path);
+  explicit FsPathWriteGuard(const String& path) : FsPathWriteGuard(path.c_str()) {}
+  ~FsPathWriteGuard();
+
+  FsPathWriteGuard(const FsPathWriteGuard&) = delete;
+  FsPathWriteGuard& operator=(const FsPathWriteGuard&) = delete;
+};
+
+// Manual per-path lock/unlock (returns false if the lock table is exhausted)
+bool fsPathLock(const char* path, bool write);
+void fsPathUnlock(const char* path, bool write);
+
 // ============================================================================
 // Helper Functions
 // ============================================================================
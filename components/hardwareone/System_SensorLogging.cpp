@@ -477,7 +477,9 @@ void sensorLogTick() {
       line = buildFromSnap(snap);
     }
     if (line && line[0] != '\0') {
-      fsLock("sensorlog.append");
+      // Per-path lock (covers rotation of <path>.N, which only the logger touches)
+      String lockedPath = gSensorLogPath;
+      bool pathLocked = fsPathLock(lockedPath.c_str(), true);
       File f = LittleFS.open(gSensorLogPath.c_str(), "a");
       if (f) {
         size_t len = strlen(line);
@@ -546,7 +548,7 @@ void sensorLogTick() {
           DEBUG_LOGGERF("logger: open fail #%u", (unsigned)log_open_fail);
         }
       }
-      fsUnlock();
+      if (pathLocked) fsPathUnlock(lockedPath.c_str(), true);
     }
 
     // Periodic summary
@@ -8,10 +8,12 @@
   #include "System_ESPNow.h" // EspNowMode enum
 #endif
 #include "System_MemUtil.h"  // PSRAM_JSON_DOC macro
+#include "System_Mutex.h"    // FsLockGuard
 #include "System_SensorStubs.h" // Network stubs when disabled
 #include "System_Utils.h"    // RETURN_VALID_IF_VALIDATE_CSTR macro
 #include "System_Command.h"
 #include "System_Notifications.h"
+#include "WebServer_ResponseCache.h"  // respCacheInvalidate
 #include <LittleFS.h>
 #include <esp_system.h>
 #include <esp_app_desc.h>
@@ -744,15 +746,8 @@ void buildSettingsJsonDoc(JsonDocument& doc, bool excludePasswords) {
   // NOTE: webCliHistorySize/oledCliHistorySize -> cli module
   // NOTE: wifiEnabled and all wifi settings -> wifi module
 
-  // wifiPrimarySSID: runtime-only convenience field for web UI (not saved, not a setting)
-#if ENABLE_WIFI
-  {
-    String cur = WiFi.SSID();
-    if (cur.length() > 0) {
-      doc["wifiPrimarySSID"] = cur;
-    }
-  }
-#endif
+  // NOTE: the web UI's wifiPrimarySSID is live radio state, added per request by
+  //       handleSettingsGet (this doc is cached until the next settings save)
 
   // NOTE: ntpServer, tzOffsetMinutes, wifiSSID, wifiPassword, wifiAutoReconnect
   //       are owned by the wifi module (written under "wifi" section).
@@ -821,60 +816,112 @@ void buildSettingsJsonDoc(JsonDocument& doc, bool excludePasswords) {
 }
 
 // ============================================================================
-// Write Settings to JSON File
+// Settings Persistence (in-memory document + debounced dirty-module saves)
 // ============================================================================
+// The last document read from / written to settings.json is kept in PSRAM so a
+// save never re-reads the file. Orphaned sections (settings of sensors compiled
+// out of this build) live on in that document untouched. setSetting() only marks
+// the owning SettingsModule dirty; settingsSaveTick() coalesces a burst of edits
+// into one write once they have been quiet for SETTINGS_SAVE_DEBOUNCE_MS, and the
+// write is skipped entirely when the plaintext content hash is unchanged.
+
+static JsonDocument* gSettingsDoc = nullptr;          // Authoritative on-disk image
+static bool gSettingsDocLoaded = false;               // gSettingsDoc mirrors settings.json
+static volatile uint32_t gSettingsDirtyModules = 0;   // Bit per gSettingsModules[] index
+static volatile bool gSettingsDirtyAll = false;       // Unknown field / explicit full save
+static volatile unsigned long gSettingsSaveDueMs = 0; // 0 = nothing pending
+static uint32_t gSettingsPersistedHash = 0;           // Hash of last content written (0 = unknown)
+static uint32_t gSettingsWriteCount = 0;
+static uint32_t gSettingsSkipCount = 0;
+static portMUX_TYPE sSettingsDirtyMux = portMUX_INITIALIZER_UNLOCKED;
+
+static JsonDocument& settingsDoc() {
+  if (!gSettingsDoc) {
+    void* mem = ps_alloc(sizeof(JsonDocument), AllocPref::PreferPSRAM, "settings.doc");
+    gSettingsDoc = mem ? new (mem) JsonDocument(psramJsonAllocator()) : new JsonDocument(psramJsonAllocator());
+  }
+  return *gSettingsDoc;
+}
 
-bool writeSettingsJson() {
-  if (!filesystemReady) return false;
-
-  // Pause sensor polling during settings I/O
-  extern volatile bool gSensorPollingPaused;
-  bool wasPaused = gSensorPollingPaused;
-  gSensorPollingPaused = true;
+// FNV-1a over plaintext values (secrets are AES-encrypted with a random IV, so
+// the serialized file is not a stable basis for change detection)
+static inline uint32_t fnv1a(uint32_t h, const void* data, size_t len) {
+  const uint8_t* p = (const uint8_t*)data;
+  for (size_t i = 0; i < len; i++) { h ^= p[i]; h *= 16777619u; }
+  return h;
+}
 
-  DEBUG_STORAGEF("[Settings] Writing to file using ArduinoJson");
+static uint32_t computeSettingsContentHash() {
+  uint32_t h = 2166136261u;
+  size_t modCount = 0;
+  const SettingsModule** mods = getSettingsModules(modCount);
+  for (size_t m = 0; m < modCount; m++) {
+    const SettingsModule* mod = mods[m];
+    if (!mod) continue;
+    for (size_t i = 0; i < mod->count; i++) {
+      const SettingEntry* e = &mod->entries[i];
+      if (!e->valuePtr) continue;
+      switch (e->type) {
+        case SETTING_INT:   h = fnv1a(h, e->valuePtr, sizeof(int)); break;
+        case SETTING_FLOAT: h = fnv1a(h, e->valuePtr, sizeof(float)); break;
+        case SETTING_BOOL:  h = fnv1a(h, e->valuePtr, sizeof(bool)); break;
+        case SETTING_STRING: {
+          const String* s = (const String*)e->valuePtr;
+          h = fnv1a(h, s->c_str(), s->length() + 1);
+          break;
+        }
+      }
+    }
+  }
+  if (gWifiNetworks) {
+    for (int i = 0; i < gWifiNetworkCount; i++) {
+      const WifiNetwork& n = gWifiNetworks[i];
+      h = fnv1a(h, n.ssid.c_str(), n.ssid.length() + 1);
+      h = fnv1a(h, n.password.c_str(), n.password.length() + 1);
+      h = fnv1a(h, &n.priority, sizeof(n.priority));
+      h = fnv1a(h, &n.hidden, sizeof(n.hidden));
+      h = fnv1a(h, &n.lastConnected, sizeof(n.lastConnected));
+    }
+  }
+  return h ? h : 1;
+}
 
-  // Build JSON document (5120 bytes for settings + encrypted WiFi passwords)
-  PSRAM_JSON_DOC(doc);
-  
-  // CRITICAL: Read existing settings first to preserve orphaned sensor sections
-  // This allows settings from disabled sensors to persist and show as grayed-out in UI
-  if (LittleFS.exists(SETTINGS_JSON_FILE)) {
-    fsLock("settings.read_for_merge");
-    File existingFile = LittleFS.open(SETTINGS_JSON_FILE, "r");
-    if (existingFile) {
-      DeserializationError err = deserializeJson(doc, existingFile);
-      existingFile.close();
-      if (err) {
-        WARN_STORAGEF("Failed to read existing settings for merge: %s", err.c_str());
-        doc.clear();  // Start fresh if parse failed
-      } else {
-        INFO_STORAGEF("Loaded existing settings for merge (preserving orphaned sections)");
+void markSettingsDirty(const void* field) {
+  uint32_t bit = 0;
+  if (field) {
+    size_t modCount = 0;
+    const SettingsModule** mods = getSettingsModules(modCount);
+    for (size_t m = 0; m < modCount && !bit; m++) {
+      for (size_t i = 0; i < mods[m]->count; i++) {
+        if (mods[m]->entries[i].valuePtr == field) { bit = 1UL << m; break; }
       }
     }
-    fsUnlock();
   }
-  
-  // Now build/overwrite with current settings (orphaned sections remain untouched)
-  buildSettingsJsonDoc(doc);
 
-  // Remove runtime-only fields that must never be persisted to disk
-  doc.remove("wifiPrimarySSID");
+  portENTER_CRITICAL(&sSettingsDirtyMux);
+  if (bit) gSettingsDirtyModules |= bit;
+  else gSettingsDirtyAll = true;
+  unsigned long due = millis() + SETTINGS_SAVE_DEBOUNCE_MS;
+  gSettingsSaveDueMs = due ? due : 1;
+  portEXIT_CRITICAL(&sSettingsDirtyMux);
 
-  // Check for overflow
-  if (doc.overflowed()) {
-    ERROR_STORAGEF("JSON document overflowed during build (need more than 5120 bytes)");
-    gSensorPollingPaused = wasPaused;
-    return false;
-  }
+  respCacheInvalidate(RESP_SRC_SETTINGS);
+}
+
+// Serialize the in-memory document and replace settings.json atomically.
+// Caller holds the settings.json path lock; the temp file gets its own so no
+// other writer of that path can interleave with the staging write and rename.
+// Sensor polling is paused only for the flash write.
+static bool persistSettingsDoc(JsonDocument& doc) {
+  extern volatile bool gSensorPollingPaused;
+  bool wasPaused = gSensorPollingPaused;
+  gSensorPollingPaused = true;
 
   // Atomic write: temp file then rename
   const char* tmp = "/settings.tmp";
-  
-  fsLock("settings.write");
+  FsPathWriteGuard tmpGuard(tmp);
   File file = LittleFS.open(tmp, "w");
   if (!file) {
-    fsUnlock();
     ERROR_STORAGEF("Failed to open temp file for writing");
     gSensorPollingPaused = wasPaused;
     return false;
@@ -883,7 +930,6 @@ bool writeSettingsJson() {
   // Serialize JSON directly to file (no intermediate buffer)
   size_t bytesWritten = serializeJson(doc, file);
   file.close();
-  fsUnlock();
 
   if (bytesWritten == 0) {
     ERROR_STORAGEF("Failed to serialize JSON");
@@ -894,29 +940,98 @@ bool writeSettingsJson() {
   DEBUG_STORAGEF("[Settings] Wrote %zu bytes to temp file", bytesWritten);
 
   // Atomic rename
-  fsLock("settings.rename");
   LittleFS.remove(SETTINGS_JSON_FILE);
-  bool okRename = LittleFS.rename(tmp, SETTINGS_JSON_FILE);
-  fsUnlock();
-
-  if (!okRename) {
+  if (!LittleFS.rename(tmp, SETTINGS_JSON_FILE)) {
     WARN_STORAGEF("Rename failed, trying direct write");
     // Fallback: write directly
-    fsLock("settings.direct");
     File directFile = LittleFS.open(SETTINGS_JSON_FILE, "w");
     if (!directFile) {
-      fsUnlock();
       gSensorPollingPaused = wasPaused;
       return false;
     }
     serializeJson(doc, directFile);
     directFile.close();
-    fsUnlock();
   }
 
-  DEBUG_STORAGEF("[Settings] Write complete");
   gSensorPollingPaused = wasPaused;
-  
+  return true;
+}
+
+static bool flushSettings(bool fullRebuild) {
+  if (!filesystemReady) return false;
+
+  FsPathWriteGuard guard(SETTINGS_JSON_FILE);
+
+  uint32_t dirtyMods;
+  bool dirtyAll;
+  portENTER_CRITICAL(&sSettingsDirtyMux);
+  dirtyMods = gSettingsDirtyModules;
+  dirtyAll = gSettingsDirtyAll || fullRebuild;
+  gSettingsDirtyModules = 0;
+  gSettingsDirtyAll = false;
+  gSettingsSaveDueMs = 0;
+  portEXIT_CRITICAL(&sSettingsDirtyMux);
+
+  uint32_t hash = computeSettingsContentHash();
+  if (gSettingsDocLoaded && hash == gSettingsPersistedHash) {
+    gSettingsSkipCount++;
+    DEBUG_STORAGEF("[Settings] Content unchanged - write skipped");
+    return true;
+  }
+
+  JsonDocument& cached = settingsDoc();
+
+  // One-time fallback when boot never loaded the file (e.g. parse failure): merge
+  // whatever is on disk so orphaned sections are not lost on the first save
+  if (!gSettingsDocLoaded && LittleFS.exists(SETTINGS_JSON_FILE)) {
+    File existingFile = LittleFS.open(SETTINGS_JSON_FILE, "r");
+    if (existingFile) {
+      DeserializationError err = deserializeJson(cached, existingFile);
+      existingFile.close();
+      if (err) {
+        WARN_STORAGEF("Failed to read existing settings for merge: %s", err.c_str());
+        cached.clear();
+      }
+    }
+    dirtyAll = true;
+  }
+  if (!gSettingsDocLoaded) dirtyAll = true;
+
+  // Work on a copy so the cached image stays compact (ArduinoJson does not
+  // reclaim pool space for overwritten values)
+  PSRAM_JSON_DOC(doc);
+  doc.set(cached);
+
+  if (dirtyAll) {
+    buildSettingsJsonDoc(doc);
+  } else {
+    size_t modCount = 0;
+    const SettingsModule** mods = getSettingsModules(modCount);
+    for (size_t m = 0; m < modCount; m++) {
+      if (dirtyMods & (1UL << m)) {
+        size_t n = writeRegisteredSettingsModule(doc, mods[m]);
+        DEBUG_STORAGEF("[Settings] Rebuilt module '%s' (%zu settings)", mods[m]->name, n);
+      }
+    }
+    doc["firmwareVersion"] = esp_app_get_description()->version;
+  }
+
+  // Check for overflow
+  if (doc.overflowed()) {
+    ERROR_STORAGEF("JSON document overflowed during build");
+    return false;
+  }
+
+  if (!persistSettingsDoc(doc)) return false;
+
+  cached.set(doc);
+  gSettingsDocLoaded = true;
+  gSettingsPersistedHash = hash;
+  gSettingsWriteCount++;
+  DEBUG_STORAGEF("[Settings] Write complete (%s, writes=%lu skipped=%lu)",
+                 dirtyAll ? "full" : "modules", (unsigned long)gSettingsWriteCount,
+                 (unsigned long)gSettingsSkipCount);
+
   // Recompute local settings hash so bond heartbeats reflect the change
 #if ENABLE_ESPNOW && ENABLE_BONDED_MODE
   { extern void computeBondLocalSettingsHash(); computeBondLocalSettingsHash(); }
@@ -925,6 +1040,30 @@ bool writeSettingsJson() {
   return true;
 }
 
+// ============================================================================
+// Write Settings to JSON File
+// ============================================================================
+
+bool writeSettingsJson() {
+  // Explicit save: callers may have mutated gSettings/gWifiNetworks directly,
+  // so rebuild every section rather than trusting the dirty set
+  DEBUG_STORAGEF("[Settings] Writing to file using ArduinoJson");
+  respCacheInvalidate(RESP_SRC_SETTINGS);
+  return flushSettings(true);
+}
+
+void settingsSaveTick() {
+  unsigned long due = gSettingsSaveDueMs;
+  if (due == 0 || gDeferWrites) return;
+  if ((long)(millis() - due) < 0) return;
+  flushSettings(false);
+}
+
+bool flushPendingSettings() {
+  if (gSettingsSaveDueMs == 0) return true;
+  return flushSettings(false);
+}
+
 // ============================================================================
 // Read Settings from JSON File
 // ============================================================================
@@ -1040,6 +1179,12 @@ bool readSettingsJson() {
   }
 #endif
 
+  // Keep the parsed document as the authoritative on-disk image for later saves
+  settingsDoc().set(doc);
+  gSettingsDocLoaded = true;
+  gSettingsPersistedHash = computeSettingsContentHash();
+  respCacheInvalidate(RESP_SRC_SETTINGS);
+
   DEBUG_STORAGEF("[Settings] Load complete");
   gSensorPollingPaused = wasPaused;
   return true;
@@ -1599,76 +1744,82 @@ void printSettingsModuleSummary() {
   }
 }
 
-size_t writeRegisteredSettings(JsonDocument& doc) {
+size_t writeRegisteredSettingsModule(JsonDocument& doc, const SettingsModule* mod) {
   size_t count = 0;
-  
-  for (size_t m = 0; m < gSettingsModuleCount; m++) {
-    const SettingsModule* mod = gSettingsModules[m];
-    // Get or create section object if specified
-    // IMPORTANT: Use as<JsonObject>() for root to avoid clearing existing content
-    // Use to<JsonObject>() for named sections to create/replace them
-    JsonObject section = mod->jsonSection
-                           ? doc[mod->jsonSection].to<JsonObject>()
-                           : doc.as<JsonObject>();
-    
-    if (section.isNull()) {
-      ERROR_STORAGEF("Failed to create section for module %s", mod->name);
+  if (!mod) return 0;
+
+  // Get or create section object if specified
+  // IMPORTANT: Use as<JsonObject>() for root to avoid clearing existing content
+  // Use to<JsonObject>() for named sections to create/replace them
+  JsonObject section = mod->jsonSection
+                         ? doc[mod->jsonSection].to<JsonObject>()
+                         : doc.as<JsonObject>();
+
+  if (section.isNull()) {
+    ERROR_STORAGEF("Failed to create section for module %s", mod->name);
+    return 0;
+  }
+
+  for (size_t i = 0; i < mod->count; i++) {
+    const SettingEntry* e = &mod->entries[i];
+
+    // Check for null pointer before dereferencing
+    if (!e->valuePtr) {
+      ERROR_STORAGEF("Null pointer for setting %s", e->jsonKey);
       continue;
     }
-    
-    for (size_t i = 0; i < mod->count; i++) {
-      const SettingEntry* e = &mod->entries[i];
-      
-      // Check for null pointer before dereferencing
-      if (!e->valuePtr) {
-        ERROR_STORAGEF("Null pointer for setting %s", e->jsonKey);
-        continue;
-      }
-      
-      // Navigate to group sub-object if specified
-      JsonObject target = section;
-      if (e->group) {
-        JsonObject groupObj = target[e->group].as<JsonObject>();
-        if (groupObj.isNull()) {
-          groupObj = target[e->group].to<JsonObject>();
-        }
-        target = groupObj;
+
+    // Navigate to group sub-object if specified
+    JsonObject target = section;
+    if (e->group) {
+      JsonObject groupObj = target[e->group].as<JsonObject>();
+      if (groupObj.isNull()) {
+        groupObj = target[e->group].to<JsonObject>();
       }
-      const char* leaf = e->jsonKey;
-      
-      switch (e->type) {
-        case SETTING_INT:
-          target[leaf] = *((int*)e->valuePtr);
-          count++;
-          break;
-        case SETTING_FLOAT:
-          target[leaf] = *((float*)e->valuePtr);
-          count++;
-          break;
-        case SETTING_BOOL:
-          target[leaf] = *((bool*)e->valuePtr);
-          count++;
-          break;
-        case SETTING_STRING:
-          if (e->isSecret) {
-            // Encrypt secret strings before writing to disk
-            String plaintext = *((String*)e->valuePtr);
-            if (plaintext.length() > 0) {
-              target[leaf] = encryptString(plaintext);
-            } else {
-              target[leaf] = "";
-            }
+      target = groupObj;
+    }
+    const char* leaf = e->jsonKey;
+
+    switch (e->type) {
+      case SETTING_INT:
+        target[leaf] = *((int*)e->valuePtr);
+        count++;
+        break;
+      case SETTING_FLOAT:
+        target[leaf] = *((float*)e->valuePtr);
+        count++;
+        break;
+      case SETTING_BOOL:
+        target[leaf] = *((bool*)e->valuePtr);
+        count++;
+        break;
+      case SETTING_STRING:
+        if (e->isSecret) {
+          // Encrypt secret strings before writing to disk
+          String plaintext = *((String*)e->valuePtr);
+          if (plaintext.length() > 0) {
+            target[leaf] = encryptString(plaintext);
           } else {
-            target[leaf] = *((String*)e->valuePtr);
+            target[leaf] = "";
           }
-          count++;
-          break;
-      }
+        } else {
+          target[leaf] = *((String*)e->valuePtr);
+        }
+        count++;
+        break;
     }
   }
   return count;
 }
 
+size_t writeRegisteredSettings(JsonDocument& doc) {
+  size_t count = 0;
+  for (size_t m = 0; m < gSettingsModuleCount; m++) {
+    count += writeRegisteredSettingsModule(doc, gSettingsModules[m]);
+  }
+  return count;
+}
+
 const char* handleSettingCommand(const SettingEntry* entry, const String& argsInput) {
   RETURN_VALID_IF_VALIDATE_CSTR();
   
@@ -1712,7 +1863,7 @@ const char* handleSettingCommand(const SettingEntry* entry, const String& argsIn
         }
       }
       *((int*)entry->valuePtr) = v;
-      if (!gDeferWrites) writeSettingsJson();
+      if (!gDeferWrites) markSettingsDirty(entry->valuePtr);
       BROADCAST_PRINTF("%s set to %d", entry->jsonKey, v);
       { char vBuf[16]; snprintf(vBuf, sizeof(vBuf), "%d", v); notifySettingChanged(entry->label ? entry->label : entry->jsonKey, vBuf); }
       return "[Settings] Configuration updated";
@@ -1727,7 +1878,7 @@ const char* handleSettingCommand(const SettingEntry* entry, const String& argsIn
         }
       }
       *((float*)entry->valuePtr) = f;
-      if (!gDeferWrites) writeSettingsJson();
+      if (!gDeferWrites) markSettingsDirty(entry->valuePtr);
       BROADCAST_PRINTF("%s set to %.3f", entry->jsonKey, f);
       { char vBuf[16]; snprintf(vBuf, sizeof(vBuf), "%.3f", f); notifySettingChanged(entry->label ? entry->label : entry->jsonKey, vBuf); }
       return "[Settings] Configuration updated";
@@ -1735,14 +1886,14 @@ const char* handleSettingCommand(const SettingEntry* entry, const String& argsIn
     case SETTING_BOOL: {
       bool v = (*p == '1' || strncasecmp(p, "true", 4) == 0);
       *((bool*)entry->valuePtr) = v;
-      if (!gDeferWrites) writeSettingsJson();
+      if (!gDeferWrites) markSettingsDirty(entry->valuePtr);
       BROADCAST_PRINTF("%s set to %s", entry->jsonKey, v ? "true" : "false");
       notifySettingChanged(entry->label ? entry->label : entry->jsonKey, v ? "on" : "off");
       return "[Settings] Configuration updated";
     }
     case SETTING_STRING: {
       *((String*)entry->valuePtr) = p;
-      if (!gDeferWrites) writeSettingsJson();
+      if (!gDeferWrites) markSettingsDirty(entry->valuePtr);
       if (entry->isSecret) {
         BROADCAST_PRINTF("%s updated", entry->jsonKey);
         notifySettingChanged(entry->label ? entry->label : entry->jsonKey, "********");
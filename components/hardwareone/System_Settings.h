@@ -634,20 +634,34 @@ void applySettings();
 // Centralized Setting Mutator — auto-persists on change
 // ============================================================================
 // Use setSetting(gSettings.field, newValue) instead of direct assignment
-// to ensure writeSettingsJson() is called automatically.
-// Only writes to flash when the value actually changes (no churn).
+// to ensure the change is persisted automatically.
+// Only marks the owning module dirty when the value actually changes (no churn);
+// settingsSaveTick() writes once edits have been quiet for SETTINGS_SAVE_DEBOUNCE_MS,
+// and skips the write when the content matches what is already on flash.
 //
 // Batch mode: call beginwrite before a group of setSetting() calls, then
 // savesettings after. This defers the flash write to a single call at the end.
 // From the web UI, save buttons use this pattern automatically.
-// From the serial CLI, each setSetting() writes immediately as before.
+// writeSettingsJson() still saves immediately (full rebuild, no debounce).
 extern volatile bool gDeferWrites;
 
+#define SETTINGS_SAVE_DEBOUNCE_MS 750
+
+// Mark the module owning 'field' dirty and (re)arm the debounced save.
+// nullptr or an unregistered field marks every section dirty.
+void markSettingsDirty(const void* field = nullptr);
+
+// Main-loop hook: performs the debounced save when due
+void settingsSaveTick();
+
+// Write any pending debounced changes now (call before reboot/deep sleep)
+bool flushPendingSettings();
+
 template<typename T>
 inline void setSetting(T& field, const T& value) {
   if (field != value) {
     field = value;
-    if (!gDeferWrites) writeSettingsJson();
+    if (!gDeferWrites) markSettingsDirty(&field);
   }
 }
 
@@ -655,7 +669,7 @@ inline void setSetting(T& field, const T& value) {
 inline void setSetting(String& field, const String& value) {
   if (field != value) {
     field = value;
-    if (!gDeferWrites) writeSettingsJson();
+    if (!gDeferWrites) markSettingsDirty(&field);
   }
 }
 
@@ -663,7 +677,7 @@ inline void setSetting(String& field, const String& value) {
 inline void setSetting(String& field, const char* value) {
   if (field != value) {
     field = value;
-    if (!gDeferWrites) writeSettingsJson();
+    if (!gDeferWrites) markSettingsDirty(&field);
   }
 }
 
@@ -788,6 +802,9 @@ size_t readRegisteredSettings(JsonDocument& doc);
 // Returns number of settings written
 size_t writeRegisteredSettings(JsonDocument& doc);
 
+// Write (replace) a single module's section; returns number of settings written
+size_t writeRegisteredSettingsModule(JsonDocument& doc, const SettingsModule* module);
+
 // Register ALL settings modules explicitly (called once early in boot)
 // Ensures all compiled modules are available before applying defaults
 void registerAllSettingsModules();
@@ -18,6 +18,9 @@ constexpr uint32_t TOF_STACK_WORDS = 3072;           // ~12KB
 constexpr uint32_t FMRADIO_STACK_WORDS = 4608;       // ~18KB
 constexpr uint32_t GAMEPAD_STACK_WORDS = 3584;       // ~14KB
 constexpr uint32_t DEBUG_OUT_STACK_WORDS = 3072;     // ~12KB
+constexpr uint32_t DEBUG_SINK_STACK_WORDS = 2560;    // ~10KB (per slow debug sink: serial/file/G2)
+constexpr uint32_t FS_ASYNC_STACK_WORDS = 3072;      // ~12KB (chunked file I/O + completion callbacks)
+constexpr uint32_t AUDIO_CAPTURE_STACK_WORDS = 2560; // ~10KB (I2S reads straight into the PSRAM ring)
 constexpr uint32_t APDS_STACK_WORDS = 3072;          // ~12KB
 constexpr uint32_t GPS_STACK_WORDS = 3072;           // ~12KB
 constexpr uint32_t PRESENCE_STACK_WORDS = 3072;      // ~12KB
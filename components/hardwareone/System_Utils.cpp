@@ -125,6 +125,7 @@ void secureClearString(String& s) {
 #include "System_Mutex.h"   // For FsLockGuard
 #include "System_I2C.h"     // For I2CSensorEntry, ConnectedDevice, MAX_CONNECTED_DEVICES
 #include "System_MemUtil.h"       // For AllocPref
+#include "WebServer_ResponseCache.h"  // respCacheInvalidate
 
 // Extern declarations for logging functions (implemented in .ino)
 extern bool appendLineWithCap(const char* path, const String& line, size_t capBytes);
@@ -322,85 +323,201 @@ String base64Decode(const String& input) {
 // JSON Parsing Helpers (moved from .ino)
 // ============================================================================
 
-bool parseJsonBool(const String& src, const char* key, bool& out) {
-  char kBuf[64];
-  snprintf(kBuf, sizeof(kBuf), "\"%s\":", key);
-  int p = src.indexOf(kBuf);
-  if (p < 0) return false;
-  p += strlen(kBuf);
-  while (p < (int)src.length() && src[p] == ' ') p++;
-  if (p >= (int)src.length()) return false;
-  if (src.startsWith("true", p)) {
-    out = true;
-    return true;
+// Single-pass field extractor. Walks the document once, tracking object/array
+// nesting and string boundaries, and resolves every requested key on its first
+// occurrence (at any depth, like the indexOf()-based helpers it replaces).
+// Results are spans into the source text; nothing is allocated.
+
+static inline bool jsonIsSpace(char c) {
+  return c == ' ' || c == '\t' || c == '\n' || c == '\r';
+}
+
+// Returns index of the closing quote for a string whose opening quote is at
+// `open`, honouring backslash escapes. Returns len if unterminated.
+static size_t jsonSkipString(const char* s, size_t len, size_t open) {
+  size_t i = open + 1;
+  while (i < len) {
+    char c = s[i];
+    if (c == '\\') { i += 2; continue; }
+    if (c == '"') return i;
+    i++;
   }
-  if (src.startsWith("false", p)) {
-    out = false;
-    return true;
+  return len;
+}
+
+static bool jsonParseSlotScalar(const char* s, size_t len, size_t p, JsonFieldSlot& slot) {
+  char num[24];
+  switch (slot.type) {
+    case JSON_FIELD_BOOL:
+      if (p + 4 <= len && memcmp(s + p, "true", 4) == 0) { slot.b = true; return true; }
+      if (p + 5 <= len && memcmp(s + p, "false", 5) == 0) { slot.b = false; return true; }
+      if (s[p] == '1') { slot.b = true; return true; }
+      if (s[p] == '0') { slot.b = false; return true; }
+      return false;
+
+    case JSON_FIELD_INT: {
+      size_t end = p;
+      while (end < len && ((s[end] >= '0' && s[end] <= '9') || s[end] == '-')) end++;
+      if (end == p) return false;
+      size_t n = end - p;
+      if (n >= sizeof(num)) n = sizeof(num) - 1;
+      memcpy(num, s + p, n);
+      num[n] = '\0';
+      slot.i = atol(num);
+      return true;
+    }
+
+    case JSON_FIELD_FLOAT: {
+      bool seenDigit = false, seenDot = false;
+      size_t end = p;
+      while (end < len) {
+        char c = s[end];
+        if (c >= '0' && c <= '9') { seenDigit = true; end++; continue; }
+        if (c == '-' && end == p) { end++; continue; }
+        if (c == '.' && !seenDot) { seenDot = true; end++; continue; }
+        break;
+      }
+      if (!seenDigit) return false;
+      size_t n = end - p;
+      if (n >= sizeof(num)) n = sizeof(num) - 1;
+      memcpy(num, s + p, n);
+      num[n] = '\0';
+      slot.f = (float)atof(num);
+      return true;
+    }
+
+    case JSON_FIELD_STRING: {
+      if (s[p] != '"') return false;
+      size_t close = jsonSkipString(s, len, p);
+      if (close >= len) return false;
+      slot.start = p + 1;
+      slot.len = close - p - 1;
+      return true;
+    }
+
+    default:
+      return false;
   }
-  if (src[p] == '1') {
-    out = true;
-    return true;
+}
+
+size_t jsonExtractFields(const char* s, size_t len, JsonFieldSlot* slots, size_t count) {
+  if (!s || !slots || count == 0) return 0;
+
+  // Per-slot state: 0 = unseen, 1 = container open (awaiting close), 2 = done
+  uint8_t state[JSON_FIELD_MAX_SLOTS];
+  uint8_t openDepth[JSON_FIELD_MAX_SLOTS];
+  if (count > JSON_FIELD_MAX_SLOTS) count = JSON_FIELD_MAX_SLOTS;
+  for (size_t k = 0; k < count; ++k) {
+    slots[k].found = false;
+    slots[k].start = 0;
+    slots[k].len = 0;
+    state[k] = 0;
   }
-  if (src[p] == '0') {
-    out = false;
-    return true;
+
+  size_t remaining = count;  // slots not yet done
+  size_t found = 0;
+  uint32_t objMask = 0;      // bit n set => nesting level n+1 is an object
+  uint8_t depth = 0;
+  bool expectKey = false;
+  size_t i = 0;
+
+  while (i < len && remaining > 0) {
+    char c = s[i];
+    if (c == '{' || c == '[') {
+      if (depth < 32) {
+        if (c == '{') objMask |= (1u << depth);
+        else objMask &= ~(1u << depth);
+      }
+      depth++;
+      expectKey = (c == '{');
+      i++;
+    } else if (c == '}' || c == ']') {
+      // Close any container slot that opened at this depth
+      for (size_t k = 0; k < count; ++k) {
+        if (state[k] == 1 && openDepth[k] == depth) {
+          slots[k].len = i + 1 - slots[k].start;
+          slots[k].found = true;
+          state[k] = 2;
+          remaining--;
+          found++;
+        }
+      }
+      if (depth > 0) depth--;
+      expectKey = false;
+      i++;
+    } else if (c == ',') {
+      expectKey = depth > 0 && depth <= 32 && (objMask & (1u << (depth - 1)));
+      i++;
+    } else if (c == '"') {
+      size_t close = jsonSkipString(s, len, i);
+      if (close >= len) break;
+      if (expectKey) {
+        size_t keyStart = i + 1;
+        size_t keyLen = close - keyStart;
+        size_t p = close + 1;
+        while (p < len && jsonIsSpace(s[p])) p++;
+        if (p < len && s[p] == ':') {
+          p++;
+          while (p < len && jsonIsSpace(s[p])) p++;
+          for (size_t k = 0; k < count; ++k) {
+            if (state[k] != 0 || !slots[k].key) continue;
+            if (strlen(slots[k].key) != keyLen || memcmp(slots[k].key, s + keyStart, keyLen) != 0) continue;
+            // First occurrence decides the slot, whether or not the value matches its type
+            JsonFieldType t = slots[k].type;
+            if (p < len && ((t == JSON_FIELD_OBJECT && s[p] == '{') || (t == JSON_FIELD_ARRAY && s[p] == '['))) {
+              slots[k].start = p;
+              openDepth[k] = depth + 1;
+              state[k] = 1;
+              continue;
+            }
+            if (p < len && jsonParseSlotScalar(s, len, p, slots[k])) {
+              slots[k].found = true;
+              found++;
+            }
+            state[k] = 2;
+            remaining--;
+          }
+        }
+        i = p;
+        expectKey = false;
+        continue;
+      }
+      i = close + 1;
+    } else {
+      i++;
+    }
   }
-  return false;
+  return found;
+}
+
+size_t jsonExtractFields(const String& src, JsonFieldSlot* slots, size_t count) {
+  return jsonExtractFields(src.c_str(), src.length(), slots, count);
+}
+
+static bool jsonFindOne(const String& src, const char* key, JsonFieldType type, JsonFieldSlot& slot) {
+  slot.key = key;
+  slot.type = type;
+  return jsonExtractFields(src, &slot, 1) == 1;
+}
+
+bool parseJsonBool(const String& src, const char* key, bool& out) {
+  JsonFieldSlot slot;
+  if (!jsonFindOne(src, key, JSON_FIELD_BOOL, slot)) return false;
+  out = slot.b;
+  return true;
 }
 
 bool parseJsonInt(const String& src, const char* key, int& out) {
-  char kBuf[64];
-  snprintf(kBuf, sizeof(kBuf), "\"%s\":", key);
-  int p = src.indexOf(kBuf);
-  if (p < 0) return false;
-  p += strlen(kBuf);
-  while (p < (int)src.length() && src[p] == ' ') p++;
-  if (p >= (int)src.length()) return false;
-  int end = p;
-  while (end < (int)src.length()) {
-    char c = src[end];
-    if ((c >= '0' && c <= '9') || c == '-') {
-      end++;
-      continue;
-    }
-    break;
-  }
-  if (end == p) return false;
-  out = src.substring(p, end).toInt();
+  JsonFieldSlot slot;
+  if (!jsonFindOne(src, key, JSON_FIELD_INT, slot)) return false;
+  out = (int)slot.i;
   return true;
 }
 
 bool parseJsonFloat(const String& src, const char* key, float& out) {
-  char kBuf[64];
-  snprintf(kBuf, sizeof(kBuf), "\"%s\":", key);
-  int p = src.indexOf(kBuf);
-  if (p < 0) return false;
-  p += strlen(kBuf);
-  while (p < (int)src.length() && src[p] == ' ') p++;
-  if (p >= (int)src.length()) return false;
-  bool seenDigit = false, seenDot = false;
-  int end = p;
-  while (end < (int)src.length()) {
-    char c = src[end];
-    if (c >= '0' && c <= '9') {
-      seenDigit = true;
-      end++;
-      continue;
-    }
-    if (c == '-' && end == p) {
-      end++;
-      continue;
-    }
-    if (c == '.' && !seenDot) {
-      seenDot = true;
-      end++;
-      continue;
-    }
-    break;
-  }
-  if (!seenDigit) return false;
-  out = src.substring(p, end).toFloat();
+  JsonFieldSlot slot;
+  if (!jsonFindOne(src, key, JSON_FIELD_FLOAT, slot)) return false;
+  out = slot.f;
   return true;
 }
 
@@ -412,75 +529,43 @@ bool parseJsonU16(const String& src, const char* key, uint16_t& out) {
 }
 
 bool parseJsonString(const String& src, const char* key, String& out) {
-  char kBuf[64];
-  snprintf(kBuf, sizeof(kBuf), "\"%s\":\"", key);
-  int p = src.indexOf(kBuf);
-  if (p < 0) return false;
-  p += strlen(kBuf);
-  int end = src.indexOf('\"', p);
-  if (end < 0) return false;
-  out = src.substring(p, end);
+  JsonFieldSlot slot;
+  if (!jsonFindOne(src, key, JSON_FIELD_STRING, slot)) return false;
+  out = src.substring(slot.start, slot.start + slot.len);
   return true;
 }
 
 bool extractObjectByKey(const String& src, const char* key, String& outObj) {
-  char kBuf[64];
-  snprintf(kBuf, sizeof(kBuf), "\"%s\"", key);
-  int kLen = strlen(kBuf);
-  int keyPos = src.indexOf(kBuf);
-  if (keyPos < 0) return false;
-  int colon = src.indexOf(':', keyPos + kLen);
-  if (colon < 0) return false;
-  int openBrace = src.indexOf('{', colon);
-  if (openBrace < 0) return false;
-  int depth = 1;
-  int closeBrace = openBrace + 1;
-  while (closeBrace < (int)src.length() && depth > 0) {
-    char c = src[closeBrace];
-    if (c == '{') depth++;
-    else if (c == '}') depth--;
-    closeBrace++;
-  }
-  if (depth != 0) return false;
-  outObj = src.substring(openBrace, closeBrace);
+  JsonFieldSlot slot;
+  if (!jsonFindOne(src, key, JSON_FIELD_OBJECT, slot)) return false;
+  outObj = src.substring(slot.start, slot.start + slot.len);
   return true;
 }
 
 bool extractArrayByKey(const String& src, const char* key, String& outArray) {
-  char kBuf[64];
-  snprintf(kBuf, sizeof(kBuf), "\"%s\"", key);
-  int kLen = strlen(kBuf);
-  int keyPos = src.indexOf(kBuf);
-  if (keyPos < 0) return false;
-  int colon = src.indexOf(':', keyPos + kLen);
-  if (colon < 0) return false;
-  int lb = src.indexOf('[', colon);
-  if (lb < 0) return false;
-  int depth = 0;
-  for (int i = lb; i < (int)src.length(); ++i) {
-    char c = src[i];
-    if (c == '[') depth++;
-    else if (c == ']') {
-      depth--;
-      if (depth == 0) {
-        outArray = src.substring(lb + 1, i);
-        return true;
-      }
-    }
-  }
-  return false;
+  JsonFieldSlot slot;
+  if (!jsonFindOne(src, key, JSON_FIELD_ARRAY, slot)) return false;
+  // Contents only, without the surrounding brackets
+  outArray = src.substring(slot.start + 1, slot.start + slot.len - 1);
+  return true;
 }
 
 bool extractArrayItem(const String& arrayStr, int& pos, String& outItem) {
-  while (pos < arrayStr.length() && (arrayStr[pos] == ' ' || arrayStr[pos] == '\t' || arrayStr[pos] == '\n' || arrayStr[pos] == ',')) {
+  const char* s = arrayStr.c_str();
+  int len = arrayStr.length();
+  while (pos < len && (s[pos] == ' ' || s[pos] == '\t' || s[pos] == '\n' || s[pos] == ',')) {
     pos++;
   }
-  if (pos >= arrayStr.length()) return false;
-  if (arrayStr[pos] == '{') {
+  if (pos >= len) return false;
+  if (s[pos] == '{') {
     int depth = 0;
     int start = pos;
-    for (int i = pos; i < arrayStr.length(); ++i) {
-      char c = arrayStr[i];
+    for (int i = pos; i < len; ++i) {
+      char c = s[i];
+      if (c == '"') {
+        i = (int)jsonSkipString(s, len, i);
+        continue;
+      }
       if (c == '{') depth++;
       else if (c == '}') {
         depth--;
@@ -704,7 +789,7 @@ bool readText(const char* path, String& out) {
   bool wasPaused = gSensorPollingPaused;
   gSensorPollingPaused = true;
   
-  FsLockGuard guard("readText");
+  FsPathReadGuard guard(path);
   File f = LittleFS.open(path, "r");
   if (!f) {
     gSensorPollingPaused = wasPaused;
@@ -724,7 +809,7 @@ bool writeText(const char* path, const String& in) {
   bool wasPaused = gSensorPollingPaused;
   gSensorPollingPaused = true;
   
-  FsLockGuard guard("writeText");
+  FsPathWriteGuard guard(path);
   File f = LittleFS.open(path, "w");
   if (!f) {
     gSensorPollingPaused = wasPaused;
@@ -732,6 +817,7 @@ bool writeText(const char* path, const String& in) {
   }
   f.print(in);
   f.close();
+  respCacheInvalidate(RESP_SRC_FILESYSTEM);
   
   // Resume sensor polling
   gSensorPollingPaused = wasPaused;
@@ -1391,6 +1477,7 @@ const char* cmd_testpassword(const String& argsInput) {
 const char* cmd_reboot(const String& originalCmd) {
   RETURN_VALID_IF_VALIDATE_CSTR();
   broadcastOutput("Rebooting system...");
+  flushPendingSettings();
   delay(100);  // Allow message to be sent
   ESP.restart();
   return "[System] Rebooting";  // Won't actually return due to restart
@@ -2149,6 +2236,11 @@ void printMemoryReport() {
       { "tof_task", TOF_STACK_WORDS },
       { "gamepad_task", GAMEPAD_STACK_WORDS },
       { "debug_out", DEBUG_OUT_STACK_WORDS },        // Debug output queue processor
+      { "dbg_serial", DEBUG_SINK_STACK_WORDS },      // Debug sink: UART
+      { "dbg_file", DEBUG_SINK_STACK_WORDS },        // Debug sink: system log file
+      { "dbg_g2", DEBUG_SINK_STACK_WORDS },          // Debug sink: G2 glasses
+      { "fs_async", FS_ASYNC_STACK_WORDS },          // Chunked/async file I/O worker
+      { "audio_cap", AUDIO_CAPTURE_STACK_WORDS },    // Shared PDM microphone capture ring
       { "apds_task", APDS_STACK_WORDS },             // APDS color/proximity/gesture sensor
       { "gps_task", GPS_STACK_WORDS },               // GPS polling task
     };
@@ -3182,71 +3274,51 @@ bool drawIcon(Adafruit_SSD1306* display, const char* name, int x, int y, uint16_
     return false;
   }
 
-  uint8_t buffer[128];
-  uint8_t width, height;
-
-  if (!loadIconData(name, buffer, sizeof(buffer), width, height)) {
+  const EmbeddedIcon* icon = findEmbeddedIcon(name);
+  if (!icon) {
     return false;
   }
 
-  // Icons are stored LSB-first, but drawBitmap expects MSB-first.
-  // Draw pixel-by-pixel with correct bit ordering.
-  for (int py = 0; py < height; py++) {
-    for (int px = 0; px < width; px++) {
-      int byteIndex = py * (width / 8) + (px / 8);
-      int bitIndex = px % 8;  // LSB-first: bit 0 = leftmost pixel
-      if ((buffer[byteIndex] >> bitIndex) & 1) {
-        display->drawPixel(x + px, y + py, color);
-      }
-    }
+  // Atlas rasters are already MSB-first, so this is one drawBitmap() per icon
+  uint8_t size = pgm_read_byte(&icon->width);
+  const uint8_t* bits = embeddedIconRaster(icon, size);
+  if (!bits) {
+    return false;
   }
+  display->drawBitmap(x, y, bits, size, size, color);
   return true;
 }
 
-// Helper to get a bit from 32x32 1bpp bitmap (row-major, LSB first per byte)
-static inline bool getBitmapBit(const uint8_t* buffer, int x, int y) {
-  if (x < 0 || x >= 32 || y < 0 || y >= 32) return false;
-  int byteIndex = y * 4 + (x / 8);  // 32 pixels / 8 = 4 bytes per row
-  int bitIndex = x % 8;
-  return (buffer[byteIndex] >> bitIndex) & 1;
-}
-
 bool drawIconScaled(Adafruit_SSD1306* display, const char* name, int x, int y, uint16_t color, float scale) {
   if (!display || scale <= 0) {
     return false;
   }
 
-  uint8_t buffer[128];
-  uint8_t width, height;
-
-  if (!loadIconData(name, buffer, sizeof(buffer), width, height)) {
+  const EmbeddedIcon* icon = findEmbeddedIcon(name);
+  if (!icon) {
     return false;
   }
 
-  // For scale == 1.0, use native bitmap draw (faster)
-  if (scale >= 0.99f && scale <= 1.01f) {
-    display->drawBitmap(x, y, buffer, width, height, color);
-    return true;
+  // Output size; the atlas caches the resampled raster per (icon, size).
+  // 0.5x uses 2x2 OR sampling (preserves thin lines), other factors nearest neighbour.
+  uint8_t width = pgm_read_byte(&icon->width);
+  uint8_t height = pgm_read_byte(&icon->height);
+  int outSize = (int)(width * scale);
+  if (outSize <= 0) {
+    return false;
   }
 
-  // Calculate output dimensions
-  int outWidth = (int)(width * scale);
-  int outHeight = (int)(height * scale);
-
-  // Handle 0.5x scale (32→16) with 2×2 block sampling
-  if (scale >= 0.49f && scale <= 0.51f && width == 32 && height == 32) {
-    for (int dy = 0; dy < 16; dy++) {
-      for (int dx = 0; dx < 16; dx++) {
-        // Sample 2×2 block from source
-        int srcX = dx * 2;
-        int srcY = dy * 2;
-        bool p00 = getBitmapBit(buffer, srcX, srcY);
-        bool p01 = getBitmapBit(buffer, srcX + 1, srcY);
-        bool p10 = getBitmapBit(buffer, srcX, srcY + 1);
-        bool p11 = getBitmapBit(buffer, srcX + 1, srcY + 1);
-
-        // OR logic: draw pixel if any source pixel is set (preserves thin lines)
-        if (p00 || p01 || p10 || p11) {
+  // Upscaling is rare enough not to be worth caching
+  if (outSize > ICON_ATLAS_MAX_SIZE) {
+    const uint8_t* src = (const uint8_t*)pgm_read_ptr(&icon->bitmapData);
+    int outHeight = (int)(height * scale);
+    float invScale = 1.0f / scale;
+    for (int dy = 0; dy < outHeight; dy++) {
+      for (int dx = 0; dx < outSize; dx++) {
+        int srcX = (int)(dx * invScale);
+        int srcY = (int)(dy * invScale);
+        if (srcX < width && srcY < height &&
+            ((pgm_read_byte(&src[srcY * (width / 8) + srcX / 8]) >> (srcX % 8)) & 1)) {
           display->drawPixel(x + dx, y + dy, color);
         }
       }
@@ -3254,18 +3326,11 @@ bool drawIconScaled(Adafruit_SSD1306* display, const char* name, int x, int y, u
     return true;
   }
 
-  // Generic scaling for other factors (nearest neighbor)
-  float invScale = 1.0f / scale;
-  for (int dy = 0; dy < outHeight; dy++) {
-    for (int dx = 0; dx < outWidth; dx++) {
-      int srcX = (int)(dx * invScale);
-      int srcY = (int)(dy * invScale);
-      if (getBitmapBit(buffer, srcX, srcY)) {
-        display->drawPixel(x + dx, y + dy, color);
-      }
-    }
+  const uint8_t* bits = embeddedIconRaster(icon, (uint8_t)outSize);
+  if (!bits) {
+    return false;
   }
-
+  display->drawBitmap(x, y, bits, outSize, outSize, color);
   return true;
 }
 
@@ -190,6 +190,37 @@ String base64Decode(const String& input);
 // JSON Parsing Helpers
 // ============================================================================
 
+// Single-pass, allocation-free field extraction. Fill `key`/`type` on each
+// slot, call jsonExtractFields() once, then read back `found` and the value.
+// STRING/OBJECT/ARRAY results are [start, start+len) spans into the source
+// (STRING excludes the quotes and is not unescaped; OBJECT/ARRAY include
+// their braces). Each key resolves on its first occurrence at any depth.
+#define JSON_FIELD_MAX_SLOTS 16
+
+enum JsonFieldType : uint8_t {
+  JSON_FIELD_BOOL,
+  JSON_FIELD_INT,
+  JSON_FIELD_FLOAT,
+  JSON_FIELD_STRING,
+  JSON_FIELD_OBJECT,
+  JSON_FIELD_ARRAY
+};
+
+struct JsonFieldSlot {
+  const char* key = nullptr;
+  JsonFieldType type = JSON_FIELD_INT;
+  bool found = false;
+  bool b = false;
+  long i = 0;
+  float f = 0.0f;
+  size_t start = 0;
+  size_t len = 0;
+};
+
+// Returns number of slots resolved. At most JSON_FIELD_MAX_SLOTS are considered.
+size_t jsonExtractFields(const char* json, size_t len, JsonFieldSlot* slots, size_t count);
+size_t jsonExtractFields(const String& src, JsonFieldSlot* slots, size_t count);
+
 bool parseJsonBool(const String& src, const char* key, bool& out);
 bool parseJsonInt(const String& src, const char* key, int& out);
 bool parseJsonFloat(const String& src, const char* key, float& out);
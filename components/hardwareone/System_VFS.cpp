@@ -7,6 +7,7 @@
 #include "System_MemUtil.h"
 #include "System_Mutex.h"
 #include "System_Notifications.h"
+#include "WebServer_ResponseCache.h"  // respCacheInvalidate
 
 #include <LittleFS.h>
 #include <SD.h>
@@ -158,7 +159,10 @@ File open(const String& path, const char* mode, bool create) {
   }
 
   if (!filesystemReady) return File();
-  return LittleFS.open(p.c_str(), mode, create);
+  File f = LittleFS.open(p.c_str(), mode, create);
+  // Any non-read open may change used bytes (files.stats)
+  if (f && mode && (mode[0] != 'r' || mode[1] == '+')) respCacheInvalidate(RESP_SRC_FILESYSTEM);
+  return f;
 }
 
 bool mkdir(const String& path) {
@@ -172,7 +176,9 @@ bool mkdir(const String& path) {
   }
 
   if (!filesystemReady) return false;
-  return LittleFS.mkdir(p);
+  bool ok = LittleFS.mkdir(p);
+  if (ok) respCacheInvalidate(RESP_SRC_FILESYSTEM);
+  return ok;
 }
 
 bool remove(const String& path) {
@@ -189,7 +195,10 @@ bool remove(const String& path) {
 
   if (!filesystemReady) return false;
   bool ok = LittleFS.remove(p);
-  if (ok) notifyFileDeleted(p.c_str());
+  if (ok) {
+    notifyFileDeleted(p.c_str());
+    respCacheInvalidate(RESP_SRC_FILESYSTEM);
+  }
   return ok;
 }
 
@@ -212,7 +221,9 @@ bool rename(const String& pathFrom, const String& pathTo) {
   }
 
   if (!filesystemReady) return false;
-  return LittleFS.rename(from, to);
+  bool ok = LittleFS.rename(from, to);
+  if (ok) respCacheInvalidate(RESP_SRC_FILESYSTEM);
+  return ok;
 }
 
 bool rmdir(const String& path) {
@@ -229,7 +240,10 @@ bool rmdir(const String& path) {
 
   if (!filesystemReady) return false;
   bool ok = LittleFS.rmdir(p);
-  if (ok) notifyFileDeleted(p.c_str());
+  if (ok) {
+    notifyFileDeleted(p.c_str());
+    respCacheInvalidate(RESP_SRC_FILESYSTEM);
+  }
   return ok;
 }
 
@@ -4,6 +4,7 @@
 
 #include "WebPage_Maps.h"
 #include "WebServer_Utils.h"
+#include "WebServer_HttpHeaders.h"
 #include "WebServer_Server.h"
 #include "System_Maps.h"
 #include "System_Debug.h"
@@ -13,6 +14,7 @@
 #include <ArduinoJson.h>
 #include "System_MemUtil.h"
 #include "System_Command.h"
+#include "System_Utils.h"
 #include <LittleFS.h>
 #include <cstring>
 
@@ -128,6 +130,8 @@ esp_err_t handleMapSelectAPI(httpd_req_t* req) {
 // Map Features API
 // =============================================================================
 
+// Map metadata plus one page of place names in case-folded order.
+// Query: prefix (case-insensitive), offset, limit (default 100, max 500).
 esp_err_t handleMapFeaturesAPI(httpd_req_t* req) {
   AuthContext ctx = makeWebAuthCtx(req);
   if (!tgRequireAuth(ctx)) return ESP_OK;
@@ -139,41 +143,204 @@ esp_err_t handleMapFeaturesAPI(httpd_req_t* req) {
     return ESP_OK;
   }
   
+  char prefix[MAP_NAME_MAX_LEN + 1] = {0};
+  uint32_t offset = 0;
+  uint32_t limit = 100;
+  char query[192];
+  if (httpd_req_get_url_query_str(req, query, sizeof(query)) == ESP_OK) {
+    char param[16];
+    char rawPrefix[sizeof(prefix) * 3];
+    if (httpd_query_key_value(query, "prefix", rawPrefix, sizeof(rawPrefix)) == ESP_OK) {
+      String decoded = urlDecode(String(rawPrefix));
+      strncpy(prefix, decoded.c_str(), sizeof(prefix) - 1);
+    }
+    if (httpd_query_key_value(query, "offset", param, sizeof(param)) == ESP_OK) offset = strtoul(param, nullptr, 10);
+    if (httpd_query_key_value(query, "limit", param, sizeof(param)) == ESP_OK) limit = strtoul(param, nullptr, 10);
+  }
+  if (limit == 0 || limit > 500) limit = 500;
+  
   const LoadedMap& map = MapCore::getCurrentMap();
+  uint32_t first = 0;
+  uint32_t total = MapCore::findNamePrefixRange(prefix, &first);
+  if (offset > total) offset = total;
+  uint32_t end = (total - offset > limit) ? offset + limit : total;
   
-  // Build JSON response
-  String json = "{";
-  json += "\"mapName\":\"";
-  json += map.filename;
-  json += "\",\"hasNames\":";
-  json += map.nameCount > 0 ? "true" : "false";
-  json += ",\"featureCount\":";
-  json += (int)map.header.featureCount;
-  json += ",";
+  char chunk[384];
+  snprintf(chunk, sizeof(chunk),
+           "{\"mapName\":\"%s\",\"hasNames\":%s,\"featureCount\":%lu,\"nameCount\":%u,"
+           "\"tileGridSize\":%u,\"tileCount\":%u,"
+           "\"total\":%lu,\"offset\":%lu,\"nextOffset\":%ld,\"names\":[",
+           map.filename, map.nameCount > 0 ? "true" : "false",
+           (unsigned long)map.header.featureCount, map.nameCount,
+           map.tileGridSize, map.tileCount,
+           (unsigned long)total, (unsigned long)offset, end < total ? (long)end : -1L);
+  httpd_resp_sendstr_chunk(req, chunk);
   
-  if (map.nameCount > 0) {
-    json += "\"nameCount\":";
-    json += map.nameCount;
-    json += ",";
-    json += "\"names\":[";
-    bool firstName = true;
-    for (int i = 0; i < map.nameCount; i++) {
-      if (!firstName) json += ",";
-      firstName = false;
-      
-      // Escape quotes in name
-      String name = String(map.names[i].name);
-      name.replace("\"", "\\\"");
-      json += "\"" + name + "\"";
+  for (uint32_t i = offset; i < end; i++) {
+    const char* name = MapCore::getName(MapCore::getSortedNameIndex(first + i));
+    if (!name) continue;
+    // JSON-escape into the chunk buffer, leaving room for the closing quote
+    size_t n = 0;
+    if (i > offset) chunk[n++] = ',';
+    chunk[n++] = '"';
+    for (const char* c = name; *c && n < sizeof(chunk) - 8; c++) {
+      uint8_t ch = (uint8_t)*c;
+      if (ch == '"' || ch == '\\') { chunk[n++] = '\\'; chunk[n++] = (char)ch; }
+      else if (ch < 0x20) n += snprintf(chunk + n, sizeof(chunk) - n, "\\u%04x", ch);
+      else chunk[n++] = (char)ch;
     }
-    json += "]";
-  } else {
-    json += "\"nameCount\":0";
+    chunk[n++] = '"';
+    chunk[n] = '\0';
+    httpd_resp_sendstr_chunk(req, chunk);
+  }
+  
+  httpd_resp_sendstr_chunk(req, "]}");
+  httpd_resp_sendstr_chunk(req, NULL);
+  return ESP_OK;
+}
+
+// =============================================================================
+// Map Tile API (binary)
+// =============================================================================
+
+static inline uint32_t fnv1a(uint32_t h, const void* data, size_t len) {
+  const uint8_t* p = (const uint8_t*)data;
+  for (size_t i = 0; i < len; i++) { h ^= p[i]; h *= 16777619u; }
+  return h;
+}
+
+// Raw bytes of the loaded map for the web viewer, read through the map's open
+// file handle. Query: tile=<index> for one tile payload; without it, the whole
+// .hwmap file. Strong ETags come from the map header, file size and tile
+// directory; If-None-Match answers 304 and a single Range answers 206.
+// The map lock is only held while the directory is read and per chunk (a slow
+// client must not stall the OLED); a map load or unload in between aborts.
+esp_err_t handleMapTileAPI(httpd_req_t* req) {
+  AuthContext ctx = makeWebAuthCtx(req);
+  if (!tgRequireAuth(ctx)) return ESP_OK;
+  
+  char query[64];
+  char param[16];
+  bool wantTile = httpd_req_get_url_query_str(req, query, sizeof(query)) == ESP_OK &&
+                  httpd_query_key_value(query, "tile", param, sizeof(param)) == ESP_OK;
+  
+  uint32_t generation = 0;
+  uint32_t base = 0;
+  uint32_t size = 0;
+  char etag[32];
+  {
+    MapCacheGuard cacheGuard("web.mapTile");
+    if (!MapCore::hasValidMap()) {
+      httpd_resp_set_status(req, "404 Not Found");
+      httpd_resp_set_type(req, "application/json");
+      httpd_resp_sendstr(req, "{\"error\":\"No map loaded\"}");
+      return ESP_OK;
+    }
+    
+    const LoadedMap& map = MapCore::getCurrentMap();
+    generation = MapCore::getMapGeneration();
+    uint32_t fileSize = (uint32_t)map.fileSize;
+    uint32_t mapHash = fnv1a(2166136261u, &map.header, sizeof(map.header));
+    mapHash = fnv1a(mapHash, &fileSize, sizeof(fileSize));
+    mapHash = fnv1a(mapHash, map.tileDir, (size_t)map.tileCount * sizeof(HWMapTileDirEntry));
+    
+    size = fileSize;
+    if (wantTile) {
+      char* end;
+      unsigned long tileIdx = strtoul(param, &end, 10);
+      if (end == param || *end != '\0' || tileIdx >= map.tileCount ||
+          (uint64_t)map.tileDir[tileIdx].offset + map.tileDir[tileIdx].payloadSize > fileSize) {
+        httpd_resp_set_status(req, "400 Bad Request");
+        httpd_resp_set_type(req, "application/json");
+        httpd_resp_sendstr(req, "{\"error\":\"Invalid tile\"}");
+        return ESP_OK;
+      }
+      base = map.tileDir[tileIdx].offset;
+      size = map.tileDir[tileIdx].payloadSize;
+      snprintf(etag, sizeof(etag), "\"%08lx-t%lu\"", (unsigned long)mapHash, tileIdx);
+    } else {
+      snprintf(etag, sizeof(etag), "\"%08lx\"", (unsigned long)mapHash);
+    }
+  }
+  
+  // Browsers revalidate every use; an unchanged map costs a 304 with no body
+  httpd_resp_set_hdr(req, "ETag", etag);
+  httpd_resp_set_hdr(req, "Accept-Ranges", "bytes");
+  httpd_resp_set_hdr(req, "Cache-Control", "no-cache");
+  
+  char hdr[128];
+  if (httpd_req_get_hdr_value_str(req, "If-None-Match", hdr, sizeof(hdr)) == ESP_OK &&
+      etagListMatches(hdr, etag)) {
+    httpd_resp_set_status(req, "304 Not Modified");
+    httpd_resp_send(req, nullptr, 0);
+    return ESP_OK;
+  }
+  
+  uint32_t first = 0;
+  uint32_t last = size ? size - 1 : 0;
+  int range = 0;
+  if (httpd_req_get_hdr_value_str(req, "Range", hdr, sizeof(hdr)) == ESP_OK) {
+    // If-Range: a stale validator means the client gets the whole current body
+    char ifRange[40];
+    if (httpd_req_get_hdr_value_str(req, "If-Range", ifRange, sizeof(ifRange)) != ESP_OK ||
+        strcmp(ifRange, etag) == 0) {
+      range = parseByteRange(hdr, size, first, last);
+    }
+  }
+  
+  char contentRange[48];
+  if (range < 0) {
+    snprintf(contentRange, sizeof(contentRange), "bytes */%lu", (unsigned long)size);
+    httpd_resp_set_status(req, "416 Range Not Satisfiable");
+    httpd_resp_set_hdr(req, "Content-Range", contentRange);
+    httpd_resp_send(req, nullptr, 0);
+    return ESP_OK;
+  }
+  
+  httpd_resp_set_type(req, "application/octet-stream");
+  if (range > 0) {
+    snprintf(contentRange, sizeof(contentRange), "bytes %lu-%lu/%lu",
+             (unsigned long)first, (unsigned long)last, (unsigned long)size);
+    httpd_resp_set_status(req, "206 Partial Content");
+    httpd_resp_set_hdr(req, "Content-Range", contentRange);
+  }
+  if (size == 0) {
+    httpd_resp_send(req, nullptr, 0);
+    return ESP_OK;
+  }
+  
+  const size_t bufSize = 4096;
+  uint8_t* buf = (uint8_t*)ps_alloc(bufSize, AllocPref::PreferPSRAM, "maps.tile");
+  if (!buf) {
+    httpd_resp_send_500(req);
+    return ESP_FAIL;
   }
   
-  json += "}";
+  // A short read mid-body aborts the connection rather than ending the chunked
+  // body, so the client never mistakes a truncated response for a complete one
+  bool ok = true;
+  uint32_t sent = 0;
+  for (uint32_t pos = first; pos <= last; ) {
+    size_t want = (last - pos + 1 < bufSize) ? (size_t)(last - pos + 1) : bufSize;
+    size_t got = 0;
+    {
+      // Same map as the one the headers (ETag, offsets, length) describe
+      MapCacheGuard cacheGuard("web.mapTile");
+      if (MapCore::getMapGeneration() == generation) got = MapCore::readMapFile(base + pos, buf, want);
+    }
+    if (got == 0 || httpd_resp_send_chunk(req, (const char*)buf, got) != ESP_OK) {
+      ok = false;
+      break;
+    }
+    pos += got;
+    sent += got;
+  }
+  free(buf);
   
-  httpd_resp_sendstr(req, json.c_str());
+  DEBUG_MAPS_PERFF("[MAPS] tile API: %s %lu bytes (%s)", etag, (unsigned long)sent,
+                   range > 0 ? "partial" : "full");
+  if (!ok) return ESP_FAIL;
+  httpd_resp_send_chunk(req, NULL, 0);
   return ESP_OK;
 }
 
@@ -284,19 +451,33 @@ esp_err_t handleGPSTracksAPI(httpd_req_t* req) {
                coverage);
       httpd_resp_sendstr_chunk(req, header);
 
-      const GPSTrackPoint* points = GPSTrackManager::getPoints();
+      // Points are streamed from the track file in small batches; long tracks
+      // are thinned to every Nth point (always keeping the last one)
+      const int maxWebPoints = 5000;
       int pointCount = GPSTrackManager::getPointCount();
+      int stride = (pointCount + maxWebPoints - 1) / maxWebPoints;
+      if (stride < 1) stride = 1;
       
-      for (int i = 0; i < pointCount; i++) {
-        char pointJson[128];
-        snprintf(pointJson, sizeof(pointJson), "%s{\"lat\":%.6f,\"lon\":%.6f}",
-                 (i == 0) ? "" : ",", points[i].lat, points[i].lon);
-        httpd_resp_sendstr_chunk(req, pointJson);
+      GPSTrackPoint batch[32];
+      int sent = 0;
+      for (int first = 0; first < pointCount; ) {
+        int n = GPSTrackManager::readPoints((uint32_t)first, batch, 32);
+        if (n <= 0) break;
+        for (int j = 0; j < n; j++) {
+          int i = first + j;
+          if (i % stride != 0 && i != pointCount - 1) continue;
+          char pointJson[128];
+          snprintf(pointJson, sizeof(pointJson), "%s{\"lat\":%.6f,\"lon\":%.6f}",
+                   (sent == 0) ? "" : ",", batch[j].lat, batch[j].lon);
+          httpd_resp_sendstr_chunk(req, pointJson);
+          sent++;
+        }
+        first += n;
       }
 
       char footer[256];
-      snprintf(footer, sizeof(footer), "],\"count\":%d,\"message\":\"%s\"}", 
-               pointCount, validMsg);
+      snprintf(footer, sizeof(footer), "],\"count\":%d,\"total\":%d,\"message\":\"%s\"}", 
+               sent, pointCount, validMsg);
       httpd_resp_sendstr_chunk(req, footer);
       httpd_resp_sendstr_chunk(req, NULL);
       return ESP_OK;
@@ -321,18 +502,27 @@ esp_err_t handleGPSTracksAPI(httpd_req_t* req) {
     while (file) {
       if (!file.isDirectory()) {
         bool hasGPS = false;
-        File check = LittleFS.open(file.path(), "r");
-        if (check) {
-          for (int i = 0; i < 15 && check.available(); i++) {
-            String line = check.readStringUntil('\n');
-            // Check for both sensor log format and CSV format
-            if (line.indexOf("gps:") >= 0 || 
-                (line.length() > 10 && line.charAt(0) != '#' && line.indexOf(',') > 0)) {
-              hasGPS = true;
-              break;
+        const char* path = file.path();
+        size_t pathLen = strlen(path);
+        size_t extLen = strlen(GPS_TRACK_EXT);
+        if (pathLen > extLen && strcmp(path + pathLen - extLen, GPS_TRACK_EXT) == 0) {
+          // Binary track; hide the cached copy of a log that is listed itself
+          String source = String(path).substring(0, pathLen - extLen);
+          hasGPS = !LittleFS.exists(source.c_str());
+        } else {
+          File check = LittleFS.open(path, "r");
+          if (check) {
+            for (int i = 0; i < 15 && check.available(); i++) {
+              String line = check.readStringUntil('\n');
+              // Check for both sensor log format and CSV format
+              if (line.indexOf("gps:") >= 0 || 
+                  (line.length() > 10 && line.charAt(0) != '#' && line.indexOf(',') > 0)) {
+                hasGPS = true;
+                break;
+              }
             }
+            check.close();
           }
-          check.close();
         }
 
         if (hasGPS) {
@@ -580,6 +770,7 @@ void registerMapsHandlers(httpd_handle_t server) {
   static httpd_uri_t mapsPage = { .uri = "/maps", .method = HTTP_GET, .handler = handleMapsPage, .user_ctx = NULL };
   static httpd_uri_t mapFeaturesGet = { .uri = "/api/maps/features", .method = HTTP_GET, .handler = handleMapFeaturesAPI, .user_ctx = NULL };
   static httpd_uri_t mapSelectGet = { .uri = "/api/maps/select", .method = HTTP_GET, .handler = handleMapSelectAPI, .user_ctx = NULL };
+  static httpd_uri_t mapTileGet = { .uri = "/api/maps/tile", .method = HTTP_GET, .handler = handleMapTileAPI, .user_ctx = NULL };
   static httpd_uri_t mapsOrganizePost = { .uri = "/api/maps/organize", .method = HTTP_POST, .handler = handleMapsOrganize, .user_ctx = NULL };
   static httpd_uri_t waypointsGet = { .uri = "/api/waypoints", .method = HTTP_GET, .handler = handleWaypointsAPI, .user_ctx = NULL };
   static httpd_uri_t waypointsPost = { .uri = "/api/waypoints", .method = HTTP_POST, .handler = handleWaypointsAPI, .user_ctx = NULL };
@@ -588,6 +779,7 @@ void registerMapsHandlers(httpd_handle_t server) {
   httpd_register_uri_handler(server, &mapsPage);
   httpd_register_uri_handler(server, &mapFeaturesGet);
   httpd_register_uri_handler(server, &mapSelectGet);
+  httpd_register_uri_handler(server, &mapTileGet);
   httpd_register_uri_handler(server, &mapsOrganizePost);
   httpd_register_uri_handler(server, &waypointsGet);
   httpd_register_uri_handler(server, &waypointsPost);
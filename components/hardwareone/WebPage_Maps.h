@@ -709,7 +709,7 @@ async function loadMap(path) {
   }
 }
 
-// Parse HWMAP binary format (v6)
+// Parse HWMAP binary format (v6 fixed-point tiles, v7 varint-delta tiles)
 function parseHWMap(buffer, filename) {
   const view = new DataView(buffer);
   const fileLen = buffer.byteLength;
@@ -724,6 +724,16 @@ function parseHWMap(buffer, filename) {
   const readU16 = () => { requireBytes(2, 'u16'); const v = view.getUint16(offset, true); offset += 2; return v; };
   const readI32 = () => { requireBytes(4, 'i32'); const v = view.getInt32(offset, true); offset += 4; return v; };
   const readU32 = () => { requireBytes(4, 'u32'); const v = view.getUint32(offset, true); offset += 4; return v; };
+  const readVarint = () => {
+    let v = 0;
+    for (let shift = 0; shift < 32; shift += 7) {
+      const b = readU8();
+      v += (b & 0x7F) * Math.pow(2, shift);
+      if (!(b & 0x80)) return v;
+    }
+    throw new Error(`[HWMap] Bad varint at ${offset}`);
+  };
+  const unzigzag = (v) => (v % 2) ? -(v + 1) / 2 : v / 2;
 
   // Header (40 bytes)
   requireBytes(40, 'header');
@@ -732,7 +742,8 @@ function parseHWMap(buffer, filename) {
   offset = 4;
 
   const version = readU16();
-  if (version !== 6) throw new Error(`Unsupported map version: ${version} (need v6)`);
+  if (version !== 6 && version !== 7) throw new Error(`Unsupported map version: ${version} (need v6 or v7)`);
+  const compact = version >= 7;
   const flags = readU16();
 
   const minLat = readI32();
@@ -814,11 +825,37 @@ function parseHWMap(buffer, filename) {
       // Feature count is at the START of each tile's payload
       const tileFeatureCount = readU16();
 
-      for (let f = 0; f < tileFeatureCount && offset + hdrSize <= tileEnd; f++) {
-        const type = readU8();
-        const subtype = readU8();
-        const nameIndex = readU16();
-        const pointCount = readU16();
+      // v7: optional dictionary of (type, subtype, nameIndex) headers
+      let dict = null;
+      if (compact) {
+        const tileFlags = readU8();
+        if (tileFlags & 0x01) {
+          const entries = readVarint();
+          dict = [];
+          for (let d = 0; d < entries; d++) dict.push([readU8(), readU8(), readU16()]);
+        }
+      }
+
+      for (let f = 0; f < tileFeatureCount && offset < tileEnd && (compact || offset + hdrSize <= tileEnd); f++) {
+        let type, subtype, nameIndex, pointCount, pointBytes;
+        if (compact) {
+          let hdr;
+          if (dict) {
+            hdr = dict[readVarint()];
+            if (!hdr) { console.warn(`[MAP] Tile ${tileIdx} feature ${f}: bad dictionary index`); break; }
+          } else {
+            hdr = [readU8(), readU8(), readU16()];
+          }
+          [type, subtype, nameIndex] = hdr;
+          pointCount = readVarint();
+          pointBytes = readVarint();
+        } else {
+          type = readU8();
+          subtype = readU8();
+          nameIndex = readU16();
+          pointCount = readU16();
+          pointBytes = pointCount * 4;
+        }
 
         if (pointCount > 0) {
           featureAvailability.add(featureAvailabilityKey(type, null));
@@ -826,21 +863,32 @@ function parseHWMap(buffer, filename) {
         }
 
         // Bounds check: ensure we have enough data for all points
-        const bytesNeeded = pointCount * 4;
+        const bytesNeeded = pointBytes;
         if (offset + bytesNeeded > tileEnd) {
           console.warn(`[MAP] Tile ${tileIdx} feature ${f}: truncated (need ${bytesNeeded} bytes, have ${tileEnd - offset})`);
           break;
         }
 
         const points = [];
+        const pointsEnd = offset + bytesNeeded;
+        let qLat = 0, qLon = 0;
         for (let p = 0; p < pointCount; p++) {
-          const qLat = readU16();
-          const qLon = readU16();
+          if (!compact) {
+            qLat = readU16();
+            qLon = readU16();
+          } else if (p === 0) {
+            qLat = readVarint() & 0xFFFF;
+            qLon = readVarint() & 0xFFFF;
+          } else {
+            qLat = (qLat + unzigzag(readVarint())) & 0xFFFF;
+            qLon = (qLon + unzigzag(readVarint())) & 0xFFFF;
+          }
           // Dequantize: match preview renderer (qMax depends on quantBits)
           const latMicro = tileMinLat + (qLat / qMax) * haloLatSpan;
           const lonMicro = tileMinLon + (qLon / qMax) * haloLonSpan;
           points.push({ lat: latMicro / 10000000, lon: lonMicro / 10000000 });
         }
+        offset = pointsEnd;
 
         if (points.length >= 2) {
           const featureName = (nameIndex !== 0xFFFF && nameIndex < names.length) ? names[nameIndex] : null;
@@ -2741,6 +2789,9 @@ esp_err_t handleMapSelectAPI(httpd_req_t* req);
 // Map features API - get map metadata and feature names
 esp_err_t handleMapFeaturesAPI(httpd_req_t* req);
 
+// Map tile API - raw tile payloads / map file bytes with ETag and Range support
+esp_err_t handleMapTileAPI(httpd_req_t* req);
+
 // GPS tracks API - load tracks, list files, live tracking
 esp_err_t handleGPSTracksAPI(httpd_req_t* req);
 
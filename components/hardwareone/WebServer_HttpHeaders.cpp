@@ -0,0 +1,70 @@
+// WebServer_HttpHeaders.cpp - Parsing of conditional and range request headers
+
+#include "WebServer_HttpHeaders.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+int parseByteRange(const char* hdr, uint32_t size, uint32_t& first, uint32_t& last) {
+  if (!hdr || strncmp(hdr, "bytes=", 6) != 0) return 0;
+  const char* p = hdr + 6;
+  while (*p == ' ') p++;
+  if (strchr(p, ',')) return 0;
+  
+  char* end;
+  unsigned long long a = 0, b = ~0ULL;
+  bool suffix = (*p == '-');
+  if (!suffix) {
+    if (*p < '0' || *p > '9') return 0;
+    a = strtoull(p, &end, 10);
+    p = end;
+    if (*p != '-') return 0;
+  }
+  p++;
+  if (*p >= '0' && *p <= '9') {
+    b = strtoull(p, &end, 10);
+    p = end;
+  } else if (suffix) {
+    return 0;
+  }
+  while (*p == ' ') p++;
+  if (*p != '\0') return 0;
+  
+  if (suffix) {
+    // Last b bytes
+    if (b == 0 || size == 0) return -1;
+    first = (b >= size) ? 0 : (uint32_t)(size - b);
+    last = size - 1;
+    return 1;
+  }
+  if (b < a) return 0;
+  if (a >= size) return -1;
+  first = (uint32_t)a;
+  last = (b >= size) ? size - 1 : (uint32_t)b;
+  return 1;
+}
+
+bool etagListMatches(const char* hdr, const char* etag) {
+  if (!hdr || !etag) return false;
+  size_t etagLen = strlen(etag);
+  const char* p = hdr;
+  for (;;) {
+    while (*p == ' ' || *p == '\t' || *p == ',') p++;
+    if (*p == '\0') return false;
+    if (p[0] == 'W' && p[1] == '/') p += 2;
+    const char* start = p;
+    if (*p == '"') {
+      // A quoted tag may itself contain commas
+      const char* close = strchr(p + 1, '"');
+      if (!close) return false;
+      p = close + 1;
+    } else {
+      while (*p && *p != ',' && *p != ' ' && *p != '\t') p++;
+    }
+    size_t n = (size_t)(p - start);
+    if (n == 1 && *start == '*') return true;
+    if (n == etagLen && memcmp(start, etag, etagLen) == 0) return true;
+    // Skip anything after the tag up to the next list separator
+    while (*p && *p != ',') p++;
+  }
+}
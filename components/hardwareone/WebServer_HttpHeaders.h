@@ -0,0 +1,19 @@
+// WebServer_HttpHeaders.h - Parsing of conditional and range request headers
+//
+// Plain string functions with no server dependency, shared by handlers that
+// serve binary bodies with ETags and byte ranges (the map tile API).
+
+#ifndef WEBSERVER_HTTP_HEADERS_H
+#define WEBSERVER_HTTP_HEADERS_H
+
+#include <stdint.h>
+
+// One "bytes=" range against a body of size bytes (RFC 7233). Returns 1 with the
+// inclusive span in first/last, -1 if unsatisfiable (416), or 0 if the header
+// is to be ignored and the whole body sent (malformed or multiple ranges).
+int parseByteRange(const char* hdr, uint32_t size, uint32_t& first, uint32_t& last);
+
+// If-None-Match list ("*", or comma-separated tags; W/ tags compare weakly)
+bool etagListMatches(const char* hdr, const char* etag);
+
+#endif  // WEBSERVER_HTTP_HEADERS_H
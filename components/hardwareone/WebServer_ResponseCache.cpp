@@ -0,0 +1,182 @@
+// WebServer_ResponseCache.cpp - Versioned, pre-serialized JSON responses for hot read-only APIs
+
+#include "WebServer_ResponseCache.h"
+
+#if ENABLE_HTTP_SERVER
+
+#include <freertos/FreeRTOS.h>
+#include <freertos/semphr.h>
+
+#include "System_Debug.h"
+#include "System_MemUtil.h"
+
+// Serialized response bytes. One reference is held by the cache entry while it
+// is current; each CachedResponse holds another until it is destroyed.
+struct RespCacheBlob {
+  uint32_t refs;
+  size_t len;
+  char data[1];
+};
+
+struct RespCacheEntry {
+  const char* name;
+  RespCacheSource source;
+  uint32_t maxAgeMs;
+  RespCacheGenerator gen;
+  SemaphoreHandle_t buildLock;  // Serializes regeneration so concurrent misses build once
+  RespCacheBlob* blob;          // Current bytes (nullptr until first build)
+  uint32_t version;             // Source version the blob was built from
+  uint32_t builtMs;
+  uint32_t hits;
+  uint32_t misses;
+};
+
+static RespCacheEntry sEntries[RESP_CACHE_MAX_ENTRIES];
+static volatile int sEntryCount = 0;
+static volatile uint32_t sSourceVersion[RESP_SRC_COUNT] = {};
+
+// Guards blob pointer swaps and refcounts only - never held across generation or I/O
+static portMUX_TYPE sCacheMux = portMUX_INITIALIZER_UNLOCKED;
+
+void respCacheInvalidate(RespCacheSource source) {
+  if (source >= RESP_SRC_COUNT) return;
+  __atomic_add_fetch(&sSourceVersion[source], 1, __ATOMIC_RELAXED);
+}
+
+uint32_t respCacheVersion(RespCacheSource source) {
+  if (source >= RESP_SRC_COUNT) return 0;
+  return __atomic_load_n(&sSourceVersion[source], __ATOMIC_RELAXED);
+}
+
+RespCacheId respCacheRegister(const char* name, RespCacheSource source, uint32_t maxAgeMs, RespCacheGenerator gen) {
+  if (!gen || source >= RESP_SRC_COUNT) return RESP_CACHE_INVALID_ID;
+
+  // Re-registration (e.g. server restart) returns the existing slot
+  for (int i = 0; i < sEntryCount; i++) {
+    if (sEntries[i].gen == gen && strcmp(sEntries[i].name, name) == 0) return i;
+  }
+  if (sEntryCount >= RESP_CACHE_MAX_ENTRIES) {
+    ERROR_WEBF("[RespCache] Registry full, '%s' will not be cached", name);
+    return RESP_CACHE_INVALID_ID;
+  }
+
+  SemaphoreHandle_t lock = xSemaphoreCreateMutex();
+  if (!lock) return RESP_CACHE_INVALID_ID;
+
+  RespCacheEntry& e = sEntries[sEntryCount];
+  e.name = name;
+  e.source = source;
+  e.maxAgeMs = maxAgeMs;
+  e.gen = gen;
+  e.buildLock = lock;
+  e.blob = nullptr;
+  e.version = 0;
+  e.builtMs = 0;
+  e.hits = 0;
+  e.misses = 0;
+  return sEntryCount++;
+}
+
+static void releaseBlob(RespCacheBlob* blob) {
+  if (!blob) return;
+  bool last;
+  portENTER_CRITICAL(&sCacheMux);
+  last = (--blob->refs == 0);
+  portEXIT_CRITICAL(&sCacheMux);
+  if (last) free(blob);
+}
+
+// Take a reader reference if the entry's blob is still valid for `want`
+static RespCacheBlob* tryAcquireCurrent(RespCacheEntry& e, uint32_t want, uint32_t now) {
+  RespCacheBlob* blob = nullptr;
+  portENTER_CRITICAL(&sCacheMux);
+  if (e.blob && e.version == want && (e.maxAgeMs == 0 || (now - e.builtMs) < e.maxAgeMs)) {
+    blob = e.blob;
+    blob->refs++;
+  }
+  portEXIT_CRITICAL(&sCacheMux);
+  return blob;
+}
+
+static RespCacheBlob* buildBlob(RespCacheEntry& e) {
+  PSRAM_JSON_DOC(doc);
+  if (!e.gen(doc)) {
+    WARN_WEBF("[RespCache] Generator for '%s' failed", e.name);
+    return nullptr;
+  }
+  size_t len = measureJson(doc);
+  RespCacheBlob* blob = (RespCacheBlob*)ps_alloc(sizeof(RespCacheBlob) + len, AllocPref::PreferPSRAM, "resp.cache");
+  if (!blob) {
+    WARN_WEBF("[RespCache] Out of memory for '%s' (%u bytes)", e.name, (unsigned)len);
+    return nullptr;
+  }
+  blob->refs = 0;
+  blob->len = serializeJson(doc, blob->data, len + 1);
+  return blob;
+}
+
+static RespCacheBlob* acquireBlob(RespCacheId id) {
+  if (id < 0 || id >= sEntryCount) return nullptr;
+  RespCacheEntry& e = sEntries[id];
+
+  uint32_t want = respCacheVersion(e.source);
+  RespCacheBlob* blob = tryAcquireCurrent(e, want, millis());
+  if (blob) {
+    e.hits++;
+    return blob;
+  }
+
+  // Miss: one task regenerates, the rest wait here and then share its result
+  xSemaphoreTake(e.buildLock, portMAX_DELAY);
+  want = respCacheVersion(e.source);
+  blob = tryAcquireCurrent(e, want, millis());
+  if (!blob) {
+    // Version is sampled before generating, so an invalidation that lands
+    // mid-build leaves the entry stale and the next reader rebuilds it.
+    blob = buildBlob(e);
+    if (blob) {
+      RespCacheBlob* old;
+      portENTER_CRITICAL(&sCacheMux);
+      old = e.blob;
+      blob->refs = 2;  // cache + this reader
+      e.blob = blob;
+      e.version = want;
+      e.builtMs = millis();
+      portEXIT_CRITICAL(&sCacheMux);
+      releaseBlob(old);
+      e.misses++;
+      DEBUG_HTTPF("[RespCache] Rebuilt '%s' v%lu: %u bytes", e.name, (unsigned long)want, (unsigned)blob->len);
+    }
+  } else {
+    e.hits++;
+  }
+  xSemaphoreGive(e.buildLock);
+  return blob;
+}
+
+CachedResponse::CachedResponse(RespCacheId id) : _blob(acquireBlob(id)) {}
+
+CachedResponse::~CachedResponse() {
+  releaseBlob(_blob);
+}
+
+const char* CachedResponse::data() const {
+  return _blob ? _blob->data : "";
+}
+
+size_t CachedResponse::length() const {
+  return _blob ? _blob->len : 0;
+}
+
+esp_err_t respCacheSend(httpd_req_t* req, RespCacheId id, const char* cacheControl) {
+  CachedResponse resp(id);
+  if (!resp.ok()) {
+    httpd_resp_send_500(req);
+    return ESP_FAIL;
+  }
+  httpd_resp_set_type(req, "application/json");
+  if (cacheControl) httpd_resp_set_hdr(req, "Cache-Control", cacheControl);
+  return httpd_resp_send(req, resp.data(), resp.length());
+}
+
+#endif // ENABLE_HTTP_SERVER
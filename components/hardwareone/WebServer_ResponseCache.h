@@ -0,0 +1,81 @@
+// WebServer_ResponseCache.h - Versioned, pre-serialized JSON responses for hot read-only APIs
+//
+// Endpoints whose output changes rarely (build config, settings schema/values,
+// filesystem stats) register a generator plus the invalidation source it depends
+// on. The first request after a change runs the generator and stores the
+// serialized bytes in a refcounted PSRAM blob; every later request until the next
+// invalidation sends those bytes directly. Readers never touch gJsonResponseBuffer
+// or gJsonResponseMutex, and a blob stays alive until the last reader releases it
+// even if a newer version is published meanwhile.
+
+#ifndef WEBSERVER_RESPONSE_CACHE_H
+#define WEBSERVER_RESPONSE_CACHE_H
+
+#include "System_BuildConfig.h"
+#include <Arduino.h>
+
+// Invalidation sources - bump with respCacheInvalidate() when the underlying data changes
+enum RespCacheSource : uint8_t {
+  RESP_SRC_STATIC = 0,   // Never changes after boot (compile-time flags)
+  RESP_SRC_SETTINGS,     // gSettings values (markSettingsDirty, load, flush)
+  RESP_SRC_FILESYSTEM,   // LittleFS contents (VFS writes, fs service, writeText, web file handlers)
+  RESP_SRC_COUNT
+};
+
+#if ENABLE_HTTP_SERVER
+
+#include <ArduinoJson.h>
+#include <esp_http_server.h>
+
+#define RESP_CACHE_MAX_ENTRIES 8
+
+typedef int RespCacheId;
+#define RESP_CACHE_INVALID_ID (-1)
+
+// Fill doc with the response body. Return false to report failure (not cached).
+typedef bool (*RespCacheGenerator)(JsonDocument& doc);
+
+struct RespCacheBlob;
+
+// Register a cached response. maxAgeMs > 0 also expires the entry after that
+// long, for data with no explicit invalidation hook (e.g. sensor connection state).
+RespCacheId respCacheRegister(const char* name, RespCacheSource source, uint32_t maxAgeMs, RespCacheGenerator gen);
+
+// Bump a source version; entries depending on it regenerate on next access
+void respCacheInvalidate(RespCacheSource source);
+uint32_t respCacheVersion(RespCacheSource source);
+
+/**
+ * CachedResponse - RAII reference to the current bytes of a cache entry
+ *
+ * Usage:
+ *   CachedResponse resp(sSchemaCacheId);
+ *   if (!resp.ok()) { httpd_resp_send_500(req); return ESP_FAIL; }
+ *   httpd_resp_send(req, resp.data(), resp.length());
+ */
+class CachedResponse {
+public:
+  explicit CachedResponse(RespCacheId id);
+  ~CachedResponse();
+
+  CachedResponse(const CachedResponse&) = delete;
+  CachedResponse& operator=(const CachedResponse&) = delete;
+
+  bool ok() const { return _blob != nullptr; }
+  const char* data() const;
+  size_t length() const;
+
+private:
+  RespCacheBlob* _blob;
+};
+
+// Convenience: send entry as application/json (500 on generator failure)
+esp_err_t respCacheSend(httpd_req_t* req, RespCacheId id, const char* cacheControl = "no-cache");
+
+#else
+
+inline void respCacheInvalidate(RespCacheSource) {}
+
+#endif // ENABLE_HTTP_SERVER
+
+#endif // WEBSERVER_RESPONSE_CACHE_H
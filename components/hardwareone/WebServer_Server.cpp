@@ -33,6 +33,7 @@
 #include "System_Utils.h"
 #include "WebServer_Utils.h"
 #include "WebServer_Server.h"
+#include "WebServer_ResponseCache.h"
 #include "WebPage_Automations.h"
 #include "WebPage_CLI.h"
 #include "WebPage_Dashboard.h"
@@ -46,6 +47,7 @@
 #include "System_ESPSR.h"
 #include "System_Filesystem.h"
 #include "System_VFS.h"
+#include "System_FsService.h"
 #include "WebServer_MigrationTool.h"
 #if ENABLE_ESPNOW
 #include "System_ESPNow.h"
@@ -1536,6 +1538,76 @@ void streamCLIContent(httpd_req_t* req, const String& username) {
   streamEndHtml(req);
 }
 
+// Large internal-flash downloads are read by the fs service (one path-locked
+// chunk at a time) and handed to the httpd task through a one-chunk mailbox
+#define FILE_READ_ASYNC_MIN_BYTES (4 * FS_ASYNC_CHUNK_SIZE)
+
+struct FileReadMailbox {
+  uint8_t* buf;               // FS_ASYNC_CHUNK_SIZE bytes
+  volatile size_t len;        // Non-zero while a chunk waits for the httpd task
+  volatile bool aborted;      // Client gone: stop the read
+  volatile bool finished;     // onDone ran; no more chunks will arrive
+  bool ok;
+  SemaphoreHandle_t wake;     // Given on each new chunk and on completion
+};
+
+static FsAsyncChunkResult fileReadMailboxChunk(const uint8_t* data, size_t len, size_t offset, void* ctx) {
+  (void)offset;
+  FileReadMailbox* mb = (FileReadMailbox*)ctx;
+  if (mb->aborted) return FS_CHUNK_ABORT;
+  if (__atomic_load_n(&mb->len, __ATOMIC_ACQUIRE) != 0) return FS_CHUNK_RETRY;
+  memcpy(mb->buf, data, len);
+  __atomic_store_n(&mb->len, len, __ATOMIC_RELEASE);
+  xSemaphoreGive(mb->wake);
+  return FS_CHUNK_TAKEN;
+}
+
+static void fileReadMailboxDone(bool ok, size_t bytes, void* ctx) {
+  (void)bytes;
+  FileReadMailbox* mb = (FileReadMailbox*)ctx;
+  mb->ok = ok;
+  __atomic_store_n(&mb->finished, true, __ATOMIC_RELEASE);
+  xSemaphoreGive(mb->wake);
+}
+
+// Stream an internal file through fsAsyncRead. Returns false (nothing sent) if the
+// read could not be queued; otherwise *sent is the body length delivered and
+// *complete is false if the read failed or the client went away.
+static bool streamFileViaFsService(httpd_req_t* req, const String& path, size_t* sent, bool* complete) {
+  *sent = 0;
+  *complete = false;
+  FileReadMailbox mb = {};
+  mb.buf = (uint8_t*)ps_alloc(FS_ASYNC_CHUNK_SIZE, AllocPref::PreferPSRAM, "http.file.read");
+  mb.wake = xSemaphoreCreateBinary();
+  if (!mb.buf || !mb.wake ||
+      !fsAsyncRead(path.c_str(), 0, 0, fileReadMailboxChunk, fileReadMailboxDone, &mb)) {
+    if (mb.buf) free(mb.buf);
+    if (mb.wake) vSemaphoreDelete(mb.wake);
+    return false;
+  }
+
+  while (true) {
+    size_t n = __atomic_load_n(&mb.len, __ATOMIC_ACQUIRE);
+    if (n) {
+      if (!mb.aborted && httpd_resp_send_chunk(req, (const char*)mb.buf, n) != ESP_OK) {
+        WARN_WEBF("File download aborted by client: %s", path.c_str());
+        mb.aborted = true;
+      }
+      if (!mb.aborted) *sent += n;
+      __atomic_store_n(&mb.len, (size_t)0, __ATOMIC_RELEASE);
+      continue;
+    }
+    // finished is set after the last chunk was posted, so an empty mailbox now is final
+    if (__atomic_load_n(&mb.finished, __ATOMIC_ACQUIRE) && __atomic_load_n(&mb.len, __ATOMIC_ACQUIRE) == 0) break;
+    xSemaphoreTake(mb.wake, pdMS_TO_TICKS(100));
+  }
+
+  *complete = mb.ok && !mb.aborted;
+  free(mb.buf);
+  vSemaphoreDelete(mb.wake);
+  return true;
+}
+
 // Read raw file contents as text/plain
 esp_err_t handleFileRead(httpd_req_t* req) {
   DEBUG_STORAGEF("[handleFileRead] START");
@@ -1593,7 +1665,37 @@ esp_err_t handleFileRead(httpd_req_t* req) {
     return ESP_OK;
   }
 
-  FsLockGuard fsGuard("handleFileRead");
+  if (VFS::getStorageType(path) == VFS::INTERNAL) {
+    size_t internalSize = 0;
+    bool found = false;
+    {
+      FsPathReadGuard sizeGuard(path);
+      File probe = VFS::open(path, "r");
+      if (probe) {
+        found = true;
+        internalSize = probe.size();
+        probe.close();
+      }
+    }
+    // Large download: the fs service takes the path lock per chunk only, so a
+    // slow client does not keep writers of this file waiting for the whole body.
+    // Falls through to the inline loop if the service cannot take the request.
+    if (found && internalSize >= FILE_READ_ASYNC_MIN_BYTES) {
+      httpd_resp_set_type(req, "text/plain; charset=utf-8");
+      size_t totalSent = 0;
+      bool complete = false;
+      if (streamFileViaFsService(req, VFS::normalize(path), &totalSent, &complete)) {
+        if (!complete) WARN_STORAGEF("File download incomplete: %s (%u/%u bytes)", path.c_str(), (unsigned)totalSent, (unsigned)internalSize);
+        httpd_resp_send_chunk(req, NULL, 0);
+        DEBUG_STORAGEF("[handleFileRead] COMPLETE: Sent %d bytes via fs service", totalSent);
+        gSensorPollingPaused = wasPaused;
+        return ESP_OK;
+      }
+    }
+  }
+
+  // Per-path read lock: a long download only blocks writers of this file
+  FsPathReadGuard fsGuard(path);
 
   File f = VFS::open(path, "r");
   if (!f) {
@@ -1744,30 +1846,42 @@ esp_err_t handleFileWrite(httpd_req_t* req) {
 
   DEBUG_STORAGEF("[handleFileWrite] Opening file for write: %s", name.c_str());
 
-  FsLockGuard fsGuard("handleFileWrite");
-
-  File f = VFS::open(name, "w", true);
-  if (!f) {
-    ERROR_STORAGEF("Failed to open file for write: %s", name.c_str());
-    httpd_resp_set_type(req, "application/json");
-    httpd_resp_send(req, "{\"success\":false,\"error\":\"Open failed\"}", HTTPD_RESP_USE_STRLEN);
-    return ESP_OK;
-  }
-  DEBUG_STORAGEF("[handleFileWrite] File opened successfully");
+  if (VFS::getStorageType(name) == VFS::INTERNAL) {
+    // Chunked via the fs service: staged to <name>.part and renamed into place,
+    // with the path lock taken per chunk so other file users interleave
+    if (!fsChunkedWrite(VFS::normalize(name).c_str(), (const uint8_t*)content.c_str(), content.length(), false)) {
+      ERROR_STORAGEF("Failed to write file: %s", name.c_str());
+      httpd_resp_set_type(req, "application/json");
+      httpd_resp_send(req, "{\"success\":false,\"error\":\"Open failed\"}", HTTPD_RESP_USE_STRLEN);
+      return ESP_OK;
+    }
+    DEBUG_STORAGEF("[handleFileWrite] Wrote %d bytes via fs service", content.length());
+  } else {
+    FsPathWriteGuard fsGuard(name);
 
-  size_t left = content.length();
-  size_t pos = 0;
-  int writeChunks = 0;
-  while (left > 0) {
-    size_t chunk = left > 512 ? 512 : left;
-    size_t written = f.write((const uint8_t*)content.c_str() + pos, chunk);
-    writeChunks++;
-    DEBUG_STORAGEF("[handleFileWrite] Write chunk %d: %d bytes (requested %d)", writeChunks, written, chunk);
-    pos += chunk;
-    left -= chunk;
+    File f = VFS::open(name, "w", true);
+    if (!f) {
+      ERROR_STORAGEF("Failed to open file for write: %s", name.c_str());
+      httpd_resp_set_type(req, "application/json");
+      httpd_resp_send(req, "{\"success\":false,\"error\":\"Open failed\"}", HTTPD_RESP_USE_STRLEN);
+      return ESP_OK;
+    }
+    DEBUG_STORAGEF("[handleFileWrite] File opened successfully");
+
+    size_t left = content.length();
+    size_t pos = 0;
+    int writeChunks = 0;
+    while (left > 0) {
+      size_t chunk = left > 512 ? 512 : left;
+      size_t written = f.write((const uint8_t*)content.c_str() + pos, chunk);
+      writeChunks++;
+      DEBUG_STORAGEF("[handleFileWrite] Write chunk %d: %d bytes (requested %d)", writeChunks, written, chunk);
+      pos += chunk;
+      left -= chunk;
+    }
+    f.close();
+    DEBUG_STORAGEF("[handleFileWrite] File closed, wrote %d bytes in %d chunks", content.length(), writeChunks);
   }
-  f.close();
-  DEBUG_STORAGEF("[handleFileWrite] File closed, wrote %d bytes in %d chunks", content.length(), writeChunks);
 
 #if ENABLE_AUTOMATION
   // Post-save hooks for specific files
@@ -1791,6 +1905,7 @@ esp_err_t handleFileWrite(httpd_req_t* req) {
   }
 #endif
 
+  respCacheInvalidate(RESP_SRC_FILESYSTEM);
   httpd_resp_set_type(req, "application/json");
   httpd_resp_send(req, "{\"success\":true}", HTTPD_RESP_USE_STRLEN);
   DEBUG_STORAGEF("[handleFileWrite] COMPLETE: Success");
@@ -1980,12 +2095,12 @@ esp_err_t handleFileUpload(httpd_req_t* req) {
     }
     DEBUG_STORAGEF("[handleFileUpload] Opening file for write: %s", path.c_str());
 
-    fsLock("handleFileUpload.file");
-    fsLockedForUpload = true;
+    // Per-path write lock for the whole streamed upload; other files stay available
+    fsLockedForUpload = fsPathLock(path.c_str(), true);
     file = VFS::open(path, "w", true);
     if (!file) {
       ERROR_STORAGEF("Failed to open file for write: %s", path.c_str());
-      fsUnlock();
+      if (fsLockedForUpload) fsPathUnlock(path.c_str(), true);
       fsLockedForUpload = false;
       return false;
     }
@@ -2022,7 +2137,7 @@ esp_err_t handleFileUpload(httpd_req_t* req) {
       DEBUG_STORAGEF("[handleFileUpload] Recv error %d", ret);
       if (fileOpen) file.close();
       if (fsLockedForUpload) {
-        fsUnlock();
+        fsPathUnlock(path.c_str(), true);
         fsLockedForUpload = false;
       }
       free(uploadOutBuf);
@@ -2180,7 +2295,7 @@ esp_err_t handleFileUpload(httpd_req_t* req) {
       LittleFS.remove(path);
     }
     if (fsLockedForUpload) {
-      fsUnlock();
+      fsPathUnlock(path.c_str(), true);
       fsLockedForUpload = false;
     }
     DEBUG_STORAGEF("[handleFileUpload] ERROR: Insufficient storage space during write (wrote %d / free %d)", (int)totalWritten, (int)freeLimit);
@@ -2194,7 +2309,7 @@ esp_err_t handleFileUpload(httpd_req_t* req) {
 
   if (fileOpen) file.close();
   if (fsLockedForUpload) {
-    fsUnlock();
+    fsPathUnlock(path.c_str(), true);
     fsLockedForUpload = false;
   }
 
@@ -2262,6 +2377,7 @@ esp_err_t handleFileUpload(httpd_req_t* req) {
   gSensorPollingPaused = wasPaused;
   DEBUG_STORAGEF("[handleFileUpload] Sensor polling resumed");
 
+  respCacheInvalidate(RESP_SRC_FILESYSTEM);
   httpd_resp_set_type(req, "application/json");
   httpd_resp_send(req, "{\"success\":true}", HTTPD_RESP_USE_STRLEN);
   return ESP_OK;
@@ -2286,87 +2402,75 @@ esp_err_t handleSettingsPage(httpd_req_t* req) {
 }
 
 // Settings API (GET): return current settings as JSON
-// OPTIMIZED: Uses static buffer with snprintf to eliminate String allocations
+// Versioned response-cache entries; the settings body excludes passwords and the live SSID
+static RespCacheId sSettingsCacheId = RESP_CACHE_INVALID_ID;
+static RespCacheId sSettingsSchemaCacheId = RESP_CACHE_INVALID_ID;
+static RespCacheId sBuildConfigCacheId = RESP_CACHE_INVALID_ID;
+static RespCacheId sFilesStatsCacheId = RESP_CACHE_INVALID_ID;
+
+static bool generateSettingsJson(JsonDocument& doc) {
+  buildSettingsJsonDoc(doc, true);  // true = exclude WiFi passwords from web API
+  return true;
+}
+
 esp_err_t handleSettingsGet(httpd_req_t* req) {
   AuthContext ctx = makeWebAuthCtx(req);
   if (!tgRequireAuth(ctx)) return ESP_OK;
 
-  // Lock shared JSON response buffer
-  JsonBufferGuard jsonGuard("handleSettingsGet");
-  if (!jsonGuard.held) {
+  CachedResponse settings(sSettingsCacheId);
+  if (!settings.ok()) {
+    DEBUG_STORAGEF("[Settings API] Settings JSON generation failed");
     httpd_resp_send_500(req);
     return ESP_FAIL;
   }
 
-  // Build response using ArduinoJson
-  // Size hint: ~3584 for settings + 512 for wrapper
-  JsonDocument response;
-  
-  // Build settings object using unified builder (passwords excluded for security)
-  JsonObject settings = response["settings"].to<JsonObject>();
-  JsonDocument settingsDoc;
-  buildSettingsJsonDoc(settingsDoc, true);  // true = exclude WiFi passwords from web API
-  settings.set(settingsDoc.as<JsonObject>());
-  
-  // Add response envelope
-  response["success"] = true;
-  
-  // Add user info
-  JsonObject user = response["user"].to<JsonObject>();
-  user["username"] = ctx.user;
-  user["isAdmin"] = isAdminUser(ctx.user);
-  
-  // Add features
-  JsonObject features = response["features"].to<JsonObject>();
-  features["adminSessions"] = isAdminUser(ctx.user);
-  features["userApprovals"] = true;
-  features["adminControls"] = true;
-  features["sensorConfig"] = true;
-  features["bluetooth"] = (bool)(ENABLE_BLUETOOTH);
-  features["espnow"] = (bool)(ENABLE_ESPNOW);
-
-  // Serialize to buffer
-  size_t len = serializeJson(response, gJsonResponseBuffer, JSON_RESPONSE_SIZE);
-  
-  if (len == 0 || len >= JSON_RESPONSE_SIZE) {
-    // Serialization failed or buffer too small
-    DEBUG_STORAGEF("[Settings API] JSON serialization failed or buffer overflow");
+  // Per-user envelope around the shared settings bytes
+  bool isAdmin = isAdminUser(ctx.user);
+  char tail[320];
+  int tailLen = snprintf(tail, sizeof(tail),
+    ",\"success\":true,\"user\":{\"username\":\"%s\",\"isAdmin\":%s},"
+    "\"features\":{\"adminSessions\":%s,\"userApprovals\":true,\"adminControls\":true,"
+    "\"sensorConfig\":true,\"bluetooth\":%s,\"espnow\":%s}}",
+    jsonEscape(ctx.user).c_str(),
+    isAdmin ? "true" : "false",
+    isAdmin ? "true" : "false",
+    ENABLE_BLUETOOTH ? "true" : "false",
+    ENABLE_ESPNOW ? "true" : "false");
+  if (tailLen <= 0 || tailLen >= (int)sizeof(tail)) {
     httpd_resp_send_500(req);
     return ESP_FAIL;
   }
 
-  // DEBUG: Log buffer usage
-  int usagePct = (len * 100) / JSON_RESPONSE_SIZE;
-  DEBUG_MEMORYF("[JSON_RESP_BUF] Settings JSON: %zu/%u bytes (%d%%)",
-                len, (unsigned)JSON_RESPONSE_SIZE, usagePct);
+  // Connected SSID is live radio state: spliced into the settings object per
+  // request, since the cached bytes only change when settings are saved
+  char ssidField[256] = "";
+#if ENABLE_WIFI
+  {
+    String cur = WiFi.SSID();
+    if (cur.length() > 0 && settings.length() > 2 && settings.data()[0] == '{') {
+      snprintf(ssidField, sizeof(ssidField), "\"wifiPrimarySSID\":\"%s\",", jsonEscape(cur).c_str());
+    }
+  }
+#endif
+
+  DEBUG_MEMORYF("[Settings API] Settings JSON: %u bytes (cached)", (unsigned)settings.length());
 
   httpd_resp_set_type(req, "application/json");
-  httpd_resp_send(req, gJsonResponseBuffer, len);
+  httpd_resp_send_chunk(req, "{\"settings\":", HTTPD_RESP_USE_STRLEN);
+  if (ssidField[0]) {
+    httpd_resp_send_chunk(req, "{", 1);
+    httpd_resp_send_chunk(req, ssidField, HTTPD_RESP_USE_STRLEN);
+    httpd_resp_send_chunk(req, settings.data() + 1, settings.length() - 1);
+  } else {
+    httpd_resp_send_chunk(req, settings.data(), settings.length());
+  }
+  httpd_resp_send_chunk(req, tail, tailLen);
+  httpd_resp_send_chunk(req, NULL, 0);
   return ESP_OK;
 }
 
-// Settings Schema API (GET): return settings metadata for dynamic UI rendering
-esp_err_t handleSettingsSchema(httpd_req_t* req) {
-  AuthContext ctx = makeWebAuthCtx(req);
-  if (!tgRequireAuth(ctx)) return ESP_OK;
-
-  // Check buffer is allocated
-  if (!gJsonResponseBuffer) {
-    WARN_WEBF("[handleSettingsSchema] JSON response buffer not allocated");
-    httpd_resp_send_500(req);
-    return ESP_FAIL;
-  }
-
-  // Lock shared JSON response buffer (longer timeout since this may race with settings fetch)
-  JsonBufferGuard jsonGuard("handleSettingsSchema");
-  if (!jsonGuard.held) {
-    WARN_WEBF("[handleSettingsSchema] Mutex timeout - another request holding buffer");
-    httpd_resp_send_500(req);
-    return ESP_FAIL;
-  }
-
+static bool generateSettingsSchema(JsonDocument& doc) {
   // Build schema from registered settings modules
-  PSRAM_JSON_DOC(doc);
   JsonArray modules = doc["modules"].to<JsonArray>();
   
   size_t modCount = 0;
@@ -2453,27 +2557,17 @@ esp_err_t handleSettingsSchema(httpd_req_t* req) {
   }
   
   doc["count"] = modCount;
+  return true;
+}
 
-  DEBUG_HTTPF("[Schema] Serializing schema JSON...");
-
-  // Serialize to buffer
-  size_t len = serializeJson(doc, gJsonResponseBuffer, JSON_RESPONSE_SIZE);
-  
-  DEBUG_HTTPF("[Schema] Serialized %zu bytes (buffer size: %u)", len, (unsigned)JSON_RESPONSE_SIZE);
-  
-  if (len == 0 || len >= JSON_RESPONSE_SIZE) {
-    WARN_WEBF("[Schema] Serialization failed or buffer overflow: %zu >= %u", len, (unsigned)JSON_RESPONSE_SIZE);
-    httpd_resp_send_500(req);
-    return ESP_FAIL;
-  }
-
-  DEBUG_HTTPF("[Schema] Sending schema response (%zu bytes)", len);
-  httpd_resp_set_type(req, "application/json");
-  httpd_resp_set_hdr(req, "Cache-Control", "no-cache");
-  httpd_resp_send(req, gJsonResponseBuffer, len);
+// Settings Schema API (GET): return settings metadata for dynamic UI rendering.
+// Schema is static apart from module connection state, which the cache entry
+// refreshes on a short max-age.
+esp_err_t handleSettingsSchema(httpd_req_t* req) {
+  AuthContext ctx = makeWebAuthCtx(req);
+  if (!tgRequireAuth(ctx)) return ESP_OK;
 
-  DEBUG_HTTPF("[Schema] Schema response sent successfully");
-  return ESP_OK;
+  return respCacheSend(req, sSettingsSchemaCacheId);
 }
 
 esp_err_t handleUserSettingsGet(httpd_req_t* req) {
@@ -2663,43 +2757,35 @@ esp_err_t handleDeviceRegistryGet(httpd_req_t* req) {
   return ESP_OK;
 }
 
+static bool generateBuildConfig(JsonDocument& doc) {
+  doc["camera"] = (bool)ENABLE_CAMERA_SENSOR;
+  doc["microphone"] = (bool)ENABLE_MICROPHONE_SENSOR;
+  doc["bluetooth"] = (bool)ENABLE_BLUETOOTH;
+  doc["g2glasses"] = (bool)ENABLE_G2_GLASSES;
+  doc["mqtt"] = (bool)ENABLE_MQTT;
+  doc["espnow"] = (bool)ENABLE_ESPNOW;
+  doc["edgeimpulse"] = (bool)ENABLE_EDGE_IMPULSE;
+  doc["espsr"] = (bool)ENABLE_ESP_SR;
+  doc["automation"] = (bool)ENABLE_AUTOMATION;
+  doc["gps"] = (bool)ENABLE_GPS_SENSOR;
+  doc["imu"] = (bool)ENABLE_IMU_SENSOR;
+  doc["thermal"] = (bool)ENABLE_THERMAL_SENSOR;
+  doc["tof"] = (bool)ENABLE_TOF_SENSOR;
+  doc["gamepad"] = (bool)ENABLE_GAMEPAD_SENSOR;
+  doc["apds"] = (bool)ENABLE_APDS_SENSOR;
+  doc["fmradio"] = (bool)ENABLE_FM_RADIO;
+  doc["rtc"] = (bool)ENABLE_RTC_SENSOR;
+  doc["presence"] = (bool)ENABLE_PRESENCE_SENSOR;
+  return true;
+}
+
 // Build Configuration API (GET): return compile-time feature flags
 esp_err_t handleBuildConfig(httpd_req_t* req) {
   AuthContext ctx = makeWebAuthCtx(req);
   if (!tgRequireAuth(ctx)) return ESP_OK;
 
-  httpd_resp_set_type(req, "application/json");
-  httpd_resp_set_hdr(req, "Cache-Control", "max-age=3600"); // Cache for 1 hour since build config doesn't change
-
-  // Build JSON response with compile-time flags
-  char json[512];
-  snprintf(json, sizeof(json),
-    "{\"camera\":%s,\"microphone\":%s,\"bluetooth\":%s,\"g2glasses\":%s,"
-    "\"mqtt\":%s,\"espnow\":%s,\"edgeimpulse\":%s,\"espsr\":%s,"
-    "\"automation\":%s,\"gps\":%s,\"imu\":%s,\"thermal\":%s,"
-    "\"tof\":%s,\"gamepad\":%s,\"apds\":%s,\"fmradio\":%s,"
-    "\"rtc\":%s,\"presence\":%s}",
-    ENABLE_CAMERA_SENSOR    ? "true" : "false",
-    ENABLE_MICROPHONE_SENSOR? "true" : "false",
-    ENABLE_BLUETOOTH        ? "true" : "false",
-    ENABLE_G2_GLASSES       ? "true" : "false",
-    ENABLE_MQTT             ? "true" : "false",
-    ENABLE_ESPNOW           ? "true" : "false",
-    ENABLE_EDGE_IMPULSE     ? "true" : "false",
-    ENABLE_ESP_SR           ? "true" : "false",
-    ENABLE_AUTOMATION       ? "true" : "false",
-    ENABLE_GPS_SENSOR       ? "true" : "false",
-    ENABLE_IMU_SENSOR       ? "true" : "false",
-    ENABLE_THERMAL_SENSOR   ? "true" : "false",
-    ENABLE_TOF_SENSOR       ? "true" : "false",
-    ENABLE_GAMEPAD_SENSOR   ? "true" : "false",
-    ENABLE_APDS_SENSOR      ? "true" : "false",
-    ENABLE_FM_RADIO         ? "true" : "false",
-    ENABLE_RTC_SENSOR       ? "true" : "false",
-    ENABLE_PRESENCE_SENSOR  ? "true" : "false");
-
-  httpd_resp_send(req, json, HTTPD_RESP_USE_STRLEN);
-  return ESP_OK;
+  // Cache for 1 hour since build config doesn't change
+  return respCacheSend(req, sBuildConfigCacheId, "max-age=3600");
 }
 
 esp_err_t handleSessionsList(httpd_req_t* req) {
@@ -3679,6 +3765,17 @@ esp_err_t handleFilesList(httpd_req_t* req) {
   return ESP_OK;
 }
 
+static bool generateFilesStats(JsonDocument& doc) {
+  size_t totalBytes = LittleFS.totalBytes();
+  size_t usedBytes = LittleFS.usedBytes();
+  doc["success"] = true;
+  doc["total"] = (unsigned)totalBytes;
+  doc["used"] = (unsigned)usedBytes;
+  doc["free"] = (unsigned)(totalBytes - usedBytes);
+  doc["usagePercent"] = (totalBytes == 0) ? 0 : (int)((usedBytes * 100) / totalBytes);
+  return true;
+}
+
 esp_err_t handleFilesStats(httpd_req_t* req) {
   AuthContext ctx = makeWebAuthCtx(req);
   if (!tgRequireAuth(ctx)) return ESP_OK;
@@ -3689,18 +3786,7 @@ esp_err_t handleFilesStats(httpd_req_t* req) {
     return ESP_OK;
   }
 
-  size_t totalBytes = LittleFS.totalBytes();
-  size_t usedBytes = LittleFS.usedBytes();
-  size_t freeBytes = totalBytes - usedBytes;
-  int usagePercent = (totalBytes == 0) ? 0 : (usedBytes * 100) / totalBytes;
-
-  char json[128];
-  snprintf(json, sizeof(json), "{\"success\":true,\"total\":%u,\"used\":%u,\"free\":%u,\"usagePercent\":%d}",
-           (unsigned)totalBytes, (unsigned)usedBytes, (unsigned)freeBytes, usagePercent);
-
-  httpd_resp_set_type(req, "application/json");
-  httpd_resp_send(req, json, HTTPD_RESP_USE_STRLEN);
-  return ESP_OK;
+  return respCacheSend(req, sFilesStatsCacheId, nullptr);
 }
 
 esp_err_t handleFilesCreate(httpd_req_t* req) {
@@ -3763,6 +3849,7 @@ esp_err_t handleFilesCreate(httpd_req_t* req) {
     bool success = executeUnifiedWebCommand(req, ctx, cmd, resultStr);
     httpd_resp_set_type(req, "application/json");
     if (success && resultStr.startsWith("Created folder:")) {
+      respCacheInvalidate(RESP_SRC_FILESYSTEM);
       httpd_resp_send(req, "{\"success\":true}", HTTPD_RESP_USE_STRLEN);
     } else {
       // Extract error message and return as JSON
@@ -3784,6 +3871,7 @@ esp_err_t handleFilesCreate(httpd_req_t* req) {
     bool ok = executeUnifiedWebCommand(req, ctx, cmd, out);
     httpd_resp_set_type(req, "application/json");
     if (ok) {
+      respCacheInvalidate(RESP_SRC_FILESYSTEM);
       httpd_resp_send(req, "{\"success\":true}", HTTPD_RESP_USE_STRLEN);
     } else {
       char respBuf[256];
@@ -4195,11 +4283,17 @@ esp_err_t handleIconGet(httpd_req_t* req) {
     return ESP_OK;
   }
 
-  httpd_resp_set_type(req, "image/png");
-  httpd_resp_set_hdr(req, "Cache-Control", "public, max-age=86400");
-  
   const uint8_t* pngPtr = (const uint8_t*)pgm_read_ptr(&icon->pngData);
   size_t pngSize = (size_t)pgm_read_dword(&icon->pngSize);
+  if (!pngPtr || pngSize == 0) {
+    // Built with EMBEDDED_ICONS_PNG=0: only display bitmaps are embedded
+    httpd_resp_set_status(req, "404");
+    httpd_resp_send(req, "Icon PNG not embedded", HTTPD_RESP_USE_STRLEN);
+    return ESP_OK;
+  }
+
+  httpd_resp_set_type(req, "image/png");
+  httpd_resp_set_hdr(req, "Cache-Control", "public, max-age=86400");
 
   if (debug) {
     char sz[16];
@@ -4379,6 +4473,7 @@ esp_err_t handleFileDelete(httpd_req_t* req) {
   bool success = executeUnifiedWebCommand(req, ctx, deleteCmd, cmdOut);
 
   if (success) {
+    respCacheInvalidate(RESP_SRC_FILESYSTEM);
     httpd_resp_set_type(req, "application/json");
     httpd_resp_send(req, "{\"success\":true}", HTTPD_RESP_USE_STRLEN);
   } else {
@@ -4470,6 +4565,7 @@ esp_err_t handleFileRename(httpd_req_t* req) {
 
   httpd_resp_set_type(req, "application/json");
   if (success) {
+    respCacheInvalidate(RESP_SRC_FILESYSTEM);
     httpd_resp_send(req, "{\"success\":true}", HTTPD_RESP_USE_STRLEN);
   } else {
     httpd_resp_send(req, "{\"success\":false,\"error\":\"Rename failed\"}", HTTPD_RESP_USE_STRLEN);
@@ -4638,8 +4734,6 @@ esp_err_t handleAdminDenyUser(httpd_req_t* req) {
 // Automation export dependencies
 extern bool extractArrayByKey(const String& json, const char* key, String& out);
 extern bool extractArrayItem(const String& arrayStr, int& pos, String& out);
-extern bool parseJsonInt(const String& json, const char* key, int& out);
-extern bool parseJsonString(const String& json, const char* key, String& out);
 extern const char* AUTOMATIONS_JSON_FILE;
 
 esp_err_t handleAutomationsExport(httpd_req_t* req) {
@@ -4666,17 +4760,25 @@ esp_err_t handleAutomationsExport(httpd_req_t* req) {
         return ESP_OK;
       }
 
-      // Parse automations array to find target
+      // Parse automations array to find target; id and name come from one scan per item
       String targetAuto;
+      String name;
       int pos = 0;
       while (pos < (int)automationsArray.length()) {
         String item;
         if (!extractArrayItem(automationsArray, pos, item)) break;
 
+        JsonFieldSlot fields[2];
+        fields[0].key = "id";
+        fields[0].type = JSON_FIELD_INT;
+        fields[1].key = "name";
+        fields[1].type = JSON_FIELD_STRING;
+        jsonExtractFields(item, fields, 2);
+
         // Check if this automation has the target ID
-        int autoId = 0;
-        if (parseJsonInt(item, "id", autoId) && autoId == targetId) {
+        if (fields[0].found && (int)fields[0].i == targetId) {
           targetAuto = item;
+          if (fields[1].found) name = item.substring(fields[1].start, fields[1].start + fields[1].len);
           break;
         }
       }
@@ -4687,8 +4789,7 @@ esp_err_t handleAutomationsExport(httpd_req_t* req) {
       }
 
       // Generate filename from automation name
-      String name;
-      if (!parseJsonString(targetAuto, "name", name) || name.length() == 0) {
+      if (name.length() == 0) {
         name = "automation";
       }
       // Sanitize filename
@@ -5023,6 +5124,12 @@ void startHttpServer() {
 register_handlers:
 #endif
 
+  // Pre-serialized responses for hot read-only endpoints
+  sSettingsCacheId = respCacheRegister("settings", RESP_SRC_SETTINGS, 0, generateSettingsJson);
+  sSettingsSchemaCacheId = respCacheRegister("settings.schema", RESP_SRC_SETTINGS, 5000, generateSettingsSchema);
+  sBuildConfigCacheId = respCacheRegister("buildconfig", RESP_SRC_STATIC, 0, generateBuildConfig);
+  sFilesStatsCacheId = respCacheRegister("files.stats", RESP_SRC_FILESYSTEM, 10000, generateFilesStats);
+
   // Define URIs
   static httpd_uri_t root = { .uri = "/", .method = HTTP_GET, .handler = handleRoot, .user_ctx = NULL };
   static httpd_uri_t loginGet = { .uri = "/login", .method = HTTP_GET, .handler = handleLogin, .user_ctx = NULL };
@@ -83,7 +83,8 @@ static const OLEDModeEntry apdsOLEDModes[] = {
     apdsInputHandler,        // inputFunc - X toggles sensor
     true,                    // showInMenu
     35,                      // menuOrder
-    nullptr                  // hints
+    nullptr,                 // hints
+    OLED_REFRESH_POLL_LIVE   // refreshMs
   }
 };
 
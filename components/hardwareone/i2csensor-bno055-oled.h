@@ -101,7 +101,8 @@ static const OLEDModeEntry imuOLEDModes[] = {
     imuInputHandler,         // inputFunc - X toggles sensor
     true,                    // showInMenu
     40,                      // menuOrder
-    nullptr                  // hints
+    nullptr,                 // hints
+    OLED_REFRESH_LIVE_FAST   // refreshMs
   }
 };
 
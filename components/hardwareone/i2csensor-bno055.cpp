@@ -1082,9 +1082,9 @@ void imuTask(void* parameter) {
         });
         lastIMURead = nowMs;
         
-        // Mark OLED dirty if IMU page is active (enables real-time display updates)
-        if (result && currentOLEDMode == OLED_IMU_ACTIONS) {
-          oledMarkDirty();
+        // New reading for the IMU page (redrawn at most every refreshMs)
+        if (result) {
+          oledMarkDirtyMode(OLED_IMU_ACTIONS);
         }
         
         // Auto-disable if too many consecutive failures
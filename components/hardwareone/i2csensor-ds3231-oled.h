@@ -170,7 +170,8 @@ static const OLEDModeEntry rtcOLEDModes[] = {
     rtcInputHandler,         // inputFunc - X toggles sensor
     true,                    // showInMenu
     55,                      // menuOrder
-    nullptr                  // hints
+    nullptr,                 // hints
+    OLED_REFRESH_SLOW        // refreshMs
   }
 };
 
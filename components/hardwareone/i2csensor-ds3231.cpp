@@ -413,10 +413,8 @@ static void rtcTask(void* pvParameters) {
           gRTCCache.lastUpdate = now;
           xSemaphoreGive(gRTCCache.mutex);
         }
-        // Mark OLED dirty if RTC page is active (enables real-time display updates)
-        if (currentOLEDMode == OLED_RTC_DATA) {
-          oledMarkDirty();
-        }
+        // New reading for the RTC page (redrawn at most every refreshMs)
+        oledMarkDirtyMode(OLED_RTC_DATA);
 #if ENABLE_ESPNOW
         {
           char rtcJson[256];
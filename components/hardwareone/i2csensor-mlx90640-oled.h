@@ -6,6 +6,60 @@
 #include "OLED_Display.h"
 #include "OLED_Utils.h"
 #include <Adafruit_SSD1306.h>
+#if DISPLAY_IS_COLOR
+#include "HAL_TFTCompositor.h"
+#endif
+
+#if DISPLAY_IS_COLOR
+// Color panels: false-color image plus palette legend and readouts, composited
+// in bands and pushed once per band instead of per-pixel fills
+struct ThermalOverlayInfo {
+  int minTemp, avgTemp, maxTemp;
+  int16_t imageHeight;
+};
+
+static void thermalOverlay(TFTBandCanvas& canvas, void* userData) {
+  const ThermalOverlayInfo* info = (const ThermalOverlayInfo*)userData;
+  const uint16_t* palette = tftThermalPalette();
+  int16_t w = canvas.width();
+  int16_t legendY = info->imageHeight + 4;
+  for (int16_t x = 0; x < w; x++) {
+    canvas.drawFastVLine(x, legendY, 6, palette[(x * 255) / (w > 1 ? w - 1 : 1)]);
+  }
+  canvas.setTextSize(1);
+  canvas.setTextColor(DISPLAY_FG);
+  canvas.setCursor(0, legendY + 10);
+  canvas.printf("%d", info->minTemp);
+  canvas.setCursor(w / 2 - 18, legendY + 10);
+  canvas.printf("avg %d", info->avgTemp);
+  canvas.setCursor(w - 18, legendY + 10);
+  canvas.printf("%d", info->maxTemp);
+  canvas.setCursor(2, 2);
+  canvas.print("THERMAL");
+}
+
+static void displayThermalColor(int thermalWidth, int thermalHeight, float minTemp, float maxTemp, float avgTemp) {
+  // Snapshot the frame so the cache lock is not held across SPI transfers
+  static int16_t frame[768];
+  memcpy(frame, gThermalCache.thermalFrame, sizeof(frame));
+  unlockThermalCache();
+
+  int16_t imageW = SCREEN_WIDTH;
+  int16_t imageH = (int16_t)((imageW * thermalHeight) / thermalWidth);
+  if (imageH > OLED_CONTENT_HEIGHT - 24) {
+    imageH = OLED_CONTENT_HEIGHT - 24;
+    imageW = (int16_t)((imageH * thermalWidth) / thermalHeight);
+  }
+
+  ThermalOverlayInfo info = { (int)minTemp, (int)avgTemp, (int)maxTemp, imageH };
+  TFTCompositor comp(0, OLED_CONTENT_START_Y, SCREEN_WIDTH, OLED_CONTENT_HEIGHT, DISPLAY_BG);
+  comp.setThermal(frame, (uint8_t)thermalWidth, (uint8_t)thermalHeight,
+                  (int16_t)(minTemp * 100.0f), (int16_t)(maxTemp * 100.0f),
+                  (SCREEN_WIDTH - imageW) / 2, 0, imageW, imageH);
+  comp.setOverlay(thermalOverlay, &info);
+  comp.render(oledDisplay);
+}
+#endif
 
 // Thermal OLED display function - shows thermal visualization
 static void displayThermalVisual() {
@@ -39,6 +93,11 @@ static void displayThermalVisual() {
   // Adjust dimensions based on rotation setting
   const int thermalWidth = (gSettings.thermalRotation == 1 || gSettings.thermalRotation == 3) ? 24 : 32;
   const int thermalHeight = (gSettings.thermalRotation == 1 || gSettings.thermalRotation == 3) ? 32 : 24;
+
+#if DISPLAY_IS_COLOR
+  displayThermalColor(thermalWidth, thermalHeight, minTemp, maxTemp, avgTemp);
+#else
+
   const float scale = (gSettings.oledThermalScale > 0.0) ? gSettings.oledThermalScale : 2.5;
   const int imageWidth = (int)(thermalWidth * scale);
   const int textStartX = imageWidth + 2;
@@ -97,6 +156,7 @@ static void displayThermalVisual() {
   oledDisplay->setCursor(textStartX, 48);
   oledDisplay->print("Max:");
   oledDisplay->print((int)maxTemp);
+#endif
 }
 
 // Availability check for Thermal OLED mode
@@ -138,7 +198,8 @@ static const OLEDModeEntry thermalOLEDModes[] = {
     thermalInputHandler,     // inputFunc - X toggles sensor
     true,                    // showInMenu
     20,                      // menuOrder
-    nullptr                  // hints
+    nullptr,                 // hints
+    OLED_REFRESH_LIVE_FAST   // refreshMs
   }
 };
 
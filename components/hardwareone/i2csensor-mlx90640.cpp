@@ -595,10 +595,6 @@ bool readThermalPixels() {
   
   int result = gMLX90640->getFrame(g_tempFrame);
 
-  for (int i = 0; i < 768; i++) {
-    g_localFrame[i] = (int16_t)(g_tempFrame[i] * 100.0f);
-  }
-
   uint32_t afterCapture = millis();
   uint32_t captureTime = afterCapture - startTime;
 
@@ -626,132 +622,114 @@ bool readThermalPixels() {
     return false;
   }
 
-  static bool useSpatialDownsampling = true;
-  int32_t sumTemp = 0;
-  float minTemp = g_localFrame[0] / 100.0f;
-  float maxTemp = g_localFrame[0] / 100.0f;
-  int hottestX = 0, hottestY = 0;
-
-  if (useSpatialDownsampling) {
-    for (int row = 0; row < 24; row += 2) {
-      for (int col = 0; col < 32; col += 2) {
-        int i = row * 32 + col;
-        if (i < 768) {
-          int16_t tempCenti = g_localFrame[i];
-          float temp = tempCenti / 100.0f;
-          sumTemp += (int32_t)tempCenti;
-
-          if (temp < minTemp) minTemp = temp;
-          if (temp > maxTemp) {
-            maxTemp = temp;
-            hottestX = col;
-            hottestY = row;
-          }
-        }
-      }
-    }
-    sumTemp = sumTemp * 4;
-  } else {
-    for (int i = 0; i < 768; i++) {
-      float temp = g_localFrame[i] / 100.0f;
-      sumTemp += (int32_t)g_localFrame[i];
-
-      if (temp < minTemp) minTemp = temp;
-      if (temp > maxTemp) {
-        maxTemp = temp;
-        hottestX = i % 32;
-        hottestY = i / 32;
-      }
-    }
-  }
-
-  int32_t avgTempInt = sumTemp / 768;
-  float avgTemp = avgTempInt / 100.0f;
+  // Post-processing runs entirely in int16/int32 centi-degrees: one fused pass
+  // for conversion, statistics and temporal smoothing, one for outlier repair.
 
   static int16_t* previousFrame = nullptr;
   static bool previousFrameValid = false;
   
-  if (gSettings.thermalTemporalAlpha > 0.0f) {
+  if (gSettings.thermalTemporalAlpha > 0.0f && !previousFrame) {
+    previousFrame = (int16_t*)ps_alloc(768 * sizeof(int16_t), AllocPref::PreferPSRAM, "thermal.prev");
     if (!previousFrame) {
-      previousFrame = (int16_t*)ps_alloc(768 * sizeof(int16_t), AllocPref::PreferPSRAM, "thermal.prev");
-      if (!previousFrame) {
-        ERROR_SENSORSF("Failed to allocate previousFrame buffer");
-      } else {
-        INFO_SENSORSF("Allocated temporal smoothing buffer: 1536 bytes");
-      }
+      ERROR_SENSORSF("Failed to allocate previousFrame buffer");
+    } else {
+      INFO_SENSORSF("Allocated temporal smoothing buffer: 1536 bytes");
     }
-    
-    if (previousFrame && previousFrameValid) {
-      float alpha = gSettings.thermalTemporalAlpha;
-      for (int i = 0; i < 768; i++) {
-        float currentTemp = g_localFrame[i] / 100.0f;
-        float filtered = alpha * (previousFrame[i] / 100.0f) + (1.0f - alpha) * currentTemp;
-        g_localFrame[i] = (int16_t)(filtered * 100.0f);
+  }
+
+  // EMA weights in Q8 (prev + cur == 256); prev weight 0 disables smoothing
+  int32_t emaPrev = 0;
+  if (gSettings.thermalTemporalAlpha > 0.0f && previousFrame && previousFrameValid) {
+    emaPrev = (int32_t)(gSettings.thermalTemporalAlpha * 256.0f + 0.5f);
+    if (emaPrev > 256) emaPrev = 256;
+  }
+  const int32_t emaCur = 256 - emaPrev;
+
+  // Pass 1: float -> centi-degrees, raw min/max/mean on the 2x2-decimated grid,
+  // temporal EMA, and sum / sum-of-squares of the smoothed frame
+  int32_t rawSum = 0;
+  int32_t rawMin = INT16_MAX;
+  int32_t rawMax = INT16_MIN;
+  int32_t smoothSum = 0;
+  int64_t smoothSumSq = 0;
+
+  for (int row = 0; row < 24; row++) {
+    const float* src = g_tempFrame + row * 32;
+    int16_t* dst = g_localFrame + row * 32;
+    const int16_t* prev = emaPrev ? previousFrame + row * 32 : nullptr;
+    const bool sampleRow = (row & 1) == 0;
+    for (int col = 0; col < 32; col++) {
+      int32_t raw = (int16_t)(src[col] * 100.0f);
+      if (sampleRow && (col & 1) == 0) {
+        rawSum += raw;
+        if (raw < rawMin) rawMin = raw;
+        if (raw > rawMax) rawMax = raw;
+      }
+      int32_t v = raw;
+      if (prev) {
+        v = (emaPrev * prev[col] + emaCur * raw + 128) >> 8;
       }
+      dst[col] = (int16_t)v;
+      smoothSum += v;
+      smoothSumSq += (int64_t)v * v;
     }
   }
 
-  float variance = 0.0;
-  for (int i = 0; i < 768; i++) {
-    float temp = g_localFrame[i] / 100.0f;
-    float deviation = abs(temp - avgTemp);
-    variance += deviation * deviation;
-  }
-  float stdDev = sqrt(variance / 768.0);
+  const int32_t avgC = (rawSum * 4) / 768;
 
-  float outlierThreshold = 1.5 * stdDev;
-  float filteredMin = avgTemp + 50.0;
-  float filteredMax = avgTemp - 50.0;
-  float filteredSum = 0.0;
+  // Spread of the smoothed frame around the raw mean:
+  // sum((v - avg)^2) = sum(v^2) - 2*avg*sum(v) + N*avg^2
+  int64_t sqDev = smoothSumSq - 2LL * avgC * smoothSum + 768LL * avgC * avgC;
+  if (sqDev < 0) sqDev = 0;
+  const int32_t outlierThresholdC = (int32_t)(1.5f * sqrtf((float)(sqDev / 768)));
+
+  // Pass 2: filtered statistics over inliers; outliers are replaced in place by
+  // the mean of their inlier 3x3 neighbors (or the frame mean if none)
+  int32_t filteredMin = avgC + 5000;
+  int32_t filteredMax = avgC - 5000;
+  int32_t filteredSum = 0;
   int validPixels = 0;
 
-  for (int i = 0; i < 768; i++) {
-    float temp = g_localFrame[i] / 100.0f;
-    float deviation = abs(temp - avgTemp);
-
-    if (deviation <= outlierThreshold) {
-      if (temp < filteredMin) filteredMin = temp;
-      if (temp > filteredMax) {
-        filteredMax = temp;
-        hottestX = i % 32;
-        hottestY = i / 32;
+  for (int y = 0; y < 24; y++) {
+    for (int x = 0; x < 32; x++) {
+      int i = y * 32 + x;
+      int32_t v = g_localFrame[i];
+
+      if (abs(v - avgC) <= outlierThresholdC) {
+        if (v < filteredMin) filteredMin = v;
+        if (v > filteredMax) filteredMax = v;
+        filteredSum += v;
+        validPixels++;
+        continue;
       }
-      filteredSum += temp;
-      validPixels++;
-    } else {
-      int x = i % 32;
-      int y = i / 32;
-      float localSum = 0.0;
-      int localCount = 0;
 
-      for (int dy = -1; dy <= 1; dy++) {
-        for (int dx = -1; dx <= 1; dx++) {
-          if (dx == 0 && dy == 0) continue;
-          int nx = x + dx;
-          int ny = y + dy;
-          if (nx >= 0 && nx < 32 && ny >= 0 && ny < 24) {
-            int neighborIdx = ny * 32 + nx;
-            float neighborTemp = g_localFrame[neighborIdx] / 100.0f;
-            if (abs(neighborTemp - avgTemp) <= outlierThreshold) {
-              localSum += neighborTemp;
-              localCount++;
-            }
+      int32_t localSum = 0;
+      int localCount = 0;
+      int y0 = y > 0 ? y - 1 : 0, y1 = y < 23 ? y + 1 : 23;
+      int x0 = x > 0 ? x - 1 : 0, x1 = x < 31 ? x + 1 : 31;
+      for (int ny = y0; ny <= y1; ny++) {
+        const int16_t* nrow = g_localFrame + ny * 32;
+        for (int nx = x0; nx <= x1; nx++) {
+          if (nx == x && ny == y) continue;
+          int32_t n = nrow[nx];
+          if (abs(n - avgC) <= outlierThresholdC) {
+            localSum += n;
+            localCount++;
           }
         }
       }
-
-      if (localCount > 0) {
-        g_localFrame[i] = (int16_t)((localSum / localCount) * 100.0f);
-      } else {
-        g_localFrame[i] = (int16_t)(avgTemp * 100.0f);
-      }
+      g_localFrame[i] = (int16_t)(localCount > 0 ? localSum / localCount : avgC);
     }
   }
 
+  float minTemp = rawMin / 100.0f;
+  float maxTemp = rawMax / 100.0f;
+  float avgTemp = avgC / 100.0f;
+
   if (validPixels > 600) {
-    minTemp = filteredMin;
-    maxTemp = filteredMax;
-    avgTemp = filteredSum / validPixels;
+    minTemp = filteredMin / 100.0f;
+    maxTemp = filteredMax / 100.0f;
+    avgTemp = (float)filteredSum / validPixels / 100.0f;
   }
 
   static float rollingMin = 0.0f;
@@ -806,25 +784,16 @@ bool readThermalPixels() {
     gThermalCache.thermalLastUpdate = millis();
     gThermalCache.thermalDataValid = true;
     gThermalCache.thermalSeq++;
+#if ENABLE_OLED_DISPLAY
+    oledMarkDirtyMode(OLED_THERMAL_VISUAL);  // Frame ready: redraw the thermal view (rate-capped)
+#endif
 
     if (gThermalCache.thermalInterpolated && gThermalCache.thermalInterpolatedWidth > 0) {
       size_t psram_before_op = heap_caps_get_free_size(MALLOC_CAP_SPIRAM);
       size_t heap_before_op = heap_caps_get_free_size(MALLOC_CAP_8BIT);
 
       uint32_t interpStart = millis();
-      static float* floatFrame = nullptr;
-      if (!floatFrame) {
-        floatFrame = (float*)ps_alloc(768 * sizeof(float), AllocPref::PreferPSRAM, "thermal.float");
-        if (!floatFrame) {
-          ERROR_SENSORSF("Failed to allocate floatFrame buffer");
-          unlockThermalCache();
-          return true;
-        }
-      }
-      for (int i = 0; i < 768; i++) {
-        floatFrame[i] = g_localFrame[i] / 100.0f;
-      }
-      interpolateThermalFrame(floatFrame, gThermalCache.thermalInterpolated,
+      interpolateThermalFrame(g_localFrame, gThermalCache.thermalInterpolated,
                               gThermalCache.thermalInterpolatedWidth, gThermalCache.thermalInterpolatedHeight);
       uint32_t interpTime = millis() - interpStart;
 
@@ -1065,39 +1034,107 @@ int buildThermalDataJSON(char* buf, size_t bufSize) {
 // ============================================================================
 
 // Bilinear interpolation for thermal upscaling
-// Upscales 32x24 source to targetWidth x targetHeight
-void interpolateThermalFrame(const float* src, float* dst, int targetWidth, int targetHeight) {
+// Upscales the 32x24 centi-degree source to targetWidth x targetHeight (degrees C).
+//
+// Source offsets and Q12 weights depend only on the output size, so they are
+// built once per size and reused. The upscale itself is separable and integer:
+// pass 1 resamples each source row horizontally into rowBuf (centi * 4096),
+// pass 2 blends two of those rows vertically in 64-bit (centi * 2^24).
+
+#define THERMAL_INTERP_MAX_W (32 * 4)
+#define THERMAL_INTERP_MAX_H (24 * 4)
+#define THERMAL_INTERP_WBITS 12
+#define THERMAL_INTERP_ONE   (1 << THERMAL_INTERP_WBITS)
+
+struct ThermalInterpTables {
+  int width = 0;
+  int height = 0;
+  uint8_t x0[THERMAL_INTERP_MAX_W];
+  uint8_t x1[THERMAL_INTERP_MAX_W];
+  uint16_t wx[THERMAL_INTERP_MAX_W];  // Q12 weight of x1
+  uint8_t y0[THERMAL_INTERP_MAX_H];
+  uint8_t y1[THERMAL_INTERP_MAX_H];
+  uint16_t wy[THERMAL_INTERP_MAX_H];  // Q12 weight of y1
+  int32_t* rowBuf = nullptr;          // 24 rows x width, horizontally resampled
+};
+
+static ThermalInterpTables gThermalInterp;
+
+// Fill offsets/weights for mapping n outputs onto srcN inputs (endpoints aligned)
+static void buildInterpAxis(int n, int srcN, uint8_t* i0, uint8_t* i1, uint16_t* w) {
+  for (int i = 0; i < n; i++) {
+    if (n < 2) {
+      i0[i] = i1[i] = 0;
+      w[i] = 0;
+      continue;
+    }
+    int num = i * (srcN - 1);
+    int base = num / (n - 1);
+    int frac = num % (n - 1);
+    i0[i] = (uint8_t)base;
+    i1[i] = (uint8_t)(base + 1 < srcN ? base + 1 : srcN - 1);
+    w[i] = (uint16_t)((frac * THERMAL_INTERP_ONE + (n - 1) / 2) / (n - 1));
+  }
+}
+
+static bool prepareThermalInterpTables(int targetWidth, int targetHeight) {
+  ThermalInterpTables& t = gThermalInterp;
+  if (t.width == targetWidth && t.height == targetHeight && t.rowBuf) return true;
+  if (targetWidth < 1 || targetWidth > THERMAL_INTERP_MAX_W ||
+      targetHeight < 1 || targetHeight > THERMAL_INTERP_MAX_H) {
+    ERROR_SENSORSF("Thermal interpolation size %dx%d out of range", targetWidth, targetHeight);
+    return false;
+  }
+
+  if (t.rowBuf && t.width < targetWidth) {
+    free(t.rowBuf);
+    t.rowBuf = nullptr;
+  }
+  if (!t.rowBuf) {
+    t.rowBuf = (int32_t*)ps_alloc(24 * targetWidth * sizeof(int32_t), AllocPref::PreferPSRAM, "thermal.interp.rows");
+    if (!t.rowBuf) {
+      ERROR_SENSORSF("Failed to allocate thermal interpolation row buffer");
+      t.width = t.height = 0;
+      return false;
+    }
+  }
+
+  buildInterpAxis(targetWidth, 32, t.x0, t.x1, t.wx);
+  buildInterpAxis(targetHeight, 24, t.y0, t.y1, t.wy);
+  t.width = targetWidth;
+  t.height = targetHeight;
+  DEBUG_THERMAL_FRAMEF("Built interpolation tables for %dx%d", targetWidth, targetHeight);
+  return true;
+}
+
+void interpolateThermalFrame(const int16_t* srcCenti, float* dst, int targetWidth, int targetHeight) {
   const int srcWidth = 32;
   const int srcHeight = 24;
 
+  if (!prepareThermalInterpTables(targetWidth, targetHeight)) return;
+  const ThermalInterpTables& t = gThermalInterp;
+
+  // Pass 1: horizontal resample of every source row
+  for (int sy = 0; sy < srcHeight; sy++) {
+    const int16_t* srow = srcCenti + sy * srcWidth;
+    int32_t* hrow = t.rowBuf + sy * targetWidth;
+    for (int x = 0; x < targetWidth; x++) {
+      int32_t a = srow[t.x0[x]];
+      int32_t b = srow[t.x1[x]];
+      hrow[x] = a * (THERMAL_INTERP_ONE - t.wx[x]) + b * t.wx[x];
+    }
+  }
+
+  // Pass 2: vertical blend of two resampled rows
+  const float scale = 1.0f / (100.0f * (float)THERMAL_INTERP_ONE * (float)THERMAL_INTERP_ONE);
   for (int y = 0; y < targetHeight; y++) {
+    const int32_t* r0 = t.rowBuf + t.y0[y] * targetWidth;
+    const int32_t* r1 = t.rowBuf + t.y1[y] * targetWidth;
+    const int64_t w1 = t.wy[y];
+    const int64_t w0 = THERMAL_INTERP_ONE - w1;
+    float* out = dst + y * targetWidth;
     for (int x = 0; x < targetWidth; x++) {
-      // Map output coordinates to source coordinates
-      float srcX = (float)x * (srcWidth - 1) / (targetWidth - 1);
-      float srcY = (float)y * (srcHeight - 1) / (targetHeight - 1);
-
-      // Get the four neighboring source pixels
-      int x0 = (int)srcX;
-      int y0 = (int)srcY;
-      int x1 = min(x0 + 1, srcWidth - 1);
-      int y1 = min(y0 + 1, srcHeight - 1);
-
-      // Calculate interpolation weights
-      float fx = srcX - x0;
-      float fy = srcY - y0;
-
-      // Get source pixel values
-      float v00 = src[y0 * srcWidth + x0];
-      float v10 = src[y0 * srcWidth + x1];
-      float v01 = src[y1 * srcWidth + x0];
-      float v11 = src[y1 * srcWidth + x1];
-
-      // Bilinear interpolation
-      float v0 = v00 * (1.0f - fx) + v10 * fx;
-      float v1 = v01 * (1.0f - fx) + v11 * fx;
-      float value = v0 * (1.0f - fy) + v1 * fy;
-
-      dst[y * targetWidth + x] = value;
+      out[x] = (float)(r0[x] * w0 + r1[x] * w1) * scale;
     }
   }
 }
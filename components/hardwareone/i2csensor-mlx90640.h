@@ -89,8 +89,9 @@ bool readThermalPixels();
 // JSON building
 int buildThermalDataJSON(char* buf, size_t bufSize);
 
-// Thermal interpolation (defined in thermal_sensor.cpp)
-void interpolateThermalFrame(const float* src, float* dst, int targetWidth, int targetHeight);
+// Thermal interpolation: 32x24 centi-degree frame -> targetWidth x targetHeight degrees C
+// (table-driven fixed-point bilinear, max 4x)
+void interpolateThermalFrame(const int16_t* srcCenti, float* dst, int targetWidth, int targetHeight);
 
 // Thermal command registry (for system_utils.cpp module list)
 struct CommandEntry;
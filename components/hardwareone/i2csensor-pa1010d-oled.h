@@ -148,7 +148,8 @@ static const OLEDModeEntry gpsOLEDModes[] = {
     gpsInputHandler,         // inputFunc
     true,                    // showInMenu
     50,                      // menuOrder
-    "\x18\x19:Scroll  X:Toggle"  // hints (↑↓ when there's overflow, X always)
+    "\x18\x19:Scroll  X:Toggle", // hints (↑↓ when there's overflow, X always)
+    OLED_REFRESH_SLOW            // refreshMs
   }
 };
 
@@ -415,9 +415,9 @@ void gpsTask(void* parameter) {
         
         lastGPSRead = nowMs;
         
-        // Mark OLED dirty if GPS page is active (enables real-time display updates)
-        if (result && currentOLEDMode == OLED_GPS_DATA) {
-          oledMarkDirty();
+        // New fix data for the GPS page (redrawn at most every refreshMs)
+        if (result) {
+          oledMarkDirtyMode(OLED_GPS_DATA);
         }
         
         // Auto-disable if too many consecutive failures
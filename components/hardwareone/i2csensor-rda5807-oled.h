@@ -97,7 +97,8 @@ static const OLEDModeEntry fmRadioOLEDModes[] = {
     fmRadioInputHandler,     // inputFunc - X toggles radio
     true,                    // showInMenu
     60,                      // menuOrder
-    nullptr                  // hints
+    nullptr,                 // hints
+    OLED_REFRESH_POLL_LIVE   // refreshMs
   }
 };
 
@@ -104,7 +104,8 @@ static const OLEDModeEntry presenceOLEDModes[] = {
     presenceInputHandler,        // inputFunc - X toggles sensor
     true,                        // showInMenu
     36,                          // menuOrder (after APDS at 35)
-    nullptr                      // hints
+    nullptr,                     // hints
+    OLED_REFRESH_POLL_LIVE       // refreshMs
   }
 };
 
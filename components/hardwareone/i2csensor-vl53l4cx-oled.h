@@ -91,7 +91,8 @@ static const OLEDModeEntry tofOLEDModes[] = {
     tofInputHandler,         // inputFunc - X toggles sensor
     true,                    // showInMenu
     30,                      // menuOrder
-    nullptr                  // hints
+    nullptr,                 // hints
+    OLED_REFRESH_LIVE_FAST   // refreshMs
   }
 };
 
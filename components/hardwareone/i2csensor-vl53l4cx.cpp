@@ -467,6 +467,9 @@ bool readToFObjects() {
     gTofCache.tofLastUpdate = millis();
     gTofCache.tofDataValid = true;
     gTofCache.tofSeq++;
+#if ENABLE_OLED_DISPLAY
+    oledMarkDirtyMode(OLED_TOF_DATA);
+#endif
 
     if (isDebugFlagSet(DEBUG_TOF_FRAME)) {
       DEBUG_TOF_FRAMEF("readToFObjects: found=%d, valid=%d, seq=%lu",
@@ -0,0 +1,313 @@
+// Binary GPS tracks (.hwtrk) on the host.
+// - The chunk codec round-trips random chunks bit for bit: tiny and huge
+//   deltas, coordinates that wrap int32, repeated points and time steps; a
+//   full chunk stays within GPS_TRACK_CHUNK_BYTES; truncated payloads and
+//   chunks over maxPoints are rejected rather than misread.
+// - GPSTrackManager::importCSV() + loadTrack() give back every CSV point in
+//   order (readPoints() from any offset, across chunk boundaries), with the
+//   header's bounds, ends, distance and duration, and chunk boxes that hold
+//   their points. The CSV mixes HH:MM:SS lines crossing midnight, sensor log
+//   lines, comments, signal markers and junk. A .hwtrk opens directly, a
+//   changed CSV is imported again, and corrupt files are refused.
+//   gps_track_test <scratch dir>
+#include <Arduino.h>
+#include <LittleFS.h>
+
+#include <math.h>
+#include <algorithm>
+#include <string>
+#include <vector>
+
+#include "host_test.h"
+#include "System_Maps.h"
+
+static uint32_t sRng = 0x68E31DA4u;
+static uint32_t rnd() {
+  sRng ^= sRng << 13;
+  sRng ^= sRng >> 17;
+  sRng ^= sRng << 5;
+  return sRng;
+}
+static int32_t rndRange(int32_t lo, int32_t hi) { return lo + (int32_t)(rnd() % (uint32_t)(hi - lo + 1)); }
+
+static bool samePoint(const GPSTrackFixedPoint& a, const GPSTrackFixedPoint& b) {
+  return a.lat == b.lat && a.lon == b.lon && a.timeMs == b.timeMs;
+}
+
+static void checkCodec() {
+  std::vector<GPSTrackFixedPoint> pts(GPS_TRACK_CHUNK_MAX), back(GPS_TRACK_CHUNK_MAX + 1);
+  std::vector<uint8_t> payload(GPS_TRACK_CHUNK_BYTES + 64);
+  size_t largest = 0;
+  uint32_t chunks = 0;
+  for (int round = 0; round < 4000; round++) {
+    int count = round < 8 ? GPS_TRACK_CHUNK_MAX : rndRange(1, GPS_TRACK_CHUNK_MAX);
+    int mode = round % 4;  // walking pace, big jumps, full-range noise, repeats
+    GPSTrackFixedPoint p = { rndRange(-90000000, 90000000), rndRange(-180000000, 180000000), rnd() };
+    if (round % 8 == 0) p = { INT32_MAX - 3, INT32_MIN + 3, UINT32_MAX - 1000 };
+    for (int i = 0; i < count; i++) {
+      pts[i] = p;
+      if (mode == 0) {
+        p.lat += rndRange(-30, 30);
+        p.lon += rndRange(-30, 30);
+        p.timeMs += 1000;
+      } else if (mode == 1) {
+        p.lat += rndRange(-5000000, 5000000);
+        p.lon += rndRange(-5000000, 5000000);
+        p.timeMs += rnd() % 86400000u;
+      } else if (mode == 2) {
+        p.lat = (int32_t)rnd();
+        p.lon = (int32_t)rnd();
+        p.timeMs = rnd();  // Wraps: deltas are modulo 2^32
+      } else if (rnd() % 2) {
+        p.lat++;
+      }
+    }
+
+    size_t size = encodeTrackChunk(pts.data(), count, payload.data());
+    if (size > largest) largest = size;
+    HOST_CHECK(size <= GPS_TRACK_CHUNK_BYTES, "round %d: %d points encode to %zu bytes (limit %d)", round, count, size,
+               GPS_TRACK_CHUNK_BYTES);
+    int n = decodeTrackChunk(payload.data(), size, back.data(), GPS_TRACK_CHUNK_MAX);
+    bool same = n == count;
+    for (int i = 0; same && i < n; i++) same = samePoint(pts[i], back[i]);
+    HOST_CHECK(same, "round %d: %d points decode to %d, or differently", round, count, n);
+    chunks++;
+
+    if (count > 1) {
+      HOST_CHECK(decodeTrackChunk(payload.data(), size, back.data(), count - 1) == -1,
+                 "round %d: %d points decoded into room for %d", round, count, count - 1);
+    }
+    // Cut anywhere: a partial point is an error, a cut between points a short chunk
+    size_t cut = rndRange(0, (int32_t)size - 1);
+    int part = decodeTrackChunk(payload.data(), cut, back.data(), GPS_TRACK_CHUNK_MAX);
+    bool prefix = part < count;
+    for (int i = 0; prefix && i < part; i++) prefix = samePoint(pts[i], back[i]);
+    HOST_CHECK(cut < 12 ? part == -1 : prefix, "round %d: payload cut to %zu of %zu bytes decodes %d points", round,
+               cut, size, part);
+  }
+  // Worst case: every delta is 2^31 apart, five varint bytes each
+  for (int i = 0; i < GPS_TRACK_CHUNK_MAX; i++) {
+    pts[i].lat = (i % 2) ? INT32_MIN : 0;
+    pts[i].lon = (i % 2) ? 0 : INT32_MIN;
+    pts[i].timeMs = (uint32_t)i << 31;
+  }
+  size_t worst = encodeTrackChunk(pts.data(), GPS_TRACK_CHUNK_MAX, payload.data());
+  HOST_CHECK(worst == GPS_TRACK_CHUNK_BYTES, "worst-case chunk is %zu bytes, GPS_TRACK_CHUNK_BYTES %d", worst,
+             GPS_TRACK_CHUNK_BYTES);
+  int n = decodeTrackChunk(payload.data(), worst, back.data(), GPS_TRACK_CHUNK_MAX);
+  HOST_CHECK(n == GPS_TRACK_CHUNK_MAX && samePoint(back[n - 1], pts[n - 1]), "worst-case chunk decodes %d points", n);
+  HOST_CHECK(decodeTrackChunk(nullptr, 12, back.data(), 4) == -1 && decodeTrackChunk(payload.data(), 12, back.data(), 0) == -1,
+             "null payload or no room decoded");
+  printf("codec: %u chunks round-tripped, largest %zu bytes, worst case %zu\n", chunks, largest, worst);
+}
+
+struct CsvPoint { int32_t lat, lon; uint32_t timeMs; };
+
+// A long drive logged over midnight, with the other line kinds loadTrack accepts or skips
+static std::vector<CsvPoint> writeCsv(const std::string& path, int points, uint32_t startSec) {
+  FILE* f = fopen(path.c_str(), "w");
+  if (!f) return {};
+  fprintf(f, "# GPS Track\n# time,lat,lon,alt_m,speed_kn,satellites\n");
+  std::vector<CsvPoint> out;
+  int32_t lat = 47610000, lon = -122330000;
+  uint32_t sec = startSec, dayMs = 0, lastMs = 0;
+  for (int i = 0; i < points; i++) {
+    lat += rndRange(-40, 60);
+    lon += rndRange(-60, 40);
+    uint32_t ms;
+    if (i % 97 == 5) {
+      // Sensor log line: no clock, keeps the last time
+      fprintf(f, "gps: lat=%.6f lon=%.6f alt=10.5m speed=0.0kn sats=8 q=1\n", lat / 1e6, lon / 1e6);
+      ms = lastMs;
+    } else {
+      uint32_t s = sec % 86400;
+      uint32_t t = s * 1000 + dayMs;
+      if (i > 0 && t < lastMs) {
+        // Midnight, or (a few seconds back) a clock step that is clamped
+        if (lastMs - t > 12u * 3600000u) {
+          dayMs += 86400000u;
+          t += 86400000u;
+        } else {
+          t = lastMs;
+        }
+      }
+      fprintf(f, "%02u:%02u:%02u,%.6f,%.6f,12.0,3.1,9\n", s / 3600, s / 60 % 60, s % 60, lat / 1e6, lon / 1e6);
+      ms = t;
+      sec += (i % 300 == 7) ? (uint32_t)-3 : (uint32_t)rndRange(1, 3);
+    }
+    lastMs = ms;
+    out.push_back({ lat, lon, ms });
+    if (i % 211 == 3) fprintf(f, "12:00:00,---,SIGNAL_LOST\n");
+    if (i % 389 == 9) fprintf(f, "\n  \nnot a gps line\n12:00:01,95.0,10.0\n");
+  }
+  fclose(f);
+  return out;
+}
+
+static void checkLoaded(const char* label, const std::vector<CsvPoint>& expected) {
+  HOST_CHECK(GPSTrackManager::getPointCount() == (int)expected.size(), "%s: %d points loaded, CSV has %zu", label,
+             GPSTrackManager::getPointCount(), expected.size());
+  if (GPSTrackManager::getPointCount() != (int)expected.size()) return;
+  HOST_CHECK(GPSTrackManager::getPoints() == nullptr, "%s: binary track exposes in-RAM points", label);
+
+  // Whole track in odd-sized reads, then reads starting at every chunk seam
+  std::vector<GPSTrackPoint> buf(1000);
+  uint32_t at = 0, mismatches = 0;
+  int32_t minLat = INT32_MAX, maxLat = INT32_MIN;
+  double distanceM = 0;
+  while (at < expected.size()) {
+    int want = rndRange(1, 1000);
+    int n = GPSTrackManager::readPoints(at, buf.data(), want);
+    HOST_CHECK(n == (int)std::min<size_t>(want, expected.size() - at), "%s: readPoints(%u, %d) returned %d", label,
+               at, want, n);
+    if (n <= 0) return;
+    for (int i = 0; i < n; i++, at++) {
+      const CsvPoint& e = expected[at];
+      if (buf[i].lat != e.lat / 1000000.0f || buf[i].lon != e.lon / 1000000.0f || buf[i].timestamp != e.timeMs) {
+        if (mismatches++ < 5) {
+          HOST_CHECK(false, "%s: point %u is %.6f,%.6f @%lu, CSV %d,%d @%u", label, at, buf[i].lat, buf[i].lon,
+                     (unsigned long)buf[i].timestamp, e.lat, e.lon, e.timeMs);
+        }
+      }
+      minLat = std::min(minLat, e.lat);
+      maxLat = std::max(maxLat, e.lat);
+      if (at > 0) {
+        double mid = (expected[at - 1].lat + e.lat) * 0.5e-6 * M_PI / 180.0;
+        double dx = (double)(e.lon - expected[at - 1].lon) * cos(mid), dy = (double)(e.lat - expected[at - 1].lat);
+        distanceM += sqrt(dx * dx + dy * dy) * 0.111195;
+      }
+    }
+  }
+  for (uint32_t seam = GPS_TRACK_CHUNK_POINTS - 2; seam < expected.size(); seam += GPS_TRACK_CHUNK_POINTS) {
+    int n = GPSTrackManager::readPoints(seam, buf.data(), 4);
+    for (int i = 0; i < n; i++) {
+      HOST_CHECK(buf[i].lat == expected[seam + i].lat / 1000000.0f && buf[i].timestamp == expected[seam + i].timeMs,
+                 "%s: point %u read from a seam differs", label, seam + i);
+    }
+  }
+  HOST_CHECK(GPSTrackManager::readPoints((uint32_t)expected.size(), buf.data(), 4) == 0, "%s: read past the end", label);
+
+  const GPSTrackBounds& b = GPSTrackManager::getBounds();
+  HOST_CHECK(b.valid && b.minLat == minLat / 1000000.0f && b.maxLat == maxLat / 1000000.0f,
+             "%s: bounds %.6f..%.6f, points %d..%d", label, b.minLat, b.maxLat, minLat, maxLat);
+  const GPSTrackStats& st = GPSTrackManager::getStats();
+  double durationSec = (expected.back().timeMs - expected.front().timeMs) / 1000.0;
+  HOST_CHECK(st.valid && fabs(st.totalDistanceM - distanceM) <= distanceM * 1e-3 + 1,
+             "%s: distance %.1f m, points %.1f m", label, st.totalDistanceM, distanceM);
+  HOST_CHECK(fabs(st.durationSec - durationSec) < 0.01, "%s: duration %.1f s, points %.1f s", label, st.durationSec,
+             durationSec);
+  printf("%s: %zu points, %.1f km over %.1f h read back\n", label, expected.size(), distanceM / 1000,
+         durationSec / 3600);
+}
+
+// Header and chunk index as written, checked against the points
+static void checkFile(const std::string& path, const std::vector<CsvPoint>& expected, size_t csvSize) {
+  FILE* f = fopen(path.c_str(), "rb");
+  HOST_CHECK(f != nullptr, "%s not written", path.c_str());
+  if (!f) return;
+  std::vector<uint8_t> data;
+  int c;
+  while ((c = fgetc(f)) != EOF) data.push_back((uint8_t)c);
+  fclose(f);
+
+  GPSTrackFileHeader h;
+  memcpy(&h, data.data(), sizeof(h));
+  const CsvPoint& first = expected.front();
+  const CsvPoint& last = expected.back();
+  HOST_CHECK(h.pointCount == expected.size() && h.sourceSize == csvSize && h.startLat == first.lat &&
+                 h.startLon == first.lon && h.endLat == last.lat && h.endLon == last.lon &&
+                 h.durationMs == last.timeMs - first.timeMs,
+             "header: %u points, ends %d,%d / %d,%d, %u ms", h.pointCount, h.startLat, h.startLon, h.endLat, h.endLon,
+             h.durationMs);
+  HOST_CHECK(h.chunkCount == (expected.size() + GPS_TRACK_CHUNK_POINTS - 1) / GPS_TRACK_CHUNK_POINTS,
+             "header: %u chunks for %zu points", h.chunkCount, expected.size());
+
+  std::vector<GPSTrackFixedPoint> pts(GPS_TRACK_CHUNK_MAX);
+  uint32_t next = 0;
+  size_t payloadBytes = 0;
+  for (uint32_t k = 0; k < h.chunkCount; k++) {
+    GPSTrackChunkEntry e;
+    memcpy(&e, data.data() + h.indexOffset + k * sizeof(e), sizeof(e));
+    int n = decodeTrackChunk(data.data() + e.offset, e.size, pts.data(), GPS_TRACK_CHUNK_MAX);
+    HOST_CHECK(n == e.pointCount, "chunk %u: %d points decoded, index says %u", k, n, e.pointCount);
+    if (n != e.pointCount) return;
+    payloadBytes += e.size;
+    uint32_t idx = k > 0 ? next - 1 : 0;  // The overlap point repeats the previous chunk's last
+    for (int i = 0; i < n; i++, idx++) {
+      const GPSTrackFixedPoint& p = pts[i];
+      HOST_CHECK(p.lat >= e.minLat && p.lat <= e.maxLat && p.lon >= e.minLon && p.lon <= e.maxLon,
+                 "chunk %u: point %d outside the chunk box", k, i);
+      HOST_CHECK(idx < expected.size() && p.lat == expected[idx].lat && p.lon == expected[idx].lon &&
+                     p.timeMs == expected[idx].timeMs,
+                 "chunk %u: point %d is not CSV point %u", k, i, idx);
+    }
+    next = idx;
+  }
+  HOST_CHECK(next == expected.size(), "chunks hold %u points, CSV %zu", next, expected.size());
+  printf("file: %zu CSV bytes -> %zu (%.1f bytes/point in chunks)\n", csvSize, data.size(),
+         (double)payloadBytes / expected.size());
+}
+
+int main(int argc, char** argv) {
+  if (argc < 2) {
+    fprintf(stderr, "usage: %s <scratch dir>\n", argv[0]);
+    return 2;
+  }
+  checkCodec();
+
+  std::string dir = argv[1];
+  hostFsSetRoot(dir.c_str());
+  remove((dir + "/drive.csv.hwtrk").c_str());
+  std::vector<CsvPoint> expected = writeCsv(dir + "/drive.csv", 20000, 23 * 3600 + 1000);
+  FILE* f = fopen((dir + "/drive.csv").c_str(), "rb");
+  fseek(f, 0, SEEK_END);
+  size_t csvSize = (size_t)ftell(f);
+  fclose(f);
+
+  String err;
+  HOST_CHECK(GPSTrackManager::loadTrack("/drive.csv", err), "loadTrack(drive.csv): %s", err.c_str());
+  checkLoaded("csv", expected);
+  checkFile(dir + "/drive.csv.hwtrk", expected, csvSize);
+
+  // The import is reused; opening the .hwtrk itself gives the same track
+  HOST_CHECK(GPSTrackManager::loadTrack("/drive.csv", err), "reload: %s", err.c_str());
+  checkLoaded("cached", expected);
+  HOST_CHECK(GPSTrackManager::loadTrack("/drive.csv.hwtrk", err), "loadTrack(.hwtrk): %s", err.c_str());
+  checkLoaded("hwtrk", expected);
+
+  // A changed CSV (different size) is imported again
+  GPSTrackManager::clearTrack();
+  expected = writeCsv(dir + "/drive.csv", 700, 8 * 3600);
+  HOST_CHECK(GPSTrackManager::loadTrack("/drive.csv", err), "loadTrack(changed csv): %s", err.c_str());
+  checkLoaded("changed", expected);
+
+  // Damaged files: bad magic, index past the end, truncated payloads
+  GPSTrackManager::clearTrack();
+  std::vector<uint8_t> good;
+  f = fopen((dir + "/drive.csv.hwtrk").c_str(), "rb");
+  for (int c; (c = fgetc(f)) != EOF;) good.push_back((uint8_t)c);
+  fclose(f);
+  auto refused = [&](const char* what, std::vector<uint8_t> bytes) {
+    FILE* out = fopen((dir + "/bad.hwtrk").c_str(), "wb");
+    fwrite(bytes.data(), 1, bytes.size(), out);
+    fclose(out);
+    bool loaded = GPSTrackManager::loadTrack("/bad.hwtrk", err);
+    HOST_CHECK(!loaded && !GPSTrackManager::hasTrack(), "%s: loaded", what);
+  };
+  std::vector<uint8_t> bad = good;
+  bad[0] = 'X';
+  refused("bad magic", bad);
+  refused("truncated index", std::vector<uint8_t>(good.begin(), good.end() - 5));
+  bad = good;
+  bad.resize(sizeof(GPSTrackFileHeader) + 10);
+  refused("truncated payloads", bad);
+  refused("header only", std::vector<uint8_t>(good.begin(), good.begin() + sizeof(GPSTrackFileHeader)));
+
+  f = fopen((dir + "/empty.csv").c_str(), "w");
+  fprintf(f, "# nothing\nSIGNAL_LOST\n");
+  fclose(f);
+  HOST_CHECK(!GPSTrackManager::loadTrack("/empty.csv", err) && !LittleFS.exists("/empty.csv.hwtrk"),
+             "CSV without points imported");
+  GPSTrackManager::clearTrack();
+  return hostTestResult("gps_track_test");
+}
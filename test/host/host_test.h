@@ -0,0 +1,26 @@
+// Minimal checks for the host tests: each failed HOST_CHECK prints its location
+// and message, and hostTestResult() turns the count into the exit code.
+#pragma once
+
+#include <stdio.h>
+
+inline int gHostTestFailures = 0;
+
+#define HOST_CHECK(cond, ...)                                       \
+  do {                                                              \
+    if (!(cond)) {                                                  \
+      gHostTestFailures++;                                          \
+      printf("FAIL %s:%d: ", __FILE__, __LINE__);                   \
+      printf(__VA_ARGS__);                                          \
+      printf("\n");                                                 \
+    }                                                               \
+  } while (0)
+
+inline int hostTestResult(const char* name) {
+  if (gHostTestFailures) {
+    printf("%s: %d check(s) failed\n", name, gHostTestFailures);
+    return 1;
+  }
+  printf("%s: OK\n", name);
+  return 0;
+}
@@ -0,0 +1,159 @@
+// Range and If-None-Match parsing for the map tile API (WebServer_HttpHeaders).
+// - parseByteRange(): RFC 7233 single ranges (first-last, open-ended, suffix)
+//   clamp to the body, unsatisfiable ones answer 416, and anything the handler
+//   should ignore (other units, several ranges, junk, reversed spans) sends the
+//   whole body. Random spans against random sizes check the arithmetic at the
+//   edges (0, size - 1, size, 2^32 - 1 and beyond).
+// - etagListMatches(): "*", lists with spaces, weak tags, tags holding commas,
+//   prefixes/suffixes of the tag and unterminated quotes.
+//   http_headers_test
+#include <stdio.h>
+#include <string.h>
+
+#include <string>
+
+#include "host_test.h"
+#include "WebServer_HttpHeaders.h"
+
+static uint32_t sRng = 0x85EBCA6Bu;
+static uint32_t rnd() {
+  sRng ^= sRng << 13;
+  sRng ^= sRng >> 17;
+  sRng ^= sRng << 5;
+  return sRng;
+}
+
+static void checkRange(const char* hdr, uint32_t size, int expected, uint32_t expFirst = 0, uint32_t expLast = 0) {
+  uint32_t first = 0xDEADBEEF, last = 0xDEADBEEF;
+  int r = parseByteRange(hdr, size, first, last);
+  bool ok = r == expected && (r != 1 || (first == expFirst && last == expLast));
+  HOST_CHECK(ok, "'%s' of %u bytes: %d [%u, %u], expected %d [%u, %u]", hdr ? hdr : "(null)", size, r, first, last,
+             expected, expFirst, expLast);
+}
+
+static void checkRanges() {
+  // Satisfiable
+  checkRange("bytes=0-0", 100, 1, 0, 0);
+  checkRange("bytes=0-99", 100, 1, 0, 99);
+  checkRange("bytes=0-", 100, 1, 0, 99);
+  checkRange("bytes=10-19", 100, 1, 10, 19);
+  checkRange("bytes=99-", 100, 1, 99, 99);
+  checkRange("bytes=50-5000", 100, 1, 50, 99);
+  checkRange("bytes=0-18446744073709551615", 100, 1, 0, 99);
+  checkRange("bytes=0-99999999999999999999999", 100, 1, 0, 99);
+  checkRange("bytes=-1", 100, 1, 99, 99);
+  checkRange("bytes=-30", 100, 1, 70, 99);
+  checkRange("bytes=-100", 100, 1, 0, 99);
+  checkRange("bytes=-101", 100, 1, 0, 99);
+  checkRange("bytes=-99999999999999999999", 100, 1, 0, 99);
+  checkRange("bytes= 10-19 ", 100, 1, 10, 19);
+  checkRange("bytes=4294967294-", 4294967295u, 1, 4294967294u, 4294967294u);
+  checkRange("bytes=0-", 4294967295u, 1, 0, 4294967294u);
+  checkRange("bytes=-4294967295", 4294967295u, 1, 0, 4294967294u);
+  checkRange("bytes=007-010", 100, 1, 7, 10);
+
+  // Unsatisfiable: 416
+  checkRange("bytes=100-", 100, -1);
+  checkRange("bytes=100-200", 100, -1);
+  checkRange("bytes=4294967296-", 100, -1);
+  checkRange("bytes=99999999999999999999999-", 100, -1);
+  checkRange("bytes=-0", 100, -1);
+  checkRange("bytes=0-0", 0, -1);
+  checkRange("bytes=0-", 0, -1);
+  checkRange("bytes=-5", 0, -1);
+
+  // Ignored: whole body
+  const char* ignored[] = {
+    nullptr, "", "bytes", "bytes=", "bytes=-", "bytes=--5", "bytes=5", "bytes=a-b", "bytes=5-a", "bytes=1-2,4-5",
+    "bytes=0-0,", "bytes=,0-0", "bytes=20-10", "bytes=5--6", "bytes=+5-6", "bytes=5-+6", "bytes=-+5", "bytes=- 5",
+    "bytes=5 -6", "bytes=5- 6", "bytes=0x10-0x20", "bytes=-5-", "items=0-5", "Bytes=0-5", " bytes=0-5",
+    "bytes=0-5;x", "bytes=1.5-2",
+  };
+  for (const char* hdr : ignored) checkRange(hdr, 100, 0);
+
+  // Random spans against random sizes, near the edges
+  uint32_t checked = 0;
+  for (int i = 0; i < 200000; i++) {
+    uint32_t size = (i % 3 == 0) ? rnd() : rnd() % 64;
+    uint64_t picks[] = { 0, 1, size, (uint64_t)size + 1, size ? size - 1u : 0u, rnd(), rnd() % 128, 0xFFFFFFFFull,
+                         0x100000000ull, ~0ull };
+    uint64_t a = picks[rnd() % 10], b = picks[rnd() % 10];
+    char hdr[64];
+    int kind = rnd() % 3;
+    if (kind == 0) {
+      snprintf(hdr, sizeof(hdr), "bytes=%llu-%llu", (unsigned long long)a, (unsigned long long)b);
+      if (b < a) checkRange(hdr, size, 0);
+      else if (a >= size) checkRange(hdr, size, -1);
+      else checkRange(hdr, size, 1, (uint32_t)a, b >= size ? size - 1 : (uint32_t)b);
+    } else if (kind == 1) {
+      snprintf(hdr, sizeof(hdr), "bytes=%llu-", (unsigned long long)a);
+      if (a >= size) checkRange(hdr, size, -1);
+      else checkRange(hdr, size, 1, (uint32_t)a, size - 1);
+    } else {
+      snprintf(hdr, sizeof(hdr), "bytes=-%llu", (unsigned long long)b);
+      if (b == 0 || size == 0) checkRange(hdr, size, -1);
+      else checkRange(hdr, size, 1, b >= size ? 0 : (uint32_t)(size - b), size - 1);
+    }
+    checked++;
+  }
+  printf("ranges: %zu ignored forms, %u random spans\n", sizeof(ignored) / sizeof(ignored[0]), checked);
+}
+
+static void checkEtag(const char* hdr, const char* etag, bool expected) {
+  HOST_CHECK(etagListMatches(hdr, etag) == expected, "If-None-Match '%s' vs %s: expected %s", hdr ? hdr : "(null)",
+             etag, expected ? "match" : "no match");
+}
+
+static void checkEtags() {
+  const char* tag = "\"1a2b3c4d-t17\"";
+  checkEtag(nullptr, tag, false);
+  checkEtag("", tag, false);
+  checkEtag("   ", tag, false);
+  checkEtag(",,", tag, false);
+  checkEtag("*", tag, true);
+  checkEtag(" * ", tag, true);
+  checkEtag("\"x\", *", tag, true);
+  checkEtag("\"1a2b3c4d-t17\"", tag, true);
+  checkEtag("W/\"1a2b3c4d-t17\"", tag, true);  // If-None-Match compares weakly
+  checkEtag("\"aaa\", \"1a2b3c4d-t17\"", tag, true);
+  checkEtag("\"aaa\",\"1a2b3c4d-t17\",\"bbb\"", tag, true);
+  checkEtag("\t\"aaa\" ,\t W/\"1a2b3c4d-t17\" ", tag, true);
+  checkEtag("\"1a2b3c4d-t1\"", tag, false);
+  checkEtag("\"1a2b3c4d-t170\"", tag, false);
+  checkEtag("\"1a2b3c4d\"", tag, false);
+  checkEtag("1a2b3c4d-t17", tag, false);
+  checkEtag("\"1A2B3C4D-t17\"", tag, false);
+  checkEtag("w/\"1a2b3c4d-t17\"", tag, false);
+  checkEtag("W/ \"1a2b3c4d-t17\"", tag, false);
+  checkEtag("\"**\"", tag, false);
+  checkEtag("\"*\"", tag, false);
+  checkEtag("**", tag, false);
+  // A comma inside another quoted tag does not start a new one
+  checkEtag("\"x,\"1a2b3c4d-t17\"", tag, false);
+  checkEtag("\"a, \"1a2b3c4d-t17\"\"", tag, false);
+  checkEtag("\"1a2b3c4d-t17", tag, false);
+  checkEtag("\"1a2b3c4d-t17\"junk, \"zzz\"", tag, true);
+  checkEtag("\"zzz\" junk \"1a2b3c4d-t17\"", tag, false);
+  checkEtag("\"zzz\" junk, \"1a2b3c4d-t17\"", tag, true);
+
+  // Every list of a few tags, with the tag at each position
+  const char* others[] = { "\"a\"", "W/\"b\"", "\"1a2b3c4d-t1\"", "\"c,d\"", "\"\"" };
+  uint32_t lists = 0;
+  for (int len = 1; len <= 4; len++) {
+    for (int at = -1; at < len; at++, lists++) {
+      std::string hdr;
+      for (int i = 0; i < len; i++) {
+        if (i) hdr += (i % 2) ? ", " : ",";
+        hdr += (i == at) ? std::string(tag) : std::string(others[(i + len) % 5]);
+      }
+      checkEtag(hdr.c_str(), tag, at >= 0);
+    }
+  }
+  printf("etags: %u generated lists\n", lists);
+}
+
+int main() {
+  checkRanges();
+  checkEtags();
+  return hostTestResult("http_headers_test");
+}
@@ -0,0 +1,306 @@
+#include "hwmap_encode.h"
+
+#include <math.h>
+#include <stdio.h>
+#include <string.h>
+#include <algorithm>
+
+#include "System_Maps.h"
+
+static void putU16(std::vector<uint8_t>& out, uint16_t v) {
+  out.push_back((uint8_t)v);
+  out.push_back((uint8_t)(v >> 8));
+}
+
+static void putU32(std::vector<uint8_t>& out, uint32_t v) {
+  for (int i = 0; i < 4; i++) out.push_back((uint8_t)(v >> (8 * i)));
+}
+
+static void setU32(std::vector<uint8_t>& out, size_t at, uint32_t v) {
+  for (int i = 0; i < 4; i++) out[at + i] = (uint8_t)(v >> (8 * i));
+}
+
+static uint16_t typeBit(uint8_t type) {
+  switch (type) {
+    case MAP_FEATURE_HIGHWAY:    return HWMAP_FTYPE_HIGHWAY;
+    case MAP_FEATURE_ROAD_MAJOR: return HWMAP_FTYPE_MAJOR;
+    case MAP_FEATURE_ROAD_MINOR: return HWMAP_FTYPE_MINOR;
+    case MAP_FEATURE_PATH:       return HWMAP_FTYPE_PATH;
+    case MAP_FEATURE_WATER:      return HWMAP_FTYPE_WATER;
+    case MAP_FEATURE_PARK:       return HWMAP_FTYPE_PARK;
+    case MAP_FEATURE_LAND_MASK:  return HWMAP_FTYPE_LAND;
+    case MAP_FEATURE_RAILWAY:    return HWMAP_FTYPE_RAILWAY;
+    case MAP_FEATURE_BUS:        return HWMAP_FTYPE_BUS;
+    case MAP_FEATURE_FERRY:      return HWMAP_FTYPE_FERRY;
+    case MAP_FEATURE_BUILDING:   return HWMAP_FTYPE_BUILDING;
+    case MAP_FEATURE_STATION:    return HWMAP_FTYPE_STATION;
+    default: return HWMAP_FTYPE_OTHER;
+  }
+}
+
+static void putVarint(std::vector<uint8_t>& out, uint32_t v) {
+  while (v >= 0x80) {
+    out.push_back((uint8_t)(v | 0x80));
+    v >>= 7;
+  }
+  out.push_back((uint8_t)v);
+}
+
+// Shortest delta mod 2^16, zigzagged (the reader adds it back with uint16 wrap)
+static uint32_t zigzagDelta(uint16_t from, uint16_t to) {
+  int32_t d = (int16_t)(uint16_t)(to - from);
+  return ((uint32_t)d << 1) ^ (uint32_t)(d >> 31);
+}
+
+static uint32_t headerKey(const HWMapEncTileFeature& f) {
+  return f.type | (f.subtype << 8) | ((uint32_t)f.nameIndex << 16);
+}
+
+std::vector<uint8_t> hwmapEncodeTile(const std::vector<HWMapEncTileFeature>& features, uint16_t version) {
+  std::vector<uint8_t> out;
+  if (version != 6 && version != 7) return out;
+  putU16(out, (uint16_t)features.size());
+  if (version == 6) {
+    for (const HWMapEncTileFeature& f : features) {
+      out.push_back(f.type);
+      out.push_back(f.subtype);
+      putU16(out, f.nameIndex);
+      putU16(out, (uint16_t)(f.points.size() / 2));
+      for (uint16_t q : f.points) putU16(out, q);
+    }
+    return out;
+  }
+
+  // Dictionary only when some header repeats, in first-use order
+  std::vector<uint32_t> dict;
+  for (const HWMapEncTileFeature& f : features) {
+    if (std::find(dict.begin(), dict.end(), headerKey(f)) == dict.end()) dict.push_back(headerKey(f));
+  }
+  const bool useDict = dict.size() < features.size();
+  out.push_back(useDict ? HWMAP_TILE_HAS_DICT : 0);
+  if (useDict) {
+    putVarint(out, (uint32_t)dict.size());
+    for (uint32_t key : dict) putU32(out, key);
+  }
+  for (const HWMapEncTileFeature& f : features) {
+    if (useDict) {
+      putVarint(out, (uint32_t)(std::find(dict.begin(), dict.end(), headerKey(f)) - dict.begin()));
+    } else {
+      putU32(out, headerKey(f));
+    }
+    std::vector<uint8_t> pts;
+    for (size_t i = 0; i < f.points.size(); i += 2) {
+      if (i == 0) {
+        putVarint(pts, f.points[0]);
+        putVarint(pts, f.points[1]);
+      } else {
+        putVarint(pts, zigzagDelta(f.points[i - 2], f.points[i]));
+        putVarint(pts, zigzagDelta(f.points[i - 1], f.points[i + 1]));
+      }
+    }
+    putVarint(out, (uint32_t)(f.points.size() / 2));
+    putVarint(out, (uint32_t)pts.size());
+    out.insert(out.end(), pts.begin(), pts.end());
+  }
+  return out;
+}
+
+// Liang-Barsky: clip segment a-b to the box; false if nothing is left
+static bool clipSegment(double& lat0, double& lon0, double& lat1, double& lon1,
+                        double minLat, double minLon, double maxLat, double maxLon) {
+  double t0 = 0.0, t1 = 1.0;
+  const double dLat = lat1 - lat0, dLon = lon1 - lon0;
+  const double p[4] = { -dLon, dLon, -dLat, dLat };
+  const double q[4] = { lon0 - minLon, maxLon - lon0, lat0 - minLat, maxLat - lat0 };
+  for (int i = 0; i < 4; i++) {
+    if (p[i] == 0.0) {
+      if (q[i] < 0.0) return false;
+      continue;
+    }
+    double r = q[i] / p[i];
+    if (p[i] < 0.0) {
+      if (r > t1) return false;
+      if (r > t0) t0 = r;
+    } else {
+      if (r < t0) return false;
+      if (r < t1) t1 = r;
+    }
+  }
+  double aLat = lat0 + t0 * dLat, aLon = lon0 + t0 * dLon;
+  double bLat = lat0 + t1 * dLat, bLon = lon0 + t1 * dLon;
+  lat0 = aLat; lon0 = aLon; lat1 = bLat; lon1 = bLon;
+  return true;
+}
+
+static uint16_t quantize(double v, int32_t min, int32_t span) {
+  double q = floor((v - min) * 65536.0 / span + 0.5);
+  if (q < 0.0) q = 0.0;
+  if (q > 65535.0) q = 65535.0;
+  return (uint16_t)q;
+}
+
+std::vector<uint8_t> hwmapEncode(const HWMapEncMap& map, const HWMapEncOptions& options,
+                                 std::vector<std::vector<HWMapEncTileFeature>>* tilesOut) {
+  std::vector<uint8_t> out;
+  if (options.tileGridCode > 2 || options.haloPct > 31 || map.names.size() > MAX_MAP_NAMES) return out;
+  const int grid = options.tileGridCode == 0 ? 16 : options.tileGridCode == 2 ? 64 : 32;
+  const uint16_t tileCount = (uint16_t)(grid * grid);
+  const uint16_t flags = (uint16_t)(options.tileGridCode | (options.haloPct << 2) | ((16 - 10) << 7));
+
+  // Tile geometry exactly as MapCore::loadMapFile derives it
+  const int32_t tileW = (map.maxLon - map.minLon) / grid;
+  const int32_t tileH = (map.maxLat - map.minLat) / grid;
+  const float haloPct = HWMAP_GET_HALO_PCT(flags);
+  const int32_t haloW = (int32_t)(tileW * haloPct);
+  const int32_t haloH = (int32_t)(tileH * haloPct);
+
+  std::vector<std::vector<HWMapEncTileFeature>> tiles(tileCount);
+  uint32_t featureCount = 0;
+  uint16_t typeMask = 0;
+  for (const HWMapEncFeature& f : map.features) {
+    if (f.points.empty()) continue;
+    int32_t fMinLat = f.points[0].lat, fMaxLat = fMinLat, fMinLon = f.points[0].lon, fMaxLon = fMinLon;
+    for (const HWMapEncPoint& p : f.points) {
+      fMinLat = std::min(fMinLat, p.lat); fMaxLat = std::max(fMaxLat, p.lat);
+      fMinLon = std::min(fMinLon, p.lon); fMaxLon = std::max(fMaxLon, p.lon);
+    }
+    for (int ty = 0; ty < grid; ty++) {
+      for (int tx = 0; tx < grid; tx++) {
+        const int32_t minLon = map.minLon + tx * tileW - haloW;
+        const int32_t maxLon = map.minLon + (tx + 1) * tileW + haloW;
+        const int32_t minLat = map.minLat + ty * tileH - haloH;
+        const int32_t maxLat = map.minLat + (ty + 1) * tileH + haloH;
+        if (fMaxLon < minLon || fMinLon > maxLon || fMaxLat < minLat || fMinLat > maxLat) continue;
+        std::vector<HWMapEncTileFeature>& tile = tiles[ty * grid + tx];
+
+        auto emit = [&](const std::vector<double>& run) {
+          if (run.empty() || run.size() / 2 > 0xFFFF) return;
+          HWMapEncTileFeature tf = { f.type, f.subtype, f.nameIndex, {} };
+          for (size_t i = 0; i < run.size(); i += 2) {
+            tf.points.push_back(quantize(run[i], minLat, maxLat - minLat));
+            tf.points.push_back(quantize(run[i + 1], minLon, maxLon - minLon));
+          }
+          tile.push_back(tf);
+          featureCount++;
+          typeMask |= typeBit(f.type);
+        };
+
+        if (f.points.size() == 1) {
+          emit({ (double)f.points[0].lat, (double)f.points[0].lon });
+          continue;
+        }
+        // Runs of consecutive segments that reach the halo box
+        std::vector<double> run;
+        for (size_t i = 0; i + 1 < f.points.size(); i++) {
+          double lat0 = f.points[i].lat, lon0 = f.points[i].lon;
+          double lat1 = f.points[i + 1].lat, lon1 = f.points[i + 1].lon;
+          if (!clipSegment(lat0, lon0, lat1, lon1, minLat, minLon, maxLat, maxLon)) {
+            emit(run);
+            run.clear();
+            continue;
+          }
+          if (!run.empty() && (run[run.size() - 2] != lat0 || run[run.size() - 1] != lon0)) {
+            emit(run);
+            run.clear();
+          }
+          if (run.empty()) {
+            run.push_back(lat0);
+            run.push_back(lon0);
+          }
+          run.push_back(lat1);
+          run.push_back(lon1);
+        }
+        emit(run);
+      }
+    }
+  }
+
+  // Header (bounds on disk are deci-microdegrees)
+  out.insert(out.end(), { 'H', 'W', 'M', 'P' });
+  putU16(out, options.version);
+  putU16(out, flags);
+  putU32(out, (uint32_t)(map.minLat * 10));
+  putU32(out, (uint32_t)(map.minLon * 10));
+  putU32(out, (uint32_t)(map.maxLat * 10));
+  putU32(out, (uint32_t)(map.maxLon * 10));
+  putU32(out, featureCount);
+  putU16(out, (uint16_t)map.names.size());
+  out.insert(out.end(), map.regionName, map.regionName + 8);
+  putU16(out, typeMask);
+
+  for (const std::string& name : map.names) {
+    size_t len = std::min<size_t>(name.size(), MAP_NAME_MAX_LEN);
+    out.push_back((uint8_t)len);
+    out.insert(out.end(), name.begin(), name.begin() + len);
+  }
+
+  const size_t dirAt = out.size();
+  out.resize(out.size() + sizeof(HWMapTileDirEntry) * tileCount, 0);
+  for (uint16_t t = 0; t < tileCount; t++) {
+    if (tiles[t].empty()) continue;
+    if (tiles[t].size() > 0xFFFF) return {};
+    std::vector<uint8_t> payload = hwmapEncodeTile(tiles[t], options.version);
+    if (payload.empty()) return {};
+    setU32(out, dirAt + 8 * t, (uint32_t)out.size());
+    setU32(out, dirAt + 8 * t + 4, (uint32_t)payload.size());
+    out.insert(out.end(), payload.begin(), payload.end());
+  }
+
+  if (tilesOut) *tilesOut = tiles;
+
+  if (options.featureBoxes) {
+    const size_t sectionAt = out.size();
+    for (uint16_t t = 0; t < tileCount; t++) {
+      uint16_t mask = 0;
+      for (const HWMapEncTileFeature& f : tiles[t]) mask |= typeBit(f.type);
+      putU16(out, mask);
+    }
+    const size_t offsetsAt = out.size();
+    out.resize(out.size() + sizeof(uint32_t) * tileCount, 0);
+    for (uint16_t t = 0; t < tileCount; t++) {
+      if (tiles[t].empty()) {
+        setU32(out, offsetsAt + 4 * t, HWMAP_FBOX_NO_RECORD);
+        continue;
+      }
+      setU32(out, offsetsAt + 4 * t, (uint32_t)(out.size() - sectionAt));
+      putU16(out, (uint16_t)tiles[t].size());
+      for (const HWMapEncTileFeature& f : tiles[t]) {
+        uint16_t box[4] = { 0xFFFF, 0xFFFF, 0, 0 };
+        for (size_t i = 0; i < f.points.size(); i += 2) {
+          box[0] = std::min(box[0], f.points[i]);
+          box[1] = std::min(box[1], f.points[i + 1]);
+          box[2] = std::max(box[2], f.points[i]);
+          box[3] = std::max(box[3], f.points[i + 1]);
+        }
+        for (uint16_t v : box) putU16(out, v);
+      }
+    }
+    const uint32_t sectionSize = (uint32_t)(out.size() - sectionAt);
+    const uint32_t dirOffset = (uint32_t)out.size();
+    out.insert(out.end(), HWMAP_SECTION_FBOX, HWMAP_SECTION_FBOX + 4);
+    putU32(out, (uint32_t)sectionAt);
+    putU32(out, sectionSize);
+    out.insert(out.end(), HWMAP_TRAILER_MAGIC, HWMAP_TRAILER_MAGIC + 4);
+    putU32(out, dirOffset);
+    putU32(out, 1);
+  }
+  return out;
+}
+
+bool hwmapWriteFile(const char* path, const std::vector<uint8_t>& data) {
+  FILE* f = fopen(path, "wb");
+  if (!f) return false;
+  bool ok = fwrite(data.data(), 1, data.size(), f) == data.size();
+  return fclose(f) == 0 && ok;
+}
+
+std::vector<uint8_t> hwmapReadFile(const char* path) {
+  std::vector<uint8_t> data;
+  FILE* f = fopen(path, "rb");
+  if (!f) return data;
+  uint8_t buf[4096];
+  size_t n;
+  while ((n = fread(buf, 1, sizeof(buf), f)) > 0) data.insert(data.end(), buf, buf + n);
+  fclose(f);
+  return data;
+}
@@ -0,0 +1,53 @@
+// .hwmap writer for host tests and fixtures (format in System_Maps.h).
+// Features are given in microdegrees; each is clipped to the halo box of every
+// tile it crosses and quantized the way MapCore dequantizes.
+#pragma once
+
+#include <stdint.h>
+#include <string>
+#include <vector>
+
+struct HWMapEncPoint {
+  int32_t lat, lon;         // Microdegrees
+};
+
+struct HWMapEncFeature {
+  uint8_t type;
+  uint8_t subtype;
+  uint16_t nameIndex;       // HWMAP_NO_NAME for unnamed features
+  std::vector<HWMapEncPoint> points;
+};
+
+struct HWMapEncOptions {
+  uint16_t version = 6;     // 6 or 7
+  uint8_t tileGridCode = 1; // 0 = 16x16, 1 = 32x32, 2 = 64x64
+  uint8_t haloPct = 10;
+  bool featureBoxes = true; // Append the FBOX extension section
+};
+
+struct HWMapEncMap {
+  char regionName[8] = {};
+  int32_t minLat = 0, minLon = 0, maxLat = 0, maxLon = 0;  // Microdegrees
+  std::vector<std::string> names;
+  std::vector<HWMapEncFeature> features;
+};
+
+// One feature of a tile payload, as MapTileReader returns it
+struct HWMapEncTileFeature {
+  uint8_t type;
+  uint8_t subtype;
+  uint16_t nameIndex;
+  std::vector<uint16_t> points;  // qLat, qLon pairs
+};
+
+// Tile payload, v6 (fixed pairs) or v7 (varint deltas, header dictionary when
+// any header repeats). Empty for other versions.
+std::vector<uint8_t> hwmapEncodeTile(const std::vector<HWMapEncTileFeature>& features, uint16_t version);
+
+// Whole file. Returns an empty vector if the map does not fit the format.
+// tilesOut, if given, receives the features of every tile in directory order.
+std::vector<uint8_t> hwmapEncode(const HWMapEncMap& map, const HWMapEncOptions& options,
+                                 std::vector<std::vector<HWMapEncTileFeature>>* tilesOut = nullptr);
+
+bool hwmapWriteFile(const char* path, const std::vector<uint8_t>& data);
+std::vector<uint8_t> hwmapReadFile(const char* path);
@@ -0,0 +1,130 @@
+// Decodes the v7 fixture through MapCore and MapTileReader (the device path)
+// and compares every name, tile and point with the fixture's expected list.
+// web_parse_hwmap.js checks the same fixture with the web page's parser.
+//   hwmap_v7_test <tiny_v7.hwmap> <tiny_v7.expected>
+#include <Arduino.h>
+#include <LittleFS.h>
+
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "host_test.h"
+#include "hwmap_encode.h"
+#include "System_Maps.h"
+
+struct ExpectedTile {
+  unsigned index;
+  std::vector<HWMapEncTileFeature> features;
+};
+
+static bool loadExpected(const char* path, std::vector<std::string>& names, std::vector<ExpectedTile>& tiles) {
+  std::ifstream in(path);
+  if (!in) return false;
+  std::string line;
+  while (std::getline(in, line)) {
+    std::istringstream ls(line);
+    std::string tag;
+    ls >> tag;
+    if (tag == "N") {
+      size_t index;
+      ls >> index;
+      names.resize(index + 1);
+      std::getline(ls >> std::ws, names[index]);
+    } else if (tag == "T") {
+      ExpectedTile tile;
+      ls >> tile.index;
+      tiles.push_back(tile);
+    } else if (tag == "F" && !tiles.empty()) {
+      unsigned type, subtype, nameIndex, qLat, qLon;
+      char comma;
+      ls >> type >> subtype >> nameIndex;
+      HWMapEncTileFeature f = { (uint8_t)type, (uint8_t)subtype, (uint16_t)nameIndex, {} };
+      while (ls >> qLat >> comma >> qLon) {
+        f.points.push_back((uint16_t)qLat);
+        f.points.push_back((uint16_t)qLon);
+      }
+      tiles.back().features.push_back(f);
+    }
+  }
+  return true;
+}
+
+int main(int argc, char** argv) {
+  if (argc < 3) {
+    fprintf(stderr, "usage: %s <map.hwmap> <expected.txt>\n", argv[0]);
+    return 2;
+  }
+  std::vector<std::string> names;
+  std::vector<ExpectedTile> tiles;
+  if (!loadExpected(argv[2], names, tiles) || tiles.empty()) {
+    fprintf(stderr, "no expected features in %s\n", argv[2]);
+    return 2;
+  }
+
+  std::string mapPath = argv[1];
+  size_t slash = mapPath.rfind('/');
+  hostFsSetRoot(slash == std::string::npos ? "." : mapPath.substr(0, slash).c_str());
+  std::string mapName = "/" + (slash == std::string::npos ? mapPath : mapPath.substr(slash + 1));
+  if (!MapCore::loadMapFile(mapName.c_str())) {
+    fprintf(stderr, "failed to load %s\n", argv[1]);
+    return 2;
+  }
+  const LoadedMap& map = MapCore::getCurrentMap();
+  HOST_CHECK(map.header.version == 7, "version %u, fixture must be v7", map.header.version);
+
+  HOST_CHECK(map.nameCount == names.size(), "%u names, expected %zu", map.nameCount, names.size());
+  for (size_t i = 0; i < names.size() && i < map.nameCount; i++) {
+    HOST_CHECK(names[i] == MapCore::getName((uint16_t)i), "name %zu: '%s', expected '%s'", i,
+               MapCore::getName((uint16_t)i), names[i].c_str());
+  }
+
+  size_t next = 0, features = 0;
+  for (uint16_t t = 0; t < map.tileCount; t++) {
+    const bool listed = next < tiles.size() && tiles[next].index == t;
+    size_t size = 0;
+    const uint8_t* data = MapCore::loadTileData(t, &size);
+    if (!listed) {
+      HOST_CHECK(!data, "tile %u has a payload, expected none", t);
+      continue;
+    }
+    const ExpectedTile& expected = tiles[next++];
+    HOST_CHECK(data, "tile %u: no payload", t);
+    if (!data) continue;
+
+    MapTileReader reader(data, size, map.header.version);
+    HOST_CHECK(reader.featureCount() == expected.features.size(), "tile %u: %u features, expected %zu", t,
+               reader.featureCount(), expected.features.size());
+    MapFeatureInfo info;
+    for (size_t i = 0; i < expected.features.size(); i++) {
+      const HWMapEncTileFeature& ef = expected.features[i];
+      if (!reader.next(info)) {
+        HOST_CHECK(false, "tile %u: feature %zu missing", t, i);
+        break;
+      }
+      features++;
+      HOST_CHECK(info.type == ef.type && info.subtype == ef.subtype && info.nameIndex == ef.nameIndex,
+                 "tile %u feature %zu: header %u/%u/%u, expected %u/%u/%u", t, i, info.type, info.subtype,
+                 info.nameIndex, ef.type, ef.subtype, ef.nameIndex);
+      HOST_CHECK(info.pointCount == ef.points.size() / 2, "tile %u feature %zu: %u points, expected %zu", t, i,
+                 info.pointCount, ef.points.size() / 2);
+      // Records are also reached by offset from the per-tile feature index
+      MapFeatureInfo again;
+      HOST_CHECK(reader.seek(info.offset, again) && again.nameIndex == info.nameIndex &&
+                 again.pointCount == info.pointCount, "tile %u feature %zu: seek(%u) lands elsewhere", t, i, info.offset);
+      uint16_t qLat, qLon;
+      size_t p = 0;
+      for (; p < ef.points.size() && reader.point(qLat, qLon); p += 2) {
+        HOST_CHECK(qLat == ef.points[p] && qLon == ef.points[p + 1], "tile %u feature %zu point %zu: %u,%u, expected %u,%u",
+                   t, i, p / 2, qLat, qLon, ef.points[p], ef.points[p + 1]);
+      }
+      HOST_CHECK(p == ef.points.size(), "tile %u feature %zu: stream ended after %zu points", t, i, p / 2);
+    }
+    HOST_CHECK(!reader.next(info), "tile %u: more features than expected", t);
+  }
+  HOST_CHECK(next == tiles.size(), "%zu listed tiles are not in the tile directory", tiles.size() - next);
+  printf("checked %zu names, %zu tiles, %zu features\n", names.size(), tiles.size(), features);
+  MapCore::unloadMap();
+  return hostTestResult("hwmap_v7_test");
+}
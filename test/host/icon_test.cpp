@@ -0,0 +1,120 @@
+// Embedded icon lookup and cached rasters on the host.
+// - Every registry name resolves through findEmbeddedIcon() to the entry the
+//   old linear strcmp scan returned (first one on duplicates), and names that
+//   are not registered (case changes, prefixes, suffixes) do not.
+// - Every icon renders identically at every size oledDrawIcon() can ask for
+//   (scale = size / 32): the atlas raster drawn with drawBitmap() matches the
+//   per-pixel sampling drawIconScaled() did before the atlas, through enough
+//   sizes that the raster cache evicts and rebuilds entries.
+#include <Arduino.h>
+#include <Adafruit_GFX.h>
+
+#include <string>
+
+#include "host_test.h"
+#include "System_Icons.h"
+
+static const EmbeddedIcon* linearFind(const char* name) {
+  for (size_t i = 0; i < EMBEDDED_ICONS_COUNT; i++) {
+    if (strcmp(EMBEDDED_ICONS[i].name, name) == 0) return &EMBEDDED_ICONS[i];
+  }
+  return nullptr;
+}
+
+static void testLookup() {
+  HOST_CHECK(EMBEDDED_ICONS_COUNT > 0, "no icons registered");
+  HOST_CHECK(!findEmbeddedIcon(nullptr) && !findEmbeddedIcon(""), "empty names must not resolve");
+  for (size_t i = 0; i < EMBEDDED_ICONS_COUNT; i++) {
+    const char* name = EMBEDDED_ICONS[i].name;
+    const EmbeddedIcon* icon = findEmbeddedIcon(name);
+    HOST_CHECK(icon == linearFind(name), "'%s' resolves to entry %td, linear scan finds %td", name,
+               icon ? icon - EMBEDDED_ICONS : -1, linearFind(name) - EMBEDDED_ICONS);
+
+    std::string upper = name, prefix(name, strlen(name) - 1), suffix = std::string(name) + "_x";
+    for (char& c : upper) c = (char)toupper((unsigned char)c);
+    for (const std::string& miss : { upper, prefix, suffix }) {
+      HOST_CHECK(findEmbeddedIcon(miss.c_str()) == linearFind(miss.c_str()), "'%s' must resolve like the linear scan",
+                 miss.c_str());
+    }
+  }
+  HOST_CHECK(!findEmbeddedIcon("no_such_icon"), "unknown name resolved");
+}
+
+// Registry bitmaps are LSB-first rows of whole bytes
+static bool srcBit(const EmbeddedIcon* icon, int x, int y) {
+  if (x < 0 || x >= icon->width || y < 0 || y >= icon->height) return false;
+  return (icon->bitmapData[y * ((icon->width + 7) / 8) + x / 8] >> (x % 8)) & 1;
+}
+
+// drawIconScaled() before the atlas, per pixel. At 1.0x it used drawBitmap()
+// on the LSB-first data and drew every byte mirrored; the reference is the
+// unmirrored icon, which the atlas now draws.
+static void drawReference(GFXcanvas1& canvas, const EmbeddedIcon* icon, int x, int y, float scale) {
+  const int width = icon->width, height = icon->height;
+  if (scale >= 0.99f && scale <= 1.01f) {
+    for (int dy = 0; dy < height; dy++)
+      for (int dx = 0; dx < width; dx++)
+        if (srcBit(icon, dx, dy)) canvas.drawPixel(x + dx, y + dy, 1);
+    return;
+  }
+  if (scale >= 0.49f && scale <= 0.51f && width == 32 && height == 32) {
+    for (int dy = 0; dy < 16; dy++)
+      for (int dx = 0; dx < 16; dx++)
+        if (srcBit(icon, dx * 2, dy * 2) || srcBit(icon, dx * 2 + 1, dy * 2) ||
+            srcBit(icon, dx * 2, dy * 2 + 1) || srcBit(icon, dx * 2 + 1, dy * 2 + 1))
+          canvas.drawPixel(x + dx, y + dy, 1);
+    return;
+  }
+  const int outWidth = (int)(width * scale), outHeight = (int)(height * scale);
+  const float invScale = 1.0f / scale;
+  for (int dy = 0; dy < outHeight; dy++)
+    for (int dx = 0; dx < outWidth; dx++)
+      if (srcBit(icon, (int)(dx * invScale), (int)(dy * invScale))) canvas.drawPixel(x + dx, y + dy, 1);
+}
+
+// drawIcon()/drawIconScaled() now: one drawBitmap() of the cached raster
+static bool drawAtlas(GFXcanvas1& canvas, const EmbeddedIcon* icon, int x, int y, uint8_t size) {
+  const uint8_t* bits = embeddedIconRaster(icon, size);
+  if (!bits) return false;
+  canvas.drawBitmap(x, y, bits, size, size, 1);
+  return true;
+}
+
+static void testRasters() {
+  GFXcanvas1 ref(40, 40), atlas(40, 40);
+  const size_t bytes = (size_t)(40 + 7) / 8 * 40;
+  uint32_t draws = 0;
+  // Every (icon, size) pair once per pass, far more than the cache holds, so
+  // slots are evicted and rebuilt throughout; the second pass runs backwards
+  for (int pass = 0; pass < 2; pass++) {
+    for (uint8_t size = 1; size <= ICON_ATLAS_MAX_SIZE; size++) {
+      const uint8_t sz = pass == 0 ? size : (uint8_t)(ICON_ATLAS_MAX_SIZE + 1 - size);
+      for (size_t i = 0; i < EMBEDDED_ICONS_COUNT; i++) {
+        const EmbeddedIcon* icon = &EMBEDDED_ICONS[pass == 0 ? i : EMBEDDED_ICONS_COUNT - 1 - i];
+        HOST_CHECK(icon->width == 32 && icon->height == 32, "'%s' is %ux%u, the sizes assume 32x32", icon->name,
+                   icon->width, icon->height);
+        ref.fillScreen(0);
+        atlas.fillScreen(0);
+        drawReference(ref, icon, 3, 5, (float)sz / 32.0f);
+        if (!drawAtlas(atlas, icon, 3, 5, sz)) {
+          HOST_CHECK(false, "'%s' at %u px: no raster", icon->name, sz);
+          continue;
+        }
+        draws++;
+        HOST_CHECK(embeddedIconRaster(icon, sz) == embeddedIconRaster(icon, sz), "'%s' at %u px: repeat draw missed the cache",
+                   icon->name, sz);
+        HOST_CHECK(memcmp(ref.getBuffer(), atlas.getBuffer(), bytes) == 0, "'%s' at %u px renders differently",
+                   icon->name, sz);
+      }
+    }
+  }
+  HOST_CHECK(!embeddedIconRaster(&EMBEDDED_ICONS[0], 0) && !embeddedIconRaster(&EMBEDDED_ICONS[0], ICON_ATLAS_MAX_SIZE + 1),
+             "sizes outside 1..%d must not rasterize", ICON_ATLAS_MAX_SIZE);
+  printf("%zu icons, %u raster draws compared\n", EMBEDDED_ICONS_COUNT, draws);
+}
+
+int main() {
+  testLookup();
+  testRasters();
+  return hostTestResult("icon_test");
+}
@@ -0,0 +1,245 @@
+// LocationContextManager::updateContext (per-tile segment grids, nearest cells
+// first, early exit) against the brute-force search it replaced: every road and
+// area segment of the 3x3 tile block around the position, ranked in the same
+// local projection. For each query point the nearest road and area must be at
+// the brute-force distance and carry the name and type of a segment at that
+// distance (ties may pick either). Query points cover the sample map and a
+// generated dense one, their edges and the area just outside; the timings of
+// both searches are printed.
+//   location_context_test <sample.hwmap> <scratch dir>
+#include <Arduino.h>
+#include <LittleFS.h>
+
+#include <math.h>
+#include <string>
+#include <vector>
+
+#include "host_test.h"
+#include "hwmap_encode.h"
+#include "System_Maps.h"
+
+static uint32_t sRng = 0x9E3779B9u;
+static uint32_t rnd() {
+  sRng ^= sRng << 13;
+  sRng ^= sRng >> 17;
+  sRng ^= sRng << 5;
+  return sRng;
+}
+static int32_t rndRange(int32_t lo, int32_t hi) { return lo + (int32_t)(rnd() % (uint32_t)(hi - lo + 1)); }
+
+struct BruteNearest {
+  double d = INFINITY;                  // Projected distance (microdegrees)
+  int32_t lat = 0, lon = 0;             // Closest point
+  std::vector<std::pair<std::string, uint8_t>> ties;  // (name, type) of every segment at d
+  bool found = false;
+};
+
+static int contextClass(uint8_t type) {
+  switch (type) {
+    case MAP_FEATURE_HIGHWAY:
+    case MAP_FEATURE_ROAD_MAJOR:
+    case MAP_FEATURE_ROAD_MINOR:
+    case MAP_FEATURE_PATH:
+      return 0;
+    case MAP_FEATURE_PARK:
+    case MAP_FEATURE_WATER:
+      return 1;
+    default:
+      return -1;
+  }
+}
+
+static double haversineM(double lat1, double lon1, double lat2, double lon2) {
+  double dLat = (lat2 - lat1) * M_PI / 180.0, dLon = (lon2 - lon1) * M_PI / 180.0;
+  double a = sin(dLat / 2) * sin(dLat / 2) +
+             cos(lat1 * M_PI / 180.0) * cos(lat2 * M_PI / 180.0) * sin(dLon / 2) * sin(dLon / 2);
+  return 6371000.0 * 2 * atan2(sqrt(a), sqrt(1 - a));
+}
+
+// Tie window: half a microdegree, well under the quantization step
+static const double kTie = 0.5;
+
+static void bruteForce(float lat, float lon, BruteNearest best[2]) {
+  const LoadedMap& map = MapCore::getCurrentMap();
+  const int32_t latMicro = (int32_t)(lat * 1000000), lonMicro = (int32_t)(lon * 1000000);
+  const int32_t cosLatQ16 = (int32_t)(cosf(lat * PI / 180.0f) * 65536.0f);
+  int tileX = (lonMicro - map.header.minLon) / map.tileW, tileY = (latMicro - map.header.minLat) / map.tileH;
+  tileX = tileX < 0 ? 0 : (tileX >= map.tileGridSize ? map.tileGridSize - 1 : tileX);
+  tileY = tileY < 0 ? 0 : (tileY >= map.tileGridSize ? map.tileGridSize - 1 : tileY);
+
+  struct Candidate { double d; int32_t lat, lon; std::string name; uint8_t type; };
+  std::vector<Candidate> all[2];
+  for (int ty = tileY - 1; ty <= tileY + 1; ty++) {
+    for (int tx = tileX - 1; tx <= tileX + 1; tx++) {
+      if (tx < 0 || ty < 0 || tx >= map.tileGridSize || ty >= map.tileGridSize) continue;
+      uint16_t tileIdx = (uint16_t)(ty * map.tileGridSize + tx);
+      size_t size = 0;
+      const uint8_t* data = MapCore::loadTileData(tileIdx, &size);
+      if (!data || size < 2) continue;
+      int32_t minLon = map.header.minLon + tx * map.tileW - map.haloW;
+      int32_t minLat = map.header.minLat + ty * map.tileH - map.haloH;
+      int32_t lonSpan = map.tileW + 2 * map.haloW, latSpan = map.tileH + 2 * map.haloH;
+      MapTileReader reader(data, size, map.header.version);
+      MapFeatureInfo info;
+      while (reader.next(info)) {
+        int cls = contextClass(info.type);
+        if (cls < 0 || info.pointCount < 2) continue;
+        const char* name = MapCore::getName(info.nameIndex);
+        uint16_t qLat, qLon;
+        int32_t pLat = 0, pLon = 0;
+        for (uint16_t k = 0; reader.point(qLat, qLon); k++) {
+          int32_t cLat = minLat + (int32_t)((int64_t)qLat * latSpan >> 16);
+          int32_t cLon = minLon + (int32_t)((int64_t)qLon * lonSpan >> 16);
+          if (k > 0) {
+            // Closest point of segment p-c in x = lon * cos(lat), y = lat (x in
+            // whole microdegrees, as the device projects it)
+            double ax = (double)(((int64_t)(pLon - lonMicro) * cosLatQ16) >> 16), ay = pLat - latMicro;
+            double bx = (double)(((int64_t)(cLon - lonMicro) * cosLatQ16) >> 16), by = cLat - latMicro;
+            double abx = bx - ax, aby = by - ay, ab2 = abx * abx + aby * aby;
+            double t = ab2 > 0 ? -(ax * abx + ay * aby) / ab2 : 0;
+            t = t < 0 ? 0 : (t > 1 ? 1 : t);
+            double d = hypot(ax + t * abx, ay + t * aby);
+            all[cls].push_back({ d, pLat + (int32_t)(t * (cLat - pLat)), pLon + (int32_t)(t * (cLon - pLon)),
+                                 name ? name : "", info.type });
+          }
+          pLat = cLat;
+          pLon = cLon;
+        }
+      }
+    }
+  }
+  for (int cls = 0; cls < 2; cls++) {
+    for (const Candidate& c : all[cls]) {
+      if (c.d < best[cls].d) {
+        best[cls].d = c.d;
+        best[cls].lat = c.lat;
+        best[cls].lon = c.lon;
+        best[cls].found = true;
+      }
+    }
+    for (const Candidate& c : all[cls]) {
+      if (c.d <= best[cls].d + kTie) best[cls].ties.push_back({ c.name, c.type });
+    }
+  }
+}
+
+static bool isTie(const BruteNearest& best, const char* name, uint8_t type) {
+  for (const auto& t : best.ties) {
+    if (t.first == name && t.second == type) return true;
+  }
+  return false;
+}
+
+static void checkQuery(float lat, float lon, uint32_t& gridUs, uint32_t& bruteUs, uint32_t& found) {
+  // Both timed on a warm tile cache (tiles loaded, segment grids built)
+  LocationContextManager::updateContext(lat, lon);
+  uint32_t t0 = micros();
+  LocationContextManager::updateContext(lat, lon);
+  uint32_t t1 = micros();
+  BruteNearest best[2];
+  bruteForce(lat, lon, best);
+  uint32_t t2 = micros();
+  gridUs += t1 - t0;
+  bruteUs += t2 - t1;
+
+  const LocationContext& ctx = LocationContextManager::getContext();
+  HOST_CHECK(ctx.valid, "%.6f,%.6f: context not valid", lat, lon);
+  const struct {
+    const char* what;
+    float distanceM;
+    const char* name;
+    uint8_t type;
+  } got[2] = { { "road", ctx.roadDistanceM, ctx.nearestRoad, (uint8_t)ctx.roadType },
+               { "area", ctx.areaDistanceM, ctx.nearestArea, (uint8_t)ctx.areaType } };
+  for (int cls = 0; cls < 2; cls++) {
+    if (!best[cls].found) {
+      HOST_CHECK(got[cls].distanceM >= 999999.0f, "%.6f,%.6f: %s at %.1f m, brute force finds none", lat, lon,
+                 got[cls].what, got[cls].distanceM);
+      continue;
+    }
+    found++;
+    // The device works in float degrees (~0.4 m at this latitude)
+    double expectedM = haversineM(lat, lon, best[cls].lat / 1e6, best[cls].lon / 1e6);
+    HOST_CHECK(fabs(got[cls].distanceM - expectedM) <= 1.0 + expectedM * 0.002,
+               "%.6f,%.6f: nearest %s at %.2f m, brute force %.2f m", lat, lon, got[cls].what, got[cls].distanceM,
+               expectedM);
+    HOST_CHECK(isTie(best[cls], got[cls].name, got[cls].type), "%.6f,%.6f: nearest %s is '%s' (type %u), brute force "
+               "has '%s' (type %u) at %.2f m", lat, lon, got[cls].what, got[cls].name, got[cls].type,
+               best[cls].ties[0].first.c_str(), best[cls].ties[0].second, expectedM);
+  }
+}
+
+// Dense downtown: a few hundred road and area segments per tile
+static HWMapEncMap denseMap() {
+  HWMapEncMap map;
+  memcpy(map.regionName, "Dense", 5);
+  map.minLat = 47600000; map.maxLat = 47632000;
+  map.minLon = -122360000; map.maxLon = -122328000;
+  map.names = { "Pike St", "Pine St", "1st Ave", "Lake Union", "Cal Anderson Park" };
+  for (int i = 0; i < 6000; i++) {
+    std::vector<HWMapEncPoint> pts;
+    int32_t lat = rndRange(map.minLat, map.maxLat), lon = rndRange(map.minLon, map.maxLon);
+    for (int k = rndRange(2, 20); k > 0; k--) {
+      pts.push_back({ lat, lon });
+      lat += rndRange(-150, 150);
+      lon += rndRange(-150, 150);
+    }
+    uint8_t type = i % 5 == 0 ? MAP_FEATURE_PARK : (i % 7 == 0 ? MAP_FEATURE_BUILDING : MAP_FEATURE_ROAD_MINOR);
+    map.features.push_back({ type, 0, (uint16_t)(i % 6 == 0 ? HWMAP_NO_NAME : rnd() % map.names.size()), pts });
+  }
+  return map;
+}
+
+static bool loadMap(const std::string& path) {
+  size_t slash = path.rfind('/');
+  hostFsSetRoot(slash == std::string::npos ? "." : path.substr(0, slash).c_str());
+  std::string name = "/" + (slash == std::string::npos ? path : path.substr(slash + 1));
+  return MapCore::loadMapFile(name.c_str());
+}
+
+static void checkMap(const char* label) {
+  const LoadedMap& map = MapCore::getCurrentMap();
+  const HWMapHeader& h = map.header;
+  uint32_t gridUs = 0, bruteUs = 0, found = 0, queries = 0;
+  // Anywhere on the map and a little beyond it
+  int32_t padLat = (h.maxLat - h.minLat) / 20, padLon = (h.maxLon - h.minLon) / 20;
+  for (int i = 0; i < 3000; i++, queries++) {
+    checkQuery(rndRange(h.minLat - padLat, h.maxLat + padLat) / 1e6f,
+               rndRange(h.minLon - padLon, h.maxLon + padLon) / 1e6f, gridUs, bruteUs, found);
+  }
+  // Tile corners and edges, where the answer may come from a neighbour's cells
+  for (int ty = 0; ty <= map.tileGridSize; ty += 3) {
+    for (int tx = 0; tx <= map.tileGridSize; tx += 3, queries++) {
+      checkQuery((h.minLat + ty * map.tileH + rndRange(-2, 2)) / 1e6f,
+                 (h.minLon + tx * map.tileW + rndRange(-2, 2)) / 1e6f, gridUs, bruteUs, found);
+    }
+  }
+  printf("%s: %u queries, %u nearest features; grid %.3f ms/query, brute force %.3f ms/query\n", label, queries,
+         found, gridUs / 1000.0 / queries, bruteUs / 1000.0 / queries);
+  HOST_CHECK(found > queries, "%s: too few queries found a road or area (%u)", label, found);
+}
+
+int main(int argc, char** argv) {
+  if (argc < 3) {
+    fprintf(stderr, "usage: %s <sample.hwmap> <scratch dir>\n", argv[0]);
+    return 2;
+  }
+  if (!loadMap(argv[1])) {
+    fprintf(stderr, "failed to load %s\n", argv[1]);
+    return 2;
+  }
+  checkMap("sample");
+  MapCore::unloadMap();
+
+  HWMapEncOptions options;
+  options.tileGridCode = 0;
+  std::string path = std::string(argv[2]) + "/context_dense.hwmap";
+  std::vector<uint8_t> data = hwmapEncode(denseMap(), options);
+  if (data.empty() || !hwmapWriteFile(path.c_str(), data) || !loadMap(path)) {
+    fprintf(stderr, "failed to write or load %s\n", path.c_str());
+    return 2;
+  }
+  checkMap("dense");
+  MapCore::unloadMap();
+  return hostTestResult("location_context_test");
+}
@@ -0,0 +1,177 @@
+// Map render benchmark and regression check on the host. Plays scripted
+// pan/zoom/rotate runs through MapCore::renderMap into a 128x64 offscreen
+// frame, reports the per-call MapRenderStats (frame time, tile I/O, cache hit
+// rate, bytes read and decoded) and compares a hash of every frame with the
+// goldens file. Any mismatch, missing or extra frame fails the run.
+//   map_bench <map.hwmap> <goldens.txt> [--save]
+#include <Arduino.h>
+#include <LittleFS.h>
+
+#include <map>
+#include <string>
+
+#include "System_Maps.h"
+
+struct BenchPhase {
+  uint8_t frames;
+  int8_t panX, panY;         // Screen pixels per frame
+  float zoomMul;             // Zoom factor per frame
+  float rotStep;             // Degrees per frame
+};
+
+struct BenchScript {
+  const char* name;
+  float zoom;                // Starting zoom (at the map centre, north up)
+  BenchPhase phases[4];
+};
+
+static const BenchScript kScripts[] = {
+  { "pan",    1.0f, { { 12, 12, 0, 1.0f, 0.0f }, { 8, 0, 10, 1.0f, 0.0f }, { 12, -9, -6, 1.0f, 0.0f } } },
+  { "zoom",   1.0f, { { 10, 0, 0, 1.25f, 0.0f }, { 16, 0, 0, 0.8f, 0.0f } } },
+  { "rotate", 2.0f, { { 24, 0, 0, 1.0f, 15.0f }, { 8, 6, 4, 1.0f, -7.5f } } },
+  { "tour",   1.0f, { { 8, 16, 0, 1.0f, 0.0f }, { 8, 0, 0, 1.25f, 0.0f }, { 8, 0, 0, 1.0f, 15.0f },
+                      { 8, -12, 12, 0.7f, 0.0f } } },
+};
+
+static uint32_t frameHash(const uint8_t* data, size_t len) {
+  uint32_t h = 2166136261u;
+  for (size_t i = 0; i < len; i++) { h ^= data[i]; h *= 16777619u; }
+  return h;
+}
+
+static bool loadGoldens(const char* path, std::map<std::string, uint32_t>& out) {
+  FILE* f = fopen(path, "r");
+  if (!f) return false;
+  char line[128];
+  while (fgets(line, sizeof(line), f)) {
+    char script[32];
+    unsigned frame, hash;
+    if (line[0] == '#' || sscanf(line, "%31s %u %x", script, &frame, &hash) != 3) continue;
+    out[std::string(script) + "/" + std::to_string(frame)] = hash;
+  }
+  fclose(f);
+  return true;
+}
+
+int main(int argc, char** argv) {
+  if (argc < 3) {
+    fprintf(stderr, "usage: %s <map.hwmap> <goldens.txt> [--save]\n", argv[0]);
+    return 2;
+  }
+  const bool save = argc > 3 && strcmp(argv[3], "--save") == 0;
+
+  // Mount the map's directory as the filesystem root
+  std::string mapPath = argv[1];
+  size_t slash = mapPath.rfind('/');
+  hostFsSetRoot(slash == std::string::npos ? "." : mapPath.substr(0, slash).c_str());
+  std::string mapName = "/" + (slash == std::string::npos ? mapPath : mapPath.substr(slash + 1));
+
+  std::map<std::string, uint32_t> goldens;
+  if (!save && !loadGoldens(argv[2], goldens)) {
+    fprintf(stderr, "no goldens at %s (run with --save)\n", argv[2]);
+    return 2;
+  }
+
+  uint8_t frame[OFFSCREEN_BUF_SIZE];
+  OffscreenMapRenderer renderer(frame, 128, 64);
+  MapRenderParams params = {};
+  params.visibleLayers = LAYER_ALL;
+  memset(params.subtypeVisibility, 0xFF, sizeof(params.subtypeVisibility));
+  params.liveOverlays = false;
+
+  std::string saved = "# map_bench goldens: <script> <frame> <FNV-1a of the 128x64 frame>\n";
+  unsigned mismatches = 0, checked = 0;
+  uint32_t linesTotal = 0;
+
+  printf("%-7s %6s %8s %8s %8s %5s %8s %8s %6s %6s\n",
+         "script", "frames", "avg ms", "max ms", "io ms", "hit%", "read KB", "dec KB", "feat", "lines");
+  for (const BenchScript& script : kScripts) {
+    // Fresh load per script: each starts with a cold tile cache
+    if (!MapCore::loadMapFile(mapName.c_str())) {
+      fprintf(stderr, "failed to load %s\n", argv[1]);
+      return 2;
+    }
+    const LoadedMap& map = MapCore::getCurrentMap();
+    float lat = (map.header.minLat + map.header.maxLat) / 2000000.0f;
+    float lon = (map.header.minLon + map.header.maxLon) / 2000000.0f;
+    params.zoom = script.zoom;
+    params.rotation = 0.0f;
+
+    uint32_t frames = 0, totalUs = 0, maxUs = 0, ioUs = 0, hits = 0, misses = 0;
+    uint32_t readBytes = 0, decoded = 0, features = 0, lines = 0;
+    for (const BenchPhase& phase : script.phases) {
+      for (uint8_t i = 0; i < phase.frames; i++, frames++) {
+        // Pan along the rotated screen axes at the current scale (as renderMap maps them)
+        float rad = params.rotation * (float)PI / 180.0f;
+        float px = phase.panX * cosf(rad) + phase.panY * sinf(rad);
+        float py = -phase.panX * sinf(rad) + phase.panY * cosf(rad);
+        lon += px * (246.0f / params.zoom) / 1000000.0f;
+        lat -= py * (188.0f / params.zoom) / 1000000.0f;
+        params.zoom *= phase.zoomMul;
+        params.rotation += phase.rotStep;
+
+        renderer.clear();
+        MapRenderStats st = {};
+        MapCore::renderMap(&renderer, lat, lon, params, &st);
+        totalUs += st.frameUs;
+        if (st.frameUs > maxUs) maxUs = st.frameUs;
+        ioUs += st.tileIOUs;
+        hits += st.cacheHits;
+        misses += st.cacheMisses;
+        readBytes += st.bytesRead;
+        decoded += st.bytesDecoded;
+        features += st.features;
+        lines += st.linesDrawn;
+
+        uint32_t hash = frameHash(frame, sizeof(frame));
+        char entry[64];
+        snprintf(entry, sizeof(entry), "%s %u %08x\n", script.name, frames, hash);
+        saved += entry;
+        if (save) continue;
+        checked++;
+        auto it = goldens.find(std::string(script.name) + "/" + std::to_string(frames));
+        if (it == goldens.end()) {
+          printf("MISSING %s frame %u (hash %08x)\n", script.name, frames, hash);
+          mismatches++;
+        } else {
+          if (it->second != hash) {
+            printf("MISMATCH %s frame %u: %08x, golden %08x\n", script.name, frames, hash, it->second);
+            mismatches++;
+          }
+          goldens.erase(it);
+        }
+      }
+    }
+    uint32_t lookups = hits + misses;
+    printf("%-7s %6u %8.2f %8.2f %8.2f %5u %8u %8u %6u %6u\n", script.name, frames,
+           totalUs / 1000.0 / frames, maxUs / 1000.0, ioUs / 1000.0 / frames,
+           lookups ? (unsigned)(hits * 100 / lookups) : 0, readBytes / 1024, decoded / 1024,
+           features / frames, lines / frames);
+    linesTotal += lines;
+  }
+  MapCore::unloadMap();
+
+  if (linesTotal == 0) {
+    fprintf(stderr, "no lines drawn: the map or the scripts miss every feature\n");
+    return 1;
+  }
+  if (save) {
+    FILE* f = fopen(argv[2], "w");
+    if (!f || fputs(saved.c_str(), f) < 0 || fclose(f) != 0) {
+      fprintf(stderr, "failed to write %s\n", argv[2]);
+      return 2;
+    }
+    printf("goldens saved: %s\n", argv[2]);
+    return 0;
+  }
+  for (const auto& extra : goldens) {
+    printf("EXTRA golden %s (script no longer renders it)\n", extra.first.c_str());
+    mismatches++;
+  }
+  if (mismatches) {
+    printf("REGRESSION: %u/%u frames differ from goldens\n", mismatches, checked);
+    return 1;
+  }
+  printf("All %u frames match goldens\n", checked);
+  return 0;
+}
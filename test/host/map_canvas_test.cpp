@@ -0,0 +1,182 @@
+// MapCanvas pans against full redraws. One canvas follows a path of pans
+// incrementally (window moves inside the margin, scrollInto + exposed strips
+// past it, full redraws for long jumps); a second one is invalidated and redrawn
+// from scratch at every step. At each step both must agree on the snapped
+// centre and blit the same frame, and where the incremental canvas re-centred,
+// hold the same pixels. Scripted pans (every shift of the page rows, sub-pixel,
+// diagonal, just inside and past the margin) and random walks run at several
+// zooms, on view heights that are and are not whole pages, over the middle of
+// the sample map and its edges. Views whose full redraw needs more tiles than
+// the cache holds are skipped. The pixels rendered by both are printed.
+//   map_canvas_test <sample.hwmap>
+#include <Arduino.h>
+#include <LittleFS.h>
+
+#include <string.h>
+#include <string>
+#include <vector>
+
+#include "host_test.h"
+#include "System_Maps.h"
+
+static uint32_t sRng = 0x68E31DA4u;
+static uint32_t rnd() {
+  sRng ^= sRng << 13;
+  sRng ^= sRng >> 17;
+  sRng ^= sRng << 5;
+  return sRng;
+}
+static int32_t rndRange(int32_t lo, int32_t hi) { return lo + (int32_t)(rnd() % (uint32_t)(hi - lo + 1)); }
+
+static bool loadMap(const std::string& path) {
+  size_t slash = path.rfind('/');
+  hostFsSetRoot(slash == std::string::npos ? "." : path.substr(0, slash).c_str());
+  std::string name = "/" + (slash == std::string::npos ? path : path.substr(slash + 1));
+  return MapCore::loadMapFile(name.c_str());
+}
+
+struct Pan { float x, y; };  // Pixels at the current zoom
+
+// Inside the margin, just past it, every row shift within a page and across
+// pages, sub-pixel, diagonal, back and forth, and far enough for a full redraw
+static const Pan kScriptedPans[] = {
+  { 3, 0 }, { 5, 2 }, { 0, -7 }, { 12, 9 }, { 20, 0 }, { 0.4f, 0.3f }, { -25, -18 }, { -6, 30 }, { 1, 1 },
+  { 90, 0 }, { -17, 4 }, { 0, 0 }, { 0, 17 }, { 0, 1 }, { 0, 2 }, { 0, 3 }, { 0, 4 }, { 0, 5 }, { 0, 6 },
+  { 0, 8 }, { 0, 9 }, { 0, -1 }, { 0, -15 }, { 0, -16 }, { 0, -23 }, { 33, 0 }, { -33, 0 }, { 31, -19 },
+  { -40, 27 }, { 0.5f, -0.5f }, { -0.7f, 0.9f }, { 16, 16 }, { -16, -16 }, { 70, 0 }, { 0, -60 }, { 300, 200 },
+};
+
+struct CanvasTotals {
+  uint32_t steps = 0, refused = 0, moved = 0, scrolled = 0, redrawn = 0;
+  uint64_t incPx = 0, refPx = 0;
+};
+
+struct CanvasPair {
+  MapCanvas inc, ref;
+  int viewW, viewH;
+  std::vector<uint8_t> frames = std::vector<uint8_t>(2 * OFFSCREEN_BUF_SIZE);
+  MapRenderParams params = {};
+  float lat = 0, lon = 0;
+  int32_t scaleX = 0, scaleY = 0;
+
+  CanvasPair(int w, int h) : viewW(w), viewH(h) {
+    params.visibleLayers = LAYER_ALL;
+    memset(params.subtypeVisibility, 0xFF, sizeof(params.subtypeVisibility));
+    params.liveOverlays = false;
+    params.rotation = 0.0f;
+  }
+
+  void start(float zoom, float startLat, float startLon) {
+    params.zoom = zoom;
+    MapCore::scaleForZoom(zoom, scaleX, scaleY);
+    lat = startLat;
+    lon = startLon;
+    inc.invalidate();
+  }
+
+  void step(const char* label, const Pan& pan, CanvasTotals& totals) {
+    lon += pan.x * scaleX / 1000000.0f;
+    lat -= pan.y * scaleY / 1000000.0f;
+    totals.steps++;
+
+    bool incOk = inc.update(lat, lon, params);
+    ref.invalidate();
+    bool refOk = ref.update(lat, lon, params);
+    // Strips need no more tiles than the whole canvas, so they may fit the
+    // cache where a full redraw does not; nothing to compare against then
+    HOST_CHECK(incOk || !refOk, "%s %dx%d z%.1f at %.6f,%.6f: incremental update refused, full redraw done", label,
+               viewW, viewH, params.zoom, lat, lon);
+    if (!refOk) {
+      totals.refused++;
+      return;
+    }
+    if (!incOk) return;
+
+    uint32_t fullPx = ref.lastRenderedPx();
+    uint32_t px = inc.lastRenderedPx();
+    totals.incPx += px;
+    totals.refPx += fullPx;
+    if (px == 0) totals.moved++;
+    else if (px < fullPx) totals.scrolled++;
+    else totals.redrawn++;
+    HOST_CHECK(px <= fullPx, "%s %dx%d z%.1f: pan %.1f,%.1f rendered %u px, more than a full redraw (%u)", label,
+               viewW, viewH, params.zoom, pan.x, pan.y, px, fullPx);
+
+    HOST_CHECK(inc.snappedLat() == ref.snappedLat() && inc.snappedLon() == ref.snappedLon(),
+               "%s %dx%d z%.1f at %.6f,%.6f: snapped to %.6f,%.6f, full redraw %.6f,%.6f", label, viewW, viewH,
+               params.zoom, lat, lon, inc.snappedLat(), inc.snappedLon(), ref.snappedLat(), ref.snappedLon());
+
+    // Frames at the top and at the OLED's content offset (rows past 64 are dropped)
+    for (int offsetY : { 0, 11 }) {
+      memset(frames.data(), 0, frames.size());
+      inc.blit(frames.data(), offsetY);
+      ref.blit(frames.data() + OFFSCREEN_BUF_SIZE, offsetY);
+      HOST_CHECK(memcmp(frames.data(), frames.data() + OFFSCREEN_BUF_SIZE, OFFSCREEN_BUF_SIZE) == 0,
+                 "%s %dx%d z%.1f at %.6f,%.6f: pan %.1f,%.1f (%u px rendered) blits a different frame at row %d",
+                 label, viewW, viewH, params.zoom, lat, lon, pan.x, pan.y, px, offsetY);
+    }
+    // A re-centred canvas sits where a full redraw puts it
+    if (px > 0) {
+      HOST_CHECK(inc.pixelBytes() == ref.pixelBytes() &&
+                 memcmp(inc.pixels(), ref.pixels(), ref.pixelBytes()) == 0,
+                 "%s %dx%d z%.1f at %.6f,%.6f: pan %.1f,%.1f (%u px rendered) leaves different canvas pixels", label,
+                 viewW, viewH, params.zoom, lat, lon, pan.x, pan.y, px);
+    }
+  }
+};
+
+static void checkView(int viewW, int viewH, CanvasTotals& totals) {
+  CanvasPair pair(viewW, viewH);
+  if (!pair.inc.begin(viewW, viewH) || !pair.ref.begin(viewW, viewH)) {
+    HOST_CHECK(false, "%dx%d: canvas allocation failed", viewW, viewH);
+    return;
+  }
+  const HWMapHeader& h = MapCore::getCurrentMap().header;
+  const float midLat = (h.minLat + h.maxLat) / 2000000.0f, midLon = (h.minLon + h.maxLon) / 2000000.0f;
+  const struct { const char* label; float lat, lon; } starts[] = {
+    { "centre", midLat, midLon },
+    { "south-west", h.minLat / 1e6f, h.minLon / 1e6f },
+    { "north-east", h.maxLat / 1e6f, h.maxLon / 1e6f },
+    { "west edge", midLat, h.minLon / 1e6f },
+  };
+  for (float zoom : { 1.0f, 2.0f, 3.0f }) {
+    for (const auto& s : starts) {
+      pair.start(zoom, s.lat, s.lon);
+      for (const Pan& pan : kScriptedPans) pair.step(s.label, pan, totals);
+    }
+    // Random walk from the middle: mostly short pans, now and then a long one
+    pair.start(zoom, midLat, midLon);
+    for (int i = 0; i < 300; i++) {
+      int32_t reach = rnd() % 10 == 0 ? 120 : 24;
+      Pan pan = { rndRange(-reach * 10, reach * 10) / 10.0f, rndRange(-reach * 10, reach * 10) / 10.0f };
+      pair.step("walk", pan, totals);
+    }
+  }
+  pair.inc.end();
+  pair.ref.end();
+}
+
+int main(int argc, char** argv) {
+  if (argc < 2) {
+    fprintf(stderr, "usage: %s <sample.hwmap>\n", argv[0]);
+    return 2;
+  }
+  if (!loadMap(argv[1])) {
+    fprintf(stderr, "failed to load %s\n", argv[1]);
+    return 2;
+  }
+  // The OLED's content area (not a whole number of pages) and a full 128x64 frame
+  for (int viewH : { 43, 64 }) {
+    CanvasTotals totals;
+    checkView(128, viewH, totals);
+    printf("128x%d: %u steps (%u refused): %u moved, %u scrolled, %u redrawn; %.1f%% of the full redraws' pixels\n",
+           viewH, totals.steps, totals.refused, totals.moved, totals.scrolled, totals.redrawn,
+           totals.refPx ? 100.0 * totals.incPx / totals.refPx : 0.0);
+    HOST_CHECK(totals.moved > 0 && totals.scrolled > 0 && totals.redrawn > 0,
+               "128x%d: pans did not exercise every update path", viewH);
+    HOST_CHECK(totals.refused < totals.steps / 10, "128x%d: %u of %u steps refused", viewH, totals.refused,
+               totals.steps);
+  }
+  MapCore::unloadMap();
+  return hostTestResult("map_canvas_test");
+}
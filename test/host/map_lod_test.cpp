@@ -0,0 +1,241 @@
+// Simplified map geometry (MapCore::getTileLod) on the host. For every feature
+// of every tile, at every level:
+// - the kept points are a subsequence of the full line that keeps both ends;
+// - every dropped point lies within the level's tolerance
+//   (MAP_LOD_BASE_TOLERANCE * 4^level quantized units) of the simplified line
+//   segment that replaces it, so nothing on screen moves by more than
+//   MAP_LOD_MAX_ERROR_PX at the zoom renderMap uses the level for;
+// - coarser levels keep a subset of the finer level's points.
+// Runs on the sample map and on generated v6/v7 maps of long random walks,
+// closed rings, spikes that double back, repeated and collinear points.
+//   map_lod_test <sample.hwmap> <scratch dir>
+#include <Arduino.h>
+#include <LittleFS.h>
+
+#include <math.h>
+#include <string>
+#include <vector>
+
+#include "host_test.h"
+#include "hwmap_encode.h"
+#include "System_Maps.h"
+
+static uint32_t sRng = 0x2545F491u;
+static uint32_t rnd() {
+  sRng ^= sRng << 13;
+  sRng ^= sRng >> 17;
+  sRng ^= sRng << 5;
+  return sRng;
+}
+static int32_t rndRange(int32_t lo, int32_t hi) { return lo + (int32_t)(rnd() % (uint32_t)(hi - lo + 1)); }
+
+static bool loadMap(const std::string& path) {
+  size_t slash = path.rfind('/');
+  hostFsSetRoot(slash == std::string::npos ? "." : path.substr(0, slash).c_str());
+  std::string name = "/" + (slash == std::string::npos ? path : path.substr(slash + 1));
+  return MapCore::loadMapFile(name.c_str());
+}
+
+// Distance from p to the segment ab, in quantized units
+static double segmentDistance(const uint16_t* p, const uint16_t* a, const uint16_t* b) {
+  double px = p[1] - (double)a[1], py = p[0] - (double)a[0];
+  double dx = b[1] - (double)a[1], dy = b[0] - (double)a[0];
+  double len2 = dx * dx + dy * dy;
+  double t = len2 > 0 ? (px * dx + py * dy) / len2 : 0;
+  t = t < 0 ? 0 : (t > 1 ? 1 : t);
+  return hypot(px - t * dx, py - t * dy);
+}
+
+struct LodTotals {
+  uint32_t features = 0, points = 0, kept[MAP_LOD_LEVELS] = {};
+  double worst[MAP_LOD_LEVELS] = {};  // Largest error as a fraction of the tolerance
+};
+
+static void checkFeature(const char* label, uint16_t tile, uint16_t f, const std::vector<uint16_t>& full,
+                         const TileLod* lod, LodTotals& totals) {
+  const size_t n = full.size() / 2;
+  std::vector<size_t> finer;
+  for (size_t i = 0; i < n; i++) finer.push_back(i);
+  double tolerance = MAP_LOD_BASE_TOLERANCE;
+  for (uint8_t level = 0; level < MAP_LOD_LEVELS; level++, tolerance *= 4) {
+    const TileLodSpan& span = lod->spans[(size_t)f * MAP_LOD_LEVELS + level];
+    const uint16_t* pts = lod->points + (size_t)span.start * 2;
+    HOST_CHECK(span.start + span.count <= lod->pointCount, "%s tile %u feature %u level %u: span past the points", label,
+               tile, f, level);
+    if (span.start + span.count > lod->pointCount) return;
+    totals.kept[level] += span.count;
+
+    // Ends first, then each kept point to the next full point at its position
+    // (clipped lines can pass the same quantized point more than once)
+    std::vector<size_t> kept;
+    bool ends = span.count >= 2 && pts[0] == full[0] && pts[1] == full[1] &&
+                pts[(span.count - 1) * 2] == full[(n - 1) * 2] && pts[(span.count - 1) * 2 + 1] == full[(n - 1) * 2 + 1];
+    size_t at = 1;
+    if (ends) kept.push_back(0);
+    for (uint16_t k = 1; ends && k + 1 < span.count; k++) {
+      while (at < n - 1 && (full[at * 2] != pts[k * 2] || full[at * 2 + 1] != pts[k * 2 + 1])) at++;
+      if (at == n - 1) break;
+      kept.push_back(at++);
+    }
+    if (ends) kept.push_back(n - 1);
+    if (!ends || kept.size() != span.count) {
+      HOST_CHECK(false, "%s tile %u feature %u level %u: %u kept points are not a subsequence keeping both ends",
+                 label, tile, f, level, span.count);
+      return;
+    }
+
+    for (size_t k = 0; k + 1 < kept.size(); k++) {
+      const uint16_t* a = &full[kept[k] * 2];
+      const uint16_t* b = &full[kept[k + 1] * 2];
+      for (size_t i = kept[k] + 1; i < kept[k + 1]; i++) {
+        double d = segmentDistance(&full[i * 2], a, b);
+        if (d / tolerance > totals.worst[level]) totals.worst[level] = d / tolerance;
+        // Float ranking on the device: allow rounding, nothing more
+        if (d > tolerance * 1.0001 + 0.01) {
+          HOST_CHECK(false, "%s tile %u feature %u level %u: point %zu is %.1f units off the simplified line "
+                     "(tolerance %.0f)", label, tile, f, level, i, d, tolerance);
+          return;
+        }
+      }
+    }
+
+    // By position: a repeated point may match either copy
+    size_t j = 0;
+    for (size_t k : kept) {
+      while (j < finer.size() && (full[finer[j] * 2] != full[k * 2] || full[finer[j] * 2 + 1] != full[k * 2 + 1])) j++;
+      if (j++ == finer.size()) {
+        HOST_CHECK(false, "%s tile %u feature %u level %u: point %zu is not kept by the finer level", label, tile, f,
+                   level, k);
+        return;
+      }
+    }
+    finer = kept;
+  }
+}
+
+static void checkMap(const char* label) {
+  const LoadedMap& map = MapCore::getCurrentMap();
+  LodTotals totals;
+  for (uint16_t t = 0; t < map.tileCount; t++) {
+    size_t size = 0;
+    const uint8_t* data = MapCore::loadTileData(t, &size);
+    if (!data || size < 2) continue;
+    uint16_t refCount = 0;
+    const TileFeatureRef* refs = MapCore::getTileFeatureRefs(t, data, size, &refCount);
+    const TileLod* lod = MapCore::getTileLod(t, data, size);
+    HOST_CHECK(refs && lod, "%s tile %u: no feature index or LOD", label, t);
+    if (!refs || !lod) continue;
+
+    MapTileReader reader(data, size, map.header.version);
+    MapFeatureInfo info;
+    for (uint16_t f = 0; f < refCount; f++) {
+      HOST_CHECK(reader.seek(refs[f].offset, info), "%s tile %u feature %u: bad offset", label, t, f);
+      std::vector<uint16_t> full;
+      uint16_t qLat, qLon;
+      while (reader.point(qLat, qLon)) {
+        full.push_back(qLat);
+        full.push_back(qLon);
+      }
+      if (full.size() < 4) continue;
+      totals.features++;
+      totals.points += (uint32_t)full.size() / 2;
+      checkFeature(label, t, f, full, lod, totals);
+    }
+  }
+  printf("%s: %u features, %u points; kept", label, totals.features, totals.points);
+  for (int l = 0; l < MAP_LOD_LEVELS; l++) {
+    printf(" L%d %u (%.1f%%, worst %.2f tol)", l + 1, totals.kept[l], 100.0 * totals.kept[l] / totals.points,
+           totals.worst[l]);
+  }
+  printf("\n");
+  HOST_CHECK(totals.features > 0, "%s: no features checked", label);
+}
+
+// Lines that stress the simplifier: random walks, rings, spikes, duplicates
+static HWMapEncMap lodMap() {
+  HWMapEncMap map;
+  memcpy(map.regionName, "LodTest", 7);
+  map.minLat = 47600000; map.maxLat = 47632000;
+  map.minLon = -122360000; map.maxLon = -122328000;
+  auto add = [&](uint8_t type, std::vector<HWMapEncPoint> pts) {
+    map.features.push_back({ type, 0, HWMAP_NO_NAME, std::move(pts) });
+  };
+  for (int i = 0; i < 300; i++) {
+    // Random walk with a drift; steps from a few units to a tile
+    std::vector<HWMapEncPoint> pts;
+    int32_t lat = rndRange(map.minLat, map.maxLat), lon = rndRange(map.minLon, map.maxLon);
+    int32_t driftLat = rndRange(-20, 20), driftLon = rndRange(-20, 20), step = rndRange(2, 200);
+    for (int k = rndRange(3, 1500); k > 0; k--) {
+      lat += driftLat + rndRange(-step, step);
+      lon += driftLon + rndRange(-step, step);
+      pts.push_back({ lat, lon });
+      if (rnd() % 50 == 0) pts.push_back({ lat, lon });  // Repeated point
+    }
+    add(MAP_FEATURE_ROAD_MINOR, pts);
+  }
+  for (int i = 0; i < 80; i++) {
+    // Closed ring (first == last), some tiny, some spanning tiles
+    std::vector<HWMapEncPoint> pts;
+    int32_t cLat = rndRange(map.minLat, map.maxLat), cLon = rndRange(map.minLon, map.maxLon);
+    int32_t r = rndRange(5, 1500);
+    int n = rndRange(4, 400);
+    for (int k = 0; k < n; k++) {
+      double a = 2.0 * M_PI * k / n;
+      pts.push_back({ cLat + (int32_t)lround(r * sin(a)) + rndRange(-r / 8, r / 8),
+                      cLon + (int32_t)lround(r * cos(a)) + rndRange(-r / 8, r / 8) });
+    }
+    pts.push_back(pts.front());
+    add(MAP_FEATURE_WATER, pts);
+  }
+  for (int i = 0; i < 120; i++) {
+    // Nearly straight line with spikes that run back past its start or end
+    std::vector<HWMapEncPoint> pts;
+    int32_t lat = rndRange(map.minLat, map.maxLat), lon = rndRange(map.minLon, map.maxLon);
+    int32_t len = rndRange(100, 900);
+    pts.push_back({ lat, lon });
+    for (int k = 1; k < 20; k++) {
+      int32_t along = rnd() % 5 == 0 ? rndRange(-len, 2 * len) : len * k / 20;
+      pts.push_back({ lat + rndRange(-3, 3), lon + along });
+    }
+    pts.push_back({ lat, lon + len });
+    add(MAP_FEATURE_ROAD_MAJOR, pts);
+  }
+  for (int i = 0; i < 40; i++) {
+    // Collinear points and a line folded back onto itself
+    int32_t lat = rndRange(map.minLat, map.maxLat), lon = rndRange(map.minLon, map.maxLon);
+    std::vector<HWMapEncPoint> pts;
+    for (int k = 0; k < 30; k++) pts.push_back({ lat + k * 7, lon + k * 11 });
+    for (int k = 30; k >= 10; k--) pts.push_back({ lat + k * 7, lon + k * 11 });
+    add(MAP_FEATURE_PATH, pts);
+  }
+  return map;
+}
+
+int main(int argc, char** argv) {
+  if (argc < 3) {
+    fprintf(stderr, "usage: %s <sample.hwmap> <scratch dir>\n", argv[0]);
+    return 2;
+  }
+  if (!loadMap(argv[1])) {
+    fprintf(stderr, "failed to load %s\n", argv[1]);
+    return 2;
+  }
+  checkMap("sample");
+  MapCore::unloadMap();
+
+  HWMapEncMap map = lodMap();
+  for (uint16_t version : { 6, 7 }) {
+    HWMapEncOptions options;
+    options.version = version;
+    options.tileGridCode = 0;
+    std::string path = std::string(argv[2]) + "/lod_v" + std::to_string(version) + ".hwmap";
+    std::vector<uint8_t> data = hwmapEncode(map, options);
+    if (data.empty() || !hwmapWriteFile(path.c_str(), data) || !loadMap(path)) {
+      fprintf(stderr, "failed to write or load %s\n", path.c_str());
+      return 2;
+    }
+    checkMap(version == 6 ? "generated v6" : "generated v7");
+    MapCore::unloadMap();
+  }
+  return hostTestResult("map_lod_test");
+}
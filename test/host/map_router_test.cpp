@@ -0,0 +1,420 @@
+// Offline routing (MapRouter::computeRoute, tile-streamed A*) on the host,
+// against Dijkstra over the whole road graph. The reference graph is built
+// from every tile up front with the router's rules (road vertices are nodes,
+// vertices within one quantization step merge, a tile contributes the
+// segments with an endpoint in its core, class-weighted projected length).
+// For each pair of positions:
+// - both ends snap to a road node as near as the nearest one the router can
+//   see (the 3x3 tile blocks around them), or neither finds one;
+// - a route exists exactly when Dijkstra connects the snapped nodes, and its
+//   cost is Dijkstra's;
+// - the polyline runs from the requested start to the requested goal along
+//   graph edges (when not decimated) and its length matches lengthM.
+// Runs on the sample map and on a generated city grid with highways, cut
+// streets and a disconnected island; expansions and times of both searches
+// are printed.
+//   map_router_test <sample.hwmap> <scratch dir>
+#include <Arduino.h>
+#include <LittleFS.h>
+
+#include <math.h>
+#include <queue>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "host_test.h"
+#include "hwmap_encode.h"
+#include "System_Maps.h"
+
+static uint32_t sRng = 0x1B873593u;
+static uint32_t rnd() {
+  sRng ^= sRng << 13;
+  sRng ^= sRng >> 17;
+  sRng ^= sRng << 5;
+  return sRng;
+}
+static int32_t rndRange(int32_t lo, int32_t hi) { return lo + (int32_t)(rnd() % (uint32_t)(hi - lo + 1)); }
+
+static bool loadMap(const std::string& path) {
+  size_t slash = path.rfind('/');
+  hostFsSetRoot(slash == std::string::npos ? "." : path.substr(0, slash).c_str());
+  std::string name = "/" + (slash == std::string::npos ? path : path.substr(slash + 1));
+  return MapCore::loadMapFile(name.c_str());
+}
+
+// Metres per microdegree of latitude, as the router measures
+static const double kMPerMicroLat = 0.1111949;
+
+struct RefGraph {
+  struct Node { int32_t lat, lon; std::vector<std::pair<int32_t, double>> edges; };
+  std::vector<Node> nodes;
+  std::unordered_map<uint64_t, std::vector<int32_t>> cells;
+  int32_t mergeTol = 1;
+  double mPerMicroLon = kMPerMicroLat;
+
+  static int32_t floorDiv(int32_t a, int32_t b) { return a / b - ((a % b != 0 && a < 0) ? 1 : 0); }
+  static uint64_t key(int32_t cy, int32_t cx) { return ((uint64_t)(uint32_t)cy << 32) | (uint32_t)cx; }
+
+  double distance(int32_t lat1, int32_t lon1, int32_t lat2, int32_t lon2) const {
+    double dy = (double)(lat2 - lat1) * kMPerMicroLat, dx = (double)(lon2 - lon1) * mPerMicroLon;
+    return sqrt(dx * dx + dy * dy);
+  }
+
+  int32_t find(int32_t lat, int32_t lon) const {
+    int32_t cy = floorDiv(lat, mergeTol), cx = floorDiv(lon, mergeTol);
+    for (int32_t dy = -1; dy <= 1; dy++) {
+      for (int32_t dx = -1; dx <= 1; dx++) {
+        auto it = cells.find(key(cy + dy, cx + dx));
+        if (it == cells.end()) continue;
+        for (int32_t n : it->second) {
+          if (abs(nodes[n].lat - lat) <= mergeTol && abs(nodes[n].lon - lon) <= mergeTol) return n;
+        }
+      }
+    }
+    return -1;
+  }
+
+  int32_t nodeAt(int32_t lat, int32_t lon) {
+    int32_t n = find(lat, lon);
+    if (n >= 0) return n;
+    nodes.push_back({ lat, lon, {} });
+    cells[key(floorDiv(lat, mergeTol), floorDiv(lon, mergeTol))].push_back((int32_t)nodes.size() - 1);
+    return (int32_t)nodes.size() - 1;
+  }
+
+  void addEdge(int32_t from, int32_t to, double cost) {
+    for (auto& e : nodes[from].edges) {
+      if (e.first == to) {
+        if (cost < e.second) e.second = cost;
+        return;
+      }
+    }
+    nodes[from].edges.push_back({ to, cost });
+  }
+
+  // Core of a tile widened by mergeTol (MapRouter's loadTile rule)
+  bool inCore(const LoadedMap& map, int tx, int ty, int32_t lat, int32_t lon) const {
+    int32_t minLon = map.header.minLon + tx * map.tileW - mergeTol;
+    int32_t minLat = map.header.minLat + ty * map.tileH - mergeTol;
+    return lon >= minLon && lon <= minLon + map.tileW + 2 * mergeTol && lat >= minLat &&
+           lat <= minLat + map.tileH + 2 * mergeTol;
+  }
+
+  void build(const LoadedMap& map) {
+    int32_t span = map.tileW + 2 * map.haloW;
+    if (map.tileH + 2 * map.haloH > span) span = map.tileH + 2 * map.haloH;
+    mergeTol = span / 65536 + 1;
+    float midLat = (map.header.minLat + map.header.maxLat) / 2000000.0f;
+    mPerMicroLon = (float)kMPerMicroLat * cosf(midLat * PI / 180.0f);
+    for (int ty = 0; ty < map.tileGridSize; ty++) {
+      for (int tx = 0; tx < map.tileGridSize; tx++) {
+        uint16_t tileIdx = (uint16_t)(ty * map.tileGridSize + tx);
+        size_t size = 0;
+        const uint8_t* data = MapCore::loadTileData(tileIdx, &size);
+        if (!data || size < 2) continue;
+        int32_t minLon = map.header.minLon + tx * map.tileW - map.haloW;
+        int32_t minLat = map.header.minLat + ty * map.tileH - map.haloH;
+        int32_t lonSpan = map.tileW + 2 * map.haloW, latSpan = map.tileH + 2 * map.haloH;
+        MapTileReader reader(data, size, map.header.version);
+        MapFeatureInfo info;
+        while (reader.next(info)) {
+          double weight = MapRouter::classWeight(info.type);
+          if (weight <= 0 || info.pointCount < 2) continue;
+          uint16_t qLat, qLon;
+          int32_t pLat = 0, pLon = 0;
+          for (uint16_t k = 0; reader.point(qLat, qLon); k++) {
+            int32_t lat = minLat + (int32_t)((int64_t)qLat * latSpan >> 16);
+            int32_t lon = minLon + (int32_t)((int64_t)qLon * lonSpan >> 16);
+            if (k > 0 && (inCore(map, tx, ty, pLat, pLon) || inCore(map, tx, ty, lat, lon))) {
+              int32_t a = nodeAt(pLat, pLon), b = nodeAt(lat, lon);
+              if (a != b) {
+                double cost = (float)distance(pLat, pLon, lat, lon) * weight;
+                addEdge(a, b, cost);
+                addEdge(b, a, cost);
+              }
+            }
+            pLat = lat;
+            pLon = lon;
+          }
+        }
+      }
+    }
+  }
+
+  // Distance to the nearest node the router can snap to from this position:
+  // a connected node with an edge from a core of the 3x3 tile block around it,
+  // or around the other end of the route (both blocks are loaded before snapping)
+  double snapDistance(const LoadedMap& map, int32_t lat, int32_t lon, int32_t otherLat, int32_t otherLon) const {
+    auto seen = [&](int32_t n) {
+      for (const auto& at : { std::make_pair(lat, lon), std::make_pair(otherLat, otherLon) }) {
+        int tx = (at.second - map.header.minLon) / map.tileW, ty = (at.first - map.header.minLat) / map.tileH;
+        for (int y = ty - 1; y <= ty + 1; y++) {
+          for (int x = tx - 1; x <= tx + 1; x++) {
+            if (x < 0 || y < 0 || x >= map.tileGridSize || y >= map.tileGridSize) continue;
+            if (inCore(map, x, y, nodes[n].lat, nodes[n].lon)) return true;
+          }
+        }
+      }
+      return false;
+    };
+    double best = INFINITY;
+    for (int32_t n = 0; n < (int32_t)nodes.size(); n++) {
+      if (nodes[n].edges.empty()) continue;
+      double d = distance(lat, lon, nodes[n].lat, nodes[n].lon);
+      if (d >= best || d > ROUTE_SNAP_MAX_M) continue;
+      bool visible = seen(n);
+      for (size_t k = 0; !visible && k < nodes[n].edges.size(); k++) visible = seen(nodes[n].edges[k].first);
+      if (visible) best = d;
+    }
+    return best;
+  }
+
+  // Cost of the cheapest path, INFINITY if none; settled counts the nodes closed
+  double dijkstra(int32_t from, int32_t to, uint32_t& settled) const {
+    std::vector<double> dist(nodes.size(), INFINITY);
+    std::vector<bool> done(nodes.size(), false);
+    typedef std::pair<double, int32_t> Entry;
+    std::priority_queue<Entry, std::vector<Entry>, std::greater<Entry>> open;
+    dist[from] = 0;
+    open.push({ 0.0, from });
+    settled = 0;
+    while (!open.empty()) {
+      Entry top = open.top();
+      open.pop();
+      if (done[top.second]) continue;
+      done[top.second] = true;
+      settled++;
+      if (top.second == to) return top.first;
+      for (const auto& e : nodes[top.second].edges) {
+        if (top.first + e.second < dist[e.first]) {
+          dist[e.first] = top.first + e.second;
+          open.push({ dist[e.first], e.first });
+        }
+      }
+    }
+    return INFINITY;
+  }
+};
+
+struct RouterTotals {
+  uint32_t pairs = 0, routed = 0, noPath = 0, noRoad = 0, limit = 0;
+  uint64_t astarExpanded = 0, dijkstraSettled = 0;
+  uint32_t astarMs = 0, dijkstraUs = 0, worstMs = 0;
+};
+
+static void checkPair(const char* label, const RefGraph& ref, int32_t fromLat, int32_t fromLon, int32_t toLat,
+                      int32_t toLon, RouterTotals& totals) {
+  const LoadedMap& map = MapCore::getCurrentMap();
+  totals.pairs++;
+  MapRouteResult result = MapRouter::computeRoute(fromLat / 1e6f, fromLon / 1e6f, toLat / 1e6f, toLon / 1e6f);
+  // The router converts through float; so does the reference
+  fromLat = (int32_t)((fromLat / 1e6f) * 1000000); fromLon = (int32_t)((fromLon / 1e6f) * 1000000);
+  toLat = (int32_t)((toLat / 1e6f) * 1000000); toLon = (int32_t)((toLon / 1e6f) * 1000000);
+  double snapFrom = ref.snapDistance(map, fromLat, fromLon, toLat, toLon);
+  double snapTo = ref.snapDistance(map, toLat, toLon, fromLat, fromLon);
+
+  if (result == ROUTE_LIMIT_REACHED) {
+    totals.limit++;
+    return;
+  }
+  if (result == ROUTE_NO_ROAD_AT_START || result == ROUTE_NO_ROAD_AT_GOAL) {
+    totals.noRoad++;
+    bool startMissing = result == ROUTE_NO_ROAD_AT_START;
+    HOST_CHECK(startMissing ? std::isinf(snapFrom) : (!std::isinf(snapFrom) && std::isinf(snapTo)),
+               "%s %d,%d -> %d,%d: %s, reference snaps %.1f m / %.1f m", label, fromLat, fromLon, toLat, toLon,
+               MapRouter::resultString(result), snapFrom, snapTo);
+    return;
+  }
+  HOST_CHECK(!std::isinf(snapFrom) && !std::isinf(snapTo), "%s %d,%d -> %d,%d: %s, but reference finds no road",
+             label, fromLat, fromLon, toLat, toLon, MapRouter::resultString(result));
+  if (std::isinf(snapFrom) || std::isinf(snapTo)) return;
+
+  // Snapped nodes: the router's polyline keeps them next to the connectors
+  // when it routes; otherwise take the reference's nearest visible nodes
+  const MapRoute& route = MapRouter::getRoute();
+  int32_t start = -1, goal = -1;
+  if (result == ROUTE_OK) {
+    uint16_t n = route.pointCount;
+    start = ref.find(route.lat[1], route.lon[1]);
+    goal = ref.find(route.lat[n - 2], route.lon[n - 2]);
+    double dFrom = ref.distance(fromLat, fromLon, route.lat[1], route.lon[1]);
+    double dTo = ref.distance(toLat, toLon, route.lat[n - 2], route.lon[n - 2]);
+    // Node positions are the first vertex seen, which can differ by a merge step
+    double slack = 2 * ref.mergeTol * kMPerMicroLat;
+    HOST_CHECK(dFrom <= snapFrom + slack && dTo <= snapTo + slack,
+               "%s %d,%d -> %d,%d: snapped %.1f m / %.1f m away, nearest road nodes %.1f m / %.1f m", label, fromLat,
+               fromLon, toLat, toLon, dFrom, dTo, snapFrom, snapTo);
+    HOST_CHECK(start >= 0 && goal >= 0, "%s %d,%d -> %d,%d: route ends are not graph nodes", label, fromLat, fromLon,
+               toLat, toLon);
+    if (start < 0 || goal < 0) return;
+  } else {
+    // Unreachable: any node at the snap distance must be cut off from any at the other
+    for (int32_t n = 0; n < (int32_t)ref.nodes.size(); n++) {
+      if (ref.nodes[n].edges.empty()) continue;
+      if (start < 0 && fabs(ref.distance(fromLat, fromLon, ref.nodes[n].lat, ref.nodes[n].lon) - snapFrom) < 1e-6) start = n;
+      if (goal < 0 && fabs(ref.distance(toLat, toLon, ref.nodes[n].lat, ref.nodes[n].lon) - snapTo) < 1e-6) goal = n;
+    }
+  }
+
+  uint32_t t0 = micros();
+  uint32_t settled = 0;
+  double cost = ref.dijkstra(start, goal, settled);
+  totals.dijkstraUs += micros() - t0;
+
+  if (result == ROUTE_NO_PATH) {
+    totals.noPath++;
+    HOST_CHECK(std::isinf(cost), "%s %d,%d -> %d,%d: no path, Dijkstra finds one costing %.1f", label, fromLat,
+               fromLon, toLat, toLon, cost);
+    return;
+  }
+  HOST_CHECK(result == ROUTE_OK, "%s %d,%d -> %d,%d: %s", label, fromLat, fromLon, toLat, toLon,
+             MapRouter::resultString(result));
+  if (result != ROUTE_OK) return;
+  totals.routed++;
+  totals.astarExpanded += route.nodesExpanded;
+  totals.dijkstraSettled += settled;
+  totals.astarMs += route.computeMs;
+  if (route.computeMs > totals.worstMs) totals.worstMs = route.computeMs;
+
+  // Float sums on the device; edge costs come from vertices, the heuristic
+  // from merged node positions, so allow a merge step per edge at most
+  HOST_CHECK(!std::isinf(cost) && fabs(route.costM - cost) <= 0.5 + cost * 1e-4,
+             "%s %d,%d -> %d,%d: route costs %.2f, Dijkstra %.2f", label, fromLat, fromLon, toLat, toLon,
+             route.costM, cost);
+
+  HOST_CHECK(route.pointCount >= 3 && route.pointCount <= ROUTE_MAX_POINTS + 2 && route.lat[0] == fromLat &&
+                 route.lon[0] == fromLon && route.lat[route.pointCount - 1] == toLat &&
+                 route.lon[route.pointCount - 1] == toLon,
+             "%s %d,%d -> %d,%d: polyline of %u points does not run from start to goal", label, fromLat, fromLon,
+             toLat, toLon, route.pointCount);
+  double length = 0, walked = 0;
+  bool onGraph = true;
+  for (uint16_t i = 0; i + 1 < route.pointCount; i++) {
+    length += ref.distance(route.lat[i], route.lon[i], route.lat[i + 1], route.lon[i + 1]);
+    if (i == 0 || i + 2 >= route.pointCount) continue;
+    int32_t a = ref.find(route.lat[i], route.lon[i]), b = ref.find(route.lat[i + 1], route.lon[i + 1]);
+    const RefGraph::Node* node = a >= 0 ? &ref.nodes[a] : nullptr;
+    bool adjacent = false;
+    for (size_t k = 0; node && k < node->edges.size(); k++) {
+      if (node->edges[k].first == b) {
+        adjacent = true;
+        walked += node->edges[k].second;
+      }
+    }
+    onGraph = onGraph && adjacent;
+  }
+  if (route.pointCount < ROUTE_MAX_POINTS) {
+    HOST_CHECK(onGraph, "%s %d,%d -> %d,%d: polyline leaves the road graph", label, fromLat, fromLon, toLat, toLon);
+    HOST_CHECK(fabs(walked - cost) <= 0.5 + cost * 1e-4, "%s %d,%d -> %d,%d: polyline edges cost %.2f, Dijkstra %.2f",
+               label, fromLat, fromLon, toLat, toLon, walked, cost);
+    HOST_CHECK(fabs(length - route.lengthM) <= 0.5 + length * 1e-4, "%s %d,%d -> %d,%d: lengthM %.2f, polyline %.2f",
+               label, fromLat, fromLon, toLat, toLon, route.lengthM, length);
+  }
+}
+
+static void checkMap(const char* label, uint32_t pairs, int32_t maxSpan, uint32_t minRouted) {
+  const LoadedMap& map = MapCore::getCurrentMap();
+  RefGraph ref;
+  ref.build(map);
+  const HWMapHeader& h = map.header;
+  RouterTotals totals;
+  for (uint32_t i = 0; i < pairs; i++) {
+    int32_t fromLat = rndRange(h.minLat, h.maxLat), fromLon = rndRange(h.minLon, h.maxLon);
+    int32_t toLat = fromLat + rndRange(-maxSpan, maxSpan), toLon = fromLon + rndRange(-maxSpan, maxSpan);
+    toLat = toLat < h.minLat ? h.minLat : (toLat > h.maxLat ? h.maxLat : toLat);
+    toLon = toLon < h.minLon ? h.minLon : (toLon > h.maxLon ? h.maxLon : toLon);
+    checkPair(label, ref, fromLat, fromLon, toLat, toLon, totals);
+  }
+  MapRouter::clearRoute();
+  printf("%s: %zu nodes; %u pairs: %u routed, %u unreachable, %u off-road, %u over limits\n", label,
+         ref.nodes.size(), totals.pairs, totals.routed, totals.noPath, totals.noRoad, totals.limit);
+  if (totals.routed) {
+    printf("%s: A* expands %.0f nodes/route (%.1f ms, worst %u ms incl. tile reads), Dijkstra settles %.0f (%.2f ms "
+           "on the prebuilt graph)\n", label, (double)totals.astarExpanded / totals.routed,
+           (double)totals.astarMs / totals.routed, totals.worstMs, (double)totals.dijkstraSettled / totals.routed,
+           totals.dijkstraUs / 1000.0 / totals.routed);
+  }
+  HOST_CHECK(totals.routed >= minRouted, "%s: only %u of %u pairs routed", label, totals.routed, pairs);
+  HOST_CHECK(totals.limit == 0, "%s: %u routes hit the search limits", label, totals.limit);
+}
+
+// A city grid: a highway every 10th line, major roads every 4th, minor streets
+// between, some streets cut, footpaths on diagonals, and an island of streets
+// with no link to the rest
+static HWMapEncMap cityMap() {
+  HWMapEncMap map;
+  memcpy(map.regionName, "Grid", 4);
+  map.minLat = 47600000; map.maxLat = 47664000;
+  map.minLon = -122360000; map.maxLon = -122296000;
+  const int32_t step = 1000;
+  const int lines = 64;
+  auto typeOf = [](int i) -> uint8_t {
+    return i % 10 == 0 ? MAP_FEATURE_HIGHWAY : (i % 4 == 0 ? MAP_FEATURE_ROAD_MAJOR : MAP_FEATURE_ROAD_MINOR);
+  };
+  for (int dir = 0; dir < 2; dir++) {
+    for (int i = 1; i < lines; i++) {
+      std::vector<HWMapEncPoint> pts;
+      for (int k = 1; k < lines; k++) {
+        int32_t lat = map.minLat + (dir ? i : k) * step, lon = map.minLon + (dir ? k : i) * step;
+        bool cut = typeOf(i) == MAP_FEATURE_ROAD_MINOR && rnd() % 6 == 0;
+        if (cut || (i > 54 && k > 54) || (i == 54 && k >= 54) || (k == 54 && i >= 54)) {
+          if (pts.size() >= 2) map.features.push_back({ typeOf(i), 0, HWMAP_NO_NAME, pts });
+          pts.clear();
+          if (cut || (i > 54 && k > 54)) continue;
+        }
+        pts.push_back({ lat, lon });
+      }
+      if (pts.size() >= 2) map.features.push_back({ typeOf(i), 0, HWMAP_NO_NAME, pts });
+    }
+  }
+  // Island: streets inside the cut-off corner
+  for (int i = 56; i < lines; i += 2) {
+    map.features.push_back({ MAP_FEATURE_ROAD_MINOR, 0, HWMAP_NO_NAME,
+                             { { map.minLat + i * step, map.minLon + 56 * step },
+                               { map.minLat + i * step, map.minLon + 62 * step } } });
+    map.features.push_back({ MAP_FEATURE_ROAD_MINOR, 0, HWMAP_NO_NAME,
+                             { { map.minLat + 56 * step, map.minLon + i * step },
+                               { map.minLat + 62 * step, map.minLon + i * step } } });
+  }
+  for (int i = 0; i < 120; i++) {
+    // Footpath along a diagonal through intersections, with bends off the grid
+    int r = rndRange(1, 45), c = rndRange(1, 45);
+    std::vector<HWMapEncPoint> pts;
+    for (int k = 0; k < rndRange(2, 8); k++) {
+      int32_t lat = map.minLat + (r + k) * step, lon = map.minLon + (c + k) * step;
+      pts.push_back({ lat, lon });
+      pts.push_back({ lat + step / 2 + rndRange(-90, 90), lon + step / 2 + rndRange(-90, 90) });
+    }
+    pts.pop_back();
+    map.features.push_back({ MAP_FEATURE_PATH, 0, HWMAP_NO_NAME, pts });
+  }
+  return map;
+}
+
+int main(int argc, char** argv) {
+  if (argc < 3) {
+    fprintf(stderr, "usage: %s <sample.hwmap> <scratch dir>\n", argv[0]);
+    return 2;
+  }
+  if (!loadMap(argv[1])) {
+    fprintf(stderr, "failed to load %s\n", argv[1]);
+    return 2;
+  }
+  // The sample city's streets cross without sharing vertices: few pairs connect
+  checkMap("sample", 200, 20000, 1);
+  MapCore::unloadMap();
+
+  HWMapEncOptions options;
+  options.version = 7;
+  options.tileGridCode = 0;
+  std::string path = std::string(argv[2]) + "/router_city.hwmap";
+  std::vector<uint8_t> data = hwmapEncode(cityMap(), options);
+  if (data.empty() || !hwmapWriteFile(path.c_str(), data) || !loadMap(path)) {
+    fprintf(stderr, "failed to write or load %s\n", path.c_str());
+    return 2;
+  }
+  checkMap("city", 300, 64000, 200);
+  MapCore::unloadMap();
+  return hostTestResult("map_router_test");
+}
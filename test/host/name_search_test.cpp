@@ -0,0 +1,216 @@
+// Map place-name search on the host, against a linear strncasecmp scan over
+// the name table (what searchNamesByPrefix did before the sorted index).
+// - The sorted index is a permutation of the table in case-folded order, with
+//   equal names in file order.
+// - For every prefix tried, findNamePrefixRange() covers exactly the names the
+//   linear scan matches, and searchNamesByPrefix() returns them in index order.
+// - findFeaturesByName() returns the (tile, offset) of every feature carrying
+//   the name, as a walk over all tile payloads finds them.
+// Runs on the sample map and on a generated one with thousands of names
+// (mixed case, punctuation around the letters, UTF-8, duplicates, prefixes of
+// each other, over-long and empty names).
+//   name_search_test <sample.hwmap> <scratch dir>
+#include <Arduino.h>
+#include <LittleFS.h>
+
+#include <algorithm>
+#include <string>
+#include <vector>
+
+#include "host_test.h"
+#include "hwmap_encode.h"
+#include "System_Maps.h"
+
+static uint32_t sRng = 0x9E3779B9u;
+static uint32_t rnd() {
+  sRng ^= sRng << 13;
+  sRng ^= sRng >> 17;
+  sRng ^= sRng << 5;
+  return sRng;
+}
+static int rndRange(int lo, int hi) { return lo + (int)(rnd() % (uint32_t)(hi - lo + 1)); }
+
+static bool loadMap(const std::string& path) {
+  size_t slash = path.rfind('/');
+  hostFsSetRoot(slash == std::string::npos ? "." : path.substr(0, slash).c_str());
+  std::string name = "/" + (slash == std::string::npos ? path : path.substr(slash + 1));
+  return MapCore::loadMapFile(name.c_str());
+}
+
+static std::vector<uint16_t> linearMatches(const char* prefix) {
+  const LoadedMap& map = MapCore::getCurrentMap();
+  size_t len = strlen(prefix);
+  std::vector<uint16_t> out;
+  for (uint16_t i = 0; i < map.nameCount; i++) {
+    if (strncasecmp(MapCore::getName(i), prefix, len) == 0) out.push_back(i);
+  }
+  return out;
+}
+
+static void checkSortedIndex(const char* label) {
+  const LoadedMap& map = MapCore::getCurrentMap();
+  std::vector<uint16_t> seen;
+  for (uint32_t pos = 0; pos < map.nameCount; pos++) {
+    uint16_t idx = MapCore::getSortedNameIndex(pos);
+    seen.push_back(idx);
+    if (pos == 0 || idx >= map.nameCount) continue;
+    uint16_t prev = MapCore::getSortedNameIndex(pos - 1);
+    int c = strcasecmp(MapCore::getName(prev), MapCore::getName(idx));
+    HOST_CHECK(c < 0 || (c == 0 && prev < idx), "%s: sorted positions %u/%u out of order ('%s', '%s')", label,
+               pos - 1, pos, MapCore::getName(prev), MapCore::getName(idx));
+  }
+  std::sort(seen.begin(), seen.end());
+  for (uint32_t i = 0; i < seen.size(); i++) {
+    if (seen[i] != i) {
+      HOST_CHECK(false, "%s: sorted index is not a permutation of the name table", label);
+      break;
+    }
+  }
+  HOST_CHECK(MapCore::getSortedNameIndex(map.nameCount) == HWMAP_NO_NAME, "%s: position past the end resolved", label);
+}
+
+static uint32_t checkPrefix(const char* label, const char* prefix) {
+  uint32_t first = 0;
+  uint32_t count = MapCore::findNamePrefixRange(prefix, &first);
+  std::vector<uint16_t> expected = linearMatches(prefix);
+  std::vector<uint16_t> found;
+  for (uint32_t i = 0; i < count; i++) found.push_back(MapCore::getSortedNameIndex(first + i));
+  std::vector<uint16_t> sortedFound = found;
+  std::sort(sortedFound.begin(), sortedFound.end());
+  HOST_CHECK(sortedFound == expected, "%s: prefix '%s' matches %u names, linear scan %zu", label, prefix, count,
+             expected.size());
+
+  const char* results[8];
+  int n = MapCore::searchNamesByPrefix(prefix, results, 8);
+  HOST_CHECK(n == (int)std::min<size_t>(8, expected.size()), "%s: prefix '%s': %d results, expected %zu", label,
+             prefix, n, std::min<size_t>(8, expected.size()));
+  for (int i = 0; i < n && i < (int)found.size(); i++) {
+    HOST_CHECK(results[i] == MapCore::getName(found[i]), "%s: prefix '%s' result %d is '%s', expected '%s'", label,
+               prefix, i, results[i], MapCore::getName(found[i]));
+  }
+  return 1;
+}
+
+static void checkPrefixes(const char* label) {
+  const LoadedMap& map = MapCore::getCurrentMap();
+  uint32_t first = 1;
+  HOST_CHECK(MapCore::findNamePrefixRange("", &first) == map.nameCount && first == 0, "%s: empty prefix", label);
+  HOST_CHECK(MapCore::findNamePrefixRange(nullptr, &first) == map.nameCount && first == 0, "%s: null prefix", label);
+
+  uint32_t prefixes = 0;
+  for (uint16_t i = 0; i < map.nameCount; i++) {
+    std::string name = MapCore::getName(i);
+    // Short prefixes (long runs), the whole name, a case flip and one past it
+    for (size_t len : { (size_t)1, (size_t)2, (size_t)3, name.size() }) {
+      if (len == 0 || len > name.size()) continue;
+      std::string p = name.substr(0, len);
+      prefixes += checkPrefix(label, p.c_str());
+      for (char& c : p) c = (char)(isupper((unsigned char)c) ? tolower((unsigned char)c) : toupper((unsigned char)c));
+      prefixes += checkPrefix(label, p.c_str());
+    }
+    prefixes += checkPrefix(label, (name + "~").c_str());
+  }
+  // Every single byte, and strings that fall between names
+  for (int c = 1; c < 256; c++) {
+    char p[2] = { (char)c, 0 };
+    prefixes += checkPrefix(label, p);
+  }
+  static const char* kAlphabet = "aAeEnNsS _[`'-0Z\xc3\xa9";
+  for (int i = 0; i < 2000; i++) {
+    std::string p;
+    for (int k = rndRange(1, 5); k > 0; k--) p += kAlphabet[rnd() % strlen(kAlphabet)];
+    prefixes += checkPrefix(label, p.c_str());
+  }
+  printf("%s: %u names, %u prefixes checked\n", label, map.nameCount, prefixes);
+}
+
+static void checkNameRefs(const char* label) {
+  const LoadedMap& map = MapCore::getCurrentMap();
+  std::vector<std::vector<MapNameRef>> expected(map.nameCount);
+  for (uint16_t t = 0; t < map.tileCount; t++) {
+    size_t size = 0;
+    const uint8_t* data = MapCore::loadTileData(t, &size);
+    if (!data || size < 2) continue;
+    MapTileReader reader(data, size, map.header.version);
+    MapFeatureInfo info;
+    while (reader.next(info)) {
+      if (info.nameIndex < map.nameCount) expected[info.nameIndex].push_back({ t, info.offset });
+    }
+  }
+  uint32_t refs = 0;
+  std::vector<MapNameRef> found(4096);
+  for (uint16_t i = 0; i < map.nameCount; i++) {
+    int n = MapCore::findFeaturesByName(i, found.data(), (int)found.size());
+    bool same = n == (int)expected[i].size();
+    for (int k = 0; same && k < n; k++) {
+      same = found[k].tileIdx == expected[i][k].tileIdx && found[k].offset == expected[i][k].offset;
+    }
+    HOST_CHECK(same, "%s: name %u '%s': %d features, a tile walk finds %zu", label, i, MapCore::getName(i), n,
+               expected[i].size());
+    refs += (uint32_t)expected[i].size();
+  }
+  printf("%s: %u named features across %u tiles\n", label, refs, map.tileCount);
+}
+
+static void checkMap(const char* label) {
+  checkSortedIndex(label);
+  checkPrefixes(label);
+  checkNameRefs(label);
+}
+
+// A regional map's worth of place names over a 32x32 tile grid
+static std::vector<uint8_t> namesMap() {
+  static const char* kWords[] = { "Main", "main", "MAIN", "Oak", "Oakland", "Oakwood", "Elm", "St", "St.",
+                                  "Saint", "Ave", "Avenue", "North", "N", "_Depot", "[Closed]", "`Quote",
+                                  "Caf\xc3\xa9", "\xc3\x89glise", "Zo\xc3\xab", "1st", "10th", "A", "a", "Z" };
+  const int kWordCount = (int)(sizeof(kWords) / sizeof(kWords[0]));
+  HWMapEncMap map;
+  memcpy(map.regionName, "Names", 5);
+  map.minLat = 47600000; map.maxLat = 47664000;
+  map.minLon = -122360000; map.maxLon = -122296000;
+  map.names.push_back("");
+  map.names.push_back(std::string(240, 'L'));
+  while (map.names.size() < 3000) {
+    if (map.names.size() > 10 && rnd() % 8 == 0) {
+      map.names.push_back(map.names[rnd() % map.names.size()]);  // Duplicate
+      continue;
+    }
+    std::string name = kWords[rnd() % kWordCount];
+    for (int k = rndRange(0, 2); k > 0; k--) name += std::string(" ") + kWords[rnd() % kWordCount];
+    if (rnd() % 4 == 0) name += " " + std::to_string(rndRange(1, 999));
+    map.names.push_back(name);
+  }
+  for (int i = 0; i < 6000; i++) {
+    int32_t lat = rndRange(map.minLat, map.maxLat - 600), lon = rndRange(map.minLon, map.maxLon - 600);
+    uint16_t name = rnd() % 10 == 0 ? HWMAP_NO_NAME : (uint16_t)(rnd() % map.names.size());
+    map.features.push_back({ MAP_FEATURE_ROAD_MINOR, SUBTYPE_MINOR_RESIDENTIAL, name,
+                             { { lat, lon }, { lat + rndRange(0, 600), lon + rndRange(0, 600) } } });
+  }
+  HWMapEncOptions options;
+  options.version = 7;
+  return hwmapEncode(map, options);
+}
+
+int main(int argc, char** argv) {
+  if (argc < 3) {
+    fprintf(stderr, "usage: %s <sample.hwmap> <scratch dir>\n", argv[0]);
+    return 2;
+  }
+  if (!loadMap(argv[1])) {
+    fprintf(stderr, "failed to load %s\n", argv[1]);
+    return 2;
+  }
+  checkMap("sample");
+  MapCore::unloadMap();
+
+  std::string path = std::string(argv[2]) + "/names.hwmap";
+  std::vector<uint8_t> data = namesMap();
+  if (data.empty() || !hwmapWriteFile(path.c_str(), data) || !loadMap(path)) {
+    fprintf(stderr, "failed to write or load %s\n", path.c_str());
+    return 2;
+  }
+  HOST_CHECK(MapCore::getCurrentMap().nameCount == 3000, "%u of 3000 names loaded", MapCore::getCurrentMap().nameCount);
+  checkMap("generated");
+  MapCore::unloadMap();
+  return hostTestResult("name_search_test");
+}
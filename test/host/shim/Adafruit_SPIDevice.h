@@ -0,0 +1,2 @@
+// Host build shim: Adafruit_GFX.h includes BusIO, the host units never use it
+#pragma once
@@ -0,0 +1,82 @@
+// Host build shim: an ST7789 panel in memory. Direct drawing lands in mem per
+// pixel; setAddrWindow() + writePixels() and drawRGBBitmap() behave like
+// Adafruit_SPITFT (clipped window, row-major burst) and are counted, so tests
+// can tell bulk pushes from per-pixel traffic.
+#pragma once
+
+#include <Adafruit_GFX.h>
+
+#include <vector>
+
+#define ST77XX_BLACK   0x0000
+#define ST77XX_WHITE   0xFFFF
+#define ST77XX_RED     0xF800
+#define ST77XX_GREEN   0x07E0
+#define ST77XX_BLUE    0x001F
+#define ST77XX_CYAN    0x07FF
+#define ST77XX_MAGENTA 0xF81F
+#define ST77XX_YELLOW  0xFFE0
+#define ST77XX_ORANGE  0xFC00
+
+class Adafruit_ST7789 : public Adafruit_GFX {
+public:
+  Adafruit_ST7789(int8_t cs, int8_t dc, int8_t rst) : Adafruit_GFX(240, 320), mem((size_t)240 * 320, 0) {
+    (void)cs; (void)dc; (void)rst;
+  }
+
+  void drawPixel(int16_t x, int16_t y, uint16_t color) override {
+    if (x < 0 || y < 0 || x >= _width || y >= _height) return;
+    mem[(size_t)y * _width + x] = color;
+    directPixels++;
+  }
+  void startWrite() override { inWrite++; }
+  void endWrite() override { inWrite--; }
+
+  void writeFillRect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color) override { fill(x, y, w, h, color); }
+  void fillRect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color) override { fill(x, y, w, h, color); }
+  void writeFastHLine(int16_t x, int16_t y, int16_t w, uint16_t color) override { fill(x, y, w, 1, color); }
+  void drawFastHLine(int16_t x, int16_t y, int16_t w, uint16_t color) override { fill(x, y, w, 1, color); }
+  void writeFastVLine(int16_t x, int16_t y, int16_t h, uint16_t color) override { fill(x, y, 1, h, color); }
+  void drawFastVLine(int16_t x, int16_t y, int16_t h, uint16_t color) override { fill(x, y, 1, h, color); }
+
+  void setAddrWindow(uint16_t x, uint16_t y, uint16_t w, uint16_t h) {
+    _wx = x; _wy = y; _ww = w; _wh = h; _wpos = 0;
+    windows++;
+    if (!inWrite || x + w > _width || y + h > _height) windowErrors++;
+  }
+  void writePixels(uint16_t* colors, uint32_t len) {
+    for (uint32_t i = 0; i < len; i++, _wpos++) {
+      if (_wpos >= (uint32_t)_ww * _wh) { windowErrors++; return; }
+      mem[(size_t)(_wy + _wpos / _ww) * _width + _wx + _wpos % _ww] = colors[i];
+    }
+    windowPixels += len;
+  }
+
+  using Adafruit_GFX::drawRGBBitmap;
+  void drawRGBBitmap(int16_t x, int16_t y, uint16_t* pcolors, int16_t w, int16_t h) {
+    int16_t x0 = x < 0 ? 0 : x, y0 = y < 0 ? 0 : y;
+    int16_t x1 = (x + w > _width) ? _width : x + w, y1 = (y + h > _height) ? _height : y + h;
+    if (x0 >= x1 || y0 >= y1) return;
+    startWrite();
+    setAddrWindow(x0, y0, x1 - x0, y1 - y0);
+    for (int16_t yy = y0; yy < y1; yy++) writePixels(&pcolors[(int32_t)(yy - y) * w + (x0 - x)], x1 - x0);
+    endWrite();
+  }
+
+  std::vector<uint16_t> mem;
+  int inWrite = 0;
+  uint32_t directPixels = 0, windows = 0, windowErrors = 0;
+  uint64_t windowPixels = 0;
+
+private:
+  // Fills flip negative sizes and clip like Adafruit_SPITFT
+  void fill(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color) {
+    if (w < 0) { x += w + 1; w = -w; }
+    if (h < 0) { y += h + 1; h = -h; }
+    for (int16_t yy = y; yy < y + h; yy++)
+      for (int16_t xx = x; xx < x + w; xx++) drawPixel(xx, yy, color);
+  }
+
+  uint16_t _wx = 0, _wy = 0, _ww = 0, _wh = 0;
+  uint32_t _wpos = 0;
+};
@@ -0,0 +1,247 @@
+// Host build shim: the subset of the Arduino-ESP32 core used by the units
+// compiled into the host tests (String, Print, timing, ESP object).
+#pragma once
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdarg.h>
+#include <math.h>
+#include <ctype.h>
+#include <string>
+#include <algorithm>
+
+#ifndef PI
+#define PI 3.1415926535897932384626433832795
+#endif
+#define DEG_TO_RAD 0.017453292519943295769236907684886
+#define RAD_TO_DEG 57.295779513082320876798154814105
+
+#include "pgmspace.h"
+#define IRAM_ATTR
+#define DRAM_ATTR
+
+#ifndef constrain
+#define constrain(amt, low, high) ((amt) < (low) ? (low) : ((amt) > (high) ? (high) : (amt)))
+#endif
+
+// newlib has these; glibc only from 2.38
+#if defined(__GLIBC__) && (__GLIBC__ < 2 || (__GLIBC__ == 2 && __GLIBC_MINOR__ < 38))
+static inline size_t strlcpy(char* dst, const char* src, size_t size) {
+  size_t len = strlen(src);
+  if (size) {
+    size_t n = len < size - 1 ? len : size - 1;
+    memcpy(dst, src, n);
+    dst[n] = '\0';
+  }
+  return len;
+}
+static inline size_t strlcat(char* dst, const char* src, size_t size) {
+  size_t used = strnlen(dst, size);
+  return used + strlcpy(dst + used, src, size - used);
+}
+#endif
+
+// Arduino-ESP32 PSRAM allocators (esp32-hal-psram.h)
+static inline void* ps_malloc(size_t size) { return malloc(size); }
+static inline void* ps_realloc(void* ptr, size_t size) { return realloc(ptr, size); }
+
+class __FlashStringHelper;
+#define F(s) ((const __FlashStringHelper*)(s))
+
+typedef bool boolean;
+typedef uint8_t byte;
+
+unsigned long millis();
+unsigned long micros();
+void delay(uint32_t ms);
+void yield();
+
+// Advances millis()/micros() without sleeping (host tests drive time explicitly)
+void hostAdvanceMicros(uint64_t us);
+
+class String {
+public:
+  String() {}
+  String(const char* s) : _s(s ? s : "") {}
+  String(const std::string& s) : _s(s) {}
+  String(char c) : _s(1, c) {}
+  String(int v) : _s(std::to_string(v)) {}
+  String(unsigned int v) : _s(std::to_string(v)) {}
+  String(long v) : _s(std::to_string(v)) {}
+  String(unsigned long v) : _s(std::to_string(v)) {}
+  String(float v, unsigned decimals = 2) { fmtFloat(v, decimals); }
+  String(double v, unsigned decimals = 2) { fmtFloat(v, decimals); }
+
+  const char* c_str() const { return _s.c_str(); }
+  unsigned int length() const { return (unsigned int)_s.size(); }
+  bool isEmpty() const { return _s.empty(); }
+  bool reserve(unsigned int n) { _s.reserve(n); return true; }
+  char charAt(unsigned int i) const { return i < _s.size() ? _s[i] : 0; }
+  char operator[](unsigned int i) const { return charAt(i); }
+  char& operator[](unsigned int i) { return _s[i]; }
+
+  String& operator=(const char* s) { _s = s ? s : ""; return *this; }
+  String& operator+=(const String& o) { _s += o._s; return *this; }
+  String& operator+=(const char* s) { if (s) _s += s; return *this; }
+  String& operator+=(char c) { _s += c; return *this; }
+  String& operator+=(int v) { _s += std::to_string(v); return *this; }
+  String& operator+=(unsigned int v) { _s += std::to_string(v); return *this; }
+  String& operator+=(long v) { _s += std::to_string(v); return *this; }
+  String& operator+=(unsigned long v) { _s += std::to_string(v); return *this; }
+  bool concat(const char* s) { if (s) _s += s; return true; }
+  bool concat(const char* s, unsigned int n) { if (s) _s.append(s, n); return true; }
+  bool concat(char c) { _s += c; return true; }
+  bool concat(const String& o) { _s += o._s; return true; }
+
+  bool operator==(const String& o) const { return _s == o._s; }
+  bool operator==(const char* s) const { return _s == (s ? s : ""); }
+  bool operator!=(const String& o) const { return _s != o._s; }
+  bool operator!=(const char* s) const { return !(*this == s); }
+  bool operator<(const String& o) const { return _s < o._s; }
+  bool equals(const String& o) const { return _s == o._s; }
+  bool equalsIgnoreCase(const String& o) const {
+    if (_s.size() != o._s.size()) return false;
+    for (size_t i = 0; i < _s.size(); i++)
+      if (tolower((unsigned char)_s[i]) != tolower((unsigned char)o._s[i])) return false;
+    return true;
+  }
+
+  int indexOf(char c, unsigned int from = 0) const { return pos(_s.find(c, from)); }
+  int indexOf(const String& s, unsigned int from = 0) const { return pos(_s.find(s._s, from)); }
+  int indexOf(const char* s, unsigned int from = 0) const { return pos(_s.find(s, from)); }
+  int lastIndexOf(char c) const { return pos(_s.rfind(c)); }
+  int lastIndexOf(const String& s) const { return pos(_s.rfind(s._s)); }
+  bool startsWith(const String& p) const { return _s.compare(0, p._s.size(), p._s) == 0; }
+  bool endsWith(const String& p) const {
+    return _s.size() >= p._s.size() && _s.compare(_s.size() - p._s.size(), p._s.size(), p._s) == 0;
+  }
+  String substring(unsigned int from) const { return from < _s.size() ? String(_s.substr(from)) : String(); }
+  String substring(unsigned int from, unsigned int to) const {
+    if (from > to) std::swap(from, to);
+    if (from >= _s.size()) return String();
+    return String(_s.substr(from, std::min<size_t>(to, _s.size()) - from));
+  }
+
+  void trim() {
+    size_t a = 0, b = _s.size();
+    while (a < b && isspace((unsigned char)_s[a])) a++;
+    while (b > a && isspace((unsigned char)_s[b - 1])) b--;
+    _s = _s.substr(a, b - a);
+  }
+  void toLowerCase() { for (auto& c : _s) c = (char)tolower((unsigned char)c); }
+  void toUpperCase() { for (auto& c : _s) c = (char)toupper((unsigned char)c); }
+  void replace(const String& from, const String& to) {
+    if (from._s.empty()) return;
+    for (size_t p = 0; (p = _s.find(from._s, p)) != std::string::npos; p += to._s.size())
+      _s.replace(p, from._s.size(), to._s);
+  }
+  void remove(unsigned int index) { if (index < _s.size()) _s.erase(index); }
+  void remove(unsigned int index, unsigned int count) { if (index < _s.size()) _s.erase(index, count); }
+  long toInt() const { return strtol(_s.c_str(), nullptr, 10); }
+  float toFloat() const { return strtof(_s.c_str(), nullptr); }
+  double toDouble() const { return strtod(_s.c_str(), nullptr); }
+
+  friend String operator+(const String& a, const String& b) { String r(a); r += b; return r; }
+  friend String operator+(const String& a, const char* b) { String r(a); r += b; return r; }
+  friend String operator+(const char* a, const String& b) { String r(a); r += b; return r; }
+  friend String operator+(const String& a, char b) { String r(a); r += b; return r; }
+  friend String operator+(const String& a, int b) { String r(a); r += b; return r; }
+
+private:
+  std::string _s;
+  static int pos(size_t p) { return p == std::string::npos ? -1 : (int)p; }
+  void fmtFloat(double v, unsigned decimals) {
+    char buf[64];
+    snprintf(buf, sizeof(buf), "%.*f", (int)decimals, v);
+    _s = buf;
+  }
+};
+
+class Print {
+public:
+  virtual ~Print() {}
+  virtual size_t write(uint8_t c) = 0;
+  virtual size_t write(const uint8_t* buf, size_t len) {
+    size_t n = 0;
+    while (len--) n += write(*buf++);
+    return n;
+  }
+  size_t write(const char* s) { return s ? write((const uint8_t*)s, strlen(s)) : 0; }
+  size_t print(const char* s) { return write(s); }
+  size_t print(const String& s) { return write((const uint8_t*)s.c_str(), s.length()); }
+  size_t print(char c) { return write((uint8_t)c); }
+  size_t print(int v) { return print(String(v)); }
+  size_t print(unsigned int v) { return print(String(v)); }
+  size_t print(long v) { return print(String(v)); }
+  size_t print(unsigned long v) { return print(String(v)); }
+  size_t print(double v, int digits = 2) { return print(String(v, digits)); }
+  size_t println() { return write((uint8_t)'\n'); }
+  template <typename T> size_t println(const T& v) { size_t n = print(v); return n + println(); }
+  size_t printf(const char* fmt, ...) __attribute__((format(printf, 2, 3))) {
+    char buf[512];
+    va_list ap;
+    va_start(ap, fmt);
+    int n = vsnprintf(buf, sizeof(buf), fmt, ap);
+    va_end(ap);
+    if (n < 0) return 0;
+    return write((const uint8_t*)buf, std::min<size_t>((size_t)n, sizeof(buf) - 1));
+  }
+};
+
+class Stream : public Print {
+public:
+  virtual int available() = 0;
+  virtual int read() = 0;
+  virtual int peek() = 0;
+  size_t readBytes(char* buf, size_t len) {
+    size_t n = 0;
+    while (n < len) {
+      int c = read();
+      if (c < 0) break;
+      buf[n++] = (char)c;
+    }
+    return n;
+  }
+  size_t readBytes(uint8_t* buf, size_t len) { return readBytes((char*)buf, len); }
+  size_t readBytesUntil(char term, char* buf, size_t len) {
+    size_t n = 0;
+    while (n < len) {
+      int c = read();
+      if (c < 0 || c == term) break;
+      buf[n++] = (char)c;
+    }
+    return n;
+  }
+  String readStringUntil(char term) {
+    String s;
+    for (int c = read(); c >= 0 && c != term; c = read()) s += (char)c;
+    return s;
+  }
+};
+
+class HostSerial : public Stream {
+public:
+  void begin(unsigned long) {}
+  size_t write(uint8_t c) override { return fputc(c, stdout) == EOF ? 0 : 1; }
+  int available() override { return 0; }
+  int read() override { return -1; }
+  int peek() override { return -1; }
+};
+extern HostSerial Serial;
+
+class EspClass {
+public:
+  uint32_t getFreeHeap() { return 256 * 1024; }
+  uint32_t getHeapSize() { return 320 * 1024; }
+  uint32_t getMinFreeHeap() { return 200 * 1024; }
+  uint32_t getMaxAllocHeap() { return 128 * 1024; }
+  uint32_t getPsramSize() { return 8 * 1024 * 1024; }
+  uint32_t getFreePsram() { return 8 * 1024 * 1024; }
+  uint32_t getMaxAllocPsram() { return 4 * 1024 * 1024; }
+};
+extern EspClass ESP;
+
+inline bool psramFound() { return true; }
@@ -0,0 +1,19 @@
+// Host build shim: LittleFS mounted on hostFsRoot()
+#pragma once
+
+#include <FS.h>
+
+namespace fs {
+
+class LittleFSFS : public FS {
+public:
+  bool begin(bool formatOnFail = false, const char* basePath = "/littlefs", uint8_t maxOpenFiles = 10,
+             const char* partitionLabel = "spiffs") { return true; }
+  void end() {}
+  size_t totalBytes() { return 16 * 1024 * 1024; }
+  size_t usedBytes() { return 0; }
+};
+
+}  // namespace fs
+
+extern fs::LittleFSFS LittleFS;
@@ -0,0 +1,3 @@
+// Host build shim: Print lives in Arduino.h here
+#pragma once
+#include <Arduino.h>
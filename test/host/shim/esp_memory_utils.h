@@ -0,0 +1,7 @@
+// Host build shim: every host pointer counts as internal RAM
+#pragma once
+
+#include <stdbool.h>
+
+static inline bool esp_ptr_external_ram(const void* p) { (void)p; return false; }
+static inline bool esp_ptr_internal(const void* p) { (void)p; return true; }
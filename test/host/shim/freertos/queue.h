@@ -0,0 +1,4 @@
+// Host build shim (see FreeRTOS.h)
+#pragma once
+
+#include <freertos/FreeRTOS.h>
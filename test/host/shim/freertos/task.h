@@ -0,0 +1,7 @@
+// Host build shim (see FreeRTOS.h)
+#pragma once
+
+#include <freertos/FreeRTOS.h>
+
+// Host tests run single-threaded; nothing to wait for
+static inline void vTaskDelay(TickType_t ticks) { (void)ticks; }
@@ -0,0 +1,22 @@
+// Host build shim: Arduino core globals and timing
+#include <Arduino.h>
+
+#include <chrono>
+#include <thread>
+
+HostSerial Serial;
+EspClass ESP;
+
+static uint64_t sAdvancedUs = 0;
+
+static uint64_t hostNowUs() {
+  static const auto start = std::chrono::steady_clock::now();
+  auto elapsed = std::chrono::steady_clock::now() - start;
+  return (uint64_t)std::chrono::duration_cast<std::chrono::microseconds>(elapsed).count() + sAdvancedUs;
+}
+
+unsigned long millis() { return (unsigned long)(hostNowUs() / 1000); }
+unsigned long micros() { return (unsigned long)hostNowUs(); }
+void delay(uint32_t ms) { std::this_thread::sleep_for(std::chrono::milliseconds(ms)); }
+void yield() {}
+void hostAdvanceMicros(uint64_t us) { sAdvancedUs += us; }
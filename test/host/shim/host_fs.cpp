@@ -0,0 +1,172 @@
+// Host build shim: fs::FS / fs::File backed by stdio and a host directory
+#include <FS.h>
+#include <LittleFS.h>
+
+#include <dirent.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <vector>
+
+fs::LittleFSFS LittleFS;
+
+static std::string sRoot = ".";
+
+void hostFsSetRoot(const char* dir) {
+  sRoot = (dir && *dir) ? dir : ".";
+  while (sRoot.size() > 1 && sRoot.back() == '/') sRoot.pop_back();
+  ::mkdir(sRoot.c_str(), 0755);
+}
+
+const char* hostFsRoot() { return sRoot.c_str(); }
+
+static std::string hostPath(const char* path) {
+  std::string p = path ? path : "";
+  if (p.empty() || p[0] != '/') p = "/" + p;
+  return sRoot + p;
+}
+
+namespace fs {
+
+struct FileImpl {
+  std::string path;           // Mount-relative
+  std::string name;           // Last component
+  FILE* fp = nullptr;
+  bool dir = false;
+  std::vector<std::string> entries;
+  size_t nextEntry = 0;
+
+  ~FileImpl() {
+    if (fp) fclose(fp);
+  }
+};
+
+static const char* baseName(const std::string& p) {
+  size_t slash = p.rfind('/');
+  return p.c_str() + (slash == std::string::npos ? 0 : slash + 1);
+}
+
+size_t File::write(uint8_t c) { return write(&c, 1); }
+
+size_t File::write(const uint8_t* buf, size_t size) {
+  if (!_impl || !_impl->fp) return 0;
+  return fwrite(buf, 1, size, _impl->fp);
+}
+
+int File::available() {
+  if (!_impl || !_impl->fp) return 0;
+  size_t sz = size(), pos = position();
+  return pos < sz ? (int)(sz - pos) : 0;
+}
+
+int File::read() {
+  if (!_impl || !_impl->fp) return -1;
+  int c = fgetc(_impl->fp);
+  return c == EOF ? -1 : c;
+}
+
+int File::peek() {
+  if (!_impl || !_impl->fp) return -1;
+  int c = fgetc(_impl->fp);
+  if (c == EOF) return -1;
+  ungetc(c, _impl->fp);
+  return c;
+}
+
+void File::flush() {
+  if (_impl && _impl->fp) fflush(_impl->fp);
+}
+
+size_t File::read(uint8_t* buf, size_t size) {
+  if (!_impl || !_impl->fp) return 0;
+  return fread(buf, 1, size, _impl->fp);
+}
+
+bool File::seek(uint32_t pos, SeekMode mode) {
+  if (!_impl || !_impl->fp) return false;
+  int whence = mode == SeekCur ? SEEK_CUR : mode == SeekEnd ? SEEK_END : SEEK_SET;
+  if (mode == SeekSet && pos > size()) return false;
+  return fseek(_impl->fp, (long)pos, whence) == 0;
+}
+
+size_t File::position() const {
+  if (!_impl || !_impl->fp) return 0;
+  long p = ftell(_impl->fp);
+  return p < 0 ? 0 : (size_t)p;
+}
+
+size_t File::size() const {
+  if (!_impl || !_impl->fp) return 0;
+  fflush(_impl->fp);
+  struct stat st;
+  if (fstat(fileno(_impl->fp), &st) != 0) return 0;
+  return (size_t)st.st_size;
+}
+
+void File::close() { _impl.reset(); }
+
+File::operator bool() const { return (bool)_impl; }
+
+const char* File::path() const { return _impl ? _impl->path.c_str() : nullptr; }
+
+const char* File::name() const { return _impl ? _impl->name.c_str() : nullptr; }
+
+bool File::isDirectory() const { return _impl && _impl->dir; }
+
+File File::openNextFile(const char* mode) {
+  if (!_impl || !_impl->dir || _impl->nextEntry >= _impl->entries.size()) return File();
+  std::string child = _impl->path;
+  if (child.empty() || child.back() != '/') child += "/";
+  child += _impl->entries[_impl->nextEntry++];
+  return LittleFS.open(child.c_str(), mode);
+}
+
+void File::rewindDirectory() {
+  if (_impl) _impl->nextEntry = 0;
+}
+
+File FS::open(const char* path, const char* mode, const bool create) {
+  std::string full = hostPath(path);
+  auto impl = std::make_shared<FileImpl>();
+  impl->path = (path && path[0] == '/') ? path : std::string("/") + (path ? path : "");
+  impl->name = baseName(impl->path);
+
+  struct stat st;
+  if (stat(full.c_str(), &st) == 0 && S_ISDIR(st.st_mode)) {
+    DIR* d = opendir(full.c_str());
+    if (!d) return File();
+    while (struct dirent* e = readdir(d)) {
+      if (strcmp(e->d_name, ".") == 0 || strcmp(e->d_name, "..") == 0) continue;
+      impl->entries.push_back(e->d_name);
+    }
+    closedir(d);
+    std::sort(impl->entries.begin(), impl->entries.end());
+    impl->dir = true;
+    return File(impl);
+  }
+
+  std::string m = mode ? mode : "r";
+  if (m.find('b') == std::string::npos) m += "b";
+  impl->fp = fopen(full.c_str(), m.c_str());
+  if (!impl->fp) return File();
+  return File(impl);
+}
+
+bool FS::exists(const char* path) {
+  struct stat st;
+  return stat(hostPath(path).c_str(), &st) == 0;
+}
+
+bool FS::remove(const char* path) { return ::unlink(hostPath(path).c_str()) == 0; }
+
+bool FS::rename(const char* pathFrom, const char* pathTo) {
+  return ::rename(hostPath(pathFrom).c_str(), hostPath(pathTo).c_str()) == 0;
+}
+
+bool FS::mkdir(const char* path) {
+  return ::mkdir(hostPath(path).c_str(), 0755) == 0 || exists(path);
+}
+
+bool FS::rmdir(const char* path) { return ::rmdir(hostPath(path).c_str()) == 0; }
+
+}  // namespace fs
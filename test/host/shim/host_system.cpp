@@ -0,0 +1,57 @@
+// Host build shim: stand-ins for System_Debug.cpp, System_Mutex.cpp and the
+// allocation globals. Locks are no-ops (host tests are single-threaded); debug
+// output goes to stderr when HWONE_HOST_DEBUG is set.
+#include <Arduino.h>
+
+#include "System_Debug.h"
+#include "System_MemUtil.h"
+#include "System_Mutex.h"
+
+size_t gAllocHeapBefore = 0;
+size_t gAllocPsBefore = 0;
+
+extern "C" void memAllocDebug(const char* op, void* ptr, size_t size,
+                              bool requestedPS, bool usedPS, const char* tag) {}
+
+volatile bool gDebugVerbose = false;
+
+static bool hostDebugEnabled() {
+  static const bool enabled = getenv("HWONE_HOST_DEBUG") != nullptr;
+  return enabled;
+}
+
+DebugManager::DebugManager() {}
+
+DebugManager& DebugManager::getInstance() {
+  static DebugManager instance;
+  return instance;
+}
+
+uint64_t DebugManager::getDebugFlags() const { return hostDebugEnabled() ? ~0ULL : 0; }
+uint8_t DebugManager::getLogLevel() const { return hostDebugEnabled() ? LOG_LEVEL_DEBUG : LOG_LEVEL_ERROR; }
+
+void debugQueuePrintf(uint64_t flag, const char* fmt, ...) {
+  va_list ap;
+  va_start(ap, fmt);
+  vfprintf(stderr, fmt, ap);
+  va_end(ap);
+  fputc('\n', stderr);
+}
+
+void broadcastOutput(const char* s) { if (s) printf("%s\n", s); }
+void broadcastOutput(const String& s) { broadcastOutput(s.c_str()); }
+
+FsLockGuard::FsLockGuard(const char*) : held(true) {}
+FsLockGuard::~FsLockGuard() {}
+MapCacheGuard::MapCacheGuard(const char*) : held(true) {}
+MapCacheGuard::~MapCacheGuard() {}
+FsPathReadGuard::FsPathReadGuard(const char*) : held(true), key(0) {}
+FsPathReadGuard::~FsPathReadGuard() {}
+FsPathWriteGuard::FsPathWriteGuard(const char*) : held(true), key(0) {}
+FsPathWriteGuard::~FsPathWriteGuard() {}
+bool fsPathLock(const char*, bool) { return true; }
+void fsPathUnlock(const char*, bool) {}
+void fsLock(const char*) {}
+void fsUnlock() {}
+bool isFsLockedByCurrentTask() { return true; }
+volatile bool gSensorPollingPaused = false;
@@ -0,0 +1,24 @@
+// Host build shim: flash is ordinary memory (the Arduino-ESP32 pgmspace.h)
+#pragma once
+
+#include <stdint.h>
+#include <string.h>
+
+#define PROGMEM
+#define PGM_P const char*
+#define pgm_read_byte(addr) (*(const uint8_t*)(addr))
+#define pgm_read_word(addr) (*(const uint16_t*)(addr))
+#define pgm_read_ptr(addr) (*(void* const*)(addr))
+#define strcpy_P strcpy
+#define strlen_P strlen
+
+// The ESP32 core reads an unsigned long, which is also pointer-sized there, and
+// Adafruit_GFX reads font pointers through it (pgm_read_pointer). On a 64-bit
+// host read the pointee's own width instead.
+template <typename T>
+inline unsigned long hostPgmReadDword(const T* addr) {
+  if (sizeof(T) == sizeof(unsigned long)) return *(const unsigned long*)addr;
+  return *(const uint32_t*)addr;
+}
+#define pgm_read_dword(addr) hostPgmReadDword(addr)
+#define pgm_read_pointer(addr) ((void *)pgm_read_dword(addr))
@@ -0,0 +1,319 @@
+// TFTCompositor on the host, built for the ST7789 (DISPLAY_TYPE 2) with the
+// in-memory panel from shim/Adafruit_ST7789.h.
+// - Per-pixel equivalence: thermal images, spectrum bars, waveforms and
+//   overlays (fixed scenes plus random ones) rendered by the compositor must
+//   leave the panel identical to the same scene drawn with plain GFX
+//   primitives into a GFXcanvas16 software framebuffer, both through the
+//   PSRAM framebuffer and drawing directly to the panel.
+// - Directly on the panel every band is exactly one address window and no
+//   pixel is drawn on its own.
+// - Benchmark: the device's thermal and microphone views, compositor against
+//   the per-pixel / per-column software framebuffer reference.
+#include <Arduino.h>
+#include <Adafruit_GFX.h>
+
+#include <vector>
+
+#include "host_test.h"
+#include "HAL_TFTCompositor.h"
+#include "System_MemUtil.h"
+
+static uint32_t sRng = 0x2545F491u;
+static uint32_t rnd() {
+  sRng ^= sRng << 13;
+  sRng ^= sRng >> 17;
+  sRng ^= sRng << 5;
+  return sRng;
+}
+static int rndRange(int lo, int hi) { return lo + (int)(rnd() % (uint32_t)(hi - lo + 1)); }
+
+// GFXcanvas16 inherits Adafruit_GFX::fillRect, which draws nothing for a
+// negative width; the panels (Adafruit_SPITFT) flip it like the fast lines do
+class ReferenceCanvas : public GFXcanvas16 {
+public:
+  ReferenceCanvas(int16_t w, int16_t h) : GFXcanvas16(w, h) {}
+  void fillRect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color) override {
+    if (w < 0) { x += w + 1; w = -w; }
+    if (h < 0) { y += h + 1; h = -h; }
+    GFXcanvas16::fillRect(x, y, w, h, color);
+  }
+};
+
+struct Scene {
+  int16_t x, y, w, h;
+  uint16_t bg;
+  std::vector<int16_t> thermal;  // Centidegrees, srcW x srcH
+  uint8_t srcW, srcH;
+  int16_t minCenti, maxCenti;
+  int16_t tx, ty, tw, th;
+  std::vector<uint8_t> bars;
+  uint8_t barMax;
+  std::vector<int16_t> wave;
+  uint16_t waveColor;
+  bool overlay;
+};
+
+// Legend, labels and marks that cross band boundaries (what the thermal view draws)
+static void sceneOverlay(TFTBandCanvas& canvas, void* userData) {
+  const Scene* s = (const Scene*)userData;
+  const uint16_t* palette = tftThermalPalette();
+  int16_t w = canvas.width(), h = canvas.height();
+  int16_t legendY = h - 22;
+  for (int16_t x = 0; x < w; x++) canvas.drawFastVLine(x, legendY, 6, palette[(x * 255) / (w > 1 ? w - 1 : 1)]);
+  canvas.setTextSize(1);
+  canvas.setTextColor(0xFFFF);
+  canvas.setCursor(2, 2);
+  canvas.print("THERMAL");
+  canvas.setCursor(0, legendY + 10);
+  canvas.print(s->minCenti / 100);
+  canvas.setTextSize(2);
+  canvas.setTextColor(0xFFE0, 0x0010);
+  canvas.setCursor(w / 2 - 18, h / 2 - 8);
+  canvas.print("37.5");
+  canvas.drawCircle(w / 3, h / 3, 20, 0x07FF);
+  canvas.drawLine(-5, h - 1, w + 5, 0, 0xF81F);
+  canvas.fillRect(w - 4, 10, -30, 14, 0xFC00);
+}
+
+static void setup(TFTCompositor& comp, Scene& s) {
+  if (!s.thermal.empty()) {
+    comp.setThermal(s.thermal.data(), s.srcW, s.srcH, s.minCenti, s.maxCenti, s.tx, s.ty, s.tw, s.th);
+  }
+  if (!s.bars.empty()) comp.setBars(s.bars.data(), (uint8_t)s.bars.size(), s.barMax);
+  if (!s.wave.empty()) comp.setWaveform(s.wave.data(), s.wave.size(), s.waveColor);
+  if (s.overlay) comp.setOverlay(sceneOverlay, &s);
+}
+
+// The scene as the views drew it before the compositor: one GFX call per
+// pixel (thermal), per bar row and per waveform column, into a software
+// framebuffer, then the overlay over the finished rectangle
+static void drawReference(ReferenceCanvas& ref, Scene& s) {
+  const uint16_t* palette = tftThermalPalette();
+  ref.fillRect(s.x, s.y, s.w, s.h, s.bg);
+
+  if (!s.thermal.empty()) {
+    int32_t range = (int32_t)s.maxCenti - s.minCenti;
+    if (range < 100) range = 100;
+    for (int16_t ly = 0; ly < s.h; ly++) {
+      for (int16_t lx = 0; lx < s.w; lx++) {
+        if (lx < s.tx || lx >= s.tx + s.tw || ly < s.ty || ly >= s.ty + s.th) continue;
+        int sx = (lx - s.tx) * s.srcW / s.tw, sy = (ly - s.ty) * s.srcH / s.th;
+        int32_t d = (int32_t)s.thermal[sy * s.srcW + sx] - s.minCenti;
+        int32_t idx = d <= 0 ? 0 : (d * 255) / range;
+        ref.drawPixel(s.x + lx, s.y + ly, palette[idx > 255 ? 255 : idx]);
+      }
+    }
+  }
+
+  if (!s.bars.empty() && s.w / (int)s.bars.size() > 0) {
+    int16_t colW = s.w / (int16_t)s.bars.size();
+    int16_t gap = colW > 2 ? 1 : 0;
+    uint8_t barMax = s.barMax ? s.barMax : 1;
+    for (size_t i = 0; i < s.bars.size(); i++) {
+      int32_t barH = (int32_t)s.bars[i] * s.h / barMax;
+      for (int32_t up = 0; up < barH && up < s.h; up++) {
+        uint16_t color = palette[s.h > 1 ? up * 255 / (s.h - 1) : 255];
+        ref.drawFastHLine(s.x + (int16_t)i * colW, s.y + s.h - 1 - up, colW - gap, color);
+      }
+    }
+  }
+
+  if (!s.wave.empty()) {
+    // Each column spans the screen y of every sample that falls into it (the
+    // sample under it when there are fewer samples than columns)
+    size_t n = s.wave.size();
+    int32_t mid = s.h / 2, half = (s.h - 1) / 2;
+    for (int16_t lx = 0; lx < s.w; lx++) {
+      size_t s0 = (size_t)lx * n / s.w, s1 = (size_t)(lx + 1) * n / s.w;
+      if (s1 <= s0) s1 = s0 + 1;
+      int32_t top = INT32_MAX, bottom = INT32_MIN;
+      for (size_t k = s0; k < s1 && k < n; k++) {
+        int32_t y = mid - (int32_t)s.wave[k] * half / 32768;
+        top = y < top ? y : top;
+        bottom = y > bottom ? y : bottom;
+      }
+      if (top < 0) top = 0;
+      if (bottom >= s.h) bottom = s.h - 1;
+      if (top <= bottom) ref.drawFastVLine(s.x + lx, s.y + (int16_t)top, (int16_t)(bottom - top + 1), s.waveColor);
+    }
+  }
+
+  if (s.overlay) {
+    std::vector<uint16_t> rect((size_t)s.w * s.h);
+    for (int16_t ly = 0; ly < s.h; ly++)
+      for (int16_t lx = 0; lx < s.w; lx++) rect[(size_t)ly * s.w + lx] = ref.getPixel(s.x + lx, s.y + ly);
+    TFTBandCanvas whole(s.w, s.h);
+    whole.setBand(rect.data(), 0, s.h);
+    sceneOverlay(whole, &s);
+    ref.drawRGBBitmap(s.x, s.y, rect.data(), s.w, s.h);
+  }
+}
+
+static Scene thermalScene(int16_t y, int16_t w, int16_t h, uint8_t srcW, uint8_t srcH) {
+  Scene s = {};
+  s.x = 0; s.y = y; s.w = w; s.h = h;
+  s.srcW = srcW; s.srcH = srcH;
+  s.thermal.resize((size_t)srcW * srcH);
+  // Warm blob over a 20-24 C background, like a hand in front of the sensor
+  for (int sy = 0; sy < srcH; sy++)
+    for (int sx = 0; sx < srcW; sx++) {
+      int dx = sx - srcW / 2, dy = sy - srcH / 2;
+      s.thermal[(size_t)sy * srcW + sx] = (int16_t)(2000 + rndRange(0, 400) + (dx * dx + dy * dy < 40 ? 1300 : 0));
+    }
+  s.minCenti = 2000; s.maxCenti = 3700;
+  s.tw = w;
+  s.th = (int16_t)(w * srcH / srcW);
+  if (s.th > h - 24) {
+    s.th = h - 24;
+    s.tw = (int16_t)(s.th * srcW / srcH);
+  }
+  s.tx = (w - s.tw) / 2;
+  s.overlay = true;
+  return s;
+}
+
+static Scene randomScene() {
+  Scene s = {};
+  s.w = (int16_t)rndRange(1, 240);
+  s.h = (int16_t)rndRange(1, 320);
+  s.x = (int16_t)rndRange(-20, 240 - s.w + 20);
+  s.y = (int16_t)rndRange(-40, 320 - s.h + 40);
+  s.bg = (uint16_t)rnd();
+  if (rnd() % 3 != 0) {
+    s.srcW = (uint8_t)rndRange(1, 64);
+    s.srcH = (uint8_t)rndRange(1, 48);
+    s.thermal.resize((size_t)s.srcW * s.srcH);
+    for (int16_t& v : s.thermal) v = (int16_t)rndRange(-4000, 12000);
+    s.minCenti = (int16_t)rndRange(-3000, 8000);
+    s.maxCenti = (int16_t)(s.minCenti + rndRange(-200, 6000));  // Narrow and inverted ranges too
+    s.tw = (int16_t)rndRange(1, s.w + 40);
+    s.th = (int16_t)rndRange(1, s.h + 40);
+    s.tx = (int16_t)rndRange(-30, s.w);
+    s.ty = (int16_t)rndRange(-30, s.h);
+  }
+  if (rnd() % 3 == 0) {
+    s.bars.resize((size_t)rndRange(1, 80));
+    s.barMax = (uint8_t)rndRange(0, 255);
+    for (uint8_t& v : s.bars) v = (uint8_t)rndRange(0, 255);
+  }
+  if (rnd() % 3 == 0) {
+    s.wave.resize((size_t)rndRange(1, 1200));
+    for (int16_t& v : s.wave) v = (int16_t)rndRange(-32768, 32767);
+    s.waveColor = (uint16_t)rnd();
+  }
+  s.overlay = rnd() % 2 == 0;
+  return s;
+}
+
+static uint32_t bandsFor(const Scene& s) { return (uint32_t)(s.h + TFT_COMPOSITOR_BAND_ROWS - 1) / TFT_COMPOSITOR_BAND_ROWS; }
+
+static bool sameAs(const DisplayDriver& tft, const ReferenceCanvas& ref) {
+  return memcmp(tft.mem.data(), ref.getBuffer(), tft.mem.size() * sizeof(uint16_t)) == 0;
+}
+
+static void firstDifference(const DisplayDriver& tft, const ReferenceCanvas& ref, const char* what, int scene) {
+  for (size_t i = 0; i < tft.mem.size(); i++) {
+    if (tft.mem[i] != ref.getBuffer()[i]) {
+      HOST_CHECK(false, "%s scene %d: pixel %zu,%zu is %04x, reference %04x", what, scene, i % 240, i / 240,
+                 tft.mem[i], ref.getBuffer()[i]);
+      return;
+    }
+  }
+}
+
+static void testMatchesReference(bool framebuffer) {
+  const char* what = framebuffer ? "framebuffer" : "direct";
+  psramBypassGlobal() = !framebuffer;
+  DisplayDriver tft(-1, -1, -1);
+  ReferenceCanvas ref(240, 320);
+  HOST_CHECK(tft.attachFramebuffer() == framebuffer, "%s: framebuffer %s", what, framebuffer ? "missing" : "attached");
+  tft.flush();
+
+  std::vector<Scene> scenes;
+  scenes.push_back(thermalScene(20, 240, 283, 32, 24));
+  scenes.push_back(thermalScene(20, 240, 283, 24, 32));
+  Scene mic = {};
+  mic.y = 40; mic.w = 240; mic.h = 130; mic.bars.resize(32); mic.barMax = 128;
+  for (uint8_t& v : mic.bars) v = (uint8_t)rndRange(0, 140);
+  scenes.push_back(mic);
+  Scene scope = {};
+  scope.y = 170; scope.w = 240; scope.h = 130; scope.waveColor = 0xFFFF;
+  scope.wave.resize(512);
+  for (size_t i = 0; i < scope.wave.size(); i++) scope.wave[i] = (int16_t)(20000 * sin(i * 0.07) + rndRange(-3000, 3000));
+  scenes.push_back(scope);
+  for (int i = 0; i < 300; i++) scenes.push_back(randomScene());
+
+  uint32_t bands = 0;
+  for (size_t i = 0; i < scenes.size(); i++) {
+    Scene& s = scenes[i];
+    TFTCompositor comp(s.x, s.y, s.w, s.h, s.bg);
+    setup(comp, s);
+    uint32_t frames = tftCompositorStats().frames, before = tftCompositorStats().bands;
+    uint32_t windows = tft.windows;
+    HOST_CHECK(comp.render(&tft), "%s scene %zu: render failed", what, i);
+    HOST_CHECK(tftCompositorStats().frames == frames + 1 && tftCompositorStats().bands == before + bandsFor(s),
+               "%s scene %zu: %u bands for %d rows", what, i, tftCompositorStats().bands - before, s.h);
+    bands += bandsFor(s);
+    if (!framebuffer) {
+      // Bands above or below the panel are clipped away before the window
+      uint32_t onScreen = 0;
+      for (int16_t by = 0; by < s.h; by += TFT_COMPOSITOR_BAND_ROWS) {
+        int16_t top = s.y + by, rows = s.h - by < TFT_COMPOSITOR_BAND_ROWS ? s.h - by : TFT_COMPOSITOR_BAND_ROWS;
+        if (top + rows > 0 && top < 320 && s.x + s.w > 0 && s.x < 240) onScreen++;
+      }
+      HOST_CHECK(tft.windows - windows == onScreen, "%s scene %zu: %u address windows for %u bands", what, i,
+                 tft.windows - windows, onScreen);
+    }
+    tft.flush();
+    drawReference(ref, s);
+    if (!sameAs(tft, ref)) {
+      firstDifference(tft, ref, what, (int)i);
+      break;
+    }
+  }
+  HOST_CHECK(tft.directPixels == 0, "%s: %u pixels drawn one at a time", what, tft.directPixels);
+  HOST_CHECK(tft.windowErrors == 0 && tft.inWrite == 0, "%s: bad address windows or unbalanced writes", what);
+  printf("%s: %zu scenes, %u bands, %u windows\n", what, scenes.size(), bands, tft.windows);
+  psramBypassGlobal() = false;
+}
+
+static void bench(const char* name, Scene& s, uint32_t frames) {
+  DisplayDriver tft(-1, -1, -1);
+  ReferenceCanvas ref(240, 320);
+  tft.attachFramebuffer();
+  uint32_t t0 = micros();
+  for (uint32_t f = 0; f < frames; f++) {
+    TFTCompositor comp(s.x, s.y, s.w, s.h, s.bg);
+    setup(comp, s);
+    comp.render(&tft);
+  }
+  uint32_t t1 = micros();
+  for (uint32_t f = 0; f < frames; f++) drawReference(ref, s);
+  uint32_t t2 = micros();
+  double comp = (t1 - t0) / 1000.0 / frames, prim = (t2 - t1) / 1000.0 / frames;
+  printf("%-24s %dx%-4d compositor %7.3f ms/frame, GFX primitives %7.3f ms/frame (%.1fx)\n", name, s.w, s.h, comp,
+         prim, comp > 0 ? prim / comp : 0.0);
+}
+
+static void benchViews() {
+  Scene thermal = thermalScene(20, 240, 283, 32, 24);
+  bench("thermal 32x24 + overlay", thermal, 200);
+  thermal.overlay = false;
+  bench("thermal 32x24", thermal, 200);
+  Scene mic = {};
+  mic.y = 40; mic.w = 240; mic.h = 130; mic.bars.resize(32); mic.barMax = 128;
+  for (uint8_t& v : mic.bars) v = (uint8_t)rndRange(0, 128);
+  bench("spectrum 32 bars", mic, 500);
+  Scene scope = {};
+  scope.y = 170; scope.w = 240; scope.h = 130; scope.waveColor = 0xFFFF;
+  scope.wave.resize(512);
+  for (int16_t& v : scope.wave) v = (int16_t)rndRange(-20000, 20000);
+  bench("waveform 512 samples", scope, 500);
+}
+
+int main() {
+  testMatchesReference(true);
+  testMatchesReference(false);
+  benchViews();
+  return hostTestResult("tft_compositor_test");
+}
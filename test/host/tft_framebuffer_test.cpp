@@ -0,0 +1,270 @@
+// TFTFramebuffer and DirtyRectList on the host.
+// - DirtyRectList::add: clipping, merging, and on random input that the rects
+//   stay within the limit, never nest, and cover every pixel that was added.
+// - Pixel equivalence: the same random GFX script drawn through
+//   TFTFramebuffer<MockPanel> and into a GFXcanvas16 reference must leave the
+//   panel identical to the reference after every flush. With the framebuffer
+//   attached the panel may only see address windows + bulk writes; without
+//   PSRAM it must draw directly and still match.
+#include <Arduino.h>
+#include <Adafruit_GFX.h>
+
+#include <vector>
+
+#include "host_test.h"
+#include "HAL_TFTFramebuffer.h"
+#include "System_MemUtil.h"
+
+static const int16_t kW = 240, kH = 135;
+
+static uint32_t sRng = 0x9E3779B9u;
+static uint32_t rnd() {
+  sRng ^= sRng << 13;
+  sRng ^= sRng >> 17;
+  sRng ^= sRng << 5;
+  return sRng;
+}
+static int16_t rndRange(int lo, int hi) { return (int16_t)(lo + (int)(rnd() % (uint32_t)(hi - lo + 1))); }
+
+// Stands in for Adafruit_SPITFT: panel memory written either per pixel
+// (direct drawing) or through setAddrWindow() + writePixels()
+class MockPanel : public Adafruit_GFX {
+public:
+  MockPanel(int16_t w, int16_t h) : Adafruit_GFX(w, h), mem((size_t)w * h, 0) {}
+
+  void drawPixel(int16_t x, int16_t y, uint16_t color) override {
+    if (x < 0 || y < 0 || x >= _width || y >= _height) return;
+    mem[(size_t)y * _width + x] = color;
+    directPixels++;
+  }
+  void startWrite() override { inWrite++; }
+  void endWrite() override { inWrite--; }
+
+  // Fills flip negative sizes and clip like Adafruit_SPITFT
+  void writeFillRect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color) override { fill(x, y, w, h, color); }
+  void fillRect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color) override { fill(x, y, w, h, color); }
+  void writeFastHLine(int16_t x, int16_t y, int16_t w, uint16_t color) override { fill(x, y, w, 1, color); }
+  void drawFastHLine(int16_t x, int16_t y, int16_t w, uint16_t color) override { fill(x, y, w, 1, color); }
+  void writeFastVLine(int16_t x, int16_t y, int16_t h, uint16_t color) override { fill(x, y, 1, h, color); }
+  void drawFastVLine(int16_t x, int16_t y, int16_t h, uint16_t color) override { fill(x, y, 1, h, color); }
+
+  void setAddrWindow(uint16_t x, uint16_t y, uint16_t w, uint16_t h) {
+    HOST_CHECK(inWrite > 0, "address window outside startWrite/endWrite");
+    HOST_CHECK(x + w <= _width && y + h <= _height, "window %u,%u %ux%u leaves the panel", x, y, w, h);
+    _wx = x; _wy = y; _ww = w; _wh = h; _wpos = 0;
+    windows++;
+  }
+  void writePixels(uint16_t* colors, uint32_t len) {
+    for (uint32_t i = 0; i < len; i++, _wpos++) {
+      HOST_CHECK(_wpos < (uint32_t)_ww * _wh, "writePixels past the address window");
+      if (_wpos >= (uint32_t)_ww * _wh) return;
+      mem[(size_t)(_wy + _wpos / _ww) * _width + _wx + _wpos % _ww] = colors[i];
+    }
+    windowPixels += len;
+  }
+
+  std::vector<uint16_t> mem;
+  int inWrite = 0;
+  uint32_t directPixels = 0, windows = 0;
+  uint64_t windowPixels = 0;
+
+private:
+  void fill(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color) {
+    if (w < 0) { x += w + 1; w = -w; }
+    if (h < 0) { y += h + 1; h = -h; }
+    for (int16_t yy = y; yy < y + h; yy++)
+      for (int16_t xx = x; xx < x + w; xx++) drawPixel(xx, yy, color);
+  }
+
+  uint16_t _wx = 0, _wy = 0, _ww = 0, _wh = 0;
+  uint32_t _wpos = 0;
+};
+
+// GFXcanvas16 inherits Adafruit_GFX::fillRect, which draws nothing for a
+// negative width; the panels (Adafruit_SPITFT) flip it like the fast lines do
+class ReferenceCanvas : public GFXcanvas16 {
+public:
+  ReferenceCanvas(int16_t w, int16_t h) : GFXcanvas16(w, h) {}
+  void fillRect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color) override {
+    if (w < 0) { x += w + 1; w = -w; }
+    if (h < 0) { y += h + 1; h = -h; }
+    GFXcanvas16::fillRect(x, y, w, h, color);
+  }
+};
+
+// --- DirtyRectList ---
+
+static bool covers(const DirtyRectList& list, int16_t x, int16_t y) {
+  for (uint8_t i = 0; i < list.count(); i++) {
+    if (x >= list[i].x0 && x <= list[i].x1 && y >= list[i].y0 && y <= list[i].y1) return true;
+  }
+  return false;
+}
+
+static void testDirtyRects() {
+  DirtyRectList list;
+  list.add(-5, -3, 10, 10, kW, kH);
+  HOST_CHECK(list.count() == 1 && list[0].x0 == 0 && list[0].y0 == 0 && list[0].x1 == 4 && list[0].y1 == 6,
+             "clip to the screen: %d,%d..%d,%d", list[0].x0, list[0].y0, list[0].x1, list[0].y1);
+  list.add(kW, 0, 5, 5, kW, kH);
+  list.add(0, 0, 0, 5, kW, kH);
+  list.add(10, -20, 5, 10, kW, kH);
+  HOST_CHECK(list.count() == 1, "off-screen or empty rects must be ignored (%u rects)", list.count());
+  list.add(1, 1, 2, 2, kW, kH);
+  HOST_CHECK(list.count() == 1 && list[0].area() == 35, "contained rect must be absorbed");
+
+  // Side-by-side rects merge exactly; distant small ones stay separate
+  list.clear();
+  list.add(0, 0, 10, 10, kW, kH);
+  list.add(10, 0, 10, 10, kW, kH);
+  HOST_CHECK(list.count() == 1 && list[0].x1 == 19 && list[0].y1 == 9, "adjacent rects must merge");
+  list.clear();
+  for (int i = 0; i < TFT_DIRTY_MAX_RECTS; i++) list.add((int16_t)((i % 4) * 60), (int16_t)((i / 4) * 70), 20, 20, kW, kH);
+  HOST_CHECK(list.count() == TFT_DIRTY_MAX_RECTS, "%u rects, distant rects must not merge", list.count());
+  list.add(100, 100, 20, 20, kW, kH);
+  HOST_CHECK(list.count() <= TFT_DIRTY_MAX_RECTS, "%u rects after overflow", list.count());
+
+  // addAll: exactly the screen
+  list.addAll(kW, kH);
+  HOST_CHECK(list.count() == 1 && list[0].area() == (int32_t)kW * kH, "addAll must cover the screen once");
+
+  // Random sequences: limit, no nesting, full coverage of what was added
+  for (int seq = 0; seq < 500; seq++) {
+    list.clear();
+    std::vector<uint8_t> added((size_t)kW * kH, 0);
+    int adds = rndRange(1, 40);
+    for (int a = 0; a < adds; a++) {
+      int16_t w = rnd() % 4 == 0 ? rndRange(1, 120) : rndRange(1, 12);
+      int16_t h = rnd() % 4 == 0 ? rndRange(1, 80) : rndRange(1, 12);
+      int16_t x = rndRange(-20, kW), y = rndRange(-20, kH);
+      list.add(x, y, w, h, kW, kH);
+      for (int16_t yy = std::max<int16_t>(y, 0); yy < std::min<int>(y + h, kH); yy++)
+        for (int16_t xx = std::max<int16_t>(x, 0); xx < std::min<int>(x + w, kW); xx++) added[(size_t)yy * kW + xx] = 1;
+    }
+    HOST_CHECK(list.count() <= TFT_DIRTY_MAX_RECTS, "seq %d: %u rects", seq, list.count());
+    for (uint8_t i = 0; i < list.count(); i++) {
+      const DirtyRectList::Rect& r = list[i];
+      HOST_CHECK(r.x0 >= 0 && r.y0 >= 0 && r.x1 < kW && r.y1 < kH && r.x0 <= r.x1 && r.y0 <= r.y1,
+                 "seq %d: rect %d,%d..%d,%d outside the screen", seq, r.x0, r.y0, r.x1, r.y1);
+      for (uint8_t j = 0; j < list.count(); j++) {
+        const DirtyRectList::Rect& o = list[j];
+        HOST_CHECK(i == j || !(o.x0 >= r.x0 && o.y0 >= r.y0 && o.x1 <= r.x1 && o.y1 <= r.y1),
+                   "seq %d: rect %u nested in rect %u", seq, j, i);
+      }
+    }
+    bool covered = true;
+    for (int16_t y = 0; y < kH && covered; y++)
+      for (int16_t x = 0; x < kW && covered; x++)
+        if (added[(size_t)y * kW + x] && !covers(list, x, y)) {
+          HOST_CHECK(false, "seq %d: pixel %d,%d added but not dirty", seq, x, y);
+          covered = false;
+        }
+  }
+}
+
+// --- Pixel equivalence ---
+
+// One random primitive on both targets (coordinates may leave the screen)
+static uint32_t drawRandom(Adafruit_GFX& a, Adafruit_GFX& b, std::vector<uint16_t>& bitmap) {
+  const uint16_t color = (uint16_t)rnd();
+  const int16_t x = rndRange(-40, kW + 10), y = rndRange(-40, kH + 10);
+  const int16_t w = rndRange(-30, 120), h = rndRange(-30, 80);
+  const int16_t x2 = rndRange(-40, kW + 40), y2 = rndRange(-40, kH + 40);
+  const int16_t r = rndRange(0, 40);
+  Adafruit_GFX* targets[2] = { &a, &b };
+  const uint32_t op = rnd() % 13;
+  if (op == 12) {
+    bitmap.resize((size_t)std::abs(w) * std::abs(h) + 1);
+    for (uint16_t& px : bitmap) px = (uint16_t)rnd();
+  }
+  char text[12];
+  snprintf(text, sizeof(text), "T%u.%c", rnd() % 1000, 'A' + rnd() % 26);
+  const uint8_t size = (uint8_t)rndRange(1, 3);
+  for (Adafruit_GFX* g : targets) {
+    switch (op) {
+      case 0: g->fillScreen(color); break;
+      case 1: g->drawPixel(x, y, color); break;
+      case 2: g->drawFastHLine(x, y, w, color); break;
+      case 3: g->drawFastVLine(x, y, h, color); break;
+      case 4: g->fillRect(x, y, w, h, color); break;
+      case 5: g->drawRect(x, y, w, h, color); break;
+      case 6: g->drawLine(x, y, x2, y2, color); break;
+      case 7: g->drawCircle(x, y, r, color); break;
+      case 8: g->fillCircle(x, y, r, color); break;
+      case 9: g->fillTriangle(x, y, x2, y2, x + w, y2 - h, color); break;
+      case 10: g->fillRoundRect(x, y, std::abs(w), std::abs(h), r / 4, color); break;
+      case 11:
+        g->setTextColor(color, (uint16_t)~color);
+        g->setTextSize(size);
+        g->setCursor(x, y);
+        g->print(text);
+        break;
+      case 12: g->drawRGBBitmap(x, y, bitmap.data(), std::abs(w), std::abs(h)); break;
+    }
+  }
+  return op;
+}
+
+static bool sameAs(const MockPanel& panel, const ReferenceCanvas& ref) {
+  return memcmp(panel.mem.data(), ref.getBuffer(), panel.mem.size() * sizeof(uint16_t)) == 0;
+}
+
+static void testFramebufferMatchesReference() {
+  TFTFramebuffer<MockPanel> tft(kW, kH);
+  ReferenceCanvas ref(kW, kH);
+  HOST_CHECK(tft.attachFramebuffer(), "framebuffer must attach when PSRAM is available");
+  tft.flush();
+  HOST_CHECK(sameAs(tft, ref), "first flush must push the cleared buffer");
+
+  std::vector<uint16_t> bitmap;
+  uint32_t frames = 0, pushes = 1, ops = 0;
+  for (int frame = 0; frame < 400; frame++, frames++) {
+    int n = rndRange(1, 12);
+    for (int i = 0; i < n; i++, ops++) drawRandom(tft, ref, bitmap);
+    uint32_t windows = tft.windows;
+    tft.flush();
+    if (tft.windows != windows) pushes++;
+    if (!sameAs(tft, ref)) {
+      HOST_CHECK(false, "frame %d: panel differs from the reference after flush", frame);
+      break;
+    }
+  }
+  HOST_CHECK(tft.directPixels == 0, "%u pixels bypassed the framebuffer", tft.directPixels);
+  HOST_CHECK(tft.inWrite == 0, "unbalanced startWrite/endWrite (%d)", tft.inWrite);
+  const TFTFlushStats& st = tft.flushStats();
+  printf("framebuffer: %u ops in %u frames, %u windows, %.1f%% of full-screen pixels pushed\n", ops, frames,
+         tft.windows, 100.0 * (double)tft.windowPixels / ((double)(frames + 1) * kW * kH));
+  // Frames whose drawing stayed off screen push nothing and are not counted
+  HOST_CHECK(st.flushes == pushes && st.pixels == tft.windowPixels && st.rects == tft.windows,
+             "flush stats disagree with the panel (%u flushes, %u rects)", st.flushes, st.rects);
+
+  // Nothing dirty, nothing pushed
+  uint32_t windows = tft.windows;
+  tft.flush();
+  HOST_CHECK(tft.windows == windows, "idle flush must not touch the panel");
+}
+
+static void testDirectFallback() {
+  psramBypassGlobal() = true;
+  TFTFramebuffer<MockPanel> tft(kW, kH);
+  ReferenceCanvas ref(kW, kH);
+  HOST_CHECK(!tft.attachFramebuffer() && !tft.hasFramebuffer(), "no PSRAM: the framebuffer must stay detached");
+  std::vector<uint16_t> bitmap;
+  for (int i = 0; i < 300; i++) {
+    uint32_t op = drawRandom(tft, ref, bitmap);
+    if (!sameAs(tft, ref)) {
+      HOST_CHECK(false, "direct drawing step %d (primitive %u) differs from the reference", i, op);
+      break;
+    }
+  }
+  tft.flush();
+  HOST_CHECK(tft.windows == 0, "flush without a framebuffer must not push");
+  psramBypassGlobal() = false;
+}
+
+int main() {
+  testDirtyRects();
+  testFramebufferMatchesReference();
+  testDirectFallback();
+  return hostTestResult("tft_framebuffer_test");
+}
@@ -0,0 +1,203 @@
+// Writes the synthetic city used by the host tests and map_bench
+// (test/host/fixtures/sample.hwmap). Deterministic: same output on every run.
+//   make_sample_map <out.hwmap> [version]
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "hwmap_encode.h"
+#include "System_Maps.h"
+
+static const int32_t kMinLat = 47600000, kMaxLat = 47640000;
+static const int32_t kMinLon = -122360000, kMaxLon = -122296000;
+
+static uint32_t sRng = 0x2545F491u;
+
+static uint32_t rnd() {
+  sRng ^= sRng << 13;
+  sRng ^= sRng >> 17;
+  sRng ^= sRng << 5;
+  return sRng;
+}
+
+static int32_t rndRange(int32_t lo, int32_t hi) { return lo + (int32_t)(rnd() % (uint32_t)(hi - lo + 1)); }
+
+static HWMapEncMap sMap;
+
+static uint16_t addName(const char* name) {
+  sMap.names.push_back(name);
+  return (uint16_t)(sMap.names.size() - 1);
+}
+
+static void add(uint8_t type, uint8_t subtype, uint16_t name, std::vector<HWMapEncPoint> pts) {
+  sMap.features.push_back({ type, subtype, name, std::move(pts) });
+}
+
+// Straight line with a little wobble every `step` microdegrees
+static std::vector<HWMapEncPoint> wobbly(int32_t lat0, int32_t lon0, int32_t lat1, int32_t lon1,
+                                         int32_t step, int32_t wobble) {
+  int32_t len = std::max(abs(lat1 - lat0), abs(lon1 - lon0));
+  int n = std::max(1, len / step);
+  std::vector<HWMapEncPoint> pts;
+  for (int i = 0; i <= n; i++) {
+    int32_t lat = lat0 + (int32_t)((int64_t)(lat1 - lat0) * i / n);
+    int32_t lon = lon0 + (int32_t)((int64_t)(lon1 - lon0) * i / n);
+    if (i > 0 && i < n && wobble > 0) {
+      lat += rndRange(-wobble, wobble);
+      lon += rndRange(-wobble, wobble);
+    }
+    pts.push_back({ lat, lon });
+  }
+  return pts;
+}
+
+static std::vector<HWMapEncPoint> ring(int32_t cLat, int32_t cLon, int32_t rLat, int32_t rLon, int n, int32_t jitter) {
+  std::vector<HWMapEncPoint> pts;
+  for (int i = 0; i < n; i++) {
+    double a = 2.0 * M_PI * i / n;
+    pts.push_back({ cLat + (int32_t)lround(rLat * sin(a)) + rndRange(-jitter, jitter),
+                    cLon + (int32_t)lround(rLon * cos(a)) + rndRange(-jitter, jitter) });
+  }
+  pts.push_back(pts[0]);
+  return pts;
+}
+
+static std::vector<HWMapEncPoint> rect(int32_t lat0, int32_t lon0, int32_t lat1, int32_t lon1) {
+  return { { lat0, lon0 }, { lat0, lon1 }, { lat1, lon1 }, { lat1, lon0 }, { lat0, lon0 } };
+}
+
+static void buildCity() {
+  memcpy(sMap.regionName, "Testvil", 7);
+  sMap.minLat = kMinLat; sMap.maxLat = kMaxLat;
+  sMap.minLon = kMinLon; sMap.maxLon = kMaxLon;
+
+  // Highways: a north-south interstate with a bend and an east-west state route
+  {
+    uint16_t n = addName("I-5");
+    std::vector<HWMapEncPoint> pts;
+    for (int i = 0; i <= 40; i++) {
+      int32_t lat = kMinLat - 2000 + i * 1100;
+      pts.push_back({ lat, kMinLon + 24000 + (int32_t)lround(6000 * sin(i / 7.0)) });
+    }
+    add(MAP_FEATURE_HIGHWAY, SUBTYPE_HIGHWAY_MOTORWAY, n, pts);
+    n = addName("SR 520");
+    add(MAP_FEATURE_HIGHWAY, SUBTYPE_HIGHWAY_TRUNK, n,
+        wobbly(kMinLat + 32500, kMinLon - 1000, kMinLat + 33500, kMaxLon + 1000, 1500, 120));
+  }
+
+  // Major grid: streets east-west, avenues north-south
+  static const char* kStreets[] = { "Pine St", "Pike St", "Union St", "Spring St",
+                                    "Madison St", "Marion St", "Cherry St", "James St" };
+  for (int k = 0; k < 8; k++) {
+    int32_t lat = kMinLat + 2500 + k * 5000;
+    add(MAP_FEATURE_ROAD_MAJOR, k % 2 ? SUBTYPE_MAJOR_SECONDARY : SUBTYPE_MAJOR_PRIMARY, addName(kStreets[k]),
+        wobbly(lat, kMinLon, lat + rndRange(-200, 200), kMaxLon, 4000, 60));
+  }
+  static const char* kAvenues[] = { "1st Ave", "2nd Ave", "3rd Ave", "4th Ave",
+                                    "5th Ave", "6th Ave", "7th Ave", "8th Ave" };
+  for (int k = 0; k < 8; k++) {
+    int32_t lon = kMinLon + 4000 + k * 8000;
+    add(MAP_FEATURE_ROAD_MAJOR, SUBTYPE_MAJOR_PRIMARY, addName(kAvenues[k]),
+        wobbly(kMinLat, lon, kMaxLat, lon + rndRange(-300, 300), 3000, 60));
+  }
+
+  // Minor roads: residential blocks between the majors, some service alleys
+  static const char* kMinorStems[] = { "Alder", "Aspen", "Birch", "Cedar", "Elm", "Fir",
+                                       "Hemlock", "Maple", "Oak", "Spruce", "Willow", "Yew" };
+  static const char* kMinorKinds[] = { "Ln", "Pl", "Ct", "Way" };
+  int minorCount = 0;
+  for (int32_t lat = kMinLat + 1250; lat < kMaxLat; lat += 1250) {
+    if ((lat - kMinLat - 2500) % 5000 == 0) continue;  // A major street runs here
+    for (int32_t lon = kMinLon; lon < kMaxLon; lon += 8000) {
+      if (rnd() % 10 < 3) continue;
+      char name[32];
+      snprintf(name, sizeof(name), "%s %s", kMinorStems[minorCount % 12], kMinorKinds[(minorCount / 12) % 4]);
+      uint8_t subtype = rnd() % 6 == 0 ? SUBTYPE_MINOR_SERVICE : SUBTYPE_MINOR_RESIDENTIAL;
+      uint16_t n = subtype == SUBTYPE_MINOR_SERVICE ? HWMAP_NO_NAME : addName(name);
+      add(MAP_FEATURE_ROAD_MINOR, subtype, n, wobbly(lat, lon + 4000, lat, lon + 12000, 1000, 40));
+      minorCount++;
+    }
+  }
+  for (int32_t lon = kMinLon + 2000; lon < kMaxLon; lon += 2000) {
+    if ((lon - kMinLon - 4000) % 8000 == 0) continue;  // A major avenue runs here
+    int32_t lat0 = kMinLat + 2500 + (int32_t)(rnd() % 4) * 5000;
+    int32_t lat1 = std::min(kMaxLat, lat0 + 5000 * (1 + (int32_t)(rnd() % 3)));
+    add(MAP_FEATURE_ROAD_MINOR, SUBTYPE_MINOR_TERTIARY, HWMAP_NO_NAME, wobbly(lat0, lon, lat1, lon, 800, 30));
+  }
+
+  // Water: a river across the south, a lake and the western shoreline
+  {
+    std::vector<HWMapEncPoint> river;
+    for (int i = 0; i <= 64; i++) {
+      river.push_back({ kMinLat + 6000 + (int32_t)lround(1800 * sin(i / 5.0)), kMinLon - 1000 + i * 1030 });
+    }
+    add(MAP_FEATURE_WATER, SUBTYPE_WATER_RIVER, addName("Duwamish River"), river);
+    add(MAP_FEATURE_WATER, SUBTYPE_WATER_LAKE, addName("Green Lake"),
+        ring(kMinLat + 25000, kMinLon + 42000, 1800, 2700, 32, 80));
+    std::vector<HWMapEncPoint> shore;
+    for (int i = 0; i <= 20; i++) {
+      shore.push_back({ kMinLat - 1000 + i * 2100, kMinLon + 1500 + (int32_t)lround(900 * sin(i / 2.0)) });
+    }
+    add(MAP_FEATURE_WATER, SUBTYPE_WATER_COASTLINE, addName("Elliott Bay Shore"), shore);
+    add(MAP_FEATURE_LAND_MASK, 0, HWMAP_NO_NAME, shore);
+  }
+
+  // Parks with footpaths and a cycle track
+  static const char* kParks[] = { "Cal Anderson Park", "Volunteer Park", "Denny Park",
+                                  "Freeway Park", "Kinnear Park", "Gas Works Park" };
+  for (int k = 0; k < 6; k++) {
+    int32_t cLat = kMinLat + 5000 + (k % 3) * 12000 + rndRange(-1000, 1000);
+    int32_t cLon = kMinLon + 10000 + (k / 3) * 30000 + rndRange(-2000, 2000);
+    uint16_t n = addName(kParks[k]);
+    add(MAP_FEATURE_PARK, k == 4 ? SUBTYPE_PARK_FOREST : SUBTYPE_PARK_PARK, n, ring(cLat, cLon, 1400, 2200, 12, 150));
+    add(MAP_FEATURE_PATH, SUBTYPE_PATH_FOOTWAY, HWMAP_NO_NAME, ring(cLat, cLon, 900, 1400, 10, 120));
+    add(MAP_FEATURE_PATH, k % 2 ? SUBTYPE_PATH_CYCLEWAY : SUBTYPE_PATH_TRACK, HWMAP_NO_NAME,
+        wobbly(cLat - 1300, cLon - 2000, cLat + 1300, cLon + 2000, 400, 90));
+  }
+
+  // Rail and transit
+  add(MAP_FEATURE_RAILWAY, SUBTYPE_RAILWAY_RAIL, addName("BNSF Line"),
+      wobbly(kMinLat - 1000, kMinLon + 5500, kMaxLat + 1000, kMinLon + 7000, 2500, 100));
+  add(MAP_FEATURE_RAILWAY, SUBTYPE_RAILWAY_SUBWAY, addName("Link Light Rail"),
+      wobbly(kMinLat - 1000, kMinLon + 30000, kMaxLat + 1000, kMinLon + 52000, 2000, 150));
+  for (int k = 0; k < 3; k++) {
+    char name[16];
+    snprintf(name, sizeof(name), "Route %d", 10 + k * 7);
+    int32_t lat = kMinLat + 2540 + k * 10000;
+    add(MAP_FEATURE_BUS, 0, addName(name), wobbly(lat, kMinLon + 4040, lat, kMaxLon - 4000, 2000, 0));
+  }
+  add(MAP_FEATURE_FERRY, 0, addName("Bainbridge Ferry"),
+      wobbly(kMinLat + 20000, kMinLon - 3000, kMinLat + 21000, kMinLon + 1500, 1500, 0));
+  for (int k = 0; k < 8; k++) {
+    char name[32];
+    snprintf(name, sizeof(name), "Station %c", 'A' + k);
+    int32_t lat = kMinLat + 2000 + k * 4500, lon = kMinLon + 30000 + k * 2700;
+    add(MAP_FEATURE_STATION, 0, addName(name), { { lat, lon }, { lat + 40, lon + 60 } });
+  }
+
+  // Buildings along the blocks
+  for (int i = 0; i < 1500; i++) {
+    int32_t lat = rndRange(kMinLat + 200, kMaxLat - 400);
+    int32_t lon = rndRange(kMinLon + 3000, kMaxLon - 400);
+    add(MAP_FEATURE_BUILDING, (uint8_t)(rnd() % 4), HWMAP_NO_NAME,
+        rect(lat, lon, lat + rndRange(60, 220), lon + rndRange(80, 300)));
+  }
+}
+
+int main(int argc, char** argv) {
+  if (argc < 2) {
+    fprintf(stderr, "usage: %s <out.hwmap> [version]\n", argv[0]);
+    return 2;
+  }
+  buildCity();
+  HWMapEncOptions options;
+  if (argc > 2) options.version = (uint16_t)atoi(argv[2]);
+  std::vector<uint8_t> data = hwmapEncode(sMap, options);
+  if (data.empty() || !hwmapWriteFile(argv[1], data)) {
+    fprintf(stderr, "failed to write %s\n", argv[1]);
+    return 1;
+  }
+  printf("%s: %zu bytes, %zu names, %zu source features\n", argv[1], data.size(), sMap.names.size(),
+         sMap.features.size());
+  return 0;
+}
@@ -0,0 +1,122 @@
+// Writes the v7 decoder fixture (test/host/fixtures/tiny_v7.hwmap) and the
+// feature list both decoders must read back from it (tiny_v7.expected):
+//   N <index> <name>
+//   T <tile> <featureCount>
+//   F <type> <subtype> <nameIndex> <qLat>,<qLon> ...
+// The map is small but covers the v7 corners: tiles with and without a header
+// dictionary, dictionary indices and point counts past one varint byte, and
+// point deltas that wrap mod 2^16.
+//   make_v7_fixture <out.hwmap> <out.expected>
+#include <math.h>
+#include <stdio.h>
+
+#include "hwmap_encode.h"
+#include "System_Maps.h"
+
+// 16x16 tiles of exactly 1000 microdegrees (halo 100), so the device's integer
+// tile geometry and the web parser's float geometry agree
+static const int32_t kMinLat = 47600000, kMinLon = -122340000;
+static const int32_t kSize = 16000;
+
+static HWMapEncMap sMap;
+
+static uint16_t addName(const char* name) {
+  sMap.names.push_back(name);
+  return (uint16_t)(sMap.names.size() - 1);
+}
+
+// Point at (latOff, lonOff) microdegrees inside tile (tx, ty)
+static HWMapEncPoint inTile(int tx, int ty, int32_t latOff, int32_t lonOff) {
+  return { kMinLat + ty * 1000 + latOff, kMinLon + tx * 1000 + lonOff };
+}
+
+static void buildMap() {
+  memcpy(sMap.regionName, "V7Test", 6);
+  sMap.minLat = kMinLat; sMap.maxLat = kMinLat + kSize;
+  sMap.minLon = kMinLon; sMap.maxLon = kMinLon + kSize;
+
+  // Straight lines across the map: every tile clips them from halo edge to halo
+  // edge, so consecutive points jump by most of the 16-bit range
+  uint16_t hwy = addName("Diagonal Hwy");
+  sMap.features.push_back({ MAP_FEATURE_HIGHWAY, SUBTYPE_HIGHWAY_MOTORWAY, hwy,
+                            { { kMinLat - 500, kMinLon - 500 }, { kMinLat + kSize + 500, kMinLon + kSize + 500 } } });
+  sMap.features.push_back({ MAP_FEATURE_RAILWAY, SUBTYPE_RAILWAY_RAIL, addName("Cross Line"),
+                            { { kMinLat + kSize + 300, kMinLon - 300 }, { kMinLat - 300, kMinLon + kSize + 300 } } });
+
+  // 300 points inside one tile: point count and stream size take two varint bytes
+  {
+    std::vector<HWMapEncPoint> pts;
+    for (int i = 0; i < 300; i++) {
+      pts.push_back(inTile(5, 9, 200 + (int32_t)lround(250 * sin(i / 9.0)) + i, 150 + i * 2));
+    }
+    sMap.features.push_back({ MAP_FEATURE_PATH, SUBTYPE_PATH_FOOTWAY, HWMAP_NO_NAME, pts });
+  }
+
+  // 140 short streets in one tile under 135 names: a dictionary past 127 entries
+  for (int i = 0; i < 140; i++) {
+    char name[16];
+    snprintf(name, sizeof(name), "Lane %d", i % 135);
+    uint16_t n = i < 135 ? addName(name) : (uint16_t)(sMap.names.size() - 135 + i % 135);
+    int32_t lat = 200 + (i % 20) * 30, lon = 200 + (i / 20) * 80;
+    sMap.features.push_back({ MAP_FEATURE_ROAD_MINOR, SUBTYPE_MINOR_RESIDENTIAL, n,
+                              { inTile(10, 3, lat, lon), inTile(10, 3, lat + 10, lon + 60) } });
+  }
+
+  // One tile with a single distinct header per feature (no dictionary)
+  sMap.features.push_back({ MAP_FEATURE_WATER, SUBTYPE_WATER_LAKE, addName("Mirror Pond"),
+                            { inTile(2, 12, 300, 300), inTile(2, 12, 300, 700), inTile(2, 12, 700, 700),
+                              inTile(2, 12, 700, 300), inTile(2, 12, 300, 300) } });
+  sMap.features.push_back({ MAP_FEATURE_PARK, SUBTYPE_PARK_PARK, addName("Pond Park"),
+                            { inTile(2, 12, 250, 250), inTile(2, 12, 250, 750), inTile(2, 12, 750, 750) } });
+
+  // Identical unnamed buildings: one dictionary entry shared by all
+  for (int i = 0; i < 12; i++) {
+    int32_t lat = 200 + (i % 4) * 150, lon = 200 + (i / 4) * 200;
+    sMap.features.push_back({ MAP_FEATURE_BUILDING, SUBTYPE_BUILDING_RESIDENTIAL, HWMAP_NO_NAME,
+                              { inTile(12, 12, lat, lon), inTile(12, 12, lat, lon + 80),
+                                inTile(12, 12, lat + 60, lon + 80), inTile(12, 12, lat + 60, lon),
+                                inTile(12, 12, lat, lon) } });
+  }
+}
+
+int main(int argc, char** argv) {
+  if (argc < 3) {
+    fprintf(stderr, "usage: %s <out.hwmap> <out.expected>\n", argv[0]);
+    return 2;
+  }
+  buildMap();
+  HWMapEncOptions options;
+  options.version = 7;
+  options.tileGridCode = 0;
+  std::vector<std::vector<HWMapEncTileFeature>> tiles;
+  std::vector<uint8_t> data = hwmapEncode(sMap, options, &tiles);
+  if (data.empty() || !hwmapWriteFile(argv[1], data)) {
+    fprintf(stderr, "failed to write %s\n", argv[1]);
+    return 1;
+  }
+
+  FILE* f = fopen(argv[2], "w");
+  if (!f) {
+    fprintf(stderr, "failed to write %s\n", argv[2]);
+    return 1;
+  }
+  fprintf(f, "# Contents of tiny_v7.hwmap (written by make_v7_fixture)\n");
+  for (size_t i = 0; i < sMap.names.size(); i++) fprintf(f, "N %zu %s\n", i, sMap.names[i].c_str());
+  size_t featureCount = 0;
+  for (size_t t = 0; t < tiles.size(); t++) {
+    if (tiles[t].empty()) continue;
+    fprintf(f, "T %zu %zu\n", t, tiles[t].size());
+    for (const HWMapEncTileFeature& tf : tiles[t]) {
+      fprintf(f, "F %u %u %u", tf.type, tf.subtype, tf.nameIndex);
+      for (size_t i = 0; i < tf.points.size(); i += 2) fprintf(f, " %u,%u", tf.points[i], tf.points[i + 1]);
+      fprintf(f, "\n");
+      featureCount++;
+    }
+  }
+  if (fclose(f) != 0) {
+    fprintf(stderr, "failed to write %s\n", argv[2]);
+    return 1;
+  }
+  printf("%s: %zu bytes, %zu names, %zu tile features\n", argv[1], data.size(), sMap.names.size(), featureCount);
+  return 0;
+}
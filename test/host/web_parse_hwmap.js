@@ -0,0 +1,105 @@
+// Runs the web page's parseHWMap (taken verbatim from WebPage_Maps.h) on the
+// v7 fixture and compares it with the fixture's expected list, the same list
+// hwmap_v7_test checks the device reader against. Points come back in degrees,
+// so they are quantized again with the parser's own tile geometry.
+//   node web_parse_hwmap.js <WebPage_Maps.h> <tiny_v7.hwmap> <tiny_v7.expected>
+'use strict';
+const fs = require('fs');
+
+if (process.argv.length < 5) {
+  console.error('usage: node web_parse_hwmap.js <WebPage_Maps.h> <map.hwmap> <expected.txt>');
+  process.exit(2);
+}
+const [pagePath, mapPath, expectedPath] = process.argv.slice(2);
+
+// Source of a top-level `function name(...) { ... }` in the page script
+function extractFunction(source, name) {
+  const start = source.indexOf(`function ${name}(`);
+  if (start < 0) throw new Error(`${name} not found in ${pagePath}`);
+  let depth = 0;
+  for (let i = source.indexOf('{', start); i < source.length; i++) {
+    if (source[i] === '{') depth++;
+    else if (source[i] === '}' && --depth === 0) return source.slice(start, i + 1);
+  }
+  throw new Error(`${name} is not closed`);
+}
+
+const page = fs.readFileSync(pagePath, 'utf8');
+const quiet = { log() {}, warn: console.warn, error: console.error };
+const parseHWMap = new Function('console',
+  extractFunction(page, 'featureAvailabilityKey') + '\n' +
+  extractFunction(page, 'parseHWMap') + '\nreturn parseHWMap;')(quiet);
+
+// Expected list: N <index> <name>, T <tile> <count>, F <type> <subtype> <name> <qLat>,<qLon>...
+const names = [];
+const tiles = [];
+for (const line of fs.readFileSync(expectedPath, 'utf8').split('\n')) {
+  const parts = line.trim().split(/\s+/);
+  if (parts[0] === 'N') {
+    names[Number(parts[1])] = parts.slice(2).join(' ');
+  } else if (parts[0] === 'T') {
+    tiles.push({ index: Number(parts[1]), features: [] });
+  } else if (parts[0] === 'F' && tiles.length) {
+    tiles[tiles.length - 1].features.push({
+      type: Number(parts[1]), subtype: Number(parts[2]), nameIndex: Number(parts[3]),
+      points: parts.slice(4).map((p) => p.split(',').map(Number))
+    });
+  }
+}
+
+const file = fs.readFileSync(mapPath);
+const map = parseHWMap(file.buffer.slice(file.byteOffset, file.byteOffset + file.length), mapPath);
+
+let failures = 0;
+const check = (ok, msg) => {
+  if (!ok) {
+    failures++;
+    console.log(`FAIL ${msg}`);
+  }
+};
+
+check(map.version === 7, `version ${map.version}, fixture must be v7`);
+check(map.names.length === names.length, `${map.names.length} names, expected ${names.length}`);
+names.forEach((n, i) => check(map.names[i] === n, `name ${i}: '${map.names[i]}', expected '${n}'`));
+
+// The parser keeps features with at least two points, in tile order
+const grid = map.tileGridSize;
+const tileW = (map.maxLon - map.minLon) * 1e7 / grid;
+const tileH = (map.maxLat - map.minLat) * 1e7 / grid;
+const qMax = 1 << map.quantBits;
+let at = 0;
+for (const tile of tiles) {
+  const tx = tile.index % grid, ty = Math.floor(tile.index / grid);
+  const minLon = map.minLon * 1e7 + tx * tileW - tileW * map.haloPct;
+  const minLat = map.minLat * 1e7 + ty * tileH - tileH * map.haloPct;
+  const spanLon = tileW * (1 + 2 * map.haloPct), spanLat = tileH * (1 + 2 * map.haloPct);
+  for (const [i, ef] of tile.features.entries()) {
+    if (ef.points.length < 2) continue;
+    const f = map.features[at++];
+    const where = `tile ${tile.index} feature ${i}`;
+    if (!f) {
+      check(false, `${where}: missing`);
+      continue;
+    }
+    const name = ef.nameIndex === 0xFFFF ? null : names[ef.nameIndex];
+    check(f.tileIdx === tile.index, `${where}: parsed from tile ${f.tileIdx}`);
+    check(f.type === ef.type && f.subtype === ef.subtype && f.name === name,
+      `${where}: header ${f.type}/${f.subtype}/${f.name}, expected ${ef.type}/${ef.subtype}/${name}`);
+    check(f.points.length === ef.points.length, `${where}: ${f.points.length} points, expected ${ef.points.length}`);
+    f.points.forEach((p, k) => {
+      if (k >= ef.points.length) return;
+      const qLat = Math.round((p.lat * 1e7 - minLat) / spanLat * qMax);
+      const qLon = Math.round((p.lon * 1e7 - minLon) / spanLon * qMax);
+      const [eLat, eLon] = ef.points[k];
+      check(qLat === eLat && qLon === eLon, `${where} point ${k}: ${qLat},${qLon}, expected ${eLat},${eLon}`);
+    });
+  }
+}
+check(at === map.features.length, `${map.features.length - at} features beyond the expected list`);
+
+console.log(`checked ${names.length} names, ${tiles.length} tiles, ${at} features`);
+if (failures) {
+  console.log(`web_parse_hwmap: ${failures} check(s) failed`);
+  process.exit(1);
+}
+console.log('web_parse_hwmap: OK');